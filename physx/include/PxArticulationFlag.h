@@ -106,6 +106,27 @@ namespace physx
 	typedef PxFlags<PxArticulationCacheFlag::Enum, PxU32> PxArticulationCacheFlags;
 	PX_FLAGS_OPERATORS(PxArticulationCacheFlag::Enum, PxU32)
 
+	/**
+	\brief Flags to select the quantities computed by PxArticulationReducedCoordinate::computeInverseDynamics.
+
+	\see PxArticulationReducedCoordinate::computeInverseDynamics PxComputeArticulationInverseDynamics
+	*/
+	class PxArticulationInverseDynamicsFlag
+	{
+	public:
+		enum Enum
+		{
+			eMASS_MATRIX = (1 << 0),					//!< The joint-space inertia matrix, see PxArticulationReducedCoordinate::computeGeneralizedMassMatrix. Written to PxArticulationCache::massMatrix.
+			eGRAVITY_FORCE = (1 << 1),					//!< The joint forces counteracting gravity, see PxArticulationReducedCoordinate::computeGeneralizedGravityForce. Written to PxArticulationCache::jointForce (summed over the requested terms).
+			eCORIOLIS_AND_CENTRIFUGAL_FORCE = (1 << 2),	//!< The joint forces counteracting Coriolis and centrifugal forces, see PxArticulationReducedCoordinate::computeCoriolisAndCentrifugalForce. Written to PxArticulationCache::jointForce (summed over the requested terms).
+			eDENSE_JACOBIAN = (1 << 3),					//!< The dense Jacobian, see PxArticulationReducedCoordinate::computeDenseJacobian. Written to PxArticulationCache::denseJacobian.
+			eALL = (eMASS_MATRIX | eGRAVITY_FORCE | eCORIOLIS_AND_CENTRIFUGAL_FORCE | eDENSE_JACOBIAN)
+		};
+	};
+
+	typedef PxFlags<PxArticulationInverseDynamicsFlag::Enum, PxU32> PxArticulationInverseDynamicsFlags;
+	PX_FLAGS_OPERATORS(PxArticulationInverseDynamicsFlag::Enum, PxU32)
+
 #if !PX_DOXYGEN
 }
 #endif
@@ -73,6 +73,7 @@ namespace physx
 
 	class PxConstraint;
 	class PxScene;
+	class PxCpuDispatcher;
 
 	/**
 	\brief Data structure used to access the root link state and acceleration.
@@ -1020,6 +1021,40 @@ namespace physx
 		*/
 		virtual		void					computeGeneralizedMassMatrix(PxArticulationCache& cache) const = 0;
 
+		/**
+		\brief Computes several inverse dynamics quantities for the current articulation state in a single call.
+
+		The results are the same as calling the corresponding individual methods, but the pose-dependent data shared by all of
+		them (link transforms, world-space joint motion matrices and spatial inertias, see commonInit()) is computed at most once.
+		It is moreover kept across calls and only recomputed when the articulation pose changed, i.e. after a simulation step,
+		an applyCache() call with PxArticulationCacheFlag::ePOSITION or PxArticulationCacheFlag::eROOT_TRANSFORM, an updateKinematic()
+		call with PxArticulationKinematicFlag::ePOSITION or a root link teleport, or when the mass, inertia or center of mass pose
+		of a link changed. Calling commonInit() beforehand is not necessary.
+
+		- Inputs:	Articulation state (joint positions and velocities (in cache), and base transform and spatial velocity).
+		- Outputs:	Mass matrix, joint bias forces and dense Jacobian (in cache), as selected by flags.
+
+		- PxArticulationInverseDynamicsFlag::eMASS_MATRIX writes PxArticulationCache::massMatrix, see computeGeneralizedMassMatrix().
+		- PxArticulationInverseDynamicsFlag::eGRAVITY_FORCE and PxArticulationInverseDynamicsFlag::eCORIOLIS_AND_CENTRIFUGAL_FORCE write
+		PxArticulationCache::jointForce. When both are raised, jointForce is the sum of the results of computeGeneralizedGravityForce()
+		and computeCoriolisAndCentrifugalForce(). For a floating base articulation, the sum is computed in a single inverse dynamics pass.
+		- PxArticulationInverseDynamicsFlag::eDENSE_JACOBIAN writes PxArticulationCache::denseJacobian, see computeDenseJacobian().
+
+		\param[in,out] cache In: PxArticulationCache::jointVelocity; Out: PxArticulationCache::massMatrix, PxArticulationCache::jointForce, PxArticulationCache::denseJacobian.
+		\param[in] flags The quantities to compute.
+		\param[out] nRows Set to the number of rows of the dense Jacobian when PxArticulationInverseDynamicsFlag::eDENSE_JACOBIAN is raised, see computeDenseJacobian().
+		\param[out] nCols Set to the number of columns of the dense Jacobian when PxArticulationInverseDynamicsFlag::eDENSE_JACOBIAN is raised, see computeDenseJacobian().
+
+		\note Changes to link mass properties are not tracked. Call commonInit() after changing them.
+
+		\note With PxSceneFlag::eENABLE_GPU_DYNAMICS the pose-dependent data is recomputed on every call.
+
+		\note This call may only be made on articulations that are in a scene, and may not be made during simulation.
+
+		\see PxArticulationInverseDynamicsFlag, PxComputeArticulationInverseDynamics
+		*/
+		virtual		void					computeInverseDynamics(PxArticulationCache& cache, PxArticulationInverseDynamicsFlags flags, PxU32& nRows, PxU32& nCols) const = 0;
+
 		/**
 		\deprecated The API related to loop joints will be removed in a future version once a replacement is made available.
 
@@ -1376,6 +1411,29 @@ namespace physx
 
 	};
 
+	/**
+	\brief Runs PxArticulationReducedCoordinate::computeInverseDynamics() for a batch of articulations.
+
+	The articulations are processed in parallel over the worker threads of the provided dispatcher, or on the calling thread if
+	no dispatcher is provided. The calling thread takes part in the work and returns once all articulations have been processed.
+
+	\param[in] nbArticulations Number of articulations in the batch.
+	\param[in] articulations The articulations. They must be in a scene and appear at most once in the batch.
+	\param[in,out] caches One cache per articulation, created by that articulation. See PxArticulationReducedCoordinate::computeInverseDynamics().
+	\param[in] flags The quantities to compute, see PxArticulationReducedCoordinate::computeInverseDynamics().
+	\param[in] dispatcher Optional dispatcher used to process the articulations in parallel.
+
+	\note The dense Jacobian dimensions are not returned. They are nbLinks * 6, minus 6 with PxArticulationFlag::eFIX_BASE, rows and
+	getDofs(), plus 6 without PxArticulationFlag::eFIX_BASE, columns.
+
+	\note If a scene has been created with PxSceneFlag::eREQUIRE_RW_LOCK, the calling thread must hold its read lock. The call may not
+	be made while one of the scenes is simulating.
+
+	\see PxArticulationReducedCoordinate::computeInverseDynamics, PxArticulationInverseDynamicsFlag
+	*/
+	PX_C_EXPORT PX_PHYSX_CORE_API void PxComputeArticulationInverseDynamics(PxU32 nbArticulations, PxArticulationReducedCoordinate* const* articulations,
+		PxArticulationCache* const* caches, PxArticulationInverseDynamicsFlags flags, PxCpuDispatcher* dispatcher = NULL);
+
 #if PX_VC
 #pragma warning(pop)
 #endif
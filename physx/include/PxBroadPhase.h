@@ -62,6 +62,12 @@ namespace physx
 	ePABP is a parallel implementation of ABP. It can often be the fastest (CPU) broadphase, but it
 	can use more memory than ABP.
 
+	ePSAP is a parallel implementation of SAP. Insertions of new objects are parallelized, and when many objects
+	jump far away from their previous positions (e.g. teleports) the sorted lists are rebuilt from scratch in
+	parallel instead of being updated incrementally. It reports the same pairs as eSAP, and regular incremental
+	updates run with the same performance as eSAP. Parallel execution requires a continuation task to be passed
+	to the broad phase update.
+
 	eGPU is a GPU implementation of the incremental sweep and prune approach. Additionally, it uses a ABP-style
 	initial pair generation approach to avoid large spikes when inserting shapes. It not only has the advantage 
 	of traditional SAP approch which is good for when many objects are sleeping, but due to being fully parallel, 
@@ -79,6 +85,7 @@ namespace physx
 			eABP,	//!< Automatic box pruning
 			ePABP,	//!< Parallel automatic box pruning
 			eGPU,	//!< GPU broad phase
+			ePSAP,	//!< Parallel 3-axes sweep-and-prune
 			eLAST
 		};
 	};
@@ -129,6 +136,67 @@ namespace physx
 		PxU32	mMaxNbRegions;	//!< Max number of regions supported by the broad-phase (0 = explicit regions not needed)
 	};
 
+	/**
+	\brief Parameters for automatic region management.
+
+	When enabled (see PxBroadPhaseRegions::setAutoRegions), the broad-phase creates and releases its own regions:
+		- regions are cells of a regular 2D grid (unbounded along the up axis), created on demand to cover the objects
+		  that are added or moved outside of the existing regions. Objects are then never reported as out-of-bounds,
+		  unless PxBroadPhaseCaps::mMaxNbRegions is reached.
+		- a region containing more than mMaxNbObjectsPerRegion objects is split into 4 sub-regions, up to mMaxDepth times.
+		- 4 sub-regions that together contain less than mMinNbObjectsPerRegion objects are merged back into their parent.
+		- empty top-level cells are released.
+
+	Objects much larger than the cells (e.g. terrains) are only guaranteed to touch one region. Pairs between two such
+	objects are only detected where the objects overlap an existing region.
+
+	\see PxBroadPhaseRegions::setAutoRegions PxBroadPhaseAutoRegionStats
+	*/
+	struct PxBroadPhaseAutoRegionParams
+	{
+		PxBroadPhaseAutoRegionParams() :
+			mCellSize				(0.0f),
+			mUpAxis					(1),
+			mMaxNbObjectsPerRegion	(1024),
+			mMinNbObjectsPerRegion	(256),
+			mMaxDepth				(3)
+		{}
+
+		PxReal	mCellSize;				//!< Size of top-level cells. 0.0 = computed from the bounds of the first batch of objects needing a region.
+		PxU32	mUpAxis;				//!< Regions are unbounded along this axis (0 = X, 1 = Y, 2 = Z)
+		PxU32	mMaxNbObjectsPerRegion;	//!< A region containing more objects than this is split
+		PxU32	mMinNbObjectsPerRegion;	//!< Sibling regions containing less objects than this (in total) are merged
+		PxU32	mMaxDepth;				//!< Max number of times a top-level cell can be split, in [0 ; 5]
+
+		PX_INLINE	bool	isValid()	const
+		{
+			if(!(mCellSize>=0.0f) || mUpAxis>2 || mMaxDepth>5)
+				return false;
+			if(mMinNbObjectsPerRegion>=mMaxNbObjectsPerRegion)
+				return false;
+			return true;
+		}
+	};
+
+	/**
+	\brief Region occupancy statistics for automatic region management.
+
+	\see PxBroadPhaseRegions::getAutoRegionStats
+	*/
+	struct PxBroadPhaseAutoRegionStats
+	{
+		PxU32	mNbRegions;				//!< Number of active regions (automatic and user-defined)
+		PxU32	mNbAutoRegions;			//!< Number of active regions managed automatically
+		PxU32	mNbObjectEntries;		//!< Sum of objects over all active regions (objects touching N regions are counted N times)
+		PxU32	mMinNbObjects;			//!< Min number of objects in an active region
+		PxU32	mMaxNbObjects;			//!< Max number of objects in an active region
+		PxU32	mNbOutOfBoundsObjects;	//!< Number of objects that could not be covered by a region in the last update
+		PxU32	mNbCreated;				//!< Total number of top-level cells created for out-of-bounds objects
+		PxU32	mNbReleased;			//!< Total number of empty top-level cells released
+		PxU32	mNbSplits;				//!< Total number of region splits
+		PxU32	mNbMerges;				//!< Total number of region merges
+	};
+
 	/**
 	\brief Broadphase descriptor.
 
@@ -399,6 +467,41 @@ namespace physx
 		\brief Return an array of objects that are not in any region.
 		*/
 		virtual	const PxU32*	getOutOfBoundsObjects()	const	= 0;
+
+		/**
+		\brief Enables or disables automatic region management.
+
+		Regions are then created, split, merged and released by the broad-phase during its update, to keep all objects
+		inside regions with a bounded number of objects per region. Automatically managed regions are regular regions,
+		i.e. they are reported by getRegions(). They can coexist with user-defined regions, but mixing both is not
+		recommended.
+
+		Disabling automatic management keeps the current regions, which then behave like user-defined regions.
+
+		\param	params	[in] Parameters for automatic region management, or NULL to disable it.
+		\return True if success. Only supported by PxBroadPhaseType::eMBP.
+		\note	The default implementation does nothing and returns false, so that existing implementations of this interface remain valid.
+		\see	PxBroadPhaseAutoRegionParams getAutoRegionStats
+		*/
+		virtual	bool	setAutoRegions(const PxBroadPhaseAutoRegionParams* params)
+		{
+			PX_UNUSED(params);
+			return false;
+		}
+
+		/**
+		\brief Retrieves region occupancy statistics.
+
+		\param	stats	[out] Region statistics
+		\return True if success. Only supported by PxBroadPhaseType::eMBP.
+		\note	The default implementation leaves the stats untouched and returns false.
+		\see	PxBroadPhaseAutoRegionStats setAutoRegions
+		*/
+		virtual	bool	getAutoRegionStats(PxBroadPhaseAutoRegionStats& stats)	const
+		{
+			PX_UNUSED(stats);
+			return false;
+		}
 	};
 
 	/**
@@ -135,6 +135,7 @@ Alternatively, one can instead directly #include a subset of the below files.
 #include "geometry/PxHeightFieldFlag.h"
 #include "geometry/PxHeightFieldGeometry.h"
 #include "geometry/PxHeightFieldSample.h"
+#include "geometry/PxMappedGeometryData.h"
 #include "geometry/PxMeshQuery.h"
 #include "geometry/PxMeshScale.h"
 #include "geometry/PxPlaneGeometry.h"
@@ -1492,6 +1492,28 @@ class PxScene : public PxSceneSQSystem
 	*/
 	virtual	bool					removeBroadPhaseRegion(PxU32 handle)				= 0;
 
+	/**
+	\brief Enables or disables automatic broad-phase region management.
+
+	Only supported by PxBroadPhaseType::eMBP. When enabled, regions are automatically created around objects that
+	would otherwise be out-of-bounds, split when they contain too many objects, and merged or released when they
+	become sparse.
+
+	\param[in]	params	Parameters for automatic region management, or NULL to disable it.
+	\return True if success
+	\see	PxBroadPhaseAutoRegionParams PxBroadPhaseRegions::setAutoRegions
+	*/
+	virtual	bool					setBroadPhaseAutoRegions(const PxBroadPhaseAutoRegionParams* params)	= 0;
+
+	/**
+	\brief Retrieves broad-phase region occupancy statistics.
+
+	\param[out]	stats	Region statistics
+	\return True if success. Only supported by PxBroadPhaseType::eMBP.
+	\see	PxBroadPhaseAutoRegionStats PxBroadPhaseRegions::getAutoRegionStats
+	*/
+	virtual	bool					getBroadPhaseAutoRegionStats(PxBroadPhaseAutoRegionStats& stats)	const	= 0;
+
 	//\}
 
 	/************************************************************************************************/
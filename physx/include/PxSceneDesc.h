@@ -341,6 +341,24 @@ struct PxSceneFlag
 		*/
 		eENABLE_SOLVER_RESIDUAL_REPORTING = (1 << 19),
 
+		/**
+		\brief Reduces contacts instead of dropping them when running low on contact data blocks.
+
+		When the number of 16K contact data blocks in use gets close to PxSceneDesc::maxNbContactDataBlocks, the CPU narrow
+		phase only keeps the first contact patch of each pair, instead of writing all patches and risking failed block
+		allocations (i.e. dropped contacts) later in the frame. Normal behavior resumes as soon as enough blocks are free again.
+
+		The number of pairs affected by this is reported in PxSimulationStatistics::nbReducedContactPairs.
+
+		\note This flag only has an effect on the CPU pipeline.
+		\note This flag is not mutable and must be set in PxSceneDesc at scene creation.
+
+		<b>Default</b> false
+
+		\see PxSceneDesc.maxNbContactDataBlocks
+		*/
+		eREDUCE_CONTACTS_ON_LOW_MEMORY = (1 << 20),
+
 		eMUTABLE_FLAGS = eENABLE_ACTIVE_ACTORS|eEXCLUDE_KINEMATICS_FROM_ACTIVE_ACTORS
 	};
 };
@@ -760,10 +778,29 @@ public:
 
 	<b>Range:</b> [0, PX_MAX_U32]<br>
 
-	\see nbContactDataBlocks PxScene.setNbContactDataBlocks()
+	\see nbContactDataBlocks PxScene.setNbContactDataBlocks() PxSceneFlag::eREDUCE_CONTACTS_ON_LOW_MEMORY
 	*/
 	PxU32	maxNbContactDataBlocks;
 
+	/**
+	\brief Number of frames after which unused 16K contact data blocks are released.
+
+	The 16K blocks allocated to store contact, friction, and contact cache data are kept by the scene and reused in subsequent
+	frames. By default they are only released by PxScene::flushSimulation(), so a scene that temporarily needed a lot of
+	blocks keeps that memory forever. When this value is non-zero, the scene tracks the peak number of blocks used over
+	this many frames, and releases the blocks exceeding that peak at the end of the period. The scene never goes below
+	nbContactDataBlocks.
+
+	The number of allocated blocks and the peak number of used blocks for the last frame are reported in PxSimulationStatistics.
+
+	<b>Default:</b> 0 (unused blocks are not released automatically)
+
+	<b>Range:</b> [0, 2^24]<br>
+
+	\see nbContactDataBlocks maxNbContactDataBlocks PxScene.flushSimulation() PxSimulationStatistics.nbContactDataBlocksAllocated
+	*/
+	PxU32	contactDataBlockIdleFrames;
+
 	/**
 	\brief The maximum bias coefficient used in the constraint solver
 
@@ -995,6 +1032,7 @@ PX_INLINE PxSceneDesc::PxSceneDesc(const PxTolerancesScale& scale):
 
 	nbContactDataBlocks				(0),
 	maxNbContactDataBlocks			(1<<16),
+	contactDataBlockIdleFrames		(0),
 	maxBiasCoefficient				(PX_MAX_F32),
 	contactReportStreamBufferSize	(8192),
 	ccdMaxPasses					(1),
@@ -1056,6 +1094,8 @@ PX_INLINE bool PxSceneDesc::isValid() const
 
 	if(maxNbContactDataBlocks < nbContactDataBlocks)
 		return false;
+	if(contactDataBlockIdleFrames > (1<<24))
+		return false;
 
 	if(wakeCounterResetValue <= 0.0f)
 		return false;
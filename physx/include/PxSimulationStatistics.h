@@ -199,6 +199,27 @@ public:
 	*/
 	PxU32   peakConstraintMemory;
 
+	/**
+	\brief The number of 16K contact data blocks allocated by the scene at the end of the current simulation step.
+
+	\see PxSceneDesc.contactDataBlockIdleFrames
+	*/
+	PxU32   nbContactDataBlocksAllocated;
+
+	/**
+	\brief The peak number of 16K contact data blocks used during the current simulation step.
+
+	\see PxSceneDesc.maxNbContactDataBlocks
+	*/
+	PxU32   peakContactDataBlocksUsed;
+
+	/**
+	\brief The number of pairs whose contacts were reduced to a single patch because of low memory in the current simulation step.
+
+	\see PxSceneFlag::eREDUCE_CONTACTS_ON_LOW_MEMORY
+	*/
+	PxU32   nbReducedContactPairs;
+
 //broadphase:
 	/**
 	\brief Get number of broadphase volumes added for the current simulation step.
@@ -425,6 +446,9 @@ public:
 		compressedContactSize				(0),
 		requiredContactConstraintMemory		(0),
 		peakConstraintMemory				(0),
+		nbContactDataBlocksAllocated		(0),
+		peakContactDataBlocksUsed			(0),
+		nbReducedContactPairs				(0),
 		nbDiscreteContactPairsTotal			(0),
 		nbDiscreteContactPairsWithCacheHits	(0),
 		nbDiscreteContactPairsWithContacts	(0),
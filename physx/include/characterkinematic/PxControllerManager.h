@@ -33,6 +33,7 @@
 #include "foundation/PxFlags.h"
 #include "foundation/PxErrorCallback.h"
 #include "common/PxRenderBuffer.h"
+#include "characterkinematic/PxController.h"
 
 #if !PX_DOXYGEN
 namespace physx
@@ -45,6 +46,7 @@ class PxController;
 class PxControllerDesc;
 class PxObstacleContext;
 class PxControllerFilterCallback;
+class PxCpuDispatcher;
 
 /**
 \brief specifies debug-rendering flags
@@ -180,12 +182,62 @@ public:
 
 	If you only have one character in the scene, or if you can guarantee your characters will never overlap, then you do not need to call this function.
 
+	The characters' bounds are kept sorted from one call to the next, so that the cost of finding overlapping characters mostly
+	depends on how much they moved since the previous call.
+
 	\note Releasing the manager will automatically release all the associated obstacle contexts.
 
 	\param[in] elapsedTime	Elapsed time since last call
-	\param[in] cctFilterCb	Filtering callback for CCT-vs-CCT interactions
+	\param[in] cctFilterCb	Filtering callback for CCT-vs-CCT interactions. It is always called from the calling thread.
+	\param[in] dispatcher	Optional dispatcher used to resolve the overlapping pairs in parallel. The results do not depend on it.
+	*/
+	virtual	void				computeInteractions(PxF32 elapsedTime, PxControllerFilterCallback* cctFilterCb=NULL, PxCpuDispatcher* dispatcher=NULL) = 0;
+
+	/**
+	\brief Moves a batch of character controllers.
+
+	The results are the same as calling PxController::move() on each controller of the batch, in the order in which they appear
+	in the 'controllers' array, with the same minDist, elapsedTime, filters and obstacles parameters. The work is however distributed
+	over the worker threads of the provided dispatcher:
+
+	- the controllers are first partitioned into groups of potentially interacting characters, using conservative bounds around
+	the space each controller can reach during its move,
+	- the groups are then moved in parallel. The controllers of a given group are moved one after the other, in batch order,
+	so that CCT-vs-CCT interactions are resolved exactly like in a sequence of move() calls,
+	- finally the kinematic actors of the controllers are updated on the calling thread.
+
+	Controllers that are far away from each other end up in different groups, so large crowds spread over a level scale well.
+	Densely packed characters form large groups that are processed sequentially.
+
+	The motion bounds assume that a controller does not travel further than twice its displacement plus twice its step offset
+	(and its own size when the overlap recovery module is enabled). A controller pushed further away than that, for example by
+	the overlap recovery module resolving a deep penetration, can see CCTs from other groups at a different position than
+	a sequence of move() calls would.
+
+	\note The hit reports, behavior and filter callbacks of the controllers are called from the dispatcher's worker threads,
+	potentially concurrently for different controllers. The callbacks of a given controller are never called concurrently.
+	The order in which callbacks are invoked across controllers is unspecified.
+
+	\note When debug rendering is enabled (see #setDebugRenderingFlags()) all the controllers are moved on the calling thread.
+
+	\note If the scene has been created with PxSceneFlag::eREQUIRE_RW_LOCK, the function acquires the necessary read and write
+	locks itself. When a dispatcher is provided, it must be called without holding a scene lock.
+
+	\param[in] nbControllers	Number of controllers in the batch
+	\param[in] controllers		Controllers to move. They must belong to this manager and appear at most once in the batch.
+	\param[in] displacements	Displacement vectors, one per controller. See PxController::move().
+	\param[in] minDist			The minimum travelled distance to consider. See PxController::move().
+	\param[in] elapsedTime		Time elapsed since last call
+	\param[in] filters			User-defined filters for this move
+	\param[in] obstacles		Potential additional obstacles the CCTs should collide with.
+	\param[out] collisionFlags	Optional buffer receiving the collision flags of each controller (PxControllerCollisionFlag)
+	\param[in] dispatcher		Dispatcher used to run the moves in parallel. NULL to run everything on the calling thread.
+
+	\see PxController::move() PxControllerFilters PxObstacleContext
 	*/
-	virtual	void				computeInteractions(PxF32 elapsedTime, PxControllerFilterCallback* cctFilterCb=NULL) = 0;
+	virtual	void				moveBatch(PxU32 nbControllers, PxController* const* controllers, const PxVec3* displacements, PxF32 minDist, PxF32 elapsedTime,
+										const PxControllerFilters& filters, const PxObstacleContext* obstacles = NULL, PxControllerCollisionFlags* collisionFlags = NULL,
+										PxCpuDispatcher* dispatcher = NULL) = 0;
 
 	/**
 	\brief Enables or disables runtime tessellation.
@@ -249,6 +301,32 @@ public:
 	*/
 	virtual	void				setPreventVerticalSlidingAgainstCeiling(bool flag) = 0;
 
+	/**
+	\brief Enables or disables the shared static geometry cache.
+
+	By default each character controller queries the scene and extracts the touched static triangles on its own, whenever it
+	leaves its cached volume. With many characters in the same area, the same triangles are then extracted many times.
+
+	When the shared cache is enabled, the static geometry gathered by a controller is shared with the other controllers of the
+	manager, as a region of space hashed on a regular grid. A controller leaving its cached volume first looks for a shared region
+	containing its new temporal bounds. If it finds one, it adopts the region as its new cached volume and copies its geometry
+	instead of querying the scene. Regions are reference-counted by the controllers using them, and a limited number of unused
+	regions is kept for controllers following each other. Regions are invalidated when the scene's static objects change, or when
+	a cached shape or actor is released.
+
+	Only controllers using the same query filter data and the same tessellation, invisible wall and slope parameters share regions.
+	Controllers using a pre- or post-filter callback always query the scene directly.
+
+	The cell size should be in the order of a character's size. Regions are looked up in a few cells around a controller, so
+	smaller cells can miss regions that would have been usable.
+
+	By default, the shared cache is disabled.
+
+	\param[in] flag				True/false to enable/disable the shared cache.
+	\param[in] cellSize			Size of the grid cells. Must be positive.
+	*/
+	virtual	void				setSharedGeometryCache(bool flag, float cellSize) = 0;
+
 	/**
 	\brief Shift the origin of the character controllers and obstacle objects by the specified vector.
 
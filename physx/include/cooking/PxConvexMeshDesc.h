@@ -130,7 +130,18 @@ struct PxConvexFlag
 		numerical stability.
 		\note Is used only with eCOMPUTE_CONVEX flag.
 		*/
-		eSHIFT_VERTICES = (1 << 8)
+		eSHIFT_VERTICES = (1 << 8),
+
+		/**
+		\brief Cooks the hull as fast as possible, for applications creating many small hulls at runtime.
+
+		This implies eDISABLE_MESH_VALIDATION and eFAST_INERTIA_COMPUTATION, and the gauss map is never built
+		regardless of PxCookingParams::gaussMapLimit. Hulls with many vertices cooked with this flag are slower
+		to collide against, so it is best used for hulls below the gauss map limit.
+
+		\see PxCreateConvexMeshes()
+		*/
+		eFAST_HULL = (1 << 9)
 	};
 };
 
@@ -50,6 +50,7 @@ class PxInsertionCallback;
 class PxFoundation;
 class PxAllocatorCallback;
 class PxHeightFieldDesc;
+class PxCpuDispatcher;
 
 /**
 \brief Result from convex cooking.
@@ -357,6 +358,22 @@ struct PxCookingParams
 	*/
 	PxReal maxWeightRatioInTet;
 
+	/**
+	\brief Optional dispatcher used to spread the work of expensive cooking operations over several threads.
+
+	When set, triangle mesh cooking runs the BVH34 tree build, mesh cleaning and active edges / adjacency computation
+	on the dispatcher's worker threads, and PxCreateConvexMeshes() cooks several convex meshes in parallel. Signed distance
+	fields requested through PxSDFDesc are computed on the dispatcher as well, in which case
+	PxSDFDesc::numThreadsForSdfConstruction is ignored. The cooked
+	data is identical to the data produced without a dispatcher. The calling thread participates in the work and blocks
+	until it is done.
+
+	\note The dispatcher is only used for the duration of the cooking call. The BVH33 midphase is always built on a single thread.
+
+	<b>Default value:</b> NULL
+	*/
+	PxCpuDispatcher* cpuDispatcher;
+
 	PxCookingParams(const PxTolerancesScale& sc):
 		areaTestEpsilon					(0.06f*sc.length*sc.length),
 		planeTolerance					(0.0007f),
@@ -370,7 +387,8 @@ struct PxCookingParams
 		meshAreaMinLimit				(0.0f),
 		meshEdgeLengthMaxLimit			(500.0f),
 		gaussMapLimit					(32),
-		maxWeightRatioInTet             (FLT_MAX)
+		maxWeightRatioInTet             (FLT_MAX),
+		cpuDispatcher					(NULL)
 	{
 	}
 };
@@ -545,6 +563,28 @@ PX_FORCE_INLINE	physx::PxConvexMesh* PxCreateConvexMesh(const physx::PxCookingPa
 	return PxCreateConvexMesh(params, desc, *PxGetStandaloneInsertionCallback());
 }
 
+/**
+\brief Cooks and creates a batch of convex meshes without going through a stream.
+
+This does the same as calling PxCreateConvexMesh() for each descriptor, but the meshes are cooked in parallel
+on PxCookingParams::cpuDispatcher's worker threads when a dispatcher is provided. This is meant for applications
+creating large numbers of convex meshes at runtime, e.g. for destruction or user-generated content. Use
+PxConvexFlag::eFAST_HULL in the descriptors to further reduce the cooking time of small hulls.
+
+\note The insertion callback is always called from one thread at a time.
+
+\param[in] params				The cooking parameters
+\param[in] nbMeshes				The number of convex meshes to create
+\param[in] descs				The convex mesh descriptors to read the meshes from (nbMeshes entries)
+\param[out] meshes				The created convex meshes (nbMeshes entries). Meshes that failed to cook are set to NULL.
+\param[in] insertionCallback	The insertion interface from PxPhysics.
+\param[out] conditions			Optional results from convex mesh cooking (nbMeshes entries).
+\return The number of successfully created meshes
+
+\see PxCreateConvexMesh() PxCookingParams::cpuDispatcher PxConvexFlag::eFAST_HULL
+*/
+PX_C_EXPORT PX_PHYSX_COOKING_API	physx::PxU32 PxCreateConvexMeshes(const physx::PxCookingParams& params, physx::PxU32 nbMeshes, const physx::PxConvexMeshDesc* descs, physx::PxConvexMesh** meshes, physx::PxInsertionCallback& insertionCallback, physx::PxConvexMeshCookingResult::Enum* conditions=NULL);
+
 /**
 \brief Verifies if the convex mesh is valid. Prints an error message for each inconsistency found.
 
@@ -61,6 +61,27 @@ namespace physx
 		};
 	};
 
+	/**
+	\brief Callback to monitor and cancel the construction of a signed distance field on the CPU.
+
+	\see PxSDFDesc::progressCallback
+	*/
+	class PxSDFProgressCallback
+	{
+	public:
+		virtual ~PxSDFProgressCallback() {}
+
+		/**
+		\brief Reports the progress of the SDF construction.
+
+		Calls are serialized but can come from the dispatcher's worker threads if PxCookingParams::cpuDispatcher is set.
+
+		\param[in] progress The fraction of the work done so far, in the range [0, 1]
+		\return False to cancel the construction. Cooking of the mesh then fails.
+		*/
+		virtual bool onProgress(PxReal progress) = 0;
+	};
+
 	/**
 	\brief A structure describing signed distance field for mesh.
 	*/
@@ -153,6 +174,11 @@ namespace physx
 		*/
 		PxSDFBuilder* sdfBuilder;
 
+		/**
+		\brief Optional callback to report progress and to cancel the SDF construction. Not used if sdfBuilder is set.
+		*/
+		PxSDFProgressCallback* progressCallback;
+
 		/**
 		\brief Constructor
 		*/
@@ -181,6 +207,7 @@ namespace physx
 		narrowBandThicknessRelativeToSdfBoundsDiagonal = 0.01f;
 		numThreadsForSdfConstruction = 1;
 		sdfBuilder = NULL;
+		progressCallback = NULL;
 	}
 
 	PX_INLINE bool PxSDFDesc::isValid() const
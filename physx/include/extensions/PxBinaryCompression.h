@@ -0,0 +1,193 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2024 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PX_BINARY_COMPRESSION_H
+#define PX_BINARY_COMPRESSION_H
+
+#include "PxPhysXConfig.h"
+#include "foundation/PxFlags.h"
+#include "foundation/PxIO.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxCpuDispatcher;
+
+	/**
+	\brief Flags for PxBinaryCompressionParams.
+	*/
+	struct PxBinaryCompressionFlag
+	{
+		enum Enum
+		{
+			/**
+			\brief Tries a lossless byte-shuffle filter on each chunk, and keeps it when the result is smaller.
+
+			The filter groups the bytes of consecutive 32-bit words by significance, which typically makes float data (vertices,
+			normals, transforms) much more compressible. It makes compression about twice slower and decompression slightly slower.
+			*/
+			eSHUFFLE_FLOATS	= (1<<0)
+		};
+	};
+
+	typedef PxFlags<PxBinaryCompressionFlag::Enum, PxU32> PxBinaryCompressionFlags;
+	PX_FLAGS_OPERATORS(PxBinaryCompressionFlag::Enum, PxU32)
+
+	/**
+	\brief Parameters for PxCreateCompressedOutputStream().
+	*/
+	struct PxBinaryCompressionParams
+	{
+		PxBinaryCompressionParams() :
+			chunkSize	(256*1024),
+			dispatcher	(NULL)
+		{
+		}
+
+		/**
+		\brief Size of the chunks the data is split into, before compression.
+
+		Chunks are compressed and decompressed independently, possibly in parallel. Smaller chunks give more parallelism and less
+		memory overhead, larger chunks give better compression ratios.
+
+		<b>Range:</b> [4096, 64MB]<br>
+		<b>Default:</b> 256KB
+		*/
+		PxU32						chunkSize;
+
+		/**
+		\brief Compression flags.
+		*/
+		PxBinaryCompressionFlags	flags;
+
+		/**
+		\brief Optional dispatcher used to compress chunks in parallel.
+
+		Without a dispatcher the compression runs on the calling thread.
+		*/
+		PxCpuDispatcher*			dispatcher;
+
+		/**
+		\brief Returns true if the parameters are valid.
+		*/
+		PX_INLINE bool isValid() const
+		{
+			return chunkSize>=4096 && chunkSize<=64*1024*1024;
+		}
+	};
+
+	/**
+	\brief Output stream compressing the data written to it.
+
+	The stream wraps another PxOutputStream and writes a compressed container to it. It can be passed to any function writing to
+	a PxOutputStream, e.g. PxSerialization::serializeCollectionToBinary or the cooking functions. The data is split into chunks that
+	are compressed independently with a built-in LZ codec, so that decompression can run in parallel and does not need the whole
+	compressed data in memory.
+
+	finish() must be called once all the data has been written.
+
+	\see PxCreateCompressedOutputStream PxDecompressBinaryData
+	*/
+	class PxCompressedOutputStream : public PxOutputStream
+	{
+		public:
+
+		/**
+		\brief Compresses the buffered data and writes the end of the container.
+
+		No data can be written to the stream afterwards.
+
+		\return True if all the data could be written to the wrapped stream.
+		*/
+		virtual	bool	finish()	= 0;
+
+		/**
+		\brief Returns the number of bytes written to the stream so far, i.e. the uncompressed size.
+		*/
+		virtual	PxU32	getUncompressedSize()	const	= 0;
+
+		/**
+		\brief Returns the number of bytes written to the wrapped stream so far, i.e. the compressed size.
+		*/
+		virtual	PxU32	getCompressedSize()	const	= 0;
+
+		/**
+		\brief Releases the stream. Does not call finish().
+		*/
+		virtual	void	release()	= 0;
+
+		protected:
+		virtual	~PxCompressedOutputStream()	{}
+	};
+
+	/**
+	\brief Creates a compressed output stream.
+
+	\param[in] stream	Stream receiving the compressed container. Must stay valid until the compressed stream is released.
+	\param[in] params	Compression parameters
+	\return The new stream, or NULL if the parameters are invalid.
+
+	\see PxCompressedOutputStream
+	*/
+	PxCompressedOutputStream*	PxCreateCompressedOutputStream(PxOutputStream& stream, const PxBinaryCompressionParams& params = PxBinaryCompressionParams());
+
+	/**
+	\brief Returns the uncompressed size of a compressed container.
+
+	\param[in] data	Compressed container, as written by a PxCompressedOutputStream. The read position is restored on return.
+	\return The uncompressed size, or 0 if the data is not a valid container.
+	*/
+	PxU32	PxGetDecompressedSize(PxInputData& data);
+
+	/**
+	\brief Decompresses a compressed container.
+
+	The container is read from the current position sequentially, a batch of chunks at a time, and each batch is decompressed in
+	parallel when a dispatcher is provided. The destination can be the 128-byte aligned memory block passed to
+	PxSerialization::createCollectionFromBinary, or a buffer wrapped in a PxDefaultMemoryInputData for cooked data.
+
+	\param[in] data			Compressed container, as written by a PxCompressedOutputStream.
+	\param[out] dst			Destination buffer
+	\param[in] dstSize		Size of the destination buffer. Must be at least the size returned by PxGetDecompressedSize.
+	\param[in] dispatcher	Optional dispatcher used to decompress chunks in parallel.
+	\return True if the data was valid and could be fully decompressed.
+
+	\note The container structure and the compressed streams are validated, but the container does not store checksums: corrupted
+	literal bytes or stored chunks are not detected.
+
+	\see PxGetDecompressedSize PxCompressedOutputStream
+	*/
+	bool	PxDecompressBinaryData(PxInputData& data, void* dst, PxU32 dstSize, PxCpuDispatcher* dispatcher = NULL);
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
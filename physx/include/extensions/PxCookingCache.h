@@ -0,0 +1,189 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2024 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PX_COOKING_CACHE_H
+#define PX_COOKING_CACHE_H
+
+#include "PxPhysXConfig.h"
+#include "cooking/PxCooking.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxPhysics;
+	class PxOutputStream;
+	class PxTriangleMesh;
+	class PxConvexMesh;
+
+	/**
+	\brief Descriptor for PxCookingCache.
+
+	\see PxCreateCookingCache
+	*/
+	class PxCookingCacheDesc
+	{
+		public:
+
+		/**
+		\brief Directory of the on-disk store. It must exist and be writable.
+
+		Several caches, in the same or in different processes, can share a directory. The string is copied.
+		*/
+		const char*	directory;
+
+		/**
+		\brief Maximum total size of the cached data, in bytes. Least recently used entries are evicted beyond this size.
+
+		Zero means unlimited.
+
+		<b>Default:</b> 0
+		*/
+		PxU64		maxSize;
+
+		PX_INLINE PxCookingCacheDesc() :
+			directory	(NULL),
+			maxSize		(0)
+		{
+		}
+
+		/**
+		\brief Returns true if the descriptor is valid.
+		*/
+		PX_INLINE bool isValid() const
+		{
+			return directory && directory[0];
+		}
+	};
+
+	/**
+	\brief Statistics of a PxCookingCache.
+
+	\see PxCookingCache::getStats
+	*/
+	struct PxCookingCacheStats
+	{
+		PxU32	nbHits;			//!< Number of requests served from the store since the cache was created
+		PxU32	nbMisses;		//!< Number of requests that had to be cooked since the cache was created
+		PxU32	nbEvictions;	//!< Number of entries evicted since the cache was created
+		PxU32	nbEntries;		//!< Number of entries currently tracked by the cache
+		PxU64	size;			//!< Total size of the tracked entries, in bytes
+	};
+
+	/**
+	\brief Content-addressed store for cooked meshes.
+
+	The cache computes a hash of the mesh descriptor's data and of the cooking parameters that affect the cooked data, and looks up
+	the cooked data in a directory before cooking. Cooked data is added to the directory after cooking, so identical meshes are
+	cooked only once, across runs. The functions mirror PxCookTriangleMesh(), PxCreateTriangleMesh(), PxCookConvexMesh() and
+	PxCreateConvexMesh() and produce the same data.
+
+	The hash covers the vertices, indices, material indices, flags and SDF settings of the descriptors. PxCookingParams::cpuDispatcher,
+	PxSDFDesc::sdfBuilder, PxSDFDesc::progressCallback and PxSDFDesc::numThreadsForSdfConstruction are ignored since they do not
+	change the cooked data. When the data comes from the store, the output members of PxSDFDesc are not written.
+
+	All functions are thread-safe. The same mesh cooked concurrently on several threads may be cooked more than once, with the same
+	result. The usage order used for eviction is saved in the directory by flush() and release().
+
+	\see PxCreateCookingCache PxCookingCacheDesc
+	*/
+	class PxCookingCache
+	{
+		public:
+
+		/**
+		\brief Cooks a triangle mesh to a stream, or copies the cooked data from the store.
+
+		\see PxCookTriangleMesh
+		*/
+		virtual	bool				cookTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxOutputStream& stream, PxTriangleMeshCookingResult::Enum* condition = NULL)	= 0;
+
+		/**
+		\brief Creates a triangle mesh, from the store if possible.
+
+		\see PxCreateTriangleMesh
+		*/
+		virtual	PxTriangleMesh*		createTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxPhysics& physics, PxTriangleMeshCookingResult::Enum* condition = NULL)	= 0;
+
+		/**
+		\brief Cooks a convex mesh to a stream, or copies the cooked data from the store.
+
+		\see PxCookConvexMesh
+		*/
+		virtual	bool				cookConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition = NULL)	= 0;
+
+		/**
+		\brief Creates a convex mesh, from the store if possible.
+
+		\see PxCreateConvexMesh
+		*/
+		virtual	PxConvexMesh*		createConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxPhysics& physics, PxConvexMeshCookingResult::Enum* condition = NULL)	= 0;
+
+		/**
+		\brief Retrieves statistics.
+		*/
+		virtual	void				getStats(PxCookingCacheStats& stats)	const	= 0;
+
+		/**
+		\brief Saves the usage order of the entries to the directory.
+
+		Entries saved by other caches sharing the directory since it was last read are merged first, and count against
+		PxCookingCacheDesc::maxSize.
+		*/
+		virtual	void				flush()	= 0;
+
+		/**
+		\brief Removes all the tracked entries from the directory.
+		*/
+		virtual	void				clear()	= 0;
+
+		/**
+		\brief Saves the usage order of the entries and releases the cache. The directory is kept.
+		*/
+		virtual	void				release()	= 0;
+
+		protected:
+		virtual	~PxCookingCache()	{}
+	};
+
+	/**
+	\brief Creates a cooking cache.
+
+	\param[in] desc	Cache descriptor
+	\return The new cache, or NULL if the descriptor is invalid.
+
+	\see PxCookingCache PxCookingCacheDesc
+	*/
+	PxCookingCache*	PxCreateCookingCache(const PxCookingCacheDesc& desc);
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
@@ -62,6 +62,12 @@
 #include "extensions/PxSamplingExt.h"
 #include "extensions/PxTetrahedronMeshExt.h"
 #include "extensions/PxCustomGeometryExt.h"
+#include "extensions/PxWorldStreamer.h"
+#include "extensions/PxBinaryCompression.h"
+#include "extensions/PxTiledHeightField.h"
+#include "extensions/PxCookingCache.h"
+#include "extensions/PxImmediatePairCache.h"
+#include "extensions/PxImmediateScene.h"
 #if PX_ENABLE_FEATURES_UNDER_CONSTRUCTION
 #include "extensions/PxFEMClothExt.h"
 #endif
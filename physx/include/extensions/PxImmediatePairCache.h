@@ -0,0 +1,195 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2024 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+#ifndef PX_IMMEDIATE_PAIR_CACHE_H
+#define PX_IMMEDIATE_PAIR_CACHE_H
+
+#include "PxPhysXConfig.h"
+#include "collision/PxCollisionDefs.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	#define PX_INVALID_IMMEDIATE_PAIR	0xffffffff	//!< Invalid PxImmediatePairCache pair handle
+
+	/**
+	\brief Descriptor for PxImmediatePairCache.
+
+	\see PxCreateImmediatePairCache
+	*/
+	class PxImmediatePairCacheDesc
+	{
+		public:
+
+		/**
+		\brief A pair that has not been used for this many frames is evicted by PxImmediatePairCache::beginFrame(). Zero disables eviction.
+
+		<b>Default:</b> 4
+		*/
+		PxU32	maxStaleFrames;
+
+		/**
+		\brief Every this many frames, PxImmediatePairCache::beginFrame() returns the unused pooled memory to the allocator. Zero disables compaction.
+
+		<b>Default:</b> 64
+		*/
+		PxU32	compactionInterval;
+
+		PX_INLINE PxImmediatePairCacheDesc() :
+			maxStaleFrames		(4),
+			compactionInterval	(64)
+		{
+		}
+	};
+
+	/**
+	\brief Statistics of a PxImmediatePairCache.
+
+	\see PxImmediatePairCache::getStats
+	*/
+	struct PxImmediatePairCacheStats
+	{
+		PxU32	nbPairs;			//!< Number of pairs in the cache
+		PxU32	nbEvictedPairs;		//!< Number of stale pairs evicted by the last beginFrame() call
+		PxU32	nbBlocks;			//!< Number of cache blocks owned by pairs or allocated during the current frame
+		PxU32	nbPages;			//!< Number of pooled memory pages, used or not
+	};
+
+	/**
+	\brief Persistent contact caches for immediate::PxGenerateContacts().
+
+	The cache owns the PxCache of each pair of geometries and the memory it points to, so that contact generation is warm-started from the
+	previous frame as in PxScene. Pairs are keyed by two user geometry IDs; the key is unordered but the geometries must be passed to
+	PxGenerateContacts() in the same order for the lifetime of a pair.
+
+	Cache data is allocated from pooled blocks by the allocators returned by getCacheAllocator(). A block that is not referenced by a pair
+	anymore is recycled by the next beginFrame() call, and pages of unused blocks are released every PxImmediatePairCacheDesc::compactionInterval
+	frames. Pairs that are not used for PxImmediatePairCacheDesc::maxStaleFrames frames are evicted.
+
+	A frame looks like this:
+
+	\code
+	pairCache->beginFrame(nbThreads);
+	// Single-threaded: look up the pairs of the frame, e.g. the broadphase pairs
+	handle = pairCache->acquirePair(id0, id1);
+	// Multi-threaded: thread i generates the contacts of its pairs with the allocator of context i
+	PxGenerateContacts(&geom0, &geom1, &pose0, &pose1, &pairCache->getCache(handle), 1, recorder, contactDistance, meshContactMargin,
+						toleranceLength, pairCache->getCacheAllocator(i));
+	\endcode
+
+	Contacts of a pair must be generated at most once per frame, and only with the allocators of the pair cache.
+
+	\see PxCreateImmediatePairCache immediate::PxGenerateContacts
+	*/
+	class PxImmediatePairCache
+	{
+		public:
+
+		/**
+		\brief Starts a new frame.
+
+		Recycles the blocks released by the previous frame, evicts stale pairs and compacts the pooled memory when due. Must not be called
+		while contacts are generated.
+
+		\param[in] nbContexts	Number of allocators used during the frame, i.e. the number of threads or tasks generating contacts concurrently.
+		*/
+		virtual	void				beginFrame(PxU32 nbContexts)	= 0;
+
+		/**
+		\brief Finds or creates the pair of two geometry IDs and marks it as used in the current frame.
+
+		Not thread-safe. The handle stays valid until the pair is released or evicted.
+
+		\param[in] id0	First geometry ID
+		\param[in] id1	Second geometry ID, different from id0
+		\return The pair handle
+		*/
+		virtual	PxU32				acquirePair(PxU32 id0, PxU32 id1)	= 0;
+
+		/**
+		\brief Returns the handle of the pair of two geometry IDs, or PX_INVALID_IMMEDIATE_PAIR if the pair is not in the cache.
+		*/
+		virtual	PxU32				findPair(PxU32 id0, PxU32 id1)	const	= 0;
+
+		/**
+		\brief Returns the contact cache of a pair, to pass to immediate::PxGenerateContacts(), and marks the pair as used in the current frame.
+
+		Can be called concurrently for different pairs.
+		*/
+		virtual	PxCache&			getCache(PxU32 pairHandle)	= 0;
+
+		/**
+		\brief Returns the allocator of a context, to pass to immediate::PxGenerateContacts().
+
+		An allocator must not be used by several threads at the same time.
+
+		\param[in] contextIndex	Index of the context, smaller than the number passed to the last beginFrame() call
+		*/
+		virtual	PxCacheAllocator&	getCacheAllocator(PxU32 contextIndex)	= 0;
+
+		/**
+		\brief Releases a pair and its cache. Not thread-safe.
+		*/
+		virtual	void				releasePair(PxU32 pairHandle)	= 0;
+
+		/**
+		\brief Releases all pairs involving a geometry ID, e.g. when the geometry is removed. Not thread-safe.
+		*/
+		virtual	void				releasePairs(PxU32 id)	= 0;
+
+		/**
+		\brief Retrieves the statistics of the cache.
+		*/
+		virtual	void				getStats(PxImmediatePairCacheStats& stats)	const	= 0;
+
+		/**
+		\brief Releases the cache and all pooled memory.
+		*/
+		virtual	void				release()	= 0;
+
+		protected:
+		virtual	~PxImmediatePairCache()	{}
+	};
+
+	/**
+	\brief Creates a pair cache for immediate mode contact generation.
+
+	\param[in] desc	Cache descriptor
+	\return The new cache
+
+	\see PxImmediatePairCache PxImmediatePairCacheDesc
+	*/
+	PxImmediatePairCache*	PxCreateImmediatePairCache(const PxImmediatePairCacheDesc& desc = PxImmediatePairCacheDesc());
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
@@ -0,0 +1,393 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2024 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+
+#ifndef PX_IMMEDIATE_SCENE_H
+#define PX_IMMEDIATE_SCENE_H
+
+#include "PxPhysXConfig.h"
+#include "PxActor.h"
+#include "PxSceneDesc.h"
+#include "common/PxTolerancesScale.h"
+#include "geometry/PxGeometry.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxCpuDispatcher;
+
+	#define PX_INVALID_IMMEDIATE_BODY	0xffffffff	//!< Invalid PxImmediateScene body index
+
+	/**
+	\brief Descriptor for PxImmediateScene.
+
+	The unit-dependent defaults follow PxSceneDesc and PxShape.
+
+	\see PxCreateImmediateScene
+	*/
+	class PxImmediateSceneDesc
+	{
+		public:
+
+		/**
+		\brief Gravity vector.
+
+		<b>Default:</b> Zero
+		*/
+		PxVec3					gravity;
+
+		/**
+		\brief Solver used by the scene. eTGS is simulated with nbPositionIterations substeps, as in PxScene.
+
+		<b>Default:</b> PxSolverType::ePGS
+		*/
+		PxSolverType::Enum		solverType;
+
+		/**
+		\brief Number of solver position iterations. Range: [1, 255]
+
+		<b>Default:</b> 4
+		*/
+		PxU32					nbPositionIterations;
+
+		/**
+		\brief Number of solver velocity iterations. Range: [0, 255]
+
+		<b>Default:</b> 1
+		*/
+		PxU32					nbVelocityIterations;
+
+		/**
+		\brief Contact offset of all bodies. Pairs are reported by the broadphase and contacts are generated once bodies are closer than twice this distance.
+
+		<b>Default:</b> 0.02 * PxTolerancesScale::length
+		*/
+		PxReal					contactOffset;
+
+		/**
+		\brief Mesh contact margin passed to immediate::PxGenerateContacts().
+
+		<b>Default:</b> 0.01 * PxTolerancesScale::length
+		*/
+		PxReal					meshContactMargin;
+
+		/**
+		\brief Tolerance length passed to immediate::PxGenerateContacts().
+
+		<b>Default:</b> PxTolerancesScale::length
+		*/
+		PxReal					toleranceLength;
+
+		/**
+		\brief A contact with a relative velocity below this will not bounce. See PxSceneDesc::bounceThresholdVelocity.
+
+		<b>Default:</b> 0.2 * PxTolerancesScale::speed
+		*/
+		PxReal					bounceThresholdVelocity;
+
+		/**
+		\brief See PxSceneDesc::frictionOffsetThreshold.
+
+		<b>Default:</b> 0.04 * PxTolerancesScale::length
+		*/
+		PxReal					frictionOffsetThreshold;
+
+		/**
+		\brief See PxSceneDesc::frictionCorrelationDistance.
+
+		<b>Default:</b> 0.025 * PxTolerancesScale::length
+		*/
+		PxReal					frictionCorrelationDistance;
+
+		/**
+		\brief Dispatcher used to run the narrowphase and the islands of the scene in parallel, or NULL to run on the calling thread.
+
+		<b>Default:</b> NULL
+		*/
+		PxCpuDispatcher*		cpuDispatcher;
+
+		PX_INLINE PxImmediateSceneDesc(const PxTolerancesScale& scale) :
+			gravity						(PxVec3(0.0f)),
+			solverType					(PxSolverType::ePGS),
+			nbPositionIterations		(4),
+			nbVelocityIterations		(1),
+			contactOffset				(0.02f * scale.length),
+			meshContactMargin			(0.01f * scale.length),
+			toleranceLength				(scale.length),
+			bounceThresholdVelocity		(0.2f * scale.speed),
+			frictionOffsetThreshold		(0.04f * scale.length),
+			frictionCorrelationDistance	(0.025f * scale.length),
+			cpuDispatcher				(NULL)
+		{
+		}
+
+		/**
+		\brief Returns true if the descriptor is valid.
+		*/
+		PX_INLINE bool isValid() const
+		{
+			return	gravity.isFinite()
+				&&	(solverType==PxSolverType::ePGS || solverType==PxSolverType::eTGS)
+				&&	nbPositionIterations>=1 && nbPositionIterations<=255
+				&&	nbVelocityIterations<=255
+				&&	contactOffset>0.0f && meshContactMargin>0.0f && toleranceLength>0.0f
+				&&	bounceThresholdVelocity>0.0f && frictionOffsetThreshold>0.0f && frictionCorrelationDistance>0.0f;
+		}
+	};
+
+	/**
+	\brief Descriptor for a body of a PxImmediateScene.
+
+	A body has a single geometry. The body frame is the center of mass frame, with axes along the principal axes of inertia, and the
+	geometry is placed at localPose in that frame. Static bodies only use geometry, pose, localPose, the material and userData.
+
+	Dynamic bodies can be spheres, capsules, boxes or convex meshes. Static bodies can also be planes, triangle meshes and heightfields.
+	The geometry is copied but meshes are referenced, so they must outlive the body.
+
+	\see PxImmediateScene::createBody
+	*/
+	class PxImmediateBodyDesc
+	{
+		public:
+		const PxGeometry*	geometry;					//!< The geometry of the body
+		PxTransform			localPose;					//!< Pose of the geometry in the body frame. <b>Default:</b> Identity
+		PxTransform			pose;						//!< Pose of the body frame in world space. <b>Default:</b> Identity
+		PxActorType::Enum	type;						//!< eRIGID_STATIC or eRIGID_DYNAMIC. <b>Default:</b> eRIGID_DYNAMIC
+
+		PxReal				mass;						//!< Mass of a dynamic body. Zero means infinite. <b>Default:</b> 1
+		PxVec3				massSpaceInertiaTensor;		//!< Diagonal inertia tensor of a dynamic body. Zero components mean infinite. <b>Default:</b> (1,1,1)
+		PxVec3				linearVelocity;				//!< Initial linear velocity. <b>Default:</b> Zero
+		PxVec3				angularVelocity;			//!< Initial angular velocity. <b>Default:</b> Zero
+		PxReal				linearDamping;				//!< See PxRigidBody::setLinearDamping. <b>Default:</b> 0
+		PxReal				angularDamping;				//!< See PxRigidBody::setAngularDamping. <b>Default:</b> 0.05
+		PxReal				maxLinearVelocity;			//!< See PxRigidBody::setMaxLinearVelocity. <b>Default:</b> 1e16
+		PxReal				maxAngularVelocity;			//!< See PxRigidBody::setMaxAngularVelocity. <b>Default:</b> 100
+		PxReal				maxDepenetrationVelocity;	//!< See PxRigidBody::setMaxDepenetrationVelocity. <b>Default:</b> PX_MAX_F32
+		PxReal				maxContactImpulse;			//!< See PxRigidBody::setMaxContactImpulse. <b>Default:</b> PX_MAX_F32
+
+		PxReal				staticFriction;				//!< Static friction. The values of two bodies are averaged. <b>Default:</b> 0.5
+		PxReal				dynamicFriction;			//!< Dynamic friction. The values of two bodies are averaged. <b>Default:</b> 0.5
+		PxReal				restitution;				//!< Restitution. The values of two bodies are averaged. <b>Default:</b> 0
+
+		void*				userData;					//!< User data. <b>Default:</b> NULL
+
+		PX_INLINE PxImmediateBodyDesc() :
+			geometry					(NULL),
+			localPose					(PxIdentity),
+			pose						(PxIdentity),
+			type						(PxActorType::eRIGID_DYNAMIC),
+			mass						(1.0f),
+			massSpaceInertiaTensor		(1.0f),
+			linearVelocity				(0.0f),
+			angularVelocity				(0.0f),
+			linearDamping				(0.0f),
+			angularDamping				(0.05f),
+			maxLinearVelocity			(1e16f),
+			maxAngularVelocity			(100.0f),
+			maxDepenetrationVelocity	(PX_MAX_F32),
+			maxContactImpulse			(PX_MAX_F32),
+			staticFriction				(0.5f),
+			dynamicFriction				(0.5f),
+			restitution					(0.0f),
+			userData					(NULL)
+		{
+		}
+
+		/**
+		\brief Returns true if the descriptor is valid.
+		*/
+		PX_INLINE bool isValid() const
+		{
+			if(!geometry || !localPose.isValid() || !pose.isValid())
+				return false;
+			if(staticFriction<0.0f || dynamicFriction<0.0f || restitution<0.0f || restitution>1.0f)
+				return false;
+			if(type==PxActorType::eRIGID_STATIC)
+				return true;
+			if(type!=PxActorType::eRIGID_DYNAMIC)
+				return false;
+
+			const PxGeometryType::Enum geomType = geometry->getType();
+			if(geomType!=PxGeometryType::eSPHERE && geomType!=PxGeometryType::eCAPSULE && geomType!=PxGeometryType::eBOX && geomType!=PxGeometryType::eCONVEXMESH)
+				return false;
+
+			return	mass>=0.0f && massSpaceInertiaTensor.x>=0.0f && massSpaceInertiaTensor.y>=0.0f && massSpaceInertiaTensor.z>=0.0f
+				&&	linearVelocity.isFinite() && angularVelocity.isFinite() && linearDamping>=0.0f && angularDamping>=0.0f
+				&&	maxLinearVelocity>=0.0f && maxAngularVelocity>=0.0f && maxDepenetrationVelocity>0.0f && maxContactImpulse>=0.0f;
+		}
+	};
+
+	/**
+	\brief Statistics of the last PxImmediateScene::simulate() call.
+
+	\see PxImmediateScene::getStats
+	*/
+	struct PxImmediateSceneStats
+	{
+		PxU32	nbPairs;			//!< Number of broadphase pairs, i.e. pairs that went through contact generation
+		PxU32	nbTouchingPairs;	//!< Number of pairs with contacts
+		PxU32	nbContacts;			//!< Number of contact points
+		PxU32	nbIslands;			//!< Number of islands, including isolated dynamic bodies
+		PxU32	nbSolverBatches;	//!< Number of groups of islands solved together, i.e. the number of parallel solver tasks
+	};
+
+	/**
+	\brief A small rigid body world simulated with the immediate mode API.
+
+	The scene runs the pipeline that the immediate mode functions leave to the user: an incremental PxAABBManager broadphase, persistent
+	pairs keeping contact caches (in a PxImmediatePairCache) and friction anchors from frame to frame, contact generation, island
+	generation and per-island solver setup, solve and integration.
+
+	Contact generation and islands run in parallel on the scene's dispatcher. Small islands are grouped so that each task has enough work,
+	and a single large island is solved by a single task. Several scenes can be simulated in parallel with PxSimulateImmediateScenes().
+	The results do not depend on the number of threads.
+
+	Bodies do not sleep, and there are no kinematic bodies, joints, articulations, filtering or contact reports. Scenes are not thread-safe:
+	a scene must not be accessed while it is simulated, but different scenes can be used on different threads.
+
+	\see PxCreateImmediateScene PxSimulateImmediateScenes
+	*/
+	class PxImmediateScene
+	{
+		public:
+
+		/**
+		\brief Creates a body.
+
+		\param[in] desc	Body descriptor
+		\return The index of the new body, or PX_INVALID_IMMEDIATE_BODY if the descriptor is invalid. Indices of released bodies are reused.
+		*/
+		virtual	PxU32				createBody(const PxImmediateBodyDesc& desc)	= 0;
+
+		/**
+		\brief Releases a body.
+		*/
+		virtual	void				releaseBody(PxU32 body)	= 0;
+
+		/**
+		\brief Returns the number of bodies.
+		*/
+		virtual	PxU32				getNbBodies()	const	= 0;
+
+		/**
+		\brief Teleports a body.
+		*/
+		virtual	void				setGlobalPose(PxU32 body, const PxTransform& pose)	= 0;
+
+		/**
+		\brief Returns the pose of a body.
+		*/
+		virtual	PxTransform			getGlobalPose(PxU32 body)	const	= 0;
+
+		/**
+		\brief Sets the linear velocity of a dynamic body.
+		*/
+		virtual	void				setLinearVelocity(PxU32 body, const PxVec3& velocity)	= 0;
+
+		/**
+		\brief Returns the linear velocity of a body.
+		*/
+		virtual	PxVec3				getLinearVelocity(PxU32 body)	const	= 0;
+
+		/**
+		\brief Sets the angular velocity of a dynamic body.
+		*/
+		virtual	void				setAngularVelocity(PxU32 body, const PxVec3& velocity)	= 0;
+
+		/**
+		\brief Returns the angular velocity of a body.
+		*/
+		virtual	PxVec3				getAngularVelocity(PxU32 body)	const	= 0;
+
+		/**
+		\brief Returns the user data of a body.
+		*/
+		virtual	void*				getUserData(PxU32 body)	const	= 0;
+
+		/**
+		\brief Sets the gravity vector.
+		*/
+		virtual	void				setGravity(const PxVec3& gravity)	= 0;
+
+		/**
+		\brief Returns the gravity vector.
+		*/
+		virtual	PxVec3				getGravity()	const	= 0;
+
+		/**
+		\brief Advances the scene by dt.
+
+		\param[in] dt	Time step. Must be positive.
+		*/
+		virtual	void				simulate(PxReal dt)	= 0;
+
+		/**
+		\brief Retrieves statistics of the last simulate() call.
+		*/
+		virtual	void				getStats(PxImmediateSceneStats& stats)	const	= 0;
+
+		/**
+		\brief Releases the scene and its bodies.
+		*/
+		virtual	void				release()	= 0;
+
+		protected:
+		virtual	~PxImmediateScene()	{}
+	};
+
+	/**
+	\brief Creates an immediate mode scene.
+
+	\param[in] desc	Scene descriptor
+	\return The new scene, or NULL if the descriptor is invalid.
+
+	\see PxImmediateScene PxImmediateSceneDesc
+	*/
+	PxImmediateScene*	PxCreateImmediateScene(const PxImmediateSceneDesc& desc);
+
+	/**
+	\brief Simulates several scenes in parallel.
+
+	Each scene is simulated as with PxImmediateScene::simulate(), and can in turn use its own dispatcher, which can be the same one.
+
+	\param[in] nbScenes		Number of scenes
+	\param[in] scenes		Scenes to simulate. They must all be different.
+	\param[in] dt			Time step. Must be positive.
+	\param[in] dispatcher	Dispatcher used to run the scenes in parallel, or NULL to simulate them one after the other on the calling thread.
+
+	\see PxImmediateScene::simulate
+	*/
+	void	PxSimulateImmediateScenes(PxU32 nbScenes, PxImmediateScene* const* scenes, PxReal dt, PxCpuDispatcher* dispatcher);
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
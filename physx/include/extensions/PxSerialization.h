@@ -41,7 +41,7 @@
 PX_BINARY_SERIAL_VERSION is used to version the PhysX binary data and meta data. The global unique identifier of the PhysX SDK needs to match 
 the one in the data and meta data, otherwise they are considered incompatible. A 32 character wide GUID can be generated with https://www.guidgenerator.com/ for example. 
 */
-#define PX_BINARY_SERIAL_VERSION "B57177A5EF424885A73E41854E472FC4"
+#define PX_BINARY_SERIAL_VERSION "7CF5BBB865294962B7A4E6CF38D2210B"
 
 
 #if !PX_DOXYGEN
@@ -50,6 +50,7 @@ namespace physx
 #endif
 
 	class PxBinaryConverter;
+	class PxCpuDispatcher;
 
 /**
 \brief Utility functions for serialization
@@ -180,13 +181,20 @@ public:
 	which is defined by "PX_PHYSICS_VERSION_MAJOR.PX_PHYSICS_VERSION_MINOR.PX_PHYSICS_VERSION_BUGFIX-PX_BINARY_SERIAL_VERSION".
 	For a list of compatible sdk releases refer to the documentation of PX_BINARY_SERIAL_VERSION.
 
+	If a CPU dispatcher is provided, materials, meshes, height fields, shapes and rigid actors are created in parallel on the
+	dispatcher's worker threads, one object type group at a time. All other objects are created afterwards on the calling thread.
+	The resulting collection is identical to the one created without a dispatcher, including the order of its objects.
+	The parallel path requires the extra data offsets written by PxSerialization::serializeCollectionToBinary. Data converted
+	to a different platform with PxBinaryConverter does not contain these offsets and is always deserialized on the calling thread.
+
 	\param[in] memBlock Pointer to memory block containing the serialized collection
 	\param[in] sr PxSerializationRegistry instance with information about registered classes.
 	\param[in] externalRefs Collection to resolve external dependencies
+	\param[in] dispatcher Optional CPU dispatcher used to create objects in parallel. The call still blocks until the collection is complete.
 
 	\see PxCollection, PxSerialization::complete, PxSerialization::serializeCollectionToBinary, PxSerializationRegistry, PX_BINARY_SERIAL_VERSION
 	*/
-	static	PxCollection*	createCollectionFromBinary(void* memBlock, PxSerializationRegistry& sr, const PxCollection* externalRefs = NULL);
+	static	PxCollection*	createCollectionFromBinary(void* memBlock, PxSerializationRegistry& sr, const PxCollection* externalRefs = NULL, PxCpuDispatcher* dispatcher = NULL);
 
 	/**
 	\brief Serializes a physics collection to an XML output stream.
@@ -0,0 +1,269 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2024 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PX_TILED_HEIGHT_FIELD_H
+#define PX_TILED_HEIGHT_FIELD_H
+
+#include "PxPhysXConfig.h"
+#include "geometry/PxCustomGeometry.h"
+#include "geometry/PxHeightFieldSample.h"
+#include "geometry/PxHeightFieldGeometry.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxPhysics;
+
+	/**
+	\brief User callback providing the samples of a PxTiledHeightField's pages on demand.
+
+	\see PxTiledHeightFieldDesc
+	*/
+	class PxTiledHeightFieldPageSource
+	{
+		public:
+
+		/**
+		\brief Provides the samples of a page.
+
+		Called the first time a page is needed, and again after the page has been released by PxTiledHeightField::update().
+		Calls are serialized, but they can happen on any thread, including simulation and scene-query threads.
+
+		\param[in] pageRow		Row index of the page, in [0, PxTiledHeightFieldDesc::nbPageRows)
+		\param[in] pageColumn	Column index of the page, in [0, PxTiledHeightFieldDesc::nbPageColumns)
+		\param[out] samples		pageSize*pageSize samples to fill, row-major as in PxHeightFieldDesc. Sample (i,j) of the page
+								is sample (pageRow*pageSize+i, pageColumn*pageSize+j) of the whole terrain.
+		\return False if the page has no data. Its cells are then treated as holes.
+		*/
+		virtual	bool	loadPage(PxU32 pageRow, PxU32 pageColumn, PxHeightFieldSample* samples)	= 0;
+
+		protected:
+		virtual	~PxTiledHeightFieldPageSource()	{}
+	};
+
+	/**
+	\brief Descriptor for PxTiledHeightField.
+
+	\see PxCreateTiledHeightField
+	*/
+	class PxTiledHeightFieldDesc
+	{
+		public:
+
+		/**
+		\brief Number of pages along the heightfield's rows (local X axis).
+		*/
+		PxU32							nbPageRows;
+
+		/**
+		\brief Number of pages along the heightfield's columns (local Z axis).
+		*/
+		PxU32							nbPageColumns;
+
+		/**
+		\brief Number of samples along each side of a page.
+
+		The whole terrain has nbPageRows*pageSize rows and nbPageColumns*pageSize columns of samples. Each sample is stored in
+		exactly one page.
+
+		<b>Range:</b> [4, 1024]<br>
+		<b>Default:</b> 64
+		*/
+		PxU32							pageSize;
+
+		/**
+		\brief Scale factors, as in PxHeightFieldGeometry.
+		*/
+		PxReal							heightScale;
+		PxReal							rowScale;
+		PxReal							columnScale;
+
+		/**
+		\brief Maximum height error allowed by the compression of the samples, in sample units (i.e. before heightScale).
+
+		Each page stores its heights relative to the page's minimum height, on 8 bits when the resulting quantization step keeps
+		the error within this tolerance, and on 16 bits otherwise. 0 makes the compression lossless.
+
+		<b>Default:</b> 0
+		*/
+		PxU16							heightTolerance;
+
+		/**
+		\brief Number of calls to PxTiledHeightField::update() after which an unused page is released.
+
+		<b>Default:</b> 60
+		*/
+		PxU32							maxIdleUpdates;
+
+		/**
+		\brief Optional source for the pages' samples.
+
+		When provided, pages are loaded on demand and their compressed samples are released with the decoded page when the page is
+		no longer used. Without a source, pages are defined with PxTiledHeightField::setPage(), and their compressed samples stay
+		resident.
+		*/
+		PxTiledHeightFieldPageSource*	source;
+
+		PX_INLINE PxTiledHeightFieldDesc() :
+			nbPageRows		(0),
+			nbPageColumns	(0),
+			pageSize		(64),
+			heightScale		(1.0f),
+			rowScale		(1.0f),
+			columnScale		(1.0f),
+			heightTolerance	(0),
+			maxIdleUpdates	(60),
+			source			(NULL)
+		{
+		}
+
+		/**
+		\brief Returns true if the descriptor is valid.
+		*/
+		PX_INLINE bool isValid() const
+		{
+			return nbPageRows && nbPageColumns && pageSize>=4 && pageSize<=1024
+				&& heightScale>=PX_MIN_HEIGHTFIELD_Y_SCALE && rowScale>=PX_MIN_HEIGHTFIELD_XZ_SCALE && columnScale>=PX_MIN_HEIGHTFIELD_XZ_SCALE
+				&& PxU64(nbPageRows)*pageSize*PxU64(nbPageColumns)*pageSize*2<=PX_MAX_U32;
+		}
+	};
+
+	/**
+	\brief Memory statistics of a PxTiledHeightField.
+
+	\see PxTiledHeightField::getStats
+	*/
+	struct PxTiledHeightFieldStats
+	{
+		PxU32	nbCompressedPages;	//!< Number of pages whose compressed samples are resident
+		PxU32	nbDecodedPages;		//!< Number of pages currently decoded to a PxHeightField
+		PxU64	compressedBytes;	//!< Memory used by the compressed samples
+		PxU64	decodedBytes;		//!< Memory used by the samples of the decoded pages
+	};
+
+	/**
+	\brief Terrain made of a grid of heightfield pages, used through a PxCustomGeometry.
+
+	The terrain behaves like a single heightfield of nbPageRows*pageSize by nbPageColumns*pageSize samples. Its samples are
+	stored compressed per page, and pages are decoded to regular PxHeightField objects only when a contact, raycast, overlap or
+	sweep touches them. Decoded pages include one ring of cells from their neighbours, so that edges along page seams are
+	classified exactly as in a single heightfield, while each triangle is reported by one page only. Triangle indices reported
+	in hits and contacts are those of the equivalent single heightfield.
+
+	Pages that are not used for PxTiledHeightFieldDesc::maxIdleUpdates calls to update() are released, so memory scales with
+	the area around the objects touching the terrain.
+
+	Contacts are generated against spheres, capsules, boxes and convex meshes. Material indices are stored with the samples and
+	holes are supported, but contacts use the shape's material as for any custom geometry.
+
+	\see PxCreateTiledHeightField PxTiledHeightFieldDesc PxCustomGeometry
+	*/
+	class PxTiledHeightField : public PxCustomGeometry::Callbacks
+	{
+		public:
+
+		/// \cond PRIVATE
+		DECLARE_CUSTOM_GEOMETRY_TYPE
+		/// \endcond
+
+		/**
+		\brief Sets the samples of a page.
+
+		Replaces the page's previous samples. Must not be called while the terrain is used by the simulation or by queries.
+
+		\param[in] pageRow		Row index of the page
+		\param[in] pageColumn	Column index of the page
+		\param[in] samples		pageSize*pageSize samples, laid out as in PxTiledHeightFieldPageSource::loadPage()
+		\return True if the page was set
+		*/
+		virtual	bool	setPage(PxU32 pageRow, PxU32 pageColumn, const PxHeightFieldSample* samples)	= 0;
+
+		/**
+		\brief Returns a sample of the terrain, as stored after compression.
+
+		Loads the page from the source if needed.
+
+		\param[in] row		Row index, in [0, nbPageRows*pageSize)
+		\param[in] column	Column index, in [0, nbPageColumns*pageSize)
+		\return The sample. Samples of missing pages are holes of zero height.
+		*/
+		virtual	PxHeightFieldSample	getSample(PxU32 row, PxU32 column)	const	= 0;
+
+		/**
+		\brief Decodes the pages overlapping a region in advance, so that the simulation or queries do not have to.
+
+		\param[in] localBounds	Region in the terrain's local space
+		*/
+		virtual	void	prefetch(const PxBounds3& localBounds)	= 0;
+
+		/**
+		\brief Releases the pages that have not been used for PxTiledHeightFieldDesc::maxIdleUpdates calls.
+
+		Typically called once per frame. Must not be called while the terrain is used by the simulation or by queries.
+		*/
+		virtual	void	update()	= 0;
+
+		/**
+		\brief Retrieves memory statistics.
+		*/
+		virtual	void	getStats(PxTiledHeightFieldStats& stats)	const	= 0;
+
+		/**
+		\brief Returns the descriptor the terrain was created with.
+		*/
+		virtual	const PxTiledHeightFieldDesc&	getDesc()	const	= 0;
+
+		/**
+		\brief Releases the terrain. Shapes using it must have been released first.
+		*/
+		virtual	void	release()	= 0;
+
+		protected:
+		virtual	~PxTiledHeightField()	{}
+	};
+
+	/**
+	\brief Creates a tiled heightfield.
+
+	The returned object is the callbacks object of a PxCustomGeometry, e.g. PxCustomGeometry geom(*tiledHeightField).
+
+	\param[in] physics	The physics object used to create the pages' heightfields
+	\param[in] desc		Terrain descriptor
+	\return The new terrain, or NULL if the descriptor is invalid.
+
+	\see PxTiledHeightField PxTiledHeightFieldDesc
+	*/
+	PxTiledHeightField*	PxCreateTiledHeightField(PxPhysics& physics, const PxTiledHeightFieldDesc& desc);
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
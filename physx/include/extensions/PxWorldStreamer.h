@@ -0,0 +1,268 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2024 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PX_WORLD_STREAMER_H
+#define PX_WORLD_STREAMER_H
+
+#include "PxPhysXConfig.h"
+#include "foundation/PxSimpleTypes.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxScene;
+	class PxCollection;
+	class PxCpuDispatcher;
+	class PxSerializationRegistry;
+
+	/**
+	\brief State of a tile managed by a PxWorldStreamer.
+
+	\see PxWorldStreamer::getTileState
+	*/
+	struct PxWorldStreamerTileState
+	{
+		enum Enum
+		{
+			eUNKNOWN,	//!< The tile is not managed by the streamer
+			eLOADING,	//!< The tile's collection is being deserialized, and its pruning structures built, on a background thread
+			eMERGING,	//!< The tile's actors are being added to the scene, within the per-update time budget
+			eLOADED,	//!< All the tile's actors have been added to the scene
+			eUNLOADING	//!< The tile's actors are being removed from the scene, within the per-update removal budget
+		};
+	};
+
+	/**
+	\brief User callback for PxWorldStreamer events.
+
+	All functions are called from PxWorldStreamer::update(), PxWorldStreamer::flush() or PxWorldStreamer::release().
+
+	\see PxWorldStreamerDesc
+	*/
+	class PxWorldStreamerCallback
+	{
+		public:
+
+		/**
+		\brief Called when all the actors of a tile have been added to the scene.
+
+		\param[in] tileID		The tile ID passed to PxWorldStreamer::loadTile()
+		\param[in] collection	The tile's deserialized collection. Owned by the streamer, it must not be released by users.
+		*/
+		virtual	void	onTileLoaded(PxU32 tileID, PxCollection& collection)	{ PX_UNUSED(tileID); PX_UNUSED(collection);	}
+
+		/**
+		\brief Called when the memory block of a tile is no longer referenced by the streamer or the SDK.
+
+		This happens after the tile has been unloaded, or if its deserialization failed. The memory block can be freed or reused.
+
+		\param[in] tileID	The tile ID passed to PxWorldStreamer::loadTile()
+		\param[in] memBlock	The memory block passed to PxWorldStreamer::loadTile()
+		*/
+		virtual	void	releaseTileData(PxU32 tileID, void* memBlock)	= 0;
+
+		protected:
+		virtual	~PxWorldStreamerCallback()	{}
+	};
+
+	/**
+	\brief Descriptor for PxWorldStreamer.
+
+	\see PxCreateWorldStreamer
+	*/
+	class PxWorldStreamerDesc
+	{
+		public:
+
+		/**
+		\brief The scene tiles are streamed into.
+		*/
+		PxScene*					scene;
+
+		/**
+		\brief Serialization registry used to deserialize tiles. See PxSerialization::createSerializationRegistry().
+		*/
+		PxSerializationRegistry*	registry;
+
+		/**
+		\brief User callback. Must be provided to release the tiles' memory blocks.
+		*/
+		PxWorldStreamerCallback*	callback;
+
+		/**
+		\brief Optional collection used to resolve references to objects shared between tiles (materials, meshes...).
+
+		Passed to PxSerialization::createCollectionFromBinary(). Must not be modified while tiles are loading.
+		*/
+		const PxCollection*			externalReferences;
+
+		/**
+		\brief Dispatcher used to load tiles in the background.
+
+		If NULL, tiles are deserialized and their pruning structures built immediately, in PxWorldStreamer::loadTile().
+		*/
+		PxCpuDispatcher*			cpuDispatcher;
+
+		/**
+		\brief Time budget for merging loaded tiles into the scene, in seconds, per call to PxWorldStreamer::update().
+
+		At least one merge operation is performed per update, regardless of the budget.
+
+		<b>Default:</b> 0.001
+		*/
+		PxReal						timeBudget;
+
+		/**
+		\brief Maximum number of actors per merge operation.
+
+		Each tile is split into chunks of at most this many actors, each chunk having its own pruning structure. Smaller chunks
+		make the time budget more accurate, larger chunks reduce the number of trees the scene-query system has to merge.
+
+		<b>Default:</b> 256
+		*/
+		PxU32						maxActorsPerChunk;
+
+		/**
+		\brief Maximum number of actors removed from the scene per call to PxWorldStreamer::update().
+
+		<b>Default:</b> 1024
+		*/
+		PxU32						maxRemovalsPerUpdate;
+
+		PX_INLINE PxWorldStreamerDesc() :
+			scene					(NULL),
+			registry				(NULL),
+			callback				(NULL),
+			externalReferences		(NULL),
+			cpuDispatcher			(NULL),
+			timeBudget				(0.001f),
+			maxActorsPerChunk		(256),
+			maxRemovalsPerUpdate	(1024)
+		{
+		}
+
+		/**
+		\brief Returns true if the descriptor is valid.
+		*/
+		PX_INLINE bool isValid() const
+		{
+			return scene && registry && callback && timeBudget>=0.0f && maxActorsPerChunk && maxRemovalsPerUpdate;
+		}
+	};
+
+	/**
+	\brief Streaming world-tile manager.
+
+	Tiles are binary serialized collections (see PxSerialization::serializeCollectionToBinary()), usually containing static
+	actors. Loading a tile deserializes it and builds pruning structures for its actors on a background thread. The tile is
+	then merged into the scene by PxWorldStreamer::update(), using PxScene::addActors(const PxPruningStructure&), within a
+	per-update time budget. Unloading a tile removes its actors from the scene in batches, over several updates if needed,
+	then releases the tile's objects.
+
+	Pruning structures stored in the tile's collection are used as-is, so they can be built offline. Rigid actors without
+	scene-query shapes are added with PxScene::addActors(), and aggregates and articulations are added individually.
+
+	All functions must be called from the same thread, outside of PxScene::simulate() / PxScene::fetchResults(), i.e. when it
+	is legal to add actors to the scene.
+
+	\see PxCreateWorldStreamer PxWorldStreamerDesc PxPruningStructure
+	*/
+	class PxWorldStreamer
+	{
+		public:
+
+		/**
+		\brief Starts loading a tile.
+
+		\param[in] tileID	User-defined tile identifier. Must not be already managed by the streamer.
+		\param[in] memBlock	Memory block containing the tile's binary serialized collection, 128-byte aligned. Must stay valid until
+							PxWorldStreamerCallback::releaseTileData() is called for this tile.
+		\return True if the tile has been queued for loading.
+		*/
+		virtual	bool	loadTile(PxU32 tileID, void* memBlock)	= 0;
+
+		/**
+		\brief Starts unloading a tile.
+
+		Tiles can be unloaded in any state. If the tile is still loading, it is released as soon as its background task finishes.
+
+		\param[in] tileID	Tile identifier passed to loadTile()
+		\return True if the tile has been queued for unloading.
+		*/
+		virtual	bool	unloadTile(PxU32 tileID)	= 0;
+
+		/**
+		\brief Returns the state of a tile.
+
+		\param[in] tileID	Tile identifier passed to loadTile()
+		\return The tile's state, or PxWorldStreamerTileState::eUNKNOWN if the tile is not managed by the streamer.
+		*/
+		virtual	PxWorldStreamerTileState::Enum	getTileState(PxU32 tileID)	const	= 0;
+
+		/**
+		\brief Performs pending removals and merges, within the budgets defined in PxWorldStreamerDesc.
+
+		Typically called once per frame, before PxScene::simulate().
+
+		\return True if there is no pending work left, i.e. all tiles are either loaded or released.
+		*/
+		virtual	bool	update()	= 0;
+
+		/**
+		\brief Waits for background loads and performs all pending removals and merges, ignoring budgets.
+		*/
+		virtual	void	flush()	= 0;
+
+		/**
+		\brief Unloads all tiles and releases the streamer.
+
+		Waits for background loads to finish first.
+		*/
+		virtual	void	release()	= 0;
+
+		protected:
+		virtual	~PxWorldStreamer()	{}
+	};
+
+	/**
+	\brief Creates a world streamer.
+
+	\param[in] desc	Streamer descriptor
+	\return The new streamer, or NULL if the descriptor is invalid.
+
+	\see PxWorldStreamer PxWorldStreamerDesc
+	*/
+	PxWorldStreamer*	PxCreateWorldStreamer(const PxWorldStreamerDesc& desc);
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
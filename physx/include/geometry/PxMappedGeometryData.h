@@ -0,0 +1,115 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2024 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef PX_MAPPED_GEOMETRY_DATA_H
+#define PX_MAPPED_GEOMETRY_DATA_H
+
+#include "common/PxPhysXCommonConfig.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+#endif
+
+	class PxTriangleMesh;
+	class PxHeightField;
+	class PxOutputStream;
+
+/**
+\brief Required alignment for mapped geometry blobs, in bytes.
+
+\see PxCreateMappedTriangleMesh PxCreateMappedHeightField
+*/
+#define PX_MAPPED_GEOMETRY_DATA_ALIGNMENT	16
+
+	/**
+	\brief Writes a triangle mesh as a mapped geometry blob.
+
+	Mapped blobs store the runtime arrays of the mesh (vertices, triangles, per-triangle data, BV4 nodes) in the exact layout
+	used by the SDK, with each array starting on a PX_MAPPED_GEOMETRY_DATA_ALIGNMENT boundary. They can then be mapped into
+	memory (e.g. with mmap) and used directly by #PxCreateMappedTriangleMesh, without parsing or copying.
+
+	Contrary to regular cooked data, mapped blobs are platform-specific: they can only be loaded on a platform with the same
+	endianness, and by the same SDK version. Only BVH34 meshes are supported. SDF and GPU data are not stored.
+
+	\param[in] mesh		The triangle mesh to save. Must use the #PxMeshMidPhase::eBVH34 midphase.
+	\param[out] stream	Output stream. The blob size is a multiple of PX_MAPPED_GEOMETRY_DATA_ALIGNMENT.
+	\return True on success.
+
+	\see PxCreateMappedTriangleMesh
+	*/
+	PX_C_EXPORT PX_PHYSX_COMMON_API bool PX_CALL_CONV PxSaveMappedTriangleMesh(const PxTriangleMesh& mesh, PxOutputStream& stream);
+
+	/**
+	\brief Creates a triangle mesh referencing a mapped geometry blob.
+
+	This is an O(1) operation: the returned mesh points directly to the arrays stored in the blob, which are neither copied
+	nor modified. The blob can live in read-only memory, e.g. a file mapped into several processes that share the same pages.
+
+	The returned mesh is not owned by a PxPhysics instance and is not reported by PxPhysics::getTriangleMeshes(). The user is
+	responsible for keeping the blob alive and unchanged until the mesh has been released, i.e. until all shapes using it
+	have been released too. PxTriangleMesh::getVerticesForModification() and PxTriangleMesh::refitBVH() are not supported
+	on such meshes.
+
+	\param[in] address	Start of the blob written by #PxSaveMappedTriangleMesh. Must be PX_MAPPED_GEOMETRY_DATA_ALIGNMENT-aligned.
+	\param[in] size		Size of the blob in bytes, used for validation.
+	\return The new triangle mesh, or NULL if the blob is invalid or incompatible with this platform.
+
+	\see PxSaveMappedTriangleMesh
+	*/
+	PX_C_EXPORT PX_PHYSX_COMMON_API PxTriangleMesh* PX_CALL_CONV PxCreateMappedTriangleMesh(const void* address, PxU32 size);
+
+	/**
+	\brief Writes a height field as a mapped geometry blob.
+
+	\param[in] heightField	The height field to save.
+	\param[out] stream		Output stream. The blob size is a multiple of PX_MAPPED_GEOMETRY_DATA_ALIGNMENT.
+	\return True on success.
+
+	\see PxSaveMappedTriangleMesh PxCreateMappedHeightField
+	*/
+	PX_C_EXPORT PX_PHYSX_COMMON_API bool PX_CALL_CONV PxSaveMappedHeightField(const PxHeightField& heightField, PxOutputStream& stream);
+
+	/**
+	\brief Creates a height field referencing a mapped geometry blob.
+
+	Same rules as for #PxCreateMappedTriangleMesh. PxHeightField::modifySamples() is not supported on such height fields.
+
+	\param[in] address	Start of the blob written by #PxSaveMappedHeightField. Must be PX_MAPPED_GEOMETRY_DATA_ALIGNMENT-aligned.
+	\param[in] size		Size of the blob in bytes, used for validation.
+	\return The new height field, or NULL if the blob is invalid or incompatible with this platform.
+
+	\see PxSaveMappedHeightField
+	*/
+	PX_C_EXPORT PX_PHYSX_COMMON_API PxHeightField* PX_CALL_CONV PxCreateMappedHeightField(const void* address, PxU32 size);
+
+#if !PX_DOXYGEN
+} // namespace physx
+#endif
+
+#endif
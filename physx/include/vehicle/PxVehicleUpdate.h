@@ -46,6 +46,7 @@ namespace physx
 	class PxVehicleDrivableSurfaceToTireFrictionPairs;
 	class PxVehicleTelemetryData;
 	class PxBatchQueryExt;
+	class PxCpuDispatcher;
 
 	/**
 	\deprecated This API is deprecated and is replaced by a new API, see the Vehicles section in the 4.0 to 5.1 migration guide.
@@ -486,6 +487,11 @@ namespace physx
 	stored in vehicleConcurrentUpdates must be passed to PxVehiclePostUpdates, where it is applied to all relevant actors in sequence. A NULL pointer is permitted.
 
 	\param[in] context the vehicle context to use for the vehicle update.
+
+	\param[in] dispatcher is an optional CPU dispatcher. If it is non-NULL the vehicles are split into chunks that are updated in parallel 
+	by its worker threads and by the calling thread, and the function returns when all vehicles have been updated.  The writes to actors 
+	are deferred: if vehicleConcurrentUpdates is specified they are stored there and must be applied with PxVehiclePostUpdates as usual,
+	otherwise they are stored in temporary buffers and applied to the actors in vehicle order before the function returns.
 	
 	\note The vehicleWheelQueryResults buffer must persist until the end of PxVehicleUpdates.
 	
@@ -503,6 +509,11 @@ namespace physx
 	\note Concurrent calls to PxVehicleUpdates and PxVehicleUpdateSingleVehicleAndStoreTelemetryData are permitted if the parameter
 	vehicleConcurrentUpdates is used.
 
+	\note With a dispatcher, a vehicle does not see the actor writes of the other vehicles of the same call, e.g. the velocity of a vehicle 
+	it drives on is the velocity before the call.  The results do not depend on the number of worker threads.  The tire force shaders are
+	called from the worker threads.  If the actor of a vehicle is in a scene created with PxSceneFlag::eREQUIRE_RW_LOCK the vehicles are 
+	updated on the calling thread only.
+
 	\see PxVehicleSetUpdateMode, PxVehicleWheelsSimData::disableWheel, PxVehicleWheelsSimData::setWheelShapeMapping, PxVehicleWheelsDynData::setWheelRotationSpeed,
 	PxVehiclePostUpdates
 	*/
@@ -510,7 +521,7 @@ namespace physx
 		const PxReal timestep, const PxVec3& gravity, 
 		const PxVehicleDrivableSurfaceToTireFrictionPairs& vehicleDrivableSurfaceToTireFrictionPairs, 
 		const PxU32 nbVehicles, PxVehicleWheels** vehicles, PxVehicleWheelQueryResult* vehicleWheelQueryResults, PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates = NULL,
-		const PxVehicleContext& context = PxVehicleGetDefaultContext());
+		const PxVehicleContext& context = PxVehicleGetDefaultContext(), PxCpuDispatcher* dispatcher = NULL);
 
 
 	/**
@@ -36,6 +36,10 @@
 #include "vehicle2/PxVehicleFunctions.h"
 #include "vehicle2/PxVehicleMaths.h"
 
+#include "vehicle2/batch/PxVehicleBatchData.h"
+#include "vehicle2/batch/PxVehicleBatchHelpers.h"
+#include "vehicle2/batch/PxVehicleBatchFunctions.h"
+
 #include "vehicle2/braking/PxVehicleBrakingParams.h"
 #include "vehicle2/braking/PxVehicleBrakingFunctions.h"
 
@@ -0,0 +1,235 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2024 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#pragma once
+
+#include "foundation/PxSimpleTypes.h"
+#include "vehicle2/PxVehicleParams.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+namespace vehicle2
+{
+#endif
+
+struct PxVehicleRigidBodyParams;
+struct PxVehicleRigidBodyState;
+struct PxVehicleWheelParams;
+struct PxVehicleWheelActuationState;
+struct PxVehicleWheelRigidBody1dState;
+struct PxVehicleRoadGeometryState;
+struct PxVehicleSuspensionParams;
+struct PxVehicleSuspensionStateCalculationParams;
+struct PxVehicleSuspensionComplianceParams;
+struct PxVehicleSuspensionForceParams;
+struct PxVehicleAntiRollForceParams;
+struct PxVehicleSuspensionState;
+struct PxVehicleSuspensionComplianceState;
+struct PxVehicleSuspensionForce;
+struct PxVehicleAntiRollTorque;
+struct PxVehicleTireForceParams;
+struct PxVehicleTireGripState;
+struct PxVehicleTireDirectionState;
+struct PxVehicleTireSpeedState;
+struct PxVehicleTireSlipState;
+struct PxVehicleTireCamberAngleState;
+struct PxVehicleTireStickyState;
+struct PxVehicleTireForce;
+struct PxVehicleEngineParams;
+struct PxVehicleClutchParams;
+struct PxVehicleGearboxParams;
+struct PxVehicleEngineDriveThrottleCommandResponseState;
+struct PxVehicleClutchCommandResponseState;
+struct PxVehicleDifferentialState;
+struct PxVehicleWheelConstraintGroupState;
+struct PxVehicleEngineState;
+struct PxVehicleGearboxState;
+struct PxVehicleClutchSlipState;
+struct PxVehiclePhysXRoadGeometryQueryParams;
+struct PxVehiclePhysXMaterialFrictionParams;
+struct PxVehiclePhysXRoadGeometryQueryState;
+struct PxVehiclePhysXRoadGeometryQueryCacheState;
+
+/**
+\brief The data of a single vehicle required by PxVehicleSuspensionBatchUpdate().
+
+The members correspond one to one to the data returned by PxVehicleSuspensionComponent::getDataForSuspensionComponent() and
+carry the same requirements. The batch update reads the data directly, without any virtual call, so the pointers must remain
+valid for as long as the instance is used.
+
+\see PxVehicleSuspensionBatchDataSet
+\see PxVehicleSuspensionBatchUpdate
+*/
+struct PxVehicleSuspensionBatchData
+{
+	const PxVehicleAxleDescription* axleDescription;
+	const PxVehicleRigidBodyParams* rigidBodyParams;
+	const PxVehicleSuspensionStateCalculationParams* suspensionStateCalculationParams;
+	PxVehicleArrayData<const PxReal> steerResponseStates;
+	const PxVehicleRigidBodyState* rigidBodyState;
+	PxVehicleArrayData<const PxVehicleWheelParams> wheelParams;
+	PxVehicleArrayData<const PxVehicleSuspensionParams> suspensionParams;
+	PxVehicleArrayData<const PxVehicleSuspensionComplianceParams> suspensionComplianceParams;
+	PxVehicleArrayData<const PxVehicleSuspensionForceParams> suspensionForceParams;
+	PxVehicleSizedArrayData<const PxVehicleAntiRollForceParams> antiRollForceParams;
+	PxVehicleArrayData<const PxVehicleRoadGeometryState> wheelRoadGeomStates;
+	PxVehicleArrayData<PxVehicleSuspensionState> suspensionStates;
+	PxVehicleArrayData<PxVehicleSuspensionComplianceState> suspensionComplianceStates;
+	PxVehicleArrayData<PxVehicleSuspensionForce> suspensionForces;
+	PxVehicleAntiRollTorque* antiRollTorque;
+};
+
+/**
+\brief The data of a single vehicle required by PxVehicleTireBatchUpdate().
+
+The members correspond one to one to the data returned by PxVehicleTireComponent::getDataForTireComponent() and
+carry the same requirements. The pointers must remain valid for as long as the instance is used.
+
+\see PxVehicleTireBatchDataSet
+\see PxVehicleTireBatchUpdate
+*/
+struct PxVehicleTireBatchData
+{
+	const PxVehicleAxleDescription* axleDescription;
+	PxVehicleArrayData<const PxReal> steerResponseStates;
+	const PxVehicleRigidBodyState* rigidBodyState;
+	PxVehicleArrayData<const PxVehicleWheelActuationState> actuationStates;
+	PxVehicleArrayData<const PxVehicleWheelParams> wheelParams;
+	PxVehicleArrayData<const PxVehicleSuspensionParams> suspensionParams;
+	PxVehicleArrayData<const PxVehicleTireForceParams> tireForceParams;
+	PxVehicleArrayData<const PxVehicleRoadGeometryState> roadGeomStates;
+	PxVehicleArrayData<const PxVehicleSuspensionState> suspensionStates;
+	PxVehicleArrayData<const PxVehicleSuspensionComplianceState> suspensionComplianceStates;
+	PxVehicleArrayData<const PxVehicleSuspensionForce> suspensionForces;
+	PxVehicleArrayData<const PxVehicleWheelRigidBody1dState> wheelRigidBody1DStates;
+	PxVehicleArrayData<PxVehicleTireGripState> tireGripStates;
+	PxVehicleArrayData<PxVehicleTireDirectionState> tireDirectionStates;
+	PxVehicleArrayData<PxVehicleTireSpeedState> tireSpeedStates;
+	PxVehicleArrayData<PxVehicleTireSlipState> tireSlipStates;
+	PxVehicleArrayData<PxVehicleTireCamberAngleState> tireCamberAngleStates;
+	PxVehicleArrayData<PxVehicleTireStickyState> tireStickyStates;
+	PxVehicleArrayData<PxVehicleTireForce> tireForces;
+};
+
+/**
+\brief The data of a single vehicle required by PxVehicleDirectDrivetrainBatchUpdate().
+
+The members correspond one to one to the data returned by PxVehicleDirectDrivetrainComponent::getDataForDirectDrivetrainComponent().
+The pointers must remain valid for as long as the instance is used.
+
+\see PxVehicleDirectDrivetrainBatchDataSet
+\see PxVehicleDirectDrivetrainBatchUpdate
+*/
+struct PxVehicleDirectDrivetrainBatchData
+{
+	const PxVehicleAxleDescription* axleDescription;
+	PxVehicleArrayData<const PxReal> brakeResponseStates;
+	PxVehicleArrayData<const PxReal> throttleResponseStates;
+	PxVehicleArrayData<const PxVehicleWheelParams> wheelParams;
+	PxVehicleArrayData<const PxVehicleWheelActuationState> actuationStates;
+	PxVehicleArrayData<const PxVehicleTireForce> tireForces;
+	PxVehicleArrayData<PxVehicleWheelRigidBody1dState> wheelRigidBody1dStates;
+};
+
+/**
+\brief The data of a single vehicle required by PxVehicleEngineDrivetrainBatchUpdate().
+
+The members correspond one to one to the data returned by PxVehicleEngineDrivetrainComponent::getDataForEngineDrivetrainComponent().
+The pointers must remain valid for as long as the instance is used.
+
+\see PxVehicleEngineDrivetrainBatchDataSet
+\see PxVehicleEngineDrivetrainBatchUpdate
+*/
+struct PxVehicleEngineDrivetrainBatchData
+{
+	const PxVehicleAxleDescription* axleDescription;
+	PxVehicleArrayData<const PxVehicleWheelParams> wheelParams;
+	const PxVehicleEngineParams* engineParams;
+	const PxVehicleClutchParams* clutchParams;
+	const PxVehicleGearboxParams* gearboxParams;
+	PxVehicleArrayData<const PxReal> brakeResponseStates;
+	PxVehicleArrayData<const PxVehicleWheelActuationState> actuationStates;
+	PxVehicleArrayData<const PxVehicleTireForce> tireForces;
+	const PxVehicleEngineDriveThrottleCommandResponseState* throttleResponseState;
+	const PxVehicleClutchCommandResponseState* clutchResponseState;
+	const PxVehicleDifferentialState* differentialState;
+	const PxVehicleWheelConstraintGroupState* constraintGroupState;
+	PxVehicleArrayData<PxVehicleWheelRigidBody1dState> wheelRigidBody1dStates;
+	PxVehicleEngineState* engineState;
+	PxVehicleGearboxState* gearboxState;
+	PxVehicleClutchSlipState* clutchState;
+};
+
+/**
+\brief The data of a single vehicle required by PxVehiclePhysXRoadGeometryQueryBatchUpdate().
+
+All members but the last two correspond one to one to the data returned by 
+PxVehiclePhysXRoadGeometrySceneQueryComponent::getDataForPhysXRoadGeometrySceneQueryComponent(). The pointers must remain
+valid for as long as the instance is used.
+
+\see PxVehiclePhysXRoadGeometryQueryBatchDataSet
+\see PxVehiclePhysXRoadGeometryQueryBatchUpdate
+*/
+struct PxVehiclePhysXRoadGeometryQueryBatchData
+{
+	const PxVehicleAxleDescription* axleDescription;
+	const PxVehiclePhysXRoadGeometryQueryParams* roadGeomParams;
+	PxVehicleArrayData<const PxReal> steerResponseStates;
+	const PxVehicleRigidBodyState* rigidBodyState;
+	PxVehicleArrayData<const PxVehicleWheelParams> wheelParams;
+	PxVehicleArrayData<const PxVehicleSuspensionParams> suspensionParams;
+	PxVehicleArrayData<const PxVehiclePhysXMaterialFrictionParams> materialFrictionParams;
+	PxVehicleArrayData<PxVehicleRoadGeometryState> roadGeometryStates;
+	PxVehicleArrayData<PxVehiclePhysXRoadGeometryQueryState> physxRoadGeometryStates;
+
+	/**
+	\brief Optional per wheel record of the last query, used to skip the query of wheels that have hardly moved.
+	
+	Set to empty to query every wheel. The entries have to be initialized with setToDefault() and reset the same way 
+	whenever static geometry is moved or removed from the scene.
+	*/
+	PxVehicleArrayData<PxVehiclePhysXRoadGeometryQueryCacheState> queryCacheStates;
+
+	/**
+	\brief The result of the last query of a wheel is reused if the start and end positions of the query have both moved 
+	by less than this distance and the query hit static geometry.
+
+	Reusing a result keeps the hit plane of the previous query, which is an approximation unless the ground under the 
+	wheel is planar. Ignored if #queryCacheStates is empty.
+
+	<b>Range:</b> [0, inf)<br>
+	<b>Unit:</b> length
+	*/
+	PxReal queryCacheTolerance;
+};
+
+#if !PX_DOXYGEN
+} // namespace vehicle2
+} // namespace physx
+#endif
@@ -0,0 +1,154 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2024 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#pragma once
+
+#include "foundation/PxSimpleTypes.h"
+#include "vehicle2/PxVehicleParams.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+class PxCpuDispatcher;
+
+namespace vehicle2
+{
+#endif
+
+struct PxVehicleSuspensionBatchData;
+struct PxVehicleTireBatchData;
+struct PxVehicleDirectDrivetrainBatchData;
+struct PxVehicleEngineDrivetrainBatchData;
+struct PxVehiclePhysXRoadGeometryQueryBatchData;
+
+/**
+\brief Update the suspension state, compliance state, suspension forces and anti-roll torque of a batch of vehicles.
+
+The results are identical to calling PxVehicleSuspensionComponent::update() for each vehicle in turn. The vehicles are
+processed stage by stage rather than vehicle by vehicle: the suspension forces of the wheels of all vehicles are computed
+four wheels at a time with SIMD instructions, from data gathered across vehicle boundaries.
+
+\param[in] vehicles is an array of nbVehicles descriptions of the vehicles to update.
+\param[in] nbVehicles is the number of vehicles to update.
+\param[in] dt is the simulation time that has passed since the last update.
+\param[in] context describes the simulation frame, scale and gravitational acceleration.
+\param[in] dispatcher is an optional CPU dispatcher. If it is non-NULL the vehicles are split into chunks that are
+processed in parallel by its worker threads and by the calling thread. The function returns when all chunks have been processed.
+\note The vehicles must not share state data with each other.
+\see PxVehicleSuspensionComponent
+\see PxVehicleSuspensionBatchDataSet
+*/
+void PxVehicleSuspensionBatchUpdate
+(const PxVehicleSuspensionBatchData* vehicles, const PxU32 nbVehicles,
+ const PxReal dt, const PxVehicleSimulationContext& context,
+ PxCpuDispatcher* dispatcher = NULL);
+
+/**
+\brief Update the tire directions, speeds, slips, camber angles, grip, sticky states and forces of a batch of vehicles.
+
+The results are identical to calling PxVehicleTireComponent::update() for each vehicle in turn. The tire forces of the
+wheels of all vehicles are computed four wheels at a time with SIMD instructions, from data gathered across vehicle boundaries.
+
+\param[in] vehicles is an array of nbVehicles descriptions of the vehicles to update.
+\param[in] nbVehicles is the number of vehicles to update.
+\param[in] dt is the simulation time that has passed since the last update.
+\param[in] context describes the simulation frame and the tire slip and sticky tire parameters.
+\param[in] dispatcher is an optional CPU dispatcher used to process chunks of vehicles in parallel.
+\note The vehicles must not share state data with each other.
+\see PxVehicleTireComponent
+\see PxVehicleTireBatchDataSet
+*/
+void PxVehicleTireBatchUpdate
+(const PxVehicleTireBatchData* vehicles, const PxU32 nbVehicles,
+ const PxReal dt, const PxVehicleSimulationContext& context,
+ PxCpuDispatcher* dispatcher = NULL);
+
+/**
+\brief Integrate the wheel rotation speeds of a batch of vehicles driven by a direct drivetrain.
+
+The results are identical to calling PxVehicleDirectDrivetrainComponent::update() for each vehicle in turn.
+
+\param[in] vehicles is an array of nbVehicles descriptions of the vehicles to update.
+\param[in] nbVehicles is the number of vehicles to update.
+\param[in] dt is the simulation time that has passed since the last update.
+\param[in] dispatcher is an optional CPU dispatcher used to process chunks of vehicles in parallel.
+\note The vehicles must not share state data with each other.
+\see PxVehicleDirectDrivetrainComponent
+\see PxVehicleDirectDrivetrainBatchDataSet
+*/
+void PxVehicleDirectDrivetrainBatchUpdate
+(const PxVehicleDirectDrivetrainBatchData* vehicles, const PxU32 nbVehicles,
+ const PxReal dt,
+ PxCpuDispatcher* dispatcher = NULL);
+
+/**
+\brief Update the gearbox and integrate the engine and wheel rotation speeds of a batch of vehicles driven by an engine.
+
+The results are identical to calling PxVehicleEngineDrivetrainComponent::update() for each vehicle in turn. The drivetrain of
+each vehicle is solved as a whole, so the vehicles are only processed in parallel and not with SIMD instructions.
+
+\param[in] vehicles is an array of nbVehicles descriptions of the vehicles to update.
+\param[in] nbVehicles is the number of vehicles to update.
+\param[in] dt is the simulation time that has passed since the last update.
+\param[in] dispatcher is an optional CPU dispatcher used to process chunks of vehicles in parallel.
+\note The vehicles must not share state data with each other.
+\see PxVehicleEngineDrivetrainComponent
+\see PxVehicleEngineDrivetrainBatchDataSet
+*/
+void PxVehicleEngineDrivetrainBatchUpdate
+(const PxVehicleEngineDrivetrainBatchData* vehicles, const PxU32 nbVehicles,
+ const PxReal dt,
+ PxCpuDispatcher* dispatcher = NULL);
+
+/**
+\brief Compute the road geometry planes and tire friction values under the wheels of a batch of vehicles with PhysX scene queries.
+
+The results are identical to calling PxVehiclePhysXRoadGeometrySceneQueryComponent::update() for each vehicle in turn, except for 
+wheels whose query result is reused from the previous call (see PxVehiclePhysXRoadGeometryQueryBatchData::queryCacheStates). 
+The queries of all wheels of all vehicles are gathered first and sorted by the position of their start point so that consecutive 
+queries traverse the same parts of the scene, then they are performed in that order.
+
+\param[in] vehicles is an array of nbVehicles descriptions of the vehicles to update.
+\param[in] nbVehicles is the number of vehicles to update.
+\param[in] context is the simulation context. It has to be of type PxVehicleSimulationContextType::ePHYSX.
+\param[in] dispatcher is an optional CPU dispatcher used to perform chunks of queries in parallel. Scene queries and 
+the filter callbacks of the vehicles will then run concurrently on several threads, the scene must not be modified 
+during the call. If the scene has PxSceneFlag::eREQUIRE_RW_LOCK set, a dispatcher must not be used.
+\note The vehicles must not share state data with each other.
+\see PxVehiclePhysXRoadGeometrySceneQueryComponent
+\see PxVehiclePhysXRoadGeometryQueryBatchDataSet
+*/
+void PxVehiclePhysXRoadGeometryQueryBatchUpdate
+(const PxVehiclePhysXRoadGeometryQueryBatchData* vehicles, const PxU32 nbVehicles,
+ const PxVehicleSimulationContext& context,
+ PxCpuDispatcher* dispatcher = NULL);
+
+#if !PX_DOXYGEN
+} // namespace vehicle2
+} // namespace physx
+#endif
@@ -0,0 +1,131 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2024 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#pragma once
+
+#include "vehicle2/drivetrain/PxVehicleDrivetrainComponents.h"
+#include "vehicle2/physxRoadGeometry/PxVehiclePhysXRoadGeometryComponents.h"
+#include "vehicle2/suspension/PxVehicleSuspensionComponents.h"
+#include "vehicle2/tire/PxVehicleTireComponents.h"
+
+#include "PxVehicleBatchData.h"
+
+#if !PX_DOXYGEN
+namespace physx
+{
+namespace vehicle2
+{
+#endif
+
+/**
+\brief Fill the batch data of a vehicle from its suspension component.
+\param[in] component is the suspension component of the vehicle.
+\param[out] data is the batch data to be filled.
+\note PxVehicleSuspensionComponent::getDataForSuspensionComponent() is called once. If the component may return different
+pointers from one call to the next, data must be refreshed accordingly before it is passed to PxVehicleSuspensionBatchUpdate().
+*/
+PX_FORCE_INLINE void PxVehicleSuspensionBatchDataSet(PxVehicleSuspensionComponent& component, PxVehicleSuspensionBatchData& data)
+{
+	component.getDataForSuspensionComponent(data.axleDescription, data.rigidBodyParams, data.suspensionStateCalculationParams,
+		data.steerResponseStates, data.rigidBodyState,
+		data.wheelParams, data.suspensionParams,
+		data.suspensionComplianceParams, data.suspensionForceParams, data.antiRollForceParams,
+		data.wheelRoadGeomStates, data.suspensionStates, data.suspensionComplianceStates,
+		data.suspensionForces, data.antiRollTorque);
+}
+
+/**
+\brief Fill the batch data of a vehicle from its tire component.
+\param[in] component is the tire component of the vehicle.
+\param[out] data is the batch data to be filled.
+\note PxVehicleTireComponent::getDataForTireComponent() is called once. If the component may return different
+pointers from one call to the next, data must be refreshed accordingly before it is passed to PxVehicleTireBatchUpdate().
+*/
+PX_FORCE_INLINE void PxVehicleTireBatchDataSet(PxVehicleTireComponent& component, PxVehicleTireBatchData& data)
+{
+	component.getDataForTireComponent(data.axleDescription, data.steerResponseStates,
+		data.rigidBodyState, data.actuationStates, data.wheelParams, data.suspensionParams, data.tireForceParams,
+		data.roadGeomStates, data.suspensionStates, data.suspensionComplianceStates, data.suspensionForces,
+		data.wheelRigidBody1DStates, data.tireGripStates, data.tireDirectionStates, data.tireSpeedStates,
+		data.tireSlipStates, data.tireCamberAngleStates, data.tireStickyStates, data.tireForces);
+}
+
+/**
+\brief Fill the batch data of a vehicle from its direct drivetrain component.
+\param[in] component is the direct drivetrain component of the vehicle.
+\param[out] data is the batch data to be filled.
+\note PxVehicleDirectDrivetrainComponent::getDataForDirectDrivetrainComponent() is called once. If the component may return
+different pointers from one call to the next, data must be refreshed accordingly before it is passed to PxVehicleDirectDrivetrainBatchUpdate().
+*/
+PX_FORCE_INLINE void PxVehicleDirectDrivetrainBatchDataSet(PxVehicleDirectDrivetrainComponent& component, PxVehicleDirectDrivetrainBatchData& data)
+{
+	component.getDataForDirectDrivetrainComponent(data.axleDescription,
+		data.brakeResponseStates, data.throttleResponseStates,
+		data.wheelParams, data.actuationStates, data.tireForces,
+		data.wheelRigidBody1dStates);
+}
+
+/**
+\brief Fill the batch data of a vehicle from its engine drivetrain component.
+\param[in] component is the engine drivetrain component of the vehicle.
+\param[out] data is the batch data to be filled.
+\note PxVehicleEngineDrivetrainComponent::getDataForEngineDrivetrainComponent() is called once. If the component may return
+different pointers from one call to the next, data must be refreshed accordingly before it is passed to PxVehicleEngineDrivetrainBatchUpdate().
+*/
+PX_FORCE_INLINE void PxVehicleEngineDrivetrainBatchDataSet(PxVehicleEngineDrivetrainComponent& component, PxVehicleEngineDrivetrainBatchData& data)
+{
+	component.getDataForEngineDrivetrainComponent(data.axleDescription, data.wheelParams,
+		data.engineParams, data.clutchParams, data.gearboxParams,
+		data.brakeResponseStates, data.actuationStates, data.tireForces,
+		data.throttleResponseState, data.clutchResponseState, data.differentialState, data.constraintGroupState,
+		data.wheelRigidBody1dStates, data.engineState, data.gearboxState, data.clutchState);
+}
+
+/**
+\brief Fill the batch data of a vehicle from its PhysX road geometry scene query component.
+\param[in] component is the road geometry scene query component of the vehicle.
+\param[out] data is the batch data to be filled. The query cache is disabled, set PxVehiclePhysXRoadGeometryQueryBatchData::queryCacheStates
+and PxVehiclePhysXRoadGeometryQueryBatchData::queryCacheTolerance afterwards to enable it.
+\note PxVehiclePhysXRoadGeometrySceneQueryComponent::getDataForPhysXRoadGeometrySceneQueryComponent() is called once. If the component may 
+return different pointers from one call to the next, data must be refreshed accordingly before it is passed to
+PxVehiclePhysXRoadGeometryQueryBatchUpdate().
+*/
+PX_FORCE_INLINE void PxVehiclePhysXRoadGeometryQueryBatchDataSet(PxVehiclePhysXRoadGeometrySceneQueryComponent& component, 
+	PxVehiclePhysXRoadGeometryQueryBatchData& data)
+{
+	component.getDataForPhysXRoadGeometrySceneQueryComponent(data.axleDescription, data.roadGeomParams, 
+		data.steerResponseStates, data.rigidBodyState, data.wheelParams, data.suspensionParams, data.materialFrictionParams,
+		data.roadGeometryStates, data.physxRoadGeometryStates);
+	data.queryCacheStates.setEmpty();
+	data.queryCacheTolerance = 0.0f;
+}
+
+#if !PX_DOXYGEN
+} // namespace vehicle2
+} // namespace physx
+#endif
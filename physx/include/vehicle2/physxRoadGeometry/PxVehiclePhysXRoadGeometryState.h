@@ -57,6 +57,23 @@ struct PxVehiclePhysXRoadGeometryQueryState
 	}
 };
 
+/**
+\brief Records the query that produced the road geometry state of a wheel so that the result can be reused if the
+wheel has hardly moved by the time of the next query.
+\see PxVehiclePhysXRoadGeometryQueryBatchUpdate
+*/
+struct PxVehiclePhysXRoadGeometryQueryCacheState
+{
+	PxVec3 queryStart;		//!< The start position of the last query that was performed for the wheel.
+	PxVec3 queryEnd;		//!< The end position of the last query that was performed for the wheel.
+	bool isValid;			//!< True if the last query hit static geometry, which makes its result eligible for reuse.
+
+	PX_FORCE_INLINE void setToDefault()
+	{
+		PxMemZero(this, sizeof(PxVehiclePhysXRoadGeometryQueryCacheState));
+	}
+};
+
 #if !PX_DOXYGEN
 } // namespace vehicle2
 } // namespace physx
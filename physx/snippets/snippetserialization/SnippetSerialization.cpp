@@ -42,9 +42,17 @@
 // Finally phyics is teared down again, including deallocation of memory
 // occupied by deserialized objects (in the case of binary serialization).
 //
+// In non-rendering mode, the snippet also measures binary deserialization of
+// a larger collection made of many chains, with and without a CPU dispatcher.
+// When a dispatcher is passed to PxSerialization::createCollectionFromBinary,
+// materials, meshes, shapes and rigid actors are created in parallel. The
+// same data is then stored in a compressed container, and the load time is
+// measured again with decompression included.
+//
 // ****************************************************************************
 
 #include "PxPhysicsAPI.h"
+#include "extensions/PxCollectionExt.h"
 #include "foundation/PxMemory.h"
 #include "../snippetutils/SnippetUtils.h"
 #include "../snippetcommon/SnippetPrint.h"
@@ -214,6 +222,109 @@ void deserializeObjects(PxInputData& sharedData, PxInputData& actorData, const P
 	sr->release();
 }
 
+/**
+Serializes a collection made of many chains similar to the ones above, then deserializes it several times
+with and without a CPU dispatcher, and prints the best time for each.
+*/
+void benchmarkBinaryDeserialization()
+{
+	static const PxU32 nbChains = 4096;
+	static const PxU32 nbRuns = 5;
+
+	PxSerializationRegistry* sr = PxSerialization::createSerializationRegistry(*gPhysics);
+
+	PxDefaultMemoryOutputStream outputStream;
+	{
+		PxMaterial* material = gPhysics->createMaterial(0.5f, 0.5f, 0.6f);
+		PxShape* shape = gPhysics->createShape(PxBoxGeometry(2.0f, 1.0f, 1.0f), *material);
+
+		PxCollection* collection = PxCreateCollection();
+		for(PxU32 c=0; c<nbChains; c++)
+		{
+			const PxVec3 pos(PxReal(c%64)*40.0f, 25.0f, PxReal(c/64)*5.0f);
+			PxRigidActor* prevActor = PxCreateStatic(*gPhysics, PxTransform(pos), PxSphereGeometry(2.0f), *material);
+			collection->add(*prevActor);
+			for(PxU32 i=1; i<8; i++)
+			{
+				PxRigidDynamic* dynamic = gPhysics->createRigidDynamic(PxTransform(pos + PxVec3(PxReal(i)*4.0f, 0.0f, 0.0f)));
+				dynamic->attachShape(*shape);
+				PxRigidBodyExt::updateMassAndInertia(*dynamic, 10.0f);
+				PxSphericalJointCreate(*gPhysics, prevActor, PxTransform(PxVec3(2.0f, 0.0f, 0.0f)), dynamic, PxTransform(PxVec3(-2.0f, 0.0f, 0.0f)));
+				collection->add(*dynamic);
+				prevActor = dynamic;
+			}
+		}
+		PxSerialization::complete(*collection, *sr);
+		PxSerialization::serializeCollectionToBinary(outputStream, *collection, *sr);
+
+		// The collection contains the shared shape and material too
+		PxCollectionExt::releaseObjects(*collection);
+		collection->release();
+	}
+
+	PxU8* baseAddr = static_cast<PxU8*>(malloc(outputStream.getSize()+PX_SERIAL_FILE_ALIGN-1));
+	void* alignedBlock = reinterpret_cast<void*>((size_t(baseAddr)+PX_SERIAL_FILE_ALIGN-1)&~(PX_SERIAL_FILE_ALIGN-1));
+
+	PxU32 nbObjects = 0;
+	PxReal bestTimes[2] = { PX_MAX_REAL, PX_MAX_REAL };
+	for(PxU32 run=0; run<nbRuns; run++)
+	{
+		for(PxU32 j=0; j<2; j++)
+		{
+			// Deserialization patches the memory block in place, so start from a fresh copy each time
+			PxMemCopy(alignedBlock, outputStream.getData(), outputStream.getSize());
+
+			const PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+			PxCollection* collection = PxSerialization::createCollectionFromBinary(alignedBlock, *sr, NULL, j ? gDispatcher : NULL);
+			const PxU64 elapsedTime = SnippetUtils::getCurrentTimeCounterValue() - startTime;
+			bestTimes[j] = PxMin(bestTimes[j], SnippetUtils::getElapsedTimeInMilliseconds(elapsedTime));
+			nbObjects = collection->getNbObjects();
+
+			PxCollectionExt::releaseObjects(*collection);
+			collection->release();
+		}
+	}
+
+	printf("Binary deserialization of %d objects (%.1f MB): %.2f ms without dispatcher, %.2f ms with %d worker threads.\n",
+		nbObjects, PxReal(outputStream.getSize())/(1024.0f*1024.0f), PxF64(bestTimes[0]), PxF64(bestTimes[1]), gDispatcher->getWorkerCount());
+
+	// Same data stored in a compressed container, decompressed straight into the aligned block before deserialization
+	PxDefaultMemoryOutputStream compressedStream;
+	{
+		PxBinaryCompressionParams params;
+		params.flags |= PxBinaryCompressionFlag::eSHUFFLE_FLOATS;
+		params.dispatcher = gDispatcher;
+		PxCompressedOutputStream* stream = PxCreateCompressedOutputStream(compressedStream, params);
+		stream->write(outputStream.getData(), outputStream.getSize());
+		stream->finish();
+		stream->release();
+	}
+
+	bestTimes[0] = bestTimes[1] = PX_MAX_REAL;
+	for(PxU32 run=0; run<nbRuns; run++)
+	{
+		for(PxU32 j=0; j<2; j++)
+		{
+			PxDefaultMemoryInputData inputData(compressedStream.getData(), compressedStream.getSize());
+
+			const PxU64 startTime = SnippetUtils::getCurrentTimeCounterValue();
+			PxDecompressBinaryData(inputData, alignedBlock, outputStream.getSize(), j ? gDispatcher : NULL);
+			PxCollection* collection = PxSerialization::createCollectionFromBinary(alignedBlock, *sr, NULL, j ? gDispatcher : NULL);
+			const PxU64 elapsedTime = SnippetUtils::getCurrentTimeCounterValue() - startTime;
+			bestTimes[j] = PxMin(bestTimes[j], SnippetUtils::getElapsedTimeInMilliseconds(elapsedTime));
+
+			PxCollectionExt::releaseObjects(*collection);
+			collection->release();
+		}
+	}
+	free(baseAddr);
+
+	printf("Compressed binary (%.1f MB): %.2f ms without dispatcher, %.2f ms with %d worker threads, decompression included.\n",
+		PxReal(compressedStream.getSize())/(1024.0f*1024.0f), PxF64(bestTimes[0]), PxF64(bestTimes[1]), gDispatcher->getWorkerCount());
+
+	sr->release();
+}
+
 /**
 Initializes physics and creates a scene
 */
@@ -301,6 +412,7 @@ int snippetMain(int, const char*const*)
 	static const PxU32 frameCount = 250;
 	for(PxU32 i=0; i<frameCount; i++)
 		stepPhysics();
+	benchmarkBinaryDeserialization();
 	cleanupPhysics();
 	printf("SnippetSerialization done.\n");
 #endif
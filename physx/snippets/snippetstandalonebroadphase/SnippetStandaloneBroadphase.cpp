@@ -32,6 +32,11 @@
 // scene objects. These objects are then updated each frame and rendered in red
 // when they touch another object, or green if they don't. Use the P and O keys
 // to pause and step the simulation one frame, to visually check the results.
+//
+// When the snippet runs without rendering, it also benchmarks the available CPU
+// broadphases on a larger scene, for objects insertion, coherent motion and a
+// mass teleport. The multithreaded broadphases run their update with a
+// continuation task, using a CPU dispatcher and a task manager.
 // ****************************************************************************
 
 #include <ctype.h>
@@ -237,6 +242,160 @@ void stepPhysics(bool /*interactive*/)
 {
 }
 
+#ifndef RENDER_SNIPPET
+static const PxU32	gNbBenchmarkObjects		= 20000;
+static const PxU32	gNbBenchmarkFrames		= 50;
+static const PxU32	gNbBenchmarkThreads		= 4;
+static const float	gBenchmarkWorldSize		= 60.0f;
+
+namespace
+{
+	// TaskWait runs after the broadphase update has completed.
+	class TaskWait : public PxLightCpuTask
+	{
+	public:
+
+		TaskWait(SnippetUtils::Sync* syncHandle) : PxLightCpuTask(), mSyncHandle(syncHandle)	{}
+
+		virtual void run()	{}
+
+		PX_INLINE void release()
+		{
+			PxLightCpuTask::release();
+			SnippetUtils::syncSet(mSyncHandle);
+		}
+
+		virtual const char* getName() const { return "TaskWait"; }
+
+	private:
+
+		SnippetUtils::Sync* mSyncHandle;
+	};
+
+	class Benchmark
+	{
+		public:
+			Benchmark(PxBroadPhaseType::Enum type, PxTaskManager* taskManager) :
+				mTaskManager(taskManager), mNbPairs(0), mSeed(42)
+			{
+				PxBroadPhaseDesc bpDesc(type);
+				mBroadphase = PxCreateBroadPhase(bpDesc);
+				mAABBManager = PxCreateAABBManager(*mBroadphase);
+				mSync = SnippetUtils::syncCreate();
+			}
+
+			~Benchmark()
+			{
+				SnippetUtils::syncRelease(mSync);
+				PX_RELEASE(mAABBManager);
+				PX_RELEASE(mBroadphase);
+			}
+
+			PxVec3 randomPosition()
+			{
+				PxVec3 p;
+				for(PxU32 j=0;j<3;j++)
+				{
+					mSeed = mSeed * 1664525u + 1013904223u;
+					p[j] = (float(mSeed>>8) / float(1<<24)) * gBenchmarkWorldSize;
+				}
+				return p;
+			}
+
+			void runBroadphase()
+			{
+				SnippetUtils::syncReset(mSync);
+
+				mTaskManager->resetDependencies();
+				mTaskManager->startSimulation();
+
+				TaskWait taskWait(mSync);
+				taskWait.setContinuation(*mTaskManager, NULL);
+				mAABBManager->update(&taskWait);
+				taskWait.removeReference();
+
+				SnippetUtils::syncWait(mSync);
+				mTaskManager->stopSimulation();
+
+				PxBroadPhaseResults results;
+				mAABBManager->fetchResults(results);
+				mNbPairs += results.mNbCreatedPairs;
+				mNbPairs -= results.mNbDeletedPairs;
+			}
+
+			void run(const char* name)
+			{
+				const PxVec3 extents(0.5f);
+
+				PxU64 time = SnippetUtils::getCurrentTimeCounterValue();
+				for(PxU32 i=0;i<gNbBenchmarkObjects;i++)
+				{
+					const PxVec3 p = randomPosition();
+					mPositions.pushBack(p);
+					mAABBManager->addObject(i, PxBounds3(p - extents, p + extents), PxGetBroadPhaseDynamicFilterGroup(i));
+				}
+				runBroadphase();
+				const PxReal insertionTime = SnippetUtils::getElapsedTimeInMilliseconds(SnippetUtils::getCurrentTimeCounterValue() - time);
+				const PxU32 nbInsertionPairs = mNbPairs;
+
+				time = SnippetUtils::getCurrentTimeCounterValue();
+				for(PxU32 frame=0;frame<gNbBenchmarkFrames;frame++)
+				{
+					for(PxU32 i=0;i<gNbBenchmarkObjects;i++)
+					{
+						const float coeff = float(i)*0.1f + float(frame)*0.2f;
+						const PxVec3 p = mPositions[i] + PxVec3(sinf(coeff), cosf(coeff*0.7f), sinf(coeff*1.3f))*0.2f;
+						const PxBounds3 bounds(p - extents, p + extents);
+						mAABBManager->updateObject(i, &bounds);
+					}
+					runBroadphase();
+				}
+				const PxReal motionTime = SnippetUtils::getElapsedTimeInMilliseconds(SnippetUtils::getCurrentTimeCounterValue() - time);
+
+				time = SnippetUtils::getCurrentTimeCounterValue();
+				for(PxU32 i=0;i<gNbBenchmarkObjects;i++)
+				{
+					const PxVec3 p = randomPosition();
+					const PxBounds3 bounds(p - extents, p + extents);
+					mAABBManager->updateObject(i, &bounds);
+				}
+				runBroadphase();
+				const PxReal teleportTime = SnippetUtils::getElapsedTimeInMilliseconds(SnippetUtils::getCurrentTimeCounterValue() - time);
+
+				printf("%-6s insertion: %7.2f ms (%d pairs) | %d frames: %7.2f ms | teleport: %7.2f ms (%d pairs)\n",
+					name, double(insertionTime), nbInsertionPairs, gNbBenchmarkFrames, double(motionTime), double(teleportTime), mNbPairs);
+			}
+
+			PxBroadPhase*			mBroadphase;
+			PxAABBManager*			mAABBManager;
+			PxTaskManager*			mTaskManager;
+			SnippetUtils::Sync*		mSync;
+			PxArray<PxVec3>			mPositions;
+			PxU32					mNbPairs;
+			PxU32					mSeed;
+	};
+}
+
+static void benchmarkBroadphases()
+{
+	printf("Benchmarking broadphases with %d objects and %d threads.\n", gNbBenchmarkObjects, gNbBenchmarkThreads);
+
+	PxDefaultCpuDispatcher* dispatcher = PxDefaultCpuDispatcherCreate(gNbBenchmarkThreads);
+	PxTaskManager* taskManager = PxTaskManager::createTaskManager(gFoundation->getErrorCallback(), dispatcher);
+
+	const PxBroadPhaseType::Enum types[] = { PxBroadPhaseType::eSAP, PxBroadPhaseType::ePSAP, PxBroadPhaseType::eABP, PxBroadPhaseType::ePABP };
+	const char* names[] = { "SAP", "PSAP", "ABP", "PABP" };
+	for(PxU32 i=0;i<sizeof(types)/sizeof(types[0]);i++)
+	{
+		Benchmark benchmark(types[i], taskManager);
+		benchmark.run(names[i]);
+	}
+
+	PX_RELEASE(taskManager);
+	PX_RELEASE(dispatcher);
+}
+#endif
+
 void cleanupPhysics(bool /*interactive*/)
 {
 	releaseScene();
@@ -271,6 +430,7 @@ int snippetMain(int, const char*const*)
 	initPhysics(false);
 	for(PxU32 i=0; i<frameCount; i++)
 		stepPhysics(false);
+	benchmarkBroadphases();
 	cleanupPhysics(false);
 #endif
 
@@ -0,0 +1,155 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2024 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "foundation/PxAllocator.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxMath.h"
+#include "foundation/PxSync.h"
+#include "foundation/PxUserAllocated.h"
+#include "task/PxCpuDispatcher.h"
+#include "task/PxTask.h"
+#include "CmParallelFor.h"
+
+using namespace physx;
+using namespace Cm;
+
+namespace
+{
+	#define PARALLEL_FOR_MAX_TASKS	64
+
+	class ParallelForJob;
+
+	class ParallelForTask : public PxBaseTask
+	{
+		public:
+		virtual	void			run()					PX_OVERRIDE;
+		virtual	const char*		getName()		const	PX_OVERRIDE	{ return "Cm::parallelFor";	}
+		virtual	void			addReference()			PX_OVERRIDE	{}
+		virtual	void			removeReference()		PX_OVERRIDE	{}
+		virtual	int32_t			getReference()	const	PX_OVERRIDE	{ return 1;					}
+		virtual	void			release()				PX_OVERRIDE;
+
+				ParallelForJob*	mJob;
+	};
+
+	// PT: the job is shared by the calling thread and the submitted tasks. It is ref-counted because tasks can start (and find
+	// nothing left to do) after the caller has returned, so it cannot live on the caller's stack.
+	class ParallelForJob : public PxUserAllocated
+	{
+		public:
+		ParallelForJob(PxU32 nbItems, PxU32 batchSize, ParallelForCallback callback, void* userData, PxU32 nbTasks) :
+			mCallback		(callback),
+			mUserData		(userData),
+			mNbItems		(nbItems),
+			mBatchSize		(batchSize),
+			mNbBatches		((nbItems + batchSize - 1)/batchSize),
+			mNextBatch		(0),
+			mNbDoneBatches	(0),
+			mRefCount		(PxI32(nbTasks + 1))
+		{
+			for(PxU32 i=0;i<nbTasks;i++)
+				mTasks[i].mJob = this;
+		}
+
+		void	processBatches()
+		{
+			for(;;)
+			{
+				const PxU32 batchIndex = PxU32(PxAtomicIncrement(&mNextBatch) - 1);
+				if(batchIndex>=mNbBatches)
+					return;
+
+				const PxU32 startIndex = batchIndex * mBatchSize;
+				const PxU32 endIndex = PxMin(startIndex + mBatchSize, mNbItems);
+				(mCallback)(mUserData, startIndex, endIndex);
+
+				if(PxU32(PxAtomicIncrement(&mNbDoneBatches))==mNbBatches)
+					mDone.set();
+			}
+		}
+
+		void	releaseReference()
+		{
+			if(!PxAtomicDecrement(&mRefCount))
+				PX_DELETE_THIS;
+		}
+
+		const ParallelForCallback	mCallback;
+		void* const					mUserData;
+		const PxU32					mNbItems;
+		const PxU32					mBatchSize;
+		const PxU32					mNbBatches;
+		volatile PxI32				mNextBatch;
+		volatile PxI32				mNbDoneBatches;
+		volatile PxI32				mRefCount;
+		PxSync						mDone;
+		ParallelForTask				mTasks[PARALLEL_FOR_MAX_TASKS];
+	};
+
+	void ParallelForTask::run()
+	{
+		mJob->processBatches();
+	}
+
+	void ParallelForTask::release()
+	{
+		mJob->releaseReference();
+	}
+}
+
+void Cm::parallelFor(PxCpuDispatcher* dispatcher, PxU32 nbItems, PxU32 batchSize, ParallelForCallback callback, void* userData)
+{
+	if(!nbItems)
+		return;
+
+	batchSize = PxMax(batchSize, 1u);
+	const PxU32 nbBatches = (nbItems + batchSize - 1)/batchSize;
+
+	PxU32 nbTasks = 0;
+	if(dispatcher && nbBatches>1)
+		nbTasks = PxMin(PxMin(dispatcher->getWorkerCount(), nbBatches - 1), PxU32(PARALLEL_FOR_MAX_TASKS));
+
+	if(!nbTasks)
+	{
+		for(PxU32 startIndex=0; startIndex<nbItems; startIndex+=batchSize)
+			(callback)(userData, startIndex, PxMin(startIndex + batchSize, nbItems));
+		return;
+	}
+
+	ParallelForJob* job = PX_NEW(ParallelForJob)(nbItems, batchSize, callback, userData, nbTasks);
+
+	for(PxU32 i=0;i<nbTasks;i++)
+		dispatcher->submitTask(job->mTasks[i]);
+
+	job->processBatches();
+
+	// PT: all batches have been picked up at this point, we only wait for the ones still running on other threads.
+	job->mDone.wait();
+
+	job->releaseReference();
+}
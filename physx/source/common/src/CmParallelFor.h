@@ -0,0 +1,54 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2024 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef CM_PARALLEL_FOR_H
+#define CM_PARALLEL_FOR_H
+
+#include "foundation/Px.h"
+#include "common/PxPhysXCommonConfig.h"
+
+namespace physx
+{
+	class PxCpuDispatcher;
+
+namespace Cm
+{
+	typedef void (*ParallelForCallback)(void* userData, PxU32 startIndex, PxU32 endIndex);
+
+	// PT: runs the callback over [0, nbItems) in batches of up to batchSize items. The work is spread over the dispatcher's
+	// worker threads when a dispatcher is provided and there is more than one batch, otherwise everything runs on the calling
+	// thread. The calling thread always processes batches itself and only waits for batches that have already been picked up
+	// by a worker, so it is safe to call this from a task running on the same dispatcher.
+	//
+	// Batches are processed in an unspecified order, so callbacks should only write to data owned by their [start, end) range
+	// if the results must not depend on the number of threads.
+	PX_PHYSX_COMMON_API void parallelFor(PxCpuDispatcher* dispatcher, PxU32 nbItems, PxU32 batchSize, ParallelForCallback callback, void* userData);
+}
+}
+
+#endif
@@ -28,7 +28,11 @@
 
 #include "foundation/PxMemory.h"
 #include "foundation/PxAssert.h"
+#include "foundation/PxAllocator.h"
+#include "foundation/PxMath.h"
+#include "task/PxCpuDispatcher.h"
 #include "CmRadixSort.h"
+#include "CmParallelFor.h"
 
 // PT: code archeology: this initially came from ICE (IceRevisitedRadix.h/cpp). Consider putting it back the way it was initially.
 
@@ -147,6 +151,176 @@ PX_INLINE const PxU32* CheckPassValidity(PxU32 pass, const PxU32* mHistogram1024
 	return CurCount;
 }
 
+// PT: below this size per thread, the multithreaded passes are not worth the overhead
+#define RADIX_MT_MIN_BLOCK_SIZE	16384
+#define RADIX_MT_MAX_BLOCKS		64
+
+namespace
+{
+	// PT: multithreaded version of the scatter loops in the sort routines. The input is split into contiguous blocks, in the
+	// current sorted order. Each block first counts its own radix values, then writes them starting where the same values
+	// of the previous blocks end. The result is the same as with the single-threaded loops.
+	class ParallelScatter
+	{
+		PX_NOCOPY(ParallelScatter)
+		public:
+							ParallelScatter(PxCpuDispatcher* dispatcher, PxU32 nb);
+							~ParallelScatter();
+
+		PX_FORCE_INLINE	bool	isEnabled()	const	{ return mNbBlocks!=0;	}
+
+		// PT: links [0, nbForwardLinks) are filled forwards from their current position, links [nbForwardLinks, 256)
+		// backwards. The ranks are the current sorted order, or NULL for the input order.
+						void	run(PxU32* const* links256, const PxU8* inputBytes, const PxU32* ranks, PxU32 nbForwardLinks);
+		private:
+		static			void	countBlocks(void* userData, PxU32 startBlock, PxU32 endBlock);
+		static			void	scatterBlocks(void* userData, PxU32 startBlock, PxU32 endBlock);
+
+		PxCpuDispatcher*	mDispatcher;
+		const PxU32			mNb;
+		PxU32				mNbBlocks;
+		PxU32				mBlockSize;
+		PxU32*				mCounts;		// 256 counters per block
+		PxU32**				mBlockLinks;	// 256 links per block
+		const PxU8*			mInputBytes;
+		const PxU32*		mRanks;
+		PxU32				mNbForwardLinks;
+	};
+
+	ParallelScatter::ParallelScatter(PxCpuDispatcher* dispatcher, PxU32 nb) :
+		mDispatcher		(dispatcher),
+		mNb				(nb),
+		mNbBlocks		(0),
+		mBlockSize		(0),
+		mCounts			(NULL),
+		mBlockLinks		(NULL),
+		mInputBytes		(NULL),
+		mRanks			(NULL),
+		mNbForwardLinks	(256)
+	{
+		if(!dispatcher || !dispatcher->getWorkerCount())
+			return;
+
+		// PT: more blocks than threads, for load balancing
+		const PxU32 nbBlocks = PxMin(PxMin((dispatcher->getWorkerCount() + 1)*2, nb/RADIX_MT_MIN_BLOCK_SIZE), PxU32(RADIX_MT_MAX_BLOCKS));
+		if(nbBlocks<2)
+			return;
+
+		mNbBlocks = nbBlocks;
+		mBlockSize = (nb + nbBlocks - 1)/nbBlocks;
+		mBlockLinks = PX_ALLOCATE(PxU32*, nbBlocks*256, "RadixSort:mBlockLinks");
+		mCounts = PX_ALLOCATE(PxU32, nbBlocks*256, "RadixSort:mCounts");
+	}
+
+	ParallelScatter::~ParallelScatter()
+	{
+		PX_FREE(mCounts);
+		PX_FREE(mBlockLinks);
+	}
+
+	void ParallelScatter::countBlocks(void* userData, PxU32 startBlock, PxU32 endBlock)
+	{
+		const ParallelScatter& ps = *reinterpret_cast<const ParallelScatter*>(userData);
+		const PxU8* PX_RESTRICT inputBytes = ps.mInputBytes;
+		const PxU32* PX_RESTRICT ranks = ps.mRanks;
+
+		for(PxU32 block=startBlock; block<endBlock; block++)
+		{
+			PxU32* PX_RESTRICT counts = ps.mCounts + block*256;
+			PxMemZero(counts, 256*sizeof(PxU32));
+
+			const PxU32 start = block*ps.mBlockSize;
+			const PxU32 end = PxMin(start + ps.mBlockSize, ps.mNb);
+			if(ranks)
+			{
+				for(PxU32 i=start;i<end;i++)
+					counts[inputBytes[ranks[i]<<2]]++;
+			}
+			else
+			{
+				for(PxU32 i=start;i<end;i++)
+					counts[inputBytes[i<<2]]++;
+			}
+		}
+	}
+
+	void ParallelScatter::scatterBlocks(void* userData, PxU32 startBlock, PxU32 endBlock)
+	{
+		const ParallelScatter& ps = *reinterpret_cast<const ParallelScatter*>(userData);
+		const PxU8* PX_RESTRICT inputBytes = ps.mInputBytes;
+		const PxU32* PX_RESTRICT ranks = ps.mRanks;
+		const PxU32 nbForwardLinks = ps.mNbForwardLinks;
+
+		for(PxU32 block=startBlock; block<endBlock; block++)
+		{
+			PxU32** PX_RESTRICT links = ps.mBlockLinks + block*256;
+
+			const PxU32 start = block*ps.mBlockSize;
+			const PxU32 end = PxMin(start + ps.mBlockSize, ps.mNb);
+			if(nbForwardLinks==256)
+			{
+				if(ranks)
+				{
+					for(PxU32 i=start;i<end;i++)
+					{
+						const PxU32 id = ranks[i];
+						*links[inputBytes[id<<2]]++ = id;
+					}
+				}
+				else
+				{
+					for(PxU32 i=start;i<end;i++)
+						*links[inputBytes[i<<2]]++ = i;
+				}
+			}
+			else
+			{
+				for(PxU32 i=start;i<end;i++)
+				{
+					const PxU32 id = ranks ? ranks[i] : i;
+					const PxU32 radix = inputBytes[id<<2];
+					if(radix<nbForwardLinks)	*links[radix]++ = id;
+					else						*(--links[radix]) = id;
+				}
+			}
+		}
+	}
+
+	void ParallelScatter::run(PxU32* const* links256, const PxU8* inputBytes, const PxU32* ranks, PxU32 nbForwardLinks)
+	{
+		PX_ASSERT(isEnabled());
+		mInputBytes = inputBytes;
+		mRanks = ranks;
+		mNbForwardLinks = nbForwardLinks;
+
+		Cm::parallelFor(mDispatcher, mNbBlocks, 1, countBlocks, this);
+
+		// PT: each block starts where the previous blocks stopped
+		for(PxU32 radix=0;radix<256;radix++)
+		{
+			PxU32* link = links256[radix];
+			if(radix<nbForwardLinks)
+			{
+				for(PxU32 block=0;block<mNbBlocks;block++)
+				{
+					mBlockLinks[block*256 + radix] = link;
+					link += mCounts[block*256 + radix];
+				}
+			}
+			else
+			{
+				for(PxU32 block=0;block<mNbBlocks;block++)
+				{
+					mBlockLinks[block*256 + radix] = link;
+					link -= mCounts[block*256 + radix];
+				}
+			}
+		}
+
+		Cm::parallelFor(mDispatcher, mNbBlocks, 1, scatterBlocks, this);
+	}
+}
+
 RadixSort::RadixSort() : mCurrentSize(0), mRanks(NULL), mRanks2(NULL), mHistogram1024(0), mLinks256(0), mTotalCalls(0), mNbHits(0), mDeleteRanks(true)
 {
 	// Initialize indices
@@ -163,9 +337,10 @@ RadixSort::~RadixSort()
  *	\param		input	[in] a list of integer values to sort
  *	\param		nb		[in] number of values to sort, must be < 2^31
  *	\param		hint	[in] RADIX_SIGNED to handle negative values, RADIX_UNSIGNED if you know your input buffer only contains positive values
+ *	\param		dispatcher	[in] optional dispatcher used to split large passes across threads
  *	\return		Self-Reference
  */
-RadixSort& RadixSort::Sort(const PxU32* input, PxU32 nb, RadixHint hint)
+RadixSort& RadixSort::Sort(const PxU32* input, PxU32 nb, RadixHint hint, PxCpuDispatcher* dispatcher)
 {
 	PX_ASSERT(mHistogram1024);
 	PX_ASSERT(mLinks256);
@@ -198,6 +373,8 @@ RadixSort& RadixSort::Sort(const PxU32* input, PxU32 nb, RadixHint hint)
 		for(PxU32 i=128;i<256;i++)	NbNegativeValues += h3[i];	// 768 for last histogram, 128 for negative part
 	}
 
+	ParallelScatter parallelScatter(dispatcher, nb);
+
 	// Radix sort, j is the pass number (0=LSB, 3=MSB)
 	for(PxU32 j=0;j<4;j++)
 	{
@@ -239,7 +416,12 @@ RadixSort& RadixSort::Sort(const PxU32* input, PxU32 nb, RadixHint hint)
 			// Perform Radix Sort
 			const PxU8* PX_RESTRICT InputBytes = reinterpret_cast<const PxU8*>(input);
             InputBytes += BYTES_INC;
-			if(INVALID_RANKS)
+			if(parallelScatter.isEnabled())
+			{
+				parallelScatter.run(Links256, InputBytes, INVALID_RANKS ? NULL : mRanks, 256);
+				VALIDATE_RANKS;
+			}
+			else if(INVALID_RANKS)
 			{
 				for(PxU32 i=0;i<nb;i++)
 					*Links256[InputBytes[i<<2]]++ = i;
@@ -268,10 +450,11 @@ RadixSort& RadixSort::Sort(const PxU32* input, PxU32 nb, RadixHint hint)
  *	This one is for floating-point values. After the call, mRanks contains a list of indices in sorted order, i.e. in the order you may process your data.
  *	\param		input2			[in] a list of floating-point values to sort
  *	\param		nb				[in] number of values to sort, must be < 2^31
+ *	\param		dispatcher		[in] optional dispatcher used to split large passes across threads
  *	\return		Self-Reference
  *	\warning	only sorts IEEE floating-point values
  */
-RadixSort& RadixSort::Sort(const float* input2, PxU32 nb)
+RadixSort& RadixSort::Sort(const float* input2, PxU32 nb, PxCpuDispatcher* dispatcher)
 {
 	PX_ASSERT(mHistogram1024);
 	PX_ASSERT(mLinks256);
@@ -310,6 +493,8 @@ RadixSort& RadixSort::Sort(const float* input2, PxU32 nb)
 	PxU32* PX_RESTRICT h3= &mHistogram1024[768];
 	for(PxU32 i=128;i<256;i++)	NbNegativeValues += h3[i];	// 768 for last histogram, 128 for negative part
 
+	ParallelScatter parallelScatter(dispatcher, nb);
+
 	// Radix sort, j is the pass number (0=LSB, 3=MSB)
 	for(PxU32 j=0;j<4;j++)
 	{
@@ -334,7 +519,12 @@ RadixSort& RadixSort::Sort(const float* input2, PxU32 nb)
 				// Perform Radix Sort
 				const PxU8* PX_RESTRICT InputBytes = reinterpret_cast<const PxU8*>(input);
                 InputBytes += BYTES_INC;
-				if(INVALID_RANKS)
+				if(parallelScatter.isEnabled())
+				{
+					parallelScatter.run(Links256, InputBytes, INVALID_RANKS ? NULL : mRanks, 256);
+					VALIDATE_RANKS;
+				}
+				else if(INVALID_RANKS)
 				{
 					for(PxU32 i=0;i<nb;i++)
 						*Links256[InputBytes[i<<2]]++ = i;
@@ -378,7 +568,14 @@ RadixSort& RadixSort::Sort(const float* input2, PxU32 nb)
 					Links256[i] += CurCount[i];							// Fixing the wrong place for negative values
 
 				// Perform Radix Sort
-				if(INVALID_RANKS)
+				if(parallelScatter.isEnabled())
+				{
+					// PT: the radix byte is the MSB, i.e. the same as input[i]>>24 below
+					const PxU8* PX_RESTRICT InputBytes = reinterpret_cast<const PxU8*>(input) + BYTES_INC;
+					parallelScatter.run(Links256, InputBytes, INVALID_RANKS ? NULL : mRanks, 128);
+					VALIDATE_RANKS;
+				}
+				else if(INVALID_RANKS)
 				{
 					for(PxU32 i=0;i<nb;i++)
 					{
@@ -449,7 +646,7 @@ using namespace physx;
 using namespace Cm;
 
 RadixSortBuffered::RadixSortBuffered()
-: RadixSort()
+: RadixSort(), mCapacity(0)
 {
 }
 
@@ -466,6 +663,7 @@ void RadixSortBuffered::reset()
 		PX_FREE(mRanks2);
 		PX_FREE(mRanks);
 	}
+	mCapacity = 0;
 	mCurrentSize = 0;
 	INVALIDATE_RANKS;
 }
@@ -486,6 +684,7 @@ bool RadixSortBuffered::Resize(PxU32 nb)
 		// Get some fresh one
 		mRanks	= PX_ALLOCATE(PxU32, nb, "RadixSortBuffered:mRanks");
 		mRanks2	= PX_ALLOCATE(PxU32, nb, "RadixSortBuffered:mRanks2");
+		mCapacity = nb;
 	}
 
 	return true;
@@ -496,7 +695,9 @@ PX_INLINE void RadixSortBuffered::CheckResize(PxU32 nb)
 	PxU32 CurSize = CURRENT_SIZE;
 	if(nb!=CurSize)
 	{
-		if(nb>CurSize)
+		// PT: compare to the allocated size rather than the previous one. Persistent sorters (broadphases, pruners) see
+		// slightly different sizes each frame, and we used to reallocate the buffers each time the size went up again.
+		if(nb>mCapacity)
 			Resize(nb);
 		mCurrentSize = nb;
 		INVALIDATE_RANKS;
@@ -509,9 +710,10 @@ PX_INLINE void RadixSortBuffered::CheckResize(PxU32 nb)
  *	\param		input	[in] a list of integer values to sort
  *	\param		nb		[in] number of values to sort, must be < 2^31
  *	\param		hint	[in] RADIX_SIGNED to handle negative values, RADIX_UNSIGNED if you know your input buffer only contains positive values
+ *	\param		dispatcher	[in] optional dispatcher used to split large passes across threads
  *	\return		Self-Reference
  */
-RadixSortBuffered& RadixSortBuffered::Sort(const PxU32* input, PxU32 nb, RadixHint hint)
+RadixSortBuffered& RadixSortBuffered::Sort(const PxU32* input, PxU32 nb, RadixHint hint, PxCpuDispatcher* dispatcher)
 {
 	// Checkings
 	if(!input || !nb || nb&0x80000000)
@@ -526,7 +728,7 @@ RadixSortBuffered& RadixSortBuffered::Sort(const PxU32* input, PxU32 nb, RadixHi
 	mHistogram1024 = histogram;
 	mLinks256 = links;
 
-	RadixSort::Sort(input, nb, hint);
+	RadixSort::Sort(input, nb, hint, dispatcher);
 	return *this;
 }
 
@@ -535,10 +737,11 @@ RadixSortBuffered& RadixSortBuffered::Sort(const PxU32* input, PxU32 nb, RadixHi
  *	This one is for floating-point values. After the call, mRanks contains a list of indices in sorted order, i.e. in the order you may process your data.
  *	\param		input2			[in] a list of floating-point values to sort
  *	\param		nb				[in] number of values to sort, must be < 2^31
+ *	\param		dispatcher		[in] optional dispatcher used to split large passes across threads
  *	\return		Self-Reference
  *	\warning	only sorts IEEE floating-point values
  */
-RadixSortBuffered& RadixSortBuffered::Sort(const float* input2, PxU32 nb)
+RadixSortBuffered& RadixSortBuffered::Sort(const float* input2, PxU32 nb, PxCpuDispatcher* dispatcher)
 {
 	// Checkings
 	if(!input2 || !nb || nb&0x80000000)
@@ -553,7 +756,7 @@ RadixSortBuffered& RadixSortBuffered::Sort(const float* input2, PxU32 nb)
 	mHistogram1024 = histogram;
 	mLinks256 = links;
 
-	RadixSort::Sort(input2, nb);
+	RadixSort::Sort(input2, nb, dispatcher);
 	return *this;
 }
 
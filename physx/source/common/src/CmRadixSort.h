@@ -33,6 +33,8 @@
 
 namespace physx
 {
+	class PxCpuDispatcher;
+
 namespace Cm
 {
 	enum RadixHint
@@ -54,9 +56,10 @@ namespace Cm
 		public:
 										RadixSort();
 		virtual							~RadixSort();
-		// Sorting methods
-						RadixSort&		Sort(const PxU32* input, PxU32 nb, RadixHint hint=RADIX_SIGNED);
-						RadixSort&		Sort(const float* input, PxU32 nb);
+		// Sorting methods. With a dispatcher, the passes over large inputs are split across its worker threads. The results do
+		// not depend on the number of threads.
+						RadixSort&		Sort(const PxU32* input, PxU32 nb, RadixHint hint=RADIX_SIGNED, PxCpuDispatcher* dispatcher=NULL);
+						RadixSort&		Sort(const float* input, PxU32 nb, PxCpuDispatcher* dispatcher=NULL);
 
 		//! Access to results. mRanks is a list of indices in sorted order, i.e. in the order you may further process your data
 		PX_FORCE_INLINE	const PxU32*	GetRanks()			const	{ return mRanks;		}
@@ -100,8 +103,8 @@ namespace Cm
 
 		void				reset();
 
-		RadixSortBuffered&	Sort(const PxU32* input, PxU32 nb, RadixHint hint=RADIX_SIGNED);
-		RadixSortBuffered&	Sort(const float* input, PxU32 nb);
+		RadixSortBuffered&	Sort(const PxU32* input, PxU32 nb, RadixHint hint=RADIX_SIGNED, PxCpuDispatcher* dispatcher=NULL);
+		RadixSortBuffered&	Sort(const float* input, PxU32 nb, PxCpuDispatcher* dispatcher=NULL);
 
 	private:
 							RadixSortBuffered(const RadixSortBuffered& object);
@@ -110,6 +113,8 @@ namespace Cm
 		// Internal methods
 		void				CheckResize(PxU32 nb);
 		bool				Resize(PxU32 nb);
+
+		PxU32				mCapacity;	//!< Allocated size of the ranks buffers, can be larger than CURRENT_SIZE
 	};
 }
 }
@@ -77,6 +77,7 @@ SET(LLDYNAMICS_SOURCE
 	${LLDYNAMICS_BASE_DIR}/src/DyArticulationMimicJoint.cpp
 	${LLDYNAMICS_BASE_DIR}/src/DyFeatherstoneArticulation.cpp
 	${LLDYNAMICS_BASE_DIR}/src/DyFeatherstoneForwardDynamic.cpp
+	${LLDYNAMICS_BASE_DIR}/src/DyFeatherstoneForwardDynamicBatch.cpp
 	${LLDYNAMICS_BASE_DIR}/src/DyFeatherstoneInverseDynamic.cpp
 	${LLDYNAMICS_BASE_DIR}/src/DyConstraintPartition.cpp
 	${LLDYNAMICS_BASE_DIR}/src/DyConstraintSetup.cpp
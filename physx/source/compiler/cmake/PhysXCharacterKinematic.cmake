@@ -53,6 +53,7 @@ SET(PHYSXCCT_SOURCE
 	${LL_SOURCE_DIR}/CctCharacterControllerCallbacks.cpp
 	${LL_SOURCE_DIR}/CctCharacterControllerManager.cpp
 	${LL_SOURCE_DIR}/CctController.cpp
+	${LL_SOURCE_DIR}/CctGeometryCache.cpp
 	${LL_SOURCE_DIR}/CctObstacleContext.cpp
 	${LL_SOURCE_DIR}/CctSweptBox.cpp
 	${LL_SOURCE_DIR}/CctSweptCapsule.cpp
@@ -62,6 +63,7 @@ SET(PHYSXCCT_SOURCE
 	${LL_SOURCE_DIR}/CctCharacterController.h
 	${LL_SOURCE_DIR}/CctCharacterControllerManager.h
 	${LL_SOURCE_DIR}/CctController.h
+	${LL_SOURCE_DIR}/CctGeometryCache.h
 	${LL_SOURCE_DIR}/CctInternalStructs.h
 	${LL_SOURCE_DIR}/CctObstacleContext.h
 	${LL_SOURCE_DIR}/CctSweptBox.h
@@ -87,6 +89,7 @@ TARGET_INCLUDE_DIRECTORIES(PhysXCharacterKinematic
 	PRIVATE ${PHYSX_SOURCE_DIR}/common/src
 	
 	PRIVATE ${PHYSX_SOURCE_DIR}/geomutils/include
+	PRIVATE ${PHYSX_SOURCE_DIR}/geomutils/src
 )
 
 TARGET_COMPILE_DEFINITIONS(PhysXCharacterKinematic 
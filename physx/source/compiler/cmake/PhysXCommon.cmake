@@ -52,6 +52,8 @@ SET(PHYSX_COMMON_SOURCE
 	${COMMON_SRC_DIR}/CmFlushPool.h
 	${COMMON_SRC_DIR}/CmIDPool.h
 	${COMMON_SRC_DIR}/CmMatrix34.h
+	${COMMON_SRC_DIR}/CmParallelFor.h
+	${COMMON_SRC_DIR}/CmParallelFor.cpp
 	${COMMON_SRC_DIR}/CmPool.h
 	${COMMON_SRC_DIR}/CmPreallocatingPool.h
 	${COMMON_SRC_DIR}/CmPriorityQueue.h
@@ -119,6 +121,7 @@ SET(PHYSXCOMMON_GEOMETRY_HEADERS
 	${PHYSX_ROOT_DIR}/include/geometry/PxHeightFieldFlag.h
 	${PHYSX_ROOT_DIR}/include/geometry/PxHeightFieldGeometry.h
 	${PHYSX_ROOT_DIR}/include/geometry/PxHeightFieldSample.h
+	${PHYSX_ROOT_DIR}/include/geometry/PxMappedGeometryData.h
 	${PHYSX_ROOT_DIR}/include/geometry/PxMeshQuery.h
 	${PHYSX_ROOT_DIR}/include/geometry/PxMeshScale.h
 	${PHYSX_ROOT_DIR}/include/geometry/PxPlaneGeometry.h
@@ -193,6 +196,7 @@ SET(PHYSXCOMMON_GU_SOURCE
 	${GU_SOURCE_DIR}/src/GuCCTSweepTests.cpp	
 	${GU_SOURCE_DIR}/src/GuGeometryQuery.cpp
 	${GU_SOURCE_DIR}/src/GuInternal.cpp
+	${GU_SOURCE_DIR}/src/GuMappedGeometryData.cpp
 	${GU_SOURCE_DIR}/src/GuMeshFactory.cpp
 	${GU_SOURCE_DIR}/src/GuMetaData.cpp
 	${GU_SOURCE_DIR}/src/GuMTD.cpp
@@ -75,6 +75,12 @@ SET(PHYSX_EXTENSIONS_SOURCE
 	${LL_SOURCE_DIR}/ExtTetMakerExt.cpp
 	${LL_SOURCE_DIR}/ExtGjkQueryExt.cpp
 	${LL_SOURCE_DIR}/ExtCustomGeometryExt.cpp
+	${LL_SOURCE_DIR}/ExtWorldStreamer.cpp
+	${LL_SOURCE_DIR}/ExtBinaryCompression.cpp
+	${LL_SOURCE_DIR}/ExtTiledHeightField.cpp
+	${LL_SOURCE_DIR}/ExtCookingCache.cpp
+	${LL_SOURCE_DIR}/ExtImmediatePairCache.cpp
+	${LL_SOURCE_DIR}/ExtImmediateScene.cpp
 )
 
 #TODO, create a propper define for whether GPU features are enabled or not!
@@ -204,6 +210,12 @@ SET(PHYSX_EXTENSIONS_HEADERS
 	${PHYSX_ROOT_DIR}/include/extensions/PxGjkQueryExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxCustomGeometryExt.h
 	${PHYSX_ROOT_DIR}/include/extensions/PxSamplingExt.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxWorldStreamer.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxBinaryCompression.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxTiledHeightField.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxCookingCache.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxImmediatePairCache.h
+	${PHYSX_ROOT_DIR}/include/extensions/PxImmediateScene.h
 )
 
 
@@ -109,6 +109,8 @@ TARGET_INCLUDE_DIRECTORIES(PhysXVehicle
 	PRIVATE ${PHYSX_SOURCE_DIR}/common/include
 	PRIVATE ${PHYSX_SOURCE_DIR}/common/src
 
+	PRIVATE ${PHYSX_SOURCE_DIR}/geomutils/src
+
 	PRIVATE ${PHYSX_SOURCE_DIR}/physxvehicle/src
 	PRIVATE ${PHYSX_SOURCE_DIR}/physxvehicle/src/physxmetadata/include
 
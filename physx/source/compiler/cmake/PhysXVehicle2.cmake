@@ -43,6 +43,11 @@ SET(PHYSX_VEHICLE2_HEADERS
 	${PHYSX_ROOT_DIR}/include/vehicle2/PxVehicleParams.h
 	${PHYSX_ROOT_DIR}/include/vehicle2/PxVehicleMaths.h
 )
+SET(PHYSX_VEHICLE2_BATCH_HEADERS
+	${PHYSX_ROOT_DIR}/include/vehicle2/batch/PxVehicleBatchData.h
+	${PHYSX_ROOT_DIR}/include/vehicle2/batch/PxVehicleBatchFunctions.h
+	${PHYSX_ROOT_DIR}/include/vehicle2/batch/PxVehicleBatchHelpers.h
+)
 SET(PHYSX_VEHICLE2_BRAKING_HEADERS
 	${PHYSX_ROOT_DIR}/include/vehicle2/braking/PxVehicleBrakingFunctions.h
 	${PHYSX_ROOT_DIR}/include/vehicle2/braking/PxVehicleBrakingParams.h
@@ -120,6 +125,7 @@ SET(PHYSX_VEHICLE2_PVD_HEADERS
 )
 
 SOURCE_GROUP(include FILES ${PHYSX_VEHICLE2_HEADERS})
+SOURCE_GROUP(include\\batch FILES ${PHYSX_VEHICLE2_BATCH_HEADERS})
 SOURCE_GROUP(include\\braking FILES ${PHYSX_VEHICLE2_BRAKING_HEADERS})
 SOURCE_GROUP(include\\commands FILES ${PHYSX_VEHICLE2_COMMAND_HEADERS})
 SOURCE_GROUP(include\\drivetrain FILES ${PHYSX_VEHICLE2_DRIVETRAIN_HEADERS})
@@ -135,6 +141,9 @@ SOURCE_GROUP(include\\wheel FILES ${PHYSX_VEHICLE2_WHEEL_HEADERS})
 SOURCE_GROUP(include\\pvd FILES ${PHYSX_VEHICLE2_PVD_HEADERS})
 
 
+SET(PHYSX_VEHICLE2_BATCH_SOURCE
+	${LL_SOURCE_DIR}/batch/VhBatchFunctions.cpp
+)
 SET(PHYSX_VEHICLE2_BRAKING_SOURCE
 )
 SET(PHYSX_VEHICLE2_COMMANDS_SOURCE
@@ -182,6 +191,7 @@ SET(PHYSX_VEHICLE2_PVD_SOURCE
 	${LL_SOURCE_DIR}/pvd/VhPvdWriter.h
 )
 
+SOURCE_GROUP(src\\batch FILES ${PHYSX_VEHICLE2_BATCH_SOURCE})
 SOURCE_GROUP(src\\braking FILES ${PHYSX_VEHICLE2_BRAKING_SOURCE})
 SOURCE_GROUP(src\\commands FILES ${PHYSX_VEHICLE2_COMMANDS_SOURCE})
 SOURCE_GROUP(src\\drivetrain FILES ${PHYSX_VEHICLE2_DRIVETRAIN_SOURCE})
@@ -196,6 +206,7 @@ SOURCE_GROUP(src\\wheel FILES ${PHYSX_VEHICLE2_WHEEL_SOURCE})
 SOURCE_GROUP(src\\pvd FILES ${PHYSX_VEHICLE2_PVD_SOURCE})
 
 ADD_LIBRARY(PhysXVehicle2 ${PHYSXVEHICLE2_LIBTYPE}
+	${PHYSX_VEHICLE2_BATCH_SOURCE}
 	${PHYSX_VEHICLE2_BRAKING_SOURCE}
 	${PHYSX_VEHICLE2_COMMANDS_SOURCE}
 	${PHYSX_VEHICLE2_DRIVETRAIN_SOURCE}
@@ -209,6 +220,7 @@ ADD_LIBRARY(PhysXVehicle2 ${PHYSXVEHICLE2_LIBTYPE}
 	${PHYSX_VEHICLE2_WHEEL_SOURCE}
 	${PHYSX_VEHICLE2_PVD_SOURCE}
 	${PHYSX_VEHICLE2_HEADERS}
+	${PHYSX_VEHICLE2_BATCH_HEADERS}
 	${PHYSX_VEHICLE2_BRAKING_HEADERS}
 	${PHYSX_VEHICLE2_COMMAND_HEADERS}
 	${PHYSX_VEHICLE2_DRIVETRAIN_HEADERS}
@@ -225,6 +237,7 @@ ADD_LIBRARY(PhysXVehicle2 ${PHYSXVEHICLE2_LIBTYPE}
 )
 
 INSTALL(FILES ${PHYSX_VEHICLE2_HEADERS} DESTINATION include/vehicle2)
+INSTALL(FILES ${PHYSX_VEHICLE2_BATCH_HEADERS} DESTINATION include/vehicle2/batch)
 INSTALL(FILES ${PHYSX_VEHICLE2_BRAKING_HEADERS} DESTINATION include/vehicle2/braking)
 INSTALL(FILES ${PHYSX_VEHICLE2_COMMAND_HEADERS} DESTINATION include/vehicle2/commands)
 INSTALL(FILES ${PHYSX_VEHICLE2_DRIVETRAIN_HEADERS} DESTINATION include/vehicle2/drivetrain)
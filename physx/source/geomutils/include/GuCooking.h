@@ -100,6 +100,7 @@ namespace physx
 		// Convex meshes
 		PX_C_EXPORT PX_PHYSX_COMMON_API	bool cookConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition=NULL);
 		PX_C_EXPORT PX_PHYSX_COMMON_API	PxConvexMesh* createConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxInsertionCallback& insertionCallback, PxConvexMeshCookingResult::Enum* condition=NULL);
+		PX_C_EXPORT PX_PHYSX_COMMON_API	PxU32 createConvexMeshes(const PxCookingParams& params, PxU32 nbMeshes, const PxConvexMeshDesc* descs, PxConvexMesh** meshes, PxInsertionCallback& insertionCallback, PxConvexMeshCookingResult::Enum* conditions=NULL);
 
 		PX_FORCE_INLINE	PxConvexMesh* createConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc)
 		{
@@ -131,7 +131,7 @@ namespace physx
 	}
 
 	static bool createSDFSparse(PxTriangleMeshDesc& desc, PxSDFDesc& sdfDesc, PxArray<PxReal>& sdfCoarse, PxArray<PxU8>& sdfDataSubgrids,
-		PxArray<PxU32>& sdfSubgridsStartSlots)
+		PxArray<PxU32>& sdfSubgridsStartSlots, PxCpuDispatcher* dispatcher)
 	{
 		PX_ASSERT(sdfDesc.subgridSize > 0);
 
@@ -219,13 +219,15 @@ namespace physx
 		{		
 			PxArray<PxReal> denseSdf;			
 			PxArray<PxReal> sparseSdf;
-			Gu::SDFUsingWindingNumbersSparse(
+			if (!Gu::SDFUsingWindingNumbersSparse(
 				baseMeshSpecified ? verticesPtr : &mesh.m_positions[0],
 				baseMeshSpecified ? indices32.begin() : &mesh.m_indices[0],
 				baseMeshSpecified ? indices32.size() : mesh.m_indices.size(),
 				dx, dy, dz,
 				meshLower, meshLower + PxVec3(static_cast<PxReal>(dx), static_cast<PxReal>(dy), static_cast<PxReal>(dz)) * spacing, narrowBandThickness, sdfDesc.subgridSize,
-				sdfCoarse, sdfSubgridsStartSlots, sparseSdf, denseSdf, subgridsMinSdfValue, subgridsMaxSdfValue, 16, sdfDesc.sdfBuilder);
+				sdfCoarse, sdfSubgridsStartSlots, sparseSdf, denseSdf, subgridsMinSdfValue, subgridsMaxSdfValue, 16, sdfDesc.sdfBuilder,
+				dispatcher, sdfDesc.progressCallback))
+				return false; // cancelled by the progress callback
 
 			PxArray<PxReal> uncompressedSdfDataSubgrids;
 			Gu::convertSparseSDFTo3DTextureLayout(dx, dy, dz, sdfDesc.subgridSize, sdfSubgridsStartSlots.begin(), sparseSdf.begin(), sparseSdf.size(), uncompressedSdfDataSubgrids,
@@ -283,11 +285,12 @@ namespace physx
 		return success; // false if we had GPU errors.
 	}
 
-	static bool createSDF(PxTriangleMeshDesc& desc, PxSDFDesc& sdfDesc, PxArray<PxReal>& sdf, PxArray<PxU8>& sdfDataSubgrids, PxArray<PxU32>& sdfSubgridsStartSlots)
+	static bool createSDF(PxTriangleMeshDesc& desc, PxSDFDesc& sdfDesc, PxArray<PxReal>& sdf, PxArray<PxU8>& sdfDataSubgrids, PxArray<PxU32>& sdfSubgridsStartSlots,
+		PxCpuDispatcher* dispatcher)
 	{
 		if (sdfDesc.subgridSize > 0)
 		{
-			return createSDFSparse(desc, sdfDesc, sdf, sdfDataSubgrids, sdfSubgridsStartSlots);
+			return createSDFSparse(desc, sdfDesc, sdf, sdfDataSubgrids, sdfSubgridsStartSlots, dispatcher);
 		}
 
 		MeshData mesh(desc);
@@ -366,9 +369,10 @@ namespace physx
 
 		if (sdfDesc.sdfBuilder == NULL) 
 		{			
-			Gu::SDFUsingWindingNumbers(verts, indices, numTriangleIndices, dx, dy, dz, &sdf[0], meshLower,
+			if (!Gu::SDFUsingWindingNumbers(verts, indices, numTriangleIndices, dx, dy, dz, &sdf[0], meshLower,
 				meshLower + PxVec3(static_cast<PxReal>(dx), static_cast<PxReal>(dy), static_cast<PxReal>(dz)) * spacing, NULL, true,
-				sdfDesc.numThreadsForSdfConstruction, sdfDesc.sdfBuilder);
+				sdfDesc.numThreadsForSdfConstruction, sdfDesc.sdfBuilder, dispatcher, sdfDesc.progressCallback))
+				return false; // cancelled by the progress callback
 		}
 		else
 		{
@@ -395,14 +399,14 @@ namespace physx
 		return true;
 	}
 
-	bool buildSDF(PxTriangleMeshDesc& desc, PxArray<PxReal>& sdf, PxArray<PxU8>& sdfDataSubgrids, PxArray<PxU32>& sdfSubgridsStartSlots)
+	bool buildSDF(PxTriangleMeshDesc& desc, PxArray<PxReal>& sdf, PxArray<PxU8>& sdfDataSubgrids, PxArray<PxU32>& sdfSubgridsStartSlots, PxCpuDispatcher* dispatcher)
 	{
 		PxSDFDesc& sdfDesc = *desc.sdfDesc;
 
 		if (!sdfDesc.sdf.data && sdfDesc.spacing > 0.f)
 		{
 			// Calculate signed distance field here if no sdf data provided.
-			if (!createSDF(desc, sdfDesc, sdf, sdfDataSubgrids, sdfSubgridsStartSlots))
+			if (!createSDF(desc, sdfDesc, sdf, sdfDataSubgrids, sdfSubgridsStartSlots, dispatcher))
 				return false;
 
 			sdfDesc.sdf.stride = sizeof(PxReal);
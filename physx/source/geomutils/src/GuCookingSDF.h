@@ -35,8 +35,10 @@
 namespace physx
 {
 	class PxTriangleMeshDesc;
+	class PxCpuDispatcher;
 
-	PX_PHYSX_COMMON_API bool buildSDF(PxTriangleMeshDesc& desc, PxArray<PxReal>& sdf, PxArray<PxU8>& sdfDataSubgrids, PxArray<PxU32>& sdfSubgridsStartSlots);
+	PX_PHYSX_COMMON_API bool buildSDF(PxTriangleMeshDesc& desc, PxArray<PxReal>& sdf, PxArray<PxU8>& sdfDataSubgrids, PxArray<PxU32>& sdfSubgridsStartSlots,
+		PxCpuDispatcher* dispatcher = NULL);
 }
 
 #endif
@@ -0,0 +1,470 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2024 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "geometry/PxMappedGeometryData.h"
+#include "geometry/PxGeometryInternal.h"
+#include "foundation/PxIO.h"
+#include "foundation/PxPhysicsVersion.h"
+#include "foundation/PxMemory.h"
+#include "CmUtils.h"
+#include "GuTriangleMeshBV4.h"
+#include "GuHeightField.h"
+
+using namespace physx;
+using namespace Gu;
+
+// PT: mapped blobs are a raw dump of the runtime arrays, each array starting on a 16-byte boundary. Objects created from
+// them reference the blob directly, so "loading" is just a header validation. There is no endian conversion: the SDK
+// version and the magic number (which reads differently on a platform with a different endianness) must both match.
+
+#define MAPPED_DATA_VERSION	1
+
+static PX_FORCE_INLINE PxU32 makeMagic(char a, char b, char c, char d)
+{
+	return PxU32(a) | (PxU32(b)<<8) | (PxU32(c)<<16) | (PxU32(d)<<24);
+}
+
+static PX_FORCE_INLINE PxU32 alignMapped(PxU32 size)
+{
+	return (size + PX_MAPPED_GEOMETRY_DATA_ALIGNMENT - 1) & ~(PX_MAPPED_GEOMETRY_DATA_ALIGNMENT - 1);
+}
+
+namespace
+{
+	struct MappedHeader
+	{
+		PxU32	mMagic;
+		PxU32	mVersion;
+		PxU32	mSDKVersion;
+		PxU32	mSize;
+	};
+
+	struct MappedTriangleMeshHeader : MappedHeader
+	{
+		PxU32	mNbVertices;
+		PxU32	mNbTriangles;
+		PxU32	mNbNodes;
+		PxU32	mNodeSize;
+		// 32
+		PxU32	mInitData;
+		PxU32	mMeshFlags;
+		PxU32	mQuantized;
+		PxReal	mGeomEpsilon;
+		// 48
+		PxVec3	mAABBCenter;
+		PxVec3	mAABBExtents;
+		PxVec3	mCenterOrMinCoeff;
+		PxVec3	mExtentsOrMaxCoeff;
+		// 96
+		PxMat33	mInertia;
+		PxVec3	mLocalCenterOfMass;
+		PxReal	mMass;
+		// 148
+		PxU32	mVerticesOffset;
+		PxU32	mTrianglesOffset;
+		PxU32	mExtraTrigDataOffset;
+		PxU32	mMaterialIndicesOffset;
+		PxU32	mFaceRemapOffset;
+		PxU32	mAdjacenciesOffset;
+		PxU32	mNodesOffset;
+	};
+	PX_COMPILE_TIME_ASSERT(!(sizeof(MappedTriangleMeshHeader) & (PX_MAPPED_GEOMETRY_DATA_ALIGNMENT-1)));
+
+	struct MappedHeightFieldHeader : MappedHeader
+	{
+		PxVec3	mAABBCenter;
+		PxVec3	mAABBExtents;
+		PxU32	mRows;
+		PxU32	mColumns;
+		PxU32	mRowLimit;
+		PxU32	mColLimit;
+		PxU32	mNbColumns;
+		PxReal	mConvexEdgeThreshold;
+		PxU32	mFlags;
+		PxU32	mFormat;
+		PxU32	mSampleStride;
+		PxU32	mNbSamples;
+		PxReal	mMinHeight;
+		PxReal	mMaxHeight;
+		PxU32	mSamplesOffset;
+		PxU32	mPadding;
+	};
+	PX_COMPILE_TIME_ASSERT(!(sizeof(MappedHeightFieldHeader) & (PX_MAPPED_GEOMETRY_DATA_ALIGNMENT-1)));
+
+	// PT: tracks the write position and inserts the padding needed to keep each array aligned
+	class MappedWriter
+	{
+		public:
+			MappedWriter(PxOutputStream& stream) : mStream(stream), mOffset(0)	{}
+
+			void	write(const void* data, PxU32 size)
+			{
+				if(size)
+					mStream.write(data, size);
+				mOffset += size;
+			}
+
+			void	align()
+			{
+				const PxU8 zeros[PX_MAPPED_GEOMETRY_DATA_ALIGNMENT] = {0};
+				write(zeros, alignMapped(mOffset) - mOffset);
+			}
+
+			PxOutputStream&	mStream;
+			PxU32			mOffset;
+	};
+
+	// PT: computes the blob layout. An offset of 0 means the array is not present.
+	class MappedLayout
+	{
+		public:
+			MappedLayout(PxU32 headerSize) : mSize(headerSize)	{}
+
+			PxU32	add(const void* data, PxU32 size)
+			{
+				if(!data || !size)
+					return 0;
+				const PxU32 offset = alignMapped(mSize);
+				mSize = offset + size;
+				return offset;
+			}
+
+			PxU32	getSize()	const	{ return alignMapped(mSize);	}
+		private:
+			PxU32	mSize;
+	};
+
+	class MappedBV4TriangleMesh : public BV4TriangleMesh
+	{
+		public:
+			MappedBV4TriangleMesh(const PxTriangleMeshInternalData& data, const MappedTriangleMeshHeader& header, const PxU8* base) : BV4TriangleMesh(data)
+			{
+				// PT: we don't own the arrays (so no eOWNS_MEMORY) but the object itself can be released
+				setBaseFlag(PxBaseFlag::eIS_RELEASABLE, true);
+
+				if(header.mExtraTrigDataOffset)
+					mExtraTrigData = const_cast<PxU8*>(base + header.mExtraTrigDataOffset);
+				if(header.mMaterialIndicesOffset)
+					mMaterialIndices = const_cast<PxU16*>(reinterpret_cast<const PxU16*>(base + header.mMaterialIndicesOffset));
+				if(header.mAdjacenciesOffset)
+					mAdjacencies = const_cast<PxU32*>(reinterpret_cast<const PxU32*>(base + header.mAdjacenciesOffset));
+
+				mMass				= header.mMass;
+				mInertia			= header.mInertia;
+				mLocalCenterOfMass	= header.mLocalCenterOfMass;
+			}
+
+			// PT: the blob can be in read-only memory, so modifications are not allowed
+			virtual	PxVec3*		getVerticesForModification()	PX_OVERRIDE	{ return TriangleMesh::getVerticesForModification();	}
+			virtual	PxBounds3	refitBVH()						PX_OVERRIDE	{ return TriangleMesh::refitBVH();						}
+
+			// PT: no mesh factory and no eOWNS_MEMORY, so we must free the object ourselves
+			virtual	void		onRefCountZero()				PX_OVERRIDE	{ PX_DELETE_THIS;										}
+	};
+
+	class MappedHeightField : public HeightField
+	{
+		public:
+			MappedHeightField(const MappedHeightFieldHeader& header, const PxU8* base) : HeightField(NULL)
+			{
+				setBaseFlag(PxBaseFlag::eOWNS_MEMORY, false);
+
+				mData.mAABB.mCenter			= header.mAABBCenter;
+				mData.mAABB.mExtents		= header.mAABBExtents;
+				mData.rows					= header.mRows;
+				mData.columns				= header.mColumns;
+				mData.rowLimit				= header.mRowLimit;
+				mData.colLimit				= header.mColLimit;
+				mData.nbColumns				= header.mNbColumns;
+				mData.samples				= const_cast<PxHeightFieldSample*>(reinterpret_cast<const PxHeightFieldSample*>(base + header.mSamplesOffset));
+				mData.convexEdgeThreshold	= header.mConvexEdgeThreshold;
+				mData.flags					= PxHeightFieldFlags(PxU16(header.mFlags));
+				mData.format				= PxHeightFieldFormat::Enum(header.mFormat);
+				mSampleStride				= header.mSampleStride;
+				mNbSamples					= header.mNbSamples;
+				mMinHeight					= header.mMinHeight;
+				mMaxHeight					= header.mMaxHeight;
+			}
+
+			virtual	bool	modifySamples(PxI32, PxI32, const PxHeightFieldDesc&, bool)	PX_OVERRIDE
+			{
+				return PxGetFoundation().error(PxErrorCode::eINVALID_OPERATION, PX_FL, "PxHeightField::modifySamples() is not supported for mapped height fields.");
+			}
+
+			virtual	void	onRefCountZero()	PX_OVERRIDE	{ PX_DELETE_THIS;	}
+	};
+}
+
+static void initMappedHeader(MappedHeader& header, char d, PxU32 size)
+{
+	header.mMagic		= makeMagic('P', 'X', 'M', d);
+	header.mVersion		= MAPPED_DATA_VERSION;
+	header.mSDKVersion	= PX_PHYSICS_VERSION;
+	header.mSize		= size;
+}
+
+static bool checkMappedHeader(const void* address, PxU32 size, PxU32 headerSize, char d, const char* funcName)
+{
+	if(!address || (size_t(address) & (PX_MAPPED_GEOMETRY_DATA_ALIGNMENT-1)))
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "%s: data must be 16-byte aligned.", funcName);
+
+	if(size<headerSize)
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "%s: invalid data size.", funcName);
+
+	const MappedHeader* header = reinterpret_cast<const MappedHeader*>(address);
+	if(header->mMagic != makeMagic('P', 'X', 'M', d))
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "%s: invalid or incompatible data (wrong type or platform).", funcName);
+
+	if(header->mVersion != MAPPED_DATA_VERSION || header->mSDKVersion != PX_PHYSICS_VERSION)
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "%s: data has been created with a different SDK version.", funcName);
+
+	if(header->mSize > size)
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "%s: truncated data.", funcName);
+
+	return true;
+}
+
+// PT: validates an array, which can be missing if not required
+static PX_FORCE_INLINE bool checkMappedArray(PxU32 offset, PxU64 size, PxU32 blobSize, bool required)
+{
+	if(!offset)
+		return !required;
+	return !(offset & (PX_MAPPED_GEOMETRY_DATA_ALIGNMENT-1)) && PxU64(offset) + size <= PxU64(blobSize);
+}
+
+bool physx::PxSaveMappedTriangleMesh(const PxTriangleMesh& mesh, PxOutputStream& stream)
+{
+	if(mesh.getConcreteType() != PxConcreteType::eTRIANGLE_MESH_BVH34)
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxSaveMappedTriangleMesh: only BVH34 meshes are supported.");
+
+	const BV4TriangleMesh& bv4Mesh = static_cast<const BV4TriangleMesh&>(mesh);
+
+	if(bv4Mesh.getSdfDataFast().mSdf || bv4Mesh.mGRB_triIndices)
+		PxGetFoundation().error(PxErrorCode::eDEBUG_WARNING, PX_FL, "PxSaveMappedTriangleMesh: SDF and GPU data are not saved in mapped blobs.");
+
+	PxTriangleMeshInternalData data;
+	bv4Mesh.getInternalData(data, false);
+
+	const PxU32 nbTris = data.mNbTriangles;
+
+	MappedTriangleMeshHeader header;
+	PxMemZero(&header, sizeof(MappedTriangleMeshHeader));
+	header.mNbVertices			= data.mNbVertices;
+	header.mNbTriangles			= nbTris;
+	header.mNbNodes				= data.mNbNodes;
+	header.mNodeSize			= data.mNodeSize;
+	header.mInitData			= data.mInitData;
+	header.mMeshFlags			= data.mFlags;
+	header.mQuantized			= data.mQuantized;
+	header.mGeomEpsilon			= data.mGeomEpsilon;
+	header.mAABBCenter			= data.mAABB_Center;
+	header.mAABBExtents			= data.mAABB_Extents;
+	header.mCenterOrMinCoeff	= data.mCenterOrMinCoeff;
+	header.mExtentsOrMaxCoeff	= data.mExtentsOrMaxCoeff;
+	bv4Mesh.getMassInformation(header.mMass, header.mInertia, header.mLocalCenterOfMass);
+
+	// PT: one extra vertex is reserved so that it is safe to V4Load the last one, as for regular meshes
+	const PxU32 verticesSize = data.getSizeofVerticesInBytes() + sizeof(PxVec3);
+
+	const PxU8* extraTrigData = bv4Mesh.getExtraTrigData();
+	const PxU16* materials = bv4Mesh.getMaterials();
+	const PxU32* adjacencies = bv4Mesh.getAdjacencies();
+
+	MappedLayout layout(sizeof(MappedTriangleMeshHeader));
+	header.mVerticesOffset			= layout.add(data.mVertices, verticesSize);
+	header.mTrianglesOffset			= layout.add(data.mTriangles, data.getSizeofTrianglesInBytes());
+	header.mExtraTrigDataOffset		= layout.add(extraTrigData, nbTris * sizeof(PxU8));
+	header.mMaterialIndicesOffset	= layout.add(materials, nbTris * sizeof(PxU16));
+	header.mFaceRemapOffset			= layout.add(data.mFaceRemap, data.getSizeofFaceRemapInBytes());
+	header.mAdjacenciesOffset		= layout.add(adjacencies, nbTris * 3 * sizeof(PxU32));
+	header.mNodesOffset				= layout.add(data.mNodes, data.getSizeofNodesInBytes());
+	initMappedHeader(header, 'M', layout.getSize());
+
+	MappedWriter writer(stream);
+	writer.write(&header, sizeof(MappedTriangleMeshHeader));
+
+	if(header.mVerticesOffset)
+	{
+		writer.align();
+		writer.write(data.mVertices, data.getSizeofVerticesInBytes());
+		const PxVec3 padding(0.0f);
+		writer.write(&padding, sizeof(PxVec3));
+	}
+	if(header.mTrianglesOffset)
+	{
+		writer.align();
+		writer.write(data.mTriangles, data.getSizeofTrianglesInBytes());
+	}
+	if(header.mExtraTrigDataOffset)
+	{
+		writer.align();
+		writer.write(extraTrigData, nbTris * sizeof(PxU8));
+	}
+	if(header.mMaterialIndicesOffset)
+	{
+		writer.align();
+		writer.write(materials, nbTris * sizeof(PxU16));
+	}
+	if(header.mFaceRemapOffset)
+	{
+		writer.align();
+		writer.write(data.mFaceRemap, data.getSizeofFaceRemapInBytes());
+	}
+	if(header.mAdjacenciesOffset)
+	{
+		writer.align();
+		writer.write(adjacencies, nbTris * 3 * sizeof(PxU32));
+	}
+	if(header.mNodesOffset)
+	{
+		writer.align();
+		writer.write(data.mNodes, data.getSizeofNodesInBytes());
+	}
+	writer.align();
+	PX_ASSERT(writer.mOffset == header.mSize);
+	return true;
+}
+
+PxTriangleMesh* physx::PxCreateMappedTriangleMesh(const void* address, PxU32 size)
+{
+	if(!checkMappedHeader(address, size, sizeof(MappedTriangleMeshHeader), 'M', "PxCreateMappedTriangleMesh"))
+		return NULL;
+
+	const PxU8* base = reinterpret_cast<const PxU8*>(address);
+	const MappedTriangleMeshHeader& header = *reinterpret_cast<const MappedTriangleMeshHeader*>(address);
+
+	const PxU64 nbTris = header.mNbTriangles;
+	const PxU64 indexSize = (header.mMeshFlags & PxTriangleMeshFlag::e16_BIT_INDICES) ? sizeof(PxU16) : sizeof(PxU32);
+	const PxU32 blobSize = header.mSize;
+	// PT: the node size is implied by the quantization, the BV4 code does not use the stored one
+	const PxU32 expectedNodeSize = header.mQuantized ? sizeof(BVDataPackedQ) : sizeof(BVDataPackedNQ);
+	const bool valid =	header.mNbVertices && nbTris
+					&&	header.mQuantized<=1 && header.mNodeSize==expectedNodeSize
+					&&	checkMappedArray(header.mVerticesOffset, (PxU64(header.mNbVertices) + 1) * sizeof(PxVec3), blobSize, true)
+					&&	checkMappedArray(header.mTrianglesOffset, nbTris * 3 * indexSize, blobSize, true)
+					&&	checkMappedArray(header.mExtraTrigDataOffset, nbTris * sizeof(PxU8), blobSize, false)
+					&&	checkMappedArray(header.mMaterialIndicesOffset, nbTris * sizeof(PxU16), blobSize, false)
+					&&	checkMappedArray(header.mFaceRemapOffset, nbTris * sizeof(PxU32), blobSize, false)
+					&&	checkMappedArray(header.mAdjacenciesOffset, nbTris * 3 * sizeof(PxU32), blobSize, false)
+					&&	checkMappedArray(header.mNodesOffset, PxU64(header.mNbNodes) * header.mNodeSize, blobSize, true);
+	if(!valid)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxCreateMappedTriangleMesh: corrupted data.");
+		return NULL;
+	}
+
+	PxTriangleMeshInternalData data;
+	data.mNbVertices		= header.mNbVertices;
+	data.mNbTriangles		= header.mNbTriangles;
+	data.mVertices			= const_cast<PxVec3*>(reinterpret_cast<const PxVec3*>(base + header.mVerticesOffset));
+	data.mTriangles			= const_cast<PxU8*>(base + header.mTrianglesOffset);
+	data.mFaceRemap			= header.mFaceRemapOffset ? const_cast<PxU32*>(reinterpret_cast<const PxU32*>(base + header.mFaceRemapOffset)) : NULL;
+	data.mAABB_Center		= header.mAABBCenter;
+	data.mAABB_Extents		= header.mAABBExtents;
+	data.mGeomEpsilon		= header.mGeomEpsilon;
+	data.mFlags				= PxU8(header.mMeshFlags);
+	data.mNbNodes			= header.mNbNodes;
+	data.mNodeSize			= header.mNodeSize;
+	data.mNodes				= const_cast<PxU8*>(base + header.mNodesOffset);
+	data.mInitData			= header.mInitData;
+	data.mCenterOrMinCoeff	= header.mCenterOrMinCoeff;
+	data.mExtentsOrMaxCoeff	= header.mExtentsOrMaxCoeff;
+	data.mQuantized			= header.mQuantized!=0;
+
+	MappedBV4TriangleMesh* mesh;
+	PX_NEW_SERIALIZED(mesh, MappedBV4TriangleMesh)(data, header, base);
+	return mesh;
+}
+
+bool physx::PxSaveMappedHeightField(const PxHeightField& heightField, PxOutputStream& stream)
+{
+	const HeightField& hf = static_cast<const HeightField&>(heightField);
+	const HeightFieldData& data = hf.getData();
+
+	const PxU32 samplesSize = data.rows * data.columns * sizeof(PxHeightFieldSample);
+
+	MappedHeightFieldHeader header;
+	PxMemZero(&header, sizeof(MappedHeightFieldHeader));
+	header.mAABBCenter			= data.mAABB.mCenter;
+	header.mAABBExtents			= data.mAABB.mExtents;
+	header.mRows				= data.rows;
+	header.mColumns				= data.columns;
+	header.mRowLimit			= data.rowLimit;
+	header.mColLimit			= data.colLimit;
+	header.mNbColumns			= data.nbColumns;
+	header.mConvexEdgeThreshold	= data.convexEdgeThreshold;
+	header.mFlags				= PxU32(PxU16(data.flags));
+	header.mFormat				= PxU32(data.format);
+	header.mSampleStride		= hf.mSampleStride;
+	header.mNbSamples			= hf.mNbSamples;
+	header.mMinHeight			= hf.getMinHeight();
+	header.mMaxHeight			= hf.getMaxHeight();
+
+	MappedLayout layout(sizeof(MappedHeightFieldHeader));
+	header.mSamplesOffset = layout.add(data.samples, samplesSize);
+	initMappedHeader(header, 'H', layout.getSize());
+
+	MappedWriter writer(stream);
+	writer.write(&header, sizeof(MappedHeightFieldHeader));
+	if(header.mSamplesOffset)
+	{
+		writer.align();
+		writer.write(data.samples, samplesSize);
+	}
+	writer.align();
+	PX_ASSERT(writer.mOffset == header.mSize);
+	return true;
+}
+
+PxHeightField* physx::PxCreateMappedHeightField(const void* address, PxU32 size)
+{
+	if(!checkMappedHeader(address, size, sizeof(MappedHeightFieldHeader), 'H', "PxCreateMappedHeightField"))
+		return NULL;
+
+	const MappedHeightFieldHeader& header = *reinterpret_cast<const MappedHeightFieldHeader*>(address);
+
+	// PT: the height field code indexes samples with 32-bit values and derives the limits from the
+	// dimensions, so every field must match what HeightField::loadFromDesc would have produced.
+	const PxU64 nbSamples = PxU64(header.mRows) * header.mColumns;
+	const bool valid =	header.mRows>1 && header.mColumns>1 && nbSamples<=PxU64(0xffffffff)
+					&&	header.mRowLimit==header.mRows-2 && header.mColLimit==header.mColumns-2
+					&&	header.mNbColumns==header.mColumns
+					&&	header.mFormat==PxU32(PxHeightFieldFormat::eS16_TM)
+					&&	header.mNbSamples==nbSamples
+					&&	header.mSampleStride>=sizeof(PxHeightFieldSample)
+					&&	checkMappedArray(header.mSamplesOffset, nbSamples * sizeof(PxHeightFieldSample), header.mSize, true);
+	if(!valid)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxCreateMappedHeightField: corrupted data.");
+		return NULL;
+	}
+
+	MappedHeightField* hf;
+	PX_NEW_SERIALIZED(hf, MappedHeightField)(header, reinterpret_cast<const PxU8*>(address));
+	return hf;
+}
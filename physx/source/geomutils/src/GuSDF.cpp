@@ -42,6 +42,10 @@
 
 #include "foundation/PxAtomic.h"
 #include "foundation/PxThread.h"
+#include "foundation/PxMutex.h"
+#include "foundation/PxMemory.h"
+#include "CmParallelFor.h"
+#include "cooking/PxSDFDesc.h"
 #include "common/GuMeshAnalysis.h"
 #include "GuMeshAnalysis.h"
 
@@ -426,6 +430,55 @@ namespace Gu
 		Range(PxI32 start, PxI32 end, bool insideStart, bool insideEnd) : mStart(start), mEnd(end), mInsideStart(insideStart), mInsideEnd(insideEnd) { }
 	};	
 
+	//Thread-safe progress accounting and cancellation for the CPU SDF construction. Work is counted in abstract units (grid rows, samples...)
+	//and every phase maps its own progress to a sub-range of [0, 1] so that the reported value never decreases.
+	class SDFProgress
+	{
+	public:
+		SDFProgress(PxSDFProgressCallback* callback) : mCallback(callback), mCancelled(0), mDone(0), mTotal(1), mPhaseStart(0.0f), mPhaseLength(1.0f), mLastReported(-1.0f)
+		{
+		}
+
+		void beginPhase(PxU32 total, PxReal phaseStart, PxReal phaseLength)
+		{
+			mDone = 0;
+			mTotal = PxMax(total, 1u);
+			mPhaseStart = phaseStart;
+			mPhaseLength = phaseLength;
+		}
+
+		PX_FORCE_INLINE bool isCancelled() const
+		{
+			return mCancelled != 0;
+		}
+
+		void advance(PxU32 nbDone)
+		{
+			const PxI32 done = PxAtomicAdd(&mDone, PxI32(nbDone));
+			if (!mCallback)
+				return;
+
+			const PxReal fraction = mPhaseStart + mPhaseLength * PxMin(1.0f, PxReal(done) / PxReal(mTotal));
+
+			PxMutex::ScopedLock lock(mMutex);
+			if (mCancelled || fraction <= mLastReported)
+				return;
+			mLastReported = fraction;
+			if (!mCallback->onProgress(fraction))
+				mCancelled = 1;
+		}
+
+	private:
+		PxSDFProgressCallback* mCallback;
+		PxMutex mMutex;
+		volatile PxI32 mCancelled;
+		volatile PxI32 mDone;
+		PxU32 mTotal;
+		PxReal mPhaseStart;
+		PxReal mPhaseLength;
+		PxReal mLastReported;
+	};
+
 	struct SDFCalculationData
 	{
 		const PxVec3* vertices;
@@ -446,6 +499,8 @@ namespace Gu
 
 		bool optimizeInsideOutsideCalculation; //Toggle to enable an additional optimization for faster inside/outside classification
 		bool signOnly;
+
+		SDFProgress* progressReporter = NULL;
 	};
 
 	void windingNumbersInsideCheck(const PxVec3* vertices, const PxU32* indices, PxU32 numTriangleIndices, PxU32 width, PxU32 height, PxU32 depth,
@@ -547,170 +602,210 @@ namespace Gu
 		yi = id / sizeX;
 	}
 
-	void* computeSDFThreadJob(void* data)
+	//Returns the distance from queryPoint to the closest point on the mesh. lastTriangle is used to warm-start the
+	//query and is updated with the closest triangle found.
+	static PxReal computeClosestDistance(const SDFCalculationData& d, const PxVec3& queryPoint, PxI32& lastTriangle)
 	{
-		SDFCalculationData& d = *reinterpret_cast<SDFCalculationData*>(data);
+		ClosestDistanceToTrimeshTraversalController cd(d.indices, d.vertices, d.tree->begin());
+		cd.setQueryPoint(queryPoint);
 
-		PxI32 lastTriangle = -1;
+		if (lastTriangle != -1)
+		{
+			//Warm-start the query with a lower-bound distance based on the triangle found by the previous query.
+			//This helps to cull the tree traversal more effectively in the closest point query.
+			PxU32 i0 = d.indices[3 * lastTriangle];
+			PxU32 i1 = d.indices[3 * lastTriangle + 1];
+			PxU32 i2 = d.indices[3 * lastTriangle + 2];
 
-		PxArray<Range> stack;
-		LineSegmentTrimeshIntersectionTraversalController intersector(d.indices, d.vertices, PxVec3(0.0f), PxVec3(0.0f));
+			//const PxVec3 closest = Gu::closestPtPointTriangle2UnitBox(queryPoint, d.vertices[i0], d.vertices[i1], d.vertices[i2]);
+			//PxReal d2 = (closest - queryPoint).magnitudeSquared();
 
-		PxI32 start = physx::PxAtomicAdd(d.progress, d.batchSize) - d.batchSize;
-		while (start < d.end)
+			aos::FloatV t1, t2;
+			aos::Vec3V q = aos::V3LoadU(queryPoint);
+			aos::Vec3V a = aos::V3LoadU(d.vertices[i0]);
+			aos::Vec3V b = aos::V3LoadU(d.vertices[i1]);
+			aos::Vec3V c = aos::V3LoadU(d.vertices[i2]);
+			aos::Vec3V cp;
+			aos::FloatV dist2 = Gu::distancePointTriangleSquared2UnitBox(q, a, b, c, t1, t2, cp);
+			PxReal d2;
+			aos::FStore(dist2, &d2);
+			PxVec3 closest;
+			aos::V3StoreU(cp, closest);							
+
+			cd.setClosestStart(d2, lastTriangle, closest);
+		}
+
+		Gu::traverseBVH(d.tree->begin(), cd);
+		PxVec3 closestPoint = cd.getClosestPoint();
+
+		lastTriangle = cd.getClosestTriId();
+
+		return (closestPoint - queryPoint).magnitude();
+	}
+
+	//Computes the sdf values of the grid rows [start, end). Rows are indexed as z * height + y.
+	static void computeSDFBatch(SDFCalculationData& d, PxI32 start, PxI32 end, PxArray<Range>& stack, LineSegmentTrimeshIntersectionTraversalController& intersector, PxI32& lastTriangle)
+	{
+		PxU32 yStart, zStart;
+		idToXY(start, d.height, yStart, zStart);
+		for (PxI32 id = start; id < end; ++id)
 		{
-			PxI32 end = PxMin(d.end, start + d.batchSize);
+			PxU32 y, z;
+			idToXY(id, d.height, y, z);
+			if (y < yStart)
+				yStart = 0;
 
-			PxU32 yStart, zStart;
-			idToXY(start, d.height, yStart, zStart);
-			for (PxI32 id = start; id < end; ++id)
+			if (d.optimizeInsideOutsideCalculation)
 			{
-				PxU32 y, z;
-				idToXY(id, d.height, y, z);
-				if (y < yStart)
-					yStart = 0;
-
-				if (d.optimizeInsideOutsideCalculation)
+				stack.pushBack(Range(0, d.width + 2, false, false));
+				while (stack.size() > 0)
 				{
-					stack.pushBack(Range(0, d.width + 2, false, false));
-					while (stack.size() > 0)
-					{
-						Range r = stack.popBack();
+					Range r = stack.popBack();
 
-						PxI32 center = (r.mStart + r.mEnd) / 2;
-						if (center == r.mStart)
+					PxI32 center = (r.mStart + r.mEnd) / 2;
+					if (center == r.mStart)
+					{
+						if (r.mStart > 0 && r.mStart <= PxI32(d.width))
 						{
-							if (r.mStart > 0 && r.mStart <= PxI32(d.width))
-							{
-								if (r.mInsideStart)
-									d.sdf[z * d.width * d.height + y * d.width + (r.mStart - 1)] *= -1.0f;
-							}
-							continue;
+							if (r.mInsideStart)
+								d.sdf[z * d.width * d.height + y * d.width + (r.mStart - 1)] *= -1.0f;
 						}
+						continue;
+					}
 
-						PxVec3 queryPoint = d.pointSampler->getPoint(center - 1, y, z); 
+					PxVec3 queryPoint = d.pointSampler->getPoint(center - 1, y, z); 
 
 
-						bool inside = false;
-						bool computeWinding = true;
-						if (id > start && y > yStart)
+					bool inside = false;
+					bool computeWinding = true;
+					if (id > start && y > yStart)
+					{
+						PxReal s = d.sdf[z * d.width * d.height + (y - 1) * d.width + (center - 1)];
+						if (PxAbs(s) > d.pointSampler->getActiveCellSize().y)
 						{
-							PxReal s = d.sdf[z * d.width * d.height + (y - 1) * d.width + (center - 1)];
-							if (PxAbs(s) > d.pointSampler->getActiveCellSize().y)
-							{
-								inside = s < 0.0f;
-								computeWinding = false;
-							}
+							inside = s < 0.0f;
+							computeWinding = false;
 						}
+					}
 
-						if (computeWinding)
-							inside = Gu::computeWindingNumber(d.tree->begin(), queryPoint, *d.clusters, d.indices, d.vertices) > 0.5f;
+					if (computeWinding)
+						inside = Gu::computeWindingNumber(d.tree->begin(), queryPoint, *d.clusters, d.indices, d.vertices) > 0.5f;
 
 
-						if (inside != r.mInsideStart)
-							stack.pushBack(Range(r.mStart, center, r.mInsideStart, inside));
-						else
+					if (inside != r.mInsideStart)
+						stack.pushBack(Range(r.mStart, center, r.mInsideStart, inside));
+					else
+					{
+						PxVec3 p = d.pointSampler->getPoint(r.mStart - 1, y, z);
+						intersector.reset(p, queryPoint);
+						Gu::traverseBVH(d.tree->begin(), intersector);
+						if (!intersector.intersectionDetected())
 						{
-							PxVec3 p = d.pointSampler->getPoint(r.mStart - 1, y, z);
-							intersector.reset(p, queryPoint);
-							Gu::traverseBVH(d.tree->begin(), intersector);
-							if (!intersector.intersectionDetected())
+							PxI32 e = PxMin(center, PxI32(d.width) + 1);
+							for (PxI32 x = PxMax(1, r.mStart); x < e; ++x)
 							{
-								PxI32 e = PxMin(center, PxI32(d.width) + 1);
-								for (PxI32 x = PxMax(1, r.mStart); x < e; ++x)
-								{
-									if (inside)
-										d.sdf[z * d.width * d.height + y * d.width + (x - 1)] *= -1.0f;
-								}
+								if (inside)
+									d.sdf[z * d.width * d.height + y * d.width + (x - 1)] *= -1.0f;
 							}
-							else
-								stack.pushBack(Range(r.mStart, center, r.mInsideStart, inside));
 						}
+						else
+							stack.pushBack(Range(r.mStart, center, r.mInsideStart, inside));
+					}
 
 
-						if (inside != r.mInsideEnd)
-							stack.pushBack(Range(center, r.mEnd, inside, r.mInsideEnd));
-						else
+					if (inside != r.mInsideEnd)
+						stack.pushBack(Range(center, r.mEnd, inside, r.mInsideEnd));
+					else
+					{
+						PxVec3 p = d.pointSampler->getPoint(r.mEnd - 1, y, z); 
+						intersector.reset(queryPoint, p);
+						Gu::traverseBVH(d.tree->begin(), intersector);
+						if (!intersector.intersectionDetected())
 						{
-							PxVec3 p = d.pointSampler->getPoint(r.mEnd - 1, y, z); 
-							intersector.reset(queryPoint, p);
-							Gu::traverseBVH(d.tree->begin(), intersector);
-							if (!intersector.intersectionDetected())
+							PxI32 e = PxMin(r.mEnd, PxI32(d.width) + 1);
+							for (PxI32 x = PxMax(1, center); x < e; ++x)
 							{
-								PxI32 e = PxMin(r.mEnd, PxI32(d.width) + 1);
-								for (PxI32 x = PxMax(1, center); x < e; ++x)
-								{
-									if (inside)
-										d.sdf[z * d.width * d.height + y * d.width + (x - 1)] *= -1.0f;
-								}
+								if (inside)
+									d.sdf[z * d.width * d.height + y * d.width + (x - 1)] *= -1.0f;
 							}
-							else
-								stack.pushBack(Range(center, r.mEnd, inside, r.mInsideEnd));
 						}
+						else
+							stack.pushBack(Range(center, r.mEnd, inside, r.mInsideEnd));
 					}
 				}
+			}
 
-				if (!d.signOnly)
+			if (!d.signOnly)
+			{
+				for (PxU32 x = 0; x < d.width; ++x)
 				{
-					for (PxU32 x = 0; x < d.width; ++x)
+					const PxU32 index = z * d.width * d.height + y * d.width + x;
+
+					PxVec3 queryPoint = d.pointSampler->getPoint(x, y, z);
+
+					const PxReal closestDistance = computeClosestDistance(d, queryPoint, lastTriangle);
+
+					PxReal sign = 1.f;
+					if (!d.optimizeInsideOutsideCalculation)
 					{
-						const PxU32 index = z * d.width * d.height + y * d.width + x;
+						PxReal windingNumber = Gu::computeWindingNumber(d.tree->begin(), queryPoint, *d.clusters, d.indices, d.vertices);
+						sign = windingNumber > 0.5f ? -1.f : 1.f;
+					}
 
-						PxVec3 queryPoint = d.pointSampler->getPoint(x, y, z);
+					d.sdf[index] *= closestDistance * sign;
+					if (d.sampleLocations)
+						d.sampleLocations[index] = queryPoint;
+				}
+			}
+		}
+	}
 
-						ClosestDistanceToTrimeshTraversalController cd(d.indices, d.vertices, d.tree->begin());
-						cd.setQueryPoint(queryPoint);
+	void* computeSDFThreadJob(void* data)
+	{
+		SDFCalculationData& d = *reinterpret_cast<SDFCalculationData*>(data);
 
-						if (lastTriangle != -1)
-						{
-							//Warm-start the query with a lower-bound distance based on the triangle found by the previous query.
-							//This helps to cull the tree traversal more effectively in the closest point query.
-							PxU32 i0 = d.indices[3 * lastTriangle];
-							PxU32 i1 = d.indices[3 * lastTriangle + 1];
-							PxU32 i2 = d.indices[3 * lastTriangle + 2];
-
-							//const PxVec3 closest = Gu::closestPtPointTriangle2UnitBox(queryPoint, d.vertices[i0], d.vertices[i1], d.vertices[i2]);
-							//PxReal d2 = (closest - queryPoint).magnitudeSquared();
-
-							aos::FloatV t1, t2;
-							aos::Vec3V q = aos::V3LoadU(queryPoint);
-							aos::Vec3V a = aos::V3LoadU(d.vertices[i0]);
-							aos::Vec3V b = aos::V3LoadU(d.vertices[i1]);
-							aos::Vec3V c = aos::V3LoadU(d.vertices[i2]);
-							aos::Vec3V cp;
-							aos::FloatV dist2 = Gu::distancePointTriangleSquared2UnitBox(q, a, b, c, t1, t2, cp);
-							PxReal d2;
-							aos::FStore(dist2, &d2);
-							PxVec3 closest;
-							aos::V3StoreU(cp, closest);							
-
-							cd.setClosestStart(d2, lastTriangle, closest);
-						}
+		PxI32 lastTriangle = -1;
 
-						Gu::traverseBVH(d.tree->begin(), cd);
-						PxVec3 closestPoint = cd.getClosestPoint();
-						PxReal closestDistance = (closestPoint - queryPoint).magnitude();
+		PxArray<Range> stack;
+		LineSegmentTrimeshIntersectionTraversalController intersector(d.indices, d.vertices, PxVec3(0.0f), PxVec3(0.0f));
 
-						lastTriangle = cd.getClosestTriId();
+		PxI32 start = physx::PxAtomicAdd(d.progress, d.batchSize) - d.batchSize;
+		while (start < d.end)
+		{
+			if (d.progressReporter && d.progressReporter->isCancelled())
+				break;
 
-						PxReal sign = 1.f;
-						if (!d.optimizeInsideOutsideCalculation)
-						{
-							PxReal windingNumber = Gu::computeWindingNumber(d.tree->begin(), queryPoint, *d.clusters, d.indices, d.vertices);
-							sign = windingNumber > 0.5f ? -1.f : 1.f;
-						}
+			PxI32 end = PxMin(d.end, start + d.batchSize);
+
+			computeSDFBatch(d, start, end, stack, intersector, lastTriangle);
+
+			if (d.progressReporter)
+				d.progressReporter->advance(PxU32(end - start));
 
-						d.sdf[index] *= closestDistance * sign;
-						if (d.sampleLocations)
-							d.sampleLocations[index] = queryPoint;
-					}
-				}
-			}
 			start = physx::PxAtomicAdd(d.progress, d.batchSize) - d.batchSize;
 		}
 		return NULL;
 	}
 
+	//Same as computeSDFThreadJob but driven by parallelFor. The batches are the same as the ones used by the threads.
+	static void computeSDFParallelForJob(void* userData, PxU32 startIndex, PxU32 endIndex)
+	{
+		SDFCalculationData& d = *reinterpret_cast<SDFCalculationData*>(userData);
+		if (d.progressReporter && d.progressReporter->isCancelled())
+			return;
+
+		PxI32 lastTriangle = -1;
+
+		PxArray<Range> stack;
+		LineSegmentTrimeshIntersectionTraversalController intersector(d.indices, d.vertices, PxVec3(0.0f), PxVec3(0.0f));
+
+		computeSDFBatch(d, PxI32(startIndex), PxI32(endIndex), stack, intersector, lastTriangle);
+
+		if (d.progressReporter)
+			d.progressReporter->advance(endIndex - startIndex);
+	}
+
+
 
 	struct PxI32x3
 	{
@@ -940,11 +1035,12 @@ namespace Gu
 
 
 
-	void SDFUsingWindingNumbers(PxArray<Gu::BVHNode>& tree, PxHashMap<PxU32, Gu::ClusterApproximation>& clusters, const PxVec3* vertices, const PxU32* indices, PxU32 numTriangleIndices, PxU32 width, PxU32 height, PxU32 depth,
-		PxReal* sdf, GridQueryPointSampler& sampler, PxVec3* sampleLocations, PxU32 numThreads, bool isWatertight, bool allVerticesInsideSamplingBox)
+	static bool SDFUsingWindingNumbers(PxArray<Gu::BVHNode>& tree, PxHashMap<PxU32, Gu::ClusterApproximation>& clusters, const PxVec3* vertices, const PxU32* indices, PxU32 numTriangleIndices, PxU32 width, PxU32 height, PxU32 depth,
+		PxReal* sdf, GridQueryPointSampler& sampler, PxVec3* sampleLocations, PxU32 numThreads, bool isWatertight, bool allVerticesInsideSamplingBox,
+		PxCpuDispatcher* dispatcher, SDFProgress& progressReporter)
 	{
 		bool optimizeInsideOutsideCalculation = allVerticesInsideSamplingBox && isWatertight;
-		numThreads = PxMax(numThreads, 1u);
+		numThreads = dispatcher ? 1u : PxMax(numThreads, 1u);
 
 		PxI32 progress = 0;
 
@@ -978,20 +1074,32 @@ namespace Gu
 			d.end = depth * height;
 
 			d.signOnly = false;
+
+			d.progressReporter = &progressReporter;
 		}
 
 		PxU32 l = width * height * depth;
 		for (PxU32 i = 0; i < l; ++i)
 			sdf[i] = 1.0f;
 
-		for (PxU32 i = 0; i < numThreads; ++i)
+		progressReporter.beginPhase(depth * height, 0.0f, 1.0f);
+
+		if (dispatcher)
 		{
-			if (perThreadData.size() == 1)
-				computeSDFThreadJob(&perThreadData[i]);
-			else
+			//The dispatcher replaces the dedicated threads, rows are processed in the same batches
+			Cm::parallelFor(dispatcher, depth * height, PxU32(perThreadData[0].batchSize), computeSDFParallelForJob, &perThreadData[0]);
+		}
+		else
+		{
+			for (PxU32 i = 0; i < numThreads; ++i)
 			{
-				threads.pushBack(PX_NEW(PxThread)(computeSDFThreadJob, &perThreadData[i], "thread"));
-				threads[i]->start();
+				if (perThreadData.size() == 1)
+					computeSDFThreadJob(&perThreadData[i]);
+				else
+				{
+					threads.pushBack(PX_NEW(PxThread)(computeSDFThreadJob, &perThreadData[i], "thread"));
+					threads[i]->start();
+				}
 			}
 		}
 
@@ -1006,8 +1114,12 @@ namespace Gu
 			PX_FREE(threads[i]);
 		}
 
+		if (progressReporter.isCancelled())
+			return false;
+
 		if (!isWatertight)
 			fixSdfForNonClosedGeometry(width, height, depth, sdf, sampler.getActiveCellSize());
+		return true;
 	}
 	//Helper class to extract surface triangles from a tetmesh
 	struct SortedTriangle
@@ -1172,8 +1284,38 @@ namespace Gu
 		}
 	}
 
-	void SDFUsingWindingNumbers(const PxVec3* vertices, const PxU32* indicesOrig, PxU32 numTriangleIndices, PxU32 width, PxU32 height, PxU32 depth,
-		PxReal* sdf, PxVec3 minExtents, PxVec3 maxExtents, PxVec3* sampleLocations, bool cellCenteredSamples, PxU32 numThreads, PxSDFBuilder* sdfBuilder)
+	//Acceleration structures used by the CPU sdf builders: a BVH for the closest point and line segment queries, and
+	//the winding number cluster approximations for the inside/outside classification
+	struct SDFMeshData
+	{
+		PxArray<Gu::BVHNode> tree;
+		PxHashMap<PxU32, Gu::ClusterApproximation> clusters;
+		bool isWatertight;
+		bool allVerticesInsideBox;
+
+		SDFMeshData(const PxVec3* vertices, const PxU32* indices, PxU32 numTriangleIndices, const PxBounds3& box)
+		{
+			buildTree(indices, numTriangleIndices / 3, vertices, tree);
+
+			Gu::precomputeClusterInformation(tree.begin(), indices, numTriangleIndices / 3, vertices, clusters);
+
+			isWatertight = MeshAnalyzer::checkMeshWatertightness(reinterpret_cast<const Triangle*>(indices), numTriangleIndices / 3);
+			allVerticesInsideBox = true;
+			for (PxU32 i = 0; i < numTriangleIndices; ++i)
+			{
+				PxVec3 v = vertices[indices[i]];
+				if (!box.contains(v))
+				{
+					allVerticesInsideBox = false;
+					break;
+				}
+			}
+		}
+	};
+
+	bool SDFUsingWindingNumbers(const PxVec3* vertices, const PxU32* indicesOrig, PxU32 numTriangleIndices, PxU32 width, PxU32 height, PxU32 depth,
+		PxReal* sdf, PxVec3 minExtents, PxVec3 maxExtents, PxVec3* sampleLocations, bool cellCenteredSamples, PxU32 numThreads, PxSDFBuilder* sdfBuilder,
+		PxCpuDispatcher* dispatcher, PxSDFProgressCallback* progressCallback)
 	{
 		PxArray<PxU32> repairedIndices;
 		//Analyze the mesh to catch and fix some special cases
@@ -1196,30 +1338,15 @@ namespace Gu
 		}
 		else
 		{	
-			PxArray<Gu::BVHNode> tree;
-			buildTree(indices, numTriangleIndices / 3, vertices, tree);
-
-			PxHashMap<PxU32, Gu::ClusterApproximation> clusters;
-			Gu::precomputeClusterInformation(tree.begin(), indices, numTriangleIndices / 3, vertices, clusters);
+			SDFMeshData meshData(vertices, indices, numTriangleIndices, PxBounds3(minExtents, maxExtents));
 
 			const PxVec3 extents(maxExtents - minExtents);
 			GridQueryPointSampler sampler(minExtents, PxVec3(extents.x / width, extents.y / height, extents.z / depth), cellCenteredSamples);
 
-
-			bool isWatertight = MeshAnalyzer::checkMeshWatertightness(reinterpret_cast<const Triangle*>(indices), numTriangleIndices / 3);
-			bool allSamplesInsideBox = true;
-			PxBounds3 box(minExtents, maxExtents);
-			for (PxU32 i = 0; i < numTriangleIndices; ++i)
-			{
-				PxVec3 v = vertices[indices[i]];
-				if (!box.contains(v))
-				{
-					allSamplesInsideBox = false;
-					break;
-				}
-			}
-
-			SDFUsingWindingNumbers(tree, clusters, vertices, indices, numTriangleIndices, width, height, depth, sdf, sampler, sampleLocations, numThreads, isWatertight, allSamplesInsideBox);
+			SDFProgress progressReporter(progressCallback);
+			if (!SDFUsingWindingNumbers(meshData.tree, meshData.clusters, vertices, indices, numTriangleIndices, width, height, depth, sdf, sampler, sampleLocations, numThreads, 
+				meshData.isWatertight, meshData.allVerticesInsideBox, dispatcher, progressReporter))
+				return false;
 		}
 
 #if EXTENDED_DEBUG
@@ -1247,6 +1374,7 @@ namespace Gu
 			}		
 		}	
 #endif
+		return true;
 	}
 
 	void convertSparseSDFTo3DTextureLayout(PxU32 width, PxU32 height, PxU32 depth, PxU32 cellsPerSubgrid,
@@ -1327,16 +1455,304 @@ namespace Gu
 		PX_CUDA_CALLABLE Interval(PxReal min_, PxReal max_) : min(min_), max(max_)
 		{}
 
-		PX_FORCE_INLINE PX_CUDA_CALLABLE bool overlaps(const Interval& i)
+		PX_FORCE_INLINE PX_CUDA_CALLABLE bool overlaps(const Interval& i) const
 		{
 			return  !(min > i.max || i.min > max);
 		}
 	};
 
-	void SDFUsingWindingNumbersSparse(const PxVec3* vertices, const PxU32* indices, PxU32 numTriangleIndices, PxU32 width, PxU32 height, PxU32 depth,
+	struct ThreadedForData
+	{
+		void		(*function)(void* userData, PxU32 startIndex, PxU32 endIndex);
+		void*		userData;
+		PxI32		nbItems;
+		PxI32		batchSize;
+		PxI32		next;
+	};
+
+	static void* threadedForJob(void* data)
+	{
+		ThreadedForData& d = *reinterpret_cast<ThreadedForData*>(data);
+
+		PxI32 start = physx::PxAtomicAdd(&d.next, d.batchSize) - d.batchSize;
+		while (start < d.nbItems)
+		{
+			d.function(d.userData, PxU32(start), PxU32(PxMin(d.nbItems, start + d.batchSize)));
+			start = physx::PxAtomicAdd(&d.next, d.batchSize) - d.batchSize;
+		}
+		return NULL;
+	}
+
+	//Runs function over [0, nbItems) in batches, on the dispatcher if there is one and on numThreads dedicated threads otherwise
+	static void parallelForOrThreads(PxCpuDispatcher* dispatcher, PxU32 numThreads, PxU32 nbItems, PxU32 batchSize,
+		void (*function)(void* userData, PxU32 startIndex, PxU32 endIndex), void* userData)
+	{
+		if (dispatcher || numThreads <= 1)
+		{
+			Cm::parallelFor(dispatcher, nbItems, batchSize, function, userData);
+			return;
+		}
+
+		ThreadedForData data;
+		data.function = function;
+		data.userData = userData;
+		data.nbItems = PxI32(nbItems);
+		data.batchSize = PxI32(batchSize);
+		data.next = 0;
+
+		PxArray<PxThread*> threads;
+		for (PxU32 i = 0; i < numThreads; ++i)
+		{
+			threads.pushBack(PX_NEW(PxThread)(threadedForJob, &data, "thread"));
+			threads[i]->start();
+		}
+
+		for (PxU32 i = 0; i < threads.size(); ++i)
+		{
+			threads[i]->waitForQuit();
+			threads[i]->~PxThreadT();
+			PX_FREE(threads[i]);
+		}
+	}
+
+	struct SDFNarrowBandData
+	{
+		SDFCalculationData calc;
+		const GridQueryPointSampler* sampler;
+		PxU32 cellsPerSubgrid;
+		PxU32 w, h, d;						//Number of subgrid blocks along each axis
+		PxU32 width, height;				//Number of samples of the full resolution grid along x and y
+		PxReal* sdfCoarse;					//(w + 1) * (h + 1) * (d + 1) samples
+		PxReal* sdfFine;					//Full resolution samples, only valid where sampleMask is set
+		const PxU8* sampleMask;				//Marks the full resolution samples that belong to a subgrid overlapping the narrow band
+	};
+
+	//Computes the signed distance at queryPoint. The sign is taken over from a neighbor sample if the neighbor is further away from
+	//the surface than the spacing between the two samples since the surface cannot be crossed in that case. Otherwise the winding
+	//number is evaluated. Pass a spacing of zero if no neighbor is available.
+	static PX_FORCE_INLINE PxReal computeSignedDistance(const SDFCalculationData& d, const PxVec3& queryPoint, PxI32& lastTriangle,
+		PxReal neighborSdf, PxReal neighborSpacing)
+	{
+		const PxReal distance = computeClosestDistance(d, queryPoint, lastTriangle);
+
+		bool inside;
+		if (neighborSpacing > 0.0f && PxAbs(neighborSdf) > neighborSpacing)
+			inside = neighborSdf < 0.0f;
+		else
+			inside = Gu::computeWindingNumber(d.tree->begin(), queryPoint, *d.clusters, d.indices, d.vertices) > 0.5f;
+		return inside ? -distance : distance;
+	}
+
+	//Computes the coarse samples for the coarse grid rows [startIndex, endIndex). Rows are indexed as zBlock * (h + 1) + yBlock.
+	static void computeCoarseSamplesJob(void* userData, PxU32 startIndex, PxU32 endIndex)
+	{
+		SDFNarrowBandData& nb = *reinterpret_cast<SDFNarrowBandData*>(userData);
+		if (nb.calc.progressReporter->isCancelled())
+			return;
+
+		const PxReal spacingX = nb.cellsPerSubgrid * nb.sampler->getActiveCellSize().x;
+
+		PxI32 lastTriangle = -1;
+		for (PxU32 row = startIndex; row < endIndex; ++row)
+		{
+			PxU32 yBlock, zBlock;
+			idToXY(row, nb.h + 1, yBlock, zBlock);
+			PxReal* sdfRow = nb.sdfCoarse + idx3D(0, yBlock, zBlock, nb.w + 1, nb.h + 1);
+			for (PxU32 xBlock = 0; xBlock <= nb.w; ++xBlock)
+			{
+				const PxVec3 p = nb.sampler->getPoint(xBlock * nb.cellsPerSubgrid, yBlock * nb.cellsPerSubgrid, zBlock * nb.cellsPerSubgrid);
+				sdfRow[xBlock] = computeSignedDistance(nb.calc, p, lastTriangle, xBlock > 0 ? sdfRow[xBlock - 1] : 0.0f, xBlock > 0 ? spacingX : 0.0f);
+			}
+		}
+		nb.calc.progressReporter->advance(endIndex - startIndex);
+	}
+
+	//Computes the masked full resolution samples for the grid rows [startIndex, endIndex). Rows are indexed as z * height + y.
+	static void computeFineSamplesJob(void* userData, PxU32 startIndex, PxU32 endIndex)
+	{
+		SDFNarrowBandData& nb = *reinterpret_cast<SDFNarrowBandData*>(userData);
+		if (nb.calc.progressReporter->isCancelled())
+			return;
+
+		const PxU32 cellsPerSubgrid = nb.cellsPerSubgrid;
+		const PxReal spacingX = nb.sampler->getActiveCellSize().x;
+
+		PxI32 lastTriangle = -1;
+		for (PxU32 row = startIndex; row < endIndex; ++row)
+		{
+			PxU32 y, z;
+			idToXY(row, nb.height, y, z);
+			const PxU32 rowStart = row * nb.width;
+			const bool onCoarseRow = (y % cellsPerSubgrid) == 0 && (z % cellsPerSubgrid) == 0;
+			for (PxU32 x = 0; x < nb.width; ++x)
+			{
+				if (!nb.sampleMask[rowStart + x])
+					continue;
+
+				PxReal& sdfValue = nb.sdfFine[rowStart + x];
+				if (onCoarseRow && (x % cellsPerSubgrid) == 0)
+				{
+					//The sample coincides with a coarse sample
+					sdfValue = nb.sdfCoarse[idx3D(x / cellsPerSubgrid, y / cellsPerSubgrid, z / cellsPerSubgrid, nb.w + 1, nb.h + 1)];
+					continue;
+				}
+
+				const bool hasNeighbor = x > 0 && nb.sampleMask[rowStart + x - 1];
+				sdfValue = computeSignedDistance(nb.calc, nb.sampler->getPoint(x, y, z), lastTriangle,
+					hasNeighbor ? nb.sdfFine[rowStart + x - 1] : 0.0f, hasNeighbor ? spacingX : 0.0f);
+			}
+		}
+		nb.calc.progressReporter->advance(endIndex - startIndex);
+	}
+
+	//Sparse sdf construction that only evaluates the full resolution grid in subgrids which can overlap the narrow band. The coarse grid
+	//is computed first. Since a signed distance field is 1-Lipschitz, a subgrid whose corner values are all further away from the narrow
+	//band than half of the subgrid diagonal cannot contain values inside the narrow band, so it is skipped. The samples of the remaining
+	//subgrids are computed in parallel and then go through the same selection as in the dense path. Only used for watertight meshes
+	//because open meshes need the dense hole fixing pass.
+	static bool SDFUsingWindingNumbersNarrowBand(SDFMeshData& meshData, const PxVec3* vertices, const PxU32* indices, PxU32 numTriangleIndices,
+		PxU32 width, PxU32 height, PxU32 depth, const PxVec3& minExtents, const PxVec3& maxExtents, PxReal narrowBandThickness, PxU32 cellsPerSubgrid,
+		PxArray<PxReal>& sdfCoarse, PxArray<PxU32>& sdfFineStartSlots, PxArray<PxReal>& subgridData,
+		PxReal& subgridsMinSdfValue, PxReal& subgridsMaxSdfValue, PxU32 numThreads, PxCpuDispatcher* dispatcher, SDFProgress& progressReporter)
+	{
+		const PxU32 w = width / cellsPerSubgrid;
+		const PxU32 h = height / cellsPerSubgrid;
+		const PxU32 d = depth / cellsPerSubgrid;
+
+		//Same sampling as the dense grid with (width + 1) * (height + 1) * (depth + 1) samples
+		const PxVec3 extents(maxExtents - minExtents);
+		const PxVec3 delta(extents.x / width, extents.y / height, extents.z / depth);
+		const PxVec3 denseExtents(maxExtents + delta - minExtents);
+		const GridQueryPointSampler sampler(minExtents, PxVec3(denseExtents.x / (width + 1), denseExtents.y / (height + 1), denseExtents.z / (depth + 1)), false);
+
+		SDFNarrowBandData nb;
+		nb.calc.vertices = vertices;
+		nb.calc.indices = indices;
+		nb.calc.numTriangleIndices = numTriangleIndices;
+		nb.calc.tree = &meshData.tree;
+		nb.calc.clusters = &meshData.clusters;
+		nb.calc.progressReporter = &progressReporter;
+		nb.sampler = &sampler;
+		nb.cellsPerSubgrid = cellsPerSubgrid;
+		nb.w = w;
+		nb.h = h;
+		nb.d = d;
+		nb.width = width + 1;
+		nb.height = height + 1;
+
+		sdfCoarse.clear();
+		sdfCoarse.resize((w + 1) * (h + 1) * (d + 1));
+		nb.sdfCoarse = sdfCoarse.begin();
+
+		progressReporter.beginPhase((h + 1) * (d + 1), 0.0f, 0.1f);
+		parallelForOrThreads(dispatcher, numThreads, (h + 1) * (d + 1), 4, computeCoarseSamplesJob, &nb);
+		if (progressReporter.isCancelled())
+			return false;
+
+		//Collect the subgrids that might overlap the narrow band and mark their samples
+		const Interval narrowBandInterval(-narrowBandThickness, narrowBandThickness);
+		const PxReal halfSubgridDiagonal = 0.5f * cellsPerSubgrid * sampler.getActiveCellSize().magnitude() * 1.01f;
+
+		PxArray<PxU8> sampleMask((width + 1) * (height + 1) * (depth + 1), PxU8(0));
+		PxArray<PxU32> candidates;
+		for (PxU32 zBlock = 0; zBlock < d; ++zBlock)
+		{
+			for (PxU32 yBlock = 0; yBlock < h; ++yBlock)
+			{
+				for (PxU32 xBlock = 0; xBlock < w; ++xBlock)
+				{
+					Interval cornerInterval;
+					for (PxU32 corner = 0; corner < 8; ++corner)
+					{
+						const PxReal sdfValue = sdfCoarse[idx3D(xBlock + (corner & 1), yBlock + ((corner >> 1) & 1), zBlock + (corner >> 2), w + 1, h + 1)];
+						cornerInterval.min = PxMin(cornerInterval.min, sdfValue);
+						cornerInterval.max = PxMax(cornerInterval.max, sdfValue);
+					}
+					cornerInterval.min -= halfSubgridDiagonal;
+					cornerInterval.max += halfSubgridDiagonal;
+
+					if (!narrowBandInterval.overlaps(cornerInterval))
+						continue;
+
+					candidates.pushBack(idx3D(xBlock, yBlock, zBlock, w, h));
+					for (PxU32 zLocal = 0; zLocal <= cellsPerSubgrid; ++zLocal)
+						for (PxU32 yLocal = 0; yLocal <= cellsPerSubgrid; ++yLocal)
+						{
+							PxU8* maskRow = &sampleMask[idx3D(xBlock * cellsPerSubgrid, yBlock * cellsPerSubgrid + yLocal, zBlock * cellsPerSubgrid + zLocal, width + 1, height + 1)];
+							PxMemSet(maskRow, 1, cellsPerSubgrid + 1);
+						}
+				}
+			}
+		}
+
+		PxArray<PxReal> sdfFine(sampleMask.size());
+		nb.sdfFine = sdfFine.begin();
+		nb.sampleMask = sampleMask.begin();
+
+		progressReporter.beginPhase((height + 1) * (depth + 1), 0.1f, 0.9f);
+		parallelForOrThreads(dispatcher, numThreads, (height + 1) * (depth + 1), 8, computeFineSamplesJob, &nb);
+		if (progressReporter.isCancelled())
+			return false;
+
+		sdfFineStartSlots.clear();
+		sdfFineStartSlots.resize(w * h * d, 0xFFFFFFFF);
+		subgridData.clear();
+
+		//Same subgrid selection as in the dense path. Candidates are sorted by block index, so the subgrids are stored in the same order.
+		DenseSDF coarseEval(w + 1, h + 1, d + 1, sdfCoarse.begin());
+		const PxReal errorThreshold = 1e-6f * extents.magnitude();
+		const PxReal s = 1.0f / cellsPerSubgrid;
+		PxU32 subgridIndexer = 0;
+		subgridsMaxSdfValue = -FLT_MAX;
+		subgridsMinSdfValue = FLT_MAX;
+		for (PxU32 i = 0; i < candidates.size(); ++i)
+		{
+			PxU32 xBlock, yBlock, zBlock;
+			idToXYZ(candidates[i], w, h, xBlock, yBlock, zBlock);
+
+			Interval interval;
+			PxReal maxAbsError = 0.0f;
+			for (PxU32 zLocal = 0; zLocal <= cellsPerSubgrid; ++zLocal)
+			{
+				for (PxU32 yLocal = 0; yLocal <= cellsPerSubgrid; ++yLocal)
+				{
+					for (PxU32 xLocal = 0; xLocal <= cellsPerSubgrid; ++xLocal)
+					{
+						const PxReal sdfValue = sdfFine[idx3D(xBlock * cellsPerSubgrid + xLocal, yBlock * cellsPerSubgrid + yLocal, zBlock * cellsPerSubgrid + zLocal, width + 1, height + 1)];
+						interval.max = PxMax(interval.max, sdfValue);
+						interval.min = PxMin(interval.min, sdfValue);
+
+						maxAbsError = PxMax(maxAbsError, PxAbs(sdfValue - coarseEval.sampleSDFDirect(PxVec3(xBlock + xLocal * s, yBlock + yLocal * s, zBlock + zLocal * s))));
+					}
+				}
+			}
+
+			bool subgridRequired = narrowBandInterval.overlaps(interval);
+			if (maxAbsError < errorThreshold)
+				subgridRequired = false; //No need for a subgrid if the coarse SDF is already almost exact
+
+			if (subgridRequired)
+			{
+				subgridsMaxSdfValue = PxMax(subgridsMaxSdfValue, interval.max);
+				subgridsMinSdfValue = PxMin(subgridsMinSdfValue, interval.min);
+
+				for (PxU32 zLocal = 0; zLocal <= cellsPerSubgrid; ++zLocal)
+					for (PxU32 yLocal = 0; yLocal <= cellsPerSubgrid; ++yLocal)
+						for (PxU32 xLocal = 0; xLocal <= cellsPerSubgrid; ++xLocal)
+							subgridData.pushBack(sdfFine[idx3D(xBlock * cellsPerSubgrid + xLocal, yBlock * cellsPerSubgrid + yLocal, zBlock * cellsPerSubgrid + zLocal, width + 1, height + 1)]);
+
+				sdfFineStartSlots[candidates[i]] = subgridIndexer;
+				++subgridIndexer;
+			}
+		}
+		return true;
+	}
+
+	bool SDFUsingWindingNumbersSparse(const PxVec3* vertices, const PxU32* indicesOrig, PxU32 numTriangleIndices, PxU32 width, PxU32 height, PxU32 depth,
 		const PxVec3& minExtents, const PxVec3& maxExtents, PxReal narrowBandThickness, PxU32 cellsPerSubgrid,
 		PxArray<PxReal>& sdfCoarse, PxArray<PxU32>& sdfFineStartSlots, PxArray<PxReal>& subgridData, PxArray<PxReal>& denseSdf,
-		PxReal& subgridsMinSdfValue, PxReal& subgridsMaxSdfValue, PxU32 numThreads, PxSDFBuilder* sdfBuilder)
+		PxReal& subgridsMinSdfValue, PxReal& subgridsMaxSdfValue, PxU32 numThreads, PxSDFBuilder* sdfBuilder,
+		PxCpuDispatcher* dispatcher, PxSDFProgressCallback* progressCallback)
 	{
 		PX_ASSERT(width % cellsPerSubgrid == 0);
 		PX_ASSERT(height % cellsPerSubgrid == 0);
@@ -1349,8 +1765,38 @@ namespace Gu
 		const PxU32 h = height / cellsPerSubgrid;
 		const PxU32 d = depth / cellsPerSubgrid;
 
-		denseSdf.resize((width + 1) * (height + 1) * (depth + 1));
-		SDFUsingWindingNumbers(vertices, indices, numTriangleIndices, width + 1, height + 1, depth + 1, denseSdf.begin(), minExtents, maxExtents + delta, NULL, false, numThreads, sdfBuilder);
+		denseSdf.clear();
+		if (sdfBuilder)
+		{
+			denseSdf.resize((width + 1) * (height + 1) * (depth + 1));
+			SDFUsingWindingNumbers(vertices, indicesOrig, numTriangleIndices, width + 1, height + 1, depth + 1, denseSdf.begin(), minExtents, maxExtents + delta, NULL, false, numThreads, sdfBuilder);
+		}
+		else
+		{
+			PxArray<PxU32> repairedIndices;
+			//Analyze the mesh to catch and fix some special cases
+			//There are meshes where every triangle is present once with cw and once with ccw orientation. Try to filter out only one set
+			analyzeAndFixMesh(vertices, indicesOrig, numTriangleIndices, repairedIndices);
+			const PxU32* indices = repairedIndices.size() > 0 ? repairedIndices.begin() : indicesOrig;
+			if (repairedIndices.size() > 0)
+				numTriangleIndices = repairedIndices.size();
+
+			SDFMeshData meshData(vertices, indices, numTriangleIndices, PxBounds3(minExtents, maxExtents + delta));
+			SDFProgress progressReporter(progressCallback);
+
+			if (meshData.isWatertight)
+			{
+				return SDFUsingWindingNumbersNarrowBand(meshData, vertices, indices, numTriangleIndices, width, height, depth, minExtents, maxExtents, narrowBandThickness, cellsPerSubgrid,
+					sdfCoarse, sdfFineStartSlots, subgridData, subgridsMinSdfValue, subgridsMaxSdfValue, numThreads, dispatcher, progressReporter);
+			}
+
+			denseSdf.resize((width + 1) * (height + 1) * (depth + 1));
+			const PxVec3 denseExtents(maxExtents + delta - minExtents);
+			GridQueryPointSampler sampler(minExtents, PxVec3(denseExtents.x / (width + 1), denseExtents.y / (height + 1), denseExtents.z / (depth + 1)), false);
+			if (!SDFUsingWindingNumbers(meshData.tree, meshData.clusters, vertices, indices, numTriangleIndices, width + 1, height + 1, depth + 1, denseSdf.begin(), sampler, NULL, numThreads,
+				meshData.isWatertight, meshData.allVerticesInsideBox, dispatcher, progressReporter))
+				return false;
+		}
 
 		sdfCoarse.clear();
 		sdfFineStartSlots.clear();
@@ -1467,6 +1913,7 @@ namespace Gu
 				}
 			}
 		}
+		return true;
 	}
 
 	PX_INLINE PxReal decodeSparse2(const SDF& sdf, PxI32 xx, PxI32 yy, PxI32 zz)
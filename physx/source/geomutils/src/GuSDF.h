@@ -38,6 +38,8 @@
 namespace physx
 {
 	class PxSDFBuilder;
+	class PxSDFProgressCallback;
+	class PxCpuDispatcher;
 	class PxSerializationContext;
 	class PxDeserializationContext;
 
@@ -270,10 +272,13 @@ namespace physx
 		\param[in] cellCenteredSamples Determines if the sample points are chosen at cell centers or at cell origins
 		\param[in] numThreads The number of cpu threads to use during the computation
 		\param[in] sdfBuilder Optional pointer to a sdf builder to accelerate the sdf construction. The pointer is owned by the caller and must remain valid until the function terminates.
+		\param[in] dispatcher Optional cpu dispatcher. If set, the samples are computed in tasks submitted to the dispatcher and numThreads is ignored. Not used if sdfBuilder is set.
+		\param[in] progressCallback Optional callback to report progress and to cancel the computation. Not used if sdfBuilder is set.
+		\return False if the computation got cancelled by the progress callback, true otherwise
 		*/
-		PX_PHYSX_COMMON_API void SDFUsingWindingNumbers(const PxVec3* vertices, const PxU32* indices, PxU32 numTriangleIndices, PxU32 width, PxU32 height, PxU32 depth, 			
+		PX_PHYSX_COMMON_API bool SDFUsingWindingNumbers(const PxVec3* vertices, const PxU32* indices, PxU32 numTriangleIndices, PxU32 width, PxU32 height, PxU32 depth, 			
 			PxReal* sdf, PxVec3 minExtents, PxVec3 maxExtents, PxVec3* sampleLocations = NULL, bool cellCenteredSamples = true, 
-			PxU32 numThreads = 1, PxSDFBuilder* sdfBuilder = NULL);
+			PxU32 numThreads = 1, PxSDFBuilder* sdfBuilder = NULL, PxCpuDispatcher* dispatcher = NULL, PxSDFProgressCallback* progressCallback = NULL);
 
 		/**
 		\brief Returns the distance to the mesh's surface for all samples in a grid. The sign is dependent on the triangle orientation. Negative distances indicate that a sample is inside the mesh, positive
@@ -294,16 +299,20 @@ namespace physx
 		\param[out] sdfCoarse The coarse sdf as a dense 3d array of lower resolution (resulution is (with/cellsPerSubgrid+1, height/cellsPerSubgrid+1, depth/cellsPerSubgrid+1))
 		\param[out] sdfFineStartSlots The start slot indices of the subgrid blocks. If a subgrid block is empty, the start slot will be 0xFFFFFFFF
 		\param[out] subgridData The array containing subgrid data blocks
-		\param[out] denseSdf Provides acces to the denxe sdf that is used for compuation internally
+		\param[out] denseSdf Provides acces to the denxe sdf that is used for compuation internally. Stays empty for watertight meshes if no sdfBuilder is set since only the subgrids close to the surface get computed in that case.
 		\param[out] subgridsMinSdfValue The minimum value over all subgrid blocks. Used if normalized textures are used which is the case for 8 and 16bit formats
 		\param[out] subgridsMaxSdfValue	The maximum value over all subgrid blocks. Used if normalized textures are used which is the case for 8 and 16bit formats
 		\param[in] numThreads The number of cpu threads to use during the computation
 		\param[in] sdfBuilder Optional pointer to a sdf builder to accelerate the sdf construction. The pointer is owned by the caller and must remain valid until the function terminates.
+		\param[in] dispatcher Optional cpu dispatcher. If set, the samples are computed in tasks submitted to the dispatcher and numThreads is ignored. Not used if sdfBuilder is set.
+		\param[in] progressCallback Optional callback to report progress and to cancel the computation. Not used if sdfBuilder is set.
+		\return False if the computation got cancelled by the progress callback, true otherwise
 		*/
-		PX_PHYSX_COMMON_API void SDFUsingWindingNumbersSparse(const PxVec3* vertices, const PxU32* indices, PxU32 numTriangleIndices, PxU32 width, PxU32 height, PxU32 depth,
+		PX_PHYSX_COMMON_API bool SDFUsingWindingNumbersSparse(const PxVec3* vertices, const PxU32* indices, PxU32 numTriangleIndices, PxU32 width, PxU32 height, PxU32 depth,
 			const PxVec3& minExtents, const PxVec3& maxExtents, PxReal narrowBandThicknessRelativeToExtentDiagonal, PxU32 cellsPerSubgrid,
 			PxArray<PxReal>& sdfCoarse, PxArray<PxU32>& sdfFineStartSlots, PxArray<PxReal>& subgridData, PxArray<PxReal>& denseSdf,
-			PxReal& subgridsMinSdfValue, PxReal& subgridsMaxSdfValue, PxU32 numThreads = 1, PxSDFBuilder* sdfBuilder = NULL);
+			PxReal& subgridsMinSdfValue, PxReal& subgridsMaxSdfValue, PxU32 numThreads = 1, PxSDFBuilder* sdfBuilder = NULL,
+			PxCpuDispatcher* dispatcher = NULL, PxSDFProgressCallback* progressCallback = NULL);
 	
 		
 		PX_PHYSX_COMMON_API void analyzeAndFixMesh(const PxVec3* vertices, const PxU32* indicesOrig, PxU32 numTriangleIndices, PxArray<PxU32>& repairedIndices);
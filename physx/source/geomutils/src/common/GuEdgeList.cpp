@@ -33,6 +33,7 @@
 #include "foundation/PxPlane.h"
 #include "CmRadixSort.h"
 #include "CmSerialize.h"
+#include "CmParallelFor.h"
 
 // PT: code archeology: this initially came from ICE (IceEdgeList.h/cpp). Consider putting it back the way it was initially.
 // It makes little sense that something like EdgeList is in GeomUtils but some equivalent class like Adjacencies in is Cooking.
@@ -103,15 +104,15 @@ bool EdgeList::init(const EDGELISTCREATE& create)
 	const bool EdgesToFaces = create.Verts ? true : create.EdgesToFaces;
 
 	// "FacesToEdges" maps each face to three edges.
-	if(FacesToEdges && !createFacesToEdges(create.NbFaces, create.DFaces, create.WFaces))
+	if(FacesToEdges && !createFacesToEdges(create.NbFaces, create.DFaces, create.WFaces, create.Dispatcher))
 		return false;
 
 	// "EdgesToFaces" maps each edge to the set of faces sharing this edge
-	if(EdgesToFaces && !createEdgesToFaces(create.NbFaces, create.DFaces, create.WFaces))
+	if(EdgesToFaces && !createEdgesToFaces(create.NbFaces, create.DFaces, create.WFaces, create.Dispatcher))
 		return false;
 
 	// Create active edges
-	if(create.Verts && !computeActiveEdges(create.NbFaces, create.DFaces, create.WFaces, create.Verts, create.Epsilon))
+	if(create.Verts && !computeActiveEdges(create.NbFaces, create.DFaces, create.WFaces, create.Verts, create.Epsilon, create.Dispatcher))
 		return false;
 
 	// Get rid of useless data
@@ -127,6 +128,46 @@ bool EdgeList::init(const EDGELISTCREATE& create)
 	return true;
 }
 
+namespace
+{
+	#define EDGE_LIST_BATCH_SIZE	16384
+
+	struct RedundantEdgesParams
+	{
+		const PxU32*	mDFaces;
+		const PxU16*	mWFaces;
+		PxU32*			mVRefs0;
+		PxU32*			mVRefs1;
+
+		static void create(void* userData, PxU32 startIndex, PxU32 endIndex)
+		{
+			const RedundantEdgesParams* params = reinterpret_cast<const RedundantEdgesParams*>(userData);
+			const PxU32* PX_RESTRICT dfaces = params->mDFaces;
+			const PxU16* PX_RESTRICT wfaces = params->mWFaces;
+			PxU32* PX_RESTRICT VRefs0 = params->mVRefs0;
+			PxU32* PX_RESTRICT VRefs1 = params->mVRefs1;
+
+			for(PxU32 i=startIndex;i<endIndex;i++)
+			{
+				// Get right vertex-references
+				const PxU32 Ref0 = dfaces ? dfaces[i*3+0] : wfaces ? wfaces[i*3+0] : 0;
+				const PxU32 Ref1 = dfaces ? dfaces[i*3+1] : wfaces ? wfaces[i*3+1] : 1;
+				const PxU32 Ref2 = dfaces ? dfaces[i*3+2] : wfaces ? wfaces[i*3+2] : 2;
+
+				// Pre-Sort vertex-references and put them in the lists
+				if(Ref0<Ref1)	{ VRefs0[i*3+0] = Ref0; VRefs1[i*3+0] = Ref1; }		// Edge 0-1 maps (i%3)
+				else			{ VRefs0[i*3+0] = Ref1; VRefs1[i*3+0] = Ref0; }		// Edge 0-1 maps (i%3)
+
+				if(Ref1<Ref2)	{ VRefs0[i*3+1] = Ref1; VRefs1[i*3+1] = Ref2; }		// Edge 1-2 maps (i%3)+1
+				else			{ VRefs0[i*3+1] = Ref2; VRefs1[i*3+1] = Ref1; }		// Edge 1-2 maps (i%3)+1
+
+				if(Ref2<Ref0)	{ VRefs0[i*3+2] = Ref2; VRefs1[i*3+2] = Ref0; }		// Edge 2-0 maps (i%3)+2
+				else			{ VRefs0[i*3+2] = Ref0; VRefs1[i*3+2] = Ref2; }		// Edge 2-0 maps (i%3)+2
+			}
+		}
+	};
+}
+
 /**
  *	Computes FacesToEdges.
  *	After the call:
@@ -139,7 +180,7 @@ bool EdgeList::init(const EDGELISTCREATE& create)
  *	\param		wfaces		[in] list of triangles with PxU16 vertex references (or NULL)
  *	\return		true if success.
  */
-bool EdgeList::createFacesToEdges(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces)
+bool EdgeList::createFacesToEdges(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces, PxCpuDispatcher* dispatcher)
 {
 	if(!nb_faces || (!dfaces && !wfaces))
 		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "EdgeList::CreateFacesToEdges: NULL parameter!");
@@ -154,22 +195,13 @@ bool EdgeList::createFacesToEdges(PxU32 nb_faces, const PxU32* dfaces, const PxU
 	EdgeData*	Buffer	= PX_ALLOCATE(EdgeData, nb_faces*3, "Tmp");					// Temp storage
 
 	// 2) Create a full redundant list of 3 edges / face.
-	for(PxU32 i=0;i<nb_faces;i++)
 	{
-		// Get right vertex-references
-		const PxU32 Ref0 = dfaces ? dfaces[i*3+0] : wfaces ? wfaces[i*3+0] : 0;
-		const PxU32 Ref1 = dfaces ? dfaces[i*3+1] : wfaces ? wfaces[i*3+1] : 1;
-		const PxU32 Ref2 = dfaces ? dfaces[i*3+2] : wfaces ? wfaces[i*3+2] : 2;
-
-		// Pre-Sort vertex-references and put them in the lists
-		if(Ref0<Ref1)	{ VRefs0[i*3+0] = Ref0; VRefs1[i*3+0] = Ref1; }		// Edge 0-1 maps (i%3)
-		else			{ VRefs0[i*3+0] = Ref1; VRefs1[i*3+0] = Ref0; }		// Edge 0-1 maps (i%3)
-
-		if(Ref1<Ref2)	{ VRefs0[i*3+1] = Ref1; VRefs1[i*3+1] = Ref2; }		// Edge 1-2 maps (i%3)+1
-		else			{ VRefs0[i*3+1] = Ref2; VRefs1[i*3+1] = Ref1; }		// Edge 1-2 maps (i%3)+1
-
-		if(Ref2<Ref0)	{ VRefs0[i*3+2] = Ref2; VRefs1[i*3+2] = Ref0; }		// Edge 2-0 maps (i%3)+2
-		else			{ VRefs0[i*3+2] = Ref0; VRefs1[i*3+2] = Ref2; }		// Edge 2-0 maps (i%3)+2
+		RedundantEdgesParams params;
+		params.mDFaces	= dfaces;
+		params.mWFaces	= wfaces;
+		params.mVRefs0	= VRefs0;
+		params.mVRefs1	= VRefs1;
+		Cm::parallelFor(dispatcher, nb_faces, EDGE_LIST_BATCH_SIZE, RedundantEdgesParams::create, &params);
 	}
 
 	// 3) Sort the list according to both keys (VRefs0 and VRefs1)
@@ -229,10 +261,10 @@ bool EdgeList::createFacesToEdges(PxU32 nb_faces, const PxU32* dfaces, const PxU
  *	\param		wfaces		[in] list of triangles with PxU16 vertex references (or NULL)
  *	\return		true if success.
  */
-bool EdgeList::createEdgesToFaces(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces)
+bool EdgeList::createEdgesToFaces(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces, PxCpuDispatcher* dispatcher)
 {
 	// 1) I need FacesToEdges !
-	if(!createFacesToEdges(nb_faces, dfaces, wfaces))
+	if(!createFacesToEdges(nb_faces, dfaces, wfaces, dispatcher))
 		return false;
 
 	// 2) Get some bytes: one Pair structure / edge
@@ -293,81 +325,191 @@ static PX_INLINE PxU32 OppositeVertex(PxU32 r0, PxU32 r1, PxU32 r2, PxU32 vref0,
 	return PX_INVALID_U32;
 }
 
-bool EdgeList::computeActiveEdges(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces, const PxVec3* verts, float epsilon)
+static bool computeActiveEdge(const EdgeDescData& ED, const EdgeData& Edge, const PxU32* PX_RESTRICT FBE, const PxU32* PX_RESTRICT dfaces, const PxU16* PX_RESTRICT wfaces, const PxVec3* PX_RESTRICT verts, float epsilon)
 {
-	if(!verts || (!dfaces && !wfaces))
-		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "EdgeList::ComputeActiveEdges: NULL parameter!");
+	// Get number of triangles sharing current edge
+	const PxU32 Count = ED.Count;
+	// Boundary edges are active => keep them (actually they're silhouette edges directly)
+	// Internal edges can be active => test them
+	// Singular edges ? => discard them
+	bool Active = false;
+	if(Count==1)
+	{
+		Active = true;
+	}
+	else if(Count==2)
+	{
+		const PxU32 FaceIndex0 = FBE[ED.Offset+0]*3;
+		const PxU32 FaceIndex1 = FBE[ED.Offset+1]*3;
 
-	PxU32 NbEdges = getNbEdges();
-	if(!NbEdges)
-		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "ActiveEdges::ComputeConvexEdges: no edges in edge list!");
+		PxU32 VRef00, VRef01, VRef02;
+		PxU32 VRef10, VRef11, VRef12;
 
-	const EdgeData* Edges = getEdges();
-	if(!Edges)
-		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "ActiveEdges::ComputeConvexEdges: no edge data in edge list!");
+		if(dfaces)
+		{
+			VRef00 = dfaces[FaceIndex0+0];
+			VRef01 = dfaces[FaceIndex0+1];
+			VRef02 = dfaces[FaceIndex0+2];
+			VRef10 = dfaces[FaceIndex1+0];
+			VRef11 = dfaces[FaceIndex1+1];
+			VRef12 = dfaces[FaceIndex1+2];
+		}
+		else //if(wfaces)
+		{
+			PX_ASSERT(wfaces);
+			VRef00 = wfaces[FaceIndex0+0];
+			VRef01 = wfaces[FaceIndex0+1];
+			VRef02 = wfaces[FaceIndex0+2];
+			VRef10 = wfaces[FaceIndex1+0];
+			VRef11 = wfaces[FaceIndex1+1];
+			VRef12 = wfaces[FaceIndex1+2];
+		}
 
-	const EdgeDescData* ED = getEdgeToTriangles();
-	if(!ED)
-		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "ActiveEdges::ComputeConvexEdges: no edge-to-triangle in edge list!");
+		{
+			// We first check the opposite vertex against the plane
 
-	const PxU32* FBE = getFacesByEdges();
-	if(!FBE)
-		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "ActiveEdges::ComputeConvexEdges: no faces-by-edges in edge list!");
+			const PxU32 Op = OppositeVertex(VRef00, VRef01, VRef02, Edge.Ref0, Edge.Ref1);
 
-	// We first create active edges in a temporaray buffer. We have one bool / edge.
-	bool* ActiveEdges = PX_ALLOCATE(bool, NbEdges, "bool");
+			const PxPlane PL1(verts[VRef10], verts[VRef11], verts[VRef12]);
 
-	// Loop through edges and look for convex ones
-	bool* CurrentMark = ActiveEdges;
+			if(PL1.distance(verts[Op])<0.0f)	// If opposite vertex is below the plane, i.e. we discard concave edges
+			{
+				const PxTriangle T0(verts[VRef00], verts[VRef01], verts[VRef02]);
+				const PxTriangle T1(verts[VRef10], verts[VRef11], verts[VRef12]);
+
+				PxVec3 N0, N1;
+				T0.normal(N0);
+				T1.normal(N1);
+				const float a = PxComputeAngle(N0, N1);
 
-	while(NbEdges--)
+				if(fabsf(a)>epsilon)
+					Active = true;
+			}
+			else
+			{
+				const PxTriangle T0(verts[VRef00], verts[VRef01], verts[VRef02]);
+				const PxTriangle T1(verts[VRef10], verts[VRef11], verts[VRef12]);
+				PxVec3 N0, N1;
+				T0.normal(N0);
+				T1.normal(N1);
+
+				if(N0.dot(N1) < -0.999f)
+					Active = true;
+			}
+//Active = true;
+		}
+
+	}
+	else
 	{
-		// Get number of triangles sharing current edge
-		const PxU32 Count = ED->Count;
-		// Boundary edges are active => keep them (actually they're silhouette edges directly)
-		// Internal edges can be active => test them
-		// Singular edges ? => discard them
-		bool Active = false;
-		if(Count==1)
+		//Connected to more than 2 
+		//We need to loop through the triangles and count the number of unique triangles (considering back-face triangles as non-unique). If we end up with more than 2 unique triangles,
+		//then by definition this is an inactive edge. However, if we end up with 2 unique triangles (say like a double-sided tesselated surface), then it depends on the same rules as above
+
+		const PxU32 FaceInd0 = FBE[ED.Offset]*3;
+		PxU32 VRef00, VRef01, VRef02;
+		PxU32 VRef10=0, VRef11=0, VRef12=0;
+		if(dfaces)
 		{
-			Active = true;
+			VRef00 = dfaces[FaceInd0+0];
+			VRef01 = dfaces[FaceInd0+1];
+			VRef02 = dfaces[FaceInd0+2];
 		}
-		else if(Count==2)
+		else //if(wfaces)
 		{
-			const PxU32 FaceIndex0 = FBE[ED->Offset+0]*3;
-			const PxU32 FaceIndex1 = FBE[ED->Offset+1]*3;
+			PX_ASSERT(wfaces);
+			VRef00 = wfaces[FaceInd0+0];
+			VRef01 = wfaces[FaceInd0+1];
+			VRef02 = wfaces[FaceInd0+2];
+		}
+
+		PxU32 numUniqueTriangles = 1;
+		bool doubleSided0 = false;
+		bool doubleSided1 = 0;
 
-			PxU32 VRef00, VRef01, VRef02;
-			PxU32 VRef10, VRef11, VRef12;
+		for(PxU32 a = 1; a < Count; ++a)
+		{
+			const PxU32 FaceInd = FBE[ED.Offset+a]*3;
 
+			PxU32 VRef0, VRef1, VRef2;
 			if(dfaces)
 			{
-				VRef00 = dfaces[FaceIndex0+0];
-				VRef01 = dfaces[FaceIndex0+1];
-				VRef02 = dfaces[FaceIndex0+2];
-				VRef10 = dfaces[FaceIndex1+0];
-				VRef11 = dfaces[FaceIndex1+1];
-				VRef12 = dfaces[FaceIndex1+2];
+				VRef0 = dfaces[FaceInd+0];
+				VRef1 = dfaces[FaceInd+1];
+				VRef2 = dfaces[FaceInd+2];
 			}
 			else //if(wfaces)
 			{
 				PX_ASSERT(wfaces);
-				VRef00 = wfaces[FaceIndex0+0];
-				VRef01 = wfaces[FaceIndex0+1];
-				VRef02 = wfaces[FaceIndex0+2];
-				VRef10 = wfaces[FaceIndex1+0];
-				VRef11 = wfaces[FaceIndex1+1];
-				VRef12 = wfaces[FaceIndex1+2];
+				VRef0 = wfaces[FaceInd+0];
+				VRef1 = wfaces[FaceInd+1];
+				VRef2 = wfaces[FaceInd+2];
 			}
 
+			if(((VRef0 != VRef00) && (VRef0 != VRef01) && (VRef0 != VRef02)) || 
+				((VRef1 != VRef00) && (VRef1 != VRef01) && (VRef1 != VRef02)) || 
+				((VRef2 != VRef00) && (VRef2 != VRef01) && (VRef2 != VRef02)))
 			{
-				// We first check the opposite vertex against the plane
+				//Not the same as trig 0
+				if(numUniqueTriangles == 2)
+				{
+					if(((VRef0 != VRef10) && (VRef0 != VRef11) && (VRef0 != VRef12)) || 
+						((VRef1 != VRef10) && (VRef1 != VRef11) && (VRef1 != VRef12)) || 
+						((VRef2 != VRef10) && (VRef2 != VRef11) && (VRef2 != VRef12)))
+					{
+						//Too many unique triangles - terminate and mark as inactive
+						numUniqueTriangles++;
+						break;
+					}
+					else
+					{
+						const PxTriangle T0(verts[VRef10], verts[VRef11], verts[VRef12]);
+						const PxTriangle T1(verts[VRef0], verts[VRef1], verts[VRef2]);
+						PxVec3 N0, N1;
+						T0.normal(N0);
+						T1.normal(N1);
 
-				const PxU32 Op = OppositeVertex(VRef00, VRef01, VRef02, Edges->Ref0, Edges->Ref1);
+						if(N0.dot(N1) < -0.999f)
+							doubleSided1 = true;
+					}
+				}
+				else
+				{
+					VRef10 = VRef0;
+					VRef11 = VRef1;
+					VRef12 = VRef2;
+					numUniqueTriangles++;
+				}
+			}
+			else
+			{
+				//Check for double sided...
+				const PxTriangle T0(verts[VRef00], verts[VRef01], verts[VRef02]);
+				const PxTriangle T1(verts[VRef0], verts[VRef1], verts[VRef2]);
+				PxVec3 N0, N1;
+				T0.normal(N0);
+				T1.normal(N1);
+
+				if(N0.dot(N1) < -0.999f)
+					doubleSided0 = true;
+			}
+		}
 
+		if(numUniqueTriangles == 1)
+			Active = true;
+		if(numUniqueTriangles == 2)
+		{
+			//Potentially active. Let's check the angles between the surfaces...
+
+			if(doubleSided0 || doubleSided1)
+			{
+			
+	//			Plane PL1 = faces[FBE[ED.Offset+1]].PlaneEquation(verts);
 				const PxPlane PL1(verts[VRef10], verts[VRef11], verts[VRef12]);
 
-				if(PL1.distance(verts[Op])<0.0f)	// If opposite vertex is below the plane, i.e. we discard concave edges
+//				if(PL1.Distance(verts[Op])<-epsilon)	Active = true;
+				//if(PL1.distance(verts[Op])<0.0f)	// If opposite vertex is below the plane, i.e. we discard concave edges
+				//KS - can't test signed distance for concave edges. This is a double-sided poly
 				{
 					const PxTriangle T0(verts[VRef00], verts[VRef01], verts[VRef02]);
 					const PxTriangle T1(verts[VRef10], verts[VRef11], verts[VRef12]);
@@ -377,208 +519,145 @@ bool EdgeList::computeActiveEdges(PxU32 nb_faces, const PxU32* dfaces, const PxU
 					T1.normal(N1);
 					const float a = PxComputeAngle(N0, N1);
 
-					if(fabsf(a)>epsilon)
+					if(fabsf(a)>epsilon)	
 						Active = true;
 				}
-				else
+			}
+			else
+			{
+				
+				//Not double sided...must have had a bunch of duplicate triangles!!!!
+				//Treat as normal
+				const PxU32 Op = OppositeVertex(VRef00, VRef01, VRef02, Edge.Ref0, Edge.Ref1);
+
+	//			Plane PL1 = faces[FBE[ED.Offset+1]].PlaneEquation(verts);
+				const PxPlane PL1(verts[VRef10], verts[VRef11], verts[VRef12]);
+
+//				if(PL1.Distance(verts[Op])<-epsilon)	Active = true;
+				if(PL1.distance(verts[Op])<0.0f)	// If opposite vertex is below the plane, i.e. we discard concave edges
 				{
 					const PxTriangle T0(verts[VRef00], verts[VRef01], verts[VRef02]);
 					const PxTriangle T1(verts[VRef10], verts[VRef11], verts[VRef12]);
+
 					PxVec3 N0, N1;
 					T0.normal(N0);
 					T1.normal(N1);
+					const float a = PxComputeAngle(N0, N1);
 
-					if(N0.dot(N1) < -0.999f)
+					if(fabsf(a)>epsilon)	
 						Active = true;
 				}
-//Active = true;
 			}
-
 		}
 		else
 		{
-			//Connected to more than 2 
-			//We need to loop through the triangles and count the number of unique triangles (considering back-face triangles as non-unique). If we end up with more than 2 unique triangles,
-			//then by definition this is an inactive edge. However, if we end up with 2 unique triangles (say like a double-sided tesselated surface), then it depends on the same rules as above
-
-			const PxU32 FaceInd0 = FBE[ED->Offset]*3;
-			PxU32 VRef00, VRef01, VRef02;
-			PxU32 VRef10=0, VRef11=0, VRef12=0;
-			if(dfaces)
-			{
-				VRef00 = dfaces[FaceInd0+0];
-				VRef01 = dfaces[FaceInd0+1];
-				VRef02 = dfaces[FaceInd0+2];
-			}
-			else //if(wfaces)
-			{
-				PX_ASSERT(wfaces);
-				VRef00 = wfaces[FaceInd0+0];
-				VRef01 = wfaces[FaceInd0+1];
-				VRef02 = wfaces[FaceInd0+2];
-			}
+			//Lots of triangles all  smooshed together. Just activate the edge in this case
+			Active = true;
+		}
 
-			PxU32 numUniqueTriangles = 1;
-			bool doubleSided0 = false;
-			bool doubleSided1 = 0;
+	}
 
-			for(PxU32 a = 1; a < Count; ++a)
-			{
-				const PxU32 FaceInd = FBE[ED->Offset+a]*3;
+	return Active;
+}
 
-				PxU32 VRef0, VRef1, VRef2;
-				if(dfaces)
-				{
-					VRef0 = dfaces[FaceInd+0];
-					VRef1 = dfaces[FaceInd+1];
-					VRef2 = dfaces[FaceInd+2];
-				}
-				else //if(wfaces)
-				{
-					PX_ASSERT(wfaces);
-					VRef0 = wfaces[FaceInd+0];
-					VRef1 = wfaces[FaceInd+1];
-					VRef2 = wfaces[FaceInd+2];
-				}
+namespace
+{
+	struct ActiveEdgesParams
+	{
+		const EdgeDescData*	mED;
+		const EdgeData*		mEdges;
+		const PxU32*		mFBE;
+		const PxU32*		mDFaces;
+		const PxU16*		mWFaces;
+		const PxVec3*		mVerts;
+		float				mEpsilon;
+		bool*				mActiveEdges;
+		EdgeTriangleData*	mEdgeFaces;
+		EdgeDescData*		mEdgeToTriangles;
+
+		static void computeEdges(void* userData, PxU32 startIndex, PxU32 endIndex)
+		{
+			const ActiveEdgesParams* params = reinterpret_cast<const ActiveEdgesParams*>(userData);
+			for(PxU32 i=startIndex;i<endIndex;i++)
+				params->mActiveEdges[i] = computeActiveEdge(params->mED[i], params->mEdges[i], params->mFBE, params->mDFaces, params->mWFaces, params->mVerts, params->mEpsilon);
+		}
 
-				if(((VRef0 != VRef00) && (VRef0 != VRef01) && (VRef0 != VRef02)) || 
-					((VRef1 != VRef00) && (VRef1 != VRef01) && (VRef1 != VRef02)) || 
-					((VRef2 != VRef00) && (VRef2 != VRef01) && (VRef2 != VRef02)))
+		static void markFaces(void* userData, PxU32 startIndex, PxU32 endIndex)
+		{
+			const ActiveEdgesParams* params = reinterpret_cast<const ActiveEdgesParams*>(userData);
+			const bool* PX_RESTRICT ActiveEdges = params->mActiveEdges;
+			for(PxU32 i=startIndex;i<endIndex;i++)
+			{
+				EdgeTriangleData& ET = params->mEdgeFaces[i];
+				for(PxU32 j=0;j<3;j++)
 				{
-					//Not the same as trig 0
-					if(numUniqueTriangles == 2)
-					{
-						if(((VRef0 != VRef10) && (VRef0 != VRef11) && (VRef0 != VRef12)) || 
-							((VRef1 != VRef10) && (VRef1 != VRef11) && (VRef1 != VRef12)) || 
-							((VRef2 != VRef10) && (VRef2 != VRef11) && (VRef2 != VRef12)))
-						{
-							//Too many unique triangles - terminate and mark as inactive
-							numUniqueTriangles++;
-							break;
-						}
-						else
-						{
-							const PxTriangle T0(verts[VRef10], verts[VRef11], verts[VRef12]);
-							const PxTriangle T1(verts[VRef0], verts[VRef1], verts[VRef2]);
-							PxVec3 N0, N1;
-							T0.normal(N0);
-							T1.normal(N1);
-
-							if(N0.dot(N1) < -0.999f)
-								doubleSided1 = true;
-						}
-					}
-					else
+					const PxU32 Link = ET.mLink[j];
+					if(!(Link & MSH_ACTIVE_EDGE_MASK))	// else already active
 					{
-						VRef10 = VRef0;
-						VRef11 = VRef1;
-						VRef12 = VRef2;
-						numUniqueTriangles++;
+						if(ActiveEdges[Link & MSH_EDGE_LINK_MASK])
+							ET.mLink[j] |= MSH_ACTIVE_EDGE_MASK;	// Mark as active
 					}
 				}
-				else
-				{
-					//Check for double sided...
-					const PxTriangle T0(verts[VRef00], verts[VRef01], verts[VRef02]);
-					const PxTriangle T1(verts[VRef0], verts[VRef1], verts[VRef2]);
-					PxVec3 N0, N1;
-					T0.normal(N0);
-					T1.normal(N1);
-
-					if(N0.dot(N1) < -0.999f)
-						doubleSided0 = true;
-				}
 			}
+		}
 
-			if(numUniqueTriangles == 1)
-				Active = true;
-			if(numUniqueTriangles == 2)
+		static void markEdges(void* userData, PxU32 startIndex, PxU32 endIndex)
+		{
+			const ActiveEdgesParams* params = reinterpret_cast<const ActiveEdgesParams*>(userData);
+			const bool* PX_RESTRICT ActiveEdges = params->mActiveEdges;
+			for(PxU32 i=startIndex;i<endIndex;i++)
 			{
-				//Potentially active. Let's check the angles between the surfaces...
-
-				if(doubleSided0 || doubleSided1)
-				{
-				
-		//			Plane PL1 = faces[FBE[ED->Offset+1]].PlaneEquation(verts);
-					const PxPlane PL1(verts[VRef10], verts[VRef11], verts[VRef12]);
-
-	//				if(PL1.Distance(verts[Op])<-epsilon)	Active = true;
-					//if(PL1.distance(verts[Op])<0.0f)	// If opposite vertex is below the plane, i.e. we discard concave edges
-					//KS - can't test signed distance for concave edges. This is a double-sided poly
-					{
-						const PxTriangle T0(verts[VRef00], verts[VRef01], verts[VRef02]);
-						const PxTriangle T1(verts[VRef10], verts[VRef11], verts[VRef12]);
-
-						PxVec3 N0, N1;
-						T0.normal(N0);
-						T1.normal(N1);
-						const float a = PxComputeAngle(N0, N1);
+				if(ActiveEdges[i])
+					params->mEdgeToTriangles[i].Flags |= PX_EDGE_ACTIVE;
+			}
+		}
+	};
+}
 
-						if(fabsf(a)>epsilon)	
-							Active = true;
-					}
-				}
-				else
-				{
-					
-					//Not double sided...must have had a bunch of duplicate triangles!!!!
-					//Treat as normal
-					const PxU32 Op = OppositeVertex(VRef00, VRef01, VRef02, Edges->Ref0, Edges->Ref1);
+bool EdgeList::computeActiveEdges(PxU32 nb_faces, const PxU32* dfaces, const PxU16* wfaces, const PxVec3* verts, float epsilon, PxCpuDispatcher* dispatcher)
+{
+	if(!verts || (!dfaces && !wfaces))
+		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "EdgeList::ComputeActiveEdges: NULL parameter!");
 
-		//			Plane PL1 = faces[FBE[ED->Offset+1]].PlaneEquation(verts);
-					const PxPlane PL1(verts[VRef10], verts[VRef11], verts[VRef12]);
+	const PxU32 NbEdges = getNbEdges();
+	if(!NbEdges)
+		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "ActiveEdges::ComputeConvexEdges: no edges in edge list!");
 
-	//				if(PL1.Distance(verts[Op])<-epsilon)	Active = true;
-					if(PL1.distance(verts[Op])<0.0f)	// If opposite vertex is below the plane, i.e. we discard concave edges
-					{
-						const PxTriangle T0(verts[VRef00], verts[VRef01], verts[VRef02]);
-						const PxTriangle T1(verts[VRef10], verts[VRef11], verts[VRef12]);
+	const EdgeData* Edges = getEdges();
+	if(!Edges)
+		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "ActiveEdges::ComputeConvexEdges: no edge data in edge list!");
 
-						PxVec3 N0, N1;
-						T0.normal(N0);
-						T1.normal(N1);
-						const float a = PxComputeAngle(N0, N1);
+	const EdgeDescData* ED = getEdgeToTriangles();
+	if(!ED)
+		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "ActiveEdges::ComputeConvexEdges: no edge-to-triangle in edge list!");
 
-						if(fabsf(a)>epsilon)	
-							Active = true;
-					}
-				}
-			}
-			else
-			{
-				//Lots of triangles all  smooshed together. Just activate the edge in this case
-				Active = true;
-			}
+	const PxU32* FBE = getFacesByEdges();
+	if(!FBE)
+		return outputError<PxErrorCode::eINVALID_OPERATION>(__LINE__, "ActiveEdges::ComputeConvexEdges: no faces-by-edges in edge list!");
 
-		}
+	// We first create active edges in a temporaray buffer. We have one bool / edge.
+	bool* ActiveEdges = PX_ALLOCATE(bool, NbEdges, "bool");
 
-		*CurrentMark++ = Active;
-		ED++;
-		Edges++;
-	}
+	// Loop through edges and look for convex ones. Each edge is processed independently.
+	ActiveEdgesParams params;
+	params.mED				= ED;
+	params.mEdges			= Edges;
+	params.mFBE				= FBE;
+	params.mDFaces			= dfaces;
+	params.mWFaces			= wfaces;
+	params.mVerts			= verts;
+	params.mEpsilon			= epsilon;
+	params.mActiveEdges		= ActiveEdges;
+	params.mEdgeFaces		= mEdgeFaces;
+	params.mEdgeToTriangles	= mEdgeToTriangles;
+	Cm::parallelFor(dispatcher, NbEdges, EDGE_LIST_BATCH_SIZE, ActiveEdgesParams::computeEdges, &params);
 
 	// Now copy bits back into already existing edge structures
 	// - first in edge triangles
-	for(PxU32 i=0;i<mNbFaces;i++)
-	{
-		EdgeTriangleData& ET = mEdgeFaces[i];
-		for(PxU32 j=0;j<3;j++)
-		{
-			const PxU32 Link = ET.mLink[j];
-			if(!(Link & MSH_ACTIVE_EDGE_MASK))	// else already active
-			{
-				if(ActiveEdges[Link & MSH_EDGE_LINK_MASK])
-					ET.mLink[j] |= MSH_ACTIVE_EDGE_MASK;	// Mark as active
-			}
-		}
-	}
+	Cm::parallelFor(dispatcher, mNbFaces, EDGE_LIST_BATCH_SIZE, ActiveEdgesParams::markFaces, &params);
 
 	// - then in edge-to-faces
-	for(PxU32 i=0;i<mNbEdges;i++)
-	{
-		if(ActiveEdges[i])
-			mEdgeToTriangles[i].Flags |= PX_EDGE_ACTIVE;
-	}
+	Cm::parallelFor(dispatcher, mNbEdges, EDGE_LIST_BATCH_SIZE, ActiveEdgesParams::markEdges, &params);
 
 	// Free & exit
 	PX_FREE(ActiveEdges);
@@ -282,11 +282,20 @@ bool ConvexHullBuilder::checkHullPolygons() const
 	testVectors[7] = PxVec3(-max.x,-max.y,-max.z);
 
 
+	// PT: hull vertices are 8-bit indices so we can mark the vertices of each polygon in a bitmap, instead
+	// of looping over the polygon's vertices for each hull vertex.
+	PxU32 polygonVerts[256/32];
+	PxMemZero(polygonVerts, sizeof(polygonVerts));
+
 	// Extra convex hull validity check. This is less aggressive than previous convex decomposer!
 	// Loop through polygons
 	for(PxU32 i=0;i<mHull->mNbPolygons;i++)
 	{
 		const PxPlane& P = hullPolygons[i].mPlane;
+		const PxU8* polygonVRefs = vertexData + hullPolygons[i].mVRef8;
+		const PxU32 nb = hullPolygons[i].mNbVerts;
+		for(PxU32 k=0;k<nb;k++)
+			polygonVerts[polygonVRefs[k]>>5] |= 1<<(polygonVRefs[k]&31);
 
 		for (PxU32 k = 0; k < 8; k++)
 		{
@@ -304,16 +313,8 @@ bool ConvexHullBuilder::checkHullPolygons() const
 		for(PxU32 j=0;j<mHull->mNbHullVertices;j++)
 		{
 			// Don't test vertex if it belongs to plane (to prevent numerical issues)
-			PxU32 nb = hullPolygons[i].mNbVerts;
-			bool discard=false;
-			for(PxU32 k=0;k<nb;k++)
-			{
-				if(vertexData[hullPolygons[i].mVRef8+k]==PxU8(j))
-				{
-					discard = true;
-					break;
-				}
-			}
+			const PxU8 vref = PxU8(j);
+			const bool discard = (polygonVerts[vref>>5] & (1<<(vref&31))) != 0;
 
 			if(!discard)
 			{
@@ -324,6 +325,9 @@ bool ConvexHullBuilder::checkHullPolygons() const
 					return outputError<PxErrorCode::eINTERNAL_ERROR>(__LINE__, "Gu::ConvexMesh::checkHullPolygons: Some hull vertices seems to be too far from hull planes.");
 			}
 		}
+
+		for(PxU32 k=0;k<nb;k++)
+			polygonVerts[polygonVRefs[k]>>5] = 0;
 	}
 
 	for (PxU32 i = 0; i < 8; i++)
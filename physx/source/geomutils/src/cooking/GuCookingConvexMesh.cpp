@@ -32,7 +32,10 @@
 #include "GuConvexMesh.h"
 #include "foundation/PxAlloca.h"
 #include "foundation/PxFPU.h"
+#include "foundation/PxMutex.h"
+#include "foundation/PxAtomic.h"
 #include "common/PxInsertionCallback.h"
+#include "CmParallelFor.h"
 
 using namespace physx;
 using namespace Gu;
@@ -61,6 +64,14 @@ static bool cookConvexMeshInternal(const PxCookingParams& params, const PxConvex
 	PxConvexMeshDesc desc = desc_;	
 	bool polygonsLimitReached = false;
 
+	// PT: fast hulls skip the validation, the precise inertia computation and the gauss map. Hulls have less than 256 vertices.
+	PxU32 gaussMapLimit = params.gaussMapLimit;
+	if(desc.flags & PxConvexFlag::eFAST_HULL)
+	{
+		desc.flags |= PxConvexFlag::eDISABLE_MESH_VALIDATION | PxConvexFlag::eFAST_INERTIA_COMPUTATION;
+		gaussMapLimit = 256;
+	}
+
 	// the convex will be cooked from provided points
 	if(desc_.flags & PxConvexFlag::eCOMPUTE_CONVEX)
 	{
@@ -109,7 +120,7 @@ static bool cookConvexMeshInternal(const PxCookingParams& params, const PxConvex
 			return outputError<PxErrorCode::eINTERNAL_ERROR>(__LINE__, "Cooking::cookConvexMesh: GPU-compatible user-provided hull must have less than 65 faces!");
 	}
 		
-	if(!meshBuilder.build(desc, params.gaussMapLimit, false, hullLib))
+	if(!meshBuilder.build(desc, gaussMapLimit, false, hullLib))
 		return false;
 
 	PxConvexMeshCookingResult::Enum result = PxConvexMeshCookingResult::eSUCCESS;
@@ -178,10 +189,9 @@ bool immediateCooking::cookConvexMesh(const PxCookingParams& params, const PxCon
 	return true;
 }
 
-PxConvexMesh* immediateCooking::createConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc_, PxInsertionCallback& insertionCallback, PxConvexMeshCookingResult::Enum* condition)
+// insertionLock is optional, used to serialize calls to the insertion callback when cooking from multiple threads
+static PxConvexMesh* createConvexMeshInternal(const PxCookingParams& params, const PxConvexMeshDesc& desc_, PxInsertionCallback& insertionCallback, PxConvexMeshCookingResult::Enum* condition, PxMutex* insertionLock)
 {
-	PX_FPU_GUARD;
-
 	// choose cooking library if needed
 	PxConvexMeshDesc desc = desc_;
 	ConvexHullLib* hullLib = createHullLib(desc, params);
@@ -200,7 +210,14 @@ PxConvexMesh* immediateCooking::createConvexMesh(const PxCookingParams& params,
 	meshBuilder.copy(meshData);
 
 	// insert into physics
-	PxConvexMesh* convexMesh = static_cast<PxConvexMesh*>(insertionCallback.buildObjectFromData(PxConcreteType::eCONVEX_MESH, &meshData));
+	PxConvexMesh* convexMesh;
+	if(insertionLock)
+	{
+		PxMutex::ScopedLock lock(*insertionLock);
+		convexMesh = static_cast<PxConvexMesh*>(insertionCallback.buildObjectFromData(PxConcreteType::eCONVEX_MESH, &meshData));
+	}
+	else
+		convexMesh = static_cast<PxConvexMesh*>(insertionCallback.buildObjectFromData(PxConcreteType::eCONVEX_MESH, &meshData));
 	if(!convexMesh)
 	{
 		if(condition)
@@ -213,6 +230,74 @@ PxConvexMesh* immediateCooking::createConvexMesh(const PxCookingParams& params,
 	return convexMesh;
 }
 
+PxConvexMesh* immediateCooking::createConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxInsertionCallback& insertionCallback, PxConvexMeshCookingResult::Enum* condition)
+{
+	PX_FPU_GUARD;
+
+	return createConvexMeshInternal(params, desc, insertionCallback, condition, NULL);
+}
+
+namespace
+{
+	// PT: small hulls only take a few dozen microseconds each, so we hand them out to threads in small groups
+	#define CONVEX_MESH_BATCH_SIZE	4
+
+	struct CreateConvexMeshesParams
+	{
+		const PxCookingParams*				mParams;
+		const PxConvexMeshDesc*				mDescs;
+		PxConvexMesh**						mMeshes;
+		PxConvexMeshCookingResult::Enum*	mConditions;
+		PxInsertionCallback*				mInsertionCallback;
+		PxMutex								mInsertionLock;
+		volatile PxI32						mNbCreated;
+
+		static void create(void* userData, PxU32 startIndex, PxU32 endIndex)
+		{
+			// PT: each thread needs its own FPU settings
+			PX_FPU_GUARD;
+
+			CreateConvexMeshesParams* params = reinterpret_cast<CreateConvexMeshesParams*>(userData);
+
+			PxI32 nbCreated = 0;
+			for(PxU32 i=startIndex;i<endIndex;i++)
+			{
+				PxConvexMeshCookingResult::Enum* condition = params->mConditions ? params->mConditions + i : NULL;
+				params->mMeshes[i] = createConvexMeshInternal(*params->mParams, params->mDescs[i], *params->mInsertionCallback, condition, &params->mInsertionLock);
+				if(params->mMeshes[i])
+					nbCreated++;
+			}
+
+			if(nbCreated)
+				PxAtomicAdd(&params->mNbCreated, nbCreated);
+		}
+	};
+}
+
+PxU32 immediateCooking::createConvexMeshes(const PxCookingParams& params, PxU32 nbMeshes, const PxConvexMeshDesc* descs, PxConvexMesh** meshes, PxInsertionCallback& insertionCallback, PxConvexMeshCookingResult::Enum* conditions)
+{
+	if(!nbMeshes)
+		return 0;
+
+	if(!descs || !meshes)
+	{
+		outputError<PxErrorCode::eINVALID_PARAMETER>(__LINE__, "Cooking::createConvexMeshes: NULL descriptors or meshes!");
+		return 0;
+	}
+
+	CreateConvexMeshesParams batchParams;
+	batchParams.mParams				= &params;
+	batchParams.mDescs				= descs;
+	batchParams.mMeshes				= meshes;
+	batchParams.mConditions			= conditions;
+	batchParams.mInsertionCallback	= &insertionCallback;
+	batchParams.mNbCreated			= 0;
+
+	Cm::parallelFor(params.cpuDispatcher, nbMeshes, CONVEX_MESH_BATCH_SIZE, CreateConvexMeshesParams::create, &batchParams);
+
+	return PxU32(batchParams.mNbCreated);
+}
+
 bool immediateCooking::validateConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc)
 {
 	ConvexMeshBuilder mesh(params.buildGPUData);
@@ -88,10 +88,8 @@ bool ConvexMeshBuilder::build(const PxConvexMeshDesc& desc, PxU32 gaussMapVertex
 	computeInternalObjects();
 //~TEST_INTERNAL_OBJECTS
 
-	if (desc.sdfDesc)
-	{
-		computeSDF(desc);
-	}
+	if (desc.sdfDesc && !computeSDF(desc))
+		return false;
 
 	return true;
 }
@@ -540,7 +538,7 @@ bool ConvexMeshBuilder::checkExtentRadiusRatio()
 	return mHullData.checkExtentRadiusRatio();
 }
 
-void ConvexMeshBuilder::computeSDF(const PxConvexMeshDesc& desc)
+bool ConvexMeshBuilder::computeSDF(const PxConvexMeshDesc& desc)
 {
 	PX_DELETE(mSdfData);
 	PX_NEW_SERIALIZED(mSdfData, SDF);
@@ -598,7 +596,8 @@ void ConvexMeshBuilder::computeSDF(const PxConvexMeshDesc& desc)
 	triDesc.flags &= (~PxMeshFlag::e16_BIT_INDICES);
 	triDesc.sdfDesc = desc.sdfDesc;
 
-	buildSDF(triDesc, sdfData, sdfDataSubgrids, sdfSubgridsStartSlots);
+	if (!buildSDF(triDesc, sdfData, sdfDataSubgrids, sdfSubgridsStartSlots))
+		return false;
 
 	PxSDFDesc& sdfDesc = *desc.sdfDesc;
 
@@ -622,5 +621,6 @@ void ConvexMeshBuilder::computeSDF(const PxConvexMeshDesc& desc)
 		immediateCooking::gatherStrided(sdfDesc.sdf.data, sdf, sdfDesc.dims.x * sdfDesc.dims.y * sdfDesc.dims.z, sizeof(PxReal), sdfDesc.sdf.stride);
 	}
 
+	return true;
 }
 //~TEST_INTERNAL_OBJECTS
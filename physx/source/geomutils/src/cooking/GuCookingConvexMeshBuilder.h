@@ -80,7 +80,7 @@ namespace physx
 
 //~TEST_INTERNAL_OBJECTS
 
-				void				computeSDF(const PxConvexMeshDesc& desc);
+				bool				computeSDF(const PxConvexMeshDesc& desc);
 
 				// set big convex data
 				void				setBigConvexData(BigConvexData* data) { mBigConvexData = data; }
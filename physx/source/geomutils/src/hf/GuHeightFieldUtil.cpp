@@ -33,9 +33,11 @@
 #include "GuHeightField.h"
 #include "GuEntityReport.h"
 #include "foundation/PxIntrinsics.h"
+#include "foundation/PxVecMath.h"
 #include "CmScaling.h"
 
 using namespace physx;
+using namespace aos;
 
 void Gu::HeightFieldUtil::computeLocalBounds(PxBounds3& bounds) const
 {
@@ -124,9 +126,52 @@ void Gu::HeightFieldUtil::overlapAABBTriangles(const PxBounds3& bounds, OverlapR
 	const PxReal maxy = localBounds.maximum.y;
 	const PxU32 columnStride = nbColumns - deltaColumn;
 
+	// PT: cells are culled 4 at a time. Heights are the low 16 bits of each sample, so we extract them with a shift pair
+	// from unaligned loads of 4 consecutive samples. Cell i of a block uses samples i and i+1 from the current and next
+	// rows, hence the second load shifted by one sample. A block only reads samples up to column+4 <= maxColumn, which
+	// is always a valid column. Surviving cells are reported in the same order as the scalar loop.
+	const PxHeightFieldSample* PX_RESTRICT samples = mHeightField->getData().samples;
+	const Vec4V minyV = V4Load(miny);
+	const Vec4V maxyV = V4Load(maxy);
+
 	for(PxU32 row=minRow; row<maxRow; row++)
 	{
-		for(PxU32 column=minColumn; column<maxColumn; column++)
+		PxU32 column = minColumn;
+		while(column+4<=maxColumn)
+		{
+			const PxHeightFieldSample* PX_RESTRICT s0 = samples + offset;
+			const PxHeightFieldSample* PX_RESTRICT s1 = s0 + nbColumns;
+
+			const Vec4V h00 = Vec4V_From_VecI32V(VecI32V_RightShift(VecI32V_LeftShift(I4LoadU(reinterpret_cast<const PxI32*>(s0)), 16), 16));
+			const Vec4V h01 = Vec4V_From_VecI32V(VecI32V_RightShift(VecI32V_LeftShift(I4LoadU(reinterpret_cast<const PxI32*>(s0+1)), 16), 16));
+			const Vec4V h10 = Vec4V_From_VecI32V(VecI32V_RightShift(VecI32V_LeftShift(I4LoadU(reinterpret_cast<const PxI32*>(s1)), 16), 16));
+			const Vec4V h11 = Vec4V_From_VecI32V(VecI32V_RightShift(VecI32V_LeftShift(I4LoadU(reinterpret_cast<const PxI32*>(s1+1)), 16), 16));
+
+			const Vec4V minH = V4Min(V4Min(h00, h01), V4Min(h10, h11));
+			const Vec4V maxH = V4Max(V4Max(h00, h01), V4Max(h10, h11));
+
+			// PT: same as "maxy < h0 && maxy < h1 && maxy < h2 && maxy < h3" (resp. miny >) in the scalar version
+			const PxU32 culled = BGetBitMask(BOr(V4IsGrtr(minH, maxyV), V4IsGrtr(minyV, maxH)));
+			if(culled!=0xf)
+			{
+				for(PxU32 i=0;i<4;i++)
+				{
+					if(culled & (1<<i))
+						continue;
+
+					const PxU32 cellOffset = offset + i;
+					if(!reportTriangle(callback, mHeightField->getMaterialIndex0(cellOffset), indexBuffer, bufferSize, indexBufferUsed, cellOffset << 1))
+						return;
+
+					if(!reportTriangle(callback, mHeightField->getMaterialIndex1(cellOffset), indexBuffer, bufferSize, indexBufferUsed, (cellOffset << 1) + 1))
+						return;
+				}
+			}
+			offset += 4;
+			column += 4;
+		}
+
+		for(; column<maxColumn; column++)
 		{
 			const PxReal h0 = mHeightField->getHeight(offset);
 			const PxReal h1 = mHeightField->getHeight(offset + 1);
@@ -227,3 +272,50 @@ PxU32 Gu::HeightFieldUtil::getTriangle(const PxTransform& pose, PxTriangle& worl
 	}
 	return PxU32(mHeightField->getTriangleMaterial(triangleIndex) != PxHeightFieldMaterial::eHOLE);
 }
+
+void Gu::HeightFieldUtil::getLocalTriangles(PxU32 nb, const PxU32* PX_RESTRICT triangleIndices, PxTriangle* PX_RESTRICT triangles, PxU32* PX_RESTRICT vertexIndices, PxU32* PX_RESTRICT adjacencyIndices) const
+{
+	// PT: same handedness logic as in getTriangle()
+	const bool wrongHanded = (mHfGeom->columnScale < 0.0f) != (mHfGeom->rowScale < 0.0f);
+	const PxU32 i1 = wrongHanded ? 2 : 1;
+	const PxU32 i2 = wrongHanded ? 1 : 2;
+	const PxU32 a0 = wrongHanded ? 2 : 0;
+	const PxU32 a2 = wrongHanded ? 0 : 2;
+
+	const PxReal rowScale = mHfGeom->rowScale;
+	const PxReal heightScale = mHfGeom->heightScale;
+	const PxReal columnScale = mHfGeom->columnScale;
+	const PxU32 nbColumns = mHeightField->getNbColumnsFast();
+
+	for(PxU32 i=0;i<nb;i++)
+	{
+		const PxU32 triangleIndex = triangleIndices[i];
+		PX_ASSERT(mHeightField->isValidTriangle(triangleIndex));
+
+		PxU32* PX_RESTRICT v = vertexIndices + i*3;
+		mHeightField->getTriangleVertexIndices(triangleIndex, v[0], v[i1], v[i2]);
+
+		if(adjacencyIndices)
+		{
+			PxU32* PX_RESTRICT adj = adjacencyIndices + i*3;
+			mHeightField->getTriangleAdjacencyIndices(triangleIndex, v[0], v[i1], v[i2], adj[a0], adj[1], adj[a2]);
+		}
+
+		// PT: all 3 vertices belong to the triangle's cell, so a single division gives the row & column of each of them.
+		// This replaces the per-vertex division/modulo in HeightField::getVertex().
+		const PxU32 cell = triangleIndex >> 1;
+		const PxU32 row = cell / nbColumns;
+		const PxU32 column = cell - row * nbColumns;
+
+		PxTriangle& tri = triangles[i];
+		for(PxU32 j=0;j<3;j++)
+		{
+			const PxU32 delta = v[j] - cell;
+			const PxU32 nextRow = PxU32(delta >= nbColumns);
+			const PxU32 nextColumn = delta - nextRow * nbColumns;
+			PX_ASSERT(nextColumn<=1);
+
+			tri.verts[j] = PxVec3(PxReal(row + nextRow) * rowScale, mHeightField->getHeight(v[j]) * heightScale, PxReal(column + nextColumn) * columnScale);
+		}
+	}
+}
@@ -114,6 +114,11 @@ namespace Gu
 
 		PxU32	getTriangle(const PxTransform&, PxTriangle& worldTri, PxU32* vertexIndices, PxU32* adjacencyIndices, PxTriangleID triangleIndex, bool worldSpaceTranslation=true, bool worldSpaceRotation=true) const;
 
+		// PT: batched version of getTriangle() for shape-space triangles (i.e. worldSpaceTranslation = worldSpaceRotation = false).
+		// Vertices are derived from the cell coordinates, computed once per triangle instead of once per vertex.
+		// vertexIndices must hold 3*nb entries. adjacencyIndices is optional, and must hold 3*nb entries when used.
+		void	getLocalTriangles(PxU32 nb, const PxU32* PX_RESTRICT triangleIndices, PxTriangle* PX_RESTRICT triangles, PxU32* PX_RESTRICT vertexIndices, PxU32* PX_RESTRICT adjacencyIndices) const;
+
 		void	overlapAABBTriangles(const PxBounds3& localBounds, OverlapReport& callback, PxU32 batchSize=HF_OVERLAP_REPORT_BUFFER_SIZE) const;
 
 		PX_FORCE_INLINE	void	overlapAABBTriangles0to1(const PxTransform& pose0to1, const PxBounds3& bounds0, OverlapReport& callback, PxU32 batchSize=HF_OVERLAP_REPORT_BUFFER_SIZE) const
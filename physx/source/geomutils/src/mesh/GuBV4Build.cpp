@@ -28,12 +28,15 @@
 
 #include "foundation/PxVec4.h"
 #include "foundation/PxMemory.h"
+#include "foundation/PxArray.h"
+#include "task/PxCpuDispatcher.h"
 #include "GuAABBTreeBuildStats.h"
 #include "GuAABBTree.h"
 #include "GuSAH.h"
 #include "GuBounds.h"
 #include "GuBV4Build.h"
 #include "GuBV4.h"
+#include "CmParallelFor.h"
 #include <stdio.h>
 
 using namespace physx;
@@ -267,6 +270,14 @@ static bool local_Subdivide_SAH(AABBTreeNode* PX_RESTRICT node, BuildStats& stat
 		return false;
 #endif
 
+	// PT: the sorters are temporally coherent, i.e. they start from the previous ranks when called with the same number
+	// of keys. That makes the order of equal keys (and thus the split) depend on whichever node was processed before,
+	// so we reset them to make each split only depend on the node's own primitives. This is what makes the output
+	// of the multithreaded build identical to the single-threaded one.
+	buffers.mSorters[0].invalidateRanks();
+	buffers.mSorters[1].invalidateRanks();
+	buffers.mSorters[2].invalidateRanks();
+
 	PxU32 leftCount;
 	if(!buffers.split(leftCount, nb, prims, boxes, centers))
 	{
@@ -325,26 +336,178 @@ static void local_BuildHierarchy_SAH(AABBTreeNode* PX_RESTRICT node, BuildStats&
 	}
 }
 
-bool BV4_AABBTree::buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStrategy strategy)
+namespace
+{
+	#define BV4_BUILD_BATCH_SIZE		16384
+	#define BV4_BUILD_MIN_SUBTREE_SIZE	4096
+
+	struct PrimitiveBoxesParams
+	{
+		SourceMeshBase*	mMesh;
+		PxBounds3*		mBoxes;
+		PxVec3*			mCenters;
+
+		static void compute(void* userData, PxU32 startIndex, PxU32 endIndex)
+		{
+			const PrimitiveBoxesParams* params = reinterpret_cast<const PrimitiveBoxesParams*>(userData);
+			SourceMeshBase& mesh = *params->mMesh;
+			PxBounds3* PX_RESTRICT boxes = params->mBoxes;
+			PxVec3* PX_RESTRICT centers = params->mCenters;
+
+			// PT: the safe stores write a bit past the current element, i.e. into the first element of the next batch,
+			// which might be processed by another thread. So the last element of each batch uses regular stores.
+			const PxU32 last = endIndex - 1;
+			const FloatV halfV = FLoad(0.5f);
+			for (PxU32 i = startIndex; i<last; i++)
+			{
+				Vec4V minV, maxV;
+				mesh.getPrimitiveBox(i, minV, maxV);
+
+				V4StoreU_Safe(minV, &boxes[i].minimum.x);	// PT: safe because 'maximum' follows 'minimum'
+				V4StoreU_Safe(maxV, &boxes[i].maximum.x);	// PT: safe because we're not the last element of the batch
+
+				const Vec4V centerV = V4Scale(V4Add(maxV, minV), halfV);
+				V4StoreU_Safe(centerV, &centers[i].x);	// PT: safe because we're not the last element of the batch
+			}
+
+			{
+				Vec4V minV, maxV;
+				mesh.getPrimitiveBox(last, minV, maxV);
+
+				PX_ALIGN(16, PxVec4) tmp;
+				V4StoreA(minV, &tmp.x);	boxes[last].minimum = tmp.getXYZ();
+				V4StoreA(maxV, &tmp.x);	boxes[last].maximum = tmp.getXYZ();
+				V4StoreA(V4Scale(V4Add(maxV, minV), halfV), &tmp.x);	centers[last] = tmp.getXYZ();
+			}
+		}
+	};
+
+	struct SubtreesParams
+	{
+		AABBTreeNode* const*	mRoots;
+		const PxU32*			mNodeOffsets;	// First pool entry available to each subtree
+		PxU32*					mNbUsedNodes;
+		const PxBounds3*		mBoxes;
+		const PxVec3*			mCenters;
+		AABBTreeNode*			mPool;
+		const SourceMesh*		mMesh;
+		PxU32					mLimit;
+		bool					mSAH;
+
+		static void build(void* userData, PxU32 startIndex, PxU32 endIndex)
+		{
+			const SubtreesParams* params = reinterpret_cast<const SubtreesParams*>(userData);
+			const BuildParams buildParams(params->mBoxes, params->mCenters, params->mPool, params->mLimit, params->mMesh);
+
+			for(PxU32 i=startIndex;i<endIndex;i++)
+			{
+				AABBTreeNode* root = params->mRoots[i];
+
+				BuildStats stats;
+				stats.setCount(params->mNodeOffsets[i]);
+
+				if(params->mSAH)
+				{
+					SAH_Buffers sah(root->mNbPrimitives);
+					local_BuildHierarchy_SAH(root, stats, buildParams, sah);
+				}
+				else
+					local_BuildHierarchy(root, stats, buildParams);
+
+				params->mNbUsedNodes[i] = stats.getCount() - params->mNodeOffsets[i];
+			}
+		}
+	};
+}
+
+// PT: builds the top of the tree down to nodes containing at most maxSubtreeSize primitives. These nodes are
+// not subdivided here: they are collected in 'subtrees' and built later in parallel.
+static void local_BuildTopHierarchy(AABBTreeNode* node, BuildStats& stats, const BuildParams& params, SAH_Buffers* buffers, PxU32 maxSubtreeSize, PxArray<AABBTreeNode*>& subtrees)
+{
+	if(node->mNbPrimitives<=maxSubtreeSize)
+	{
+		subtrees.pushBack(node);
+		return;
+	}
+
+	if(buffers ? local_Subdivide_SAH(node, stats, params, *buffers) : local_Subdivide(node, stats, params))
+	{
+		AABBTreeNode* pos = const_cast<AABBTreeNode*>(node->getPos());
+		AABBTreeNode* neg = const_cast<AABBTreeNode*>(node->getNeg());
+		local_BuildTopHierarchy(pos, stats, params, buffers, maxSubtreeSize, subtrees);
+		local_BuildTopHierarchy(neg, stats, params, buffers, maxSubtreeSize, subtrees);
+	}
+}
+
+// PT: multithreaded version of local_BuildHierarchy / local_BuildHierarchy_SAH. Each node is split the same way
+// as in the single-threaded version, only the location of nodes within the pool changes. The pool has room for
+// 2*N-1 nodes and a subtree with K primitives needs at most 2*K-2 nodes (its root is already allocated), so each
+// subtree gets its own range of the pool and can be built without synchronization. This leaves unused entries in
+// the pool but nothing iterates over it linearly: the tree is only accessed through the children pointers.
+static PxU32 local_BuildHierarchyMT(AABBTreeNode* root, const BuildParams& params, SAH_Buffers* buffers, PxU32 nbBoxes, PxCpuDispatcher* dispatcher)
+{
+	const PxU32 nbWorkers = dispatcher->getWorkerCount();
+	const PxU32 maxSubtreeSize = PxMax(PxU32(BV4_BUILD_MIN_SUBTREE_SIZE), nbBoxes/(nbWorkers*4));
+
+	BuildStats stats;
+	stats.setCount(1);
+
+	PxArray<AABBTreeNode*> subtrees;
+	local_BuildTopHierarchy(root, stats, params, buffers, maxSubtreeSize, subtrees);
+
+	const PxU32 nbSubtrees = subtrees.size();
+	if(!nbSubtrees)
+		return stats.getCount();
+
+	PxU32* nodeOffsets = PX_ALLOCATE(PxU32, nbSubtrees*2, "BV4 subtrees");
+	PxU32* nbUsedNodes = nodeOffsets + nbSubtrees;
+	PxU32 offset = stats.getCount();
+	for(PxU32 i=0;i<nbSubtrees;i++)
+	{
+		nodeOffsets[i] = offset;
+		offset += subtrees[i]->mNbPrimitives*2 - 2;
+	}
+	PX_ASSERT(offset<=nbBoxes*2-1);
+
+	SubtreesParams subtreesParams;
+	subtreesParams.mRoots		= subtrees.begin();
+	subtreesParams.mNodeOffsets	= nodeOffsets;
+	subtreesParams.mNbUsedNodes	= nbUsedNodes;
+	subtreesParams.mBoxes		= params.mBoxes;
+	subtreesParams.mCenters		= params.mCenters;
+	subtreesParams.mPool		= const_cast<AABBTreeNode*>(params.mNodeBase);
+	subtreesParams.mMesh		= params.mMesh;
+	subtreesParams.mLimit		= params.mLimit;
+	subtreesParams.mSAH			= buffers!=NULL;
+	Cm::parallelFor(dispatcher, nbSubtrees, 1, SubtreesParams::build, &subtreesParams);
+
+	PxU32 totalNbNodes = stats.getCount();
+	for(PxU32 i=0;i<nbSubtrees;i++)
+		totalNbNodes += nbUsedNodes[i];
+
+	PX_FREE(nodeOffsets);
+	return totalNbNodes;
+}
+
+bool BV4_AABBTree::buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStrategy strategy, PxCpuDispatcher* dispatcher)
 {
 	const PxU32 nbBoxes = mesh.getNbPrimitives();
 	if(!nbBoxes)
 		return false;
 	PxBounds3* boxes = PX_ALLOCATE(PxBounds3, (nbBoxes + 1), "BV4");	// PT: +1 to safely V4Load/V4Store the last element
 	PxVec3* centers = PX_ALLOCATE(PxVec3, (nbBoxes + 1), "BV4");		// PT: +1 to safely V4Load/V4Store the last element
-	const FloatV halfV = FLoad(0.5f);
-	for (PxU32 i = 0; i<nbBoxes; i++)
 	{
-		Vec4V minV, maxV;
-		mesh.getPrimitiveBox(i, minV, maxV);
-
-		V4StoreU_Safe(minV, &boxes[i].minimum.x);	// PT: safe because 'maximum' follows 'minimum'
-		V4StoreU_Safe(maxV, &boxes[i].maximum.x);	// PT: safe because we allocated one more box
-
-		const Vec4V centerV = V4Scale(V4Add(maxV, minV), halfV);
-		V4StoreU_Safe(centerV, &centers[i].x);	// PT: safe because we allocated one more PxVec3
+		PrimitiveBoxesParams params;
+		params.mMesh	= &mesh;
+		params.mBoxes	= boxes;
+		params.mCenters	= centers;
+		Cm::parallelFor(dispatcher, nbBoxes, BV4_BUILD_BATCH_SIZE, PrimitiveBoxesParams::compute, &params);
 	}
 
+	// PT: no need to go wide when there's a single subtree anyway
+	if(dispatcher && (!dispatcher->getWorkerCount() || nbBoxes<=BV4_BUILD_MIN_SUBTREE_SIZE))
+		dispatcher = NULL;
+
 	{
 		// Release previous tree
 		release();
@@ -378,12 +541,18 @@ bool BV4_AABBTree::buildFromMesh(SourceMeshBase& mesh, PxU32 limit, BV4_BuildStr
 				if(mesh.getMeshType()==SourceMeshBase::TRI_MESH)
 					triMesh = static_cast<SourceMesh*>(&mesh);
 			}
-			local_BuildHierarchy(mPool, Stats, BuildParams(boxes, centers, mPool, limit, triMesh));
+			if(dispatcher)
+				Stats.setCount(local_BuildHierarchyMT(mPool, BuildParams(boxes, centers, mPool, limit, triMesh), NULL, nbBoxes, dispatcher));
+			else
+				local_BuildHierarchy(mPool, Stats, BuildParams(boxes, centers, mPool, limit, triMesh));
 		}
 		else if(strategy==BV4_SAH)
 		{
 			SAH_Buffers sah(nbBoxes);
-			local_BuildHierarchy_SAH(mPool, Stats, BuildParams(boxes, centers, mPool, limit, NULL), sah);
+			if(dispatcher)
+				Stats.setCount(local_BuildHierarchyMT(mPool, BuildParams(boxes, centers, mPool, limit, NULL), &sah, nbBoxes, dispatcher));
+			else
+				local_BuildHierarchy_SAH(mPool, Stats, BuildParams(boxes, centers, mPool, limit, NULL), sah);
 		}
 		else
 			return false;
@@ -1820,7 +1989,7 @@ static bool gReorderCallback(const AABBTreeNode* current, PxU32 /*depth*/, void*
 	return true;
 }
 
-bool physx::Gu::BuildBV4Ex(BV4Tree& tree, SourceMeshBase& mesh, float epsilon, PxU32 nbPrimitivePerLeaf, bool quantized, BV4_BuildStrategy strategy)
+bool physx::Gu::BuildBV4Ex(BV4Tree& tree, SourceMeshBase& mesh, float epsilon, PxU32 nbPrimitivePerLeaf, bool quantized, BV4_BuildStrategy strategy, PxCpuDispatcher* dispatcher)
 {
 	//either number of triangle or number of tetrahedron
 	const PxU32 nbPrimitives = mesh.getNbPrimitives();
@@ -1828,7 +1997,7 @@ bool physx::Gu::BuildBV4Ex(BV4Tree& tree, SourceMeshBase& mesh, float epsilon, P
 	BV4_AABBTree Source;
 	{
 		GU_PROFILE_ZONE("..BuildBV4Ex_buildFromMesh")
-		if(!Source.buildFromMesh(mesh, nbPrimitivePerLeaf, strategy))
+		if(!Source.buildFromMesh(mesh, nbPrimitivePerLeaf, strategy, dispatcher))
 			return false;
 	}
 
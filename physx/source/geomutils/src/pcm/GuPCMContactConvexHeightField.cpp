@@ -76,6 +76,11 @@ struct PCMConvexVsHeightfieldContactGenerationCallback
 	{
 	}
 
+	// PT: we tried an SoA prefilter here, testing 4 cached triangles at a time against the hull's oriented bounds along
+	// the triangle normals (the first SAT axis in generateTriangleFullContactManifold). Results were identical but it was
+	// not worth it: it rejected 0.26% of the triangles for boxes resting on a 1024x1024 terrain (7.7% for random poses),
+	// the remaining SAT tests dominate, and timings were within noise. Revisit if the midphase starts returning more
+	// separated triangles.
 	template<PxU32 CacheSize>
 	void processTriangleCache(TriangleCache<CacheSize>& cache)
 	{
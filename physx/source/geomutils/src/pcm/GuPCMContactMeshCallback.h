@@ -133,26 +133,39 @@ public:
 		const PxU32 CacheSize = 16;
 		Gu::TriangleCache<CacheSize> cache;
 
-		const PxU32 nbPasses = (nb+(CacheSize-1))/CacheSize;
-		PxU32 nbTrigs = nb;
-		const PxU32* inds0 = indices;
+		// PT: triangles are extracted in batches: first the whole batch of touched triangles, then all their valid
+		// neighbors in a second batch. This replaces up to 4 calls to HeightFieldUtil::getTriangle() per triangle.
+		PxTriangle triangles[CacheSize];		// in heightfield shape space
+		PxU32 vertIndices[CacheSize*3];
+		PxU32 adjInds[CacheSize*3];
+		PxTriangle adjTriangles[CacheSize*3];
+		PxU32 adjTriangleIndices[CacheSize*3];
+		PxU32 adjVertIndices[CacheSize*3*3];
 
 		const PxU8 nextInd[] = {2,0,1};
 
-		for(PxU32 i = 0; i < nbPasses; ++i)
+		while(nb)
 		{
-			cache.mNumTriangles = 0;
-			PxU32 trigCount = PxMin(nbTrigs, CacheSize);
-			nbTrigs -= trigCount;
-			while(trigCount--)
-			{
-				PxU32 triangleIndex = *(inds0++);
-				PxU32 vertIndices[3];
+			const PxU32 trigCount = PxMin(nb, CacheSize);
+			nb -= trigCount;
 
-				PxTriangle currentTriangle;	// in world space
+			mHfUtil.getLocalTriangles(trigCount, indices, triangles, vertIndices, adjInds);
+
+			PxU32 nbAdj = 0;
+			for(PxU32 a=0; a<trigCount*3; a++)
+			{
+				if(adjInds[a] != 0xFFFFFFFF)
+					adjTriangleIndices[nbAdj++] = adjInds[a];
+			}
+			mHfUtil.getLocalTriangles(nbAdj, adjTriangleIndices, adjTriangles, adjVertIndices, NULL);
 
-				PxU32 adjInds[3];
-				mHfUtil.getTriangle(mHeightfieldTransform, currentTriangle, vertIndices, adjInds, triangleIndex, false, false);
+			cache.mNumTriangles = 0;
+			PxU32 adjIndex = 0;
+			for(PxU32 t=0; t<trigCount; t++)
+			{
+				const PxTriangle& currentTriangle = triangles[t];
+				const PxU32* currentVertIndices = vertIndices + t*3;
+				const PxU32* currentAdjInds = adjInds + t*3;
 
 				PxVec3 normal;
 				currentTriangle.normal(normal);
@@ -161,15 +174,16 @@ public:
 
 				for(PxU32 a = 0; a < 3; ++a)
 				{
-					if (adjInds[a] != 0xFFFFFFFF)
+					if (currentAdjInds[a] != 0xFFFFFFFF)
 					{
-						PxTriangle adjTri;
-						PxU32 inds[3];
-						mHfUtil.getTriangle(mHeightfieldTransform, adjTri, inds, NULL, adjInds[a], false, false);
+						const PxTriangle& adjTri = adjTriangles[adjIndex];
+						const PxU32* inds = adjVertIndices + adjIndex*3;
+						adjIndex++;
+						PX_UNUSED(inds);
 						//We now compare the triangles to see if this edge is active
 
-						PX_ASSERT(inds[0] == vertIndices[a] || inds[1] == vertIndices[a] || inds[2] == vertIndices[a]);
-						PX_ASSERT(inds[0] == vertIndices[(a + 1) % 3] || inds[1] == vertIndices[(a + 1) % 3] || inds[2] == vertIndices[(a + 1) % 3]);
+						PX_ASSERT(inds[0] == currentVertIndices[a] || inds[1] == currentVertIndices[a] || inds[2] == currentVertIndices[a]);
+						PX_ASSERT(inds[0] == currentVertIndices[(a + 1) % 3] || inds[1] == currentVertIndices[(a + 1) % 3] || inds[2] == currentVertIndices[(a + 1) % 3]);
 
 						PxVec3 adjNormal;
 						adjTri.denormalizedNormal(adjNormal);
@@ -196,10 +210,13 @@ public:
 						triFlags |= (1 << a); //Mark as silhouette edge
 				}
 
-				cache.addTriangle(currentTriangle.verts, vertIndices, triangleIndex, triFlags);
+				cache.addTriangle(currentTriangle.verts, currentVertIndices, indices[t], triFlags);
 			}
+			PX_ASSERT(adjIndex == nbAdj);
 			PX_ASSERT(cache.mNumTriangles <= 16);
 
+			indices += trigCount;
+
 			(static_cast<Derived*>(this))->template processTriangleCache< CacheSize >(cache);
 		}
 		return true;
@@ -1786,6 +1786,8 @@ namespace
 		virtual	bool						removeRegion(PxU32 handle)																										PX_OVERRIDE	PX_FINAL;
 		virtual	PxU32						getNbOutOfBoundsObjects()																								const	PX_OVERRIDE	PX_FINAL;
 		virtual	const PxU32*				getOutOfBoundsObjects()																									const	PX_OVERRIDE	PX_FINAL;
+		virtual	bool						setAutoRegions(const PxBroadPhaseAutoRegionParams* params)																		PX_OVERRIDE	PX_FINAL;
+		virtual	bool						getAutoRegionStats(PxBroadPhaseAutoRegionStats& stats)																	const	PX_OVERRIDE	PX_FINAL;
 		//~PxBroadPhaseRegions
 
 				Bp::BroadPhase*				mBroadPhase;
@@ -2009,6 +2011,18 @@ const PxU32* ImmCPUBP::getOutOfBoundsObjects()	const
 	return mBroadPhase->getOutOfBoundsObjects();
 }
 
+bool ImmCPUBP::setAutoRegions(const PxBroadPhaseAutoRegionParams* params)
+{
+	PX_ASSERT(mBroadPhase);
+	return mBroadPhase->setAutoRegions(params);
+}
+
+bool ImmCPUBP::getAutoRegionStats(PxBroadPhaseAutoRegionStats& stats)	const
+{
+	PX_ASSERT(mBroadPhase);
+	return mBroadPhase->getAutoRegionStats(stats);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 #if PX_SUPPORT_GPU_PHYSX
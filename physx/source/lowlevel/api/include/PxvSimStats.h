@@ -97,6 +97,9 @@ struct PxvSimStats
 	PxU32	mTotalCompressedContactSize;
 	PxU32	mTotalConstraintSize;
 	PxU32	mPeakConstraintBlockAllocations;
+	PxU32	mNbContactDataBlocksAllocated;
+	PxU32	mPeakContactDataBlocksUsed;
+	PxU32	mNbReducedContactPairs;
 
 	PxU32	mNbNewPairs;
 	PxU32	mNbLostPairs;
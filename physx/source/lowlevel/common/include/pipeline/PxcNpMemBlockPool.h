@@ -55,14 +55,24 @@ public:
 	PxcNpMemBlockPool(PxcScratchAllocator& allocator);
 	~PxcNpMemBlockPool();
 
-	void			init(PxU32 initial16KDataBlocks, PxU32 maxBlocks);
+	void			init(PxU32 initial16KDataBlocks, PxU32 maxBlocks, PxU32 idleFrames = 0, bool reduceContactsOnLowMemory = false);
 	void			flush();
 	void			setBlockCount(PxU32 count);
 	PxU32			getUsedBlockCount() const;
 	PxU32			getMaxUsedBlockCount() const;
 	PxU32			getPeakConstraintBlockCount() const;
+	PxU32			getAllocatedBlockCount() const;
+	PxU32			getFramePeakUsedBlockCount() const;
 	void			releaseUnusedBlocks();
 
+	// Called once per frame, after all streams have been released. Updates the per-frame statistics and releases the
+	// blocks that have not been needed for the last 'idleFrames' frames.
+	void			endFrame();
+
+	// True when the number of used blocks gets close to the max number of blocks, and the pool has been configured to
+	// reduce contacts in that case. Read without locking: this is only a hint for contact generation.
+	PX_FORCE_INLINE	bool	isLowOnMemory()	const	{ return mLowOnMemory;	}
+
 	PxcNpMemBlock*	acquireConstraintBlock();
 	PxcNpMemBlock*	acquireConstraintBlock(PxcNpMemBlockArray& memBlocks);
 	PxcNpMemBlock*	acquireContactBlock();
@@ -108,6 +118,17 @@ private:
 	PxU32					mPeakConstraintAllocations;
 	PxU32					mConstraintAllocations;
 
+	PxU32					mIdleFrames;			// number of frames after which unused blocks are released, 0 to disable
+	PxU32					mNbFramesSinceTrim;
+	PxU32					mFramePeakUsedBlocks;	// peak number of used blocks for the current frame
+	PxU32					mLastFramePeakUsedBlocks;
+	PxU32					mTrimPeakUsedBlocks;	// peak number of used blocks since the last time blocks were released
+	PxU32					mLowMemoryThreshold;	// number of used blocks above which we're low on memory
+	bool					mReduceContactsOnLowMemory;
+	volatile bool			mLowOnMemory;
+
+	PX_FORCE_INLINE	void	updateUsedBlocks(PxU32 usedBlocks);
+
 	PxcNpMemBlock*	acquire(PxcNpMemBlockArray& trackingArray, PxU32* allocationCount = NULL, PxU32* peakAllocationCount = NULL, bool isScratchAllocation = false);
 	void			release(PxcNpMemBlockArray& deadArray, PxU32* allocationCount = NULL);
 };
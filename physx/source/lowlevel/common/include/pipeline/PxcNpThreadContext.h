@@ -173,6 +173,7 @@ public:
 					PxU32						mCompressedCacheSize;
 					PxU32						mNbDiscreteContactPairsWithCacheHits;
 					PxU32						mNbDiscreteContactPairsWithContacts;
+					PxU32						mNbReducedContactPairs;
 #else
 					PX_CATCH_UNDEFINED_ENABLE_SIM_STATS
 #endif
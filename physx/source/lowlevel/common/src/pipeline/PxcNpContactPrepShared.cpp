@@ -73,14 +73,28 @@ struct StridePatch
 	bool isRoot;
 };
 
-PxU32 physx::writeCompressedContact(const PxContactPoint* const PX_RESTRICT contactPoints, const PxU32 numContactPoints, PxcNpThreadContext* threadContext,
+// PT: returns the number of contacts in the first patch, i.e. the leading contacts sharing the first contact's normal and materials
+static PxU32 getFirstPatchSize(const PxContactPoint* const PX_RESTRICT contactPoints, const PxU32 numContactPoints, const PxsMaterialInfo* PX_RESTRICT pMaterial)
+{
+	const PxVec3& normal = contactPoints[0].normal;
+	const PxU16 mat0 = pMaterial[0].mMaterialIndex0;
+	const PxU16 mat1 = pMaterial[0].mMaterialIndex1;
+
+	PxU32 nb = 1;
+	while(nb<numContactPoints && normal.dot(contactPoints[nb].normal) >= PXC_SAME_NORMAL
+		&& pMaterial[nb].mMaterialIndex0 == mat0 && pMaterial[nb].mMaterialIndex1 == mat1)
+		nb++;
+	return nb;
+}
+
+PxU32 physx::writeCompressedContact(const PxContactPoint* const PX_RESTRICT contactPoints, const PxU32 numContactPoints_, PxcNpThreadContext* threadContext,
 									PxU16& writtenContactCount, PxU8*& outContactPatches, PxU8*& outContactPoints, PxU16& compressedContactSize, PxReal*& outContactForces, PxU32 contactForceByteSize,
 									PxU8*& outFrictionPatches, PxcDataStreamPool* frictionPatchesStreamPool,
 									const PxsMaterialManager* materialManager, bool hasModifiableContacts, bool forceNoResponse, const PxsMaterialInfo* PX_RESTRICT pMaterial, PxU8& numPatches,
 									PxU32 additionalHeaderSize, PxsConstraintBlockManager* manager, PxcConstraintBlockStream* blockStream, bool insertAveragePoint,
 									PxcDataStreamPool* contactStreamPool, PxcDataStreamPool* patchStreamPool, PxcDataStreamPool* forceStreamPool, const bool isMeshType)
 {
-	if(numContactPoints == 0)
+	if(numContactPoints_ == 0)
 	{
 		writtenContactCount = 0;
 		outContactPatches = NULL;
@@ -92,6 +106,21 @@ PxU32 physx::writeCompressedContact(const PxContactPoint* const PX_RESTRICT cont
 		return 0;
 	}
 
+	PxU32 numContactPoints = numContactPoints_;
+
+	// PT: when the contact data blocks are about to run out, we only keep the first patch of the pair. This is better than
+	// dropping all contacts of the pairs processed after the blocks are exhausted.
+	if(threadContext && !contactStreamPool && threadContext->mContactBlockStream.getMemBlockPool().isLowOnMemory())
+	{
+		numContactPoints = getFirstPatchSize(contactPoints, numContactPoints, pMaterial);
+#if PX_ENABLE_SIM_STATS
+		if(numContactPoints != numContactPoints_)
+			threadContext->mNbReducedContactPairs++;
+#else
+		PX_CATCH_UNDEFINED_ENABLE_SIM_STATS
+#endif
+	}
+
 	//Calculate the size of the contact buffer...
 	PX_ALLOCA(strPatches, StridePatch, numContactPoints);
 
@@ -276,12 +305,12 @@ PxU32 physx::writeCompressedContact(const PxContactPoint* const PX_RESTRICT cont
 			if(data)
 			{
 				PxMemZero(forceData, contactForceByteSize);
-			}
 
-			if (frictionPatchesSize)
-			{
-				frictionPatchesData = data + alignedRequiredSize + contactForceByteSize;
-				PxMemZero(frictionPatchesData, frictionPatchesSize);
+				if (frictionPatchesSize)
+				{
+					frictionPatchesData = data + alignedRequiredSize + contactForceByteSize;
+					PxMemZero(frictionPatchesData, frictionPatchesSize);
+				}
 			}
 		}
 
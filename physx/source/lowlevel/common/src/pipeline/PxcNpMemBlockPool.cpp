@@ -50,14 +50,27 @@ PxcNpMemBlockPool::PxcNpMemBlockPool(PxcScratchAllocator& allocator) :
 	mNbScratchBlocks(0),
 	mScratchAllocator(allocator),
 	mPeakConstraintAllocations(0),
-	mConstraintAllocations(0)  
+	mConstraintAllocations(0),
+	mIdleFrames(0),
+	mNbFramesSinceTrim(0),
+	mFramePeakUsedBlocks(0),
+	mLastFramePeakUsedBlocks(0),
+	mTrimPeakUsedBlocks(0),
+	mLowMemoryThreshold(0),
+	mReduceContactsOnLowMemory(false),
+	mLowOnMemory(false)
 {
 }
 
-void PxcNpMemBlockPool::init(PxU32 initialBlockCount, PxU32 maxBlocks)
+void PxcNpMemBlockPool::init(PxU32 initialBlockCount, PxU32 maxBlocks, PxU32 idleFrames, bool reduceContactsOnLowMemory)
 {
 	mMaxBlocks = maxBlocks;
 	mInitialBlocks = initialBlockCount;
+	mIdleFrames = idleFrames;
+	mReduceContactsOnLowMemory = reduceContactsOnLowMemory;
+	// PT: we start reducing contacts when less than 1/8 of the blocks are left. This leaves enough room for the friction,
+	// constraint and cache streams, which cannot be reduced.
+	mLowMemoryThreshold = maxBlocks - maxBlocks/8;
 
 	PxU32 reserve = PxMax<PxU32>(initialBlockCount, 64);
 
@@ -88,6 +101,50 @@ PxU32 PxcNpMemBlockPool::getPeakConstraintBlockCount() const
 	return mPeakConstraintAllocations;
 }
 
+PxU32 PxcNpMemBlockPool::getAllocatedBlockCount() const
+{
+	return mAllocatedBlocks;
+}
+
+PxU32 PxcNpMemBlockPool::getFramePeakUsedBlockCount() const
+{
+	return mLastFramePeakUsedBlocks;
+}
+
+PX_FORCE_INLINE void PxcNpMemBlockPool::updateUsedBlocks(PxU32 usedBlocks)
+{
+	// PT: called with the lock held
+	mUsedBlocks = usedBlocks;
+	mMaxUsedBlocks = PxMax<PxU32>(usedBlocks, mMaxUsedBlocks);
+	mFramePeakUsedBlocks = PxMax<PxU32>(usedBlocks, mFramePeakUsedBlocks);
+	mLowOnMemory = mReduceContactsOnLowMemory && usedBlocks >= mLowMemoryThreshold;
+}
+
+void PxcNpMemBlockPool::endFrame()
+{
+	PxMutex::ScopedLock lock(mLock);
+
+	mLastFramePeakUsedBlocks = mFramePeakUsedBlocks;
+	mTrimPeakUsedBlocks = PxMax<PxU32>(mTrimPeakUsedBlocks, mFramePeakUsedBlocks);
+	// PT: blocks still in use (e.g. cached contacts kept for next frame) count for the next frame's peak
+	mFramePeakUsedBlocks = mUsedBlocks;
+
+	if(!mIdleFrames || ++mNbFramesSinceTrim<mIdleFrames)
+		return;
+
+	// PT: release the blocks that were not needed during the whole period, but keep the initial blocks
+	const PxU32 targetCount = PxMax<PxU32>(mTrimPeakUsedBlocks, mInitialBlocks);
+	while(mAllocatedBlocks>targetCount && mUnused.size())
+	{
+		PxcNpMemBlock* ptr = mUnused.popBack();
+		PX_FREE(ptr);
+		mAllocatedBlocks--;
+	}
+
+	mNbFramesSinceTrim = 0;
+	mTrimPeakUsedBlocks = 0;
+}
+
 void PxcNpMemBlockPool::setBlockCount(PxU32 blockCount)
 {
 	PxMutex::ScopedLock lock(mLock);
@@ -158,7 +215,7 @@ void PxcNpMemBlockPool::releaseConstraintMemory()
 		{
 			mUnused.pushBack(block);
 			PX_ASSERT(mUsedBlocks>0);
-			mUsedBlocks--;
+			updateUsedBlocks(mUsedBlocks-1);
 		}
 	}
 
@@ -201,8 +258,7 @@ PxcNpMemBlock* PxcNpMemBlockPool::acquire(PxcNpMemBlockArray& trackingArray, PxU
 	{
 		PxcNpMemBlock* block = mUnused.popBack();
 		trackingArray.pushBack(block);
-		mMaxUsedBlocks = PxMax<PxU32>(mUsedBlocks+1, mMaxUsedBlocks);
-		mUsedBlocks++;
+		updateUsedBlocks(mUsedBlocks+1);
 		return block;
 	}	
 
@@ -231,8 +287,7 @@ PxcNpMemBlock* PxcNpMemBlockPool::acquire(PxcNpMemBlockArray& trackingArray, PxU
 	if(block)
 	{
 		trackingArray.pushBack(block);
-		mMaxUsedBlocks = PxMax<PxU32>(mUsedBlocks+1, mMaxUsedBlocks);
-		mUsedBlocks++;
+		updateUsedBlocks(mUsedBlocks+1);
 	}
 	else
 		mAllocatedBlocks--;
@@ -255,7 +310,7 @@ void PxcNpMemBlockPool::release(PxcNpMemBlockArray& deadArray, PxU32* allocation
 {
 	PxMutex::ScopedLock lock(mLock);
 	PX_ASSERT(mUsedBlocks >= deadArray.size());
-	mUsedBlocks -= deadArray.size();
+	updateUsedBlocks(mUsedBlocks - deadArray.size());
 	if(allocationCount)
 	{
 		*allocationCount -= deadArray.size();
@@ -311,7 +366,7 @@ void PxcNpMemBlockPool::releaseConstraintBlocks(PxcNpMemBlockArray& memBlocks)
 		{
 			mUnused.pushBack(block);
 			PX_ASSERT(mUsedBlocks>0);
-			mUsedBlocks--;
+			updateUsedBlocks(mUsedBlocks-1);
 		}
 	}
 }
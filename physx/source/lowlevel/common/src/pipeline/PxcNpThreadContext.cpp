@@ -43,6 +43,7 @@ PxcNpThreadContext::PxcNpThreadContext(PxcNpContext* params) :
 	mCompressedCacheSize				(0),
 	mNbDiscreteContactPairsWithCacheHits(0),
 	mNbDiscreteContactPairsWithContacts	(0),
+	mNbReducedContactPairs				(0),
 #else
 	PX_CATCH_UNDEFINED_ENABLE_SIM_STATS
 #endif
@@ -74,6 +75,7 @@ void PxcNpThreadContext::clearStats()
 	mCompressedCacheSize					= 0;
 	mNbDiscreteContactPairsWithCacheHits	= 0;
 	mNbDiscreteContactPairsWithContacts		= 0;
+	mNbReducedContactPairs					= 0;
 }
 #else
 	PX_CATCH_UNDEFINED_ENABLE_SIM_STATS
@@ -74,7 +74,8 @@ PxsContext::PxsContext(const PxSceneDesc& desc, PxTaskManager* taskManager, Cm::
 
 	PxMemZero(mVisualizationParams, sizeof(PxReal) * PxVisualizationParameter::eNUM_VALUES);
 
-	mNpMemBlockPool.init(desc.nbContactDataBlocks, desc.maxNbContactDataBlocks);
+	mNpMemBlockPool.init(desc.nbContactDataBlocks, desc.maxNbContactDataBlocks, desc.contactDataBlockIdleFrames,
+		desc.flags & PxSceneFlag::eREDUCE_CONTACTS_ON_LOW_MEMORY);
 }
 
 PxsContext::~PxsContext()
@@ -463,6 +464,7 @@ void PxsContext::mergeCMDiscreteUpdateResults(PxBaseTask* /*continuation*/)
 		mSimStats.mNbDiscreteContactPairsWithContacts += threadContext->mNbDiscreteContactPairsWithContacts;
 
 		mSimStats.mTotalCompressedContactSize += threadContext->mCompressedCacheSize;
+		mSimStats.mNbReducedContactPairs += threadContext->mNbReducedContactPairs;
 		//KS - this data is not available yet
 		//mSimStats.mTotalConstraintSize += threadContext->mConstraintSize;
 		threadContext->clearStats();
@@ -49,7 +49,9 @@ BroadPhase* BroadPhase::create(
 	else if(bpType==PxBroadPhaseType::eMBP)
 		return PX_NEW(BroadPhaseMBP)(maxNbRegions, maxNbBroadPhaseOverlaps, maxNbStaticShapes, maxNbDynamicShapes, contextID);
 	else if(bpType==PxBroadPhaseType::eSAP)
-		return PX_NEW(BroadPhaseSap)(maxNbBroadPhaseOverlaps, maxNbStaticShapes, maxNbDynamicShapes, contextID);
+		return PX_NEW(BroadPhaseSap)(maxNbBroadPhaseOverlaps, maxNbStaticShapes, maxNbDynamicShapes, contextID, false);
+	else if(bpType==PxBroadPhaseType::ePSAP)
+		return PX_NEW(BroadPhaseSap)(maxNbBroadPhaseOverlaps, maxNbStaticShapes, maxNbDynamicShapes, contextID, true);
 	else
 	{
 		PX_ASSERT(0);
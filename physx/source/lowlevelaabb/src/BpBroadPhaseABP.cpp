@@ -59,6 +59,9 @@ PT: to try:
 */
 
 #define ABP_MT
+// PT: sorts updated boxes with the multithreaded radix sort. Disabled for now: the extra count pass makes it ~1.4x slower
+// when the workers share a core, and the multi-core speedup has not been measured yet.
+//#define ABP_MT_RADIX_SORT
 
 #define CHECKPOINT(x)
 //#include <stdio.h>
@@ -988,7 +991,7 @@ void ABP_SharedData::resize(BpHandle userID)
 						void				removeObject(ABPEntry& object, BpHandle userID);
 						void				updateObject(ABPEntry& object, BpHandle userID);
 
-						void				prepareData(RadixSortBuffered& rs, ABP_Object* PX_RESTRICT objects, PxU32 objectsCapacity, ABP_MM& memoryManager, PxU64 contextID);
+						void				prepareData(RadixSortBuffered& rs, ABP_Object* PX_RESTRICT objects, PxU32 objectsCapacity, ABP_MM& memoryManager, PxCpuDispatcher* dispatcher, PxU64 contextID);
 
 //		PX_FORCE_INLINE	PxU32				isThereWorkToDo()		const	{ return mNbUpdated;	}
 		PX_FORCE_INLINE	bool				isThereWorkToDo()		const	{ return mNbUpdated || mNbRemovedSleeping;	}	// PT: temp & test, maybe we do that differently in the end
@@ -1341,7 +1344,7 @@ static PX_FORCE_INLINE PosXType2 getNextCandidateNonSorted(PxU32 offsetNonSorted
 }
 
 PX_COMPILE_TIME_ASSERT(sizeof(BpHandle)==sizeof(float));
-void BoxManager::prepareData(RadixSortBuffered& /*rs*/, ABP_Object* PX_RESTRICT objects, PxU32 objectsCapacity, ABP_MM& memoryManager, PxU64 contextID)
+void BoxManager::prepareData(RadixSortBuffered& /*rs*/, ABP_Object* PX_RESTRICT objects, PxU32 objectsCapacity, ABP_MM& memoryManager, PxCpuDispatcher* dispatcher, PxU64 contextID)
 {
 	PX_UNUSED(contextID);
 
@@ -1663,7 +1666,7 @@ void BoxManager::prepareData(RadixSortBuffered& /*rs*/, ABP_Object* PX_RESTRICT
 		const PxU32* sorted;
 		{
 			PX_PROFILE_ZONE("Sort", contextID);
-			sorted = rs.Sort(keys, nbUpdated).GetRanks();
+			sorted = rs.Sort(keys, nbUpdated, dispatcher).GetRanks();
 		}
 
 		// PT:
@@ -1929,7 +1932,7 @@ static PX_FORCE_INLINE void outputPair(PairManagerMT& pairManager, PxU32 index0,
 
 						void					setTransientData(const PxBounds3* bounds, const PxReal* contactDistance);
 
-						void					Region_prepareOverlaps();
+						void					Region_prepareOverlaps(PxCpuDispatcher* dispatcher);
 
 						ABP_MM					mMM;
 						BoxManager				mSBM;
@@ -3397,7 +3400,7 @@ static void doCompleteBoxPruning_(
 	}
 }
 
-void ABP::Region_prepareOverlaps()
+void ABP::Region_prepareOverlaps(PxCpuDispatcher* dispatcher)
 {
 	PX_PROFILE_ZONE("ABP - Region_prepareOverlaps", mContextID);
 
@@ -3407,11 +3410,15 @@ void ABP::Region_prepareOverlaps()
 		)
 		return;
 
+#ifndef ABP_MT_RADIX_SORT
+	dispatcher = NULL;
+#endif
+
 	if(mSBM.isThereWorkToDo())
-		mSBM.prepareData(mRS, mShared.mABP_Objects, mShared.mABP_Objects_Capacity, mMM, mContextID);
+		mSBM.prepareData(mRS, mShared.mABP_Objects, mShared.mABP_Objects_Capacity, mMM, dispatcher, mContextID);
 
-	mDBM.prepareData(mRS, mShared.mABP_Objects, mShared.mABP_Objects_Capacity, mMM, mContextID);
-	mKBM.prepareData(mRS, mShared.mABP_Objects, mShared.mABP_Objects_Capacity, mMM, mContextID);
+	mDBM.prepareData(mRS, mShared.mABP_Objects, mShared.mABP_Objects_Capacity, mMM, dispatcher, mContextID);
+	mKBM.prepareData(mRS, mShared.mABP_Objects, mShared.mABP_Objects_Capacity, mMM, dispatcher, mContextID);
 
 	mRS.reset();
 }
@@ -3788,7 +3795,7 @@ void ABP::findOverlaps(PxBaseTask* continuation, const Bp::FilterGroup::Enum* PX
 	mPairManager.mLUT = lut;
 
 	if(!gPrepareOverlapsFlag)
-		Region_prepareOverlaps();
+		Region_prepareOverlaps(continuation ? continuation->getTaskManager()->getCpuDispatcher() : NULL);
 
 	bool doKineKine = true;
 	bool doStaticKine = true;
@@ -4065,7 +4072,7 @@ void BroadPhaseABP::update(PxcScratchAllocator* scratchAllocator, const BroadPha
 			PX_ASSERT(!mDeleted.size());
 
 			if(gPrepareOverlapsFlag)
-				mABP->Region_prepareOverlaps();
+				mABP->Region_prepareOverlaps(continuation ? continuation->getTaskManager()->getCpuDispatcher() : NULL);
 		}
 
 		{
@@ -4100,7 +4107,7 @@ void ABP_InternalTask::run()
 			PX_ASSERT(!mBP->mDeleted.size());
 
 			if(gPrepareOverlapsFlag)
-				abp->Region_prepareOverlaps();
+				abp->Region_prepareOverlaps(getTaskManager()->getCpuDispatcher());
 		}
 
 		{
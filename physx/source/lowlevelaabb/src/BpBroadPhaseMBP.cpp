@@ -33,6 +33,7 @@
 #include "foundation/PxMemory.h"
 #include "foundation/PxBitUtils.h"
 #include "foundation/PxHashSet.h"
+#include "foundation/PxHashMap.h"
 #include "common/PxProfileZone.h"
 #include "CmRadixSort.h"
 #include "CmUtils.h"
@@ -498,8 +499,10 @@ struct RegionData : public PxUserAllocated
 						void				reset();
 						void				freeBuffers();
 
-						PxU32				addRegion(const PxBroadPhaseRegion& region, bool populateRegion, const PxBounds3* boundsArray, const PxReal* contactDistance);
+						PxU32				addRegion(const PxBroadPhaseRegion& region, bool populateRegion, const PxBounds3* boundsArray, const PxReal* contactDistance, bool markUpdated=true);
 						bool				removeRegion(PxU32 handle);
+						bool				replaceRegions(const PxU32* oldHandles, PxU32 nbOld, const PxBounds3* newBounds, PxU32 nbNew, PxU32* newHandles);
+						PxU32				getNbActiveRegions()	const;
 						const Region*		getRegion(PxU32 i)		const;
 		PX_FORCE_INLINE	PxU32				getNbRegions()			const	{ return mNbRegions;	}
 
@@ -507,7 +510,7 @@ struct RegionData : public PxUserAllocated
 						bool				removeObject(MBP_Handle handle);
 						bool				updateObject(MBP_Handle handle, const MBP_AABB& box);
 						bool				updateObjectAfterRegionRemoval(MBP_Handle handle, Region* removedRegion);
-						bool				updateObjectAfterNewRegionAdded(MBP_Handle handle, const MBP_AABB& box, Region* addedRegion, PxU32 regionIndex);
+						bool				updateObjectAfterNewRegionAdded(MBP_Handle handle, const MBP_AABB& box, Region* addedRegion, PxU32 regionIndex, bool markUpdated);
 						void				prepareOverlaps();
 						void				findOverlaps(const Bp::FilterGroup::Enum* PX_RESTRICT groups, const bool* PX_RESTRICT lut);
 						PxU32				finalize(BroadPhaseMBP* mbp);
@@ -535,7 +538,7 @@ struct RegionData : public PxUserAllocated
 #ifdef USE_FULLY_INSIDE_FLAG
 						BitArray			mFullyInsideBitmap;	// Indexed by MBP_ObjectIndex
 #endif
-						void				populateNewRegion(const MBP_AABB& box, Region* addedRegion, PxU32 regionIndex, const PxBounds3* boundsArray, const PxReal* contactDistance);
+						void				populateNewRegion(const MBP_AABB& box, Region* addedRegion, PxU32 regionIndex, const PxBounds3* boundsArray, const PxReal* contactDistance, bool markUpdated);
 
 #ifdef MBP_REGION_BOX_PRUNING
 						void				buildRegionData();
@@ -1880,7 +1883,7 @@ void MBP::populateNewRegion(const MBP_AABB& box, Region* addedRegion, PxU32 regi
 		if(bounds.intersect(box))
 		{
 //			updateObject(mbpHandle, bounds);
-			updateObjectAfterNewRegionAdded(mbpHandle, bounds, addedRegion, regionIndex);
+			updateObjectAfterNewRegionAdded(mbpHandle, bounds, addedRegion, regionIndex, true);
 #ifdef PRINT_STATS
 			nbObjectsFound++;
 #endif
@@ -1907,7 +1910,7 @@ void MBP::populateNewRegion(const MBP_AABB& box, Region* addedRegion, PxU32 regi
 		return retval;
 	}*/
 
-void MBP::populateNewRegion(const MBP_AABB& box, Region* addedRegion, PxU32 regionIndex, const PxBounds3* boundsArray, const PxReal* contactDistance)
+void MBP::populateNewRegion(const MBP_AABB& box, Region* addedRegion, PxU32 regionIndex, const PxBounds3* boundsArray, const PxReal* contactDistance, bool markUpdated)
 {
 	const RegionData* PX_RESTRICT regions = mRegions.begin();
 	const PxU32 nbObjects = mMBP_Objects.size();
@@ -1985,7 +1988,7 @@ void MBP::populateNewRegion(const MBP_AABB& box, Region* addedRegion, PxU32 regi
 			if(bounds.intersects(box))
 			{
 //				updateObject(mbpHandle, bounds);
-				updateObjectAfterNewRegionAdded(mbpHandle, bounds, addedRegion, regionIndex);
+				updateObjectAfterNewRegionAdded(mbpHandle, bounds, addedRegion, regionIndex, markUpdated);
 #ifdef PRINT_STATS
 				nbObjectsFound++;
 #endif
@@ -2069,7 +2072,7 @@ void MBP::populateNewRegion(const MBP_AABB& box, Region* addedRegion, PxU32 regi
 		if(bounds.intersect(box))
 		{
 //			updateObject(mbpHandle, bounds);
-			updateObjectAfterNewRegionAdded(mbpHandle, bounds, addedRegion, regionIndex);
+			updateObjectAfterNewRegionAdded(mbpHandle, bounds, addedRegion, regionIndex, true);
 #ifdef PRINT_STATS
 			nbObjectsFound++;
 #endif
@@ -2082,7 +2085,7 @@ void MBP::populateNewRegion(const MBP_AABB& box, Region* addedRegion, PxU32 regi
 }
 #endif
 
-PxU32 MBP::addRegion(const PxBroadPhaseRegion& region, bool populateRegion, const PxBounds3* boundsArray, const PxReal* contactDistance)
+PxU32 MBP::addRegion(const PxBroadPhaseRegion& region, bool populateRegion, const PxBounds3* boundsArray, const PxReal* contactDistance, bool markUpdated)
 {
 	PxU32 regionHandle;
 	RegionData* PX_RESTRICT buffer;
@@ -2117,7 +2120,7 @@ PxU32 MBP::addRegion(const PxBroadPhaseRegion& region, bool populateRegion, cons
 
 	// PT: automatically populate new region with overlapping objects
 	if(populateRegion)
-		populateNewRegion(buffer->mBox, newRegion, regionHandle, boundsArray, contactDistance);
+		populateNewRegion(buffer->mBox, newRegion, regionHandle, boundsArray, contactDistance, markUpdated);
 
 #ifdef MBP_REGION_BOX_PRUNING
 	mDirtyRegions = true;
@@ -2185,6 +2188,193 @@ bool MBP::removeRegion(PxU32 handle)
 	return true;
 }
 
+// PT: replaces a set of regions with another set covering the same space, i.e. this is used to split or merge regions.
+// Objects are directly transferred from the old regions to the new ones. Contrary to removeRegion() followed by
+// addRegion(), this works even for objects flagged as "fully inside", and objects never go out-of-bounds in-between.
+bool MBP::replaceRegions(const PxU32* oldHandles, PxU32 nbOld, const PxBounds3* newBounds, PxU32 nbNew, PxU32* newHandles)
+{
+	if(getNbActiveRegions()+nbNew>MAX_NB_MBP)
+		return false;
+
+	for(PxU32 i=0;i<nbOld;i++)
+	{
+		if(oldHandles[i]>=mNbRegions || !mRegions[oldHandles[i]].mBP)
+		{
+			PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "MBP::replaceRegions: invalid handle.");
+			return false;
+		}
+	}
+
+	for(PxU32 i=0;i<nbNew;i++)
+	{
+		PxBroadPhaseRegion region;
+		region.mBounds		= newBounds[i];
+		region.mUserData	= NULL;
+		newHandles[i] = addRegion(region, false, NULL, NULL);
+		PX_ASSERT(newHandles[i]!=INVALID_ID);
+	}
+
+	// PT: 0 = untouched region, 1 = replaced region, 2 = new region
+	PxU8 regionTypes[MAX_NB_MBP];
+	PxMemZero(regionTypes, sizeof(PxU8)*mNbRegions);
+	for(PxU32 i=0;i<nbOld;i++)
+		regionTypes[oldHandles[i]] = 1;
+	for(PxU32 i=0;i<nbNew;i++)
+		regionTypes[newHandles[i]] = 2;
+
+	// PT: the regions array doesn't change below this point
+	const RegionData* PX_RESTRICT regions = mRegions.begin();
+	MBP_Object* PX_RESTRICT objects = mMBP_Objects.begin();
+
+	bool alreadyInside[MAX_NB_MBP];
+	for(PxU32 i=0;i<nbNew;i++)
+		alreadyInside[newHandles[i]] = false;
+
+	for(PxU32 r=0;r<nbOld;r++)
+	{
+		const Region* oldRegion = regions[oldHandles[r]].mBP;
+		const PxU32 maxNbObjects = oldRegion->mMaxNbObjects;
+		const MBPEntry* PX_RESTRICT entries = oldRegion->mObjects;
+		for(PxU32 j=0;j<maxNbObjects;j++)
+		{
+			// The handle is INVALID_ID for non-active entries
+			const MBP_Handle mbpHandle = entries[j].mMBPHandle;
+			if(mbpHandle==INVALID_ID)
+				continue;
+
+			const MBP_ObjectIndex objectIndex = decodeHandle_Index(mbpHandle);
+			const bool isStatic = decodeHandle_IsStatic(mbpHandle)!=0;
+			MBP_Object& currentObject = objects[objectIndex];
+
+			const PxU32 nbHandles = currentObject.mNbHandles;
+			RegionHandle* handles = getHandles(currentObject, nbHandles);
+
+			// PT: objects touching several replaced regions have already been transferred the first time we met them
+			bool alreadyTransferred = true;
+			for(PxU32 i=0;i<nbHandles;i++)
+			{
+				if(regionTypes[handles[i].mInternalBPHandle]==1)
+				{
+					alreadyTransferred = false;
+					break;
+				}
+			}
+			if(alreadyTransferred)
+				continue;
+
+			MBP_AABB bounds;
+			oldRegion->retrieveBounds(bounds, MBP_Index(j));
+
+#ifdef USE_FULLY_INSIDE_FLAG
+			bool objectIsFullyInsideRegions = true;
+#endif
+			PxU32 nbNewHandles = 0;
+			RegionHandle newRegionHandles[MAX_NB_MBP+1];
+
+			// PT: keep handles from untouched regions. Handles from replaced regions are simply dropped, since
+			// the replaced regions are deleted afterwards.
+			for(PxU32 i=0;i<nbHandles;i++)
+			{
+				const RegionHandle& h = handles[i];
+				const PxU32 type = regionTypes[h.mInternalBPHandle];
+				if(type==1)
+					continue;
+				if(type==2)
+					alreadyInside[h.mInternalBPHandle] = true;
+#ifdef USE_FULLY_INSIDE_FLAG
+				if(!bounds.isInside(regions[h.mInternalBPHandle].mBox))
+					objectIsFullyInsideRegions = false;
+#endif
+				newRegionHandles[nbNewHandles++] = h;
+			}
+
+			for(PxU32 i=0;i<nbNew;i++)
+			{
+				const PxU32 regionIndex = newHandles[i];
+				if(alreadyInside[regionIndex])
+				{
+					alreadyInside[regionIndex] = false;
+					continue;
+				}
+
+				const RegionData& newRegion = regions[regionIndex];
+#ifdef MBP_USE_NO_CMP_OVERLAP_3D
+				if(!intersect3D(newRegion.mBox, bounds))
+#else
+				if(!newRegion.mBox.intersects(bounds))
+#endif
+					continue;
+#ifdef MBP_USE_WORDS
+				if(newRegion.mBP->mNbObjects==0xffff)
+				{
+					PxGetFoundation().error(PxErrorCode::eINTERNAL_ERROR, PX_FL, "MBP::replaceRegions: 64K objects in single region reached. Some collisions might be lost.");
+					continue;
+				}
+#endif
+#ifdef USE_FULLY_INSIDE_FLAG
+				if(!bounds.isInside(newRegion.mBox))
+					objectIsFullyInsideRegions = false;
+#endif
+				RegionHandle& h = newRegionHandles[nbNewHandles++];
+				h.mHandle = newRegion.mBP->addObject(bounds, mbpHandle, isStatic);
+				h.mInternalBPHandle = PxTo16(regionIndex);
+			}
+
+			purgeHandles(&currentObject, nbHandles);
+			storeHandles(&currentObject, nbNewHandles, newRegionHandles);
+			currentObject.mNbHandles = PxTo16(nbNewHandles);
+			if(!nbNewHandles)
+			{
+				currentObject.mHandlesIndex = mbpHandle;
+				addToOutOfBoundsArray(currentObject.mUserID);
+			}
+
+			// PT: we don't mark the object as updated in mUpdatedObjects. Its bounds did not change so none of its
+			// pairs can be lost, but some of them might not be found again this frame (e.g. pairs with a sleeping
+			// object that only overlaps one of the untouched regions).
+
+#ifdef USE_FULLY_INSIDE_FLAG
+			if(objectIsFullyInsideRegions && nbNewHandles)
+				setBit(mFullyInsideBitmap, objectIndex);
+			else
+				clearBit(mFullyInsideBitmap, objectIndex);
+#endif
+		}
+	}
+
+	PxBounds3 empty;
+	empty.setEmpty();
+	for(PxU32 i=0;i<nbOld;i++)
+	{
+		const PxU32 handle = oldHandles[i];
+		RegionData& region = mRegions[handle];
+		region.mBox.initFrom2(empty);
+		PX_DELETE(region.mBP);
+		region.mUserData = reinterpret_cast<void*>(size_t(mFirstFreeIndexBP));
+		mFirstFreeIndexBP = handle;
+	}
+
+#ifdef MBP_REGION_BOX_PRUNING
+	mDirtyRegions = true;
+#endif
+
+	setupOverlapFlags(mNbRegions, mRegions.begin());
+	return true;
+}
+
+PxU32 MBP::getNbActiveRegions() const
+{
+	const PxU32 nb = mNbRegions;
+	const RegionData* PX_RESTRICT regions = mRegions.begin();
+	PxU32 nbActiveRegions = 0;
+	for(PxU32 i=0;i<nb;i++)
+	{
+		if(regions[i].mBP)
+			nbActiveRegions++;
+	}
+	return nbActiveRegions;
+}
+
 const Region* MBP::getRegion(PxU32 i) const
 {
 	if(i>=mNbRegions)
@@ -2644,7 +2834,7 @@ bool MBP::updateObjectAfterRegionRemoval(MBP_Handle handle, Region* removedRegio
 	return true;
 }
 
-bool MBP::updateObjectAfterNewRegionAdded(MBP_Handle handle, const MBP_AABB& box, Region* addedRegion, PxU32 regionIndex)
+bool MBP::updateObjectAfterNewRegionAdded(MBP_Handle handle, const MBP_AABB& box, Region* addedRegion, PxU32 regionIndex, bool markUpdated)
 {
 	PX_ASSERT(addedRegion);
 
@@ -2656,6 +2846,9 @@ bool MBP::updateObjectAfterNewRegionAdded(MBP_Handle handle, const MBP_AABB& box
 
 //	if(!isStatic)	// ### removed for PhysX integration (bugfix)
 //	if(!currentObject.IsStatic())
+	// PT: an updated object loses the pairs that are not found again this frame. Automatic regions skip this: the object
+	// did not move, so the pairs it has in its other regions are still valid (see replaceRegions()).
+	if(markUpdated)
 	{
 		mUpdatedObjects.setBitChecked(objectIndex);
 	}
@@ -2927,6 +3120,529 @@ void MBP::shiftOrigin(const PxVec3& shift, const PxBounds3* boundsArray, const P
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Automatic region management. Regions are the leaves of quadtrees whose roots are the cells of a regular 2D grid.
+// Cells are created on demand around objects that are not covered by existing regions. Leaves containing too many
+// objects are split, sparse siblings are merged back into their parent, and empty root cells are eventually released.
+//
+// PT: the key invariant is that the bounds of each (regular-sized) object are fully covered by regions, so that any
+// overlap between two objects lies inside a region both objects touch. We never remove a non-empty region and split
+// and merge operations preserve the covered space, so we only need to check objects that have been added or moved.
+
+#define AUTO_REGION_MAX_CELLS_PER_AXIS	4		// Objects spanning more cells than this are only guaranteed to touch one region
+#define AUTO_REGION_MAX_CELL_INDEX		8388608.0f	// 2^23, leaves room for mMaxDepth<=5 levels in the node keys
+#define AUTO_REGION_RELEASE_DELAY		32		// Number of consecutive updates a root cell must be empty before it is released
+
+namespace internalMBP
+{
+	struct AutoRegionNode
+	{
+		PxBounds3	mBounds;
+		PxI32		mX;
+		PxI32		mZ;
+		PxU32		mLevel;
+		PxU32		mRegion;		// MBP region handle for leaves, INVALID_ID for nodes that have been split
+		PxU32		mEmptyCount;	// Number of consecutive updates the (root) leaf has been empty
+	};
+
+	class AutoRegions : public PxUserAllocated
+	{
+											PX_NOCOPY(AutoRegions)
+		public:
+											AutoRegions(const PxBroadPhaseAutoRegionParams& params);
+											~AutoRegions()	{}
+
+						void				setParams(const PxBroadPhaseAutoRegionParams& params);
+						void				update(MBP& mbp, const BroadPhaseUpdateData& updateData, const MBP_Handle* mapping, PxU32 capacity);
+						void				shiftOrigin(const PxVec3& shift);
+						void				getStats(PxBroadPhaseAutoRegionStats& stats)	const;
+
+		private:
+						PxBroadPhaseAutoRegionParams		mParams;
+						PxVec3								mOrigin;
+						PxReal								mCellSize;
+						PxU32								mAxis0;
+						PxU32								mAxis1;
+						PxHashMap<PxU64, AutoRegionNode>	mNodes;
+						PxArray<PxU64>						mPendingCells;
+						PxHashSet<PxU64>					mPendingCellsSet;
+						PxArray<PxU64>						mTmpKeys;
+						PxU32								mNbLeaves;
+						PxU32								mNbOutOfBoundsObjects;
+						PxU32								mNbCreated;
+						PxU32								mNbReleased;
+						PxU32								mNbSplits;
+						PxU32								mNbMerges;
+						bool								mNeedsFullPass;
+						bool								mBudgetWarningSent;
+
+		PX_FORCE_INLINE	void				getInflatedBounds(PxBounds3& bounds, const BroadPhaseUpdateData& updateData, PxU32 index)	const
+						{
+							const PxBounds3& b = updateData.getAABBs()[index];
+							const PxVec3 c(updateData.getContactDistance()[index]);
+							bounds = PxBounds3(b.minimum - c, b.maximum + c);
+						}
+
+		PX_FORCE_INLINE	PxI32				computeCellIndex(PxReal coord, PxU32 axis)	const
+						{
+							const PxReal f = PxFloor((coord - mOrigin[axis]) / mCellSize);
+							return PxI32(PxClamp(f, -AUTO_REGION_MAX_CELL_INDEX, AUTO_REGION_MAX_CELL_INDEX));
+						}
+
+						void				computeCellSize(const MBP& mbp, const BroadPhaseUpdateData& updateData, const MBP_Handle* mapping);
+						void				addCandidate(const MBP& mbp, const PxBounds3& bounds, MBP_Handle mbpHandle);
+						void				createPendingCells(MBP& mbp, const BroadPhaseUpdateData& updateData);
+						void				splitRegions(MBP& mbp);
+						void				mergeRegions(MBP& mbp);
+						void				releaseRegions(MBP& mbp);
+						bool				checkBudget(const MBP& mbp, PxU32 nbNeeded);
+	};
+}
+
+static PX_FORCE_INLINE PxU64 encodeNodeKey(PxU32 level, PxI32 x, PxI32 z)
+{
+	return (PxU64(level)<<60) | (PxU64(PxU32(x + (1<<29)))<<30) | PxU64(PxU32(z + (1<<29)));
+}
+
+static PX_FORCE_INLINE PxI32 decodeNodeKey_X(PxU64 key)
+{
+	return PxI32(PxU32(key>>30) & ((1<<30)-1)) - (1<<29);
+}
+
+static PX_FORCE_INLINE PxI32 decodeNodeKey_Z(PxU64 key)
+{
+	return PxI32(PxU32(key) & ((1<<30)-1)) - (1<<29);
+}
+
+static PX_FORCE_INLINE bool isFullyInsideRegions(const MBP& mbp, MBP_ObjectIndex objectIndex)
+{
+#ifdef USE_FULLY_INSIDE_FLAG
+	#ifdef HWSCAN
+	return !mbp.mFullyInsideBitmap.isSetChecked(objectIndex);
+	#else
+	return mbp.mFullyInsideBitmap.isSetChecked(objectIndex)!=0;
+	#endif
+#else
+	PX_UNUSED(mbp);
+	PX_UNUSED(objectIndex);
+	return false;
+#endif
+}
+
+AutoRegions::AutoRegions(const PxBroadPhaseAutoRegionParams& params) :
+	mOrigin					(PxVec3(0.0f)),
+	mCellSize				(0.0f),
+	mNbLeaves				(0),
+	mNbOutOfBoundsObjects	(0),
+	mNbCreated				(0),
+	mNbReleased				(0),
+	mNbSplits				(0),
+	mNbMerges				(0),
+	mNeedsFullPass			(true),
+	mBudgetWarningSent		(false)
+{
+	setParams(params);
+}
+
+void AutoRegions::setParams(const PxBroadPhaseAutoRegionParams& params)
+{
+	PX_ASSERT(params.isValid());
+
+	// PT: the grid layout cannot change while we have regions in it
+	if(!mNodes.size())
+	{
+		mCellSize	= params.mCellSize;
+		mAxis0		= params.mUpAxis==0 ? 1u : 0u;
+		mAxis1		= params.mUpAxis==2 ? 1u : 2u;
+	}
+	else if(params.mUpAxis!=mParams.mUpAxis || (params.mCellSize!=0.0f && params.mCellSize!=mCellSize))
+	{
+		PxGetFoundation().error(PxErrorCode::eDEBUG_WARNING, PX_FL, "MBP::setAutoRegions: cell size and up axis cannot change while automatic regions exist. New values are ignored.");
+	}
+
+	const PxU32 upAxis = mNodes.size() ? mParams.mUpAxis : params.mUpAxis;
+	mParams = params;
+	mParams.mUpAxis = upAxis;
+	mParams.mCellSize = mCellSize;
+	mBudgetWarningSent = false;
+}
+
+// PT: if the user didn't provide a cell size we derive one from the first batch of objects needing a region: we
+// aim for a 4*4 grid around them (as recommended for manual regions), but keep cells large compared to objects.
+void AutoRegions::computeCellSize(const MBP& mbp, const BroadPhaseUpdateData& updateData, const MBP_Handle* mapping)
+{
+	PxBounds3 centers = PxBounds3::empty();
+	PxReal sumExtents = 0.0f;
+	PxU32 nb = 0;
+
+	const PxU32 nbObjects = mbp.mMBP_Objects.size();
+	const MBP_Object* PX_RESTRICT objects = mbp.mMBP_Objects.begin();
+	for(PxU32 i=0;i<nbObjects;i++)
+	{
+		if(objects[i].mFlags & MBP_REMOVED)
+			continue;
+
+		const BpHandle userID = objects[i].mUserID;
+		if(mapping[userID]==PX_INVALID_U32)
+			continue;
+
+		PxBounds3 bounds;
+		getInflatedBounds(bounds, updateData, userID);
+		const PxVec3 extents = bounds.getExtents();
+		centers.include(bounds.getCenter());
+		sumExtents += PxMax(extents[mAxis0], extents[mAxis1]);
+		nb++;
+	}
+
+	// PT: no object yet, try again next time
+	if(!nb)
+		return;
+
+	const PxVec3 worldExtents = centers.getDimensions();
+	PxReal cellSize = PxMax(worldExtents[mAxis0], worldExtents[mAxis1]) * 0.25f;
+	cellSize = PxMax(cellSize, (sumExtents / PxReal(nb)) * 16.0f);
+	mCellSize = cellSize>0.0f && PxIsFinite(cellSize) ? cellSize : 1.0f;
+	mParams.mCellSize = mCellSize;
+}
+
+void AutoRegions::addCandidate(const MBP& mbp, const PxBounds3& bounds, MBP_Handle mbpHandle)
+{
+	// PT: fast path for objects fully inside the regions they touch. These are covered since they are inside at least one region.
+	const MBP_ObjectIndex objectIndex = decodeHandle_Index(mbpHandle);
+	const MBP_Object& object = mbp.mMBP_Objects[objectIndex];
+	if(object.mNbHandles && isFullyInsideRegions(mbp, objectIndex))
+		return;
+
+	const PxI32 x0 = computeCellIndex(bounds.minimum[mAxis0], mAxis0);
+	const PxI32 z0 = computeCellIndex(bounds.minimum[mAxis1], mAxis1);
+	const PxI32 x1 = computeCellIndex(bounds.maximum[mAxis0], mAxis0);
+	const PxI32 z1 = computeCellIndex(bounds.maximum[mAxis1], mAxis1);
+
+	if(x1-x0>=AUTO_REGION_MAX_CELLS_PER_AXIS || z1-z0>=AUTO_REGION_MAX_CELLS_PER_AXIS)
+	{
+		// PT: large object, we only make sure it touches a region
+		if(object.mNbHandles)
+			return;
+
+		const PxVec3 center = bounds.getCenter();
+		const PxU64 key = encodeNodeKey(0, computeCellIndex(center[mAxis0], mAxis0), computeCellIndex(center[mAxis1], mAxis1));
+		if(!mNodes.find(key) && mPendingCellsSet.insert(key))
+			mPendingCells.pushBack(key);
+		return;
+	}
+
+	for(PxI32 z=z0;z<=z1;z++)
+	{
+		for(PxI32 x=x0;x<=x1;x++)
+		{
+			const PxU64 key = encodeNodeKey(0, x, z);
+			if(!mNodes.find(key) && mPendingCellsSet.insert(key))
+				mPendingCells.pushBack(key);
+		}
+	}
+}
+
+bool AutoRegions::checkBudget(const MBP& mbp, PxU32 nbNeeded)
+{
+	if(mbp.getNbActiveRegions()+nbNeeded<=MAX_NB_MBP)
+		return true;
+
+	if(!mBudgetWarningSent)
+	{
+		mBudgetWarningSent = true;
+		PxGetFoundation().error(PxErrorCode::ePERF_WARNING, PX_FL, "MBP: max number of regions reached, automatic regions cannot be created or split. Consider using a larger cell size.");
+	}
+	return false;
+}
+
+void AutoRegions::createPendingCells(MBP& mbp, const BroadPhaseUpdateData& updateData)
+{
+	const PxU32 nbPending = mPendingCells.size();
+	for(PxU32 i=0;i<nbPending;i++)
+	{
+		if(!checkBudget(mbp, 1))
+			break;
+
+		const PxU64 key = mPendingCells[i];
+
+		AutoRegionNode node;
+		node.mX				= decodeNodeKey_X(key);
+		node.mZ				= decodeNodeKey_Z(key);
+		node.mLevel			= 0;
+		node.mEmptyCount	= 0;
+		node.mBounds.minimum = PxVec3(-PX_MAX_BOUNDS_EXTENTS);
+		node.mBounds.maximum = PxVec3(PX_MAX_BOUNDS_EXTENTS);
+		node.mBounds.minimum[mAxis0] = mOrigin[mAxis0] + PxReal(node.mX) * mCellSize;
+		node.mBounds.maximum[mAxis0] = mOrigin[mAxis0] + PxReal(node.mX+1) * mCellSize;
+		node.mBounds.minimum[mAxis1] = mOrigin[mAxis1] + PxReal(node.mZ) * mCellSize;
+		node.mBounds.maximum[mAxis1] = mOrigin[mAxis1] + PxReal(node.mZ+1) * mCellSize;
+
+		PxBroadPhaseRegion region;
+		region.mBounds		= node.mBounds;
+		region.mUserData	= NULL;
+		// PT: the new region is populated with the objects touching it, including the ones added or moved this frame
+		node.mRegion = mbp.addRegion(region, true, updateData.getAABBs(), updateData.getContactDistance(), false);
+		if(node.mRegion==INVALID_ID)
+			break;
+
+		mNodes.insert(key, node);
+		mNbLeaves++;
+		mNbCreated++;
+	}
+	mPendingCells.clear();
+	mPendingCellsSet.clear();
+}
+
+void AutoRegions::splitRegions(MBP& mbp)
+{
+	mTmpKeys.clear();
+	for(PxHashMap<PxU64, AutoRegionNode>::Iterator iter = mNodes.getIterator(); !iter.done(); ++iter)
+	{
+		const AutoRegionNode& node = iter->second;
+		if(node.mRegion!=INVALID_ID && node.mLevel<mParams.mMaxDepth && mbp.getRegion(node.mRegion)->mNbObjects>mParams.mMaxNbObjectsPerRegion)
+			mTmpKeys.pushBack(iter->first);
+	}
+
+	const PxU32 nbToSplit = mTmpKeys.size();
+	for(PxU32 i=0;i<nbToSplit;i++)
+	{
+		if(!checkBudget(mbp, 4))
+			break;
+
+		AutoRegionNode& parent = mNodes[mTmpKeys[i]];
+
+		PxBounds3 childBounds[4];
+		const PxReal mid0 = (parent.mBounds.minimum[mAxis0] + parent.mBounds.maximum[mAxis0]) * 0.5f;
+		const PxReal mid1 = (parent.mBounds.minimum[mAxis1] + parent.mBounds.maximum[mAxis1]) * 0.5f;
+		for(PxU32 j=0;j<4;j++)
+		{
+			childBounds[j] = parent.mBounds;
+			if(j&1)
+				childBounds[j].minimum[mAxis0] = mid0;
+			else
+				childBounds[j].maximum[mAxis0] = mid0;
+			if(j&2)
+				childBounds[j].minimum[mAxis1] = mid1;
+			else
+				childBounds[j].maximum[mAxis1] = mid1;
+		}
+
+		PxU32 childRegions[4];
+		if(!mbp.replaceRegions(&parent.mRegion, 1, childBounds, 4, childRegions))
+			break;
+
+		parent.mRegion = INVALID_ID;
+		const PxU32 level = parent.mLevel + 1;
+		const PxI32 x = parent.mX*2;
+		const PxI32 z = parent.mZ*2;
+		for(PxU32 j=0;j<4;j++)
+		{
+			AutoRegionNode child;
+			child.mBounds		= childBounds[j];
+			child.mX			= x + PxI32(j&1);
+			child.mZ			= z + PxI32(j>>1);
+			child.mLevel		= level;
+			child.mRegion		= childRegions[j];
+			child.mEmptyCount	= 0;
+			mNodes.insert(encodeNodeKey(level, child.mX, child.mZ), child);	// PT: invalidates 'parent'
+		}
+		mNbLeaves += 3;
+		mNbSplits++;
+	}
+}
+
+void AutoRegions::mergeRegions(MBP& mbp)
+{
+	mTmpKeys.clear();
+	for(PxHashMap<PxU64, AutoRegionNode>::Iterator iter = mNodes.getIterator(); !iter.done(); ++iter)
+	{
+		const AutoRegionNode& node = iter->second;
+		if(node.mRegion!=INVALID_ID)
+			continue;
+
+		PxU32 nbObjects = 0;
+		bool canMerge = true;
+		for(PxU32 j=0;j<4 && canMerge;j++)
+		{
+			const PxHashMap<PxU64, AutoRegionNode>::Entry* child = mNodes.find(encodeNodeKey(node.mLevel+1, node.mX*2 + PxI32(j&1), node.mZ*2 + PxI32(j>>1)));
+			PX_ASSERT(child);
+			if(child->second.mRegion==INVALID_ID)
+				canMerge = false;
+			else
+				nbObjects += mbp.getRegion(child->second.mRegion)->mNbObjects;
+		}
+
+		if(canMerge && nbObjects<mParams.mMinNbObjectsPerRegion)
+			mTmpKeys.pushBack(iter->first);
+	}
+
+	const PxU32 nbToMerge = mTmpKeys.size();
+	for(PxU32 i=0;i<nbToMerge;i++)
+	{
+		if(!checkBudget(mbp, 1))
+			break;
+
+		AutoRegionNode& parent = mNodes[mTmpKeys[i]];
+
+		PxU64 childKeys[4];
+		PxU32 childRegions[4];
+		for(PxU32 j=0;j<4;j++)
+		{
+			childKeys[j] = encodeNodeKey(parent.mLevel+1, parent.mX*2 + PxI32(j&1), parent.mZ*2 + PxI32(j>>1));
+			childRegions[j] = mNodes[childKeys[j]].mRegion;
+		}
+
+		PxU32 parentRegion;
+		if(!mbp.replaceRegions(childRegions, 4, &parent.mBounds, 1, &parentRegion))
+			break;
+
+		parent.mRegion		= parentRegion;
+		parent.mEmptyCount	= 0;
+		for(PxU32 j=0;j<4;j++)
+			mNodes.erase(childKeys[j]);
+		mNbLeaves -= 3;
+		mNbMerges++;
+	}
+}
+
+void AutoRegions::releaseRegions(MBP& mbp)
+{
+	mTmpKeys.clear();
+	for(PxHashMap<PxU64, AutoRegionNode>::Iterator iter = mNodes.getIterator(); !iter.done(); ++iter)
+	{
+		AutoRegionNode& node = iter->second;
+		if(node.mLevel || node.mRegion==INVALID_ID)
+			continue;
+
+		if(mbp.getRegion(node.mRegion)->mNbObjects)
+			node.mEmptyCount = 0;
+		else if(++node.mEmptyCount>=AUTO_REGION_RELEASE_DELAY)
+			mTmpKeys.pushBack(iter->first);
+	}
+
+	const PxU32 nbToRelease = mTmpKeys.size();
+	for(PxU32 i=0;i<nbToRelease;i++)
+	{
+		// PT: the region is empty so no object can become out-of-bounds here
+		const bool status = mbp.removeRegion(mNodes[mTmpKeys[i]].mRegion);
+		PX_ASSERT(status);
+		PX_UNUSED(status);
+		mNodes.erase(mTmpKeys[i]);
+		mNbLeaves--;
+		mNbReleased++;
+	}
+}
+
+void AutoRegions::update(MBP& mbp, const BroadPhaseUpdateData& updateData, const MBP_Handle* mapping, PxU32 capacity)
+{
+	// PT: gather objects that might not be covered by regions: new objects, moved objects, and objects that went
+	// out-of-bounds for other reasons (e.g. a user-defined region has been removed). The first time we run, all
+	// existing objects are considered.
+	if(mCellSize==0.0f)
+	{
+		computeCellSize(mbp, updateData, mapping);
+		if(mCellSize==0.0f)
+			return;
+	}
+
+	const bool fullPass = mNeedsFullPass;
+	mNeedsFullPass = false;
+
+	PxBounds3 bounds;
+	if(fullPass)
+	{
+		const PxU32 nbObjects = mbp.mMBP_Objects.size();
+		for(PxU32 i=0;i<nbObjects;i++)
+		{
+			const MBP_Object& object = mbp.mMBP_Objects[i];
+			if(object.mFlags & MBP_REMOVED)
+				continue;
+			const MBP_Handle mbpHandle = mapping[object.mUserID];
+			if(mbpHandle==PX_INVALID_U32)
+				continue;
+			getInflatedBounds(bounds, updateData, object.mUserID);
+			addCandidate(mbp, bounds, mbpHandle);
+		}
+	}
+	else
+	{
+		const BpHandle* PX_RESTRICT created = updateData.getCreatedHandles();
+		PxU32 nbToGo = created ? updateData.getNumCreatedHandles() : 0;
+		while(nbToGo--)
+		{
+			const BpHandle index = *created++;
+			getInflatedBounds(bounds, updateData, index);
+			addCandidate(mbp, bounds, mapping[index]);
+		}
+
+		const BpHandle* PX_RESTRICT updated = updateData.getUpdatedHandles();
+		nbToGo = updated ? updateData.getNumUpdatedHandles() : 0;
+		while(nbToGo--)
+		{
+			const BpHandle index = *updated++;
+			getInflatedBounds(bounds, updateData, index);
+			addCandidate(mbp, bounds, mapping[index]);
+		}
+
+		const PxU32 nbOutOfBounds = mbp.mOutOfBoundsObjects.size();
+		for(PxU32 i=0;i<nbOutOfBounds;i++)
+		{
+			const PxU32 index = mbp.mOutOfBoundsObjects[i];
+			if(index>=capacity || mapping[index]==PX_INVALID_U32)
+				continue;
+			getInflatedBounds(bounds, updateData, index);
+			addCandidate(mbp, bounds, mapping[index]);
+		}
+	}
+
+	createPendingCells(mbp, updateData);
+	splitRegions(mbp);
+	mergeRegions(mbp);
+	releaseRegions(mbp);
+
+	// PT: objects covered by new regions are not out-of-bounds anymore, and should not be reported as such.
+	PxU32 nbOutOfBounds = 0;
+	const PxU32 nb = mbp.mOutOfBoundsObjects.size();
+	for(PxU32 i=0;i<nb;i++)
+	{
+		const PxU32 index = mbp.mOutOfBoundsObjects[i];
+		if(index>=capacity || mapping[index]==PX_INVALID_U32)
+			continue;
+		if(mbp.mMBP_Objects[decodeHandle_Index(mapping[index])].mNbHandles)
+			continue;
+		mbp.mOutOfBoundsObjects[nbOutOfBounds++] = index;
+	}
+	mbp.mOutOfBoundsObjects.forceSize_Unsafe(nbOutOfBounds);
+	mNbOutOfBoundsObjects = nbOutOfBounds;
+
+}
+
+void AutoRegions::shiftOrigin(const PxVec3& shift)
+{
+	mOrigin[mAxis0] -= shift[mAxis0];
+	mOrigin[mAxis1] -= shift[mAxis1];
+
+	for(PxHashMap<PxU64, AutoRegionNode>::Iterator iter = mNodes.getIterator(); !iter.done(); ++iter)
+	{
+		PxBounds3& bounds = iter->second.mBounds;
+		bounds.minimum[mAxis0] -= shift[mAxis0];
+		bounds.maximum[mAxis0] -= shift[mAxis0];
+		bounds.minimum[mAxis1] -= shift[mAxis1];
+		bounds.maximum[mAxis1] -= shift[mAxis1];
+	}
+}
+
+void AutoRegions::getStats(PxBroadPhaseAutoRegionStats& stats) const
+{
+	stats.mNbAutoRegions		= mNbLeaves;
+	stats.mNbOutOfBoundsObjects	= mNbOutOfBoundsObjects;
+	stats.mNbCreated			= mNbCreated;
+	stats.mNbReleased			= mNbReleased;
+	stats.mNbSplits				= mNbSplits;
+	stats.mNbMerges				= mNbMerges;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 // Below is the PhysX wrapper = link between AABBManager and MBP
 
 #define DEFAULT_CREATED_DELETED_PAIRS_CAPACITY 1024
@@ -2936,6 +3652,7 @@ BroadPhaseMBP::BroadPhaseMBP(	PxU32 maxNbRegions,
 								PxU32 maxNbStaticShapes,
 								PxU32 maxNbDynamicShapes,
 								PxU64 contextID) :
+	mAutoRegions(NULL),
 	mMapping	(NULL),
 	mCapacity	(0),
 	mGroups		(NULL),
@@ -2956,6 +3673,7 @@ BroadPhaseMBP::BroadPhaseMBP(	PxU32 maxNbRegions,
 
 BroadPhaseMBP::~BroadPhaseMBP()
 {
+	PX_DELETE(mAutoRegions);
 	PX_DELETE(mMBP);
 	PX_FREE(mMapping);
 }
@@ -3176,6 +3894,13 @@ void BroadPhaseMBP::addObjects(const BroadPhaseUpdateData& updateData)
 	}
 }
 
+void BroadPhaseMBP::updateAutoRegions(const BroadPhaseUpdateData& updateData)
+{
+	PX_PROFILE_ZONE("BroadPhaseMBP::updateAutoRegions", mContextID);
+
+	mAutoRegions->update(*mMBP, updateData, mMapping, mCapacity);
+}
+
 void BroadPhaseMBP::setUpdateData(const BroadPhaseUpdateData& updateData)
 {
 	PX_PROFILE_ZONE("BroadPhaseMBP::setUpdateData", mContextID);
@@ -3205,6 +3930,9 @@ void BroadPhaseMBP::setUpdateData(const BroadPhaseUpdateData& updateData)
 	addObjects(updateData);
 	updateObjects(updateData);
 
+	if(mAutoRegions)
+		updateAutoRegions(updateData);
+
 	PX_ASSERT(!mCreated.size());
 	PX_ASSERT(!mDeleted.size());
 
@@ -3259,6 +3987,51 @@ const PxU32* BroadPhaseMBP::getOutOfBoundsObjects() const
 	return mMBP->mOutOfBoundsObjects.begin();
 }
 
+bool BroadPhaseMBP::setAutoRegions(const PxBroadPhaseAutoRegionParams* params)
+{
+	if(!params)
+	{
+		// PT: existing regions are kept, they just aren't managed automatically anymore
+		PX_DELETE(mAutoRegions);
+		return true;
+	}
+
+	if(!params->isValid())
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "BroadPhaseMBP::setAutoRegions: invalid parameters.");
+
+	if(mAutoRegions)
+		mAutoRegions->setParams(*params);
+	else
+		mAutoRegions = PX_NEW(AutoRegions)(*params);
+	return true;
+}
+
+bool BroadPhaseMBP::getAutoRegionStats(PxBroadPhaseAutoRegionStats& stats) const
+{
+	PxMemZero(&stats, sizeof(PxBroadPhaseAutoRegionStats));
+	if(mAutoRegions)
+		mAutoRegions->getStats(stats);
+	else
+		stats.mNbOutOfBoundsObjects = mMBP->mOutOfBoundsObjects.size();
+
+	PxU32 minNbObjects = 0xffffffff;
+	const PxU32 size = mMBP->mNbRegions;
+	const RegionData* PX_RESTRICT regions = mMBP->mRegions.begin();
+	for(PxU32 i=0;i<size;i++)
+	{
+		if(!regions[i].mBP)
+			continue;
+
+		const PxU32 nbObjects = regions[i].mBP->mNbObjects;
+		stats.mNbRegions++;
+		stats.mNbObjectEntries += nbObjects;
+		minNbObjects = PxMin(minNbObjects, nbObjects);
+		stats.mMaxNbObjects = PxMax(stats.mMaxNbObjects, nbObjects);
+	}
+	stats.mMinNbObjects = stats.mNbRegions ? minNbObjects : 0;
+	return true;
+}
+
 static void freeBuffer(PxArray<BroadPhasePair>& buffer)
 {
 	const PxU32 size = buffer.size();
@@ -3342,6 +4115,8 @@ bool BroadPhaseMBP::isValid(const BroadPhaseUpdateData& updateData) const
 void BroadPhaseMBP::shiftOrigin(const PxVec3& shift, const PxBounds3* boundsArray, const PxReal* contactDistances)
 {
 	mMBP->shiftOrigin(shift, boundsArray, contactDistances);
+	if(mAutoRegions)
+		mAutoRegions->shiftOrigin(shift);
 }
 
 PxU32 BroadPhaseMBP::getCurrentNbPairs() const
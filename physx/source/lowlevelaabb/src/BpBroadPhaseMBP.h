@@ -36,6 +36,7 @@
 namespace internalMBP
 {
 	class MBP;
+	class AutoRegions;
 }
 
 namespace physx
@@ -64,6 +65,8 @@ namespace Bp
 		virtual	bool						removeRegion(PxU32 handle)			PX_OVERRIDE	PX_FINAL;
 		virtual	PxU32						getNbOutOfBoundsObjects()	const	PX_OVERRIDE	PX_FINAL;
 		virtual	const PxU32*				getOutOfBoundsObjects()		const	PX_OVERRIDE	PX_FINAL;
+		virtual	bool						setAutoRegions(const PxBroadPhaseAutoRegionParams* params)		PX_OVERRIDE	PX_FINAL;
+		virtual	bool						getAutoRegionStats(PxBroadPhaseAutoRegionStats& stats)	const	PX_OVERRIDE	PX_FINAL;
 	//~PxBroadPhaseRegions
 
 	// BroadPhase
@@ -82,6 +85,7 @@ namespace Bp
 	//~BroadPhase
 
 				internalMBP::MBP*			mMBP;		// PT: TODO: aggregate
+				internalMBP::AutoRegions*	mAutoRegions;	// NULL unless automatic region management is enabled
 
 				MBP_Handle*					mMapping;
 				PxU32						mCapacity;
@@ -97,6 +101,7 @@ namespace Bp
 				void						addObjects(const BroadPhaseUpdateData& updateData);
 				void						removeObjects(const BroadPhaseUpdateData& updateData);
 				void						updateObjects(const BroadPhaseUpdateData& updateData);
+				void						updateAutoRegions(const BroadPhaseUpdateData& updateData);
 
 				void						update();
 				void						postUpdate();
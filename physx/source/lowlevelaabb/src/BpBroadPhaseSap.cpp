@@ -91,12 +91,29 @@ BroadPhaseSap::BroadPhaseSap(
 	const PxU32 maxNbBroadPhaseOverlaps,
 	const PxU32 maxNbStaticShapes,
 	const PxU32 maxNbDynamicShapes,
-	PxU64 contextID) :
-	mScratchAllocator	(NULL),
-	mContextID			(contextID)
+	PxU64 contextID,
+	bool enableMT) :
+	mScratchAllocator		(NULL),
+	mUpdateStageTask		(contextID, this, "BpBroadphaseSap.updateStage"),
+	mOverlapStageTask		(contextID, this, "BpBroadphaseSap.overlapStage"),
+	mPostUpdateStageTask	(contextID, this, "BpBroadphaseSap.postUpdateStage"),
+	mCreateStageTask		(contextID, this, "BpBroadphaseSap.createStage"),
+	mFinalizeStageTask		(contextID, this, "BpBroadphaseSap.finalizeStage"),
+	mNbPruningTasks			(0),
+	mFullRebuild			(false),
+	mContextID				(contextID),
+	mEnableMT				(enableMT)
 {
 	for(PxU32 i=0;i<3;i++)
+	{
 		mBatchUpdateTasks[i].setContextId(contextID);
+		mAxisTasks[i].setContextId(contextID);
+		mAxisTasks[i].set(this, i);
+	}
+	for(PxU32 i=0;i<BP_SAP_NB_PRUNING_TASKS;i++)
+		mPruningTasks[i].setContextId(contextID);
+	mAuxData[0] = NULL;
+	mAuxData[1] = NULL;
 
 	//Boxes
 	mBoxesSize=0;
@@ -485,18 +502,40 @@ bool BroadPhaseSap::isValid(const BroadPhaseUpdateData& updateData) const
 }
 #endif
 
-void BroadPhaseSap::update(PxcScratchAllocator* scratchAllocator, const BroadPhaseUpdateData& updateData, PxBaseTask* /*continuation*/)
+void BroadPhaseSap::update(PxcScratchAllocator* scratchAllocator, const BroadPhaseUpdateData& updateData, PxBaseTask* continuation)
 {
 	PX_CHECK_AND_RETURN(scratchAllocator, "BroadPhaseSap::update - scratchAllocator must be non-NULL \n");
 
+	// PT: run single-threaded if forced to do so
+	if(!mEnableMT)
+		continuation = NULL;
+
 	if(setUpdateData(updateData))
 	{
 		mScratchAllocator = scratchAllocator;
 
 		resizeBuffers();
 
-		update();
-		postUpdate();
+		if(continuation)
+		{
+			// PT: the stages run one after the other. Each of them can spawn parallel tasks that the next stage waits for.
+			mFinalizeStageTask.setContinuation(continuation);
+			mCreateStageTask.setContinuation(&mFinalizeStageTask);
+			mPostUpdateStageTask.setContinuation(&mCreateStageTask);
+			mOverlapStageTask.setContinuation(&mPostUpdateStageTask);
+			mUpdateStageTask.setContinuation(&mOverlapStageTask);
+
+			mFinalizeStageTask.removeReference();
+			mCreateStageTask.removeReference();
+			mPostUpdateStageTask.removeReference();
+			mOverlapStageTask.removeReference();
+			mUpdateStageTask.removeReference();
+		}
+		else
+		{
+			update();
+			postUpdate();
+		}
 	}
 }
 
@@ -640,6 +679,15 @@ void BroadPhaseSap::postUpdate()
 {
 	PX_PROFILE_ZONE("BroadPhase.SapPostUpdate", mContextID);
 
+	mergeUpdatePairs();
+
+	batchCreate();
+
+	finalizeUpdate();
+}
+
+void BroadPhaseSap::mergeUpdatePairs()
+{
 	DataArray da(mData, mDataSize, mDataCapacity);
 
 	for(PxU32 i=0;i<3;i++)
@@ -661,9 +709,10 @@ void BroadPhaseSap::postUpdate()
 	mData = da.mData;
 	mDataSize = da.mSize;
 	mDataCapacity = da.mCapacity;
+}
 
-	batchCreate();
-
+void BroadPhaseSap::finalizeUpdate()
+{
 	//Compute the lists of created and deleted overlap pairs.
 
 	ComputeCreatedDeletedPairsLists(
@@ -871,6 +920,52 @@ void BroadPhaseSap::ComputeSortedLists(	//const PxVec4& globalMin, const PxVec4&
 	PX_ASSERT(oldBoxIndicesCount<=((numSortedEndPoints-NUM_SENTINELS)/2));
 }
 
+void BroadPhaseSap::insertCreatedEndPoints(const PxU32 Axis, Cm::RadixSortBuffered& RS, ValType* newEPSortedValues, ValType* bufferValues)
+{
+	//Number of newly-created boxes (still to be sorted).
+	const PxU32 numNewBoxes = mCreatedSize;
+	const PxU32 numEndPoints = numNewBoxes*2;
+
+	//Array of newly-created box indices.
+	const BpHandle* PX_RESTRICT created = mCreated;
+
+	//Arrays of min and max coords for each box for each axis.
+	const PxBounds3* PX_RESTRICT minMax = mBoxBoundsMinMax;
+
+	for(PxU32 i=0;i<numNewBoxes;i++)
+	{
+		const PxU32 boxIndex = PxU32(created[i]);
+		PX_ASSERT(mBoxEndPts[Axis][boxIndex].mMinMax[0]==BP_INVALID_BP_HANDLE || mBoxEndPts[Axis][boxIndex].mMinMax[0]==PX_REMOVED_BP_HANDLE);
+		PX_ASSERT(mBoxEndPts[Axis][boxIndex].mMinMax[1]==BP_INVALID_BP_HANDLE || mBoxEndPts[Axis][boxIndex].mMinMax[1]==PX_REMOVED_BP_HANDLE);
+
+//		const ValType minValue = minMax[boxIndex].getMin(Axis);
+//		const ValType maxValue = minMax[boxIndex].getMax(Axis);
+		const PxReal contactDistance = mContactDistance[boxIndex];
+		newEPSortedValues[i*2+0] = encodeMin(minMax[boxIndex], Axis, contactDistance);
+		newEPSortedValues[i*2+1] = encodeMax(minMax[boxIndex], Axis, contactDistance);
+	}
+
+	// Sort endpoints backwards
+	BpHandle* bufferDatas;
+	{
+		RS.invalidateRanks();	// PT: there's no coherence between axes
+		const PxU32* Sorted = RS.Sort(newEPSortedValues, numEndPoints, Cm::RADIX_UNSIGNED).GetRanks();
+		bufferDatas = RS.GetRecyclable();
+
+		// PT: TODO: with two passes here we could reuse the "newEPSortedValues" buffer and drop "bufferValues"
+		for(PxU32 i=0;i<numEndPoints;i++)
+		{
+			const PxU32 sortedIndex = Sorted[numEndPoints-1-i];
+			bufferValues[i] = newEPSortedValues[sortedIndex];
+			// PT: compute buffer data on-the-fly, store in recyclable buffer
+			const PxU32 boxIndex = PxU32(created[sortedIndex>>1]);
+			bufferDatas[i] = setData(boxIndex, (sortedIndex&1)!=0);
+		}
+	}
+
+	InsertEndPoints(bufferValues, bufferDatas, numEndPoints, mEndPointValues[Axis], mEndPointDatas[Axis], 2*(mBoxesSize-mCreatedSize)+NUM_SENTINELS, mBoxEndPts[Axis]);
+}
+
 //#include "foundation/PxVecMath.h"
 //using namespace aos;
 
@@ -887,9 +982,7 @@ void BroadPhaseSap::batchCreate()
 
 	//Array of newly-created box indices.
 	const BpHandle* PX_RESTRICT created = mCreated;
-
-	//Arrays of min and max coords for each box for each axis.
-	const PxBounds3* PX_RESTRICT minMax = mBoxBoundsMinMax;
+	PX_UNUSED(created);
 
 /*	{
 		PxU32 nbToGo = numNewBoxes-1;
@@ -926,40 +1019,7 @@ void BroadPhaseSap::batchCreate()
 		Cm::RadixSortBuffered RS;
 
 		for(PxU32 Axis=0;Axis<3;Axis++)
-		{
-			for(PxU32 i=0;i<numNewBoxes;i++)
-			{
-				const PxU32 boxIndex = PxU32(created[i]);
-				PX_ASSERT(mBoxEndPts[Axis][boxIndex].mMinMax[0]==BP_INVALID_BP_HANDLE || mBoxEndPts[Axis][boxIndex].mMinMax[0]==PX_REMOVED_BP_HANDLE);
-				PX_ASSERT(mBoxEndPts[Axis][boxIndex].mMinMax[1]==BP_INVALID_BP_HANDLE || mBoxEndPts[Axis][boxIndex].mMinMax[1]==PX_REMOVED_BP_HANDLE);
-
-//				const ValType minValue = minMax[boxIndex].getMin(Axis);
-//				const ValType maxValue = minMax[boxIndex].getMax(Axis);
-				const PxReal contactDistance = mContactDistance[boxIndex];
-				newEPSortedValues[i*2+0] = encodeMin(minMax[boxIndex], Axis, contactDistance);
-				newEPSortedValues[i*2+1] = encodeMax(minMax[boxIndex], Axis, contactDistance);
-			}
-
-			// Sort endpoints backwards
-			BpHandle* bufferDatas;
-			{
-				RS.invalidateRanks();	// PT: there's no coherence between axes
-				const PxU32* Sorted = RS.Sort(newEPSortedValues, numEndPoints, Cm::RADIX_UNSIGNED).GetRanks();
-				bufferDatas = RS.GetRecyclable();
-
-				// PT: TODO: with two passes here we could reuse the "newEPSortedValues" buffer and drop "bufferValues"
-				for(PxU32 i=0;i<numEndPoints;i++)
-				{
-					const PxU32 sortedIndex = Sorted[numEndPoints-1-i];
-					bufferValues[i] = newEPSortedValues[sortedIndex];
-					// PT: compute buffer data on-the-fly, store in recyclable buffer
-					const PxU32 boxIndex = PxU32(created[sortedIndex>>1]);
-					bufferDatas[i] = setData(boxIndex, (sortedIndex&1)!=0);
-				}
-			}
-
-			InsertEndPoints(bufferValues, bufferDatas, numEndPoints, mEndPointValues[Axis], mEndPointDatas[Axis], 2*(mBoxesSize-mCreatedSize)+NUM_SENTINELS, mBoxEndPts[Axis]);
-		}
+			insertCreatedEndPoints(Axis, RS, newEPSortedValues, bufferValues);
 	}
 
 	//Some debug tests.
@@ -1791,6 +1851,350 @@ void BroadPhaseSap::batchUpdateFewUpdates(const PxU32 Axis, BroadPhasePair*& pai
 	}
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+// PT: multithreaded version (PxBroadPhaseType::ePSAP). The update is split into stages running one after the other:
+// - updateStage: removes boxes, then either runs the incremental update or re-sorts the three axes in parallel.
+// - overlapStage: after a full re-sort, finds all overlaps with parallel box pruning over segments of the first axis.
+// - postUpdateStage: adds/removes the pairs found so far, then inserts the new boxes in the three axes in parallel.
+// - createStage: finds the new boxes' overlaps with parallel box pruning.
+// - finalizeStage: adds the new boxes' pairs and computes the created/deleted pairs lists.
+// Pairs found by parallel tasks are recorded and added to the pair manager afterwards, in the same order as
+// the single-threaded code.
+//
+// The incremental update of each axis uses the sorted positions of the boxes along the other axes, as updated
+// by the previous axes. The three axes cannot be processed concurrently without changing the results, so when
+// too many boxes jump far away in the sorted lists (e.g. mass teleports) we re-sort the lists from scratch instead.
+
+// PT: don't split box pruning into tasks smaller than this
+#define BP_SAP_MIN_NB_BOXES_PER_TASK	256
+// PT: full rebuilds are only considered above this number of boxes
+#define BP_SAP_MIN_NB_BOXES_FOR_REBUILD	1024
+// PT: an updated box is considered "far" if it moved further than this number of endpoints in a sorted list
+#define BP_SAP_REBUILD_WINDOW			32
+// PT: ...and we fully re-sort the lists when more than 1/BP_SAP_REBUILD_RATIO of the boxes are "far"
+#define BP_SAP_REBUILD_RATIO			8
+
+void BroadPhaseSapAxisTask::runInternal()
+{
+	if(mRebuild)
+	{
+		mSap->rebuildAxis(mAxis);
+	}
+	else
+	{
+		const PxU32 numEndPoints = mSap->mCreatedSize*2;
+
+		TmpMem<ValType, 32> nepsv(numEndPoints), bv(numEndPoints);
+
+		Cm::RadixSortBuffered RS;
+		mSap->insertCreatedEndPoints(mAxis, RS, nepsv.getBase(), bv.getBase());
+	}
+}
+
+void BroadPhaseSapPruningTask::runInternal()
+{
+	if(mAuxData1)
+		performBoxPruningNewOld(mAuxData0, mAuxData1, mPass, mStart, mEnd, mLUT, mPairs);
+	else
+		performBoxPruningNewNew(mAuxData0, mStart, mEnd, mLUT, mPairs);
+}
+
+bool BroadPhaseSap::needsFullRebuild() const
+{
+	//Number of sorted boxes (new boxes haven't been inserted yet).
+	const PxU32 numBoxes = mBoxesSize - mCreatedSize;
+	if(numBoxes<BP_SAP_MIN_NB_BOXES_FOR_REBUILD || mUpdatedSize*BP_SAP_REBUILD_RATIO<numBoxes)
+		return false;
+
+	const PxU32 lastIndex = numBoxes*2 + 1;	// PT: max sentinel
+	const PxU32 maxNbFarBoxes = numBoxes/BP_SAP_REBUILD_RATIO;
+	PxU32 nbFarBoxes = 0;
+	for(PxU32 i=0;i<mUpdatedSize;i++)
+	{
+		const PxU32 handle = mUpdated[i];
+		for(PxU32 Axis=0;Axis<3;Axis++)
+		{
+			const PxU32 index = mBoxEndPts[Axis][handle].mMinMax[0];
+			if(index>=lastIndex)
+				break;	// PT: box not in the sorted lists
+
+			const ValType* PX_RESTRICT values = mEndPointValues[Axis];
+			const ValType value = encodeMin(mBoxBoundsMinMax[handle], Axis, mContactDistance[handle]);
+			const PxU32 lowIndex = index>BP_SAP_REBUILD_WINDOW ? index - BP_SAP_REBUILD_WINDOW : 0;
+			const PxU32 highIndex = PxMin(index + BP_SAP_REBUILD_WINDOW, lastIndex);
+			if(value<values[lowIndex] || value>values[highIndex])
+			{
+				if(++nbFarBoxes>=maxNbFarBoxes)
+					return true;
+				break;
+			}
+		}
+	}
+	return false;
+}
+
+void BroadPhaseSap::rebuildAxis(const PxU32 Axis)
+{
+	PX_PROFILE_ZONE("BroadPhase.SapRebuildAxis", mContextID);
+
+	const PxU32 numEndPoints = (mBoxesSize - mCreatedSize)*2;
+
+	// PT: skip the min sentinel
+	ValType* PX_RESTRICT endPointValues = mEndPointValues[Axis] + 1;
+	BpHandle* PX_RESTRICT endPointDatas = mEndPointDatas[Axis] + 1;
+	SapBox1D* PX_RESTRICT boxes = mBoxEndPts[Axis];
+	const PxU8* PX_RESTRICT updated = mBoxesUpdated;
+
+	TmpMem<ValType, 32> valuesMem(numEndPoints);
+	TmpMem<BpHandle, 32> datasMem(numEndPoints);
+	ValType* values = valuesMem.getBase();
+	BpHandle* datas = datasMem.getBase();
+
+	// PT: gather the endpoints in their previous order so that the (stable) radix sort gives deterministic results
+	for(PxU32 i=0;i<numEndPoints;i++)
+	{
+		const BpHandle data = endPointDatas[i];
+		const PxU32 handle = getOwner(data);
+		datas[i] = data;
+		if(updated[handle])
+			values[i] = isMax(data) ? encodeMax(mBoxBoundsMinMax[handle], Axis, mContactDistance[handle]) : encodeMin(mBoxBoundsMinMax[handle], Axis, mContactDistance[handle]);
+		else
+			values[i] = endPointValues[i];
+	}
+
+	Cm::RadixSortBuffered RS;
+	const PxU32* Sorted = RS.Sort(values, numEndPoints, Cm::RADIX_UNSIGNED).GetRanks();
+
+	for(PxU32 i=0;i<numEndPoints;i++)
+	{
+		const PxU32 sortedIndex = Sorted[i];
+		const BpHandle data = datas[sortedIndex];
+		endPointValues[i] = values[sortedIndex];
+		endPointDatas[i] = data;
+		boxes[getOwner(data)].mMinMax[isMax(data)] = BpHandle(i+1);
+	}
+}
+
+PxU32 BroadPhaseSap::startPruningTasks(const AuxData* auxData0, const AuxData* auxData1, const PxU32 pass, const PxU32 nb, PxU32 nbTasks, PxU32 firstTask, PxBaseTask* continuation)
+{
+	if(!nb)
+		return 0;
+
+	nbTasks = PxClamp(nb/BP_SAP_MIN_NB_BOXES_PER_TASK, PxU32(1), nbTasks);
+	PX_ASSERT(firstTask+nbTasks<=BP_SAP_NB_PRUNING_TASKS);
+
+	const PxU32 nbPerTask = (nb + nbTasks - 1)/nbTasks;
+
+	PxU32 nbStarted = 0;
+	for(PxU32 i=0;i<nbTasks;i++)
+	{
+		const PxU32 start = i*nbPerTask;
+		if(start>=nb)
+			break;
+
+		BroadPhaseSapPruningTask& task = mPruningTasks[firstTask + nbStarted++];
+		task.mAuxData0 = auxData0;
+		task.mAuxData1 = auxData1;
+		task.mLUT = mFilter->getLUT();
+		task.mPass = pass;
+		task.mStart = start;
+		task.mEnd = PxMin(start + nbPerTask, nb);
+		task.mPairs.resetOrClear();
+		task.setContinuation(continuation);
+	}
+
+	for(PxU32 i=0;i<nbStarted;i++)
+		mPruningTasks[firstTask + i].removeReference();
+
+	return nbStarted;
+}
+
+void BroadPhaseSap::addRecordedPairs(PxU32 nbTasks)
+{
+	DataArray da(mData, mDataSize, mDataCapacity);
+
+	for(PxU32 i=0;i<nbTasks;i++)
+	{
+		const PxArray<BroadPhasePair>& pairs = mPruningTasks[i].mPairs;
+		const PxU32 nbPairs = pairs.size();
+		for(PxU32 j=0;j<nbPairs;j++)
+			addPair(pairs[j].mVolA, pairs[j].mVolB, mScratchAllocator, mPairs, da);
+	}
+
+	mData = da.mData;
+	mDataSize = da.mSize;
+	mDataCapacity = da.mCapacity;
+}
+
+void BroadPhaseSap::mergeRebuildPairs()
+{
+	// PT: after a full rebuild we don't know which pairs have been lost. We tag all of them as removed
+	// first, and the ones found again by the box pruning will be revived when we add them back.
+	{
+		DataArray da(mData, mDataSize, mDataCapacity);
+
+		const PxU32 nbActivePairs = mPairs.mNbActivePairs;
+		for(PxU32 i=0;i<nbActivePairs;i++)
+		{
+			const BroadPhasePair* UP = mPairs.mActivePairs + i;
+			PX_ASSERT(!mPairs.IsInArray(UP));
+			mPairs.SetInArray(UP);
+			mPairs.SetRemoved(UP);
+			da.AddData(i, mScratchAllocator);
+		}
+
+		mData = da.mData;
+		mDataSize = da.mSize;
+		mDataCapacity = da.mCapacity;
+	}
+
+	addRecordedPairs(mNbPruningTasks);
+	mNbPruningTasks = 0;
+
+	releaseAuxData();
+}
+
+void BroadPhaseSap::releaseAuxData()
+{
+	PX_DELETE(mAuxData[1]);
+	PX_DELETE(mAuxData[0]);
+}
+
+void BroadPhaseSap::updateStage(PxBaseTask* continuation)
+{
+	PX_PROFILE_ZONE("BroadPhase.SapUpdate", mContextID);
+
+	batchRemove();
+
+	//Check that the overlap pairs per axis have been reset.
+	PX_ASSERT(0==mBatchUpdateTasks[0].getPairsSize());
+	PX_ASSERT(0==mBatchUpdateTasks[1].getPairsSize());
+	PX_ASSERT(0==mBatchUpdateTasks[2].getPairsSize());
+
+	mFullRebuild = needsFullRebuild();
+	if(mFullRebuild)
+	{
+		for(PxU32 Axis=0;Axis<3;Axis++)
+		{
+			mAxisTasks[Axis].mRebuild = true;
+			mAxisTasks[Axis].setContinuation(continuation);
+		}
+		for(PxU32 Axis=0;Axis<3;Axis++)
+			mAxisTasks[Axis].removeReference();
+	}
+	else
+	{
+		mBatchUpdateTasks[0].runInternal();
+		mBatchUpdateTasks[1].runInternal();
+		mBatchUpdateTasks[2].runInternal();
+	}
+}
+
+void BroadPhaseSap::overlapStage(PxBaseTask* continuation)
+{
+	mNbPruningTasks = 0;
+	if(!mFullRebuild)
+		return;
+
+	PX_PROFILE_ZONE("BroadPhase.SapRebuildOverlaps", mContextID);
+
+	//Gather the sorted boxes along the preferred axis direction.
+	const PxU32 numBoxes = mBoxesSize - mCreatedSize;
+	TmpMem<BpHandle, 8> boxesIndicesSortedMem(numBoxes);
+	BpHandle* boxesIndicesSorted = boxesIndicesSortedMem.getBase();
+
+	const BpHandle* PX_RESTRICT endPointDatas = mEndPointDatas[0];
+	PxU32 boxCount = 0;
+	for(PxU32 i=1;i<=numBoxes*2;i++)
+	{
+		if(!isMax(endPointDatas[i]))
+			boxesIndicesSorted[boxCount++] = BpHandle(getOwner(endPointDatas[i]));
+	}
+	PX_ASSERT(boxCount==numBoxes);
+
+	mAuxData[0] = PX_NEW(AuxData)(boxCount, mBoxEndPts, boxesIndicesSorted, mBoxGroups);
+
+	mNbPruningTasks = startPruningTasks(mAuxData[0], NULL, 0, boxCount, BP_SAP_NB_PRUNING_TASKS, 0, continuation);
+}
+
+void BroadPhaseSap::postUpdateStage(PxBaseTask* continuation)
+{
+	PX_PROFILE_ZONE("BroadPhase.SapPostUpdate", mContextID);
+
+	if(mFullRebuild)
+		mergeRebuildPairs();
+	else
+		mergeUpdatePairs();
+
+	if(!mCreatedSize)
+		return;
+
+	//Insert new boxes into sorted endpoints lists.
+	for(PxU32 Axis=0;Axis<3;Axis++)
+	{
+		mAxisTasks[Axis].mRebuild = false;
+		mAxisTasks[Axis].setContinuation(continuation);
+	}
+	for(PxU32 Axis=0;Axis<3;Axis++)
+		mAxisTasks[Axis].removeReference();
+}
+
+void BroadPhaseSap::createStage(PxBaseTask* continuation)
+{
+	mNbPruningTasks = 0;
+	if(!mCreatedSize)
+		return;
+
+	PX_PROFILE_ZONE("BroadPhase.SapCreate", mContextID);
+
+	//Number of newly-created boxes and number of old boxes.
+	const PxU32 numNewBoxes = mCreatedSize;
+	const PxU32 numOldBoxes = mBoxesSize - mCreatedSize;
+
+	TmpMem<BpHandle, 8> oldBoxesIndicesSortedMem(numOldBoxes);
+	TmpMem<BpHandle, 8> newBoxesIndicesSortedMem(numNewBoxes);
+	BpHandle* oldBoxesIndicesSorted = oldBoxesIndicesSortedMem.getBase();
+	BpHandle* newBoxesIndicesSorted = newBoxesIndicesSortedMem.getBase();
+	PxU32 oldBoxCount = 0;
+	PxU32 newBoxCount = 0;
+
+	bool allNewBoxesStatics = false;
+	bool allOldBoxesStatics = false;
+	ComputeSortedLists(newBoxesIndicesSorted, newBoxCount, oldBoxesIndicesSorted, oldBoxCount, allNewBoxesStatics, allOldBoxesStatics);
+
+	//Intersect new boxes with new boxes and new boxes with existing boxes.
+	if(!allNewBoxesStatics || !allOldBoxesStatics)
+	{
+		mAuxData[0] = PX_NEW(AuxData)(newBoxCount, mBoxEndPts, newBoxesIndicesSorted, mBoxGroups);
+
+		PxU32 nbTasks = 0;
+		if(!allNewBoxesStatics)
+			nbTasks += startPruningTasks(mAuxData[0], NULL, 0, newBoxCount, BP_SAP_NB_PRUNING_TASKS/2, nbTasks, continuation);
+
+		if(numOldBoxes && oldBoxCount)
+		{
+			mAuxData[1] = PX_NEW(AuxData)(oldBoxCount, mBoxEndPts, oldBoxesIndicesSorted, mBoxGroups);
+
+			nbTasks += startPruningTasks(mAuxData[0], mAuxData[1], 0, newBoxCount, BP_SAP_NB_PRUNING_TASKS/4, nbTasks, continuation);
+			nbTasks += startPruningTasks(mAuxData[0], mAuxData[1], 1, oldBoxCount, BP_SAP_NB_PRUNING_TASKS/4, nbTasks, continuation);
+		}
+		mNbPruningTasks = nbTasks;
+	}
+}
+
+void BroadPhaseSap::finalizeStage(PxBaseTask*)
+{
+	PX_PROFILE_ZONE("BroadPhase.SapFinalize", mContextID);
+
+	addRecordedPairs(mNbPruningTasks);
+	mNbPruningTasks = 0;
+
+	releaseAuxData();
+
+	finalizeUpdate();
+}
+
 #if PX_DEBUG
 
 bool BroadPhaseSap::isSelfOrdered() const 
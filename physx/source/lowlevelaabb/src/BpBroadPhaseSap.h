@@ -44,6 +44,11 @@ namespace Gu
 	class Axes;
 }
 
+namespace Cm
+{
+	class RadixSortBuffered;
+}
+
 namespace Bp
 {
 
@@ -88,6 +93,61 @@ private:
 	PxU32 mPairsCapacity;
 };
 
+// PT: tasks for the multithreaded version (PxBroadPhaseType::ePSAP)
+class BroadPhaseSapAxisTask : public Cm::Task
+{
+public:
+
+	BroadPhaseSapAxisTask(PxU64 contextId=0) :
+		Cm::Task	(contextId),
+		mSap		(NULL),
+		mAxis		(0xffffffff),
+		mRebuild	(false)
+	{
+	}
+
+	virtual void runInternal();
+
+	virtual const char* getName() const { return mRebuild ? "BpBroadphaseSap.rebuildAxis" : "BpBroadphaseSap.insertAxis"; }
+
+	void set(class BroadPhaseSap* sap, const PxU32 axis) {mSap = sap; mAxis = axis;}
+
+	class BroadPhaseSap* mSap;
+	PxU32 mAxis;
+	bool mRebuild;
+};
+
+class BroadPhaseSapPruningTask : public Cm::Task
+{
+public:
+
+	BroadPhaseSapPruningTask(PxU64 contextId=0) :
+		Cm::Task	(contextId),
+		mAuxData0	(NULL),
+		mAuxData1	(NULL),
+		mLUT		(NULL),
+		mPass		(0),
+		mStart		(0),
+		mEnd		(0)
+	{
+	}
+
+	virtual void runInternal();
+
+	virtual const char* getName() const { return "BpBroadphaseSap.boxPruning"; }
+
+	const AuxData* mAuxData0;
+	const AuxData* mAuxData1;	// NULL for complete box pruning
+	const bool* mLUT;
+	PxU32 mPass;
+	PxU32 mStart;
+	PxU32 mEnd;
+
+	PxArray<BroadPhasePair> mPairs;
+};
+
+#define BP_SAP_NB_PRUNING_TASKS	16
+
 //KS - TODO, this could be reduced to U16 in smaller scenes
 struct BroadPhaseActivityPocket
 {
@@ -104,12 +164,14 @@ public:
 	friend class BroadPhaseBatchUpdateWorkTask;
 	friend class SapUpdateWorkTask;
 	friend class SapPostUpdateWorkTask;
+	friend class BroadPhaseSapAxisTask;
+	friend class BroadPhaseSapPruningTask;
 
-										BroadPhaseSap(const PxU32 maxNbBroadPhaseOverlaps, const PxU32 maxNbStaticShapes, const PxU32 maxNbDynamicShapes, PxU64 contextID);
+										BroadPhaseSap(const PxU32 maxNbBroadPhaseOverlaps, const PxU32 maxNbStaticShapes, const PxU32 maxNbDynamicShapes, PxU64 contextID, bool enableMT);
 	virtual								~BroadPhaseSap();
 
 	// BroadPhase
-	virtual	PxBroadPhaseType::Enum		getType()					const	PX_OVERRIDE	PX_FINAL	{ return PxBroadPhaseType::eSAP;	}
+	virtual	PxBroadPhaseType::Enum		getType()					const	PX_OVERRIDE	PX_FINAL	{ return mEnableMT ? PxBroadPhaseType::ePSAP : PxBroadPhaseType::eSAP;	}
 	virtual	void						release()							PX_OVERRIDE	PX_FINAL;
 	virtual	void						update(PxcScratchAllocator* scratchAllocator, const BroadPhaseUpdateData& updateData, physx::PxBaseTask* continuation)	PX_OVERRIDE	PX_FINAL;
 	virtual	void						preBroadPhase(const Bp::BroadPhaseUpdateData&)	PX_OVERRIDE	PX_FINAL	{}
@@ -197,7 +259,37 @@ private:
 
 			BroadPhaseBatchUpdateWorkTask mBatchUpdateTasks[3];
 
+	//Multithreaded version.
+			void						mergeUpdatePairs();
+			void						finalizeUpdate();
+			void						insertCreatedEndPoints(const PxU32 Axis, Cm::RadixSortBuffered& RS, ValType* newEPSortedValues, ValType* bufferValues);
+			bool						needsFullRebuild()	const;
+			void						rebuildAxis(const PxU32 Axis);
+			void						mergeRebuildPairs();
+			PxU32						startPruningTasks(const AuxData* auxData0, const AuxData* auxData1, const PxU32 pass, const PxU32 nb, PxU32 nbTasks, PxU32 firstTask, PxBaseTask* continuation);
+			void						addRecordedPairs(PxU32 nbTasks);
+			void						releaseAuxData();
+
+			void						updateStage(PxBaseTask* continuation);
+			void						overlapStage(PxBaseTask* continuation);
+			void						postUpdateStage(PxBaseTask* continuation);
+			void						createStage(PxBaseTask* continuation);
+			void						finalizeStage(PxBaseTask* continuation);
+
+			Cm::DelegateTask<BroadPhaseSap, &BroadPhaseSap::updateStage>		mUpdateStageTask;
+			Cm::DelegateTask<BroadPhaseSap, &BroadPhaseSap::overlapStage>		mOverlapStageTask;
+			Cm::DelegateTask<BroadPhaseSap, &BroadPhaseSap::postUpdateStage>	mPostUpdateStageTask;
+			Cm::DelegateTask<BroadPhaseSap, &BroadPhaseSap::createStage>		mCreateStageTask;
+			Cm::DelegateTask<BroadPhaseSap, &BroadPhaseSap::finalizeStage>		mFinalizeStageTask;
+
+			BroadPhaseSapAxisTask		mAxisTasks[3];
+			BroadPhaseSapPruningTask	mPruningTasks[BP_SAP_NB_PRUNING_TASKS];
+			PxU32						mNbPruningTasks;
+			AuxData*					mAuxData[2];
+			bool						mFullRebuild;
+
 			const PxU64					mContextID;
+			const bool					mEnableMT;
 #if PX_DEBUG
 			bool						isSelfOrdered() const;
 			bool						isSelfConsistent() const;
@@ -676,6 +676,8 @@ struct AddPairParams
 	{
 	}
 
+	PX_FORCE_INLINE	void	outputPair(const BpHandle id0, const BpHandle id1);
+
 	const PxU32*			mRemap0;
 	const PxU32*			mRemap1;
 	PxcScratchAllocator*	mScratchAllocator;
@@ -704,6 +706,32 @@ static void addPair(const AddPairParams* PX_RESTRICT params, const BpHandle id0_
 	pairManager.ClearRemoved(UP);
 }
 
+PX_FORCE_INLINE void AddPairParams::outputPair(const BpHandle id0, const BpHandle id1)
+{
+	addPair(this, id0, id1);
+}
+
+// PT: same as AddPairParams but only records the pairs, for the multithreaded version. The recorded pairs are added
+// to the pair manager later, from a single thread and in the same order as the single-threaded code would have done it.
+struct RecordPairParams
+{
+	RecordPairParams(const PxU32* remap0, const PxU32* remap1, PxArray<BroadPhasePair>* pairs) :
+		mRemap0	(remap0),
+		mRemap1	(remap1),
+		mPairs	(pairs)
+	{
+	}
+
+	PX_FORCE_INLINE	void	outputPair(const BpHandle id0, const BpHandle id1)
+	{
+		mPairs->pushBack(BroadPhasePair(BpHandle(mRemap0[id0]), BpHandle(mRemap1[id1])));
+	}
+
+	const PxU32*				mRemap0;
+	const PxU32*				mRemap1;
+	PxArray<BroadPhasePair>*	mPairs;
+};
+
 // PT: TODO: use SIMD
 
 AuxData::AuxData(PxU32 nb, const SapBox1D*const* PX_RESTRICT boxes, const BpHandle* PX_RESTRICT indicesSorted, const Bp::FilterGroup::Enum* PX_RESTRICT groupIds)
@@ -757,63 +785,80 @@ AuxData::~AuxData()
 	PX_FREE(mBoxX);
 }
 
-void performBoxPruningNewNew(	const AuxData* PX_RESTRICT auxData, PxcScratchAllocator* scratchAllocator,
-								const bool* lut, SapPairManager& pairManager, BpHandle*& dataArray, PxU32& dataArraySize, PxU32& dataArrayCapacity)
+// PT: box pruning of boxes [start;end[ against all the following boxes. Processing the whole array in one go is
+// equivalent to processing it in consecutive ranges, which is what the multithreaded version relies on.
+template<class ParamsT>
+static void completeBoxPruning(const AuxData* PX_RESTRICT auxData, const PxU32 start, const PxU32 end, const bool* lut, ParamsT& params)
 {
-	const PxU32 nb = auxData->mNb;
-	if(!nb)
-		return;
+	PX_UNUSED(lut);
 
-	DataArray da(dataArray, dataArraySize, dataArrayCapacity);
-
-	START_STATS
-	{
-		BoxX* boxX = auxData->mBoxX;
-		BoxYZ* boxYZ = auxData->mBoxYZ;
-		Bp::FilterGroup::Enum* groups = auxData->mGroups;
-		PxU32* remap = auxData->mRemap;
+	const PxU32 nb = auxData->mNb;
 
-		AddPairParams params(remap, remap, scratchAllocator, &pairManager, &da);
+	const BoxX* boxX = auxData->mBoxX;
+	const BoxYZ* boxYZ = auxData->mBoxYZ;
+#if BP_SAP_TEST_GROUP_ID_CREATEUPDATE
+	const Bp::FilterGroup::Enum* groups = auxData->mGroups;
+#endif
 
-		PxU32 runningIndex = 0;
-		PxU32 index0 = 0;
+	// PT: the running index is always equal to index0 at the start of each iteration (the sorted boxes
+	// start with the box itself), so we can start from any index in the array.
+	PxU32 runningIndex = start;
+	PxU32 index0 = start;
 
-		while(runningIndex<nb && index0<nb)
-		{
+	while(runningIndex<nb && index0<end)
+	{
 #if BP_SAP_TEST_GROUP_ID_CREATEUPDATE
-			const Bp::FilterGroup::Enum group0 = groups[index0];
+		const Bp::FilterGroup::Enum group0 = groups[index0];
 #endif
-			const BoxX& boxX0 = boxX[index0];
+		const BoxX& boxX0 = boxX[index0];
 
-			const BpHandle minLimit = boxX0.mMinX;
-			while(boxX[runningIndex++].mMinX<minLimit);
+		const BpHandle minLimit = boxX0.mMinX;
+		while(boxX[runningIndex++].mMinX<minLimit);
 
-			const BpHandle maxLimit = boxX0.mMaxX;
-			PxU32 index1 = runningIndex;
-			while(boxX[index1].mMinX <= maxLimit)
-			{
-				INCREASE_STATS_NB_ITER
+		const BpHandle maxLimit = boxX0.mMaxX;
+		PxU32 index1 = runningIndex;
+		while(boxX[index1].mMinX <= maxLimit)
+		{
+			INCREASE_STATS_NB_ITER
 #if BP_SAP_TEST_GROUP_ID_CREATEUPDATE
-				if(groupFiltering(group0, groups[index1], lut))
+			if(groupFiltering(group0, groups[index1], lut))
 #endif
+			{
+				INCREASE_STATS_NB_TESTS
+				if(intersect2D(boxYZ[index0], boxYZ[index1]))
+/*				__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&boxYZ[index0].mMinY));
+				b = _mm_shuffle_epi32(b, 78);
+				const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&boxYZ[index1].mMinY));
+				const __m128i d = _mm_cmpgt_epi32(a, b);
+				const int mask = _mm_movemask_epi8(d);
+				if(mask==0x0000ff00)*/
 				{
-					INCREASE_STATS_NB_TESTS
-					if(intersect2D(boxYZ[index0], boxYZ[index1]))
-/*					__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&boxYZ[index0].mMinY));
-					b = _mm_shuffle_epi32(b, 78);
-					const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&boxYZ[index1].mMinY));
-					const __m128i d = _mm_cmpgt_epi32(a, b);
-					const int mask = _mm_movemask_epi8(d);
-					if(mask==0x0000ff00)*/
-					{
-						INCREASE_STATS_NB_PAIRS
-						addPair(&params, index0, index1);
-					}
+					INCREASE_STATS_NB_PAIRS
+					params.outputPair(index0, index1);
 				}
-				index1++;
 			}
-			index0++;
+			index1++;
 		}
+		index0++;
+	}
+}
+
+void performBoxPruningNewNew(	const AuxData* PX_RESTRICT auxData, PxcScratchAllocator* scratchAllocator,
+								const bool* lut, SapPairManager& pairManager, BpHandle*& dataArray, PxU32& dataArraySize, PxU32& dataArrayCapacity)
+{
+	const PxU32 nb = auxData->mNb;
+	if(!nb)
+		return;
+
+	DataArray da(dataArray, dataArraySize, dataArrayCapacity);
+
+	START_STATS
+	{
+		const PxU32* remap = auxData->mRemap;
+
+		AddPairParams params(remap, remap, scratchAllocator, &pairManager, &da);
+
+		completeBoxPruning(auxData, 0, nb, lut, params);
 	}
 	DUMP_STATS
 
@@ -822,18 +867,47 @@ void performBoxPruningNewNew(	const AuxData* PX_RESTRICT auxData, PxcScratchAllo
 	dataArrayCapacity = da.mCapacity;
 }
 
+void performBoxPruningNewNew(const AuxData* PX_RESTRICT auxData, const PxU32 start, const PxU32 end, const bool* lut, PxArray<BroadPhasePair>& pairs)
+{
+	PX_ASSERT(start<=end && end<=auxData->mNb);
+
+	RecordPairParams params(auxData->mRemap, auxData->mRemap, &pairs);
+
+	completeBoxPruning(auxData, start, end, lut, params);
+}
+
+// PT: returns the running index that the bipartite loop below would have reached when processing box "index0".
 template<int codepath>
+static PxU32 findRunningIndex(const BoxX* PX_RESTRICT boxX1, const PxU32 nb1, const BpHandle minLimit)
+{
+	PxU32 low = 0;
+	PxU32 high = nb1;
+	while(low<high)
+	{
+		const PxU32 mid = (low+high)>>1;
+		const bool before = codepath ? boxX1[mid].mMinX<=minLimit : boxX1[mid].mMinX<minLimit;
+		if(before)
+			low = mid+1;
+		else
+			high = mid;
+	}
+	return low;
+}
+
+template<int codepath, class ParamsT>
 static void bipartitePruning(
-	const PxU32 nb0, const BoxX* PX_RESTRICT boxX0, const BoxYZ* PX_RESTRICT boxYZ0, const PxU32* PX_RESTRICT remap0, const Bp::FilterGroup::Enum* PX_RESTRICT groups0,
-	const PxU32 nb1, const BoxX* PX_RESTRICT boxX1, const BoxYZ* PX_RESTRICT boxYZ1, const PxU32* PX_RESTRICT remap1, const Bp::FilterGroup::Enum* PX_RESTRICT groups1,
-	const bool* lut, PxcScratchAllocator* scratchAllocator, SapPairManager& pairManager, DataArray& dataArray)
+	const PxU32 nb0, const BoxX* PX_RESTRICT boxX0, const BoxYZ* PX_RESTRICT boxYZ0, const Bp::FilterGroup::Enum* PX_RESTRICT groups0,
+	const PxU32 nb1, const BoxX* PX_RESTRICT boxX1, const BoxYZ* PX_RESTRICT boxYZ1, const Bp::FilterGroup::Enum* PX_RESTRICT groups1,
+	const PxU32 start, const PxU32 end, const bool* lut, ParamsT& params)
 {
-	AddPairParams params(remap0, remap1, scratchAllocator, &pairManager, &dataArray);
+	PX_UNUSED(nb0);
+	PX_UNUSED(lut);
+	PX_ASSERT(start<=end && end<=nb0);
 
-	PxU32 runningIndex = 0;
-	PxU32 index0 = 0;
+	PxU32 runningIndex = start ? findRunningIndex<codepath>(boxX1, nb1, boxX0[start].mMinX) : 0;
+	PxU32 index0 = start;
 
-	while(runningIndex<nb1 && index0<nb0)
+	while(runningIndex<nb1 && index0<end)
 	{
 #if BP_SAP_TEST_GROUP_ID_CREATEUPDATE
 		const Bp::FilterGroup::Enum group0 = groups0[index0];
@@ -864,7 +938,7 @@ static void bipartitePruning(
 				if(intersect2D(boxYZ0[index0], boxYZ1[index1]))
 				{
 					INCREASE_STATS_NB_PAIRS
-					addPair(&params, index0, index1);
+					params.outputPair(index0, index1);
 				}
 			}
 			index1++;
@@ -895,8 +969,11 @@ void performBoxPruningNewOld(	const AuxData* PX_RESTRICT auxData0, const AuxData
 		const BoxYZ* boxYZ1 = auxData1->mBoxYZ;
 		const Bp::FilterGroup::Enum* groups1 = auxData1->mGroups;
 		const PxU32* remap1 = auxData1->mRemap;
-		bipartitePruning<0>(nb0, boxX0, boxYZ0, remap0, groups0, nb1, boxX1, boxYZ1, remap1, groups1, lut, scratchAllocator, pairManager, da);
-		bipartitePruning<1>(nb1, boxX1, boxYZ1, remap1, groups1, nb0, boxX0, boxYZ0, remap0, groups0, lut, scratchAllocator, pairManager, da);
+
+		AddPairParams params01(remap0, remap1, scratchAllocator, &pairManager, &da);
+		AddPairParams params10(remap1, remap0, scratchAllocator, &pairManager, &da);
+		bipartitePruning<0>(nb0, boxX0, boxYZ0, groups0, nb1, boxX1, boxYZ1, groups1, 0, nb0, lut, params01);
+		bipartitePruning<1>(nb1, boxX1, boxYZ1, groups1, nb0, boxX0, boxYZ0, groups0, 0, nb1, lut, params10);
 	}
 	DUMP_STATS
 
@@ -905,6 +982,29 @@ void performBoxPruningNewOld(	const AuxData* PX_RESTRICT auxData0, const AuxData
 	dataArrayCapacity = da.mCapacity;
 }
 
+void performBoxPruningNewOld(	const AuxData* PX_RESTRICT auxData0, const AuxData* PX_RESTRICT auxData1, const PxU32 pass, const PxU32 start, const PxU32 end,
+								const bool* lut, PxArray<BroadPhasePair>& pairs)
+{
+	PX_ASSERT(pass<2);
+
+	const PxU32 nb0 = auxData0->mNb;
+	const PxU32 nb1 = auxData1->mNb;
+
+	if(!nb0 || !nb1)
+		return;
+
+	if(!pass)
+	{
+		RecordPairParams params(auxData0->mRemap, auxData1->mRemap, &pairs);
+		bipartitePruning<0>(nb0, auxData0->mBoxX, auxData0->mBoxYZ, auxData0->mGroups, nb1, auxData1->mBoxX, auxData1->mBoxYZ, auxData1->mGroups, start, end, lut, params);
+	}
+	else
+	{
+		RecordPairParams params(auxData1->mRemap, auxData0->mRemap, &pairs);
+		bipartitePruning<1>(nb1, auxData1->mBoxX, auxData1->mBoxYZ, auxData1->mGroups, nb0, auxData0->mBoxX, auxData0->mBoxYZ, auxData0->mGroups, start, end, lut, params);
+	}
+}
+
 } //namespace Bp
 
 } //namespace physx
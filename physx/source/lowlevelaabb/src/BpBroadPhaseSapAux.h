@@ -35,6 +35,7 @@
 #include "BpBroadPhase.h"
 #include "BpBroadPhaseIntegerAABB.h"
 #include "foundation/PxBitMap.h"
+#include "foundation/PxArray.h"
 
 namespace physx
 {
@@ -242,7 +243,7 @@ void ComputeCreatedDeletedPairsLists
 		PxU32	mMaxZ;
 	};
 
-	struct AuxData
+	struct AuxData : public PxUserAllocated
 	{
 		AuxData(PxU32 nb, const SapBox1D*const* PX_RESTRICT boxes, const BpHandle* PX_RESTRICT indicesSorted, const Bp::FilterGroup::Enum* PX_RESTRICT groupIds);
 		~AuxData();
@@ -260,6 +261,13 @@ void performBoxPruningNewNew(	const AuxData* PX_RESTRICT auxData, PxcScratchAllo
 void performBoxPruningNewOld(	const AuxData* PX_RESTRICT auxData0, const AuxData* PX_RESTRICT auxData1, PxcScratchAllocator* scratchAllocator,
 								const bool* lut, SapPairManager& pairManager, BpHandle*& dataArray, PxU32& dataArraySize, PxU32& dataArrayCapacity);
 
+// PT: multithreaded versions. These only process boxes [start;end[ of the first array (or of the second array for the second
+// pass of the new-vs-old case), and record the overlapping pairs instead of adding them to the pair manager.
+void performBoxPruningNewNew(	const AuxData* PX_RESTRICT auxData, const PxU32 start, const PxU32 end, const bool* lut, PxArray<BroadPhasePair>& pairs);
+
+void performBoxPruningNewOld(	const AuxData* PX_RESTRICT auxData0, const AuxData* PX_RESTRICT auxData1, const PxU32 pass, const PxU32 start, const PxU32 end,
+								const bool* lut, PxArray<BroadPhasePair>& pairs);
+
 PX_FORCE_INLINE bool Intersect2D_Handle
 (const BpHandle bDir1Min, const BpHandle bDir1Max, const BpHandle bDir2Min, const BpHandle bDir2Max,
  const BpHandle cDir1Min, const BpHandle cDir1Max, const BpHandle cDir2Min, const BpHandle cDir2Max)
@@ -49,6 +49,9 @@
 
 #define DY_STATIC_CONTACTS_IN_INTERNAL_SOLVER true
 
+//Number of articulations with the same topology that computeUnconstrainedVelocitiesInternalBatch() processes together.
+#define DY_ARTICULATION_BATCH_WIDTH 4
+
 namespace physx
 {
 
@@ -676,6 +679,9 @@ namespace Dy
 
 		void		getGeneralizedMassMatrixCRB(PxArticulationCache& cache);
 
+		//mass matrix, bias forces (gravity, coriolis and centrifugal) and dense jacobian as output, only runs commonInit if the pose changed
+		void		getInverseDynamics(const PxVec3& gravity, PxArticulationCache& cache, PxArticulationInverseDynamicsFlags flags, PxU32& nRows, PxU32& nCols);
+
 		bool storeStaticConstraint(const PxSolverConstraintDesc& desc);
 
 		bool		willStoreStaticConstraint() { return DY_STATIC_CONTACTS_IN_INTERNAL_SOLVER; }
@@ -731,6 +737,25 @@ namespace Dy
 			PxReal dt, const PxVec3& gravity,
 			PxReal invLengthScale, bool externalForcesEveryTgsIterationEnabled);
 
+		/**
+		\brief Equivalent of calling computeUnconstrainedVelocities() on each descriptor. Articulations with the same topology
+		are batched, see computeUnconstrainedVelocitiesInternalBatch().
+		\param[out] internalConstraintCounts receives the value computeUnconstrainedVelocities() returns, one entry per descriptor.
+		*/
+		static void computeUnconstrainedVelocitiesBatch(
+			const ArticulationSolverDesc* descs, PxU32 nbDescs,
+			PxReal dt, const PxVec3& gravity, PxReal invLengthScale,
+			PxU32* internalConstraintCounts);
+
+		/**
+		\brief Equivalent of calling computeUnconstrainedVelocitiesTGS() on each descriptor. Articulations with the same topology
+		are batched, see computeUnconstrainedVelocitiesInternalBatch().
+		*/
+		static void computeUnconstrainedVelocitiesTGSBatch(
+			const ArticulationSolverDesc* descs, PxU32 nbDescs,
+			PxReal dt, const PxVec3& gravity,
+			PxReal invLengthScale, bool externalForcesEveryTgsIterationEnabled);
+
 		static PxU32 setupSolverConstraintsTGS(const ArticulationSolverDesc& articDesc,
 			PxReal dt,
 			PxReal invDt,
@@ -876,9 +901,40 @@ namespace Dy
 
 		void updateArticulation(const PxVec3& gravity, PxReal invLengthScale, bool externalForcesEveryTgsIterationEnabled);
 
+		//The stages of updateArticulation(), in the order they must run. They are exposed separately so that the
+		//batched path can run the articulated inertia and response matrix sweeps on several articulations at once.
+		void updateArticulationLinkStates(const PxVec3& gravity, PxReal invLengthScale, bool externalForcesEveryTgsIterationEnabled);
+		void updateArticulatedInertia(bool externalForcesEveryTgsIterationEnabled);
+		void updateArticulatedResponseMatrix();
+		void updateArticulationAccelerations();
+
 		void computeUnconstrainedVelocitiesInternal(
 			const PxVec3& gravity, PxReal invLengthScale, bool externalForcesEveryTgsIterationEnabled = false);
 
+		//computeUnconstrainedVelocitiesInternal() is beginUnconstrainedVelocities(), updateArticulation(), endUnconstrainedVelocities().
+		void beginUnconstrainedVelocities();
+		void endUnconstrainedVelocities();
+
+		/**
+		\brief Batched equivalent of calling computeUnconstrainedVelocitiesInternal() on each articulation.
+		Articulations that share a topology are processed in groups of up to DY_ARTICULATION_BATCH_WIDTH, with the articulated
+		inertia and response matrix sweeps running on the whole group at once (one articulation per SIMD lane). The results
+		are identical to the unbatched path.
+		\param[in] articulations is the array of articulations. Their dt must be set and jcalc() must be up to date.
+		\param[in] nbArticulations is the number of articulations.
+		*/
+		static void computeUnconstrainedVelocitiesInternalBatch(
+			FeatherstoneArticulation* const* articulations, PxU32 nbArticulations,
+			const PxVec3& gravity, PxReal invLengthScale, bool externalForcesEveryTgsIterationEnabled);
+
+		//Returns true if a and b can share a SIMD batch, i.e. their links, parents, joint types and dof layouts match.
+		static bool haveSameBatchTopology(const ArticulationData& a, const ArticulationData& b);
+
+		//SIMD equivalents of computeArticulatedSpatialInertiaAndZ() and computeArticulatedResponseMatrix() for 2 to
+		//DY_ARTICULATION_BATCH_WIDTH articulations with the same batch topology.
+		static void computeArticulatedSpatialInertiaAndZBatch(FeatherstoneArticulation* const* articulations, PxU32 nbArticulations, bool externalForcesEveryTgsIterationEnabled);
+		static void computeArticulatedResponseMatrixBatch(FeatherstoneArticulation* const* articulations, PxU32 nbArticulations);
+
 		//copy joint data from fromJointData to toJointData
 		void copyJointData(const ArticulationData& data, PxReal* toJointData, const PxReal* fromJointData);
 
@@ -1151,6 +1207,17 @@ namespace Dy
 			 const Cm::SpatialVectorF* jointDofISW, const InvStIs* linkInvStISW, const Cm::SpatialVectorF* jointDofIsInvDW, 
 			 ArticulationLink* links, TestImpulseResponse* linkResponsesW);
 
+		/*
+		\brief Compute the response matrix of the root link, the first step of computeArticulatedResponseMatrix().
+		\param[in] articulationFlags describes whether the articulation has a fixed base.
+		\param[in] baseInvArticulatedInertiaW is the inverse of the articulated spatial inertia of the root link.
+		\param[out] links is an array of articulation links. The cfm value of the root link will be updated.
+		\param[out] linkResponsesW is an array of link responses. Only the root link entry is written.
+		*/
+		static void computeRootResponseMatrix
+			(const PxArticulationFlags& articulationFlags, const SpatialMatrix& baseInvArticulatedInertiaW,
+			 ArticulationLink* links, TestImpulseResponse* linkResponsesW);
+
 		void computeArticulatedSpatialZ(ArticulationData& data, ScratchData& scratchData);
 
 
@@ -1358,6 +1425,14 @@ namespace Dy
 
 		void calculateHFloatingBase(PxArticulationCache& cache);
 
+		//gravity as input, joint force of a fixed base articulation as output
+		void computeGravityForceFixBase(const PxVec3& gravity, PxReal* jointForces, PxcScratchAllocator* allocator);
+
+		//gravity and joint velocity as input, joint force as output
+		void computeBiasForce(const PxVec3& gravity, PxArticulationCache& cache);
+
+		void computeDenseJacobianInternal(PxArticulationCache& cache, PxU32& nRows, PxU32& nCols);
+
 		//joint limits
 		static void enforcePrismaticLimits(PxReal& jPosition, ArticulationJointCore* joint);
 
@@ -1551,6 +1626,7 @@ namespace Dy
 		PxArray<PxSolverConstraintDesc> mStatic1DConstraints;
 		PxU32							mGPUDirtyFlags;
 		bool							mJcalcDirty;
+		bool							mSpatialInertiaDirty;	//the coefficient matrix queries overwrite the spatial inertias computed by initializeCommonData()
 
 		Dy::ErrorAccumulator			mInternalErrorAccumulatorVelIter;
 		Dy::ErrorAccumulator			mContactErrorAccumulatorVelIter;
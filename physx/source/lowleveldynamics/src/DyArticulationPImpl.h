@@ -50,6 +50,16 @@ public:
 		return FeatherstoneArticulation::computeUnconstrainedVelocities(desc, dt, acCount, gravity, invLengthScale);
 	}
 
+	static void computeUnconstrainedVelocitiesBatch(const ArticulationSolverDesc* descs,
+											PxU32 nbDescs,
+											PxReal dt,
+											const PxVec3& gravity, 
+											const PxReal invLengthScale,
+											PxU32* internalConstraintCounts)
+	{
+		FeatherstoneArticulation::computeUnconstrainedVelocitiesBatch(descs, nbDescs, dt, gravity, invLengthScale, internalConstraintCounts);
+	}
+
 	static void	updateBodies(const ArticulationSolverDesc& desc, Cm::SpatialVectorF* tempDeltaV,
 						 PxReal dt)
 	{
@@ -81,6 +91,16 @@ public:
 		FeatherstoneArticulation::computeUnconstrainedVelocitiesTGS(desc, dt, gravity, invLengthScale, externalForcesEveryTgsIterationEnabled);
 	}
 
+	static void computeUnconstrainedVelocitiesTGSBatch(const ArticulationSolverDesc* descs,
+		PxU32 nbDescs,
+		PxReal dt,
+		const PxVec3& gravity,
+		PxReal invLengthScale,
+		bool externalForcesEveryTgsIterationEnabled)
+	{
+		FeatherstoneArticulation::computeUnconstrainedVelocitiesTGSBatch(descs, nbDescs, dt, gravity, invLengthScale, externalForcesEveryTgsIterationEnabled);
+	}
+
 	static void	updateDeltaMotion(const ArticulationSolverDesc& desc, const PxReal dt, Cm::SpatialVectorF* DeltaV, const PxReal totalInvDt)
 	{
 		FeatherstoneArticulation::recordDeltaMotion(desc, dt, DeltaV, totalInvDt);
@@ -752,16 +752,18 @@ public:
 
 		const PxReal invLengthScale = 1.f/mContext.getLengthScale();
 
+		PX_ASSERT(mNbToProcess <= NbArticulationsPerTask);
+		PxU32 descCounts[NbArticulationsPerTask];
+
+		//Articulations sharing a topology get their forward dynamics computed in SIMD batches.
+		ArticulationPImpl::computeUnconstrainedVelocitiesBatch(mArticulationDescArray, mNbToProcess, mContext.mDt,
+			mContext.getGravity(), invLengthScale, descCounts);
+
 		for(PxU32 i=0;i<mNbToProcess; i++)
 		{
 			FeatherstoneArticulation& a = *(mArticulations[i]);
 
-			PxU32 acCount, descCount;
-			
-			descCount = ArticulationPImpl::computeUnconstrainedVelocities(mArticulationDescArray[i], mContext.mDt,
-				acCount, mContext.getGravity(), invLengthScale);
-
-			mArticulationDescArray[i].numInternalConstraints = PxTo8(descCount);
+			mArticulationDescArray[i].numInternalConstraints = PxTo8(descCounts[i]);
 
 			const PxU16 iterWord = a.getIterationCounts();
 			maxVelIters = PxMax<PxU32>(PxU32(iterWord >> 8),	maxVelIters);
@@ -249,7 +249,7 @@ namespace Dy
 
 	FeatherstoneArticulation::FeatherstoneArticulation(void* userData)
 		: mUserData(userData), mContext(NULL), mUpdateSolverData(true),
-		mMaxDepth(0), mJcalcDirty(true)
+		mMaxDepth(0), mJcalcDirty(true), mSpatialInertiaDirty(true)
 	{
 		mGPUDirtyFlags = 0;
 		mInternalErrorAccumulatorVelIter.reset();
@@ -3228,6 +3228,9 @@ namespace Dy
 
 	void FeatherstoneArticulation::teleportLinks(ArticulationData& data)
 	{
+		//the link poses change so the inverse dynamics data needs to be recomputed
+		mArticulationData.setDataDirty(true);
+
 		ArticulationLink* links = mArticulationData.getLinks();
 	
 		ArticulationJointCoreData* jointData = mArticulationData.getJointData();
@@ -3770,6 +3773,12 @@ namespace Dy
 		//jcalc(mArticulationData);
 		initializeCommonData();
 
+		computeDenseJacobianInternal(cache, nRows, nCols);
+	}
+
+	//expects initializeCommonData() to have been called for the current pose
+	void FeatherstoneArticulation::computeDenseJacobianInternal(PxArticulationCache& cache, PxU32 & nRows, PxU32 & nCols)
+	{
 		const PxU32 linkCount = mArticulationData.getLinkCount();
 		ArticulationLink* links = mArticulationData.getLinks();
 
@@ -3865,8 +3874,6 @@ namespace Dy
 
 			linkDatum.maxPenBias = bodyCore.maxPenBias;
 
-			const PxTransform& body2World = bodyCore.body2World;
-
 			const ArticulationJointCoreData& jointDatum = mArticulationData.getJointData(linkID);
 			const PxU32 parentLinkID = link.parent;
 
@@ -3916,13 +3923,13 @@ namespace Dy
 				}
 			}
 
-			//diagonal block:
+			//diagonal block: the world space motion matrix has been computed in initializeCommonData()
 			for (PxU32 ind = 0; ind < jointDatum.dof; ++ind)
 			{
-				const Cm::UnAlignedSpatialVector& v = mArticulationData.mMotionMatrix[jointDatum.jointOffset + ind];
+				const Cm::UnAlignedSpatialVector& v = mArticulationData.mWorldMotionMatrix[jointDatum.jointOffset + ind];
 
-				const PxVec3 ang = body2World.rotate(v.top);
-				const PxVec3 lin = body2World.rotate(v.bottom);
+				const PxVec3& ang = v.top;
+				const PxVec3& lin = v.bottom;
 
 				jacobian(destRow + 0, destCol) = lin.x;
 				jacobian(destRow + 1, destCol) = lin.y;
@@ -5280,6 +5287,8 @@ namespace Dy
 		//make sure motionMatrix has been set
 		//jcalc(mArticulationData);
 
+		mArticulationData.setDataDirty(true);
+
 		const PxU32 linkCount = mArticulationData.getLinkCount();
 		ArticulationLink* links = mArticulationData.getLinks();
 		PxReal* jointPositions = mArticulationData.getJointPositions();
@@ -865,24 +865,7 @@ namespace Dy
 
 		//The input expected is a local-space impulse and the output is a local-space impulse response vector
 
-		if (articulationFlags & PxArticulationFlag::eFIX_BASE)
-		{
-			//Fixed base, so response is zero
-			PxMemZero(testImpulseResponsesW, sizeof(TestImpulseResponse));
-		}
-		else
-		{
-			//Compute impulse response matrix. Compute the impulse response of unit responses on all 6 axes...
-			const PxMat33& bottomRight = baseInvArticulatedInertiaW.getBottomRight();
-			testImpulseResponsesW[0].linkDeltaVTestImpulseResponses[0] = Cm::SpatialVectorF(baseInvArticulatedInertiaW.topLeft.column0, baseInvArticulatedInertiaW.bottomLeft.column0);
-			testImpulseResponsesW[0].linkDeltaVTestImpulseResponses[1] = Cm::SpatialVectorF(baseInvArticulatedInertiaW.topLeft.column1, baseInvArticulatedInertiaW.bottomLeft.column1);
-			testImpulseResponsesW[0].linkDeltaVTestImpulseResponses[2] = Cm::SpatialVectorF(baseInvArticulatedInertiaW.topLeft.column2, baseInvArticulatedInertiaW.bottomLeft.column2);
-			testImpulseResponsesW[0].linkDeltaVTestImpulseResponses[3] = Cm::SpatialVectorF(baseInvArticulatedInertiaW.topRight.column0, bottomRight.column0);
-			testImpulseResponsesW[0].linkDeltaVTestImpulseResponses[4] = Cm::SpatialVectorF(baseInvArticulatedInertiaW.topRight.column1, bottomRight.column1);
-			testImpulseResponsesW[0].linkDeltaVTestImpulseResponses[5] = Cm::SpatialVectorF(baseInvArticulatedInertiaW.topRight.column2, bottomRight.column2);
-
-			links[0].cfm *= PxMax(testImpulseResponsesW[0].linkDeltaVTestImpulseResponses[0].bottom.x, PxMax(testImpulseResponsesW[0].linkDeltaVTestImpulseResponses[1].bottom.y, testImpulseResponsesW[0].linkDeltaVTestImpulseResponses[2].bottom.z));
-		}
+		computeRootResponseMatrix(articulationFlags, baseInvArticulatedInertiaW, links, testImpulseResponsesW);
 
 		//We want to compute the effect of a test impulse applied to child link.
 		//But to do that we need to apply the negative of that impulse to the parent link.
@@ -934,6 +917,30 @@ namespace Dy
 		}
 	}
 
+	void FeatherstoneArticulation::computeRootResponseMatrix
+	(const PxArticulationFlags& articulationFlags, const SpatialMatrix& baseInvArticulatedInertiaW,
+	 ArticulationLink* links, TestImpulseResponse* testImpulseResponsesW)
+	{
+		if (articulationFlags & PxArticulationFlag::eFIX_BASE)
+		{
+			//Fixed base, so response is zero
+			PxMemZero(testImpulseResponsesW, sizeof(TestImpulseResponse));
+		}
+		else
+		{
+			//Compute impulse response matrix. Compute the impulse response of unit responses on all 6 axes...
+			const PxMat33& bottomRight = baseInvArticulatedInertiaW.getBottomRight();
+			testImpulseResponsesW[0].linkDeltaVTestImpulseResponses[0] = Cm::SpatialVectorF(baseInvArticulatedInertiaW.topLeft.column0, baseInvArticulatedInertiaW.bottomLeft.column0);
+			testImpulseResponsesW[0].linkDeltaVTestImpulseResponses[1] = Cm::SpatialVectorF(baseInvArticulatedInertiaW.topLeft.column1, baseInvArticulatedInertiaW.bottomLeft.column1);
+			testImpulseResponsesW[0].linkDeltaVTestImpulseResponses[2] = Cm::SpatialVectorF(baseInvArticulatedInertiaW.topLeft.column2, baseInvArticulatedInertiaW.bottomLeft.column2);
+			testImpulseResponsesW[0].linkDeltaVTestImpulseResponses[3] = Cm::SpatialVectorF(baseInvArticulatedInertiaW.topRight.column0, bottomRight.column0);
+			testImpulseResponsesW[0].linkDeltaVTestImpulseResponses[4] = Cm::SpatialVectorF(baseInvArticulatedInertiaW.topRight.column1, bottomRight.column1);
+			testImpulseResponsesW[0].linkDeltaVTestImpulseResponses[5] = Cm::SpatialVectorF(baseInvArticulatedInertiaW.topRight.column2, bottomRight.column2);
+
+			links[0].cfm *= PxMax(testImpulseResponsesW[0].linkDeltaVTestImpulseResponses[0].bottom.x, PxMax(testImpulseResponsesW[0].linkDeltaVTestImpulseResponses[1].bottom.y, testImpulseResponsesW[0].linkDeltaVTestImpulseResponses[2].bottom.z));
+		}
+	}
+
 	void FeatherstoneArticulation::computeArticulatedSpatialZ(ArticulationData& data, ScratchData& scratchData)
 	{
 		ArticulationLink* links = data.getLinks();
@@ -1569,6 +1576,14 @@ namespace Dy
 	//}
 
 	void FeatherstoneArticulation::updateArticulation(const PxVec3& gravity, const PxReal invLengthScale, const bool externalForcesEveryTgsIterationEnabled)
+	{
+		updateArticulationLinkStates(gravity, invLengthScale, externalForcesEveryTgsIterationEnabled);
+		updateArticulatedInertia(externalForcesEveryTgsIterationEnabled);
+		updateArticulatedResponseMatrix();
+		updateArticulationAccelerations();
+	}
+
+	void FeatherstoneArticulation::updateArticulationLinkStates(const PxVec3& gravity, const PxReal invLengthScale, const bool externalForcesEveryTgsIterationEnabled)
 	{
 		//Copy the link poses into a handy array.
 		//Update the link separation vectors with the latest link poses.
@@ -1643,7 +1658,10 @@ namespace Dy
 				}
 			}
 		}
-		
+	}
+
+	void FeatherstoneArticulation::updateArticulatedInertia(const bool externalForcesEveryTgsIterationEnabled)
+	{
 		{	
 			//Constant inputs.
 			const ArticulationLink* links = mArticulationData.getLinks();
@@ -1676,7 +1694,10 @@ namespace Dy
 				linkZAForcesExtW, linkZAForcesIntW,									//outputs 
 				linkSpatialInertiasW, baseInvSpatialArticulatedInertiaW);			//outputs
 		}
+	}
 
+	void FeatherstoneArticulation::updateArticulatedResponseMatrix()
+	{
 		{
 			//Constants
 			const PxArticulationFlags& flags = mArticulationData.getArticulationFlags();
@@ -1700,7 +1721,10 @@ namespace Dy
 				jointDofISW, linkInvStIsW, jointDofISInvDW, 		//constants
 				links, linkImpulseResponseMatricesW);				//outputs
 		}
+	}
 
+	void FeatherstoneArticulation::updateArticulationAccelerations()
+	{
 		{
 			//Constant terms.
 			const bool doIC = false;
@@ -1799,6 +1823,15 @@ namespace Dy
 	{
 		//PX_PROFILE_ZONE("Articulations:computeUnconstrainedVelocities", 0);
 
+		beginUnconstrainedVelocities();
+
+		updateArticulation(gravity, invLengthScale, externalForcesEveryTgsIterationEnabled);
+
+		endUnconstrainedVelocities();
+	}
+
+	void FeatherstoneArticulation::beginUnconstrainedVelocities()
+	{
 		//mStaticConstraints.forceSize_Unsafe(0);
 		mStatic1DConstraints.forceSize_Unsafe(0);
 		mStaticContactConstraints.forceSize_Unsafe(0);
@@ -1808,9 +1841,10 @@ namespace Dy
 		//const PxU32 linkCount = mArticulationData.getLinkCount();
 
 		mArticulationData.init();
+	}
 
-		updateArticulation(gravity, invLengthScale, externalForcesEveryTgsIterationEnabled);
-
+	void FeatherstoneArticulation::endUnconstrainedVelocities()
+	{
 		ScratchData scratchData;
 		scratchData.motionVelocities = mArticulationData.getMotionVelocities();
 		scratchData.motionAccelerations = mArticulationData.getMotionAccelerations();
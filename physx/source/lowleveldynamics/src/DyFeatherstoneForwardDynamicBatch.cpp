@@ -0,0 +1,996 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2024 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "foundation/PxAlloca.h"
+#include "foundation/PxVecMath.h"
+#include "DyFeatherstoneArticulation.h"
+#include "DyFeatherstoneArticulationLink.h"
+#include "DyFeatherstoneArticulationJointData.h"
+
+// Batched forward dynamics for articulations that share a topology.
+//
+// Identical robots (same links, parents, joint types and dof layout) only differ in their numbers, so the tip-to-root
+// articulated inertia sweep and the root-to-tip response matrix sweep can process DY_ARTICULATION_BATCH_WIDTH of them
+// at once with one articulation per SIMD lane. The link data stays in each articulation's own arrays and is transposed
+// to structure-of-arrays form one link at a time, so the memory layout seen by the rest of the solver is unchanged.
+//
+// Every SoA helper below performs exactly the floating-point operations, in exactly the order, of the scalar code it
+// mirrors (the PxVec3/PxMat33/SpatialMatrix operators and the aos code in translateInertia()). Batched and unbatched
+// articulations therefore produce bit-identical results.
+
+namespace physx
+{
+namespace Dy
+{
+	using namespace aos;
+
+	PX_COMPILE_TIME_ASSERT(DY_ARTICULATION_BATCH_WIDTH == 4);
+	PX_COMPILE_TIME_ASSERT(sizeof(SpatialMatrix) == sizeof(PxReal) * 28);
+	PX_COMPILE_TIME_ASSERT(sizeof(Cm::SpatialVectorF) == sizeof(PxReal) * 8);
+	PX_COMPILE_TIME_ASSERT(sizeof(Cm::UnAlignedSpatialVector) == sizeof(PxReal) * 6);
+
+	namespace
+	{
+		//Each Vec4V holds the same scalar for the 4 articulations of a batch.
+		struct SoAVec3
+		{
+			Vec4V x, y, z;
+		};
+
+		//Element (column c, row r) is at index 3 * c + r when viewed as Vec4V[9], like PxMat33.
+		struct SoAMat33
+		{
+			SoAVec3 col0, col1, col2;
+
+			PX_FORCE_INLINE Vec4V& operator()(const PxU32 c, const PxU32 r) { return (&col0.x)[3 * c + r]; }
+		};
+
+		struct SoASpatialVector
+		{
+			SoAVec3 top, bottom;
+		};
+
+		//Same layout as SpatialMatrix without the padding, i.e. Vec4V[27].
+		struct SoASpatialMatrix
+		{
+			SoAMat33 topLeft, topRight, bottomLeft;
+		};
+
+		PX_FORCE_INLINE Vec4V negate(const Vec4V a)
+		{
+			//V4Neg() is 0 - a, which differs from the scalar unary minus for a == 0.
+			return V4Mul(a, V4Load(-1.0f));
+		}
+
+		PX_FORCE_INLINE SoAVec3 add(const SoAVec3& a, const SoAVec3& b)
+		{
+			const SoAVec3 r = { V4Add(a.x, b.x), V4Add(a.y, b.y), V4Add(a.z, b.z) };
+			return r;
+		}
+
+		PX_FORCE_INLINE SoAVec3 sub(const SoAVec3& a, const SoAVec3& b)
+		{
+			const SoAVec3 r = { V4Sub(a.x, b.x), V4Sub(a.y, b.y), V4Sub(a.z, b.z) };
+			return r;
+		}
+
+		PX_FORCE_INLINE SoAVec3 scale(const SoAVec3& a, const Vec4V s)
+		{
+			const SoAVec3 r = { V4Mul(a.x, s), V4Mul(a.y, s), V4Mul(a.z, s) };
+			return r;
+		}
+
+		PX_FORCE_INLINE SoAVec3 negate(const SoAVec3& a)
+		{
+			const SoAVec3 r = { negate(a.x), negate(a.y), negate(a.z) };
+			return r;
+		}
+
+		PX_FORCE_INLINE Vec4V dot(const SoAVec3& a, const SoAVec3& b)
+		{
+			return V4Add(V4Add(V4Mul(a.x, b.x), V4Mul(a.y, b.y)), V4Mul(a.z, b.z));
+		}
+
+		PX_FORCE_INLINE SoAVec3 cross(const SoAVec3& a, const SoAVec3& b)
+		{
+			const SoAVec3 r =
+			{
+				V4Sub(V4Mul(a.y, b.z), V4Mul(a.z, b.y)),
+				V4Sub(V4Mul(a.z, b.x), V4Mul(a.x, b.z)),
+				V4Sub(V4Mul(a.x, b.y), V4Mul(a.y, b.x))
+			};
+			return r;
+		}
+
+		//PxMat33::transform()
+		PX_FORCE_INLINE SoAVec3 transform(const SoAMat33& m, const SoAVec3& v)
+		{
+			return add(add(scale(m.col0, v.x), scale(m.col1, v.y)), scale(m.col2, v.z));
+		}
+
+		//PxMat33::transformTranspose()
+		PX_FORCE_INLINE SoAVec3 transformTranspose(const SoAMat33& m, const SoAVec3& v)
+		{
+			const SoAVec3 r = { dot(m.col0, v), dot(m.col1, v), dot(m.col2, v) };
+			return r;
+		}
+
+		PX_FORCE_INLINE SoAMat33 mul(const SoAMat33& a, const SoAMat33& b)
+		{
+			const SoAMat33 r = { transform(a, b.col0), transform(a, b.col1), transform(a, b.col2) };
+			return r;
+		}
+
+		PX_FORCE_INLINE SoAMat33 add(const SoAMat33& a, const SoAMat33& b)
+		{
+			const SoAMat33 r = { add(a.col0, b.col0), add(a.col1, b.col1), add(a.col2, b.col2) };
+			return r;
+		}
+
+		PX_FORCE_INLINE SoAMat33 sub(const SoAMat33& a, const SoAMat33& b)
+		{
+			const SoAMat33 r = { sub(a.col0, b.col0), sub(a.col1, b.col1), sub(a.col2, b.col2) };
+			return r;
+		}
+
+		PX_FORCE_INLINE SoAMat33 scale(const SoAMat33& a, const Vec4V s)
+		{
+			const SoAMat33 r = { scale(a.col0, s), scale(a.col1, s), scale(a.col2, s) };
+			return r;
+		}
+
+		PX_FORCE_INLINE SoAMat33 transpose(const SoAMat33& a)
+		{
+			const SoAMat33 r =
+			{
+				{ a.col0.x, a.col1.x, a.col2.x },
+				{ a.col0.y, a.col1.y, a.col2.y },
+				{ a.col0.z, a.col1.z, a.col2.z }
+			};
+			return r;
+		}
+
+		PX_FORCE_INLINE SoASpatialVector add(const SoASpatialVector& a, const SoASpatialVector& b)
+		{
+			const SoASpatialVector r = { add(a.top, b.top), add(a.bottom, b.bottom) };
+			return r;
+		}
+
+		PX_FORCE_INLINE SoASpatialVector scale(const SoASpatialVector& a, const Vec4V s)
+		{
+			const SoASpatialVector r = { scale(a.top, s), scale(a.bottom, s) };
+			return r;
+		}
+
+		//Cm::SpatialVectorF::innerProduct() and Cm::UnAlignedSpatialVector::innerProduct() with a as "this".
+		PX_FORCE_INLINE Vec4V innerProduct(const SoASpatialVector& a, const SoASpatialVector& b)
+		{
+			return V4Add(dot(a.bottom, b.top), dot(a.top, b.bottom));
+		}
+
+		//FeatherstoneArticulation::translateSpatialVector()
+		PX_FORCE_INLINE SoASpatialVector translateSpatialVectorSoA(const SoAVec3& offset, const SoASpatialVector& v)
+		{
+			const SoASpatialVector r = { v.top, add(v.bottom, cross(offset, v.top)) };
+			return r;
+		}
+
+		//SpatialMatrix::operator*() for spatial vectors
+		PX_FORCE_INLINE SoASpatialVector mul(const SoASpatialMatrix& m, const SoASpatialVector& s)
+		{
+			const SoASpatialVector r =
+			{
+				add(transform(m.topLeft, s.top), transform(m.topRight, s.bottom)),
+				add(transform(m.bottomLeft, s.top), transformTranspose(m.topLeft, s.bottom))
+			};
+			return r;
+		}
+
+		PX_FORCE_INLINE SoASpatialMatrix sub(const SoASpatialMatrix& a, const SoASpatialMatrix& b)
+		{
+			const SoASpatialMatrix r = { sub(a.topLeft, b.topLeft), sub(a.topRight, b.topRight), sub(a.bottomLeft, b.bottomLeft) };
+			return r;
+		}
+
+		//PxMat33::getInverse()
+		PX_FORCE_INLINE SoAMat33 getInverse(const SoAMat33& m)
+		{
+			const Vec4V zero = V4Zero();
+			const Vec4V one = V4One();
+
+			const SoAVec3& c0 = m.col0;
+			const SoAVec3& c1 = m.col1;
+			const SoAVec3& c2 = m.col2;
+
+			const Vec4V det = dot(c0, cross(c1, c2));
+			const BoolV singular = V4IsEq(det, zero);
+			//Keep the division well defined in the lanes that end up with the identity.
+			const Vec4V invDet = V4Div(one, V4Sel(singular, one, det));
+
+			SoAMat33 r;
+			r.col0.x = V4Mul(invDet, V4Sub(V4Mul(c1.y, c2.z), V4Mul(c2.y, c1.z)));
+			r.col0.y = V4Mul(invDet, negate(V4Sub(V4Mul(c0.y, c2.z), V4Mul(c2.y, c0.z))));
+			r.col0.z = V4Mul(invDet, V4Sub(V4Mul(c0.y, c1.z), V4Mul(c0.z, c1.y)));
+
+			r.col1.x = V4Mul(invDet, negate(V4Sub(V4Mul(c1.x, c2.z), V4Mul(c1.z, c2.x))));
+			r.col1.y = V4Mul(invDet, V4Sub(V4Mul(c0.x, c2.z), V4Mul(c0.z, c2.x)));
+			r.col1.z = V4Mul(invDet, negate(V4Sub(V4Mul(c0.x, c1.z), V4Mul(c0.z, c1.x))));
+
+			r.col2.x = V4Mul(invDet, V4Sub(V4Mul(c1.x, c2.y), V4Mul(c1.y, c2.x)));
+			r.col2.y = V4Mul(invDet, negate(V4Sub(V4Mul(c0.x, c2.y), V4Mul(c0.y, c2.x))));
+			r.col2.z = V4Mul(invDet, V4Sub(V4Mul(c0.x, c1.y), V4Mul(c1.x, c0.y)));
+
+			for (PxU32 c = 0; c < 3; ++c)
+			{
+				for (PxU32 row = 0; row < 3; ++row)
+					r(c, row) = V4Sel(singular, c == row ? one : zero, r(c, row));
+			}
+			return r;
+		}
+
+		//FeatherstoneArticulation::translateInertia() with sTod = constructSkewSymmetricMatrix(offset)
+		PX_FORCE_INLINE void translateInertiaSoA(const SoAVec3& offset, SoASpatialMatrix& inertia)
+		{
+			const Vec4V zero = V4Zero();
+			const SoAMat33 sTod =
+			{
+				{ zero, offset.z, negate(offset.y) },
+				{ negate(offset.z), zero, offset.x },
+				{ offset.y, negate(offset.x), zero }
+			};
+			const SoAMat33 dTos = transpose(sTod);
+
+			const SoAMat33 tL = inertia.topLeft;
+			const SoAMat33 tR = inertia.topRight;
+			const SoAMat33 bL = inertia.bottomLeft;
+
+			const SoAMat33 bl = add(mul(sTod, tL), bL);
+			const SoAMat33 br = add(mul(sTod, tR), transpose(tL));
+			const SoAMat33 bottomLeft = add(bl, mul(br, dTos));
+
+			inertia.topLeft = add(tL, mul(tR, dTos));
+			inertia.bottomLeft = scale(add(bottomLeft, transpose(bottomLeft)), V4Load(0.5f));
+		}
+
+		//lanes[l] = &bases[l][index]
+		template<typename T>
+		PX_FORCE_INLINE void offsetLanes(T* const* bases, const PxU32 index, T** lanes)
+		{
+			for (PxU32 l = 0; l < DY_ARTICULATION_BATCH_WIDTH; ++l)
+				lanes[l] = bases[l] + index;
+		}
+
+		template<typename T>
+		PX_FORCE_INLINE const PxReal* asReals(const T* t)
+		{
+			return reinterpret_cast<const PxReal*>(t);
+		}
+
+		template<typename T>
+		PX_FORCE_INLINE PxReal* asReals(T* t)
+		{
+			return reinterpret_cast<PxReal*>(t);
+		}
+
+		PX_FORCE_INLINE void gather(const SpatialMatrix* const* src, SoASpatialMatrix& out)
+		{
+			Vec4V* o = &out.topLeft.col0.x;
+			for (PxU32 c = 0; c < 7; ++c)
+			{
+				Vec4V v0 = V4LoadU(asReals(src[0]) + 4 * c);
+				Vec4V v1 = V4LoadU(asReals(src[1]) + 4 * c);
+				Vec4V v2 = V4LoadU(asReals(src[2]) + 4 * c);
+				Vec4V v3 = V4LoadU(asReals(src[3]) + 4 * c);
+				V4Transpose(v0, v1, v2, v3);
+				o[4 * c] = v0;
+				o[4 * c + 1] = v1;
+				o[4 * c + 2] = v2;
+				//The last float of a SpatialMatrix is padding.
+				if (c < 6)
+					o[4 * c + 3] = v3;
+			}
+		}
+
+		PX_FORCE_INLINE void gather(const Cm::SpatialVectorF* const* src, SoASpatialVector& out)
+		{
+			Vec4V t0 = V4LoadU(&src[0]->top.x), t1 = V4LoadU(&src[1]->top.x), t2 = V4LoadU(&src[2]->top.x), t3 = V4LoadU(&src[3]->top.x);
+			Vec4V b0 = V4LoadU(&src[0]->bottom.x), b1 = V4LoadU(&src[1]->bottom.x), b2 = V4LoadU(&src[2]->bottom.x), b3 = V4LoadU(&src[3]->bottom.x);
+			V4Transpose(t0, t1, t2, t3);
+			V4Transpose(b0, b1, b2, b3);
+			out.top.x = t0; out.top.y = t1; out.top.z = t2;
+			out.bottom.x = b0; out.bottom.y = b1; out.bottom.z = b2;
+		}
+
+		PX_FORCE_INLINE void gather(const Cm::UnAlignedSpatialVector* const* src, SoASpatialVector& out)
+		{
+			//6 floats per lane: load floats [0, 4) and [2, 6) so that nothing past the vector is read.
+			Vec4V t0 = V4LoadU(asReals(src[0])), t1 = V4LoadU(asReals(src[1])), t2 = V4LoadU(asReals(src[2])), t3 = V4LoadU(asReals(src[3]));
+			Vec4V b0 = V4LoadU(asReals(src[0]) + 2), b1 = V4LoadU(asReals(src[1]) + 2), b2 = V4LoadU(asReals(src[2]) + 2), b3 = V4LoadU(asReals(src[3]) + 2);
+			V4Transpose(t0, t1, t2, t3);
+			V4Transpose(b0, b1, b2, b3);
+			out.top.x = t0; out.top.y = t1; out.top.z = t2;
+			out.bottom.x = b1; out.bottom.y = b2; out.bottom.z = b3;
+		}
+
+		PX_FORCE_INLINE SoAVec3 gather(const PxVec3* const* src)
+		{
+			const SoAVec3 r =
+			{
+				V4LoadXYZW(src[0]->x, src[1]->x, src[2]->x, src[3]->x),
+				V4LoadXYZW(src[0]->y, src[1]->y, src[2]->y, src[3]->y),
+				V4LoadXYZW(src[0]->z, src[1]->z, src[2]->z, src[3]->z)
+			};
+			return r;
+		}
+
+		PX_FORCE_INLINE Vec4V gather(const PxReal* const* src)
+		{
+			return V4LoadXYZW(*src[0], *src[1], *src[2], *src[3]);
+		}
+
+		PX_FORCE_INLINE void store(const Vec4V v, PxReal* const* dst, const PxU32 nbLanes)
+		{
+			PX_ALIGN(16, PxReal lanes[4]);
+			V4StoreA(v, lanes);
+			for (PxU32 l = 0; l < nbLanes; ++l)
+				*dst[l] = lanes[l];
+		}
+
+		//Transpose v back to one Vec4V per lane for its top and for its bottom.
+		PX_FORCE_INLINE void scatterTranspose(const SoASpatialVector& v, Vec4V* top, Vec4V* bottom)
+		{
+			const Vec4V zero = V4Zero();
+			top[0] = v.top.x; top[1] = v.top.y; top[2] = v.top.z; top[3] = zero;
+			bottom[0] = v.bottom.x; bottom[1] = v.bottom.y; bottom[2] = v.bottom.z; bottom[3] = zero;
+			V4Transpose(top[0], top[1], top[2], top[3]);
+			V4Transpose(bottom[0], bottom[1], bottom[2], bottom[3]);
+		}
+
+		//Cm::SpatialVectorF::operator=(), which also zeroes the padding.
+		PX_FORCE_INLINE void store(const SoASpatialVector& v, Cm::SpatialVectorF* const* dst, const PxU32 nbLanes)
+		{
+			Vec4V top[4], bottom[4];
+			scatterTranspose(v, top, bottom);
+			for (PxU32 l = 0; l < nbLanes; ++l)
+			{
+				V4StoreU(top[l], &dst[l]->top.x);
+				V4StoreU(bottom[l], &dst[l]->bottom.x);
+			}
+		}
+
+		//Assign (or add) the xyz of v to dst and leave the 4th float, which is padding, untouched.
+		template<bool accumulate>
+		PX_FORCE_INLINE void storeXYZ(const Vec4V v, PxReal* dst)
+		{
+			const Vec4V d = V4LoadU(dst);
+			V4StoreU(V4Sel(BTTTF(), accumulate ? V4Add(d, v) : v, d), dst);
+		}
+
+		//Assignment to (or Cm::SpatialVectorF::operator+=() on) top and bottom, leaving the padding untouched.
+		template<bool accumulate>
+		PX_FORCE_INLINE void storeXYZ(const SoASpatialVector& v, Cm::SpatialVectorF* const* dst, const PxU32 nbLanes)
+		{
+			Vec4V top[4], bottom[4];
+			scatterTranspose(v, top, bottom);
+			for (PxU32 l = 0; l < nbLanes; ++l)
+			{
+				storeXYZ<accumulate>(top[l], &dst[l]->top.x);
+				storeXYZ<accumulate>(bottom[l], &dst[l]->bottom.x);
+			}
+		}
+
+		//SpatialMatrix::operator+=()
+		PX_FORCE_INLINE void accumulate(const SoASpatialMatrix& m, SpatialMatrix* const* dst, const PxU32 nbLanes)
+		{
+			const Vec4V* src = &m.topLeft.col0.x;
+			for (PxU32 c = 0; c < 7; ++c)
+			{
+				Vec4V lanes[4] = { src[4 * c], src[4 * c + 1], src[4 * c + 2], c < 6 ? src[4 * c + 3] : V4Zero() };
+				V4Transpose(lanes[0], lanes[1], lanes[2], lanes[3]);
+				for (PxU32 l = 0; l < nbLanes; ++l)
+				{
+					PxReal* d = asReals(dst[l]) + 4 * c;
+					if (c < 6)
+						V4StoreU(V4Add(V4LoadU(d), lanes[l]), d);
+					else
+						storeXYZ<true>(lanes[l], d);
+				}
+			}
+		}
+	}
+
+	bool FeatherstoneArticulation::haveSameBatchTopology(const ArticulationData& a, const ArticulationData& b)
+	{
+		const PxU32 linkCount = a.getLinkCount();
+		if (linkCount != b.getLinkCount() || linkCount < 2)
+			return false;
+
+		const ArticulationLink* linksA = a.getLinks();
+		const ArticulationLink* linksB = b.getLinks();
+		for (PxU32 linkID = 1; linkID < linkCount; ++linkID)
+		{
+			const ArticulationJointCoreData& jointA = a.getJointData(linkID);
+			const ArticulationJointCoreData& jointB = b.getJointData(linkID);
+			const PxU8 jointType = linksA[linkID].inboundJoint->jointType;
+
+			if (linksA[linkID].parent != linksB[linkID].parent || jointType != linksB[linkID].inboundJoint->jointType ||
+				jointA.dof != jointB.dof || jointA.jointOffset != jointB.jointOffset)
+				return false;
+
+			//Single axis joints are only batched in their regular single dof configuration.
+			if ((jointType == PxArticulationJointType::ePRISMATIC || jointType == PxArticulationJointType::eREVOLUTE ||
+				jointType == PxArticulationJointType::eREVOLUTE_UNWRAPPED) && jointA.dof != 1)
+				return false;
+		}
+		return true;
+	}
+
+	void FeatherstoneArticulation::computeArticulatedSpatialInertiaAndZBatch(FeatherstoneArticulation* const* articulations, const PxU32 nbArticulations,
+		const bool externalForcesEveryTgsIterationEnabled)
+	{
+		PX_ASSERT(nbArticulations > 1 && nbArticulations <= DY_ARTICULATION_BATCH_WIDTH);
+
+		//Lanes past nbArticulations read lane 0 and are never written.
+		ArticulationData* data[DY_ARTICULATION_BATCH_WIDTH];
+		for (PxU32 l = 0; l < DY_ARTICULATION_BATCH_WIDTH; ++l)
+			data[l] = &articulations[l < nbArticulations ? l : 0]->mArticulationData;
+
+		const ArticulationData& data0 = *data[0];
+		const ArticulationLink* links = data0.getLinks();
+		const PxU32 linkCount = data0.getLinkCount();
+
+		//Constant inputs.
+		const PxVec3* linkRsW[DY_ARTICULATION_BATCH_WIDTH];
+		const ArticulationJointCoreData* jointData[DY_ARTICULATION_BATCH_WIDTH];
+		const Cm::UnAlignedSpatialVector* jointDofMotionMatricesW[DY_ARTICULATION_BATCH_WIDTH];
+		const Cm::SpatialVectorF* linkCoriolisVectorsW[DY_ARTICULATION_BATCH_WIDTH];
+		const PxReal* jointDofForces[DY_ARTICULATION_BATCH_WIDTH];
+
+		//Values that we need now and will cache for later use.
+		Cm::SpatialVectorF* jointDofISW[DY_ARTICULATION_BATCH_WIDTH];
+		InvStIs* linkInvStISW[DY_ARTICULATION_BATCH_WIDTH];
+		Cm::SpatialVectorF* jointDofISInvStISW[DY_ARTICULATION_BATCH_WIDTH];
+		PxReal* jointDofMinusStZExtW[DY_ARTICULATION_BATCH_WIDTH];
+		PxReal* jointDofQStZIntIcW[DY_ARTICULATION_BATCH_WIDTH];
+
+		//We need to compute these.
+		Cm::SpatialVectorF* linkZAExtForcesW[DY_ARTICULATION_BATCH_WIDTH];
+		Cm::SpatialVectorF* linkZAIntForcesW[DY_ARTICULATION_BATCH_WIDTH];
+		SpatialMatrix* linkSpatialArticulatedInertiaW[DY_ARTICULATION_BATCH_WIDTH];
+
+		for (PxU32 l = 0; l < DY_ARTICULATION_BATCH_WIDTH; ++l)
+		{
+			ArticulationData& d = *data[l];
+			linkRsW[l] = d.getRw();
+			jointData[l] = d.getJointData();
+			jointDofMotionMatricesW[l] = d.getWorldMotionMatrix();
+			linkCoriolisVectorsW[l] = d.getCorioliseVectors();
+			jointDofForces[l] = externalForcesEveryTgsIterationEnabled ? NULL : d.getJointForces();
+			jointDofISW[l] = d.getIsW();
+			linkInvStISW[l] = d.getInvStIS();
+			jointDofISInvStISW[l] = d.getISInvStIS();
+			jointDofMinusStZExtW[l] = d.getMinusStZExt();
+			jointDofQStZIntIcW[l] = d.getQStZIntIc();
+			linkZAExtForcesW[l] = d.getSpatialZAVectors();
+			linkZAIntForcesW[l] = d.mZAInternalForces.begin();
+			linkSpatialArticulatedInertiaW[l] = d.getWorldSpatialArticulatedInertia();
+		}
+
+		const Vec4V zero = V4Zero();
+		const Vec4V one = V4One();
+
+		for (PxU32 linkID = linkCount - 1; linkID > 0; --linkID)
+		{
+			const ArticulationLink& link = links[linkID];
+			const PxU32 jointOffset = data0.getJointData(linkID).jointOffset;
+			const PxU8 nbDofs = data0.getJointData(linkID).dof;
+
+			SpatialMatrix* lanes_I[DY_ARTICULATION_BATCH_WIDTH];
+			offsetLanes(linkSpatialArticulatedInertiaW, linkID, lanes_I);
+			SoASpatialMatrix linkArticulatedInertiaW;
+			gather(lanes_I, linkArticulatedInertiaW);
+
+			SoASpatialVector motionMatricesW[3];
+			SoASpatialVector IsW[3];
+			Vec4V armatures[3];
+			Vec4V jointForces[3];
+			PxReal* lanes_minusStZExt[3][DY_ARTICULATION_BATCH_WIDTH];
+			PxReal* lanes_qStZIntIc[3][DY_ARTICULATION_BATCH_WIDTH];
+			Cm::SpatialVectorF* lanes_isInvStIs[3][DY_ARTICULATION_BATCH_WIDTH];
+			for (PxU8 ind = 0; ind < nbDofs; ++ind)
+			{
+				const PxU32 dofId = jointOffset + ind;
+
+				const Cm::UnAlignedSpatialVector* lanes_s[DY_ARTICULATION_BATCH_WIDTH];
+				offsetLanes(jointDofMotionMatricesW, dofId, lanes_s);
+				gather(lanes_s, motionMatricesW[ind]);
+
+				IsW[ind] = mul(linkArticulatedInertiaW, motionMatricesW[ind]);
+				Cm::SpatialVectorF* lanes_Is[DY_ARTICULATION_BATCH_WIDTH];
+				offsetLanes(jointDofISW, dofId, lanes_Is);
+				storeXYZ<false>(IsW[ind], lanes_Is, nbArticulations);
+
+				armatures[ind] = V4LoadXYZW(jointData[0][linkID].armature[ind], jointData[1][linkID].armature[ind],
+					jointData[2][linkID].armature[ind], jointData[3][linkID].armature[ind]);
+
+				if (jointDofForces[0])
+				{
+					const PxReal* lanes_Q[DY_ARTICULATION_BATCH_WIDTH];
+					offsetLanes(jointDofForces, dofId, lanes_Q);
+					jointForces[ind] = gather(lanes_Q);
+				}
+				else
+				{
+					jointForces[ind] = zero;
+				}
+
+				offsetLanes(jointDofMinusStZExtW, dofId, lanes_minusStZExt[ind]);
+				offsetLanes(jointDofQStZIntIcW, dofId, lanes_qStZIntIc[ind]);
+				offsetLanes(jointDofISInvStISW, dofId, lanes_isInvStIs[ind]);
+			}
+
+			SoASpatialVector linkZExtW, linkZIntW, linkCoriolisW;
+			{
+				Cm::SpatialVectorF* lanes_ZExt[DY_ARTICULATION_BATCH_WIDTH];
+				Cm::SpatialVectorF* lanes_ZInt[DY_ARTICULATION_BATCH_WIDTH];
+				const Cm::SpatialVectorF* lanes_c[DY_ARTICULATION_BATCH_WIDTH];
+				offsetLanes(linkZAExtForcesW, linkID, lanes_ZExt);
+				offsetLanes(linkZAIntForcesW, linkID, lanes_ZInt);
+				offsetLanes(linkCoriolisVectorsW, linkID, lanes_c);
+				gather(lanes_ZExt, linkZExtW);
+				gather(lanes_ZInt, linkZIntW);
+				gather(lanes_c, linkCoriolisW);
+			}
+			const SoASpatialVector linkZIntIcW = add(linkZIntW, mul(linkArticulatedInertiaW, linkCoriolisW));
+
+			//computePropagateSpatialInertia_ZA_ZIc()
+			SoASpatialVector deltaZAExtParent = linkZExtW;
+			SoASpatialVector deltaZAIntIcParent = linkZIntIcW;
+			SoASpatialMatrix spatialInertiaW;
+			switch (link.inboundJoint->jointType)
+			{
+			case PxArticulationJointType::ePRISMATIC:
+			case PxArticulationJointType::eREVOLUTE:
+			case PxArticulationJointType::eREVOLUTE_UNWRAPPED:
+			{
+				const SoASpatialVector& sa = motionMatricesW[0];
+				const SoASpatialVector& Is = IsW[0];
+
+				const Vec4V stIs = V4Add(innerProduct(sa, Is), armatures[0]);
+				const BoolV positive = V4IsGrtr(stIs, zero);
+				const Vec4V invStIS = V4Sel(positive, V4Div(one, V4Sel(positive, stIs, one)), zero);
+				{
+					PxReal* lanes_invStIs[DY_ARTICULATION_BATCH_WIDTH];
+					for (PxU32 l = 0; l < DY_ARTICULATION_BATCH_WIDTH; ++l)
+						lanes_invStIs[l] = &linkInvStISW[l][linkID].invStIs[0][0];
+					store(invStIS, lanes_invStIs, nbArticulations);
+				}
+
+				const SoASpatialVector isID = scale(Is, invStIS);
+				store(isID, lanes_isInvStIs[0], nbArticulations);
+
+				//SpatialMatrix::constructSpatialMatrix(isID, stI) with stI = (Is.bottom, Is.top)
+				const SoASpatialMatrix isIDStI =
+				{
+					{ scale(isID.top, Is.bottom.x), scale(isID.top, Is.bottom.y), scale(isID.top, Is.bottom.z) },
+					{ scale(isID.top, Is.top.x), scale(isID.top, Is.top.y), scale(isID.top, Is.top.z) },
+					{ scale(isID.bottom, Is.bottom.x), scale(isID.bottom, Is.bottom.y), scale(isID.bottom, Is.bottom.z) }
+				};
+
+				{
+					const Vec4V diff = negate(innerProduct(sa, linkZExtW));
+					store(diff, lanes_minusStZExt[0], nbArticulations);
+					deltaZAExtParent = add(deltaZAExtParent, scale(isID, diff));
+				}
+
+				{
+					const Vec4V diff = V4Sub(jointForces[0], innerProduct(sa, linkZIntIcW));
+					store(diff, lanes_qStZIntIc[0], nbArticulations);
+					deltaZAIntIcParent = add(deltaZAIntIcParent, scale(isID, diff));
+				}
+
+				spatialInertiaW = sub(linkArticulatedInertiaW, isIDStI);
+				break;
+			}
+			case PxArticulationJointType::eSPHERICAL:
+			{
+				SoAMat33 D =
+				{
+					{ one, zero, zero },
+					{ zero, one, zero },
+					{ zero, zero, one }
+				};
+				for (PxU32 ind = 0; ind < nbDofs; ++ind)
+				{
+					for (PxU32 ind2 = 0; ind2 < nbDofs; ++ind2)
+						D(ind, ind2) = innerProduct(motionMatricesW[ind2], IsW[ind]);
+					D(ind, ind) = V4Add(D(ind, ind), armatures[ind]);
+				}
+
+				SoAMat33 invD = getInverse(D);
+				for (PxU32 ind = 0; ind < nbDofs; ++ind)
+				{
+					for (PxU32 ind2 = 0; ind2 < nbDofs; ++ind2)
+					{
+						PxReal* lanes_invStIs[DY_ARTICULATION_BATCH_WIDTH];
+						for (PxU32 l = 0; l < DY_ARTICULATION_BATCH_WIDTH; ++l)
+							lanes_invStIs[l] = &linkInvStISW[l][linkID].invStIs[ind][ind2];
+						store(invD(ind, ind2), lanes_invStIs, nbArticulations);
+					}
+				}
+
+				const SoAVec3 zeroV = { zero, zero, zero };
+				const SoASpatialVector zeroSV = { zeroV, zeroV };
+				SoASpatialVector columns[6] = { zeroSV, zeroSV, zeroSV, zeroSV, zeroSV, zeroSV };
+				for (PxU32 ind = 0; ind < nbDofs; ++ind)
+				{
+					const SoASpatialVector& sa = motionMatricesW[ind];
+
+					const Vec4V localQstZ = negate(innerProduct(sa, linkZExtW));
+					const Vec4V localQstZInt = V4Sub(jointForces[ind], innerProduct(sa, linkZIntIcW));
+					store(localQstZ, lanes_minusStZExt[ind], nbArticulations);
+					store(localQstZInt, lanes_qStZIntIc[ind], nbArticulations);
+
+					SoASpatialVector isID = zeroSV;
+					for (PxU32 ind2 = 0; ind2 < nbDofs; ++ind2)
+						isID = add(isID, scale(IsW[ind2], invD(ind, ind2)));
+
+					columns[0] = add(columns[0], scale(isID, IsW[ind].bottom.x));
+					columns[1] = add(columns[1], scale(isID, IsW[ind].bottom.y));
+					columns[2] = add(columns[2], scale(isID, IsW[ind].bottom.z));
+					columns[3] = add(columns[3], scale(isID, IsW[ind].top.x));
+					columns[4] = add(columns[4], scale(isID, IsW[ind].top.y));
+					columns[5] = add(columns[5], scale(isID, IsW[ind].top.z));
+					store(isID, lanes_isInvStIs[ind], nbArticulations);
+
+					deltaZAExtParent = add(deltaZAExtParent, scale(isID, localQstZ));
+					deltaZAIntIcParent = add(deltaZAIntIcParent, scale(isID, localQstZInt));
+				}
+
+				//SpatialMatrix::constructSpatialMatrix(columns)
+				const SoASpatialMatrix isIDStI =
+				{
+					{ columns[0].top, columns[1].top, columns[2].top },
+					{ columns[3].top, columns[4].top, columns[5].top },
+					{ columns[0].bottom, columns[1].bottom, columns[2].bottom }
+				};
+				spatialInertiaW = sub(linkArticulatedInertiaW, isIDStI);
+				break;
+			}
+			default:
+				spatialInertiaW = linkArticulatedInertiaW;
+				break;
+			}
+
+			const PxVec3* lanes_r[DY_ARTICULATION_BATCH_WIDTH];
+			offsetLanes(linkRsW, linkID, lanes_r);
+			const SoAVec3 linkRW = gather(lanes_r);
+
+			//Accumulate the spatial inertia on the parent link.
+			{
+				translateInertiaSoA(linkRW, spatialInertiaW);
+
+				//Make sure we do not propagate up negative inertias around the principal inertial axes
+				//due to numerical rounding errors (PxMax(0, x) is V4Max(0, x)).
+				spatialInertiaW.bottomLeft.col0.x = V4Max(zero, spatialInertiaW.bottomLeft.col0.x);
+				spatialInertiaW.bottomLeft.col1.y = V4Max(zero, spatialInertiaW.bottomLeft.col1.y);
+				spatialInertiaW.bottomLeft.col2.z = V4Max(zero, spatialInertiaW.bottomLeft.col2.z);
+
+				SpatialMatrix* lanes_parentI[DY_ARTICULATION_BATCH_WIDTH];
+				offsetLanes(linkSpatialArticulatedInertiaW, link.parent, lanes_parentI);
+				accumulate(spatialInertiaW, lanes_parentI, nbArticulations);
+			}
+
+			//Accumulate the articulated z.a force on the parent link.
+			{
+				Cm::SpatialVectorF* lanes_parentZExt[DY_ARTICULATION_BATCH_WIDTH];
+				Cm::SpatialVectorF* lanes_parentZInt[DY_ARTICULATION_BATCH_WIDTH];
+				offsetLanes(linkZAExtForcesW, link.parent, lanes_parentZExt);
+				offsetLanes(linkZAIntForcesW, link.parent, lanes_parentZInt);
+				storeXYZ<true>(translateSpatialVectorSoA(linkRW, deltaZAExtParent), lanes_parentZExt, nbArticulations);
+				storeXYZ<true>(translateSpatialVectorSoA(linkRW, deltaZAIntIcParent), lanes_parentZInt, nbArticulations);
+			}
+		}
+
+		//cache base link inverse spatial inertia
+		for (PxU32 l = 0; l < nbArticulations; ++l)
+			linkSpatialArticulatedInertiaW[l][0].invertInertiaV(data[l]->getBaseInvSpatialArticulatedInertiaW());
+	}
+
+	void FeatherstoneArticulation::computeArticulatedResponseMatrixBatch(FeatherstoneArticulation* const* articulations, const PxU32 nbArticulations)
+	{
+		PX_ASSERT(nbArticulations > 1 && nbArticulations <= DY_ARTICULATION_BATCH_WIDTH);
+
+		//Lanes past nbArticulations read lane 0 and are never written.
+		ArticulationData* data[DY_ARTICULATION_BATCH_WIDTH];
+		for (PxU32 l = 0; l < DY_ARTICULATION_BATCH_WIDTH; ++l)
+			data[l] = &articulations[l < nbArticulations ? l : 0]->mArticulationData;
+
+		const ArticulationData& data0 = *data[0];
+		const ArticulationLink* links = data0.getLinks();
+		const PxU32 linkCount = data0.getLinkCount();
+
+		//Constants
+		const PxVec3* linkRsW[DY_ARTICULATION_BATCH_WIDTH];
+		const Cm::UnAlignedSpatialVector* jointDofMotionMatricesW[DY_ARTICULATION_BATCH_WIDTH];
+		const Cm::SpatialVectorF* jointDofISW[DY_ARTICULATION_BATCH_WIDTH];
+		const InvStIs* linkInvStISW[DY_ARTICULATION_BATCH_WIDTH];
+		const Cm::SpatialVectorF* jointDofISInvDW[DY_ARTICULATION_BATCH_WIDTH];
+
+		//outputs
+		TestImpulseResponse* testImpulseResponsesW[DY_ARTICULATION_BATCH_WIDTH];
+
+		for (PxU32 l = 0; l < DY_ARTICULATION_BATCH_WIDTH; ++l)
+		{
+			ArticulationData& d = *data[l];
+			linkRsW[l] = d.getRw();
+			jointDofMotionMatricesW[l] = d.getWorldMotionMatrix();
+			jointDofISW[l] = d.getIsW();
+			linkInvStISW[l] = d.getInvStIS();
+			jointDofISInvDW[l] = d.getISInvStIS();
+			testImpulseResponsesW[l] = d.getImpulseResponseMatrixWorld();
+		}
+
+		for (PxU32 l = 0; l < nbArticulations; ++l)
+		{
+			ArticulationData& d = *data[l];
+			computeRootResponseMatrix(d.getArticulationFlags(), d.getBaseInvSpatialArticulatedInertiaW(), d.getLinks(), testImpulseResponsesW[l]);
+		}
+
+		const Vec4V zero = V4Zero();
+		const Vec4V minusOne = V4Load(-1.0f);
+
+		//The negated unit test impulses of computeArticulatedResponseMatrix().
+		SoASpatialVector testLinkImpulses[6];
+		for (PxU32 i = 0; i < 6; ++i)
+		{
+			Vec4V* v = &testLinkImpulses[i].top.x;
+			for (PxU32 j = 0; j < 6; ++j)
+				v[j] = (i == j) ? minusOne : zero;
+		}
+
+		for (PxU32 linkID = 1; linkID < linkCount; ++linkID)
+		{
+			const PxU32 jointOffset = data0.getJointData(linkID).jointOffset;
+			const PxU8 dofCount = data0.getJointData(linkID).dof;
+			const PxU32 parentLinkId = links[linkID].parent;
+
+			const PxVec3* lanes_r[DY_ARTICULATION_BATCH_WIDTH];
+			offsetLanes(linkRsW, linkID, lanes_r);
+			const SoAVec3 parentLinkToChildLink = gather(lanes_r);
+			const SoAVec3 childLinkToParentLink = negate(parentLinkToChildLink);
+
+			SoASpatialVector motionMatricesW[3];
+			SoASpatialVector IsW[3];
+			SoASpatialVector IsInvDW[3];
+			for (PxU8 ind = 0; ind < dofCount; ++ind)
+			{
+				const Cm::UnAlignedSpatialVector* lanes_s[DY_ARTICULATION_BATCH_WIDTH];
+				const Cm::SpatialVectorF* lanes_Is[DY_ARTICULATION_BATCH_WIDTH];
+				const Cm::SpatialVectorF* lanes_IsInvD[DY_ARTICULATION_BATCH_WIDTH];
+				offsetLanes(jointDofMotionMatricesW, jointOffset + ind, lanes_s);
+				offsetLanes(jointDofISW, jointOffset + ind, lanes_Is);
+				offsetLanes(jointDofISInvDW, jointOffset + ind, lanes_IsInvD);
+				gather(lanes_s, motionMatricesW[ind]);
+				gather(lanes_Is, IsW[ind]);
+				gather(lanes_IsInvD, IsInvDW[ind]);
+			}
+
+			Vec4V invStIs[3][3];
+			for (PxU8 ind = 0; ind < dofCount; ++ind)
+			{
+				for (PxU8 ind2 = 0; ind2 < dofCount; ++ind2)
+				{
+					invStIs[ind][ind2] = V4LoadXYZW(linkInvStISW[0][linkID].invStIs[ind][ind2], linkInvStISW[1][linkID].invStIs[ind][ind2],
+						linkInvStISW[2][linkID].invStIs[ind][ind2], linkInvStISW[3][linkID].invStIs[ind][ind2]);
+				}
+			}
+
+			SoASpatialVector parentResponses[6];
+			for (PxU32 i = 0; i < 6; ++i)
+			{
+				const Cm::SpatialVectorF* lanes_row[DY_ARTICULATION_BATCH_WIDTH];
+				for (PxU32 l = 0; l < DY_ARTICULATION_BATCH_WIDTH; ++l)
+					lanes_row[l] = &testImpulseResponsesW[l][parentLinkId].linkDeltaVTestImpulseResponses[i];
+				gather(lanes_row, parentResponses[i]);
+			}
+
+			for (PxU32 i = 0; i < 6; ++i)
+			{
+				const SoASpatialVector& testLinkImpulse = testLinkImpulses[i];
+
+				//(1) Propagate child link impulse (and zero joint impulse) to parent, see propagateImpulseW().
+				Vec4V QMinusStZ[3] = { zero, zero, zero };
+				SoASpatialVector Zp;
+				{
+					const SoAVec3 zeroV = { zero, zero, zero };
+					SoASpatialVector YParentW = { zeroV, zeroV };
+					for (PxU8 ind = 0; ind < dofCount; ++ind)
+					{
+						const Vec4V QMinusStY = V4Sub(zero, innerProduct(motionMatricesW[ind], testLinkImpulse));
+						YParentW = add(YParentW, scale(IsInvDW[ind], QMinusStY));
+						QMinusStZ[ind] = V4Add(QMinusStZ[ind], QMinusStY);
+					}
+					YParentW = add(YParentW, testLinkImpulse);
+					Zp = translateSpatialVectorSoA(parentLinkToChildLink, YParentW);
+				}
+
+				//(2) Get deltaV response for parent, see TestImpulseResponse::getLinkDeltaVImpulseResponse().
+				SoASpatialVector deltaVParent = scale(parentResponses[0], Zp.top.x);
+				deltaVParent = add(deltaVParent, scale(parentResponses[1], Zp.top.y));
+				deltaVParent = add(deltaVParent, scale(parentResponses[2], Zp.top.z));
+				deltaVParent = add(deltaVParent, scale(parentResponses[3], Zp.bottom.x));
+				deltaVParent = add(deltaVParent, scale(parentResponses[4], Zp.bottom.y));
+				deltaVParent = add(deltaVParent, scale(parentResponses[5], Zp.bottom.z));
+				deltaVParent.top = negate(deltaVParent.top);
+				deltaVParent.bottom = negate(deltaVParent.bottom);
+
+				//(3) Propagate deltaV to child and apply test impulse (encoded in QMinusStZ), see propagateAccelerationW().
+				SoASpatialVector deltaVChild = translateSpatialVectorSoA(childLinkToParentLink, deltaVParent);
+				Vec4V tJAccel[3];
+				for (PxU8 ind = 0; ind < dofCount; ++ind)
+					tJAccel[ind] = V4Sub(QMinusStZ[ind], innerProduct(IsW[ind], deltaVChild));
+
+				for (PxU8 ind = 0; ind < dofCount; ++ind)
+				{
+					Vec4V jVel = zero;
+					for (PxU8 ind2 = 0; ind2 < dofCount; ++ind2)
+						jVel = V4Add(jVel, V4Mul(invStIs[ind2][ind], tJAccel[ind2]));
+
+					deltaVChild.top = add(deltaVChild.top, scale(motionMatricesW[ind].top, jVel));
+					deltaVChild.bottom = add(deltaVChild.bottom, scale(motionMatricesW[ind].bottom, jVel));
+				}
+
+				Cm::SpatialVectorF* lanes_response[DY_ARTICULATION_BATCH_WIDTH];
+				for (PxU32 l = 0; l < DY_ARTICULATION_BATCH_WIDTH; ++l)
+					lanes_response[l] = &testImpulseResponsesW[l][linkID].linkDeltaVTestImpulseResponses[i];
+				store(deltaVChild, lanes_response, nbArticulations);
+			}
+
+			for (PxU32 l = 0; l < nbArticulations; ++l)
+			{
+				const TestImpulseResponse& response = testImpulseResponsesW[l][linkID];
+				data[l]->getLinks()[linkID].cfm *= PxMax(response.linkDeltaVTestImpulseResponses[0].bottom.x, PxMax(response.linkDeltaVTestImpulseResponses[1].bottom.y, response.linkDeltaVTestImpulseResponses[2].bottom.z));
+			}
+		}
+	}
+
+	void FeatherstoneArticulation::computeUnconstrainedVelocitiesInternalBatch(FeatherstoneArticulation* const* articulations, const PxU32 nbArticulations,
+		const PxVec3& gravity, const PxReal invLengthScale, const bool externalForcesEveryTgsIterationEnabled)
+	{
+		PX_ALLOCA(_batched, bool, nbArticulations);
+		bool* batched = _batched;
+		PxMemZero(batched, sizeof(bool) * nbArticulations);
+
+		for (PxU32 a = 0; a < nbArticulations; ++a)
+		{
+			if (batched[a])
+				continue;
+
+			//Gather the following articulations that can share a SIMD batch with this one.
+			FeatherstoneArticulation* batch[DY_ARTICULATION_BATCH_WIDTH];
+			PxU32 nbBatched = 0;
+			batch[nbBatched++] = articulations[a];
+			for (PxU32 b = a + 1; b < nbArticulations && nbBatched < DY_ARTICULATION_BATCH_WIDTH; ++b)
+			{
+				if (!batched[b] && haveSameBatchTopology(articulations[a]->mArticulationData, articulations[b]->mArticulationData))
+				{
+					batched[b] = true;
+					batch[nbBatched++] = articulations[b];
+				}
+			}
+
+			if (nbBatched == 1)
+			{
+				articulations[a]->computeUnconstrainedVelocitiesInternal(gravity, invLengthScale, externalForcesEveryTgsIterationEnabled);
+				continue;
+			}
+
+			//Same sequence as computeUnconstrainedVelocitiesInternal() and updateArticulation(), with the two
+			//sweeps that dominate the cost of identical articulations running on the whole batch.
+			for (PxU32 i = 0; i < nbBatched; ++i)
+			{
+				batch[i]->beginUnconstrainedVelocities();
+				batch[i]->updateArticulationLinkStates(gravity, invLengthScale, externalForcesEveryTgsIterationEnabled);
+			}
+
+			computeArticulatedSpatialInertiaAndZBatch(batch, nbBatched, externalForcesEveryTgsIterationEnabled);
+			computeArticulatedResponseMatrixBatch(batch, nbBatched);
+
+			for (PxU32 i = 0; i < nbBatched; ++i)
+			{
+				batch[i]->updateArticulationAccelerations();
+				batch[i]->endUnconstrainedVelocities();
+			}
+		}
+	}
+
+	void FeatherstoneArticulation::computeUnconstrainedVelocitiesBatch(
+		const ArticulationSolverDesc* descs, const PxU32 nbDescs,
+		const PxReal dt, const PxVec3& gravity, const PxReal invLengthScale,
+		PxU32* internalConstraintCounts)
+	{
+		PX_ALLOCA(_articulations, FeatherstoneArticulation*, nbDescs);
+		FeatherstoneArticulation** articulations = _articulations;
+
+		for (PxU32 i = 0; i < nbDescs; ++i)
+		{
+			FeatherstoneArticulation* articulation = descs[i].articulation;
+			ArticulationData& data = articulation->mArticulationData;
+			data.setDt(dt);
+
+			if (articulation->mJcalcDirty)
+			{
+				articulation->mJcalcDirty = false;
+				articulation->jcalc(data);
+			}
+
+			articulations[i] = articulation;
+		}
+
+		computeUnconstrainedVelocitiesInternalBatch(articulations, nbDescs, gravity, invLengthScale, false);
+
+		for (PxU32 i = 0; i < nbDescs; ++i)
+		{
+			FeatherstoneArticulation* articulation = articulations[i];
+			ArticulationData& data = articulation->mArticulationData;
+			const bool fixBase = data.getArticulationFlags() & PxArticulationFlag::eFIX_BASE;
+
+			PxU32 acCount;
+			internalConstraintCounts[i] = articulation->setupSolverConstraints(data.getLinks(), data.getLinkCount(), fixBase, data, acCount);
+		}
+	}
+
+	void FeatherstoneArticulation::computeUnconstrainedVelocitiesTGSBatch(
+		const ArticulationSolverDesc* descs, const PxU32 nbDescs,
+		const PxReal dt, const PxVec3& gravity,
+		const PxReal invLengthScale, const bool externalForcesEveryTgsIterationEnabled)
+	{
+		PX_ALLOCA(_articulations, FeatherstoneArticulation*, nbDescs);
+		FeatherstoneArticulation** articulations = _articulations;
+
+		for (PxU32 i = 0; i < nbDescs; ++i)
+		{
+			FeatherstoneArticulation* articulation = descs[i].articulation;
+			ArticulationData& data = articulation->mArticulationData;
+			data.setDt(dt);
+
+			if (articulation->mJcalcDirty)
+			{
+				articulation->mJcalcDirty = false;
+				articulation->jcalc(data);
+			}
+
+			articulations[i] = articulation;
+		}
+
+		computeUnconstrainedVelocitiesInternalBatch(articulations, nbDescs, gravity, invLengthScale, externalForcesEveryTgsIterationEnabled);
+	}
+
+}//namespace Dy
+}
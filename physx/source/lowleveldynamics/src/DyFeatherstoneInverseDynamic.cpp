@@ -509,6 +509,7 @@ namespace Dy
 		computeRelativeTransformC2B(mArticulationData);
 
 		computeSpatialInertia(mArticulationData);
+		mSpatialInertiaDirty = false;
 
 		mArticulationData.setDataDirty(false);
 	}
@@ -554,30 +555,7 @@ namespace Dy
 		const bool fixBase = mArticulationData.getArticulationFlags() & PxArticulationFlag::eFIX_BASE;
 		if (fixBase)
 		{
-			Cm::SpatialVectorF* spatialZAForces = reinterpret_cast<Cm::SpatialVectorF*>(allocator->alloc(sizeof(Cm::SpatialVectorF) * linkCount));
-
-			for (PxU32 linkID = 0; linkID < linkCount; ++linkID)
-			{
-				ArticulationLink& link = mArticulationData.getLink(linkID);
-
-				PxsBodyCore& core = *link.bodyCore;
-
-				const PxReal m = 1.0f / core.inverseMass;
-
-				const PxVec3 linkGravity = tGravity;
-
-				spatialZAForces[linkID].top = m*linkGravity;
-				spatialZAForces[linkID].bottom = PxVec3(0.f);
-			}
-
-			ScratchData scratchData;
-			scratchData.spatialZAVectors = spatialZAForces;
-			scratchData.jointForces = cache.jointForce;
-
-			computeGeneralizedForceInv(mArticulationData, scratchData);
-
-			//release spatialZA vectors
-			allocator->free(spatialZAForces);
+			computeGravityForceFixBase(gravity, cache.jointForce, allocator);
 		}
 		else
 		{
@@ -608,6 +586,37 @@ namespace Dy
 
 	}
 
+	void FeatherstoneArticulation::computeGravityForceFixBase(const PxVec3& gravity, PxReal* jointForces, PxcScratchAllocator* allocator)
+	{
+		const PxVec3 tGravity = -gravity;
+		const PxU32 linkCount = mArticulationData.getLinkCount();
+
+		Cm::SpatialVectorF* spatialZAForces = reinterpret_cast<Cm::SpatialVectorF*>(allocator->alloc(sizeof(Cm::SpatialVectorF) * linkCount));
+
+		for (PxU32 linkID = 0; linkID < linkCount; ++linkID)
+		{
+			ArticulationLink& link = mArticulationData.getLink(linkID);
+
+			PxsBodyCore& core = *link.bodyCore;
+
+			const PxReal m = 1.0f / core.inverseMass;
+
+			const PxVec3 linkGravity = tGravity;
+
+			spatialZAForces[linkID].top = m*linkGravity;
+			spatialZAForces[linkID].bottom = PxVec3(0.f);
+		}
+
+		ScratchData scratchData;
+		scratchData.spatialZAVectors = spatialZAForces;
+		scratchData.jointForces = jointForces;
+
+		computeGeneralizedForceInv(mArticulationData, scratchData);
+
+		//release spatialZA vectors
+		allocator->free(spatialZAForces);
+	}
+
 	//gravity, acceleration and external force(external acceleration) are zero
 	void  FeatherstoneArticulation::getCoriolisAndCentrifugalForce(PxArticulationCache& cache)
 	{
@@ -999,6 +1008,7 @@ namespace Dy
 		}
 
 		computeArticulatedSpatialInertia(mArticulationData);
+		mSpatialInertiaDirty = true;
 
 		ArticulationLink* links = mArticulationData.getLinks();
 	
@@ -1374,6 +1384,7 @@ namespace Dy
 		}
 
 		computeArticulatedSpatialInertia(mArticulationData);
+		mSpatialInertiaDirty = true;
 
 		const PxU32 linkCount = mArticulationData.getLinkCount();
 		 
@@ -1499,10 +1510,10 @@ namespace Dy
 			{
 				inverseDynamicFloatingBase(mArticulationData, PxVec3(0.f), scratchData, false);
 			}
-		
-			allocator->free(tData);
-			allocator->free(tempMemory);
 		}
+
+		allocator->free(tData);
+		allocator->free(tempMemory);
 	}
 
 	void FeatherstoneArticulation::constraintPrep(ArticulationLoopConstraint* lConstraints, 
@@ -2020,7 +2031,7 @@ namespace Dy
 
 			Dy::SpatialMatrix cSpatialInertia = compositeSpatialInertia[i];
 			//transform current link's spatial inertia to parent's space
-			PxVec3 rw = link.bodyCore->body2World.p - links[link.parent].bodyCore->body2World.p;
+			const PxVec3& rw = mArticulationData.getRw(i);
 			FeatherstoneArticulation::translateInertia(FeatherstoneArticulation::constructSkewSymmetricMatrix(rw), cSpatialInertia);
 
 			//compute parent's composite spatial inertia
@@ -2059,7 +2070,7 @@ namespace Dy
 		PxcScratchAllocator* allocator = reinterpret_cast<PxcScratchAllocator*>(cache.scratchAllocator);
 
 		ArticulationLink* links = mArticulationData.getLinks();
-		//ArticulationLinkData* linkData = mArticulationData.getLinkData();
+		const ArticulationLinkData* linkData = mArticulationData.getLinkData();
 
 		const PxU32 startIndex = PxU32(linkCount - 1);
 
@@ -2075,7 +2086,7 @@ namespace Dy
 
 			Dy::SpatialMatrix cSpatialInertia = compositeSpatialInertia[i];
 			//transform current link's spatial inertia to parent's space
-			PxVec3 rw = link.bodyCore->body2World.p - links[link.parent].bodyCore->body2World.p;
+			const PxVec3& rw = mArticulationData.getRw(i);
 			FeatherstoneArticulation::translateInertia(FeatherstoneArticulation::constructSkewSymmetricMatrix(rw), cSpatialInertia);
 
 			//compute parent's composite spatial inertia
@@ -2099,9 +2110,7 @@ namespace Dy
 			const PxU32 j = computeHi(mArticulationData, i, massMatrix, f);
 
 			//transform F to the base link space
-			//ArticulationLinkData& fDatum = linkData[j];
-			
-			PxVec3 brw = links[j].bodyCore->body2World.p - links[0].bodyCore->body2World.p;
+			const PxVec3& brw = linkData[j].childToBase;
 			for (PxU32 ind = 0; ind < jointDatum.dof; ++ind)
 			{
 				f[ind] = translateSpatialVector(brw, f[ind]);
@@ -2191,6 +2200,67 @@ namespace Dy
 
 	}
 
+	void FeatherstoneArticulation::computeBiasForce(const PxVec3& gravity, PxArticulationCache& cache)
+	{
+		const PxU32 linkCount = mArticulationData.getLinkCount();
+
+		PxcScratchAllocator* allocator = reinterpret_cast<PxcScratchAllocator*>(cache.scratchAllocator);
+
+		ScratchData scratchData;
+		PxU8* tempMemory = allocateScratchSpatialData(allocator, linkCount, scratchData);
+
+		scratchData.jointVelocities = cache.jointVelocity;
+		scratchData.jointAccelerations = NULL;
+		scratchData.jointForces = cache.jointForce;
+		scratchData.externalAccels = NULL;
+
+		//same gravity conventions as getGeneralizedGravityForce(), so that the result is the sum of the two separate queries
+		const bool fixBase = mArticulationData.getArticulationFlags() & PxArticulationFlag::eFIX_BASE;
+		if (fixBase)
+		{
+			//the fixed base gravity force does not honor PxActorFlag::eDISABLE_GRAVITY while the combined inverse dynamics pass
+			//would, so the gravity term is added separately
+			inverseDynamic(mArticulationData, PxVec3(0.f), scratchData, true);
+
+			const PxU32 dofs = mArticulationData.getDofs();
+			PxReal* gravityForces = reinterpret_cast<PxReal*>(allocator->alloc(sizeof(PxReal) * dofs));
+			computeGravityForceFixBase(gravity, gravityForces, allocator);
+			for (PxU32 i = 0; i < dofs; ++i)
+				cache.jointForce[i] += gravityForces[i];
+			allocator->free(gravityForces);
+		}
+		else
+		{
+			inverseDynamicFloatingBase(mArticulationData, -gravity, scratchData, true);
+		}
+
+		allocator->free(tempMemory);
+	}
+
+	void FeatherstoneArticulation::getInverseDynamics(const PxVec3& gravity, PxArticulationCache& cache, PxArticulationInverseDynamicsFlags flags,
+		PxU32& nRows, PxU32& nCols)
+	{
+		//the pose dependent data is kept until the pose changes, see teleportLinks(), teleportRootLink() and endUnconstrainedVelocities(),
+		//or until a coefficient matrix query overwrites the spatial inertias
+		if (mJcalcDirty || mSpatialInertiaDirty || mArticulationData.getDataDirty())
+			initializeCommonData();
+
+		if (flags & PxArticulationInverseDynamicsFlag::eMASS_MATRIX)
+			getGeneralizedMassMatrixCRB(cache);
+
+		const bool gravityForce = flags & PxArticulationInverseDynamicsFlag::eGRAVITY_FORCE;
+		const bool coriolisForce = flags & PxArticulationInverseDynamicsFlag::eCORIOLIS_AND_CENTRIFUGAL_FORCE;
+		if (gravityForce && coriolisForce)
+			computeBiasForce(gravity, cache);
+		else if (gravityForce)
+			getGeneralizedGravityForce(gravity, cache);
+		else if (coriolisForce)
+			getCoriolisAndCentrifugalForce(cache);
+
+		if (flags & PxArticulationInverseDynamicsFlag::eDENSE_JACOBIAN)
+			computeDenseJacobianInternal(cache, nRows, nCols);
+	}
+
 	void FeatherstoneArticulation::getGeneralizedMassMatrix( PxArticulationCache& cache)
 	{
 		if (mArticulationData.getDataDirty())
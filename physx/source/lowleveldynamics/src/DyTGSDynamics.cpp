@@ -1770,11 +1770,9 @@ public:
 
 		const PxReal invLengthScale = 1.f / mContext.getLengthScale();
 
-		for (PxU32 a = 0; a < mNbDescs; ++a)
-		{			
-			ArticulationPImpl::computeUnconstrainedVelocitiesTGS(mDescs[a], mDt, 
-				mGravity, invLengthScale, mExternalForcesEveryTgsIterationEnabled);
-		}
+		//Articulations sharing a topology get their forward dynamics computed in SIMD batches.
+		ArticulationPImpl::computeUnconstrainedVelocitiesTGSBatch(mDescs, mNbDescs, mDt,
+			mGravity, invLengthScale, mExternalForcesEveryTgsIterationEnabled);
 
 		mContext.putThreadContext(&threadContext);
 	}
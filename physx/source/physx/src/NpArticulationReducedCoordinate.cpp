@@ -40,6 +40,7 @@
 #include "NpAggregate.h"
 
 #include "omnipvd/NpOmniPvdSetData.h"
+#include "CmParallelFor.h"
 
 using namespace physx;
 
@@ -335,6 +336,69 @@ void NpArticulationReducedCoordinate::computeGeneralizedMassMatrix(PxArticulatio
 	mCore.computeGeneralizedMassMatrix(cache);
 }
 
+void NpArticulationReducedCoordinate::computeInverseDynamics(PxArticulationCache& cache, PxArticulationInverseDynamicsFlags flags, PxU32& nRows, PxU32& nCols) const
+{
+	NP_READ_CHECK(getNpScene());
+	PX_CHECK_AND_RETURN(getNpScene(), "PxArticulationReducedCoordinate::computeInverseDynamics: Articulation must be in a scene.");
+	PX_CHECK_AND_RETURN(cache.version == mCacheVersion, "PxArticulationReducedCoordinate::computeInverseDynamics: cache is invalid, articulation configuration has changed!");
+
+	PX_CHECK_SCENE_API_WRITE_FORBIDDEN(getNpScene(), "PxArticulationReducedCoordinate::computeInverseDynamics() not allowed while simulation is running. Call will be ignored.");
+
+	const bool isGpuSimEnabled = getNpScene()->getFlags() & PxSceneFlag::eENABLE_GPU_DYNAMICS;
+
+	mCore.computeInverseDynamics(cache, flags, nRows, nCols, isGpuSimEnabled);
+}
+
+namespace
+{
+	struct InverseDynamicsBatch
+	{
+		PxArticulationReducedCoordinate* const*	mArticulations;
+		PxArticulationCache* const*				mCaches;
+		PxArticulationInverseDynamicsFlags		mFlags;
+	};
+
+	void computeInverseDynamicsBatch(void* userData, PxU32 startIndex, PxU32 endIndex)
+	{
+		const InverseDynamicsBatch& batch = *reinterpret_cast<const InverseDynamicsBatch*>(userData);
+
+		for(PxU32 i=startIndex; i<endIndex; i++)
+		{
+			const NpArticulationReducedCoordinate* articulation = static_cast<const NpArticulationReducedCoordinate*>(batch.mArticulations[i]);
+
+			const bool isGpuSimEnabled = articulation->getNpScene()->getFlagsFast() & PxSceneFlag::eENABLE_GPU_DYNAMICS;
+
+			PxU32 nRows, nCols;
+			articulation->getCore().computeInverseDynamics(*batch.mCaches[i], batch.mFlags, nRows, nCols, isGpuSimEnabled);
+		}
+	}
+}
+
+void physx::PxComputeArticulationInverseDynamics(PxU32 nbArticulations, PxArticulationReducedCoordinate* const* articulations,
+	PxArticulationCache* const* caches, PxArticulationInverseDynamicsFlags flags, PxCpuDispatcher* dispatcher)
+{
+	// validate everything on the calling thread, the worker threads only see valid articulations and don't touch the scene locks.
+	for(PxU32 i=0; i<nbArticulations; i++)
+	{
+		const NpArticulationReducedCoordinate* articulation = static_cast<const NpArticulationReducedCoordinate*>(articulations[i]);
+		const NpScene* npScene = articulation->getNpScene();
+
+		NP_READ_CHECK(npScene);
+		PX_CHECK_AND_RETURN(npScene, "PxComputeArticulationInverseDynamics: Articulation must be in a scene.");
+		PX_CHECK_AND_RETURN(caches[i]->version == articulation->mCacheVersion, "PxComputeArticulationInverseDynamics: cache is invalid, articulation configuration has changed!");
+
+		PX_CHECK_SCENE_API_WRITE_FORBIDDEN(npScene, "PxComputeArticulationInverseDynamics() not allowed while simulation is running. Call will be ignored.");
+	}
+
+	InverseDynamicsBatch batch;
+	batch.mArticulations	= articulations;
+	batch.mCaches			= caches;
+	batch.mFlags			= flags;
+
+	// a few articulations per task, a single one is usually too little work to amortize the task overhead
+	Cm::parallelFor(dispatcher, nbArticulations, 8, computeInverseDynamicsBatch, &batch);
+}
+
 void NpArticulationReducedCoordinate::addLoopJoint(PxConstraint* joint)
 {
 	NP_WRITE_CHECK(getNpScene());
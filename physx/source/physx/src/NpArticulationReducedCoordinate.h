@@ -163,6 +163,8 @@ namespace physx
 
 		virtual		void							computeGeneralizedMassMatrix(PxArticulationCache& cache) const	PX_OVERRIDE	PX_FINAL;
 
+		virtual		void							computeInverseDynamics(PxArticulationCache& cache, PxArticulationInverseDynamicsFlags flags, PxU32& nRows, PxU32& nCols) const	PX_OVERRIDE	PX_FINAL;
+
 		virtual		void							addLoopJoint(PxConstraint* joint)	PX_OVERRIDE	PX_FINAL;
 
 		virtual		void							removeLoopJoint(PxConstraint* constraint)	PX_OVERRIDE	PX_FINAL;
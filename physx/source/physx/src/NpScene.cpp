@@ -2597,6 +2597,24 @@ bool NpScene::removeBroadPhaseRegion(PxU32 handle)
 	return bp->removeRegion(handle);
 }
 
+bool NpScene::setBroadPhaseAutoRegions(const PxBroadPhaseAutoRegionParams* params)
+{
+	NP_WRITE_CHECK(this);
+	PX_CHECK_AND_RETURN_VAL(!params || params->isValid(), "PxScene::setBroadPhaseAutoRegions(): invalid parameters provided!", false);
+
+	PX_CHECK_SCENE_API_WRITE_FORBIDDEN_AND_RETURN_VAL(this, "PxScene::setBroadPhaseAutoRegions() not allowed while simulation is running. Call will be ignored.", false)
+
+	Bp::BroadPhase* bp = mScene.getAABBManager()->getBroadPhase();
+	return bp->setAutoRegions(params);
+}
+
+bool NpScene::getBroadPhaseAutoRegionStats(PxBroadPhaseAutoRegionStats& stats) const
+{
+	NP_READ_CHECK(this);
+	const Bp::BroadPhase* bp = mScene.getAABBManager()->getBroadPhase();
+	return bp->getAutoRegionStats(stats);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 // Filtering
@@ -4790,6 +4808,7 @@ void NpScene::createInOmniPVD(const PxSceneDesc& desc)
 	OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxScene, solverArticulationBatchSize, static_cast<PxScene&>(*this), getSolverArticulationBatchSize())
 	OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxScene, nbContactDataBlocks, static_cast<PxScene&>(*this), getNbContactDataBlocksUsed())
 	OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxScene, maxNbContactDataBlocks, static_cast<PxScene&>(*this), getMaxNbContactDataBlocksUsed())//naming problem of functions
+	OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxScene, contactDataBlockIdleFrames, static_cast<PxScene&>(*this), desc.contactDataBlockIdleFrames)
 	OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxScene, maxBiasCoefficient, static_cast<PxScene&>(*this), getMaxBiasCoefficient())
 	OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxScene, contactReportStreamBufferSize, static_cast<PxScene&>(*this), getContactReportStreamBufferSize())
 	OMNI_PVD_SET_EXPLICIT(pvdWriter, pvdRegData, OMNI_PVD_CONTEXT_HANDLE, PxScene, ccdMaxPasses, static_cast<PxScene&>(*this), getCCDMaxPasses())
@@ -287,6 +287,8 @@ class NpScene : public NpSceneAccessor, public PxUserAllocated
 	virtual			PxU32							getBroadPhaseRegions(PxBroadPhaseRegionInfo* userBuffer, PxU32 bufferSize, PxU32 startIndex=0) const	PX_OVERRIDE PX_FINAL;
 	virtual			PxU32							addBroadPhaseRegion(const PxBroadPhaseRegion& region, bool populateRegion)	PX_OVERRIDE PX_FINAL;
 	virtual			bool							removeBroadPhaseRegion(PxU32 handle)	PX_OVERRIDE PX_FINAL;
+	virtual			bool							setBroadPhaseAutoRegions(const PxBroadPhaseAutoRegionParams* params)	PX_OVERRIDE PX_FINAL;
+	virtual			bool							getBroadPhaseAutoRegionStats(PxBroadPhaseAutoRegionStats& stats)	const	PX_OVERRIDE PX_FINAL;
 
 	virtual			bool							addActors(PxActor*const* actors, PxU32 nbActors)	PX_OVERRIDE PX_FINAL;
 	virtual			bool							addActors(const PxPruningStructure& prunerStructure)	PX_OVERRIDE PX_FINAL;
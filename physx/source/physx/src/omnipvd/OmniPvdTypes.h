@@ -277,6 +277,7 @@ OMNI_PVD_ATTRIBUTE						(PxScene,		solverBatchSize,		PxU32,		OmniPvdDataType::eU
 OMNI_PVD_ATTRIBUTE						(PxScene,		solverArticulationBatchSize, PxU32,	OmniPvdDataType::eUINT32)
 OMNI_PVD_ATTRIBUTE						(PxScene,		nbContactDataBlocks,	PxU32,		OmniPvdDataType::eUINT32)
 OMNI_PVD_ATTRIBUTE						(PxScene,		maxNbContactDataBlocks, PxU32,		OmniPvdDataType::eUINT32)
+OMNI_PVD_ATTRIBUTE						(PxScene,		contactDataBlockIdleFrames, PxU32,	OmniPvdDataType::eUINT32)
 OMNI_PVD_ATTRIBUTE						(PxScene,		maxBiasCoefficient,		PxReal,		OmniPvdDataType::eFLOAT32)
 OMNI_PVD_ATTRIBUTE						(PxScene,		contactReportStreamBufferSize, PxU32,	OmniPvdDataType::eUINT32)
 OMNI_PVD_ATTRIBUTE						(PxScene,		ccdMaxPasses,			PxU32,		OmniPvdDataType::eUINT32)
@@ -43,6 +43,7 @@ class PxPhysics;
 
 namespace Cct
 {
+	class SweptBox;
 
 	class BoxController : public PxBoxController, public Controller
 	{
@@ -102,6 +103,7 @@ namespace Cct
 
 				bool								updateKinematicProxy();
 				void								getOBB(PxExtendedBox& obb)			const;
+				void								getSweptBox(SweptBox& sweptBox)		const;
 	};
 
 } // namespace Cct
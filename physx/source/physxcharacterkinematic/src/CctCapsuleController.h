@@ -42,6 +42,7 @@ class PxPhysics;
 
 namespace Cct
 {
+	class SweptCapsule;
 	class CapsuleController : public PxCapsuleController, public Controller
 	{
 	public:
@@ -95,6 +96,7 @@ namespace Cct
 		//~ PxCapsuleController
 
 				void								getCapsule(PxExtendedCapsule& capsule)	const;
+				void								getSweptCapsule(SweptCapsule& sweptCapsule)	const;
 
 				PxF32								mRadius;
 				PxF32								mHeight;
@@ -778,7 +778,7 @@ static SweepFunc gSweepMap[SweptVolumeType::eLAST][TouchedGeomType::eLAST] = {
 
 PX_COMPILE_TIME_ASSERT(sizeof(gSweepMap)==SweptVolumeType::eLAST*TouchedGeomType::eLAST*sizeof(SweepFunc));
 
-static const PxU32 GeomSizes[] =
+const PxU32 Cct::gGeomSizes[] =
 {
 	sizeof(TouchedUserBox),
 	sizeof(TouchedUserCapsule),
@@ -850,7 +850,7 @@ static const TouchedGeom* CollideGeoms(
 		}
 
 		const PxU8* ptr = reinterpret_cast<const PxU8*>(Data);
-		ptr += GeomSizes[CurrentGeom->mType];
+		ptr += gGeomSizes[CurrentGeom->mType];
 		Data = reinterpret_cast<const PxU32*>(ptr);
 	}
 	return impact.mGeom;
@@ -929,7 +929,7 @@ static PxVec3 computeMTD(const SweepTest* sweep_test, const SweptVolume& volume,
 			}
 
 			const PxU8* ptr = reinterpret_cast<const PxU8*>(Data);
-			ptr += GeomSizes[CurrentGeom->mType];
+			ptr += gGeomSizes[CurrentGeom->mType];
 			Data = reinterpret_cast<const PxU32*>(ptr);
 		}
 	}
@@ -949,7 +949,7 @@ static bool ParseGeomStream(const void* object, const IntArray& geom_stream)
 			return true;
 
 		const PxU8* ptr = reinterpret_cast<const PxU8*>(Data);
-		ptr += GeomSizes[CurrentGeom->mType];
+		ptr += gGeomSizes[CurrentGeom->mType];
 		Data = reinterpret_cast<const PxU32*>(ptr);
 	}
 	return false;
@@ -994,6 +994,7 @@ SweepTest::SweepTest(bool registerDeletionListener) :
 	mCachedTriIndex[0] = mCachedTriIndex[1] = mCachedTriIndex[2] = 0;
 	mNbCachedStatic = 0;
 	mNbCachedT		= 0;
+	mSharedRegion	= NULL;
 
 	mTouchedObstacleHandle	= PX_INVALID_OBSTACLE_HANDLE;
 	mTouchedPos					= PxVec3(0);
@@ -1018,6 +1019,9 @@ SweepTest::~SweepTest()
 	// set the TouchedObject to NULL so we unregister the actor/shape
 	mTouchedShape = NULL;
 	mTouchedActor = NULL;
+
+	if(mCctManager)
+		mCctManager->mGeometryCache.releaseRegion(mSharedRegion, mCctManager->mLockingEnabled);
 }
 
 void SweepTest::voidTestCache()
@@ -1073,7 +1077,7 @@ void SweepTest::updateCachedShapesRegistration(PxU32 startIndex, bool unregister
 		}
 
 		const PxU8* ptr = reinterpret_cast<const PxU8*>(data);
-		ptr += GeomSizes[CurrentGeom->mType];
+		ptr += gGeomSizes[CurrentGeom->mType];
 		data = reinterpret_cast<const PxU32*>(ptr);
 	}
 }
@@ -1177,7 +1181,7 @@ void SweepTest::onOriginShift(const PxVec3& shift)
 		sub(currentGeom->mOffset, shift);
 
 		PxU8* ptr = reinterpret_cast<PxU8*>(data);
-		ptr += GeomSizes[currentGeom->mType];
+		ptr += gGeomSizes[currentGeom->mType];
 		data = reinterpret_cast<PxU32*>(ptr);
 	}
 }
@@ -1368,7 +1372,25 @@ void SweepTest::updateTouchedGeoms(	const InternalCBData_FindTouchedGeom* userDa
 		if(filters.mFilterFlags & PxQueryFlag::eSTATIC)
 			filter.mStaticShapes	= true;
 		filter.mDynamicShapes	= false;
-		findTouchedGeometry(userData, mCacheBounds, mWorldTriangles, mTriangleIndices, mGeomStream, filter, mUserParams, mNbTessellation);
+
+		// PT: the static geometry can come from a region shared by the manager's controllers, in which case the region's
+		// bounds replace our cached volume. We acquire the new region before releasing the previous one, so that a region
+		// we keep using is not purged in-between.
+		{
+			GeometryCache& sharedCache = mCctManager->mGeometryCache;
+			const bool lockCache = mCctManager->mLockingEnabled || mCctManager->mConcurrentMoves;
+
+			GeometryCacheRegion* previousRegion = mSharedRegion;
+			mSharedRegion = NULL;
+
+			if(filter.mStaticShapes && !sharedCache.findRegion(mSharedRegion, userData, worldTemporalBox, mCacheBounds, mWorldTriangles, mTriangleIndices, mGeomStream, filter, mUserParams, lockCache))
+			{
+				findTouchedGeometry(userData, mCacheBounds, mWorldTriangles, mTriangleIndices, mGeomStream, filter, mUserParams, mNbTessellation);
+				mSharedRegion = sharedCache.addRegion(userData, mCacheBounds, mWorldTriangles, mTriangleIndices, mGeomStream, filter, mUserParams, lockCache);
+			}
+
+			sharedCache.releaseRegion(previousRegion, lockCache);
+		}
 
 		mNbCachedStatic = mGeomStream.size();
 		mNbCachedT = mWorldTriangles.size();
@@ -2283,19 +2305,16 @@ bool Controller::rideOnTouchedObject(SweptVolume& volume, const PxVec3& upDirect
 	return standingOnMoving;
 }
 
-PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& originalDisp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacleContext, bool constrainedClimbingMode)
+// PT: first stage of a move: per-controller setup and riding on the touched object. This only depends on the controller itself,
+// the scene and the obstacle context, not on the other CCTs. Returns true if the CCT is standing on a moving object.
+bool Controller::prepareMove(SweptVolume& volume, PxVec3& disp, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacleContext)
 {
-	const bool lockWrite = mManager->mLockingEnabled;
-	if(lockWrite)
-		mWriteLock.lock();	
-
 	mGlobalTime += PxF64(elapsedTime);
 
 	// Init CCT with per-controller settings
 	PxRenderBuffer* renderBuffer									= mManager->mRenderBuffer;
-	const PxU32 debugRenderFlags									= mManager->mDebugRenderingFlags;
 	mCctModule.mRenderBuffer										= renderBuffer;
-	mCctModule.mRenderFlags											= debugRenderFlags;
+	mCctModule.mRenderFlags											= mManager->mDebugRenderingFlags;
 	mCctModule.mUserParams											= mUserParams;
 	mCctModule.mFlags												|= STF_FIRST_UPDATE;
 	mCctModule.mUserParams.mMaxEdgeLength2							= mManager->mMaxEdgeLength * mManager->mMaxEdgeLength;
@@ -2309,7 +2328,7 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 
 	///////////
 
-	PxVec3 disp = originalDisp + mOverlapRecover;
+	disp += mOverlapRecover;
 	mOverlapRecover = PxVec3(0.0f);
 
 	bool standingOnMoving = false;	// PT: whether the CCT is currently standing on a moving object
@@ -2380,25 +2399,33 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 	}
 //	printf("standingOnMoving: %d\n", standingOnMoving);
 
-	///////////
-	PxArray<const void*>&		boxUserData		= mManager->mBoxUserData;
-	PxArray<PxExtendedBox>&		boxes			= mManager->mBoxes;
-	PxArray<const void*>&		capsuleUserData	= mManager->mCapsuleUserData;
-	PxArray<PxExtendedCapsule>&	capsules		= mManager->mCapsules;
-	PX_ASSERT(!boxUserData.size());
-	PX_ASSERT(!boxes.size());
-	PX_ASSERT(!capsuleUserData.size());
-	PX_ASSERT(!capsules.size());
+	return standingOnMoving;
+}
+
+// PT: gathers the other CCTs and the user-defined obstacles into the obstacle buffers. By default all the manager's controllers
+// are considered, but the caller can restrict this to a list of candidates (indices in the manager's array, in increasing order).
+// Since touched CCTs are later culled against the query boxes, skipping CCTs that cannot touch them does not change the result.
+void Controller::gatherObstacles(ObstacleBuffers& buffers, const PxControllerFilters& filters, const PxObstacleContext* obstacleContext, const PxU32* candidates, PxU32 nbCandidates)
+{
+	PxRenderBuffer* renderBuffer	= mManager->mRenderBuffer;
+	const PxU32 debugRenderFlags	= mManager->mDebugRenderingFlags;
+
+	PxArray<const void*>&		boxUserData		= buffers.mBoxUserData;
+	PxArray<PxExtendedBox>&		boxes			= buffers.mBoxes;
+	PxArray<const void*>&		capsuleUserData	= buffers.mCapsuleUserData;
+	PxArray<PxExtendedCapsule>&	capsules		= buffers.mCapsules;
+	PX_ASSERT(buffers.isEmpty());
 
 	{
 		PX_PROFILE_ZONE("CharacterController.filterCandidateControllers", getContextId());
 
 		// Experiment - to do better
-		const PxU32 nbControllers = mManager->getNbControllers();
+		const PxU32 nbControllers = candidates ? nbCandidates : mManager->getNbControllers();
 		Controller** controllers = mManager->getControllers();
 
-		for(PxU32 i=0;i<nbControllers;i++)
+		for(PxU32 j=0;j<nbControllers;j++)
 		{
+			const PxU32 i = candidates ? candidates[j] : j;
 			Controller* currentController = controllers[i];
 			if(currentController==this)
 				continue;
@@ -2449,10 +2476,9 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 		}
 	}
 
-	const ObstacleContext* obstacles = NULL;
 	if(obstacleContext)
 	{
-		obstacles = static_cast<const ObstacleContext*>(obstacleContext);
+		const ObstacleContext* obstacles = static_cast<const ObstacleContext*>(obstacleContext);
 
 		// PT: TODO: optimize this
 		const PxU32 nbExtraBoxes = obstacles->mBoxObstacles.size();
@@ -2507,23 +2533,29 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 			}
 		}
 	}
+}
 
+// PT: second stage of a move: gathers the touched geometry and runs the sweeps. The obstacle buffers must have been filled
+// by gatherObstacles(). The controller's position is updated but the kinematic actor is not, see updateKinematicTarget().
+PxControllerCollisionFlags Controller::sweepMove(SweptVolume& volume, const PxVec3& disp, bool standingOnMoving, PxF32 minDist, const PxControllerFilters& filters, const PxObstacleContext* obstacleContext, bool constrainedClimbingMode, ObstacleBuffers& buffers)
+{
+	const PxVec3& upDirection = mUserParams.mUpDirection;
 
 	UserObstacles userObstacles;
 
-	const PxU32 nbBoxes = boxes.size();
+	const PxU32 nbBoxes = buffers.mBoxes.size();
 	userObstacles.mNbBoxes			= nbBoxes;
-	userObstacles.mBoxes			= nbBoxes ? boxes.begin() : NULL;
-	userObstacles.mBoxUserData		= nbBoxes ? boxUserData.begin() : NULL;
+	userObstacles.mBoxes			= nbBoxes ? buffers.mBoxes.begin() : NULL;
+	userObstacles.mBoxUserData		= nbBoxes ? buffers.mBoxUserData.begin() : NULL;
 
-	const PxU32 nbCapsules = capsules.size();
+	const PxU32 nbCapsules = buffers.mCapsules.size();
 	userObstacles.mNbCapsules		= nbCapsules;
-	userObstacles.mCapsules			= nbCapsules ? capsules.begin() : NULL;
-	userObstacles.mCapsuleUserData	= nbCapsules ? capsuleUserData.begin() : NULL;
+	userObstacles.mCapsules			= nbCapsules ? buffers.mCapsules.begin() : NULL;
+	userObstacles.mCapsuleUserData	= nbCapsules ? buffers.mCapsuleUserData.begin() : NULL;
 
 	PxInternalCBData_OnHit userHitData;
 	userHitData.controller	= this;
-	userHitData.obstacles	= obstacles;
+	userHitData.obstacles	= static_cast<const ObstacleContext*>(obstacleContext);
 
 	///////////
 
@@ -2531,7 +2563,7 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 
 	PxInternalCBData_FindTouchedGeom findGeomData;
 	findGeomData.scene				= mScene;
-	findGeomData.renderBuffer		= renderBuffer;
+	findGeomData.renderBuffer		= mManager->mRenderBuffer;
 	findGeomData.cctShapeHashSet	= &mManager->mCCTShapes;
 
 	mCctModule.mFlags &= ~STF_WALK_EXPERIMENT;
@@ -2539,7 +2571,7 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 	// store new touched actor/shape. Then set new actor/shape to avoid register/unregister for same objects
 	const PxRigidActor* touchedActor = NULL;
 	const PxShape* touchedShape = NULL;
-	PxExtendedVec3 Backup = volume.mCenter;
+	const PxExtendedVec3 Backup = volume.mCenter;
 	collisionFlags = mCctModule.moveCharacter(&findGeomData, &userHitData, volume, disp, userObstacles, minDist, filters, constrainedClimbingMode, standingOnMoving, touchedActor, touchedShape, getContextId());
 
 	if(mCctModule.mFlags & STF_HIT_NON_WALKABLE)
@@ -2568,10 +2600,16 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 	// Copy results back
 	mPosition = volume.mCenter;
 
+	return collisionFlags;
+}
+
+// PT: last stage of a move: moves the kinematic actor to the new position, if the CCT has moved since 'previousPosition'.
+void Controller::updateKinematicTarget(const PxExtendedVec3& previousPosition)
+{
 	// Update kinematic actor
 	if(mKineActor)
 	{
-		const PxVec3 delta = diff(Backup, volume.mCenter);
+		const PxVec3 delta = diff(previousPosition, mPosition);
 		const PxF32 deltaM2 = delta.magnitudeSquared();
 		if(deltaM2!=0.0f)
 		{
@@ -2581,6 +2619,24 @@ PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& o
 			mKineActor->setKinematicTarget(targetPose);
 		}
 	}
+}
+
+PxControllerCollisionFlags Controller::move(SweptVolume& volume, const PxVec3& originalDisp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacleContext, bool constrainedClimbingMode)
+{
+	const bool lockWrite = mManager->mLockingEnabled;
+	if(lockWrite)
+		mWriteLock.lock();	
+
+	PxVec3 disp = originalDisp;
+	const bool standingOnMoving = prepareMove(volume, disp, elapsedTime, filters, obstacleContext);
+
+	ObstacleBuffers& buffers = mManager->mObstacleBuffers;
+	gatherObstacles(buffers, filters, obstacleContext, NULL, 0);
+
+	const PxExtendedVec3 previousPosition = volume.mCenter;
+	const PxControllerCollisionFlags collisionFlags = sweepMove(volume, disp, standingOnMoving, minDist, filters, obstacleContext, constrainedClimbingMode, buffers);
+
+	updateKinematicTarget(previousPosition);
 
 	mManager->resetObstaclesBuffers();
 
@@ -2599,10 +2655,15 @@ PxControllerCollisionFlags BoxController::move(const PxVec3& disp, PxF32 minDist
 
 	// Create internal swept box
 	SweptBox sweptBox;
+	getSweptBox(sweptBox);
+	return Controller::move(sweptBox, disp, minDist, elapsedTime, filters, obstacles, false);
+}
+
+void BoxController::getSweptBox(SweptBox& sweptBox) const
+{
 	sweptBox.mCenter		= mPosition;
 	sweptBox.mExtents		= PxVec3(mHalfHeight, mHalfSideExtent, mHalfForwardExtent);
 	sweptBox.mHalfHeight	= mHalfHeight;	// UBI
-	return Controller::move(sweptBox, disp, minDist, elapsedTime, filters, obstacles, false);
 }
 
 PxControllerCollisionFlags CapsuleController::move(const PxVec3& disp, PxF32 minDist, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacles)
@@ -2613,10 +2674,15 @@ PxControllerCollisionFlags CapsuleController::move(const PxVec3& disp, PxF32 min
 
 	// Create internal swept capsule
 	SweptCapsule sweptCapsule;
+	getSweptCapsule(sweptCapsule);
+	return Controller::move(sweptCapsule, disp, minDist, elapsedTime, filters, obstacles, mClimbingMode==PxCapsuleClimbingMode::eCONSTRAINED);
+}
+
+void CapsuleController::getSweptCapsule(SweptCapsule& sweptCapsule) const
+{
 	sweptCapsule.mCenter		= mPosition;
 	sweptCapsule.mRadius		= mRadius;
 	sweptCapsule.mHeight		= mHeight;
 	sweptCapsule.mHalfHeight	= mHeight*0.5f + mRadius;	// UBI
-	return Controller::move(sweptCapsule, disp, minDist, elapsedTime, filters, obstacles, mClimbingMode==PxCapsuleClimbingMode::eCONSTRAINED);
 }
 
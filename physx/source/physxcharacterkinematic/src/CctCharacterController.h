@@ -227,6 +227,9 @@ namespace Cct
 		PxF32			mRadius;	//!< Capsule's radius
 	};
 
+	// PT: size in bytes of each TouchedGeom type, used to parse geom streams
+	extern const PxU32 gGeomSizes[TouchedGeomType::eLAST];
+
 	struct SweptContact
 	{
 		PxExtendedVec3		mWorldPos;		// Contact position in world space
@@ -374,6 +377,7 @@ namespace Cct
 					mutable	PxU32		mCachedTriIndex[3];
 					PxU32				mNbCachedStatic;
 					PxU32				mNbCachedT;
+					GeometryCacheRegion*	mSharedRegion;	// Region of the manager's shared cache used by the static part of the stream
 	public:
 #ifdef USE_CONTACT_NORMAL_FOR_SLOPE_TEST
 					PxVec3				mContactNormalDownPass;
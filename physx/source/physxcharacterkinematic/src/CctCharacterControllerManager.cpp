@@ -38,6 +38,11 @@
 #include "PxPhysics.h"
 #include "CmRenderBuffer.h"
 #include "CmRadixSort.h"
+#include "CctSweptBox.h"
+#include "CctSweptCapsule.h"
+#include "foundation/PxFPU.h"
+#include "common/PxProfileZone.h"
+#include "CmParallelFor.h"
 
 using namespace physx;
 using namespace Cct;
@@ -55,7 +60,8 @@ CharacterControllerManager::CharacterControllerManager(PxScene& scene, bool lock
 	mOverlapRecovery						(true),
 	mPreciseSweeps							(true),
 	mPreventVerticalSlidingAgainstCeiling	(false),
-	mLockingEnabled							(lockingEnabled)
+	mLockingEnabled							(lockingEnabled),
+	mConcurrentMoves						(false)
 {
 	// PT: register ourself as a deletion listener, to be called by the SDK whenever an object is deleted	
 	PxPhysics& physics = scene.getPhysics();
@@ -275,23 +281,29 @@ void CharacterControllerManager::onRelease(const PxBase* observed, void* , PxDel
 			if(mLockingEnabled)
 				controller->mWriteLock.unlock();
 		}
+
+		// PT: unused regions whose shapes are not registered by any controller are caught by the static timestamp
+		// check instead, since releasing a static object changes the scene's static pruning structure.
+		mGeometryCache.onRelease(*observed, mLockingEnabled);
 	}
 }
 
 void CharacterControllerManager::registerObservedObject(const PxBase* obj)
 {	
-	if(mLockingEnabled)
+	const bool lock = mLockingEnabled || mConcurrentMoves;
+	if(lock)
 		mWriteLock.lock();
 
 	mObservedRefCountMap[obj].refCount++;	
 
-	if(mLockingEnabled)
+	if(lock)
 		mWriteLock.unlock();
 }
 
 void CharacterControllerManager::unregisterObservedObject(const PxBase* obj)
 {
-	if(mLockingEnabled)
+	const bool lock = mLockingEnabled || mConcurrentMoves;
+	if(lock)
 		mWriteLock.lock();
 
 	ObservedRefCounter& refCounter = mObservedRefCountMap[obj];
@@ -300,7 +312,7 @@ void CharacterControllerManager::unregisterObservedObject(const PxBase* obj)
 	if(!refCounter.refCount)
 		mObservedRefCountMap.erase(obj);
 
-	if(mLockingEnabled)
+	if(lock)
 		mWriteLock.unlock();
 }
 
@@ -365,10 +377,7 @@ void CharacterControllerManager::onObstacleAdded(PxObstacleHandle index, const P
 
 void CharacterControllerManager::resetObstaclesBuffers()
 {
-	mBoxUserData.resetOrClear();
-	mBoxes.resetOrClear();
-	mCapsuleUserData.resetOrClear();
-	mCapsules.resetOrClear();
+	mObstacleBuffers.reset();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -402,6 +411,18 @@ void CharacterControllerManager::setPreventVerticalSlidingAgainstCeiling(bool fl
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void CharacterControllerManager::setSharedGeometryCache(bool flag, float cellSize)
+{
+	if(flag && !(cellSize>0.0f))
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxControllerManager::setSharedGeometryCache(): cell size must be positive.");
+		return;
+	}
+	mGeometryCache.setCellSize(flag ? cellSize : 0.0f);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void CharacterControllerManager::shiftOrigin(const PxVec3& shift)
 {
 	for(PxU32 i=0; i < mControllers.size(); i++)
@@ -417,9 +438,11 @@ void CharacterControllerManager::shiftOrigin(const PxVec3& shift)
 	if(mRenderBuffer)
 		mRenderBuffer->shift(-shift);
 
+	// PT: regions are hashed on the world grid
+	mGeometryCache.invalidate();
+
 	// assumption is that these are just used for temporary stuff
-	PX_ASSERT(!mBoxes.size());
-	PX_ASSERT(!mCapsules.size());
+	PX_ASSERT(mObstacleBuffers.isEmpty());
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -511,7 +534,9 @@ static PxVec3 fixDir(const PxVec3& dir, const PxVec3& up)
 	return tangentCompo.getNormalized();
 }
 
-static void InteractionCharacterCharacter(Controller* entity0, Controller* entity1, PxF32 elapsedTime)
+// PT: returns the separation to add to entity0's overlap recovery vector, and to subtract from entity1's. This only reads
+// the controllers, so the pairs can be processed in parallel.
+static PxVec3 computeCharacterCharacterSeparation(Controller* entity0, Controller* entity1, PxF32 elapsedTime)
 {
 	PX_ASSERT(entity0);
 	PX_ASSERT(entity1);
@@ -519,7 +544,8 @@ static void InteractionCharacterCharacter(Controller* entity0, Controller* entit
 	PxF32 overlap=0.0f;
 	PxVec3 dir(0.0f);
 
-	if(entity0->mType>entity1->mType)
+	const bool swapped = entity0->mType>entity1->mType;
+	if(swapped)
 		PxSwap(entity0, entity1);
 
 	if(entity0->mType==PxControllerShapeType::eCAPSULE && entity1->mType==PxControllerShapeType::eCAPSULE)
@@ -620,27 +646,18 @@ static void InteractionCharacterCharacter(Controller* entity0, Controller* entit
 			overlap=maxOverlap;
 
 		const PxVec3 sep = dir * overlap * 0.5f;
-		entity0->mOverlapRecover += sep;
-		entity1->mOverlapRecover -= sep;
+		return swapped ? -sep : sep;
 	}
+	return PxVec3(0.0f);
 }
 
 // PT: TODO: this is the very old version, revisit with newer one
-static void completeBoxPruning(const PxBounds3* bounds, PxU32 nb, PxArray<PxU32>& pairs)
+// PT: 'sorted' lists the boxes by increasing min x
+static void boxPruning(const PxBounds3* bounds, const PxU32* sorted, PxU32 nb, PxArray<PxU32>& pairs)
 {
-	if(!nb)
-		return;
-
 	pairs.clear();
 
-	float* PosList = PX_ALLOCATE(float, nb, "completeBoxPruning");
-
-	for(PxU32 i=0;i<nb;i++)
-		PosList[i] = bounds[i].minimum.x;
-
-	/*static*/ Cm::RadixSortBuffered RS;	// Static for coherence
-	const PxU32* Sorted = RS.Sort(PosList, nb).GetRanks();
-
+	const PxU32* Sorted = sorted;
 	const PxU32* const LastSorted = &Sorted[nb];
 	const PxU32* RunningAddress = Sorted;
 	PxU32 Index0, Index1;
@@ -648,11 +665,11 @@ static void completeBoxPruning(const PxBounds3* bounds, PxU32 nb, PxArray<PxU32>
 	{
 		Index0 = *Sorted++;
 
-		while(RunningAddress<LastSorted && PosList[*RunningAddress++]<PosList[Index0]);
+		while(RunningAddress<LastSorted && bounds[*RunningAddress++].minimum.x<bounds[Index0].minimum.x);
 
 		const PxU32* RunningAddress2 = RunningAddress;
 
-		while(RunningAddress2<LastSorted && PosList[Index1 = *RunningAddress2++]<=bounds[Index0].maximum.x)
+		while(RunningAddress2<LastSorted && bounds[Index1 = *RunningAddress2++].minimum.x<=bounds[Index0].maximum.x)
 		{
 			if(Index0!=Index1)
 			{
@@ -664,52 +681,588 @@ static void completeBoxPruning(const PxBounds3* bounds, PxU32 nb, PxArray<PxU32>
 			}
 		}
 	}
+}
+
+static const PxU32* sortBoxes(Cm::RadixSortBuffered& RS, const PxBounds3* bounds, PxU32 nb)
+{
+	float* PosList = PX_ALLOCATE(float, nb, "sortBoxes");
+
+	for(PxU32 i=0;i<nb;i++)
+		PosList[i] = bounds[i].minimum.x;
+
+	const PxU32* Sorted = RS.Sort(PosList, nb).GetRanks();
 
 	PX_FREE(PosList);
+	return Sorted;
 }
 
-void CharacterControllerManager::computeInteractions(PxF32 elapsedTime, PxControllerFilterCallback* cctFilterCb)
+static void completeBoxPruning(const PxBounds3* bounds, PxU32 nb, PxArray<PxU32>& pairs)
 {
-	PxU32 nbControllers = mControllers.size();
-	Controller** controllers = mControllers.begin();
+	if(!nb)
+		return;
+
+	Cm::RadixSortBuffered RS;
+	boxPruning(bounds, sortBoxes(RS, bounds, nb), nb, pairs);
+}
+
+static PX_FORCE_INLINE bool sortedBefore(const PxBounds3* bounds, PxU32 index0, PxU32 index1)
+{
+	const float x0 = bounds[index0].minimum.x;
+	const float x1 = bounds[index1].minimum.x;
+	return x0<x1 || (x0==x1 && index0<index1);
+}
+
+// PT: restores the order of boxes sorted in a previous call. Controllers move coherently, so an insertion sort runs in
+// about linear time. Ties are broken by index, which gives the same order as the (stable) radix sort.
+static void updateSortedBoxes(const PxBounds3* bounds, PxU32* sorted, PxU32 nb)
+{
+	for(PxU32 i=1;i<nb;i++)
+	{
+		const PxU32 current = sorted[i];
+		PxU32 j = i;
+		while(j && sortedBefore(bounds, current, sorted[j-1]))
+		{
+			sorted[j] = sorted[j-1];
+			j--;
+		}
+		sorted[j] = current;
+	}
+}
+
+namespace
+{
+	struct InteractionContext
+	{
+		Controller* const*	mControllers;
+		const PxU32*		mPairs;
+		PxVec3*				mSeparations;
+		PxF32				mElapsedTime;
+	};
+}
 
-	PxBounds3* boxes = PX_ALLOCATE(PxBounds3, nbControllers, "CharacterControllerManager::computeInteractions");	// PT: TODO: get rid of alloc
-	PxBounds3* runningBoxes = boxes;
+static void computeSeparations(void* userData, PxU32 startIndex, PxU32 endIndex)
+{
+	PX_SIMD_GUARD;
 
-	while(nbControllers--)
+	const InteractionContext& context = *reinterpret_cast<const InteractionContext*>(userData);
+	for(PxU32 i=startIndex;i<endIndex;i++)
 	{
-		Controller* current = *controllers++;
+		Controller* ctrl0 = context.mControllers[context.mPairs[i*2+0]];
+		Controller* ctrl1 = context.mControllers[context.mPairs[i*2+1]];
+		context.mSeparations[i] = computeCharacterCharacterSeparation(ctrl0, ctrl1, context.mElapsedTime);
+	}
+}
 
+void CharacterControllerManager::computeInteractions(PxF32 elapsedTime, PxControllerFilterCallback* cctFilterCb, PxCpuDispatcher* dispatcher)
+{
+	PX_PROFILE_ZONE("CharacterController.computeInteractions", PxU64(&mScene));
+
+	const PxU32 nbControllers = mControllers.size();
+	Controller* const* controllers = mControllers.begin();
+
+	// PT: the arrays are kept from one call to the next, to avoid allocations
+	mInteractionBounds.resizeUninitialized(nbControllers);
+	PxBounds3* boxes = mInteractionBounds.begin();
+	for(PxU32 i=0;i<nbControllers;i++)
+	{
 		PxExtendedBounds3 extBox;
-		current->getWorldBox(extBox);
+		controllers[i]->getWorldBox(extBox);
 
-		*runningBoxes++ = PxBounds3(toVec3(extBox.minimum), toVec3(extBox.maximum));	// ### LOSS OF ACCURACY
+		boxes[i] = PxBounds3(toVec3(extBox.minimum), toVec3(extBox.maximum));	// ### LOSS OF ACCURACY
+	}
+
+	// PT: the sorted order of the previous call is a good starting point, unless controllers have been added or removed. The
+	// order only contains valid indices when the number of controllers didn't change.
+	if(mInteractionOrder.size()==nbControllers)
+	{
+		updateSortedBoxes(boxes, mInteractionOrder.begin(), nbControllers);
+	}
+	else if(nbControllers)
+	{
+		Cm::RadixSortBuffered RS;
+		const PxU32* sorted = sortBoxes(RS, boxes, nbControllers);
+		mInteractionOrder.resizeUninitialized(nbControllers);
+		PxMemCopy(mInteractionOrder.begin(), sorted, sizeof(PxU32)*nbControllers);
+	}
+	else
+	{
+		mInteractionOrder.clear();
 	}
 
-	//
+	boxPruning(boxes, mInteractionOrder.begin(), nbControllers, mInteractionPairs);
 
-	const PxU32 nbEntities = PxU32(runningBoxes - boxes);
+	// PT: the filtering callback is called on this thread, in pair order
+	if(cctFilterCb)
+	{
+		PxU32* pairs = mInteractionPairs.begin();
+		const PxU32 nbPairs = mInteractionPairs.size()>>1;
+		PxU32 nbKept = 0;
+		for(PxU32 i=0;i<nbPairs;i++)
+		{
+			const PxU32 index0 = pairs[i*2+0];
+			const PxU32 index1 = pairs[i*2+1];
+			if(cctFilterCb->filter(*controllers[index0]->getPxController(), *controllers[index1]->getPxController()))
+			{
+				pairs[nbKept*2+0] = index0;
+				pairs[nbKept*2+1] = index1;
+				nbKept++;
+			}
+		}
+		mInteractionPairs.forceSize_Unsafe(nbKept*2);
+	}
+
+	// PT: each pair only reads its controllers, so the separations can be computed in parallel. They are then accumulated
+	// in pair order, which gives the same results regardless of the dispatcher.
+	const PxU32 nbPairs = mInteractionPairs.size()>>1;
+	mInteractionSeparations.resizeUninitialized(nbPairs);
 
-	PxArray<PxU32> pairs;	// PT: TODO: get rid of alloc
-	completeBoxPruning(boxes, nbEntities, pairs);
+	InteractionContext context;
+	context.mControllers	= controllers;
+	context.mPairs			= mInteractionPairs.begin();
+	context.mSeparations	= mInteractionSeparations.begin();
+	context.mElapsedTime	= elapsedTime;
+	Cm::parallelFor(dispatcher, nbPairs, 64, computeSeparations, &context);
 
-	PxU32 nbPairs = pairs.size()>>1;
-	const PxU32* indices = pairs.begin();
-	while(nbPairs--)
+	for(PxU32 i=0;i<nbPairs;i++)
 	{
-		const PxU32 index0 = *indices++;
-		const PxU32 index1 = *indices++;
-		Controller* ctrl0 = mControllers[index0];
-		Controller* ctrl1 = mControllers[index1];
+		const PxVec3& sep = mInteractionSeparations[i];
+		if(sep.isZero())
+			continue;
+
+		controllers[mInteractionPairs[i*2+0]]->mOverlapRecover += sep;
+		controllers[mInteractionPairs[i*2+1]]->mOverlapRecover -= sep;
+	}
+}
 
-		bool keep=true;
-		if(cctFilterCb)
-			keep = cctFilterCb->filter(*ctrl0->getPxController(), *ctrl1->getPxController());
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-		if(keep)
-			InteractionCharacterCharacter(ctrl0, ctrl1, elapsedTime);
+namespace
+{
+	// PT: per-controller data for moveBatch()
+	struct BatchedMove
+	{
+		Controller*					mController;
+		PxExtendedVec3				mCenter;			// Volume center after Controller::prepareMove(), i.e. after riding on the touched object
+		PxVec3						mDisp;				// Displacement after Controller::prepareMove()
+		PxU32						mManagerIndex;
+		PxU32						mFirstCandidate;	// Candidate CCTs, see Controller::gatherObstacles()
+		PxU32						mNbCandidates;
+		PxControllerCollisionFlags	mCollisionFlags;
+		bool						mStandingOnMoving;
+	};
+
+	struct MoveBatchContext
+	{
+		CharacterControllerManager*	mManager;
+		BatchedMove*				mMoves;
+		PxBounds3*					mReachBounds;		// Per-controller bounds, indexed by manager index. See computeMoveBounds().
+		PxBounds3*					mQueryBounds;
+		const PxVec3*				mDisplacements;
+		const PxU32*				mCandidates;
+		const PxU32*				mIslandStarts;
+		const PxU32*				mIslandMoves;
+		PxF32						mMinDist;
+		PxF32						mElapsedTime;
+		const PxControllerFilters*	mFilters;
+		const PxObstacleContext*	mObstacles;
+		bool						mReadLock;
+	};
+}
+
+static SweptVolume& initSweptVolume(Controller* controller, SweptBox& sweptBox, SweptCapsule& sweptCapsule, bool& constrainedClimbingMode)
+{
+	if(controller->mType==PxControllerShapeType::eBOX)
+	{
+		static_cast<BoxController*>(controller)->getSweptBox(sweptBox);
+		constrainedClimbingMode = false;
+		return sweptBox;
 	}
 
-	PX_FREE(boxes);
+	PX_ASSERT(controller->mType==PxControllerShapeType::eCAPSULE);
+	CapsuleController* capsuleController = static_cast<CapsuleController*>(controller);
+	capsuleController->getSweptCapsule(sweptCapsule);
+	constrainedClimbingMode = capsuleController->mClimbingMode==PxCapsuleClimbingMode::eCONSTRAINED;
+	return sweptCapsule;
+}
+
+// PT: world-space AABB of the OBB or capsule seen by the other CCTs. Contrary to Controller::getWorldBox() this takes the up
+// direction into account for box controllers.
+static void getControllerBounds(Controller* controller, PxExtendedBounds3& bounds)
+{
+	if(controller->mType==PxControllerShapeType::eBOX)
+	{
+		PxExtendedBox obb;
+		static_cast<BoxController*>(controller)->getOBB(obb);
+
+		const PxMat33 rot(obb.rot);
+		const PxVec3 extents = rot.column0.abs() * obb.extents.x + rot.column1.abs() * obb.extents.y + rot.column2.abs() * obb.extents.z;
+		setCenterExtents(bounds, obb.center, extents);
+	}
+	else
+	{
+		PX_ASSERT(controller->mType==PxControllerShapeType::eCAPSULE);
+		PxExtendedCapsule capsule;
+		static_cast<CapsuleController*>(controller)->getCapsule(capsule);
+
+		const PxExtended r = PxExtended(capsule.radius);
+		bounds.minimum = PxExtendedVec3(PxMin(capsule.p0.x, capsule.p1.x) - r, PxMin(capsule.p0.y, capsule.p1.y) - r, PxMin(capsule.p0.z, capsule.p1.z) - r);
+		bounds.maximum = PxExtendedVec3(PxMax(capsule.p0.x, capsule.p1.x) + r, PxMax(capsule.p0.y, capsule.p1.y) + r, PxMax(capsule.p0.z, capsule.p1.z) + r);
+	}
+}
+
+// PT: conservative bounds for the next move of a controller:
+// - 'reachBounds' contains all the positions the CCT can occupy, i.e. where the other CCTs can see it
+// - 'queryBounds' contains all the boxes the CCT can use to gather the other CCTs, see SweepTest::updateTouchedGeoms()
+// We assume that the sweeps never move the CCT further than twice the displacement plus twice the step offset (up & down passes,
+// walk experiment), plus its own size when the overlap recovery module can push it out of a penetrating shape.
+static void computeMoveBounds(Controller* controller, const SweptVolume& volume, const PxVec3& disp, bool overlapRecovery, PxBounds3& reachBounds, PxBounds3& queryBounds)
+{
+	const SweepTest& test = controller->mCctModule;
+
+	// Start position, as seen by the other CCTs, and temporal box at the start of the sweeps
+	PxExtendedBounds3 box;
+	getControllerBounds(controller, box);
+	PxVec3 extents;
+	getExtents(box, extents);
+
+	PxF32 reach = 2.0f * (disp.magnitude() + test.mUserParams.mStepOffset) + test.mUserParams.mContactOffset;
+	if(overlapRecovery)
+		reach += 2.0f * extents.maxElement();
+
+	PxExtendedBounds3 temporalBox;
+	volume.computeTemporalBox(test, temporalBox, volume.mCenter, PxVec3(0.0f));
+	add(box, temporalBox);
+
+	PxExtendedVec3 center;
+	getCenter(box, center);
+	getExtents(box, extents);
+	extents += PxVec3(reach);
+	setCenterExtents(box, center, extents);
+	reachBounds = PxBounds3(toVec3(box.minimum), toVec3(box.maximum));	// ### LOSS OF ACCURACY
+
+	// The temporal boxes used during the move are inside the reach bounds. The cached bounds are grown versions of these boxes,
+	// shifted along the side motion by less than 0.45 times the growth.
+	const PxF32 growth = test.mVolumeGrowth;
+	extents = extents * growth + PxVec3(0.9f * (growth - 1.0f) * extents.magnitude());
+	setCenterExtents(box, center, extents);
+
+	// The bounds cached by previous moves can also be reused as-is. Empty bounds leave the box unchanged.
+	add(box, test.mCacheBounds);
+	queryBounds = PxBounds3(toVec3(box.minimum), toVec3(box.maximum));	// ### LOSS OF ACCURACY
 }
 
+static void prepareMoves(void* userData, PxU32 startIndex, PxU32 endIndex)
+{
+	PX_SIMD_GUARD;
+
+	const MoveBatchContext& context = *reinterpret_cast<const MoveBatchContext*>(userData);
+	CharacterControllerManager* manager = context.mManager;
+	PX_PROFILE_ZONE("CharacterController.moveBatch.prepare", PxU64(&manager->mScene));
+
+	if(context.mReadLock)
+		manager->mScene.lockRead(PX_FL);
+
+	const bool lockWrite = manager->mLockingEnabled;
+	for(PxU32 i=startIndex;i<endIndex;i++)
+	{
+		BatchedMove& move = context.mMoves[i];
+		Controller* controller = move.mController;
+
+		if(lockWrite)
+			controller->mWriteLock.lock();
+
+		SweptBox sweptBox;
+		SweptCapsule sweptCapsule;
+		bool constrainedClimbingMode;
+		SweptVolume& volume = initSweptVolume(controller, sweptBox, sweptCapsule, constrainedClimbingMode);
+
+		PxVec3 disp = context.mDisplacements[i];
+		move.mStandingOnMoving = controller->prepareMove(volume, disp, context.mElapsedTime, *context.mFilters, context.mObstacles);
+		move.mCenter = volume.mCenter;
+		move.mDisp = disp;
+
+		computeMoveBounds(controller, volume, disp, manager->mOverlapRecovery, context.mReachBounds[move.mManagerIndex], context.mQueryBounds[move.mManagerIndex]);
+
+		if(lockWrite)
+			controller->mWriteLock.unlock();
+	}
+
+	if(context.mReadLock)
+		manager->mScene.unlockRead();
+}
+
+static void sweepIslands(void* userData, PxU32 startIndex, PxU32 endIndex)
+{
+	PX_SIMD_GUARD;
+
+	const MoveBatchContext& context = *reinterpret_cast<const MoveBatchContext*>(userData);
+	CharacterControllerManager* manager = context.mManager;
+	PX_PROFILE_ZONE("CharacterController.moveBatch.sweep", PxU64(&manager->mScene));
+
+	if(context.mReadLock)
+		manager->mScene.lockRead(PX_FL);
+
+	const bool lockWrite = manager->mLockingEnabled;
+	ObstacleBuffers buffers;
+	for(PxU32 i=startIndex;i<endIndex;i++)
+	{
+		// PT: the controllers of an island are moved in batch order, as with a sequence of PxController::move() calls
+		for(PxU32 j=context.mIslandStarts[i];j<context.mIslandStarts[i+1];j++)
+		{
+			BatchedMove& move = context.mMoves[context.mIslandMoves[j]];
+			Controller* controller = move.mController;
+
+			if(lockWrite)
+				controller->mWriteLock.lock();
+
+			SweptBox sweptBox;
+			SweptCapsule sweptCapsule;
+			bool constrainedClimbingMode;
+			SweptVolume& volume = initSweptVolume(controller, sweptBox, sweptCapsule, constrainedClimbingMode);
+			volume.mCenter = move.mCenter;
+
+			controller->gatherObstacles(buffers, *context.mFilters, context.mObstacles, context.mCandidates + move.mFirstCandidate, move.mNbCandidates);
+			move.mCollisionFlags = controller->sweepMove(volume, move.mDisp, move.mStandingOnMoving, context.mMinDist, *context.mFilters, context.mObstacles, constrainedClimbingMode, buffers);
+			buffers.reset();
+
+			if(lockWrite)
+				controller->mWriteLock.unlock();
+		}
+	}
+
+	if(context.mReadLock)
+		manager->mScene.unlockRead();
+}
+
+static PX_FORCE_INLINE PxU32 findIsland(PxU32* parents, PxU32 index)
+{
+	while(parents[index]!=index)
+	{
+		parents[index] = parents[parents[index]];
+		index = parents[index];
+	}
+	return index;
+}
+
+void CharacterControllerManager::moveBatch(PxU32 nbControllers, PxController* const* controllers, const PxVec3* displacements, PxF32 minDist, PxF32 elapsedTime,
+											const PxControllerFilters& filters, const PxObstacleContext* obstacles, PxControllerCollisionFlags* collisionFlags, PxCpuDispatcher* dispatcher)
+{
+	PX_PROFILE_ZONE("CharacterController.moveBatch", PxU64(&mScene));
+
+	if(!nbControllers)
+		return;
+
+	if(!controllers || !displacements)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxControllerManager::moveBatch(): NULL controllers or displacements.");
+		return;
+	}
+
+	// PT: map the batch to the manager's controllers. The manager index is used to encode touched CCTs, and defines the order
+	// in which they are gathered by Controller::gatherObstacles().
+	PxHashMap<const PxController*, PxU32> batchIndices;
+	for(PxU32 i=0;i<nbControllers;i++)
+	{
+		if(!batchIndices.insert(controllers[i], i))
+		{
+			PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxControllerManager::moveBatch(): the same controller appears several times in the batch.");
+			return;
+		}
+	}
+
+	const PxU32 nbManagerControllers = mControllers.size();
+	PxArray<BatchedMove> moves;
+	PxArray<PxU32> managerToBatch;
+	PxArray<PxBounds3> reachBounds;
+	PxArray<PxBounds3> queryBounds;
+	moves.resizeUninitialized(nbControllers);
+	managerToBatch.resizeUninitialized(nbManagerControllers);
+	reachBounds.resizeUninitialized(nbManagerControllers);
+	queryBounds.resizeUninitialized(nbManagerControllers);
+	PxU32 nbFound = 0;
+	for(PxU32 i=0;i<nbManagerControllers;i++)
+	{
+		Controller* controller = mControllers[i];
+		const PxHashMap<const PxController*, PxU32>::Entry* entry = batchIndices.find(controller->getPxController());
+		if(entry)
+		{
+			BatchedMove& move = moves[entry->second];
+			move.mController = controller;
+			move.mManagerIndex = i;
+			managerToBatch[i] = entry->second;
+			nbFound++;
+		}
+		else
+		{
+			// PT: controllers that are not part of the batch do not move
+			managerToBatch[i] = 0xffffffff;
+			PxExtendedBounds3 box;
+			getControllerBounds(controller, box);
+			reachBounds[i] = PxBounds3(toVec3(box.minimum), toVec3(box.maximum));	// ### LOSS OF ACCURACY
+			queryBounds[i] = reachBounds[i];
+		}
+	}
+
+	if(nbFound!=nbControllers)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxControllerManager::moveBatch(): controller does not belong to this manager.");
+		return;
+	}
+
+	// PT: debug rendering writes to the shared render buffer, so we don't multithread in that case
+	if(mRenderBuffer)
+		dispatcher = NULL;
+
+	MoveBatchContext context;
+	context.mManager		= this;
+	context.mMoves			= moves.begin();
+	context.mReachBounds	= reachBounds.begin();
+	context.mQueryBounds	= queryBounds.begin();
+	context.mDisplacements	= displacements;
+	context.mCandidates		= NULL;
+	context.mIslandStarts	= NULL;
+	context.mIslandMoves	= NULL;
+	context.mMinDist		= minDist;
+	context.mElapsedTime	= elapsedTime;
+	context.mFilters		= &filters;
+	context.mObstacles		= obstacles;
+	context.mReadLock		= mScene.getFlags() & PxSceneFlag::eREQUIRE_RW_LOCK;
+
+	mConcurrentMoves = dispatcher!=NULL;
+
+	// PT: first stage: riding on touched objects & move bounds. This does not depend on the other CCTs.
+	Cm::parallelFor(dispatcher, nbControllers, 32, prepareMoves, &context);
+
+	// PT: second stage: find the CCTs that can interact during the move, and group the moving ones into islands
+	PxArray<PxU32> candidates;
+	PxArray<PxU32> islandStarts;
+	PxArray<PxU32> islandMoves(nbControllers);
+	{
+		PX_PROFILE_ZONE("CharacterController.moveBatch.islands", PxU64(&mScene));
+
+		// PT: the query bounds contain the reach bounds, so the box pruning finds all the potential interactions. We then only
+		// keep the CCTs that a moving CCT can actually see. Controllers that are not part of the batch are static obstacles
+		// and do not connect islands.
+		PxArray<PxU32> pairs;
+		completeBoxPruning(queryBounds.begin(), nbManagerControllers, pairs);
+
+		PxArray<PxU32> parents(nbControllers);
+		for(PxU32 i=0;i<nbControllers;i++)
+		{
+			parents[i] = i;
+			moves[i].mNbCandidates = 0;
+		}
+
+		// PT: visible CCTs, as (batch index of the moving CCT, manager index of the seen CCT) pairs
+		PxArray<PxU32> edges;
+		edges.reserve(pairs.size()*2);
+		PxArray<PxU32> managerCounts(nbManagerControllers+1, 0);
+
+		const PxU32 nbPairs = pairs.size()/2;
+		for(PxU32 i=0;i<nbPairs;i++)
+		{
+			const PxU32 managerIndex0 = pairs[i*2+0];
+			const PxU32 managerIndex1 = pairs[i*2+1];
+			const PxU32 batchIndex0 = managerToBatch[managerIndex0];
+			const PxU32 batchIndex1 = managerToBatch[managerIndex1];
+
+			const bool sees1 = batchIndex0!=0xffffffff && queryBounds[managerIndex0].intersects(reachBounds[managerIndex1]);
+			const bool sees0 = batchIndex1!=0xffffffff && queryBounds[managerIndex1].intersects(reachBounds[managerIndex0]);
+			if(sees1)
+			{
+				edges.pushBack(batchIndex0);
+				edges.pushBack(managerIndex1);
+				moves[batchIndex0].mNbCandidates++;
+				managerCounts[managerIndex1+1]++;
+			}
+			if(sees0)
+			{
+				edges.pushBack(batchIndex1);
+				edges.pushBack(managerIndex0);
+				moves[batchIndex1].mNbCandidates++;
+				managerCounts[managerIndex0+1]++;
+			}
+			if((sees0 || sees1) && batchIndex0!=0xffffffff && batchIndex1!=0xffffffff)
+			{
+				const PxU32 root0 = findIsland(parents.begin(), batchIndex0);
+				const PxU32 root1 = findIsland(parents.begin(), batchIndex1);
+				if(root0!=root1)
+					parents[PxMax(root0, root1)] = PxMin(root0, root1);
+			}
+		}
+
+		PxU32 nbCandidates = 0;
+		for(PxU32 i=0;i<nbControllers;i++)
+		{
+			moves[i].mFirstCandidate = nbCandidates;
+			nbCandidates += moves[i].mNbCandidates;
+			moves[i].mNbCandidates = 0;
+		}
+
+		// PT: keep the manager order, so that the touched CCTs are gathered in the same order as in PxController::move(). The
+		// edges are first bucketed by seen CCT, then distributed to the moving CCTs, which leaves each candidate list sorted.
+		const PxU32 nbEdges = edges.size()/2;
+		for(PxU32 i=0;i<nbManagerControllers;i++)
+			managerCounts[i+1] += managerCounts[i];
+
+		PxArray<PxU32> sortedEdges;
+		sortedEdges.resizeUninitialized(nbEdges);
+		for(PxU32 i=0;i<nbEdges;i++)
+			sortedEdges[managerCounts[edges[i*2+1]]++] = i;
+
+		candidates.resizeUninitialized(nbCandidates);
+		for(PxU32 i=0;i<nbEdges;i++)
+		{
+			const PxU32 edge = sortedEdges[i];
+			BatchedMove& move = moves[edges[edge*2+0]];
+			candidates[move.mFirstCandidate + move.mNbCandidates++] = edges[edge*2+1];
+		}
+
+		// PT: islands are numbered by their first controller in the batch, and list their controllers in batch order
+		PxArray<PxU32> islandIds(nbControllers);
+		PxU32 nbIslands = 0;
+		for(PxU32 i=0;i<nbControllers;i++)
+		{
+			const PxU32 root = findIsland(parents.begin(), i);
+			islandIds[i] = root==i ? nbIslands++ : islandIds[root];
+		}
+
+		islandStarts.resize(nbIslands+1, 0);
+		for(PxU32 i=0;i<nbControllers;i++)
+			islandStarts[islandIds[i]+1]++;
+		for(PxU32 i=0;i<nbIslands;i++)
+			islandStarts[i+1] += islandStarts[i];
+
+		PxArray<PxU32> offsets(islandStarts);
+		for(PxU32 i=0;i<nbControllers;i++)
+			islandMoves[offsets[islandIds[i]]++] = i;
+	}
+
+	// PT: third stage: the islands are independent and can be moved in parallel
+	context.mCandidates		= candidates.begin();
+	context.mIslandStarts	= islandStarts.begin();
+	context.mIslandMoves	= islandMoves.begin();
+	Cm::parallelFor(dispatcher, islandStarts.size() - 1, 4, sweepIslands, &context);
+
+	mConcurrentMoves = false;
+
+	// PT: last stage: update the kinematic actors on the calling thread
+	{
+		PX_PROFILE_ZONE("CharacterController.moveBatch.kinematicTargets", PxU64(&mScene));
+
+		const bool writeLock = context.mReadLock;
+		if(writeLock)
+			mScene.lockWrite(PX_FL);
+
+		for(PxU32 i=0;i<nbControllers;i++)
+		{
+			const BatchedMove& move = moves[i];
+			move.mController->updateKinematicTarget(move.mCenter);
+			if(collisionFlags)
+				collisionFlags[i] = move.mCollisionFlags;
+		}
+
+		if(writeLock)
+			mScene.unlockWrite();
+	}
+}
@@ -40,6 +40,7 @@
 #include "characterkinematic/PxControllerObstacles.h"
 #include "PxDeletionListener.h"
 #include "CctUtils.h"
+#include "CctGeometryCache.h"
 #include "foundation/PxMutex.h"
 #include "foundation/PxArray.h"
 #include "foundation/PxUserAllocated.h"
@@ -62,6 +63,29 @@ namespace Cct
 
 	typedef PxHashMap<const PxBase*, ObservedRefCounter>	ObservedRefCountMap;
 
+	// PT: temporary buffers for the obstacles (other CCTs and user-defined obstacles) gathered by a move
+	struct ObstacleBuffers
+	{
+		PxArray<const void*>		mBoxUserData;
+		PxArray<PxExtendedBox>		mBoxes;
+
+		PxArray<const void*>		mCapsuleUserData;
+		PxArray<PxExtendedCapsule>	mCapsules;
+
+		PX_FORCE_INLINE	void	reset()
+		{
+			mBoxUserData.resetOrClear();
+			mBoxes.resetOrClear();
+			mCapsuleUserData.resetOrClear();
+			mCapsules.resetOrClear();
+		}
+
+		PX_FORCE_INLINE	bool	isEmpty()	const
+		{
+			return !mBoxUserData.size() && !mBoxes.size() && !mCapsuleUserData.size() && !mCapsules.size();
+		}
+	};
+
 	//Implements the PxControllerManager interface, this class used to be called ControllerManager
 	class CharacterControllerManager : public PxControllerManager, public PxUserAllocated, public PxDeletionListener
 	{
@@ -85,11 +109,14 @@ namespace Cct
 		virtual			PxU32							getNbObstacleContexts() const	PX_OVERRIDE	PX_FINAL;
 		virtual			PxObstacleContext*				getObstacleContext(PxU32 index)	PX_OVERRIDE	PX_FINAL;
 		virtual			PxObstacleContext*				createObstacleContext()	PX_OVERRIDE	PX_FINAL;
-		virtual			void							computeInteractions(PxF32 elapsedTime, PxControllerFilterCallback* cctFilterCb)	PX_OVERRIDE	PX_FINAL;
+		virtual			void							computeInteractions(PxF32 elapsedTime, PxControllerFilterCallback* cctFilterCb, PxCpuDispatcher* dispatcher)	PX_OVERRIDE	PX_FINAL;
+		virtual			void							moveBatch(PxU32 nbControllers, PxController* const* controllers, const PxVec3* displacements, PxF32 minDist, PxF32 elapsedTime,
+																	const PxControllerFilters& filters, const PxObstacleContext* obstacles, PxControllerCollisionFlags* collisionFlags, PxCpuDispatcher* dispatcher)	PX_OVERRIDE	PX_FINAL;
 		virtual			void							setTessellation(bool flag, float maxEdgeLength)	PX_OVERRIDE	PX_FINAL;
 		virtual			void							setOverlapRecoveryModule(bool flag)	PX_OVERRIDE	PX_FINAL;
 		virtual			void							setPreciseSweeps(bool flag)	PX_OVERRIDE	PX_FINAL;
 		virtual			void							setPreventVerticalSlidingAgainstCeiling(bool flag)	PX_OVERRIDE	PX_FINAL;
+		virtual			void							setSharedGeometryCache(bool flag, float cellSize)	PX_OVERRIDE	PX_FINAL;
 		virtual			void							shiftOrigin(const PxVec3& shift)	PX_OVERRIDE	PX_FINAL;
 		//~PxControllerManager
 
@@ -114,17 +141,22 @@ namespace Cct
 						PxRenderBuffer*					mRenderBuffer;
 						PxControllerDebugRenderFlags	mDebugRenderingFlags;
 		// Shared buffers for obstacles
-						PxArray<const void*>			mBoxUserData;
-						PxArray<PxExtendedBox>			mBoxes;
-
-						PxArray<const void*>			mCapsuleUserData;
-						PxArray<PxExtendedCapsule>		mCapsules;
+						ObstacleBuffers					mObstacleBuffers;
 
 						PxArray<Controller*>			mControllers;
 						PxHashSet<PxShape*>				mCCTShapes;
 
 						PxArray<ObstacleContext*>		mObstacleContexts;
 
+		// Static geometry shared by the controllers, see setSharedGeometryCache()
+						GeometryCache					mGeometryCache;
+
+		// Persistent data for computeInteractions()
+						PxArray<PxBounds3>				mInteractionBounds;
+						PxArray<PxU32>					mInteractionOrder;		// Controllers sorted by min x in the previous call
+						PxArray<PxU32>					mInteractionPairs;
+						PxArray<PxVec3>					mInteractionSeparations;
+
 						float							mMaxEdgeLength;
 						bool							mTessellation;
 
@@ -133,6 +165,7 @@ namespace Cct
 						bool							mPreventVerticalSlidingAgainstCeiling;
 
 						bool							mLockingEnabled;						
+						bool							mConcurrentMoves;	// True while moveBatch() runs controllers on several threads
 	private:
 						ObservedRefCountMap				mObservedRefCountMap;
 						mutable	PxMutex					mWriteLock;			// Lock used for guarding pointers in observedrefcountmap
@@ -68,6 +68,12 @@ namespace Cct
 
 					void							onRelease(const PxBase& observed);
 
+		// The stages of a move, shared by PxController::move() and PxControllerManager::moveBatch()
+					bool							prepareMove(SweptVolume& volume, PxVec3& disp, PxF32 elapsedTime, const PxControllerFilters& filters, const PxObstacleContext* obstacleContext);
+					void							gatherObstacles(ObstacleBuffers& buffers, const PxControllerFilters& filters, const PxObstacleContext* obstacleContext, const PxU32* candidates, PxU32 nbCandidates);
+					PxControllerCollisionFlags		sweepMove(SweptVolume& volume, const PxVec3& disp, bool standingOnMoving, PxF32 minDist, const PxControllerFilters& filters, const PxObstacleContext* obstacleContext, bool constrainedClimbingMode, ObstacleBuffers& buffers);
+					void							updateKinematicTarget(const PxExtendedVec3& previousPosition);
+
 					void							setCctManager(CharacterControllerManager* cm)
 													{
 														mManager = cm;
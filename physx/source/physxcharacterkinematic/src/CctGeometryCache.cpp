@@ -0,0 +1,496 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2024 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+#include "CctGeometryCache.h"
+#include "CctCharacterController.h"
+#include "foundation/PxInlineArray.h"
+#include "foundation/PxMemory.h"
+#include "PxShape.h"
+
+using namespace physx;
+using namespace Cct;
+
+// PT: regions kept alive after the last controller released them, so that controllers following each other can still find
+// them. Unused regions are purged all at once when there are more than this.
+static const PxU32 gMaxNbUnusedRegions = 512;
+
+// PT: number of candidate min cells tested per axis in findRegion()
+static const PxI32 gMaxNbLookupsPerAxis = 3;
+
+namespace physx
+{
+namespace Cct
+{
+	struct GeometryCacheRegion : public PxUserAllocated
+	{
+		GeometryCacheKey		mKey;
+		PxExtendedBounds3		mBounds;
+		TriArray				mWorldTriangles;
+		IntArray				mTriangleIndices;
+		IntArray				mGeomStream;
+		GeometryCacheRegion*	mNext;		// Next region with the same key
+		PxU32					mRefCount;
+		bool					mDiscarded;	// Removed from the cache, deleted when the last controller releases it
+	};
+}
+}
+
+typedef PxHashMap<GeometryCacheKey, GeometryCacheRegion*, GeometryCacheKeyHash>	RegionMap;
+
+GeometryCache::GeometryCache() :
+	mCellSize			(0.0f),
+	mTimestamp			(0xffffffff),
+	mNbUnusedRegions	(0)
+{
+}
+
+GeometryCache::~GeometryCache()
+{
+	invalidate();
+}
+
+void GeometryCache::setCellSize(PxF32 cellSize)
+{
+	if(cellSize==mCellSize)
+		return;
+
+	invalidate();
+	mCellSize = cellSize;
+}
+
+void GeometryCache::invalidate()
+{
+	for(RegionMap::Iterator iter = mRegions.getIterator(); !iter.done(); ++iter)
+	{
+		GeometryCacheRegion* region = iter->second;
+		while(region)
+		{
+			GeometryCacheRegion* next = region->mNext;
+			region->mNext = NULL;
+			if(region->mRefCount)
+				region->mDiscarded = true;
+			else
+				PX_DELETE(region);
+			region = next;
+		}
+	}
+	mRegions.clear();
+	mNbUnusedRegions = 0;
+}
+
+void GeometryCache::discardRegion(GeometryCacheRegion* region)
+{
+	PX_ASSERT(!region->mDiscarded);
+
+	RegionMap::Entry* entry = const_cast<RegionMap::Entry*>(mRegions.find(region->mKey));
+	PX_ASSERT(entry);
+	if(entry->second==region)
+	{
+		if(region->mNext)
+			entry->second = region->mNext;
+		else
+			mRegions.erase(region->mKey);
+	}
+	else
+	{
+		GeometryCacheRegion* previous = entry->second;
+		while(previous->mNext!=region)
+			previous = previous->mNext;
+		previous->mNext = region->mNext;
+	}
+	region->mNext = NULL;
+
+	if(region->mRefCount)
+	{
+		region->mDiscarded = true;
+	}
+	else
+	{
+		PX_ASSERT(mNbUnusedRegions);
+		mNbUnusedRegions--;
+		PX_DELETE(region);
+	}
+}
+
+void GeometryCache::purgeUnusedRegions()
+{
+	PxInlineArray<GeometryCacheKey, 64> emptyKeys;
+	for(RegionMap::Iterator iter = mRegions.getIterator(); !iter.done(); ++iter)
+	{
+		GeometryCacheRegion** link = &iter->second;
+		while(*link)
+		{
+			GeometryCacheRegion* region = *link;
+			if(region->mRefCount)
+			{
+				link = &region->mNext;
+			}
+			else
+			{
+				*link = region->mNext;
+				PX_DELETE(region);
+			}
+		}
+
+		if(!iter->second)
+			emptyKeys.pushBack(iter->first);
+	}
+
+	for(PxU32 i=0;i<emptyKeys.size();i++)
+		mRegions.erase(emptyKeys[i]);
+
+	mNbUnusedRegions = 0;
+}
+
+bool GeometryCache::canShare(const CCTFilter& filter)	const
+{
+	PX_ASSERT(filter.mStaticShapes && !filter.mDynamicShapes);
+
+	// PT: filter callbacks can return different results for each controller
+	return isEnabled() && !(filter.mFilterCallback && (filter.mPreFilter || filter.mPostFilter));
+}
+
+static PX_FORCE_INLINE bool getCellIndex(PxExtended coord, PxExtended invCellSize, PxI32& index)
+{
+	const PxExtended scaled = coord * invCellSize;
+	const PxExtended limit = PxExtended(1<<30);
+	if(!(scaled>-limit && scaled<limit))	// PT: also catches NaNs
+		return false;
+
+	PxI32 i = PxI32(scaled);
+	if(PxExtended(i)>scaled)
+		i--;
+	index = i;
+	return true;
+}
+
+static PX_FORCE_INLINE bool getMinCell(const PxExtendedBounds3& bounds, PxExtended invCellSize, PxI32 minCell[3])
+{
+	return		getCellIndex(bounds.minimum.x, invCellSize, minCell[0])
+			&&	getCellIndex(bounds.minimum.y, invCellSize, minCell[1])
+			&&	getCellIndex(bounds.minimum.z, invCellSize, minCell[2]);
+}
+
+void GeometryCache::validate(const InternalCBData_FindTouchedGeom* userData)
+{
+	// PT: regions are discarded as soon as the static pruning structure changes
+	const PxU32 sceneTimestamp = getSceneTimestamp(userData);
+	if(sceneTimestamp!=mTimestamp)
+	{
+		invalidate();
+		mTimestamp = sceneTimestamp;
+	}
+}
+
+PxU32 GeometryCache::getConfigIndex(const CCTFilter& filter, const CCTParams& params)
+{
+	GeometryCacheConfig config;
+	config.mFilterData			= filter.mFilterData ? *filter.mFilterData : PxFilterData();
+	config.mUpDirection			= params.mUpDirection;
+	config.mSlopeLimit			= params.mSlopeLimit;
+	config.mInvisibleWallHeight	= params.mInvisibleWallHeight;
+	config.mMaxEdgeLength2		= params.mMaxEdgeLength2;
+	config.mTessellation		= params.mTessellation;
+
+	const PxU32 nbConfigs = mConfigs.size();
+	for(PxU32 i=0;i<nbConfigs;i++)
+	{
+		const GeometryCacheConfig& current = mConfigs[i];
+		if(		current.mFilterData==config.mFilterData
+			&&	current.mUpDirection==config.mUpDirection
+			&&	current.mSlopeLimit==config.mSlopeLimit
+			&&	current.mInvisibleWallHeight==config.mInvisibleWallHeight
+			&&	current.mMaxEdgeLength2==config.mMaxEdgeLength2
+			&&	current.mTessellation==config.mTessellation)
+			return i;
+	}
+	mConfigs.pushBack(config);
+	return nbConfigs;
+}
+
+// PT: appends a static geometry stream to another one. Touched meshes index the triangle array, the other
+// offsets are in world space and don't need fixing.
+static void appendGeometry(	TriArray& dstTriangles, IntArray& dstTriIndices, IntArray& dstStream,
+							const TriArray& srcTriangles, const IntArray& srcTriIndices, const IntArray& srcStream)
+{
+	const PxU32 triangleOffset = dstTriangles.size();
+
+	const PxU32 nbTris = srcTriangles.size();
+	if(nbTris)
+		PxMemCopy(dstTriangles.reserve(nbTris), srcTriangles.begin(), sizeof(PxTriangle)*nbTris);
+
+	const PxU32 nbIndices = srcTriIndices.size();
+	if(nbIndices)
+	{
+		const PxU32 size = dstTriIndices.size();
+		dstTriIndices.resizeUninitialized(size + nbIndices);
+		PxMemCopy(dstTriIndices.begin() + size, srcTriIndices.begin(), sizeof(PxU32)*nbIndices);
+	}
+
+	const PxU32 streamSize = srcStream.size();
+	if(streamSize)
+	{
+		const PxU32 size = dstStream.size();
+		dstStream.resizeUninitialized(size + streamSize);
+		PxU32* data = dstStream.begin() + size;
+		PxMemCopy(data, srcStream.begin(), sizeof(PxU32)*streamSize);
+
+		if(triangleOffset)
+		{
+			const PxU32* last = dstStream.end();
+			while(data!=last)
+			{
+				TouchedGeom* currentGeom = reinterpret_cast<TouchedGeom*>(data);
+				if(currentGeom->mType==TouchedGeomType::eMESH)
+					static_cast<TouchedMesh*>(currentGeom)->mIndexWorldTriangles += triangleOffset;
+
+				data = reinterpret_cast<PxU32*>(reinterpret_cast<PxU8*>(data) + gGeomSizes[currentGeom->mType]);
+			}
+		}
+	}
+}
+
+// PT: how far the temporal bounds are from the region's boundaries, i.e. how long the controller can keep using the region
+static PX_FORCE_INLINE PxExtended computeSlack(const PxExtendedBounds3& temporalBounds, const PxExtendedBounds3& regionBounds)
+{
+	PxExtended slack = PX_MAX_EXTENDED;
+	for(PxU32 i=0;i<3;i++)
+	{
+		slack = PxMin(slack, temporalBounds.minimum[i] - regionBounds.minimum[i]);
+		slack = PxMin(slack, regionBounds.maximum[i] - temporalBounds.maximum[i]);
+	}
+	return slack;
+}
+
+bool GeometryCache::findRegion(	GeometryCacheRegion*& region, const InternalCBData_FindTouchedGeom* userData,
+								const PxExtendedBounds3& temporalBounds, PxExtendedBounds3& cacheBounds,
+								TriArray& worldTriangles, IntArray& triIndicesArray, IntArray& geomStream,
+								const CCTFilter& filter, const CCTParams& params, bool lock)
+{
+	PX_ASSERT(!region);
+	PX_ASSERT(temporalBounds.isInside(cacheBounds));
+
+	if(!canShare(filter))
+		return false;
+
+	// PT: regions are hashed by min cell. A region containing the temporal bounds has its min cell at or below the temporal
+	// bounds' min cell. Regions created by similar controllers are about as large as our cached volume, so we don't look
+	// further than the cached volume's min cell.
+	const PxExtended invCellSize = PxExtended(1.0) / PxExtended(mCellSize);
+	PxI32 minCell[3], temporalMinCell[3];
+	if(!getMinCell(cacheBounds, invCellSize, minCell) || !getMinCell(temporalBounds, invCellSize, temporalMinCell))
+		return false;
+
+	for(PxU32 i=0;i<3;i++)
+		minCell[i] = PxMax(minCell[i], temporalMinCell[i] - gMaxNbLookupsPerAxis + 1);
+
+	GeometryCacheRegion* bestRegion = NULL;
+	{
+		if(lock)
+			mMutex.lock();
+
+		validate(userData);
+
+		GeometryCacheKey key;
+		key.mConfig = getConfigIndex(filter, params);
+
+		PxExtended bestSlack = PxExtended(-1.0);
+		for(key.mZ=minCell[2]; key.mZ<=temporalMinCell[2]; key.mZ++)
+		{
+			for(key.mY=minCell[1]; key.mY<=temporalMinCell[1]; key.mY++)
+			{
+				for(key.mX=minCell[0]; key.mX<=temporalMinCell[0]; key.mX++)
+				{
+					const RegionMap::Entry* entry = mRegions.find(key);
+					if(!entry)
+						continue;
+
+					for(GeometryCacheRegion* current = entry->second; current; current = current->mNext)
+					{
+						const PxExtended slack = computeSlack(temporalBounds, current->mBounds);
+						if(slack>=PxExtended(0.0) && slack>bestSlack)
+						{
+							bestSlack = slack;
+							bestRegion = current;
+						}
+					}
+				}
+			}
+		}
+
+		if(bestRegion && !bestRegion->mRefCount++)
+		{
+			PX_ASSERT(mNbUnusedRegions);
+			mNbUnusedRegions--;
+		}
+
+		if(lock)
+			mMutex.unlock();
+	}
+
+	if(!bestRegion)
+		return false;
+
+	// PT: the region we reference cannot be deleted, and its content never changes, so it can be read without locking
+	appendGeometry(worldTriangles, triIndicesArray, geomStream, bestRegion->mWorldTriangles, bestRegion->mTriangleIndices, bestRegion->mGeomStream);
+	cacheBounds = bestRegion->mBounds;
+	region = bestRegion;
+	return true;
+}
+
+GeometryCacheRegion* GeometryCache::addRegion(	const InternalCBData_FindTouchedGeom* userData, const PxExtendedBounds3& cacheBounds,
+												const TriArray& worldTriangles, const IntArray& triIndicesArray, const IntArray& geomStream,
+												const CCTFilter& filter, const CCTParams& params, bool lock)
+{
+	if(!canShare(filter))
+		return NULL;
+
+	PxI32 minCell[3];
+	if(!getMinCell(cacheBounds, PxExtended(1.0) / PxExtended(mCellSize), minCell))
+		return NULL;
+
+	// PT: the copy is made outside of the lock
+	GeometryCacheRegion* newRegion = PX_NEW(GeometryCacheRegion);
+	newRegion->mKey.mX		= minCell[0];
+	newRegion->mKey.mY		= minCell[1];
+	newRegion->mKey.mZ		= minCell[2];
+	newRegion->mBounds		= cacheBounds;
+	newRegion->mNext		= NULL;
+	newRegion->mRefCount	= 1;
+	newRegion->mDiscarded	= false;
+	appendGeometry(newRegion->mWorldTriangles, newRegion->mTriangleIndices, newRegion->mGeomStream, worldTriangles, triIndicesArray, geomStream);
+
+	if(lock)
+		mMutex.lock();
+
+	validate(userData);
+
+	newRegion->mKey.mConfig = getConfigIndex(filter, params);
+
+	GeometryCacheRegion* region = newRegion;
+	RegionMap::Entry* entry = const_cast<RegionMap::Entry*>(mRegions.find(newRegion->mKey));
+	if(!entry)
+	{
+		mRegions.insert(newRegion->mKey, newRegion);
+	}
+	else
+	{
+		// PT: another controller may have shared the same region in the meantime
+		GeometryCacheRegion* current = entry->second;
+		while(current)
+		{
+			if(current->mBounds.minimum==cacheBounds.minimum && current->mBounds.maximum==cacheBounds.maximum)
+				break;
+			current = current->mNext;
+		}
+
+		if(current)
+		{
+			if(!current->mRefCount++)
+			{
+				PX_ASSERT(mNbUnusedRegions);
+				mNbUnusedRegions--;
+			}
+			region = current;
+		}
+		else
+		{
+			newRegion->mNext = entry->second;
+			entry->second = newRegion;
+		}
+	}
+
+	if(lock)
+		mMutex.unlock();
+
+	if(region!=newRegion)
+		PX_DELETE(newRegion);
+
+	return region;
+}
+
+void GeometryCache::releaseRegion(GeometryCacheRegion* region, bool lock)
+{
+	if(!region)
+		return;
+
+	if(lock)
+		mMutex.lock();
+
+	PX_ASSERT(region->mRefCount);
+	if(!--region->mRefCount)
+	{
+		if(region->mDiscarded)
+		{
+			PX_DELETE(region);
+		}
+		else if(++mNbUnusedRegions>gMaxNbUnusedRegions)
+		{
+			purgeUnusedRegions();
+		}
+	}
+
+	if(lock)
+		mMutex.unlock();
+}
+
+static bool regionReferences(const GeometryCacheRegion& region, const PxBase& observed)
+{
+	const PxU32* data = region.mGeomStream.begin();
+	const PxU32* last = region.mGeomStream.end();
+	while(data!=last)
+	{
+		const TouchedGeom* currentGeom = reinterpret_cast<const TouchedGeom*>(data);
+		if(currentGeom->mTGUserData==&observed || currentGeom->mActor==&observed)
+			return true;
+
+		data = reinterpret_cast<const PxU32*>(reinterpret_cast<const PxU8*>(data) + gGeomSizes[currentGeom->mType]);
+	}
+	return false;
+}
+
+void GeometryCache::onRelease(const PxBase& observed, bool lock)
+{
+	if(lock)
+		mMutex.lock();
+
+	PxInlineArray<GeometryCacheRegion*, 16> releasedRegions;
+	for(RegionMap::Iterator iter = mRegions.getIterator(); !iter.done(); ++iter)
+	{
+		for(GeometryCacheRegion* region = iter->second; region; region = region->mNext)
+		{
+			if(regionReferences(*region, observed))
+				releasedRegions.pushBack(region);
+		}
+	}
+
+	for(PxU32 i=0;i<releasedRegions.size();i++)
+		discardRegion(releasedRegions[i]);
+
+	if(lock)
+		mMutex.unlock();
+}
@@ -0,0 +1,142 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2024 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#ifndef CCT_GEOMETRY_CACHE_H
+#define CCT_GEOMETRY_CACHE_H
+
+/* Exclude from documentation */
+/** \cond */
+
+#include "foundation/PxArray.h"
+#include "foundation/PxHashMap.h"
+#include "foundation/PxMutex.h"
+#include "foundation/PxUserAllocated.h"
+#include "PxFiltering.h"
+#include "CctUtils.h"
+
+namespace physx
+{
+	class PxBase;
+
+namespace Cct
+{
+	class TriArray;
+	class CCTFilter;
+	struct CCTParams;
+	struct InternalCBData_FindTouchedGeom;
+	struct GeometryCacheRegion;
+
+	struct GeometryCacheKey
+	{
+		PxI32	mX, mY, mZ;	// Min cell of the region
+		PxU32	mConfig;	// Index of the query configuration
+	};
+
+	struct GeometryCacheKeyHash
+	{
+		PX_FORCE_INLINE	PxU32	operator()(const GeometryCacheKey& key)	const
+		{
+			const PxU64 xy = (PxU64(PxU32(key.mX))<<32)|PxU32(key.mY);
+			const PxU64 zc = (PxU64(PxU32(key.mZ))<<32)|key.mConfig;
+			return PxComputeHash(xy) ^ (PxComputeHash(zc) * 0x9e3779b1);
+		}
+
+		PX_FORCE_INLINE	bool	equal(const GeometryCacheKey& k0, const GeometryCacheKey& k1)	const
+		{
+			return k0.mX==k1.mX && k0.mY==k1.mY && k0.mZ==k1.mZ && k0.mConfig==k1.mConfig;
+		}
+	};
+
+	// PT: what the gathered static geometry depends on, besides the queried volume
+	struct GeometryCacheConfig
+	{
+		PxFilterData	mFilterData;
+		PxVec3			mUpDirection;
+		PxF32			mSlopeLimit;
+		PxF32			mInvisibleWallHeight;
+		PxF32			mMaxEdgeLength2;
+		bool			mTessellation;
+	};
+
+	// PT: static geometry gathered by SweepTest::updateTouchedGeoms(), shared by all the controllers of a manager. Each region
+	// is the cached volume of the controller which queried the scene for it. A controller whose temporal bounds fit in an
+	// existing region adopts it and copies its geometry, instead of querying the scene again. Regions are hashed by the
+	// grid cell containing their min, and reference-counted by the controllers using them.
+	class GeometryCache
+	{
+										PX_NOCOPY(GeometryCache)
+	public:
+										GeometryCache();
+										~GeometryCache();
+
+						void			setCellSize(PxF32 cellSize);	// 0.0f disables the cache
+		PX_FORCE_INLINE	bool			isEnabled()	const	{ return mCellSize!=0.0f;	}
+
+		// Looks for a region containing 'temporalBounds'. On success the region's geometry is appended to the output arrays,
+		// 'cacheBounds' is replaced with the region's bounds and the function returns true. Otherwise the caller is expected
+		// to query the scene for 'cacheBounds' and share the results with addRegion(). The returned region must be released
+		// with releaseRegion().
+						bool			findRegion(	GeometryCacheRegion*& region, const InternalCBData_FindTouchedGeom* userData,
+													const PxExtendedBounds3& temporalBounds, PxExtendedBounds3& cacheBounds,
+													TriArray& worldTriangles, PxArray<PxU32>& triIndicesArray, PxArray<PxU32>& geomStream,
+													const CCTFilter& filter, const CCTParams& params, bool lock);
+
+		// Shares the static geometry gathered by a controller for 'cacheBounds', after findRegion() failed
+						GeometryCacheRegion*	addRegion(	const InternalCBData_FindTouchedGeom* userData, const PxExtendedBounds3& cacheBounds,
+															const TriArray& worldTriangles, const PxArray<PxU32>& triIndicesArray, const PxArray<PxU32>& geomStream,
+															const CCTFilter& filter, const CCTParams& params, bool lock);
+
+		// Releases a region returned by findRegion() or addRegion()
+						void			releaseRegion(GeometryCacheRegion* region, bool lock);
+
+		// Discards the regions referencing a released shape or actor
+						void			onRelease(const PxBase& observed, bool lock);
+
+		// Discards all regions. Regions still used by controllers are deleted when released.
+						void			invalidate();
+	private:
+						bool			canShare(const CCTFilter& filter)	const;
+						void			validate(const InternalCBData_FindTouchedGeom* userData);
+						PxU32			getConfigIndex(const CCTFilter& filter, const CCTParams& params);
+						void			discardRegion(GeometryCacheRegion* region);
+						void			purgeUnusedRegions();
+
+						PxHashMap<GeometryCacheKey, GeometryCacheRegion*, GeometryCacheKeyHash>	mRegions;	// Regions with the same key are linked together
+						PxArray<GeometryCacheConfig>	mConfigs;
+						PxMutex			mMutex;
+						PxF32			mCellSize;
+						PxU32			mTimestamp;			// Static timestamp of the scene when the regions were gathered
+						PxU32			mNbUnusedRegions;	// Regions kept in the cache while no controller uses them
+	};
+
+} // namespace Cct
+
+}
+
+/** \endcond */
+#endif
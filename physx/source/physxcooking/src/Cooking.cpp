@@ -88,6 +88,11 @@ PxConvexMesh* PxCreateConvexMesh(const PxCookingParams& params, const PxConvexMe
 	return immediateCooking::createConvexMesh(params, desc, insertionCallback, condition);
 }
 
+PxU32 PxCreateConvexMeshes(const PxCookingParams& params, PxU32 nbMeshes, const PxConvexMeshDesc* descs, PxConvexMesh** meshes, PxInsertionCallback& insertionCallback, PxConvexMeshCookingResult::Enum* conditions)
+{
+	return immediateCooking::createConvexMeshes(params, nbMeshes, descs, meshes, insertionCallback, conditions);
+}
+
 bool PxValidateConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc)
 {
 	return immediateCooking::validateConvexMesh(params, desc);
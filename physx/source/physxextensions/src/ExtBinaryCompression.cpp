@@ -0,0 +1,666 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2024 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "extensions/PxBinaryCompression.h"
+#include "foundation/PxAllocator.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxMath.h"
+#include "foundation/PxMemory.h"
+#include "foundation/PxUserAllocated.h"
+#include "common/PxSerialFramework.h"
+#include "task/PxCpuDispatcher.h"
+#include "CmParallelFor.h"
+
+using namespace physx;
+
+// PT: container layout:
+// - ContainerHeader
+// - for each chunk: ChunkHeader followed by ChunkHeader::mCompressedSize bytes
+// - ContainerFooter
+//
+// All chunks except the last one contain exactly ContainerHeader::mChunkSize uncompressed bytes, so the destination of each
+// chunk is known without decoding the previous ones. Chunks are compressed with a small LZ77 codec using the LZ4 block layout:
+// a token (4 bits literal length, 4 bits match length - 4), extra literal length bytes, literals, 16-bit match offset, extra
+// match length bytes. The last sequence of a chunk only has literals.
+
+namespace
+{
+	const PxU32 gContainerMagic		= PX_MAKE_FOURCC('P','X','C','Z');
+	const PxU32 gContainerVersion	= 1;
+
+	struct ContainerHeader
+	{
+		PxU32	mMagic;
+		PxU32	mVersion;
+		PxU32	mChunkSize;
+	};
+
+	enum ChunkFlag
+	{
+		CHUNK_STORED	= (1<<0),	// PT: chunk data is not compressed
+		CHUNK_SHUFFLED	= (1<<1)	// PT: byte-shuffle filter applied before compression
+	};
+
+	struct ChunkHeader
+	{
+		PxU32	mUncompressedSize;
+		PxU32	mCompressedSize;
+		PxU32	mFlags;
+	};
+
+	struct ContainerFooter
+	{
+		PxU32	mUncompressedSize;
+		PxU32	mNbChunks;
+		PxU32	mMagic;
+	};
+
+	///////////////////////////////////////////////////////////////////////////
+
+	#define LZ_MIN_MATCH	4
+	#define LZ_MAX_OFFSET	65535
+	#define LZ_HASH_LOG		14
+	#define LZ_HASH_SIZE	(1<<LZ_HASH_LOG)
+
+	PX_FORCE_INLINE PxU32 readU32(const PxU8* p)
+	{
+		PxU32 value;
+		PxMemCopy(&value, p, sizeof(PxU32));
+		return value;
+	}
+
+	PX_FORCE_INLINE PxU32 lzHash(PxU32 sequence)
+	{
+		return (sequence * 2654435761u) >> (32 - LZ_HASH_LOG);
+	}
+
+	PX_FORCE_INLINE PxU32 lzCompressBound(PxU32 size)
+	{
+		return size + size/255 + 16;
+	}
+
+	PX_FORCE_INLINE PxU8* lzWriteLength(PxU8* op, PxU32 length)
+	{
+		while(length>=255)
+		{
+			*op++ = 255;
+			length -= 255;
+		}
+		*op++ = PxU8(length);
+		return op;
+	}
+
+	// PT: writes a sequence, or only literals if matchLength is 0. Returns NULL if the output buffer is too small.
+	PX_FORCE_INLINE PxU8* lzWriteSequence(PxU8* op, const PxU8* opEnd, const PxU8* literals, PxU32 nbLiterals, PxU32 offset, PxU32 matchLength)
+	{
+		const size_t maxSize = 1 + nbLiterals/255 + 1 + nbLiterals + 2 + matchLength/255 + 1;
+		if(size_t(opEnd - op) < maxSize)
+			return NULL;
+
+		const PxU32 extraMatchLength = matchLength ? matchLength - LZ_MIN_MATCH : 0;
+		*op++ = PxU8((PxMin(nbLiterals, 15u)<<4) | PxMin(extraMatchLength, 15u));
+		if(nbLiterals>=15)
+			op = lzWriteLength(op, nbLiterals - 15);
+		PxMemCopy(op, literals, nbLiterals);
+		op += nbLiterals;
+
+		if(matchLength)
+		{
+			*op++ = PxU8(offset & 0xff);
+			*op++ = PxU8(offset >> 8);
+			if(extraMatchLength>=15)
+				op = lzWriteLength(op, extraMatchLength - 15);
+		}
+		return op;
+	}
+
+	// PT: greedy LZ77 with a single-entry hash table. Returns the compressed size, or 0 if it does not fit in dstCapacity.
+	PxU32 lzCompress(const PxU8* src, PxU32 srcSize, PxU8* dst, PxU32 dstCapacity, PxU32* hashTable)
+	{
+		PxMemZero(hashTable, sizeof(PxU32)*LZ_HASH_SIZE);
+
+		const PxU8* opEnd = dst + dstCapacity;
+		PxU8* op = dst;
+		PxU32 ip = 0;
+		PxU32 anchor = 0;
+		while(ip + LZ_MIN_MATCH <= srcSize)
+		{
+			const PxU32 sequence = readU32(src + ip);
+			const PxU32 h = lzHash(sequence);
+			const PxU32 candidate = hashTable[h];	// PT: position + 1, 0 for empty entries
+			hashTable[h] = ip + 1;
+
+			if(candidate && ip - (candidate - 1) <= LZ_MAX_OFFSET && readU32(src + candidate - 1) == sequence)
+			{
+				const PxU32 ref = candidate - 1;
+				PxU32 matchLength = LZ_MIN_MATCH;
+				while(ip + matchLength + 4 <= srcSize && readU32(src + ref + matchLength) == readU32(src + ip + matchLength))
+					matchLength += 4;
+				while(ip + matchLength < srcSize && src[ref + matchLength] == src[ip + matchLength])
+					matchLength++;
+
+				op = lzWriteSequence(op, opEnd, src + anchor, ip - anchor, ip - ref, matchLength);
+				if(!op)
+					return 0;
+
+				ip += matchLength;
+				anchor = ip;
+			}
+			else
+			{
+				// PT: skip faster through incompressible data
+				ip += 1 + ((ip - anchor)>>6);
+			}
+		}
+
+		op = lzWriteSequence(op, opEnd, src + anchor, srcSize - anchor, 0, 0);
+		if(!op)
+			return 0;
+		return PxU32(op - dst);
+	}
+
+	PX_FORCE_INLINE bool lzReadLength(const PxU8*& ip, const PxU8* ipEnd, PxU32& length)
+	{
+		PxU32 b;
+		do
+		{
+			if(ip==ipEnd)
+				return false;
+			b = *ip++;
+			length += b;
+		} while(b==255);
+		return true;
+	}
+
+	// PT: returns false for corrupted data. Never reads or writes outside of the given buffers.
+	bool lzDecompress(const PxU8* src, PxU32 srcSize, PxU8* dst, PxU32 dstSize)
+	{
+		const PxU8* ip = src;
+		const PxU8* ipEnd = src + srcSize;
+		PxU8* op = dst;
+		PxU8* opEnd = dst + dstSize;
+		for(;;)
+		{
+			if(ip==ipEnd)
+				return false;
+			const PxU32 token = *ip++;
+
+			PxU32 nbLiterals = token>>4;
+			if(nbLiterals==15 && !lzReadLength(ip, ipEnd, nbLiterals))
+				return false;
+			if(nbLiterals > PxU32(ipEnd - ip) || nbLiterals > PxU32(opEnd - op))
+				return false;
+			PxMemCopy(op, ip, nbLiterals);
+			ip += nbLiterals;
+			op += nbLiterals;
+
+			if(op==opEnd)
+				return ip==ipEnd;	// PT: last sequence
+
+			if(ipEnd - ip < 2)
+				return false;
+			const PxU32 offset = PxU32(ip[0]) | (PxU32(ip[1])<<8);
+			ip += 2;
+
+			PxU32 matchLength = token & 15;
+			if(matchLength==15 && !lzReadLength(ip, ipEnd, matchLength))
+				return false;
+			matchLength += LZ_MIN_MATCH;
+
+			if(!offset || offset > PxU32(op - dst) || matchLength > PxU32(opEnd - op))
+				return false;
+
+			const PxU8* match = op - offset;
+			if(offset>=matchLength)
+			{
+				PxMemCopy(op, match, matchLength);
+				op += matchLength;
+			}
+			else
+			{
+				// PT: overlapping match, e.g. repeated patterns
+				for(PxU32 i=0;i<matchLength;i++)
+					*op++ = *match++;
+			}
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+
+	// PT: groups bytes of consecutive 32-bit words by significance. Trailing bytes are copied as-is.
+	void shuffleBytes(const PxU8* PX_RESTRICT src, PxU32 size, PxU8* PX_RESTRICT dst)
+	{
+		const PxU32 nbWords = size/4;
+		for(PxU32 i=0;i<nbWords;i++)
+		{
+			dst[i]				= src[i*4+0];
+			dst[i + nbWords]	= src[i*4+1];
+			dst[i + nbWords*2]	= src[i*4+2];
+			dst[i + nbWords*3]	= src[i*4+3];
+		}
+		PxMemCopy(dst + nbWords*4, src + nbWords*4, size - nbWords*4);
+	}
+
+	void unshuffleBytes(const PxU8* PX_RESTRICT src, PxU32 size, PxU8* PX_RESTRICT dst)
+	{
+		const PxU32 nbWords = size/4;
+		for(PxU32 i=0;i<nbWords;i++)
+		{
+			dst[i*4+0] = src[i];
+			dst[i*4+1] = src[i + nbWords];
+			dst[i*4+2] = src[i + nbWords*2];
+			dst[i*4+3] = src[i + nbWords*3];
+		}
+		PxMemCopy(dst + nbWords*4, src + nbWords*4, size - nbWords*4);
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+
+	// PT: number of chunks processed per batch, per thread. Batches bound the memory used by the streams.
+	#define CHUNKS_PER_THREAD	2
+
+	PX_FORCE_INLINE PxU32 getNbChunksPerBatch(PxCpuDispatcher* dispatcher)
+	{
+		return dispatcher ? (dispatcher->getWorkerCount() + 1) * CHUNKS_PER_THREAD : 1;
+	}
+
+	struct ChunkSlot
+	{
+		const PxU8*	mSrc;		// PT: uncompressed data for compression, compressed data for decompression
+		PxU8*		mDst;
+		PxU8*		mScratch;
+		PxU32		mUncompressedSize;
+		PxU32		mCompressedSize;
+		PxU32		mFlags;
+		bool		mValid;
+	};
+
+	struct ChunkBatch
+	{
+		ChunkSlot*	mSlots;
+		PxU32		mChunkSize;
+		bool		mShuffle;
+	};
+
+	// PT: scratch layout for compression: hash table, compressed output, shuffled input, compressed shuffled output
+	PX_FORCE_INLINE PxU32 getCompressionScratchSize(PxU32 chunkSize, bool shuffle)
+	{
+		const PxU32 size = sizeof(PxU32)*LZ_HASH_SIZE + lzCompressBound(chunkSize);
+		return shuffle ? size + chunkSize + lzCompressBound(chunkSize) : size;
+	}
+
+	void compressChunks(void* userData, PxU32 start, PxU32 end)
+	{
+		const ChunkBatch& batch = *reinterpret_cast<const ChunkBatch*>(userData);
+		const PxU32 bound = lzCompressBound(batch.mChunkSize);
+
+		for(PxU32 i=start;i<end;i++)
+		{
+			ChunkSlot& slot = batch.mSlots[i];
+			PxU32* hashTable = reinterpret_cast<PxU32*>(slot.mScratch);
+			PxU8* output = slot.mScratch + sizeof(PxU32)*LZ_HASH_SIZE;
+			const PxU32 size = slot.mUncompressedSize;
+
+			PxU32 compressedSize = lzCompress(slot.mSrc, size, output, bound, hashTable);
+			slot.mDst = output;
+			slot.mFlags = 0;
+
+			if(batch.mShuffle)
+			{
+				PxU8* shuffled = output + bound;
+				PxU8* shuffledOutput = shuffled + batch.mChunkSize;
+				shuffleBytes(slot.mSrc, size, shuffled);
+				const PxU32 shuffledSize = lzCompress(shuffled, size, shuffledOutput, bound, hashTable);
+				if(shuffledSize && (!compressedSize || shuffledSize < compressedSize))
+				{
+					compressedSize = shuffledSize;
+					slot.mDst = shuffledOutput;
+					slot.mFlags = CHUNK_SHUFFLED;
+				}
+			}
+
+			if(!compressedSize || compressedSize >= size)
+			{
+				compressedSize = size;
+				slot.mDst = const_cast<PxU8*>(slot.mSrc);
+				slot.mFlags = CHUNK_STORED;
+			}
+			slot.mCompressedSize = compressedSize;
+		}
+	}
+
+	void decompressChunks(void* userData, PxU32 start, PxU32 end)
+	{
+		const ChunkBatch& batch = *reinterpret_cast<const ChunkBatch*>(userData);
+
+		for(PxU32 i=start;i<end;i++)
+		{
+			ChunkSlot& slot = batch.mSlots[i];
+			if(slot.mFlags & CHUNK_STORED)
+			{
+				// PT: stored chunks are read directly to their destination
+				slot.mValid = true;
+			}
+			else if(slot.mFlags & CHUNK_SHUFFLED)
+			{
+				slot.mValid = lzDecompress(slot.mSrc, slot.mCompressedSize, slot.mScratch, slot.mUncompressedSize);
+				if(slot.mValid)
+					unshuffleBytes(slot.mScratch, slot.mUncompressedSize, slot.mDst);
+			}
+			else
+			{
+				slot.mValid = lzDecompress(slot.mSrc, slot.mCompressedSize, slot.mDst, slot.mUncompressedSize);
+			}
+		}
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+
+	class CompressedOutputStream : public PxCompressedOutputStream, public PxUserAllocated
+	{
+		public:
+												CompressedOutputStream(PxOutputStream& stream, const PxBinaryCompressionParams& params);
+		virtual									~CompressedOutputStream();
+
+		// PxOutputStream
+		virtual	PxU32							write(const void* src, PxU32 count)	PX_OVERRIDE;
+		//~PxOutputStream
+
+		// PxCompressedOutputStream
+		virtual	bool							finish()							PX_OVERRIDE;
+		virtual	PxU32							getUncompressedSize()		const	PX_OVERRIDE	{ return mUncompressedSize;	}
+		virtual	PxU32							getCompressedSize()			const	PX_OVERRIDE	{ return mCompressedSize;	}
+		virtual	void							release()							PX_OVERRIDE	{ PX_DELETE_THIS;			}
+		//~PxCompressedOutputStream
+
+		private:
+				void							writeToStream(const void* src, PxU32 count);
+				void							flushBatch();
+
+				PxOutputStream&					mStream;
+				const PxU32						mChunkSize;
+				const PxU32						mNbChunksPerBatch;
+				const PxU32						mScratchSize;
+				const bool						mShuffle;
+				PxCpuDispatcher*				mDispatcher;
+				PxU8*							mBuffer;			// PT: uncompressed data of the current batch
+				PxU8*							mScratch;
+				PxArray<ChunkSlot>				mSlots;
+				PxU32							mBufferSize;
+				PxU32							mUncompressedSize;
+				PxU32							mCompressedSize;
+				PxU32							mNbChunks;
+				bool							mFinished;
+				bool							mError;
+	};
+
+	CompressedOutputStream::CompressedOutputStream(PxOutputStream& stream, const PxBinaryCompressionParams& params) :
+		mStream				(stream),
+		mChunkSize			(params.chunkSize),
+		mNbChunksPerBatch	(getNbChunksPerBatch(params.dispatcher)),
+		mScratchSize		(getCompressionScratchSize(params.chunkSize, params.flags.isSet(PxBinaryCompressionFlag::eSHUFFLE_FLOATS))),
+		mShuffle			(params.flags.isSet(PxBinaryCompressionFlag::eSHUFFLE_FLOATS)),
+		mDispatcher			(params.dispatcher),
+		mBufferSize			(0),
+		mUncompressedSize	(0),
+		mCompressedSize		(0),
+		mNbChunks			(0),
+		mFinished			(false),
+		mError				(false)
+	{
+		mBuffer = PX_ALLOCATE(PxU8, mChunkSize*mNbChunksPerBatch, "CompressedOutputStream::mBuffer");
+		mScratch = PX_ALLOCATE(PxU8, mScratchSize*mNbChunksPerBatch, "CompressedOutputStream::mScratch");
+		mSlots.resize(mNbChunksPerBatch);
+
+		ContainerHeader header;
+		header.mMagic		= gContainerMagic;
+		header.mVersion		= gContainerVersion;
+		header.mChunkSize	= mChunkSize;
+		writeToStream(&header, sizeof(ContainerHeader));
+	}
+
+	CompressedOutputStream::~CompressedOutputStream()
+	{
+		PX_FREE(mScratch);
+		PX_FREE(mBuffer);
+	}
+
+	void CompressedOutputStream::writeToStream(const void* src, PxU32 count)
+	{
+		const PxU32 written = mStream.write(src, count);
+		mCompressedSize += written;
+		if(written!=count)
+			mError = true;
+	}
+
+	PxU32 CompressedOutputStream::write(const void* src, PxU32 count)
+	{
+		if(mFinished)
+		{
+			PxGetFoundation().error(PxErrorCode::eINVALID_OPERATION, PX_FL, "PxCompressedOutputStream::write: stream has already been finished.");
+			return 0;
+		}
+
+		const PxU8* bytes = reinterpret_cast<const PxU8*>(src);
+		const PxU32 batchSize = mChunkSize*mNbChunksPerBatch;
+		PxU32 remaining = count;
+		while(remaining)
+		{
+			const PxU32 nb = PxMin(remaining, batchSize - mBufferSize);
+			PxMemCopy(mBuffer + mBufferSize, bytes, nb);
+			mBufferSize += nb;
+			bytes += nb;
+			remaining -= nb;
+
+			if(mBufferSize==batchSize)
+				flushBatch();
+		}
+		mUncompressedSize += count;
+		return count;
+	}
+
+	void CompressedOutputStream::flushBatch()
+	{
+		const PxU32 nbChunks = (mBufferSize + mChunkSize - 1)/mChunkSize;
+		for(PxU32 i=0;i<nbChunks;i++)
+		{
+			ChunkSlot& slot = mSlots[i];
+			slot.mSrc				= mBuffer + i*mChunkSize;
+			slot.mScratch			= mScratch + i*mScratchSize;
+			slot.mUncompressedSize	= PxMin(mChunkSize, mBufferSize - i*mChunkSize);
+		}
+
+		ChunkBatch batch;
+		batch.mSlots		= mSlots.begin();
+		batch.mChunkSize	= mChunkSize;
+		batch.mShuffle		= mShuffle;
+		Cm::parallelFor(mDispatcher, nbChunks, 1, compressChunks, &batch);
+
+		// PT: chunks are written in order, so the output does not depend on the number of threads
+		for(PxU32 i=0;i<nbChunks;i++)
+		{
+			const ChunkSlot& slot = mSlots[i];
+
+			ChunkHeader header;
+			header.mUncompressedSize	= slot.mUncompressedSize;
+			header.mCompressedSize		= slot.mCompressedSize;
+			header.mFlags				= slot.mFlags;
+			writeToStream(&header, sizeof(ChunkHeader));
+			writeToStream(slot.mDst, slot.mCompressedSize);
+		}
+
+		mNbChunks += nbChunks;
+		mBufferSize = 0;
+	}
+
+	bool CompressedOutputStream::finish()
+	{
+		if(mFinished)
+			return !mError;
+
+		if(mBufferSize)
+			flushBatch();
+
+		ContainerFooter footer;
+		footer.mUncompressedSize	= mUncompressedSize;
+		footer.mNbChunks			= mNbChunks;
+		footer.mMagic				= gContainerMagic;
+		writeToStream(&footer, sizeof(ContainerFooter));
+
+		mFinished = true;
+		return !mError;
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+
+	bool readContainerInfo(PxInputData& data, ContainerHeader& header, ContainerFooter& footer)
+	{
+		const PxU32 start = data.tell();
+		const PxU32 length = data.getLength();
+		if(length < start || length - start < sizeof(ContainerHeader) + sizeof(ContainerFooter))
+			return false;
+
+		if(data.read(&header, sizeof(ContainerHeader))!=sizeof(ContainerHeader))
+			return false;
+
+		data.seek(length - PxU32(sizeof(ContainerFooter)));
+		const bool footerRead = data.read(&footer, sizeof(ContainerFooter))==sizeof(ContainerFooter);
+		data.seek(start);
+
+		if(!footerRead || header.mMagic!=gContainerMagic || header.mVersion!=gContainerVersion || footer.mMagic!=gContainerMagic)
+			return false;
+
+		// PT: the chunk size is used to size the decompression buffers, so it must be in the range accepted by the compressor
+		PxBinaryCompressionParams params;
+		params.chunkSize = header.mChunkSize;
+		if(!params.isValid())
+			return false;
+
+		return PxU64(footer.mNbChunks) == (PxU64(footer.mUncompressedSize) + header.mChunkSize - 1)/header.mChunkSize;
+	}
+}
+
+PxCompressedOutputStream* physx::PxCreateCompressedOutputStream(PxOutputStream& stream, const PxBinaryCompressionParams& params)
+{
+	if(!params.isValid())
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxCreateCompressedOutputStream: invalid parameters.");
+		return NULL;
+	}
+	return PX_NEW(CompressedOutputStream)(stream, params);
+}
+
+PxU32 physx::PxGetDecompressedSize(PxInputData& data)
+{
+	ContainerHeader header;
+	ContainerFooter footer;
+	if(!readContainerInfo(data, header, footer))
+		return 0;
+	return footer.mUncompressedSize;
+}
+
+bool physx::PxDecompressBinaryData(PxInputData& data, void* dst, PxU32 dstSize, PxCpuDispatcher* dispatcher)
+{
+	ContainerHeader header;
+	ContainerFooter footer;
+	if(!readContainerInfo(data, header, footer))
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxDecompressBinaryData: invalid compressed data.");
+		return false;
+	}
+
+	if(dstSize < footer.mUncompressedSize)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxDecompressBinaryData: destination buffer is too small.");
+		return false;
+	}
+	data.seek(data.tell() + PxU32(sizeof(ContainerHeader)));
+
+	const PxU32 chunkSize = header.mChunkSize;
+	const PxU32 nbChunksPerBatch = getNbChunksPerBatch(dispatcher);
+	const PxU32 bound = lzCompressBound(chunkSize);
+
+	// PT: per slot: compressed data, then unshuffled data for shuffled chunks
+	PxU8* staging = PX_ALLOCATE(PxU8, (PxU64(bound) + chunkSize)*nbChunksPerBatch, "PxDecompressBinaryData");
+	PxArray<ChunkSlot> slots(nbChunksPerBatch);
+
+	ChunkBatch batch;
+	batch.mSlots		= slots.begin();
+	batch.mChunkSize	= chunkSize;
+	batch.mShuffle		= false;
+
+	PxU8* dstBytes = reinterpret_cast<PxU8*>(dst);
+	bool valid = true;
+	PxU32 chunkIndex = 0;
+	while(valid && chunkIndex<footer.mNbChunks)
+	{
+		// PT: read a batch of chunks, then decompress it
+		const PxU32 nbChunks = PxMin(nbChunksPerBatch, footer.mNbChunks - chunkIndex);
+		for(PxU32 i=0;i<nbChunks && valid;i++)
+		{
+			const PxU32 offset = (chunkIndex + i)*chunkSize;
+			const PxU32 expectedSize = PxMin(chunkSize, footer.mUncompressedSize - offset);
+
+			ChunkHeader chunkHeader;
+			valid = data.read(&chunkHeader, sizeof(ChunkHeader))==sizeof(ChunkHeader)
+				&& chunkHeader.mUncompressedSize==expectedSize
+				&& chunkHeader.mCompressedSize<=bound
+				&& (!(chunkHeader.mFlags & CHUNK_STORED) || chunkHeader.mCompressedSize==expectedSize);
+			if(!valid)
+				break;
+
+			ChunkSlot& slot = slots[i];
+			slot.mDst				= dstBytes + offset;
+			slot.mUncompressedSize	= chunkHeader.mUncompressedSize;
+			slot.mCompressedSize	= chunkHeader.mCompressedSize;
+			slot.mFlags				= chunkHeader.mFlags;
+			slot.mValid				= false;
+
+			PxU8* compressed = staging + i*(PxU64(bound) + chunkSize);
+			slot.mSrc		= compressed;
+			slot.mScratch	= compressed + bound;
+
+			PxU8* target = (chunkHeader.mFlags & CHUNK_STORED) ? slot.mDst : compressed;
+			valid = data.read(target, chunkHeader.mCompressedSize)==chunkHeader.mCompressedSize;
+		}
+
+		if(valid)
+		{
+			Cm::parallelFor(dispatcher, nbChunks, 1, decompressChunks, &batch);
+			for(PxU32 i=0;i<nbChunks;i++)
+				valid = valid && slots[i].mValid;
+		}
+		chunkIndex += nbChunks;
+	}
+
+	PX_FREE(staging);
+
+	if(!valid)
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxDecompressBinaryData: corrupted compressed data.");
+	return valid;
+}
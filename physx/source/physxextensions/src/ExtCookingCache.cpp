@@ -0,0 +1,800 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2024 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "extensions/PxCookingCache.h"
+#include "extensions/PxDefaultStreams.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxHashMap.h"
+#include "foundation/PxHashSet.h"
+#include "foundation/PxMutex.h"
+#include "foundation/PxPhysicsVersion.h"
+#include "foundation/PxString.h"
+#include "foundation/PxThread.h"
+#include "foundation/PxTime.h"
+#include "foundation/PxUserAllocated.h"
+#include "geometry/PxTriangleMesh.h"
+#include "geometry/PxConvexMesh.h"
+#include "PxPhysics.h"
+
+#include "SnFile.h"
+
+#include <string.h>
+
+using namespace physx;
+
+namespace
+{
+	// PT: version of the entry and index formats. Entries are also keyed by the SDK version, so that data cooked by another
+	// version of the SDK is never returned.
+	static const PxU32 gCacheVersion = 1;
+	static const PxU32 gEntryMagic = 0x45435850;	// PXCE
+	static const PxU32 gIndexMagic = 0x49435850;	// PXCI
+
+	struct CacheKey
+	{
+		PxU64	k0;
+		PxU64	k1;
+	};
+
+	struct CacheKeyHash
+	{
+		PX_FORCE_INLINE	PxU32	operator()(const CacheKey& key)						const	{ return PxU32(key.k0);							}
+		PX_FORCE_INLINE	bool	equal(const CacheKey& a, const CacheKey& b)			const	{ return a.k0==b.k0 && a.k1==b.k1;				}
+	};
+
+	// PT: 128-bit content hash made of two independent 64-bit lanes. Data is consumed in 8-byte words, so strided data
+	// gives the same result whether it is hashed element by element or as a whole.
+	class Hasher
+	{
+		public:
+		Hasher() : mH0(0x9e3779b97f4a7c15ull), mH1(0xc2b2ae3d27d4eb4full), mWord(0), mNbBytes(0), mSize(0)	{}
+
+		void	add(const void* data, PxU32 size)
+		{
+			const PxU8* bytes = reinterpret_cast<const PxU8*>(data);
+			mSize += size;
+			while(size && mNbBytes)
+			{
+				addByte(*bytes++);
+				size--;
+			}
+			while(size>=8)
+			{
+				PxU64 word;
+				PxMemCopy(&word, bytes, 8);
+				mix(word);
+				bytes += 8;
+				size -= 8;
+			}
+			while(size--)
+				addByte(*bytes++);
+		}
+
+		template<class T>
+		PX_FORCE_INLINE	void	add(const T& value)	{ add(&value, sizeof(T));	}
+
+		void	addStrided(const void* data, PxU32 count, PxU32 elementSize, PxU32 stride)
+		{
+			add(count);
+			if(!data)
+				return;
+			const PxU8* bytes = reinterpret_cast<const PxU8*>(data);
+			if(stride==elementSize)
+				add(bytes, count*elementSize);
+			else
+				for(PxU32 i=0;i<count;i++)
+					add(bytes + i*stride, elementSize);
+		}
+
+		CacheKey	finish()
+		{
+			while(mNbBytes)
+				addByte(0);
+			mix(mSize);
+			CacheKey key;
+			key.k0 = avalanche(mH0 ^ (mH1>>29));
+			key.k1 = avalanche(mH1 ^ (mH0<<17));
+			return key;
+		}
+
+		private:
+		PxU64	mH0;
+		PxU64	mH1;
+		PxU64	mWord;
+		PxU32	mNbBytes;
+		PxU64	mSize;
+
+		PX_FORCE_INLINE	void	addByte(PxU8 b)
+		{
+			mWord |= PxU64(b)<<(mNbBytes*8);
+			if(++mNbBytes==8)
+			{
+				mix(mWord);
+				mWord = 0;
+				mNbBytes = 0;
+			}
+		}
+
+		static PX_FORCE_INLINE	PxU64	rotl(PxU64 x, PxU32 r)	{ return (x<<r)|(x>>(64-r));	}
+
+		PX_FORCE_INLINE	void	mix(PxU64 word)
+		{
+			mH0 = rotl(mH0 ^ (word * 0x87c37b91114253d5ull), 31) * 0x4cf5ad432745937full;
+			mH1 = rotl(mH1 + (word * 0xff51afd7ed558ccdull), 27) * 0x9e3779b97f4a7c15ull + 0x52dce729;
+		}
+
+		static PX_FORCE_INLINE	PxU64	avalanche(PxU64 x)
+		{
+			x ^= x>>33;
+			x *= 0xff51afd7ed558ccdull;
+			x ^= x>>33;
+			x *= 0xc4ceb9fe1a85ec53ull;
+			x ^= x>>33;
+			return x;
+		}
+	};
+
+	enum EntryType
+	{
+		eTRIANGLE_MESH	= 1,
+		eCONVEX_MESH	= 2
+	};
+
+	void hashParams(Hasher& hasher, const PxCookingParams& params)
+	{
+		hasher.add(params.areaTestEpsilon);
+		hasher.add(params.planeTolerance);
+		hasher.add(PxU32(params.convexMeshCookingType));
+		hasher.add(PxU32(params.suppressTriangleMeshRemapTable));
+		hasher.add(PxU32(params.buildTriangleAdjacencies));
+		hasher.add(PxU32(params.buildGPUData));
+		hasher.add(params.scale.length);
+		hasher.add(params.scale.speed);
+		hasher.add(PxU32(params.meshPreprocessParams));
+		hasher.add(params.meshWeldTolerance);
+		hasher.add(params.meshAreaMinLimit);
+		hasher.add(params.meshEdgeLengthMaxLimit);
+		hasher.add(params.gaussMapLimit);
+		hasher.add(params.maxWeightRatioInTet);
+
+		const PxMidphaseDesc& midphase = params.midphaseDesc;
+		hasher.add(PxU32(midphase.getType()));
+		if(midphase.getType()==PxMeshMidPhase::eBVH34)
+		{
+			hasher.add(midphase.mBVH34Desc.numPrimsPerLeaf);
+			hasher.add(PxU32(midphase.mBVH34Desc.buildStrategy));
+			hasher.add(PxU32(midphase.mBVH34Desc.quantized));
+		}
+		else
+		{
+			hasher.add(midphase.mBVH33Desc.meshSizePerformanceTradeOff);
+			hasher.add(PxU32(midphase.mBVH33Desc.meshCookingHint));
+		}
+	}
+
+	void hashSimpleMesh(Hasher& hasher, const PxSimpleTriangleMesh& mesh)
+	{
+		hasher.add(PxU32(mesh.flags));
+		hasher.addStrided(mesh.points.data, mesh.points.count, sizeof(PxVec3), mesh.points.stride);
+		const PxU32 indexSize = mesh.flags & PxMeshFlag::e16_BIT_INDICES ? sizeof(PxU16)*3 : sizeof(PxU32)*3;
+		hasher.addStrided(mesh.triangles.data, mesh.triangles.count, indexSize, mesh.triangles.stride);
+	}
+
+	void hashSDF(Hasher& hasher, const PxSDFDesc* sdfDesc)
+	{
+		hasher.add(PxU32(sdfDesc!=NULL));
+		if(!sdfDesc)
+			return;
+
+		hasher.add(sdfDesc->spacing);
+		hasher.add(sdfDesc->subgridSize);
+		hasher.add(PxU32(sdfDesc->bitsPerSubgridPixel));
+		hasher.add(sdfDesc->narrowBandThicknessRelativeToSdfBoundsDiagonal);
+		hasher.add(sdfDesc->sdfBounds);
+		hashSimpleMesh(hasher, sdfDesc->baseMesh);
+
+		// PT: precomputed SDFs are used as they are
+		hasher.addStrided(sdfDesc->sdf.data, sdfDesc->sdf.count, sizeof(PxReal), sdfDesc->sdf.stride);
+		if(sdfDesc->sdf.data)
+		{
+			hasher.add(sdfDesc->dims);
+			hasher.add(sdfDesc->meshLower);
+			hasher.add(sdfDesc->sdfSubgrids3DTexBlockDim);
+			hasher.add(sdfDesc->subgridsMinSdfValue);
+			hasher.add(sdfDesc->subgridsMaxSdfValue);
+			hasher.addStrided(sdfDesc->sdfSubgrids.data, sdfDesc->sdfSubgrids.count, sizeof(PxU8), sdfDesc->sdfSubgrids.stride);
+			hasher.addStrided(sdfDesc->sdfStartSlots.data, sdfDesc->sdfStartSlots.count, sizeof(PxU32), sdfDesc->sdfStartSlots.stride);
+		}
+	}
+
+	CacheKey computeKey(const PxCookingParams& params, const PxTriangleMeshDesc& desc)
+	{
+		Hasher hasher;
+		hasher.add(gCacheVersion);
+		hasher.add(PxU32(PX_PHYSICS_VERSION));
+		hasher.add(PxU32(eTRIANGLE_MESH));
+		hashParams(hasher, params);
+		hashSimpleMesh(hasher, desc);
+		hasher.addStrided(desc.materialIndices.data, desc.materialIndices.data ? desc.triangles.count : 0, sizeof(PxMaterialTableIndex), desc.materialIndices.stride);
+		hashSDF(hasher, desc.sdfDesc);
+		return hasher.finish();
+	}
+
+	CacheKey computeKey(const PxCookingParams& params, const PxConvexMeshDesc& desc)
+	{
+		Hasher hasher;
+		hasher.add(gCacheVersion);
+		hasher.add(PxU32(PX_PHYSICS_VERSION));
+		hasher.add(PxU32(eCONVEX_MESH));
+		hashParams(hasher, params);
+		hasher.add(PxU32(desc.flags));
+		hasher.add(desc.vertexLimit);
+		hasher.add(desc.polygonLimit);
+		hasher.add(desc.quantizedCount);
+		hasher.addStrided(desc.points.data, desc.points.count, sizeof(PxVec3), desc.points.stride);
+		hasher.addStrided(desc.polygons.data, desc.polygons.count, sizeof(PxHullPolygon), desc.polygons.stride);
+
+		// PT: the number of indices is implied by the polygons
+		PxU32 nbIndices = 0;
+		if(desc.polygons.data)
+		{
+			const PxU8* polygons = reinterpret_cast<const PxU8*>(desc.polygons.data);
+			for(PxU32 i=0;i<desc.polygons.count;i++)
+			{
+				const PxHullPolygon& polygon = *reinterpret_cast<const PxHullPolygon*>(polygons + i*desc.polygons.stride);
+				nbIndices = PxMax(nbIndices, PxU32(polygon.mIndexBase) + polygon.mNbVerts);
+			}
+		}
+		const PxU32 indexSize = desc.flags & PxConvexFlag::e16_BIT_INDICES ? sizeof(PxU16) : sizeof(PxU32);
+		hasher.addStrided(desc.indices.data, desc.indices.data ? nbIndices : 0, indexSize, desc.indices.stride ? desc.indices.stride : indexSize);
+		hashSDF(hasher, desc.sdfDesc);
+		return hasher.finish();
+	}
+
+	PxU64 computeChecksum(const void* data, PxU32 size)
+	{
+		Hasher hasher;
+		hasher.add(data, size);
+		return hasher.finish().k0;
+	}
+
+	// PT: header of the files storing the cooked data. The cooked data follows.
+	struct EntryHeader
+	{
+		PxU32	magic;
+		PxU32	version;
+		PxU32	type;
+		PxU32	condition;
+		CacheKey	key;
+		PxU64	checksum;
+		PxU32	dataSize;
+		PxU32	pad;
+	};
+
+	// PT: index file entry, storing the usage order of the cached data
+	struct IndexEntry
+	{
+		CacheKey	key;
+		PxU64	lastUse;
+		PxU32	size;
+		PxU32	pad;
+	};
+
+	struct Entry
+	{
+		PxU64	lastUse;
+		PxU32	size;
+	};
+
+	class CookingCache : public PxCookingCache, public PxUserAllocated
+	{
+		public:
+										CookingCache(const PxCookingCacheDesc& desc);
+		virtual							~CookingCache();
+
+		virtual	bool					cookTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxOutputStream& stream, PxTriangleMeshCookingResult::Enum* condition)	PX_OVERRIDE;
+		virtual	PxTriangleMesh*			createTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxPhysics& physics, PxTriangleMeshCookingResult::Enum* condition)	PX_OVERRIDE;
+		virtual	bool					cookConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition)	PX_OVERRIDE;
+		virtual	PxConvexMesh*			createConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxPhysics& physics, PxConvexMeshCookingResult::Enum* condition)	PX_OVERRIDE;
+		virtual	void					getStats(PxCookingCacheStats& stats)	const	PX_OVERRIDE;
+		virtual	void					flush()	PX_OVERRIDE;
+		virtual	void					clear()	PX_OVERRIDE;
+		virtual	void					release()	PX_OVERRIDE;
+
+		private:
+				PxArray<char>			mDirectory;
+				PxU64					mMaxSize;
+		mutable	PxMutex					mMutex;
+				PxHashMap<CacheKey, Entry, CacheKeyHash>	mEntries;
+				PxHashSet<CacheKey, CacheKeyHash>			mRemovedKeys;	// Entries removed since the last flush, not merged back from the index file
+				PxU64					mTotalSize;
+				PxU64					mUseCounter;
+				PxU32					mTempCounter;
+				PxU32					mNbHits;
+				PxU32					mNbMisses;
+				PxU32					mNbEvictions;
+
+				void					getEntryPath(const CacheKey& key, char* path, PxU32 pathSize)	const;
+				void					getIndexPath(char* path, PxU32 pathSize)	const;
+				void					getTempPath(const char* path, char* tempPath, PxU32 tempPathSize);
+				bool					load(const CacheKey& key, EntryType type, PxArray<PxU8>& data, PxU32& condition);
+				void					store(const CacheKey& key, EntryType type, const PxU8* data, PxU32 size, PxU32 condition);
+				void					touch(const CacheKey& key, PxU32 size);
+				void					evict();
+				bool					readIndex(PxArray<IndexEntry>& indexEntries)	const;
+				void					mergeIndex();
+				bool					writeFile(const char* path, const void* data0, PxU32 size0, const void* data1, PxU32 size1);
+
+				template<class DescT, class ConditionT>
+				bool					getCookedData(const PxCookingParams& params, const DescT& desc, EntryType type, PxArray<PxU8>& data, PxDefaultMemoryOutputStream& cooked,
+											const PxU8*& cookedData, PxU32& cookedSize, ConditionT* condition);
+	};
+
+	static const PxU32 gMaxPathLength = 1024;
+
+	PX_FORCE_INLINE char toHex(PxU32 v)
+	{
+		return char(v<10 ? '0'+v : 'a'+v-10);
+	}
+
+	void writeHex(char* dst, PxU64 value)
+	{
+		for(PxU32 i=0;i<16;i++)
+			dst[i] = toHex(PxU32(value>>((15-i)*4)) & 15);
+	}
+}
+
+CookingCache::CookingCache(const PxCookingCacheDesc& desc) :
+	mMaxSize		(desc.maxSize),
+	mTotalSize		(0),
+	mUseCounter		(0),
+	mTempCounter	(0),
+	mNbHits			(0),
+	mNbMisses		(0),
+	mNbEvictions	(0)
+{
+	const PxU32 length = PxU32(strlen(desc.directory));
+	mDirectory.resize(length+1);
+	PxMemCopy(mDirectory.begin(), desc.directory, length+1);
+
+	// PT: drop trailing separators
+	while(mDirectory.size()>2 && (mDirectory[mDirectory.size()-2]=='/' || mDirectory[mDirectory.size()-2]=='\\'))
+	{
+		mDirectory.popBack();
+		mDirectory.back() = 0;
+	}
+
+	mergeIndex();
+}
+
+CookingCache::~CookingCache()
+{
+}
+
+void CookingCache::getEntryPath(const CacheKey& key, char* path, PxU32 pathSize) const
+{
+	char name[33];
+	writeHex(name, key.k0);
+	writeHex(name+16, key.k1);
+	name[32] = 0;
+	Pxsnprintf(path, pathSize, "%s/%s.pxcache", mDirectory.begin(), name);
+}
+
+void CookingCache::getIndexPath(char* path, PxU32 pathSize) const
+{
+	Pxsnprintf(path, pathSize, "%s/index.pxcache", mDirectory.begin());
+}
+
+void CookingCache::getTempPath(const char* path, char* tempPath, PxU32 tempPathSize)
+{
+	// PT: unique enough across threads and processes sharing the directory
+	PxU32 counter;
+	{
+		PxMutex::ScopedLock lock(mMutex);
+		counter = mTempCounter++;
+	}
+	char suffix[33];
+	writeHex(suffix, PxU64(PxThread::getId()) ^ PxU64(size_t(this)));
+	writeHex(suffix+16, PxTime::getCurrentCounterValue() + counter);
+	suffix[32] = 0;
+	Pxsnprintf(tempPath, tempPathSize, "%s.%s.tmp", path, suffix);
+}
+
+bool CookingCache::writeFile(const char* path, const void* data0, PxU32 size0, const void* data1, PxU32 size1)
+{
+	// PT: data is written to a temporary file first and renamed, so that other threads and processes never see partial files
+	char tempPath[gMaxPathLength];
+	getTempPath(path, tempPath, gMaxPathLength);
+
+	FILE* fp = NULL;
+	if(sn::fopen_s(&fp, tempPath, "wb") || !fp)
+		return false;
+
+	bool success = fwrite(data0, 1, size0, fp)==size0;
+	if(success && size1)
+		success = fwrite(data1, 1, size1, fp)==size1;
+	success = fclose(fp)==0 && success;
+
+	if(success && ::rename(tempPath, path)!=0)
+	{
+		// PT: some platforms do not replace existing files
+		::remove(path);
+		success = ::rename(tempPath, path)==0;
+	}
+	if(!success)
+		::remove(tempPath);
+	return success;
+}
+
+bool CookingCache::readIndex(PxArray<IndexEntry>& indexEntries) const
+{
+	char path[gMaxPathLength];
+	getIndexPath(path, gMaxPathLength);
+
+	FILE* fp = NULL;
+	if(sn::fopen_s(&fp, path, "rb") || !fp)
+		return false;
+
+	PxU32 header[3];
+	if(fread(header, sizeof(header), 1, fp)==1 && header[0]==gIndexMagic && header[1]==gCacheVersion)
+	{
+		IndexEntry indexEntry;
+		for(PxU32 i=0;i<header[2] && fread(&indexEntry, sizeof(IndexEntry), 1, fp)==1;i++)
+			indexEntries.pushBack(indexEntry);
+	}
+	fclose(fp);
+	return true;
+}
+
+void CookingCache::mergeIndex()
+{
+	// PT: other caches sharing the directory may have added entries since the index was last read. They are merged so that
+	// the index written by flush() keeps them and they remain subject to eviction.
+	PxArray<IndexEntry> indexEntries;
+	if(!readIndex(indexEntries))
+		return;
+
+	PxMutex::ScopedLock lock(mMutex);
+	for(PxU32 i=0;i<indexEntries.size();i++)
+	{
+		const IndexEntry& indexEntry = indexEntries[i];
+		if(mRemovedKeys.contains(indexEntry.key))
+			continue;
+
+		Entry* entry = mEntries.find(indexEntry.key) ? &mEntries[indexEntry.key] : NULL;
+		if(entry)
+		{
+			entry->lastUse = PxMax(entry->lastUse, indexEntry.lastUse);
+		}
+		else
+		{
+			entry = &mEntries[indexEntry.key];
+			entry->lastUse = indexEntry.lastUse;
+			entry->size = indexEntry.size;
+			mTotalSize += indexEntry.size;
+		}
+		mUseCounter = PxMax(mUseCounter, indexEntry.lastUse+1);
+	}
+}
+
+void CookingCache::flush()
+{
+	mergeIndex();
+	evict();
+
+	PxArray<IndexEntry> indexEntries;
+	{
+		PxMutex::ScopedLock lock(mMutex);
+		mRemovedKeys.clear();
+		indexEntries.reserve(mEntries.size());
+		for(PxHashMap<CacheKey, Entry, CacheKeyHash>::Iterator it = mEntries.getIterator(); !it.done(); ++it)
+		{
+			IndexEntry indexEntry;
+			indexEntry.key = it->first;
+			indexEntry.lastUse = it->second.lastUse;
+			indexEntry.size = it->second.size;
+			indexEntry.pad = 0;
+			indexEntries.pushBack(indexEntry);
+		}
+	}
+
+	const PxU32 header[3] = { gIndexMagic, gCacheVersion, indexEntries.size() };
+
+	char path[gMaxPathLength];
+	getIndexPath(path, gMaxPathLength);
+	writeFile(path, header, sizeof(header), indexEntries.begin(), indexEntries.size()*sizeof(IndexEntry));
+}
+
+void CookingCache::touch(const CacheKey& key, PxU32 size)
+{
+	PxMutex::ScopedLock lock(mMutex);
+	Entry* entry = mEntries.find(key) ? &mEntries[key] : NULL;
+	if(!entry)
+	{
+		entry = &mEntries[key];
+		entry->size = size;
+		mTotalSize += size;
+	}
+	else if(entry->size!=size)
+	{
+		mTotalSize += PxU64(size) - entry->size;
+		entry->size = size;
+	}
+	entry->lastUse = mUseCounter++;
+	mRemovedKeys.erase(key);
+}
+
+void CookingCache::evict()
+{
+	// PT: linear search for the least recently used entry. Cooking is orders of magnitude more expensive.
+	PxArray<CacheKey> evicted;
+	{
+		PxMutex::ScopedLock lock(mMutex);
+		while(mMaxSize && mTotalSize>mMaxSize && mEntries.size()>1)
+		{
+			const PxHashMap<CacheKey, Entry, CacheKeyHash>::Entry* oldest = NULL;
+			for(PxHashMap<CacheKey, Entry, CacheKeyHash>::Iterator it = mEntries.getIterator(); !it.done(); ++it)
+			{
+				if(!oldest || it->second.lastUse<oldest->second.lastUse)
+					oldest = &*it;
+			}
+			const CacheKey key = oldest->first;
+			mTotalSize -= oldest->second.size;
+			mEntries.erase(key);
+			mRemovedKeys.insert(key);
+			evicted.pushBack(key);
+			mNbEvictions++;
+		}
+	}
+
+	char path[gMaxPathLength];
+	for(PxU32 i=0;i<evicted.size();i++)
+	{
+		getEntryPath(evicted[i], path, gMaxPathLength);
+		::remove(path);
+	}
+}
+
+bool CookingCache::load(const CacheKey& key, EntryType type, PxArray<PxU8>& data, PxU32& condition)
+{
+	char path[gMaxPathLength];
+	getEntryPath(key, path, gMaxPathLength);
+
+	FILE* fp = NULL;
+	if(sn::fopen_s(&fp, path, "rb") || !fp)
+		return false;
+
+	EntryHeader header;
+	bool valid = fread(&header, sizeof(EntryHeader), 1, fp)==1 && header.magic==gEntryMagic && header.version==gCacheVersion
+		&& header.type==PxU32(type) && header.key.k0==key.k0 && header.key.k1==key.k1;
+	if(valid)
+	{
+		// PT: the header is not trusted before the data size has been checked against the file size
+		const long dataStart = ftell(fp);
+		valid = dataStart>=0 && fseek(fp, 0, SEEK_END)==0;
+		if(valid)
+		{
+			const long fileSize = ftell(fp);
+			valid = fileSize>=dataStart && PxU64(fileSize - dataStart)==PxU64(header.dataSize) && fseek(fp, dataStart, SEEK_SET)==0;
+		}
+	}
+	if(valid)
+	{
+		data.resize(header.dataSize);
+		valid = fread(data.begin(), 1, header.dataSize, fp)==header.dataSize && computeChecksum(data.begin(), header.dataSize)==header.checksum;
+	}
+	fclose(fp);
+
+	if(!valid)
+	{
+		// PT: truncated or corrupted entry, cooked again and replaced
+		::remove(path);
+		return false;
+	}
+
+	condition = header.condition;
+	touch(key, PxU32(sizeof(EntryHeader)) + header.dataSize);
+	return true;
+}
+
+void CookingCache::store(const CacheKey& key, EntryType type, const PxU8* data, PxU32 size, PxU32 condition)
+{
+	EntryHeader header;
+	header.magic = gEntryMagic;
+	header.version = gCacheVersion;
+	header.type = PxU32(type);
+	header.condition = condition;
+	header.key = key;
+	header.checksum = computeChecksum(data, size);
+	header.dataSize = size;
+	header.pad = 0;
+
+	char path[gMaxPathLength];
+	getEntryPath(key, path, gMaxPathLength);
+	if(!writeFile(path, &header, sizeof(EntryHeader), data, size))
+	{
+		PxGetFoundation().error(PxErrorCode::eDEBUG_WARNING, PX_FL, "PxCookingCache: unable to write %s.", path);
+		return;
+	}
+
+	touch(key, PxU32(sizeof(EntryHeader)) + size);
+	evict();
+}
+
+namespace
+{
+	PX_FORCE_INLINE bool cook(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxOutputStream& stream, PxTriangleMeshCookingResult::Enum* condition)
+	{
+		return PxCookTriangleMesh(params, desc, stream, condition);
+	}
+
+	PX_FORCE_INLINE bool cook(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition)
+	{
+		return PxCookConvexMesh(params, desc, stream, condition);
+	}
+}
+
+template<class DescT, class ConditionT>
+bool CookingCache::getCookedData(const PxCookingParams& params, const DescT& desc, EntryType type, PxArray<PxU8>& data, PxDefaultMemoryOutputStream& cooked,
+	const PxU8*& cookedData, PxU32& cookedSize, ConditionT* condition)
+{
+	const CacheKey key = computeKey(params, desc);
+
+	PxU32 storedCondition;
+	if(load(key, type, data, storedCondition))
+	{
+		{
+			PxMutex::ScopedLock lock(mMutex);
+			mNbHits++;
+		}
+		if(condition)
+			*condition = ConditionT(storedCondition);
+		cookedData = data.begin();
+		cookedSize = data.size();
+		return true;
+	}
+
+	{
+		PxMutex::ScopedLock lock(mMutex);
+		mNbMisses++;
+	}
+
+	ConditionT localCondition = ConditionT(0);
+	if(!cook(params, desc, cooked, &localCondition))
+	{
+		if(condition)
+			*condition = localCondition;
+		return false;
+	}
+	if(condition)
+		*condition = localCondition;
+
+	store(key, type, cooked.getData(), cooked.getSize(), PxU32(localCondition));
+	cookedData = cooked.getData();
+	cookedSize = cooked.getSize();
+	return true;
+}
+
+bool CookingCache::cookTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxOutputStream& stream, PxTriangleMeshCookingResult::Enum* condition)
+{
+	PxArray<PxU8> data;
+	PxDefaultMemoryOutputStream cooked;
+	const PxU8* cookedData;
+	PxU32 cookedSize;
+	if(!getCookedData(params, desc, eTRIANGLE_MESH, data, cooked, cookedData, cookedSize, condition))
+		return false;
+	return stream.write(cookedData, cookedSize)==cookedSize;
+}
+
+PxTriangleMesh* CookingCache::createTriangleMesh(const PxCookingParams& params, const PxTriangleMeshDesc& desc, PxPhysics& physics, PxTriangleMeshCookingResult::Enum* condition)
+{
+	PxArray<PxU8> data;
+	PxDefaultMemoryOutputStream cooked;
+	const PxU8* cookedData;
+	PxU32 cookedSize;
+	if(!getCookedData(params, desc, eTRIANGLE_MESH, data, cooked, cookedData, cookedSize, condition))
+		return NULL;
+	PxDefaultMemoryInputData input(const_cast<PxU8*>(cookedData), cookedSize);
+	return physics.createTriangleMesh(input);
+}
+
+bool CookingCache::cookConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxOutputStream& stream, PxConvexMeshCookingResult::Enum* condition)
+{
+	PxArray<PxU8> data;
+	PxDefaultMemoryOutputStream cooked;
+	const PxU8* cookedData;
+	PxU32 cookedSize;
+	if(!getCookedData(params, desc, eCONVEX_MESH, data, cooked, cookedData, cookedSize, condition))
+		return false;
+	return stream.write(cookedData, cookedSize)==cookedSize;
+}
+
+PxConvexMesh* CookingCache::createConvexMesh(const PxCookingParams& params, const PxConvexMeshDesc& desc, PxPhysics& physics, PxConvexMeshCookingResult::Enum* condition)
+{
+	PxArray<PxU8> data;
+	PxDefaultMemoryOutputStream cooked;
+	const PxU8* cookedData;
+	PxU32 cookedSize;
+	if(!getCookedData(params, desc, eCONVEX_MESH, data, cooked, cookedData, cookedSize, condition))
+		return NULL;
+	PxDefaultMemoryInputData input(const_cast<PxU8*>(cookedData), cookedSize);
+	return physics.createConvexMesh(input);
+}
+
+void CookingCache::getStats(PxCookingCacheStats& stats) const
+{
+	PxMutex::ScopedLock lock(mMutex);
+	stats.nbHits = mNbHits;
+	stats.nbMisses = mNbMisses;
+	stats.nbEvictions = mNbEvictions;
+	stats.nbEntries = mEntries.size();
+	stats.size = mTotalSize;
+}
+
+void CookingCache::clear()
+{
+	// PT: includes the entries added by other caches sharing the directory
+	mergeIndex();
+
+	PxArray<CacheKey> keys;
+	{
+		PxMutex::ScopedLock lock(mMutex);
+		keys.reserve(mEntries.size());
+		for(PxHashMap<CacheKey, Entry, CacheKeyHash>::Iterator it = mEntries.getIterator(); !it.done(); ++it)
+		{
+			keys.pushBack(it->first);
+			mRemovedKeys.insert(it->first);
+		}
+		mEntries.clear();
+		mTotalSize = 0;
+	}
+
+	char path[gMaxPathLength];
+	for(PxU32 i=0;i<keys.size();i++)
+	{
+		getEntryPath(keys[i], path, gMaxPathLength);
+		::remove(path);
+	}
+	flush();
+}
+
+void CookingCache::release()
+{
+	flush();
+	PX_DELETE_THIS;
+}
+
+PxCookingCache* physx::PxCreateCookingCache(const PxCookingCacheDesc& desc)
+{
+	if(!desc.isValid() || strlen(desc.directory)>gMaxPathLength-64)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxCreateCookingCache: invalid descriptor.");
+		return NULL;
+	}
+	return PX_NEW(CookingCache)(desc);
+}
@@ -0,0 +1,431 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2024 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+
+#include "extensions/PxImmediatePairCache.h"
+#include "foundation/PxAllocator.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxHashMap.h"
+#include "foundation/PxUserAllocated.h"
+
+using namespace physx;
+
+namespace
+{
+	class BlockPool;
+
+	// A page holds blocks of a single size class
+	struct PX_ALIGN_PREFIX(16) Page
+	{
+		PxU32	sizeClass;
+		PxU32	nbUsedBlocks;
+	} PX_ALIGN_SUFFIX(16);
+
+	// Header in front of each block of cache data. Pages are null for blocks larger than a page, allocated separately.
+	struct PX_ALIGN_PREFIX(16) BlockHeader
+	{
+		BlockPool*		pool;
+		Page*			page;
+		BlockHeader*	next;	// Next free block of the same size class
+		PxU32			sizeClass;
+		PxU32			owned;	// Set once the block is referenced by a pair
+	} PX_ALIGN_SUFFIX(16);
+
+	PX_FORCE_INLINE BlockHeader* getBlockHeader(PxU8* data)
+	{
+		return reinterpret_cast<BlockHeader*>(data) - 1;
+	}
+
+	// Size-class block allocator used by one contact generation context. Blocks allocated during a frame are recorded, so that the
+	// ones a pair did not keep are recycled by the next frame.
+	class BlockPool : public PxCacheAllocator, public PxUserAllocated
+	{
+		public:
+		enum
+		{
+			ePAGE_SIZE			= 16384,
+			eMIN_BLOCK_SIZE		= 64,
+			eNB_SIZE_CLASSES	= 8,	// Blocks of 64 to 8192 bytes, header included
+			eLARGE_BLOCK		= eNB_SIZE_CLASSES
+		};
+
+								BlockPool() : mNbBlocks(0)
+								{
+									for(PxU32 i=0;i<eNB_SIZE_CLASSES;i++)
+										mFreeBlocks[i] = NULL;
+								}
+
+								~BlockPool()
+								{
+									recycleFrameBlocks();
+									PX_ASSERT(!mNbBlocks);
+									for(PxU32 i=0;i<mPages.size();i++)
+										PX_FREE(mPages[i]);
+								}
+
+		virtual	PxU8*			allocateCacheData(const PxU32 byteSize)	PX_OVERRIDE
+		{
+			const PxU32 totalSize = byteSize + sizeof(BlockHeader);
+
+			BlockHeader* block;
+			if(totalSize > (eMIN_BLOCK_SIZE<<(eNB_SIZE_CLASSES-1)))
+			{
+				block = reinterpret_cast<BlockHeader*>(PX_ALLOC(totalSize, "PxImmediatePairCache"));
+				block->page			= NULL;
+				block->sizeClass	= eLARGE_BLOCK;
+			}
+			else
+			{
+				PxU32 sizeClass = 0;
+				while((PxU32(eMIN_BLOCK_SIZE)<<sizeClass) < totalSize)
+					sizeClass++;
+
+				if(!mFreeBlocks[sizeClass])
+					addPage(sizeClass);
+
+				block = mFreeBlocks[sizeClass];
+				mFreeBlocks[sizeClass] = block->next;
+				block->page->nbUsedBlocks++;
+			}
+			block->pool		= this;
+			block->next		= NULL;
+			block->owned	= 0;
+			mNbBlocks++;
+			mFrameBlocks.pushBack(block);
+			return reinterpret_cast<PxU8*>(block + 1);
+		}
+
+				void			freeBlock(BlockHeader* block)
+		{
+			PX_ASSERT(block->pool==this);
+			mNbBlocks--;
+			if(block->sizeClass==eLARGE_BLOCK)
+			{
+				PX_FREE(block);
+				return;
+			}
+			block->page->nbUsedBlocks--;
+			block->next = mFreeBlocks[block->sizeClass];
+			mFreeBlocks[block->sizeClass] = block;
+		}
+
+		// Frees the blocks of the last frame that no pair has kept, e.g. the blocks of pairs released during the frame
+				void			recycleFrameBlocks()
+		{
+			for(PxU32 i=0;i<mFrameBlocks.size();i++)
+			{
+				if(!mFrameBlocks[i]->owned)
+					freeBlock(mFrameBlocks[i]);
+			}
+			mFrameBlocks.clear();
+		}
+
+		// Releases the pages without used blocks
+				void			compact()
+		{
+			for(PxU32 i=0;i<eNB_SIZE_CLASSES;i++)
+			{
+				BlockHeader** link = &mFreeBlocks[i];
+				while(*link)
+				{
+					if(!(*link)->page->nbUsedBlocks)
+						*link = (*link)->next;
+					else
+						link = &(*link)->next;
+				}
+			}
+
+			PxU32 i=0;
+			while(i<mPages.size())
+			{
+				if(!mPages[i]->nbUsedBlocks)
+				{
+					PX_FREE(mPages[i]);
+					mPages.replaceWithLast(i);
+				}
+				else
+					i++;
+			}
+		}
+
+		PX_FORCE_INLINE	PxU32	getNbBlocks()	const	{ return mNbBlocks;			}
+		PX_FORCE_INLINE	PxU32	getNbPages()	const	{ return mPages.size();		}
+
+		private:
+				void			addPage(PxU32 sizeClass)
+		{
+			Page* page = reinterpret_cast<Page*>(PX_ALLOC(ePAGE_SIZE, "PxImmediatePairCache"));
+			page->sizeClass		= sizeClass;
+			page->nbUsedBlocks	= 0;
+			mPages.pushBack(page);
+
+			const PxU32 blockSize = PxU32(eMIN_BLOCK_SIZE)<<sizeClass;
+			const PxU32 nbBlocks = (ePAGE_SIZE - sizeof(Page)) / blockSize;
+			PxU8* address = reinterpret_cast<PxU8*>(page + 1);
+			for(PxU32 i=0;i<nbBlocks;i++)
+			{
+				BlockHeader* block = reinterpret_cast<BlockHeader*>(address + i*blockSize);
+				block->pool			= this;
+				block->page			= page;
+				block->sizeClass	= sizeClass;
+				block->owned		= 0;
+				block->next			= mFreeBlocks[sizeClass];
+				mFreeBlocks[sizeClass] = block;
+			}
+		}
+
+				BlockHeader*			mFreeBlocks[eNB_SIZE_CLASSES];
+				PxArray<Page*>			mPages;
+				PxArray<BlockHeader*>	mFrameBlocks;	// Blocks allocated since the last beginFrame() call
+				PxU32					mNbBlocks;
+	};
+
+	struct PairSlot
+	{
+		PxCache			cache;
+		BlockHeader*	block;			// Block owned by the pair. The cache points to a new block once contacts have been generated.
+		PxU64			key;
+		PxU32			lastUsedFrame;
+	};
+
+	// Key of unused slots. The two IDs of a pair are different, so this is not a valid pair key.
+	const PxU64 gFreeSlotKey = 0xffffffffffffffffull;
+
+	PX_FORCE_INLINE PxU64 getPairKey(PxU32 id0, PxU32 id1)
+	{
+		return id0<id1 ? (PxU64(id0)<<32)|id1 : (PxU64(id1)<<32)|id0;
+	}
+
+	class ImmediatePairCache : public PxImmediatePairCache, public PxUserAllocated
+	{
+		public:
+											ImmediatePairCache(const PxImmediatePairCacheDesc& desc);
+		virtual								~ImmediatePairCache();
+
+		// PxImmediatePairCache
+		virtual	void						beginFrame(PxU32 nbContexts)			PX_OVERRIDE;
+		virtual	PxU32						acquirePair(PxU32 id0, PxU32 id1)		PX_OVERRIDE;
+		virtual	PxU32						findPair(PxU32 id0, PxU32 id1)	const	PX_OVERRIDE;
+		virtual	PxCache&					getCache(PxU32 pairHandle)				PX_OVERRIDE;
+		virtual	PxCacheAllocator&			getCacheAllocator(PxU32 contextIndex)	PX_OVERRIDE;
+		virtual	void						releasePair(PxU32 pairHandle)			PX_OVERRIDE;
+		virtual	void						releasePairs(PxU32 id)					PX_OVERRIDE;
+		virtual	void						getStats(PxImmediatePairCacheStats& stats)	const	PX_OVERRIDE;
+		virtual	void						release()								PX_OVERRIDE	{ PX_DELETE_THIS;	}
+		//~PxImmediatePairCache
+
+		private:
+		PX_FORCE_INLINE	bool				isValidPair(PxU32 pairHandle)	const	{ return pairHandle<mSlots.size() && mSlots[pairHandle].key!=gFreeSlotKey;	}
+						void				releaseSlot(PxU32 index);
+
+						PxImmediatePairCacheDesc	mDesc;
+						PxArray<PairSlot>			mSlots;
+						PxArray<PxU32>				mFreeSlots;
+						PxHashMap<PxU64, PxU32>		mPairMap;		// Pair key to slot index
+						PxArray<BlockPool*>			mPools;			// One per context
+						PxU32						mNbContexts;
+						PxU32						mFrame;
+						PxU32						mNbFramesSinceCompaction;
+						PxU32						mNbEvictedPairs;
+	};
+}
+
+ImmediatePairCache::ImmediatePairCache(const PxImmediatePairCacheDesc& desc) :
+	mDesc						(desc),
+	mNbContexts					(0),
+	mFrame						(0),
+	mNbFramesSinceCompaction	(0),
+	mNbEvictedPairs				(0)
+{
+}
+
+ImmediatePairCache::~ImmediatePairCache()
+{
+	for(PxU32 i=0;i<mSlots.size();i++)
+	{
+		if(mSlots[i].key!=gFreeSlotKey)
+			releaseSlot(i);
+	}
+
+	for(PxU32 i=0;i<mPools.size();i++)
+		PX_DELETE(mPools[i]);
+}
+
+void ImmediatePairCache::releaseSlot(PxU32 index)
+{
+	PairSlot& slot = mSlots[index];
+
+	// A block allocated for the pair during the current frame is not owned yet and is recycled by the next frame
+	if(slot.block)
+		slot.block->pool->freeBlock(slot.block);
+
+	mPairMap.erase(slot.key);
+	slot.cache.reset();
+	slot.block	= NULL;
+	slot.key	= gFreeSlotKey;
+	mFreeSlots.pushBack(index);
+}
+
+void ImmediatePairCache::beginFrame(PxU32 nbContexts)
+{
+	PX_CHECK_AND_RETURN(nbContexts>0, "PxImmediatePairCache::beginFrame: nbContexts must be positive.");
+
+	// PxGenerateContacts() reads the old cache of a pair while writing the new one to a new block. The old block can be recycled now.
+	const PxU32 nbSlots = mSlots.size();
+	for(PxU32 i=0;i<nbSlots;i++)
+	{
+		PairSlot& slot = mSlots[i];
+		if(slot.key==gFreeSlotKey)
+			continue;
+
+		BlockHeader* block = slot.cache.mCachedData ? getBlockHeader(slot.cache.mCachedData) : NULL;
+		if(block!=slot.block)
+		{
+			if(slot.block)
+				slot.block->pool->freeBlock(slot.block);
+			if(block)
+				block->owned = 1;
+			slot.block = block;
+		}
+	}
+
+	for(PxU32 i=0;i<mPools.size();i++)
+		mPools[i]->recycleFrameBlocks();
+
+	mNbEvictedPairs = 0;
+	if(mDesc.maxStaleFrames)
+	{
+		for(PxU32 i=0;i<nbSlots;i++)
+		{
+			const PairSlot& slot = mSlots[i];
+			if(slot.key!=gFreeSlotKey && mFrame - slot.lastUsedFrame >= mDesc.maxStaleFrames)
+			{
+				releaseSlot(i);
+				mNbEvictedPairs++;
+			}
+		}
+	}
+
+	if(mDesc.compactionInterval && ++mNbFramesSinceCompaction>=mDesc.compactionInterval)
+	{
+		for(PxU32 i=0;i<mPools.size();i++)
+			mPools[i]->compact();
+		mNbFramesSinceCompaction = 0;
+	}
+
+	while(mPools.size()<nbContexts)
+		mPools.pushBack(PX_NEW(BlockPool));
+	mNbContexts = nbContexts;
+	mFrame++;
+}
+
+PxU32 ImmediatePairCache::acquirePair(PxU32 id0, PxU32 id1)
+{
+	PX_CHECK_AND_RETURN_VAL(id0!=id1, "PxImmediatePairCache::acquirePair: the IDs of a pair must be different.", PX_INVALID_IMMEDIATE_PAIR);
+
+	const PxU64 key = getPairKey(id0, id1);
+	const PxHashMap<PxU64, PxU32>::Entry* entry = mPairMap.find(key);
+	if(entry)
+	{
+		mSlots[entry->second].lastUsedFrame = mFrame;
+		return entry->second;
+	}
+
+	PxU32 index;
+	if(mFreeSlots.size())
+	{
+		index = mFreeSlots.popBack();
+	}
+	else
+	{
+		index = mSlots.size();
+		mSlots.insert();
+	}
+
+	PairSlot& slot = mSlots[index];
+	slot.cache			= PxCache();
+	slot.block			= NULL;
+	slot.key			= key;
+	slot.lastUsedFrame	= mFrame;
+	mPairMap.insert(key, index);
+	return index;
+}
+
+PxU32 ImmediatePairCache::findPair(PxU32 id0, PxU32 id1) const
+{
+	const PxHashMap<PxU64, PxU32>::Entry* entry = mPairMap.find(getPairKey(id0, id1));
+	return entry ? entry->second : PX_INVALID_IMMEDIATE_PAIR;
+}
+
+PxCache& ImmediatePairCache::getCache(PxU32 pairHandle)
+{
+	PX_ASSERT(isValidPair(pairHandle));
+	PairSlot& slot = mSlots[pairHandle];
+	slot.lastUsedFrame = mFrame;
+	return slot.cache;
+}
+
+PxCacheAllocator& ImmediatePairCache::getCacheAllocator(PxU32 contextIndex)
+{
+	PX_ASSERT(contextIndex<mNbContexts);
+	return *mPools[contextIndex];
+}
+
+void ImmediatePairCache::releasePair(PxU32 pairHandle)
+{
+	PX_CHECK_AND_RETURN(isValidPair(pairHandle), "PxImmediatePairCache::releasePair: invalid pair.");
+	releaseSlot(pairHandle);
+}
+
+void ImmediatePairCache::releasePairs(PxU32 id)
+{
+	for(PxU32 i=0;i<mSlots.size();i++)
+	{
+		const PxU64 key = mSlots[i].key;
+		if(key!=gFreeSlotKey && (PxU32(key>>32)==id || PxU32(key)==id))
+			releaseSlot(i);
+	}
+}
+
+void ImmediatePairCache::getStats(PxImmediatePairCacheStats& stats) const
+{
+	stats.nbPairs			= mPairMap.size();
+	stats.nbEvictedPairs	= mNbEvictedPairs;
+	stats.nbBlocks			= 0;
+	stats.nbPages			= 0;
+	for(PxU32 i=0;i<mPools.size();i++)
+	{
+		stats.nbBlocks	+= mPools[i]->getNbBlocks();
+		stats.nbPages	+= mPools[i]->getNbPages();
+	}
+}
+
+PxImmediatePairCache* physx::PxCreateImmediatePairCache(const PxImmediatePairCacheDesc& desc)
+{
+	return PX_NEW(ImmediatePairCache)(desc);
+}
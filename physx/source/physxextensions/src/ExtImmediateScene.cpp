@@ -0,0 +1,1039 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2024 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.
+
+
+#include "extensions/PxImmediateScene.h"
+#include "extensions/PxImmediatePairCache.h"
+#include "foundation/PxAllocator.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxHashMap.h"
+#include "foundation/PxMemory.h"
+#include "foundation/PxUserAllocated.h"
+#include "geometry/PxGeometryHelpers.h"
+#include "geometry/PxGeometryQuery.h"
+#include "task/PxCpuDispatcher.h"
+#include "CmParallelFor.h"
+#include "PxBroadPhase.h"
+#include "PxImmediateMode.h"
+
+using namespace physx;
+using namespace immediate;
+
+namespace
+{
+	// Linear allocator over pages that are kept from one reset to the next, so that a steady scene stops allocating after a few
+	// frames. Allocations larger than a page get their own block, released on reset.
+	class PageAllocator
+	{
+		public:
+		enum { ePAGE_SIZE = 16384 };
+
+			PageAllocator() : mNbUsedPages(0), mOffset(ePAGE_SIZE)	{}
+
+			~PageAllocator()
+			{
+				reset();
+				for(PxU32 i=0;i<mPages.size();i++)
+					PX_FREE(mPages[i]);
+			}
+
+			PxU8*	allocate(PxU32 byteSize)
+			{
+				byteSize = (byteSize + 15) & ~15;
+				if(byteSize>ePAGE_SIZE)
+				{
+					PxU8* block = reinterpret_cast<PxU8*>(PX_ALLOC(byteSize, "PxImmediateScene"));
+					mLargeBlocks.pushBack(block);
+					return block;
+				}
+
+				if(!mNbUsedPages || mOffset+byteSize>ePAGE_SIZE)
+				{
+					if(mNbUsedPages==mPages.size())
+						mPages.pushBack(reinterpret_cast<PxU8*>(PX_ALLOC(ePAGE_SIZE, "PxImmediateScene")));
+					mNbUsedPages++;
+					mOffset = 0;
+				}
+
+				PxU8* address = mPages[mNbUsedPages-1] + mOffset;
+				mOffset += byteSize;
+				return address;
+			}
+
+			void	reset()
+			{
+				for(PxU32 i=0;i<mLargeBlocks.size();i++)
+					PX_FREE(mLargeBlocks[i]);
+				mLargeBlocks.clear();
+				mNbUsedPages = 0;
+				mOffset = ePAGE_SIZE;
+			}
+
+		private:
+			PxArray<PxU8*>	mPages;
+			PxArray<PxU8*>	mLargeBlocks;
+			PxU32			mNbUsedPages;
+			PxU32			mOffset;
+	};
+
+	// Constraint data only lives for a frame. Friction anchors are read again by the next frame, so they are double-buffered: the memory
+	// written in a frame is recycled two frames later.
+	class ConstraintAllocator : public PxConstraintAllocator
+	{
+		public:
+							ConstraintAllocator() : mCurrent(0)	{}
+
+		virtual	PxU8*		reserveConstraintData(const PxU32 byteSize)	PX_OVERRIDE	{ return mConstraints.allocate(byteSize);			}
+		virtual	PxU8*		reserveFrictionData(const PxU32 byteSize)	PX_OVERRIDE	{ return mFrictions[mCurrent].allocate(byteSize);	}
+
+				void		flip()	{ mConstraints.reset(); mCurrent ^= 1; mFrictions[mCurrent].reset();	}
+
+		private:
+				PageAllocator	mConstraints;
+				PageAllocator	mFrictions[2];
+				PxU32			mCurrent;
+	};
+
+	struct Body
+	{
+		PxGeometryHolder	geometry;
+		PxTransform			localPose;
+		PxTransform			pose;
+		PxVec3				linearVelocity;
+		PxVec3				angularVelocity;
+		PxVec3				invInertia;
+		PxReal				invMass;
+		PxReal				linearDamping;
+		PxReal				angularDamping;
+		PxReal				maxLinearVelocitySq;
+		PxReal				maxAngularVelocitySq;
+		PxReal				maxDepenetrationVelocity;
+		PxReal				maxContactImpulse;
+		PxReal				staticFriction;
+		PxReal				dynamicFriction;
+		PxReal				restitution;
+		void*				userData;
+		bool				isDynamic;
+		bool				inUse;
+	};
+
+	struct Pair
+	{
+		PxU32					body0;			// Always a dynamic body
+		PxU32					body1;
+		PxU32					cacheHandle;	// Pair in the PxImmediatePairCache
+		PxU8*					frictions;
+		PxU32					nbFrictions;
+		const PxContactPoint*	contacts;		// Contacts of the current frame
+		PxU32					contactStart;
+		PxU32					nbContacts;
+	};
+
+	// Scratch data of a narrowphase batch. Batches always cover the same range of pairs, so the results do not depend on the thread
+	// that runs them. Each batch also uses its own allocator of the pair cache.
+	struct NarrowPhaseContext : public PxUserAllocated
+	{
+		PxArray<PxContactPoint>	contacts;
+	};
+
+	// Scratch data of a solver batch, i.e. of a group of islands solved together.
+	struct SolverContext : public PxUserAllocated
+	{
+		ConstraintAllocator					allocator;
+		PxArray<PxRigidBodyData>			rigidData;
+		PxArray<PxSolverBody>				bodies;
+		PxArray<PxSolverBodyData>			bodyData;
+		PxArray<PxVec3>						linearMotion;
+		PxArray<PxVec3>						angularMotion;
+		PxArray<PxTGSSolverBodyVel>			tgsBodies;
+		PxArray<PxTGSSolverBodyTxInertia>	txInertia;
+		PxArray<PxTGSSolverBodyData>		tgsBodyData;
+		PxArray<PxTransform>				poses;
+		PxArray<PxSolverConstraintDesc>		descs;
+		PxArray<PxSolverConstraintDesc>		orderedDescs;
+		PxArray<PxConstraintBatchHeader>	headers;
+		PxArray<PxSolverContactDesc>		contactDescs;
+		PxArray<PxTGSSolverContactDesc>		tgsContactDescs;
+		PxArray<Pair*>						orderedPairs;
+		PxArray<PxReal>						contactForces;
+	};
+
+	struct SolverBatch
+	{
+		PxU32	bodyStart;
+		PxU32	nbBodies;
+		PxU32	pairStart;
+		PxU32	nbPairs;
+	};
+
+	class PairContactRecorder : public PxContactRecorder
+	{
+		public:
+			PairContactRecorder(PxArray<PxContactPoint>& contacts, const Body& body0, const Body& body1) :
+				mContacts			(contacts),
+				mStaticFriction		((body0.staticFriction + body1.staticFriction)*0.5f),
+				mDynamicFriction	((body0.dynamicFriction + body1.dynamicFriction)*0.5f),
+				mRestitution		((body0.restitution + body1.restitution)*0.5f),
+				mNbContacts			(0)
+			{
+			}
+
+			virtual bool	recordContacts(const PxContactPoint* contactPoints, PxU32 nbContacts, PxU32 index)	PX_OVERRIDE
+			{
+				PX_UNUSED(index);
+				for(PxU32 i=0;i<nbContacts;i++)
+				{
+					PxContactPoint& point = mContacts.insert();
+					point = contactPoints[i];
+					point.maxImpulse		= PX_MAX_F32;
+					point.targetVel			= PxVec3(0.0f);
+					point.staticFriction	= mStaticFriction;
+					point.dynamicFriction	= mDynamicFriction;
+					point.restitution		= mRestitution;
+					point.damping			= 0.0f;
+					point.materialFlags		= 0;
+				}
+				mNbContacts += nbContacts;
+				return true;
+			}
+
+			PxArray<PxContactPoint>&	mContacts;
+			const PxReal				mStaticFriction;
+			const PxReal				mDynamicFriction;
+			const PxReal				mRestitution;
+			PxU32						mNbContacts;
+
+			PX_NOCOPY(PairContactRecorder)
+	};
+
+	PX_FORCE_INLINE PxU64 getPairKey(PxU32 id0, PxU32 id1)
+	{
+		return id0<id1 ? (PxU64(id0)<<32)|id1 : (PxU64(id1)<<32)|id0;
+	}
+
+	PX_FORCE_INLINE PxU32 findIslandRoot(PxU32* parents, PxU32 index)
+	{
+		while(parents[index]!=index)
+		{
+			parents[index] = parents[parents[index]];
+			index = parents[index];
+		}
+		return index;
+	}
+
+	PX_FORCE_INLINE void setSolverBodies(PxSolverConstraintDesc& desc, PxSolverBody* bodies, PxU32 index0, PxU32 index1)
+	{
+		desc.bodyA = bodies + index0;
+		desc.bodyB = bodies + index1;
+	}
+
+	PX_FORCE_INLINE void setSolverBodies(PxSolverConstraintDesc& desc, PxTGSSolverBodyVel* bodies, PxU32 index0, PxU32 index1)
+	{
+		desc.tgsBodyA = bodies + index0;
+		desc.tgsBodyB = bodies + index1;
+	}
+
+	class ImmediateScene : public PxImmediateScene, public PxUserAllocated
+	{
+		public:
+										ImmediateScene(const PxImmediateSceneDesc& desc);
+		virtual							~ImmediateScene();
+
+		// PxImmediateScene
+		virtual	PxU32					createBody(const PxImmediateBodyDesc& desc)					PX_OVERRIDE;
+		virtual	void					releaseBody(PxU32 body)										PX_OVERRIDE;
+		virtual	PxU32					getNbBodies()										const	PX_OVERRIDE	{ return mNbBodies;	}
+		virtual	void					setGlobalPose(PxU32 body, const PxTransform& pose)			PX_OVERRIDE;
+		virtual	PxTransform				getGlobalPose(PxU32 body)							const	PX_OVERRIDE;
+		virtual	void					setLinearVelocity(PxU32 body, const PxVec3& velocity)		PX_OVERRIDE;
+		virtual	PxVec3					getLinearVelocity(PxU32 body)						const	PX_OVERRIDE;
+		virtual	void					setAngularVelocity(PxU32 body, const PxVec3& velocity)		PX_OVERRIDE;
+		virtual	PxVec3					getAngularVelocity(PxU32 body)						const	PX_OVERRIDE;
+		virtual	void*					getUserData(PxU32 body)								const	PX_OVERRIDE;
+		virtual	void					setGravity(const PxVec3& gravity)							PX_OVERRIDE	{ mDesc.gravity = gravity;	}
+		virtual	PxVec3					getGravity()										const	PX_OVERRIDE	{ return mDesc.gravity;		}
+		virtual	void					simulate(PxReal dt)											PX_OVERRIDE;
+		virtual	void					getStats(PxImmediateSceneStats& stats)				const	PX_OVERRIDE	{ stats = mStats;			}
+		virtual	void					release()													PX_OVERRIDE	{ PX_DELETE_THIS;			}
+		//~PxImmediateScene
+
+				void					runNarrowPhase(PxU32 startPair, PxU32 endPair);
+				void					solveBatch(PxU32 batchIndex);
+
+		private:
+		// Number of pairs per narrowphase task
+		enum { eNARROWPHASE_BATCH_SIZE = 64 };
+		// Islands are grouped until a solver task has at least this many bodies and pairs
+		enum { eSOLVER_BATCH_COST = 128 };
+
+				bool					isValidBody(PxU32 body)	const	{ return body<mBodies.size() && mBodies[body].inUse;	}
+				PxBounds3				computeBounds(const Body& body)	const;
+				void					updateBroadPhase();
+				void					addPair(PxU32 id0, PxU32 id1);
+				void					removePair(PxU32 id0, PxU32 id1);
+				void					buildIslands();
+				void					fillRigidBodyData(SolverContext& context, const SolverBatch& batch);
+		template<class SolverBodyT>
+				void					setupConstraintDescs(SolverContext& context, const SolverBatch& batch, SolverBodyT* bodies);
+				void					solveBatchPGS(SolverContext& context, const SolverBatch& batch);
+				void					solveBatchTGS(SolverContext& context, const SolverBatch& batch);
+
+				PxImmediateSceneDesc		mDesc;
+				PxBroadPhase*				mBroadPhase;
+				PxAABBManager*				mAABBManager;
+
+				PxArray<Body>				mBodies;
+				PxArray<PxU32>				mFreeBodies;		// Indices that can be reused
+				PxArray<PxU32>				mReleasedBodies;	// Indices released since the last broadphase update, not reusable yet
+				PxU32						mNbBodies;
+
+				PxArray<Pair>				mPairs;
+				PxHashMap<PxU64, PxU32>		mPairMap;			// Pair key to index in mPairs
+				PxImmediatePairCache*		mPairCache;			// Contact caches of the pairs
+
+				PxArray<NarrowPhaseContext*>	mNarrowPhaseContexts;
+				PxArray<SolverContext*>			mSolverContexts;
+
+				// Islands, rebuilt every frame. Bodies and touching pairs are sorted by island, and a solver batch is a range of
+				// consecutive islands.
+				PxArray<PxU32>				mIslandParents;
+				PxArray<PxU32>				mIslandIds;
+				PxArray<PxU32>				mIslandBodyStarts;
+				PxArray<PxU32>				mIslandPairStarts;
+				PxArray<PxU32>				mIslandBodies;
+				PxArray<PxU32>				mIslandPairs;
+				PxArray<PxU32>				mSolverIndices;		// Index of each body in its solver batch
+				PxArray<SolverBatch>		mSolverBatches;
+
+				PxReal						mDt;
+				PxImmediateSceneStats		mStats;
+	};
+}
+
+ImmediateScene::ImmediateScene(const PxImmediateSceneDesc& desc) :
+	mDesc		(desc),
+	mBroadPhase	(NULL),
+	mAABBManager(NULL),
+	mNbBodies	(0),
+	mPairCache	(NULL),
+	mDt			(0.0f)
+{
+	PxMemZero(&mStats, sizeof(PxImmediateSceneStats));
+
+	PxBroadPhaseDesc bpDesc(PxBroadPhaseType::eABP);
+	mBroadPhase = PxCreateBroadPhase(bpDesc);
+	mAABBManager = PxCreateAABBManager(*mBroadPhase);
+
+	// Pairs are released when the broadphase loses them, and all pairs go through contact generation every frame
+	PxImmediatePairCacheDesc pairCacheDesc;
+	pairCacheDesc.maxStaleFrames = 0;
+	mPairCache = PxCreateImmediatePairCache(pairCacheDesc);
+}
+
+ImmediateScene::~ImmediateScene()
+{
+	for(PxU32 i=0;i<mNarrowPhaseContexts.size();i++)
+		PX_DELETE(mNarrowPhaseContexts[i]);
+	for(PxU32 i=0;i<mSolverContexts.size();i++)
+		PX_DELETE(mSolverContexts[i]);
+
+	PX_RELEASE(mPairCache);
+	PX_RELEASE(mAABBManager);
+	PX_RELEASE(mBroadPhase);
+}
+
+PxBounds3 ImmediateScene::computeBounds(const Body& body) const
+{
+	PxBounds3 bounds;
+	PxGeometryQuery::computeGeomBounds(bounds, body.geometry.any(), body.pose * body.localPose);
+	return bounds;
+}
+
+PxU32 ImmediateScene::createBody(const PxImmediateBodyDesc& desc)
+{
+	if(!desc.isValid())
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxImmediateScene::createBody: invalid descriptor.");
+		return PX_INVALID_IMMEDIATE_BODY;
+	}
+
+	PxU32 index;
+	if(mFreeBodies.size())
+	{
+		index = mFreeBodies.popBack();
+	}
+	else
+	{
+		index = mBodies.size();
+		mBodies.insert();
+		mSolverIndices.pushBack(0);
+	}
+
+	const bool isDynamic = desc.type==PxActorType::eRIGID_DYNAMIC;
+
+	Body& body = mBodies[index];
+	body.geometry.storeAny(*desc.geometry);
+	body.localPose					= desc.localPose;
+	body.pose						= desc.pose;
+	body.linearVelocity				= isDynamic ? desc.linearVelocity : PxVec3(0.0f);
+	body.angularVelocity			= isDynamic ? desc.angularVelocity : PxVec3(0.0f);
+	body.invMass					= isDynamic && desc.mass>0.0f ? 1.0f/desc.mass : 0.0f;
+	body.invInertia.x				= isDynamic && desc.massSpaceInertiaTensor.x>0.0f ? 1.0f/desc.massSpaceInertiaTensor.x : 0.0f;
+	body.invInertia.y				= isDynamic && desc.massSpaceInertiaTensor.y>0.0f ? 1.0f/desc.massSpaceInertiaTensor.y : 0.0f;
+	body.invInertia.z				= isDynamic && desc.massSpaceInertiaTensor.z>0.0f ? 1.0f/desc.massSpaceInertiaTensor.z : 0.0f;
+	body.linearDamping				= desc.linearDamping;
+	body.angularDamping				= desc.angularDamping;
+	body.maxLinearVelocitySq		= desc.maxLinearVelocity * desc.maxLinearVelocity;
+	body.maxAngularVelocitySq		= desc.maxAngularVelocity * desc.maxAngularVelocity;
+	body.maxDepenetrationVelocity	= desc.maxDepenetrationVelocity;
+	body.maxContactImpulse			= desc.maxContactImpulse;
+	body.staticFriction				= desc.staticFriction;
+	body.dynamicFriction			= desc.dynamicFriction;
+	body.restitution				= desc.restitution;
+	body.userData					= desc.userData;
+	body.isDynamic					= isDynamic;
+	body.inUse						= true;
+
+	const PxBpFilterGroup group = isDynamic ? PxGetBroadPhaseDynamicFilterGroup(index) : PxGetBroadPhaseStaticFilterGroup();
+	mAABBManager->addObject(index, computeBounds(body), group, mDesc.contactOffset);
+
+	mNbBodies++;
+	return index;
+}
+
+void ImmediateScene::releaseBody(PxU32 body)
+{
+	PX_CHECK_AND_RETURN(isValidBody(body), "PxImmediateScene::releaseBody: invalid body.");
+
+	mAABBManager->removeObject(body);
+	mBodies[body].inUse = false;
+	mBodies[body].geometry.storeAny(PxSphereGeometry());
+
+	// The pairs of the body are removed by the next broadphase update, and the index cannot be reused before that.
+	mReleasedBodies.pushBack(body);
+	mNbBodies--;
+}
+
+void ImmediateScene::setGlobalPose(PxU32 body, const PxTransform& pose)
+{
+	PX_CHECK_AND_RETURN(isValidBody(body) && pose.isValid(), "PxImmediateScene::setGlobalPose: invalid parameter.");
+
+	Body& b = mBodies[body];
+	b.pose = pose;
+
+	// Dynamic bounds are updated by simulate()
+	if(!b.isDynamic)
+	{
+		const PxBounds3 bounds = computeBounds(b);
+		mAABBManager->updateObject(body, &bounds);
+	}
+}
+
+PxTransform ImmediateScene::getGlobalPose(PxU32 body) const
+{
+	PX_CHECK_AND_RETURN_VAL(isValidBody(body), "PxImmediateScene::getGlobalPose: invalid body.", PxTransform(PxIdentity));
+	return mBodies[body].pose;
+}
+
+void ImmediateScene::setLinearVelocity(PxU32 body, const PxVec3& velocity)
+{
+	PX_CHECK_AND_RETURN(isValidBody(body) && mBodies[body].isDynamic && velocity.isFinite(), "PxImmediateScene::setLinearVelocity: invalid parameter.");
+	mBodies[body].linearVelocity = velocity;
+}
+
+PxVec3 ImmediateScene::getLinearVelocity(PxU32 body) const
+{
+	PX_CHECK_AND_RETURN_VAL(isValidBody(body), "PxImmediateScene::getLinearVelocity: invalid body.", PxVec3(0.0f));
+	return mBodies[body].linearVelocity;
+}
+
+void ImmediateScene::setAngularVelocity(PxU32 body, const PxVec3& velocity)
+{
+	PX_CHECK_AND_RETURN(isValidBody(body) && mBodies[body].isDynamic && velocity.isFinite(), "PxImmediateScene::setAngularVelocity: invalid parameter.");
+	mBodies[body].angularVelocity = velocity;
+}
+
+PxVec3 ImmediateScene::getAngularVelocity(PxU32 body) const
+{
+	PX_CHECK_AND_RETURN_VAL(isValidBody(body), "PxImmediateScene::getAngularVelocity: invalid body.", PxVec3(0.0f));
+	return mBodies[body].angularVelocity;
+}
+
+void* ImmediateScene::getUserData(PxU32 body) const
+{
+	PX_CHECK_AND_RETURN_NULL(isValidBody(body), "PxImmediateScene::getUserData: invalid body.");
+	return mBodies[body].userData;
+}
+
+void ImmediateScene::addPair(PxU32 id0, PxU32 id1)
+{
+	// Static-static pairs are filtered out by the broadphase groups
+	if(!mBodies[id0].isDynamic)
+		PxSwap(id0, id1);
+	PX_ASSERT(mBodies[id0].isDynamic);
+
+	Pair pair;
+	pair.body0			= id0;
+	pair.body1			= id1;
+	pair.cacheHandle	= mPairCache->acquirePair(id0, id1);
+	pair.frictions		= NULL;
+	pair.nbFrictions	= 0;
+	pair.contacts		= NULL;
+	pair.contactStart	= 0;
+	pair.nbContacts		= 0;
+
+	const bool inserted = mPairMap.insert(getPairKey(id0, id1), mPairs.size());
+	PX_ASSERT(inserted);
+	PX_UNUSED(inserted);
+	mPairs.pushBack(pair);
+}
+
+void ImmediateScene::removePair(PxU32 id0, PxU32 id1)
+{
+	PxHashMap<PxU64, PxU32>::Entry entry;
+	if(!mPairMap.erase(getPairKey(id0, id1), entry))
+	{
+		PX_ASSERT(0);
+		return;
+	}
+
+	const PxU32 index = entry.second;
+	mPairCache->releasePair(mPairs[index].cacheHandle);
+
+	const PxU32 lastIndex = mPairs.size() - 1;
+	if(index!=lastIndex)
+	{
+		mPairs[index] = mPairs[lastIndex];
+		mPairMap[getPairKey(mPairs[index].body0, mPairs[index].body1)] = index;
+	}
+	mPairs.popBack();
+}
+
+void ImmediateScene::updateBroadPhase()
+{
+	const PxU32 nbBodies = mBodies.size();
+	for(PxU32 i=0;i<nbBodies;i++)
+	{
+		const Body& body = mBodies[i];
+		if(body.inUse && body.isDynamic)
+		{
+			const PxBounds3 bounds = computeBounds(body);
+			mAABBManager->updateObject(i, &bounds);
+		}
+	}
+
+	PxBroadPhaseResults results;
+	mAABBManager->updateAndFetchResults(results);
+
+	for(PxU32 i=0;i<results.mNbDeletedPairs;i++)
+		removePair(results.mDeletedPairs[i].mID0, results.mDeletedPairs[i].mID1);
+	for(PxU32 i=0;i<results.mNbCreatedPairs;i++)
+		addPair(results.mCreatedPairs[i].mID0, results.mCreatedPairs[i].mID1);
+
+	// The broadphase does not report the pairs of removed objects
+	if(mReleasedBodies.size())
+	{
+		PxU32 i=0;
+		while(i<mPairs.size())
+		{
+			const Pair& pair = mPairs[i];
+			if(!mBodies[pair.body0].inUse || !mBodies[pair.body1].inUse)
+				removePair(pair.body0, pair.body1);
+			else
+				i++;
+		}
+
+		for(PxU32 j=0;j<mReleasedBodies.size();j++)
+			mFreeBodies.pushBack(mReleasedBodies[j]);
+		mReleasedBodies.clear();
+	}
+}
+
+void ImmediateScene::runNarrowPhase(PxU32 startPair, PxU32 endPair)
+{
+	const PxU32 batchIndex = startPair / eNARROWPHASE_BATCH_SIZE;
+	NarrowPhaseContext& context = *mNarrowPhaseContexts[batchIndex];
+	PxCacheAllocator& cacheAllocator = mPairCache->getCacheAllocator(batchIndex);
+	context.contacts.clear();
+
+	const PxReal contactDistance = mDesc.contactOffset * 2.0f;
+
+	for(PxU32 i=startPair;i<endPair;i++)
+	{
+		Pair& pair = mPairs[i];
+		const Body& body0 = mBodies[pair.body0];
+		const Body& body1 = mBodies[pair.body1];
+
+		const PxGeometry* geom0 = &body0.geometry.any();
+		const PxGeometry* geom1 = &body1.geometry.any();
+		const PxTransform pose0 = body0.pose * body0.localPose;
+		const PxTransform pose1 = body1.pose * body1.localPose;
+
+		PairContactRecorder recorder(context.contacts, body0, body1);
+		pair.contactStart = context.contacts.size();
+		PxGenerateContacts(&geom0, &geom1, &pose0, &pose1, &mPairCache->getCache(pair.cacheHandle), 1, recorder, contactDistance, mDesc.meshContactMargin, mDesc.toleranceLength, cacheAllocator);
+		pair.nbContacts = recorder.mNbContacts;
+
+		// The friction anchors are only valid for a continuous contact
+		if(!pair.nbContacts)
+		{
+			pair.frictions = NULL;
+			pair.nbFrictions = 0;
+		}
+	}
+
+	// The contact buffer does not move anymore
+	for(PxU32 i=startPair;i<endPair;i++)
+		mPairs[i].contacts = context.contacts.begin() + mPairs[i].contactStart;
+}
+
+void ImmediateScene::buildIslands()
+{
+	const PxU32 nbBodies = mBodies.size();
+	const PxU32 nbPairs = mPairs.size();
+
+	mIslandParents.resizeUninitialized(nbBodies);
+	mIslandIds.resizeUninitialized(nbBodies);
+	PxU32* parents = mIslandParents.begin();
+	for(PxU32 i=0;i<nbBodies;i++)
+		parents[i] = i;
+
+	// Static bodies do not connect islands
+	PxU32 nbTouchingPairs = 0;
+	PxU32 nbContacts = 0;
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		const Pair& pair = mPairs[i];
+		if(!pair.nbContacts)
+			continue;
+
+		nbTouchingPairs++;
+		nbContacts += pair.nbContacts;
+		if(mBodies[pair.body1].isDynamic)
+		{
+			const PxU32 root0 = findIslandRoot(parents, pair.body0);
+			const PxU32 root1 = findIslandRoot(parents, pair.body1);
+			// Lowest index as root, so that the islands do not depend on the pair order
+			if(root0<root1)
+				parents[root1] = root0;
+			else if(root1<root0)
+				parents[root0] = root1;
+		}
+	}
+
+	// Number the islands in body order
+	PxU32 nbIslands = 0;
+	mIslandBodyStarts.clear();
+	for(PxU32 i=0;i<nbBodies;i++)
+	{
+		mIslandIds[i] = PX_INVALID_U32;
+		const Body& body = mBodies[i];
+		if(!body.inUse || !body.isDynamic)
+			continue;
+
+		const PxU32 root = findIslandRoot(parents, i);
+		if(root==i)
+		{
+			mIslandIds[i] = nbIslands++;
+			mIslandBodyStarts.pushBack(0);
+		}
+		else
+		{
+			PX_ASSERT(root<i);
+			mIslandIds[i] = mIslandIds[root];
+		}
+		mIslandBodyStarts[mIslandIds[i]]++;
+	}
+
+	// Sort bodies and touching pairs by island
+	mIslandPairStarts.resizeUninitialized(nbIslands + 1);
+	PxMemZero(mIslandPairStarts.begin(), sizeof(PxU32)*(nbIslands + 1));
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		if(mPairs[i].nbContacts)
+			mIslandPairStarts[mIslandIds[mPairs[i].body0]]++;
+	}
+
+	mIslandBodyStarts.pushBack(0);
+	PxU32 bodyOffset = 0;
+	PxU32 pairOffset = 0;
+	for(PxU32 i=0;i<=nbIslands;i++)
+	{
+		const PxU32 nbIslandBodies = mIslandBodyStarts[i];
+		const PxU32 nbIslandPairs = mIslandPairStarts[i];
+		mIslandBodyStarts[i] = bodyOffset;
+		mIslandPairStarts[i] = pairOffset;
+		bodyOffset += nbIslandBodies;
+		pairOffset += nbIslandPairs;
+	}
+
+	mIslandBodies.resizeUninitialized(bodyOffset);
+	mIslandPairs.resizeUninitialized(pairOffset);
+	for(PxU32 i=0;i<nbBodies;i++)
+	{
+		if(mIslandIds[i]!=PX_INVALID_U32)
+			mIslandBodies[mIslandBodyStarts[mIslandIds[i]]++] = i;
+	}
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		if(mPairs[i].nbContacts)
+			mIslandPairs[mIslandPairStarts[mIslandIds[mPairs[i].body0]]++] = i;
+	}
+
+	// The fill loops moved the starts to the ends. Group consecutive islands into solver batches.
+	mSolverBatches.clear();
+	SolverBatch batch;
+	batch.bodyStart = 0;
+	batch.pairStart = 0;
+	for(PxU32 i=0;i<nbIslands;i++)
+	{
+		const PxU32 bodyEnd = mIslandBodyStarts[i];
+		const PxU32 pairEnd = mIslandPairStarts[i];
+		if(bodyEnd - batch.bodyStart + pairEnd - batch.pairStart >= eSOLVER_BATCH_COST || i==nbIslands-1)
+		{
+			batch.nbBodies = bodyEnd - batch.bodyStart;
+			batch.nbPairs = pairEnd - batch.pairStart;
+			mSolverBatches.pushBack(batch);
+			batch.bodyStart = bodyEnd;
+			batch.pairStart = pairEnd;
+		}
+	}
+
+	mStats.nbPairs			= nbPairs;
+	mStats.nbTouchingPairs	= nbTouchingPairs;
+	mStats.nbContacts		= nbContacts;
+	mStats.nbIslands		= nbIslands;
+	mStats.nbSolverBatches	= mSolverBatches.size();
+}
+
+void ImmediateScene::fillRigidBodyData(SolverContext& context, const SolverBatch& batch)
+{
+	context.rigidData.resizeUninitialized(batch.nbBodies);
+
+	const PxU32* bodyIndices = mIslandBodies.begin() + batch.bodyStart;
+	for(PxU32 i=0;i<batch.nbBodies;i++)
+	{
+		const Body& body = mBodies[bodyIndices[i]];
+		mSolverIndices[bodyIndices[i]] = i;
+
+		PxRigidBodyData& data = context.rigidData[i];
+		data.linearVelocity				= body.linearVelocity;
+		data.invMass					= body.invMass;
+		data.angularVelocity			= body.angularVelocity;
+		data.maxDepenetrationVelocity	= body.maxDepenetrationVelocity;
+		data.invInertia					= body.invInertia;
+		data.maxContactImpulse			= body.maxContactImpulse;
+		data.body2World					= body.pose;
+		data.linearDamping				= body.linearDamping;
+		data.angularDamping				= body.angularDamping;
+		data.maxLinearVelocitySq		= body.maxLinearVelocitySq;
+		data.maxAngularVelocitySq		= body.maxAngularVelocitySq;
+		data.pad						= 0;
+	}
+}
+
+// Contacts against static bodies all use the last solver body of the batch, with a zero velocity and an infinite mass, like the world
+// body of PxScene.
+template<class SolverBodyT>
+void ImmediateScene::setupConstraintDescs(SolverContext& context, const SolverBatch& batch, SolverBodyT* bodies)
+{
+	const PxU32 nbPairs = batch.nbPairs;
+	const PxU32* pairIndices = mIslandPairs.begin() + batch.pairStart;
+
+	context.descs.resizeUninitialized(nbPairs);
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		Pair& pair = mPairs[pairIndices[i]];
+		const PxU32 index0 = mSolverIndices[pair.body0];
+		const PxU32 index1 = mBodies[pair.body1].isDynamic ? mSolverIndices[pair.body1] : batch.nbBodies;
+
+		PxSolverConstraintDesc& desc = context.descs[i];
+		PxMemZero(&desc, sizeof(PxSolverConstraintDesc));
+		setSolverBodies(desc, bodies, index0, index1);
+		desc.bodyADataIndex	= index0;
+		desc.bodyBDataIndex	= index1;
+		desc.linkIndexA		= PxSolverConstraintDesc::RIGID_BODY;
+		desc.linkIndexB		= PxSolverConstraintDesc::RIGID_BODY;
+		// Overwritten by the contact prep, after batching
+		desc.constraint		= reinterpret_cast<PxU8*>(&pair);
+		desc.constraintType	= PxSolverConstraintDesc::eCONTACT_CONSTRAINT;
+	}
+
+	context.orderedDescs.resizeUninitialized(nbPairs);
+	context.headers.resizeUninitialized(nbPairs);
+	context.orderedPairs.resizeUninitialized(nbPairs);
+}
+
+void ImmediateScene::solveBatchPGS(SolverContext& context, const SolverBatch& batch)
+{
+	const PxU32 nbBodies = batch.nbBodies;
+	const PxU32 nbPairs = batch.nbPairs;
+
+	context.bodies.resizeUninitialized(nbBodies + 1);
+	context.bodyData.resizeUninitialized(nbBodies + 1);
+	PxConstructSolverBodies(context.rigidData.begin(), context.bodyData.begin(), nbBodies, mDesc.gravity, mDt);
+	PxConstructStaticSolverBody(PxTransform(PxIdentity), context.bodyData[nbBodies]);
+
+	setupConstraintDescs(context, batch, context.bodies.begin());
+	const PxU32 nbHeaders = PxBatchConstraints(context.descs.begin(), nbPairs, context.bodies.begin(), nbBodies, context.headers.begin(), context.orderedDescs.begin());
+
+	PxU32 nbContacts = 0;
+	for(PxU32 i=0;i<nbPairs;i++)
+		nbContacts += reinterpret_cast<const Pair*>(context.orderedDescs[i].constraint)->nbContacts;
+	context.contactForces.resizeUninitialized(nbContacts);
+
+	// The headers reference consecutive ranges of ordered descs, and the contact descs follow the same order
+	context.contactDescs.resizeUninitialized(nbPairs);
+	PxU32 contactOffset = 0;
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		PxSolverConstraintDesc& constraintDesc = context.orderedDescs[i];
+		Pair* pair = reinterpret_cast<Pair*>(constraintDesc.constraint);
+		context.orderedPairs[i] = pair;
+		const bool isDynamic1 = constraintDesc.bodyBDataIndex!=nbBodies;
+
+		PxSolverContactDesc& contactDesc = context.contactDescs[i];
+		PxMemZero(&contactDesc, sizeof(PxSolverContactDesc));
+		contactDesc.body0				= constraintDesc.bodyA;
+		contactDesc.body1				= constraintDesc.bodyB;
+		contactDesc.data0				= &context.bodyData[constraintDesc.bodyADataIndex];
+		contactDesc.data1				= &context.bodyData[constraintDesc.bodyBDataIndex];
+		contactDesc.bodyFrame0			= contactDesc.data0->body2World;
+		contactDesc.bodyFrame1			= isDynamic1 ? contactDesc.data1->body2World : mBodies[pair->body1].pose;
+		contactDesc.bodyState0			= PxSolverConstraintPrepDescBase::eDYNAMIC_BODY;
+		contactDesc.bodyState1			= isDynamic1 ? PxSolverConstraintPrepDescBase::eDYNAMIC_BODY : PxSolverConstraintPrepDescBase::eSTATIC_BODY;
+		contactDesc.desc				= &constraintDesc;
+		contactDesc.invMassScales.linear0 = contactDesc.invMassScales.linear1 = contactDesc.invMassScales.angular0 = contactDesc.invMassScales.angular1 = 1.0f;
+		contactDesc.shapeInteraction	= NULL;
+		contactDesc.contacts			= pair->contacts;
+		contactDesc.numContacts			= pair->nbContacts;
+		contactDesc.contactForces		= context.contactForces.begin() + contactOffset;
+		contactDesc.frictionPtr			= pair->frictions;
+		contactDesc.frictionCount		= PxU8(pair->nbFrictions);
+		contactDesc.maxCCDSeparation	= PX_MAX_F32;
+		contactOffset += pair->nbContacts;
+	}
+
+	PxCreateContactConstraints(context.headers.begin(), nbHeaders, context.contactDescs.begin(), context.allocator, 1.0f/mDt,
+		-mDesc.bounceThresholdVelocity, mDesc.frictionOffsetThreshold, mDesc.frictionCorrelationDistance);
+
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		context.orderedPairs[i]->frictions = context.contactDescs[i].frictionPtr;
+		context.orderedPairs[i]->nbFrictions = context.contactDescs[i].frictionCount;
+	}
+
+	// The solver accumulates delta velocities in the solver bodies, which must start at zero
+	PxMemZero(context.bodies.begin(), sizeof(PxSolverBody)*(nbBodies + 1));
+	context.linearMotion.resizeUninitialized(nbBodies);
+	context.angularMotion.resizeUninitialized(nbBodies);
+
+	PxSolveConstraints(context.headers.begin(), nbHeaders, context.orderedDescs.begin(), context.bodies.begin(), context.linearMotion.begin(), context.angularMotion.begin(),
+		nbBodies, mDesc.nbPositionIterations, mDesc.nbVelocityIterations);
+	PxIntegrateSolverBodies(context.bodyData.begin(), context.bodies.begin(), context.linearMotion.begin(), context.angularMotion.begin(), nbBodies, mDt);
+
+	const PxU32* bodyIndices = mIslandBodies.begin() + batch.bodyStart;
+	for(PxU32 i=0;i<nbBodies;i++)
+	{
+		Body& body = mBodies[bodyIndices[i]];
+		const PxSolverBodyData& data = context.bodyData[i];
+		body.pose				= data.body2World;
+		body.linearVelocity		= data.linearVelocity;
+		body.angularVelocity	= data.angularVelocity;
+	}
+}
+
+void ImmediateScene::solveBatchTGS(SolverContext& context, const SolverBatch& batch)
+{
+	const PxU32 nbBodies = batch.nbBodies;
+	const PxU32 nbPairs = batch.nbPairs;
+
+	const PxReal invDt = 1.0f/mDt;
+	const PxReal stepDt = mDt/PxReal(mDesc.nbPositionIterations);
+	const PxReal invStepDt = invDt*PxReal(mDesc.nbPositionIterations);
+
+	context.tgsBodies.resizeUninitialized(nbBodies + 1);
+	context.txInertia.resizeUninitialized(nbBodies + 1);
+	context.tgsBodyData.resizeUninitialized(nbBodies + 1);
+	context.poses.resizeUninitialized(nbBodies + 1);
+	PxConstructSolverBodiesTGS(context.rigidData.begin(), context.tgsBodies.begin(), context.txInertia.begin(), context.tgsBodyData.begin(), nbBodies, mDesc.gravity, mDt);
+	PxConstructStaticSolverBodyTGS(PxTransform(PxIdentity), context.tgsBodies[nbBodies], context.txInertia[nbBodies], context.tgsBodyData[nbBodies]);
+	for(PxU32 i=0;i<nbBodies;i++)
+		context.poses[i] = context.rigidData[i].body2World;
+	context.poses[nbBodies] = PxTransform(PxIdentity);
+
+	setupConstraintDescs(context, batch, context.tgsBodies.begin());
+	const PxU32 nbHeaders = PxBatchConstraintsTGS(context.descs.begin(), nbPairs, context.tgsBodies.begin(), nbBodies, context.headers.begin(), context.orderedDescs.begin());
+
+	PxU32 nbContacts = 0;
+	for(PxU32 i=0;i<nbPairs;i++)
+		nbContacts += reinterpret_cast<const Pair*>(context.orderedDescs[i].constraint)->nbContacts;
+	context.contactForces.resizeUninitialized(nbContacts);
+
+	context.tgsContactDescs.resizeUninitialized(nbPairs);
+	PxU32 contactOffset = 0;
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		PxSolverConstraintDesc& constraintDesc = context.orderedDescs[i];
+		Pair* pair = reinterpret_cast<Pair*>(constraintDesc.constraint);
+		context.orderedPairs[i] = pair;
+		const bool isDynamic1 = constraintDesc.bodyBDataIndex!=nbBodies;
+
+		PxTGSSolverContactDesc& contactDesc = context.tgsContactDescs[i];
+		PxMemZero(&contactDesc, sizeof(PxTGSSolverContactDesc));
+		contactDesc.body0				= constraintDesc.tgsBodyA;
+		contactDesc.body1				= constraintDesc.tgsBodyB;
+		contactDesc.body0TxI			= &context.txInertia[constraintDesc.bodyADataIndex];
+		contactDesc.body1TxI			= &context.txInertia[constraintDesc.bodyBDataIndex];
+		contactDesc.bodyData0			= &context.tgsBodyData[constraintDesc.bodyADataIndex];
+		contactDesc.bodyData1			= &context.tgsBodyData[constraintDesc.bodyBDataIndex];
+		contactDesc.bodyFrame0			= context.poses[constraintDesc.bodyADataIndex];
+		contactDesc.bodyFrame1			= isDynamic1 ? context.poses[constraintDesc.bodyBDataIndex] : mBodies[pair->body1].pose;
+		contactDesc.bodyState0			= PxSolverConstraintPrepDescBase::eDYNAMIC_BODY;
+		contactDesc.bodyState1			= isDynamic1 ? PxSolverConstraintPrepDescBase::eDYNAMIC_BODY : PxSolverConstraintPrepDescBase::eSTATIC_BODY;
+		contactDesc.desc				= &constraintDesc;
+		contactDesc.invMassScales.linear0 = contactDesc.invMassScales.linear1 = contactDesc.invMassScales.angular0 = contactDesc.invMassScales.angular1 = 1.0f;
+		contactDesc.shapeInteraction	= NULL;
+		contactDesc.contacts			= pair->contacts;
+		contactDesc.numContacts			= pair->nbContacts;
+		contactDesc.contactForces		= context.contactForces.begin() + contactOffset;
+		contactDesc.frictionPtr			= pair->frictions;
+		contactDesc.frictionCount		= PxU8(pair->nbFrictions);
+		contactDesc.maxCCDSeparation	= PX_MAX_F32;
+		contactDesc.maxImpulse			= PX_MAX_F32;
+		contactOffset += pair->nbContacts;
+	}
+
+	PxCreateContactConstraintsTGS(context.headers.begin(), nbHeaders, context.tgsContactDescs.begin(), context.allocator, invStepDt, invDt,
+		-mDesc.bounceThresholdVelocity, mDesc.frictionOffsetThreshold, mDesc.frictionCorrelationDistance);
+
+	for(PxU32 i=0;i<nbPairs;i++)
+	{
+		context.orderedPairs[i]->frictions = context.tgsContactDescs[i].frictionPtr;
+		context.orderedPairs[i]->nbFrictions = context.tgsContactDescs[i].frictionCount;
+	}
+
+	PxSolveConstraintsTGS(context.headers.begin(), nbHeaders, context.orderedDescs.begin(), context.tgsBodies.begin(), context.txInertia.begin(),
+		nbBodies, mDesc.nbPositionIterations, mDesc.nbVelocityIterations, stepDt, invStepDt);
+	PxIntegrateSolverBodiesTGS(context.tgsBodies.begin(), context.txInertia.begin(), context.poses.begin(), nbBodies, mDt);
+
+	const PxU32* bodyIndices = mIslandBodies.begin() + batch.bodyStart;
+	for(PxU32 i=0;i<nbBodies;i++)
+	{
+		Body& body = mBodies[bodyIndices[i]];
+		body.pose				= context.poses[i];
+		body.linearVelocity		= context.tgsBodies[i].linearVelocity;
+		body.angularVelocity	= context.tgsBodies[i].angularVelocity;
+	}
+}
+
+void ImmediateScene::solveBatch(PxU32 batchIndex)
+{
+	SolverContext& context = *mSolverContexts[batchIndex];
+	const SolverBatch& batch = mSolverBatches[batchIndex];
+
+	fillRigidBodyData(context, batch);
+	if(mDesc.solverType==PxSolverType::eTGS)
+		solveBatchTGS(context, batch);
+	else
+		solveBatchPGS(context, batch);
+}
+
+static void runNarrowPhaseBatch(void* userData, PxU32 startIndex, PxU32 endIndex)
+{
+	reinterpret_cast<ImmediateScene*>(userData)->runNarrowPhase(startIndex, endIndex);
+}
+
+static void runSolverBatches(void* userData, PxU32 startIndex, PxU32 endIndex)
+{
+	ImmediateScene* scene = reinterpret_cast<ImmediateScene*>(userData);
+	for(PxU32 i=startIndex;i<endIndex;i++)
+		scene->solveBatch(i);
+}
+
+void ImmediateScene::simulate(PxReal dt)
+{
+	PX_CHECK_AND_RETURN(dt>0.0f && PxIsFinite(dt), "PxImmediateScene::simulate: dt must be positive.");
+	mDt = dt;
+
+	updateBroadPhase();
+
+	// Recycle the pooled memory of the previous frames, see PxImmediatePairCache and ConstraintAllocator
+	const PxU32 nbPairs = mPairs.size();
+	const PxU32 nbNarrowPhaseBatches = (nbPairs + eNARROWPHASE_BATCH_SIZE - 1) / eNARROWPHASE_BATCH_SIZE;
+	mPairCache->beginFrame(PxMax(nbNarrowPhaseBatches, 1u));
+	for(PxU32 i=0;i<mSolverContexts.size();i++)
+		mSolverContexts[i]->allocator.flip();
+
+	while(mNarrowPhaseContexts.size()<nbNarrowPhaseBatches)
+		mNarrowPhaseContexts.pushBack(PX_NEW(NarrowPhaseContext));
+	Cm::parallelFor(mDesc.cpuDispatcher, nbPairs, eNARROWPHASE_BATCH_SIZE, runNarrowPhaseBatch, this);
+
+	buildIslands();
+
+	const PxU32 nbSolverBatches = mSolverBatches.size();
+	while(mSolverContexts.size()<nbSolverBatches)
+		mSolverContexts.pushBack(PX_NEW(SolverContext));
+	Cm::parallelFor(mDesc.cpuDispatcher, nbSolverBatches, 1, runSolverBatches, this);
+}
+
+PxImmediateScene* physx::PxCreateImmediateScene(const PxImmediateSceneDesc& desc)
+{
+	if(!desc.isValid())
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxCreateImmediateScene: invalid descriptor.");
+		return NULL;
+	}
+	return PX_NEW(ImmediateScene)(desc);
+}
+
+namespace
+{
+	struct SceneBatch
+	{
+		PxImmediateScene* const*	scenes;
+		PxReal						dt;
+	};
+}
+
+static void simulateScenes(void* userData, PxU32 startIndex, PxU32 endIndex)
+{
+	const SceneBatch* batch = reinterpret_cast<const SceneBatch*>(userData);
+	for(PxU32 i=startIndex;i<endIndex;i++)
+		batch->scenes[i]->simulate(batch->dt);
+}
+
+void physx::PxSimulateImmediateScenes(PxU32 nbScenes, PxImmediateScene* const* scenes, PxReal dt, PxCpuDispatcher* dispatcher)
+{
+	PX_CHECK_AND_RETURN(dt>0.0f && PxIsFinite(dt), "PxSimulateImmediateScenes: dt must be positive.");
+
+	SceneBatch batch;
+	batch.scenes	= scenes;
+	batch.dt		= dt;
+	Cm::parallelFor(dispatcher, nbScenes, 1, simulateScenes, &batch);
+}
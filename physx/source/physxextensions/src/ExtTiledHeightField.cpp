@@ -0,0 +1,913 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2024 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "extensions/PxTiledHeightField.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxIntrinsics.h"
+#include "foundation/PxMutex.h"
+#include "foundation/PxUserAllocated.h"
+#include "geometry/PxGeometryQuery.h"
+#include "geometry/PxHeightField.h"
+#include "geometry/PxHeightFieldDesc.h"
+#include "geomutils/PxContactBuffer.h"
+#include "common/PxRenderOutput.h"
+#include "cooking/PxCooking.h"
+#include "PxImmediateMode.h"
+#include "PxPhysics.h"
+
+using namespace physx;
+
+IMPLEMENT_CUSTOM_GEOMETRY_TYPE(PxTiledHeightField)
+
+namespace
+{
+	// PT: compressed samples of a page. Heights are stored relative to the page's minimum height, either as 8-bit multiples of
+	// a quantization step or as exact 16-bit offsets (step==0). The two material bytes (tess flag included) are stored once when
+	// the whole page uses the same ones, per sample otherwise. The data follows the header in the same allocation.
+	struct CompressedPage
+	{
+		PxU32	size;
+		PxI16	minHeight;
+		PxU16	step;
+		PxU8	material0;
+		PxU8	material1;
+		PxU8	uniformMaterials;
+		PxU8	pad;
+
+		PX_FORCE_INLINE	const PxU8*	getHeights()	const	{ return reinterpret_cast<const PxU8*>(this + 1);	}
+
+		PX_FORCE_INLINE	PxI16	getHeight(PxU32 i)	const
+		{
+			if(!step)
+				return PxI16(minHeight + reinterpret_cast<const PxU16*>(getHeights())[i]);
+			return PxI16(PxMin(PxI32(minHeight) + PxI32(getHeights()[i])*PxI32(step), PxI32(PX_MAX_I16)));
+		}
+
+		PX_FORCE_INLINE	const PxU8*	getMaterials(PxU32 nbSamples)	const
+		{
+			return getHeights() + (step ? nbSamples : nbSamples*2);
+		}
+	};
+
+	PX_FORCE_INLINE PxU8 getMaterialByte(const PxBitAndByte& b)	{ return PxU8(PxU8(b) | b.isBitSet());	}
+	PX_FORCE_INLINE PxBitAndByte setMaterialByte(PxU8 b)		{ return PxBitAndByte(PxU8(b & 0x7f), (b & 0x80)!=0);	}
+
+	PX_FORCE_INLINE PxHeightFieldSample getHoleSample()
+	{
+		PxHeightFieldSample s;
+		s.height = 0;
+		s.materialIndex0 = PxBitAndByte(PxHeightFieldMaterial::eHOLE);
+		s.materialIndex1 = PxBitAndByte(PxHeightFieldMaterial::eHOLE);
+		return s;
+	}
+
+	CompressedPage* compressPage(const PxHeightFieldSample* samples, PxU32 nbSamples, PxU16 tolerance)
+	{
+		PxI32 minHeight = PX_MAX_I32;
+		PxI32 maxHeight = -PX_MAX_I32;
+		bool uniformMaterials = true;
+		const PxU8 material0 = getMaterialByte(samples[0].materialIndex0);
+		const PxU8 material1 = getMaterialByte(samples[0].materialIndex1);
+		for(PxU32 i=0; i<nbSamples; i++)
+		{
+			minHeight = PxMin(minHeight, PxI32(samples[i].height));
+			maxHeight = PxMax(maxHeight, PxI32(samples[i].height));
+			if(getMaterialByte(samples[i].materialIndex0)!=material0 || getMaterialByte(samples[i].materialIndex1)!=material1)
+				uniformMaterials = false;
+		}
+
+		// PT: smallest step fitting the page's range in 8 bits. The rounding error is at most step/2.
+		const PxU32 range = PxU32(maxHeight - minHeight);
+		const PxU32 step8 = range ? (range + 254)/255 : 1;
+		const PxU32 step = step8/2 <= tolerance ? step8 : 0;
+
+		const PxU32 heightBytes = step ? nbSamples : nbSamples*2;
+		const PxU32 materialBytes = uniformMaterials ? 0 : nbSamples*2;
+		const PxU32 size = PxU32(sizeof(CompressedPage)) + heightBytes + materialBytes;
+
+		CompressedPage* page = reinterpret_cast<CompressedPage*>(PX_ALLOC(size, "CompressedPage"));
+		page->size				= size;
+		page->minHeight			= PxI16(minHeight);
+		page->step				= PxU16(step);
+		page->material0			= material0;
+		page->material1			= material1;
+		page->uniformMaterials	= PxU8(uniformMaterials);
+		page->pad				= 0;
+
+		PxU8* heights = reinterpret_cast<PxU8*>(page + 1);
+		if(step)
+		{
+			for(PxU32 i=0; i<nbSamples; i++)
+				heights[i] = PxU8((PxU32(samples[i].height - minHeight) + step/2)/step);
+		}
+		else
+		{
+			PxU16* heights16 = reinterpret_cast<PxU16*>(heights);
+			for(PxU32 i=0; i<nbSamples; i++)
+				heights16[i] = PxU16(samples[i].height - minHeight);
+		}
+
+		if(!uniformMaterials)
+		{
+			PxU8* materials = heights + heightBytes;
+			for(PxU32 i=0; i<nbSamples; i++)
+			{
+				materials[i*2+0] = getMaterialByte(samples[i].materialIndex0);
+				materials[i*2+1] = getMaterialByte(samples[i].materialIndex1);
+			}
+		}
+		return page;
+	}
+
+	struct Page
+	{
+		enum Flags
+		{
+			eLOADED			= (1<<0),	// Samples are known: either compressed is set, or the page has no data
+			eFROM_SOURCE	= (1<<1),	// Samples come from the page source and can be released
+			eDECODED		= (1<<2),	// heightField is up-to-date, NULL for pages without data
+			eTRACKED		= (1<<3)	// Page is in mTrackedPages
+		};
+
+		CompressedPage*	compressed;
+		PxHeightField*	heightField;
+		PxU32			lastUsed;
+		PxU32			flags;
+	};
+
+	// PT: decoded page, i.e. the heightfield of a page with its ring of neighbour cells, and where it sits in the terrain.
+	struct DecodedPage
+	{
+		PxHeightField*	heightField;
+		PxU32			pageRow;
+		PxU32			pageColumn;
+		PxU32			firstRow;
+		PxU32			firstColumn;
+	};
+
+	class TiledHeightField : public PxTiledHeightField, public PxUserAllocated
+	{
+		public:
+									TiledHeightField(PxPhysics& physics, const PxTiledHeightFieldDesc& desc);
+		virtual						~TiledHeightField();
+
+		// PxCustomGeometry::Callbacks
+		virtual	PxBounds3			getLocalBounds(const PxGeometry& geometry)	const	PX_OVERRIDE;
+		virtual	bool				generateContacts(const PxGeometry& geom0, const PxGeometry& geom1, const PxTransform& pose0, const PxTransform& pose1,
+										const PxReal contactDistance, const PxReal meshContactMargin, const PxReal toleranceLength,
+										PxContactBuffer& contactBuffer)	const	PX_OVERRIDE;
+		virtual	PxU32				raycast(const PxVec3& origin, const PxVec3& unitDir, const PxGeometry& geom, const PxTransform& pose,
+										PxReal maxDist, PxHitFlags hitFlags, PxU32 maxHits, PxGeomRaycastHit* rayHits, PxU32 stride, PxRaycastThreadContext* threadContext)	const	PX_OVERRIDE;
+		virtual	bool				overlap(const PxGeometry& geom0, const PxTransform& pose0, const PxGeometry& geom1, const PxTransform& pose1, PxOverlapThreadContext* threadContext)	const	PX_OVERRIDE;
+		virtual	bool				sweep(const PxVec3& unitDir, const PxReal maxDist,
+										const PxGeometry& geom0, const PxTransform& pose0, const PxGeometry& geom1, const PxTransform& pose1,
+										PxGeomSweepHit& sweepHit, PxHitFlags hitFlags, const PxReal inflation, PxSweepThreadContext* threadContext)	const	PX_OVERRIDE;
+		virtual	void				visualize(const PxGeometry& geometry, PxRenderOutput& out, const PxTransform& absPose, const PxBounds3& cullbox)	const	PX_OVERRIDE;
+		virtual	void				computeMassProperties(const PxGeometry& geometry, PxMassProperties& massProperties)	const	PX_OVERRIDE;
+		virtual	bool				usePersistentContactManifold(const PxGeometry& geometry, PxReal& breakingThreshold)	const	PX_OVERRIDE;
+		//~PxCustomGeometry::Callbacks
+
+		// PxTiledHeightField
+		virtual	bool				setPage(PxU32 pageRow, PxU32 pageColumn, const PxHeightFieldSample* samples)	PX_OVERRIDE;
+		virtual	PxHeightFieldSample	getSample(PxU32 row, PxU32 column)	const	PX_OVERRIDE;
+		virtual	void				prefetch(const PxBounds3& localBounds)	PX_OVERRIDE;
+		virtual	void				update()	PX_OVERRIDE;
+		virtual	void				getStats(PxTiledHeightFieldStats& stats)	const	PX_OVERRIDE;
+		virtual	const PxTiledHeightFieldDesc&	getDesc()	const	PX_OVERRIDE	{ return mDesc;	}
+		virtual	void				release()	PX_OVERRIDE;
+		//~PxTiledHeightField
+
+		private:
+				PxPhysics&					mPhysics;
+				const PxTiledHeightFieldDesc	mDesc;
+				const PxU32					mNbRows;
+				const PxU32					mNbColumns;
+				PxU32						mUpdateCount;
+
+				// PT: pages are loaded and decoded lazily from const query callbacks, possibly from several threads at the same
+				// time. Loading and decoding are serialized by mLock, and a decoded page is then read without locking.
+		mutable	PxMutex						mLock;
+		mutable	PxArray<Page>				mPages;
+		mutable	PxArray<PxU32>				mTrackedPages;
+		mutable	PxArray<PxHeightFieldSample>	mLoadBuffer;
+		mutable	PxArray<PxHeightFieldSample>	mDecodeBuffer;
+		mutable	PxU32						mNbCompressedPages;
+		mutable	PxU32						mNbDecodedPages;
+		mutable	PxU64						mCompressedBytes;
+		mutable	PxU64						mDecodedBytes;
+
+		PX_FORCE_INLINE	PxU32	getPageIndex(PxU32 pageRow, PxU32 pageColumn)	const	{ return pageRow*mDesc.nbPageColumns + pageColumn;	}
+
+				bool				getPageRange(const PxBounds3& localBounds, PxU32& pageRow0, PxU32& pageRow1, PxU32& pageColumn0, PxU32& pageColumn1)	const;
+				bool				getDecodedPage(PxU32 pageRow, PxU32 pageColumn, DecodedPage& decoded)	const;
+				PxTransform			getPagePose(const PxTransform& pose, const DecodedPage& decoded)	const;
+				PxHeightFieldGeometry	getPageGeometry(const DecodedPage& decoded)	const;
+				bool				isOwnedTriangle(const DecodedPage& decoded, PxU32 triangleIndex)	const;
+				PxU32				getGlobalTriangle(const DecodedPage& decoded, PxU32 triangleIndex)	const;
+
+				// Must be called with mLock held
+				void				trackPage(PxU32 pageIndex)	const;
+				void				loadPage(PxU32 pageRow, PxU32 pageColumn)	const;
+				void				decodePage(PxU32 pageRow, PxU32 pageColumn)	const;
+				void				decodeSamples(PxU32 pageRow, PxU32 pageColumn, PxU32 row0, PxU32 row1, PxU32 column0, PxU32 column1, PxHeightFieldSample* dst, PxU32 dstStride)	const;
+				void				releaseCompressed(Page& page)	const;
+				void				releaseDecoded(Page& page)	const;
+	};
+}
+
+TiledHeightField::TiledHeightField(PxPhysics& physics, const PxTiledHeightFieldDesc& desc) :
+	mPhysics			(physics),
+	mDesc				(desc),
+	mNbRows				(desc.nbPageRows*desc.pageSize),
+	mNbColumns			(desc.nbPageColumns*desc.pageSize),
+	mUpdateCount		(0),
+	mNbCompressedPages	(0),
+	mNbDecodedPages		(0),
+	mCompressedBytes	(0),
+	mDecodedBytes		(0)
+{
+	Page empty;
+	empty.compressed	= NULL;
+	empty.heightField	= NULL;
+	empty.lastUsed		= 0;
+	empty.flags			= 0;
+	mPages.resize(desc.nbPageRows*desc.nbPageColumns, empty);
+}
+
+TiledHeightField::~TiledHeightField()
+{
+	const PxU32 nbPages = mPages.size();
+	for(PxU32 i=0; i<nbPages; i++)
+	{
+		releaseDecoded(mPages[i]);
+		releaseCompressed(mPages[i]);
+	}
+}
+
+void TiledHeightField::release()
+{
+	PX_DELETE_THIS;
+}
+
+void TiledHeightField::releaseCompressed(Page& page) const
+{
+	if(page.compressed)
+	{
+		mNbCompressedPages--;
+		mCompressedBytes -= page.compressed->size;
+		PX_FREE(page.compressed);
+	}
+	page.flags &= ~(Page::eLOADED|Page::eFROM_SOURCE);
+}
+
+void TiledHeightField::releaseDecoded(Page& page) const
+{
+	if(page.heightField)
+	{
+		mNbDecodedPages--;
+		mDecodedBytes -= PxU64(page.heightField->getNbRows())*page.heightField->getNbColumns()*sizeof(PxHeightFieldSample);
+		page.heightField->release();
+		page.heightField = NULL;
+	}
+	page.flags &= ~Page::eDECODED;
+}
+
+void TiledHeightField::trackPage(PxU32 pageIndex) const
+{
+	Page& page = mPages[pageIndex];
+	if(!(page.flags & Page::eTRACKED))
+	{
+		page.flags |= Page::eTRACKED;
+		mTrackedPages.pushBack(pageIndex);
+	}
+}
+
+void TiledHeightField::loadPage(PxU32 pageRow, PxU32 pageColumn) const
+{
+	const PxU32 pageIndex = getPageIndex(pageRow, pageColumn);
+	Page& page = mPages[pageIndex];
+	page.lastUsed = mUpdateCount;
+	if(page.flags & Page::eLOADED)
+		return;
+
+	page.flags |= Page::eLOADED;
+	if(!mDesc.source)
+		return;
+
+	page.flags |= Page::eFROM_SOURCE;
+	trackPage(pageIndex);
+
+	const PxU32 nbSamples = mDesc.pageSize*mDesc.pageSize;
+	mLoadBuffer.resizeUninitialized(nbSamples);
+	if(mDesc.source->loadPage(pageRow, pageColumn, mLoadBuffer.begin()))
+	{
+		page.compressed = compressPage(mLoadBuffer.begin(), nbSamples, mDesc.heightTolerance);
+		mNbCompressedPages++;
+		mCompressedBytes += page.compressed->size;
+	}
+}
+
+void TiledHeightField::decodeSamples(PxU32 pageRow, PxU32 pageColumn, PxU32 row0, PxU32 row1, PxU32 column0, PxU32 column1, PxHeightFieldSample* dst, PxU32 dstStride) const
+{
+	loadPage(pageRow, pageColumn);
+
+	const CompressedPage* compressed = mPages[getPageIndex(pageRow, pageColumn)].compressed;
+	if(!compressed)
+	{
+		const PxHeightFieldSample hole = getHoleSample();
+		for(PxU32 r=row0; r<row1; r++)
+			for(PxU32 c=column0; c<column1; c++)
+				dst[(r-row0)*dstStride + c - column0] = hole;
+		return;
+	}
+
+	const PxU32 pageSize = mDesc.pageSize;
+	const PxU8* materials = compressed->uniformMaterials ? NULL : compressed->getMaterials(pageSize*pageSize);
+	for(PxU32 r=row0; r<row1; r++)
+	{
+		PxHeightFieldSample* PX_RESTRICT out = dst + (r-row0)*dstStride;
+		for(PxU32 c=column0; c<column1; c++)
+		{
+			const PxU32 i = r*pageSize + c;
+			out->height = compressed->getHeight(i);
+			out->materialIndex0 = setMaterialByte(materials ? materials[i*2+0] : compressed->material0);
+			out->materialIndex1 = setMaterialByte(materials ? materials[i*2+1] : compressed->material1);
+			out++;
+		}
+	}
+}
+
+void TiledHeightField::decodePage(PxU32 pageRow, PxU32 pageColumn) const
+{
+	const PxU32 pageIndex = getPageIndex(pageRow, pageColumn);
+	Page& page = mPages[pageIndex];
+	PX_ASSERT(!(page.flags & Page::eDECODED));
+
+	loadPage(pageRow, pageColumn);
+	page.flags |= Page::eDECODED;
+	trackPage(pageIndex);
+	if(!page.compressed)
+		return;
+
+	// PT: the page's heightfield covers its own cells plus one ring of cells from the neighbour pages. The ring makes edges
+	// along the seams convex or concave exactly as in a single heightfield. Contacts and hits on ring triangles are discarded,
+	// since the neighbour pages own them.
+	const PxU32 pageSize = mDesc.pageSize;
+	const PxU32 firstRow = pageRow ? pageRow*pageSize - 1 : 0;
+	const PxU32 firstColumn = pageColumn ? pageColumn*pageSize - 1 : 0;
+	const PxU32 lastRow = PxMin((pageRow+1)*pageSize + 1, mNbRows - 1);
+	const PxU32 lastColumn = PxMin((pageColumn+1)*pageSize + 1, mNbColumns - 1);
+	const PxU32 nbRows = lastRow - firstRow + 1;
+	const PxU32 nbColumns = lastColumn - firstColumn + 1;
+
+	mDecodeBuffer.resizeUninitialized(nbRows*nbColumns);
+	for(PxU32 pr=firstRow/pageSize; pr<=lastRow/pageSize; pr++)
+	{
+		const PxU32 r0 = PxMax(firstRow, pr*pageSize);
+		const PxU32 r1 = PxMin(lastRow + 1, (pr+1)*pageSize);
+		for(PxU32 pc=firstColumn/pageSize; pc<=lastColumn/pageSize; pc++)
+		{
+			const PxU32 c0 = PxMax(firstColumn, pc*pageSize);
+			const PxU32 c1 = PxMin(lastColumn + 1, (pc+1)*pageSize);
+			decodeSamples(pr, pc, r0 - pr*pageSize, r1 - pr*pageSize, c0 - pc*pageSize, c1 - pc*pageSize,
+				mDecodeBuffer.begin() + (r0 - firstRow)*nbColumns + c0 - firstColumn, nbColumns);
+		}
+	}
+
+	PxHeightFieldDesc hfDesc;
+	hfDesc.nbRows			= nbRows;
+	hfDesc.nbColumns		= nbColumns;
+	hfDesc.samples.data		= mDecodeBuffer.begin();
+	hfDesc.samples.stride	= sizeof(PxHeightFieldSample);
+	PxHeightField* heightField = PxCreateHeightField(hfDesc, mPhysics.getPhysicsInsertionCallback());
+	if(!heightField)
+		return;
+
+	mNbDecodedPages++;
+	mDecodedBytes += PxU64(nbRows)*nbColumns*sizeof(PxHeightFieldSample);
+
+	// PT: published last, readers access decoded pages without locking
+	PxMemoryBarrier();
+	page.heightField = heightField;
+}
+
+bool TiledHeightField::getDecodedPage(PxU32 pageRow, PxU32 pageColumn, DecodedPage& decoded) const
+{
+	Page& page = mPages[getPageIndex(pageRow, pageColumn)];
+	page.lastUsed = mUpdateCount;
+
+	PxHeightField* heightField = page.heightField;
+	if(!heightField)
+	{
+		PxMutex::ScopedLock lock(mLock);
+		if(!(page.flags & Page::eDECODED))
+			decodePage(pageRow, pageColumn);
+		heightField = page.heightField;
+		if(!heightField)
+			return false;
+	}
+
+	const PxU32 pageSize = mDesc.pageSize;
+	decoded.heightField	= heightField;
+	decoded.pageRow		= pageRow;
+	decoded.pageColumn	= pageColumn;
+	decoded.firstRow	= pageRow ? pageRow*pageSize - 1 : 0;
+	decoded.firstColumn	= pageColumn ? pageColumn*pageSize - 1 : 0;
+	return true;
+}
+
+PxTransform TiledHeightField::getPagePose(const PxTransform& pose, const DecodedPage& decoded) const
+{
+	const PxVec3 offset(PxReal(decoded.firstRow)*mDesc.rowScale, 0.0f, PxReal(decoded.firstColumn)*mDesc.columnScale);
+	return PxTransform(pose.transform(offset), pose.q);
+}
+
+PxHeightFieldGeometry TiledHeightField::getPageGeometry(const DecodedPage& decoded) const
+{
+	return PxHeightFieldGeometry(decoded.heightField, PxMeshGeometryFlags(), mDesc.heightScale, mDesc.rowScale, mDesc.columnScale);
+}
+
+bool TiledHeightField::isOwnedTriangle(const DecodedPage& decoded, PxU32 triangleIndex) const
+{
+	const PxU32 cell = triangleIndex>>1;
+	const PxU32 nbColumns = decoded.heightField->getNbColumns();
+	const PxU32 row = decoded.firstRow + cell/nbColumns;
+	const PxU32 column = decoded.firstColumn + cell%nbColumns;
+	return row/mDesc.pageSize==decoded.pageRow && column/mDesc.pageSize==decoded.pageColumn;
+}
+
+PxU32 TiledHeightField::getGlobalTriangle(const DecodedPage& decoded, PxU32 triangleIndex) const
+{
+	const PxU32 cell = triangleIndex>>1;
+	const PxU32 nbColumns = decoded.heightField->getNbColumns();
+	const PxU32 row = decoded.firstRow + cell/nbColumns;
+	const PxU32 column = decoded.firstColumn + cell%nbColumns;
+	return ((row*mNbColumns + column)<<1) | (triangleIndex & 1);
+}
+
+bool TiledHeightField::getPageRange(const PxBounds3& localBounds, PxU32& pageRow0, PxU32& pageRow1, PxU32& pageColumn0, PxU32& pageColumn1) const
+{
+	const PxReal maxX = PxReal(mNbRows - 1)*mDesc.rowScale;
+	const PxReal maxZ = PxReal(mNbColumns - 1)*mDesc.columnScale;
+	if(localBounds.isEmpty() || localBounds.maximum.x<0.0f || localBounds.maximum.z<0.0f || localBounds.minimum.x>maxX || localBounds.minimum.z>maxZ)
+		return false;
+
+	// PT: cells touched by the bounds, then pages owning these cells
+	const PxReal lastCellRow = PxReal(mNbRows - 2);
+	const PxReal lastCellColumn = PxReal(mNbColumns - 2);
+	const PxU32 row0 = PxU32(PxClamp(localBounds.minimum.x/mDesc.rowScale, 0.0f, lastCellRow));
+	const PxU32 row1 = PxU32(PxClamp(localBounds.maximum.x/mDesc.rowScale, 0.0f, lastCellRow));
+	const PxU32 column0 = PxU32(PxClamp(localBounds.minimum.z/mDesc.columnScale, 0.0f, lastCellColumn));
+	const PxU32 column1 = PxU32(PxClamp(localBounds.maximum.z/mDesc.columnScale, 0.0f, lastCellColumn));
+	pageRow0 = row0/mDesc.pageSize;
+	pageRow1 = row1/mDesc.pageSize;
+	pageColumn0 = column0/mDesc.pageSize;
+	pageColumn1 = column1/mDesc.pageSize;
+	return true;
+}
+
+PxBounds3 TiledHeightField::getLocalBounds(const PxGeometry&) const
+{
+	// PT: heights of pages that are not loaded yet are unknown, so the bounds cover the whole range of the samples
+	const PxReal minY = PxReal(-PX_MAX_I16 - 1)*mDesc.heightScale;
+	const PxReal maxY = PxReal(PX_MAX_I16)*mDesc.heightScale;
+	return PxBounds3(PxVec3(0.0f, minY, 0.0f), PxVec3(PxReal(mNbRows - 1)*mDesc.rowScale, maxY, PxReal(mNbColumns - 1)*mDesc.columnScale));
+}
+
+bool TiledHeightField::generateContacts(const PxGeometry&, const PxGeometry& geom1, const PxTransform& pose0, const PxTransform& pose1,
+	const PxReal contactDistance, const PxReal meshContactMargin, const PxReal toleranceLength, PxContactBuffer& contactBuffer) const
+{
+	const PxGeometryType::Enum type = geom1.getType();
+	if(type!=PxGeometryType::eSPHERE && type!=PxGeometryType::eCAPSULE && type!=PxGeometryType::eBOX && type!=PxGeometryType::eCONVEXMESH)
+		return false;
+
+	PxBounds3 localBounds;
+	PxGeometryQuery::computeGeomBounds(localBounds, geom1, pose0.transformInv(pose1), contactDistance, 1.0f, PxGeometryQueryFlags(0));
+
+	PxU32 pageRow0, pageRow1, pageColumn0, pageColumn1;
+	if(!getPageRange(localBounds, pageRow0, pageRow1, pageColumn0, pageColumn1))
+		return false;
+
+	struct PageContactRecorder : immediate::PxContactRecorder
+	{
+		const TiledHeightField&	mOwner;
+		const DecodedPage&		mPage;
+		PxContactBuffer&		mContactBuffer;
+
+		PageContactRecorder(const TiledHeightField& owner, const DecodedPage& page, PxContactBuffer& contactBuffer) :
+			mOwner(owner), mPage(page), mContactBuffer(contactBuffer)	{}
+
+		virtual bool recordContacts(const PxContactPoint* contactPoints, PxU32 nbContacts, PxU32)
+		{
+			for(PxU32 i=0; i<nbContacts; i++)
+			{
+				// PT: contacts against the ring cells are generated by the pages owning them
+				if(!mOwner.isOwnedTriangle(mPage, contactPoints[i].internalFaceIndex1))
+					continue;
+
+				PxContactPoint contact = contactPoints[i];
+				contact.normal = -contact.normal;
+				contact.internalFaceIndex1 = mOwner.getGlobalTriangle(mPage, contact.internalFaceIndex1);
+				mContactBuffer.contact(contact);
+			}
+			return true;
+		}
+		PX_NOCOPY(PageContactRecorder)
+	};
+
+	// PT: each page is a separate pair for the immediate-mode contact generation, with a throw-away cache. Persistency is
+	// handled by the multi-manifold of the custom geometry pair instead (see usePersistentContactManifold).
+	// Large manifolds don't fit in the stack buffer and go to the heap, released after each page.
+	struct ContactCacheAllocator : PxCacheAllocator
+	{
+		PxU8	buffer[4096];
+		PxU8*	heapBuffer;
+
+		ContactCacheAllocator() : heapBuffer(NULL)	{}
+		~ContactCacheAllocator()					{ releaseHeapBuffer();	}
+
+		virtual PxU8* allocateCacheData(const PxU32 byteSize)
+		{
+			if(size_t(byteSize) + 15 <= sizeof(buffer))
+				return reinterpret_cast<PxU8*>(size_t(buffer + 15) & ~size_t(15));
+
+			releaseHeapBuffer();
+			heapBuffer = reinterpret_cast<PxU8*>(PX_ALLOC(size_t(byteSize) + 15, "ContactCacheAllocator"));
+			return heapBuffer ? reinterpret_cast<PxU8*>(size_t(heapBuffer + 15) & ~size_t(15)) : NULL;
+		}
+
+		void releaseHeapBuffer()
+		{
+			PX_FREE(heapBuffer);
+		}
+	}
+	contactCacheAllocator;
+
+	for(PxU32 pageRow=pageRow0; pageRow<=pageRow1; pageRow++)
+	{
+		for(PxU32 pageColumn=pageColumn0; pageColumn<=pageColumn1; pageColumn++)
+		{
+			DecodedPage decoded;
+			if(!getDecodedPage(pageRow, pageColumn, decoded))
+				continue;
+
+			const PxHeightFieldGeometry pageGeom = getPageGeometry(decoded);
+			const PxTransform pagePose = getPagePose(pose0, decoded);
+			const PxGeometry* pGeom0 = &geom1;
+			const PxGeometry* pGeom1 = &pageGeom;
+
+			PxCache contactCache;
+			PageContactRecorder contactRecorder(*this, decoded, contactBuffer);
+			immediate::PxGenerateContacts(&pGeom0, &pGeom1, &pose1, &pagePose, &contactCache, 1, contactRecorder,
+				contactDistance, meshContactMargin, toleranceLength, contactCacheAllocator);
+			contactCacheAllocator.releaseHeapBuffer();
+		}
+	}
+	return contactBuffer.count > 0;
+}
+
+PxU32 TiledHeightField::raycast(const PxVec3& origin, const PxVec3& unitDir, const PxGeometry&, const PxTransform& pose,
+	PxReal maxDist, PxHitFlags hitFlags, PxU32 maxHits, PxGeomRaycastHit* rayHits, PxU32 stride, PxRaycastThreadContext* threadContext) const
+{
+	// PT: clip the ray against the terrain's footprint, in local space
+	const PxVec3 localOrigin = pose.transformInv(origin);
+	const PxVec3 localDir = pose.rotateInv(unitDir);
+	const PxReal extents[2] = { PxReal(mNbRows - 1)*mDesc.rowScale, PxReal(mNbColumns - 1)*mDesc.columnScale };
+	const PxReal o[2] = { localOrigin.x, localOrigin.z };
+	const PxReal d[2] = { localDir.x, localDir.z };
+	PxReal tMin = 0.0f;
+	PxReal tMax = maxDist;
+	for(PxU32 a=0; a<2; a++)
+	{
+		if(PxAbs(d[a])<1e-9f)
+		{
+			if(o[a]<0.0f || o[a]>extents[a])
+				return 0;
+		}
+		else
+		{
+			PxReal t0 = -o[a]/d[a];
+			PxReal t1 = (extents[a] - o[a])/d[a];
+			if(t0>t1)
+				PxSwap(t0, t1);
+			tMin = PxMax(tMin, t0);
+			tMax = PxMin(tMax, t1);
+		}
+	}
+	if(tMin>tMax)
+		return 0;
+
+	// PT: walk the pages along the ray. Pages are visited in ray order, so without eMESH_MULTIPLE the first page with an
+	// owned hit contains the closest hit.
+	const bool multipleHits = (hitFlags & PxHitFlag::eMESH_MULTIPLE) && maxHits>1;
+	const PxReal pageExtents[2] = { PxReal(mDesc.pageSize)*mDesc.rowScale, PxReal(mDesc.pageSize)*mDesc.columnScale };
+	const PxI32 nbPages[2] = { PxI32(mDesc.nbPageRows), PxI32(mDesc.nbPageColumns) };
+	PxI32 page[2];
+	PxI32 step[2];
+	PxReal tNext[2];
+	PxReal tDelta[2];
+	for(PxU32 a=0; a<2; a++)
+	{
+		const PxReal p = o[a] + d[a]*tMin;
+		page[a] = PxClamp(PxI32(PxFloor(p/pageExtents[a])), 0, nbPages[a] - 1);
+		if(PxAbs(d[a])<1e-9f)
+		{
+			step[a] = 0;
+			tNext[a] = tDelta[a] = PX_MAX_F32;
+		}
+		else
+		{
+			step[a] = d[a]>0.0f ? 1 : -1;
+			tNext[a] = (PxReal(page[a] + (step[a]>0 ? 1 : 0))*pageExtents[a] - o[a])/d[a];
+			tDelta[a] = pageExtents[a]/PxAbs(d[a]);
+		}
+	}
+
+	PxU32 nbHits = 0;
+	PxU8* hitBuffer = reinterpret_cast<PxU8*>(rayHits);
+	for(;;)
+	{
+		DecodedPage decoded;
+		if(getDecodedPage(PxU32(page[0]), PxU32(page[1]), decoded))
+		{
+			const PxHeightFieldGeometry pageGeom = getPageGeometry(decoded);
+			const PxTransform pagePose = getPagePose(pose, decoded);
+			const PxU32 firstHit = nbHits;
+			PxGeomRaycastHit* pageHits = reinterpret_cast<PxGeomRaycastHit*>(hitBuffer + firstHit*stride);
+			const PxU32 nbPageHits = PxGeometryQuery::raycast(origin, unitDir, pageGeom, pagePose, maxDist, hitFlags, maxHits - firstHit,
+				pageHits, stride, PxGeometryQueryFlags(0), threadContext);
+
+			for(PxU32 i=0; i<nbPageHits; i++)
+			{
+				const PxGeomRaycastHit& hit = *reinterpret_cast<const PxGeomRaycastHit*>(hitBuffer + (firstHit + i)*stride);
+				if(!isOwnedTriangle(decoded, hit.faceIndex))
+					continue;
+				const PxU32 faceIndex = getGlobalTriangle(decoded, hit.faceIndex);
+				PxGeomRaycastHit& dst = *reinterpret_cast<PxGeomRaycastHit*>(hitBuffer + nbHits*stride);
+				dst = hit;
+				dst.faceIndex = faceIndex;
+				nbHits++;
+			}
+		}
+
+		if(nbHits==maxHits || (nbHits && !multipleHits))
+			break;
+
+		const PxU32 a = tNext[0]<tNext[1] ? 0u : 1u;
+		if(tNext[a]>tMax)
+			break;
+		page[a] += step[a];
+		if(page[a]<0 || page[a]>=nbPages[a])
+			break;
+		tNext[a] += tDelta[a];
+	}
+	return nbHits;
+}
+
+bool TiledHeightField::overlap(const PxGeometry&, const PxTransform& pose0, const PxGeometry& geom1, const PxTransform& pose1, PxOverlapThreadContext* threadContext) const
+{
+	PxBounds3 localBounds;
+	PxGeometryQuery::computeGeomBounds(localBounds, geom1, pose0.transformInv(pose1), 0.0f, 1.0f, PxGeometryQueryFlags(0));
+
+	PxU32 pageRow0, pageRow1, pageColumn0, pageColumn1;
+	if(!getPageRange(localBounds, pageRow0, pageRow1, pageColumn0, pageColumn1))
+		return false;
+
+	for(PxU32 pageRow=pageRow0; pageRow<=pageRow1; pageRow++)
+	{
+		for(PxU32 pageColumn=pageColumn0; pageColumn<=pageColumn1; pageColumn++)
+		{
+			DecodedPage decoded;
+			if(getDecodedPage(pageRow, pageColumn, decoded)
+				&& PxGeometryQuery::overlap(geom1, pose1, getPageGeometry(decoded), getPagePose(pose0, decoded), PxGeometryQueryFlags(0), threadContext))
+				return true;
+		}
+	}
+	return false;
+}
+
+bool TiledHeightField::sweep(const PxVec3& unitDir, const PxReal maxDist, const PxGeometry&, const PxTransform& pose0, const PxGeometry& geom1, const PxTransform& pose1,
+	PxGeomSweepHit& sweepHit, PxHitFlags hitFlags, const PxReal inflation, PxSweepThreadContext* threadContext) const
+{
+	const PxTransform localPose1 = pose0.transformInv(pose1);
+	PxBounds3 localBounds;
+	PxGeometryQuery::computeGeomBounds(localBounds, geom1, localPose1, inflation, 1.0f, PxGeometryQueryFlags(0));
+	const PxVec3 localMotion = pose0.rotateInv(unitDir)*maxDist;
+	localBounds.include(localBounds.minimum + localMotion);
+	localBounds.include(localBounds.maximum + localMotion);
+
+	PxU32 pageRow0, pageRow1, pageColumn0, pageColumn1;
+	if(!getPageRange(localBounds, pageRow0, pageRow1, pageColumn0, pageColumn1))
+		return false;
+
+	// PT: closest hit over the touched pages. Hits on ring triangles are kept, they are the same as in the owning page.
+	bool status = false;
+	for(PxU32 pageRow=pageRow0; pageRow<=pageRow1; pageRow++)
+	{
+		for(PxU32 pageColumn=pageColumn0; pageColumn<=pageColumn1; pageColumn++)
+		{
+			DecodedPage decoded;
+			if(!getDecodedPage(pageRow, pageColumn, decoded))
+				continue;
+
+			PxGeomSweepHit hit;
+			if(PxGeometryQuery::sweep(unitDir, maxDist, geom1, pose1, getPageGeometry(decoded), getPagePose(pose0, decoded), hit, hitFlags, inflation, PxGeometryQueryFlags(0), threadContext)
+				&& (!status || hit.distance<sweepHit.distance))
+			{
+				sweepHit = hit;
+				sweepHit.faceIndex = getGlobalTriangle(decoded, hit.faceIndex);
+				status = true;
+			}
+		}
+	}
+	return status;
+}
+
+void TiledHeightField::visualize(const PxGeometry&, PxRenderOutput& out, const PxTransform& absPose, const PxBounds3& cullbox) const
+{
+	// PT: only decoded pages are drawn, i.e. the pages currently used around the objects touching the terrain
+	PxU32 pageRow0 = 0, pageRow1 = mDesc.nbPageRows - 1, pageColumn0 = 0, pageColumn1 = mDesc.nbPageColumns - 1;
+	if(!cullbox.isEmpty() && !getPageRange(PxBounds3::transformFast(absPose.getInverse(), cullbox), pageRow0, pageRow1, pageColumn0, pageColumn1))
+		return;
+
+	out << PxU32(PxDebugColor::eARGB_MAGENTA);
+	out << absPose;
+
+	const PxU32 pageSize = mDesc.pageSize;
+	for(PxU32 pageRow=pageRow0; pageRow<=pageRow1; pageRow++)
+	{
+		for(PxU32 pageColumn=pageColumn0; pageColumn<=pageColumn1; pageColumn++)
+		{
+			const PxHeightField* heightField = mPages[getPageIndex(pageRow, pageColumn)].heightField;
+			if(!heightField)
+				continue;
+
+			const PxU32 firstRow = pageRow ? pageRow*pageSize - 1 : 0;
+			const PxU32 firstColumn = pageColumn ? pageColumn*pageSize - 1 : 0;
+			const PxU32 row0 = pageRow*pageSize - firstRow;
+			const PxU32 column0 = pageColumn*pageSize - firstColumn;
+			const PxU32 row1 = PxMin(row0 + pageSize, heightField->getNbRows() - 1);
+			const PxU32 column1 = PxMin(column0 + pageSize, heightField->getNbColumns() - 1);
+			for(PxU32 r=row0; r<row1; r++)
+			{
+				for(PxU32 c=column0; c<column1; c++)
+				{
+					const PxHeightFieldSample& s = heightField->getSample(r, c);
+					if(s.materialIndex0==PxHeightFieldMaterial::eHOLE && s.materialIndex1==PxHeightFieldMaterial::eHOLE)
+						continue;
+
+					PxVec3 v[4];
+					for(PxU32 j=0; j<4; j++)
+					{
+						const PxU32 vr = r + (j&1);
+						const PxU32 vc = c + (j>>1);
+						v[j] = PxVec3(PxReal(firstRow + vr)*mDesc.rowScale, PxReal(heightField->getSample(vr, vc).height)*mDesc.heightScale, PxReal(firstColumn + vc)*mDesc.columnScale);
+					}
+					out.outputSegment(v[0], v[1]);
+					out.outputSegment(v[0], v[2]);
+					if(s.tessFlag())
+						out.outputSegment(v[0], v[3]);
+					else
+						out.outputSegment(v[1], v[2]);
+				}
+			}
+		}
+	}
+}
+
+void TiledHeightField::computeMassProperties(const PxGeometry&, PxMassProperties&) const
+{
+	// PT: terrains are static
+}
+
+bool TiledHeightField::usePersistentContactManifold(const PxGeometry&, PxReal&) const
+{
+	// PT: regenerating contacts means looking up pages and running the heightfield contact generation for each of them, so
+	// let the custom geometry pair keep a multi-manifold like for regular heightfields.
+	return true;
+}
+
+bool TiledHeightField::setPage(PxU32 pageRow, PxU32 pageColumn, const PxHeightFieldSample* samples)
+{
+	if(pageRow>=mDesc.nbPageRows || pageColumn>=mDesc.nbPageColumns || !samples)
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxTiledHeightField::setPage: invalid parameters.");
+		return false;
+	}
+
+	PxMutex::ScopedLock lock(mLock);
+
+	Page& page = mPages[getPageIndex(pageRow, pageColumn)];
+	releaseCompressed(page);
+	page.compressed = compressPage(samples, mDesc.pageSize*mDesc.pageSize, mDesc.heightTolerance);
+	page.flags |= Page::eLOADED;
+	mNbCompressedPages++;
+	mCompressedBytes += page.compressed->size;
+
+	// PT: the decoded neighbours contain a ring of this page's samples
+	for(PxU32 pr=PxMax(pageRow, 1u)-1; pr<=PxMin(pageRow+1, mDesc.nbPageRows-1); pr++)
+		for(PxU32 pc=PxMax(pageColumn, 1u)-1; pc<=PxMin(pageColumn+1, mDesc.nbPageColumns-1); pc++)
+			releaseDecoded(mPages[getPageIndex(pr, pc)]);
+	return true;
+}
+
+PxHeightFieldSample TiledHeightField::getSample(PxU32 row, PxU32 column) const
+{
+	PxHeightFieldSample sample = getHoleSample();
+	if(row<mNbRows && column<mNbColumns)
+	{
+		PxMutex::ScopedLock lock(mLock);
+		const PxU32 pageSize = mDesc.pageSize;
+		const PxU32 r = row%pageSize;
+		const PxU32 c = column%pageSize;
+		decodeSamples(row/pageSize, column/pageSize, r, r+1, c, c+1, &sample, 1);
+	}
+	return sample;
+}
+
+void TiledHeightField::prefetch(const PxBounds3& localBounds)
+{
+	PxU32 pageRow0, pageRow1, pageColumn0, pageColumn1;
+	if(!getPageRange(localBounds, pageRow0, pageRow1, pageColumn0, pageColumn1))
+		return;
+
+	for(PxU32 pageRow=pageRow0; pageRow<=pageRow1; pageRow++)
+	{
+		for(PxU32 pageColumn=pageColumn0; pageColumn<=pageColumn1; pageColumn++)
+		{
+			DecodedPage decoded;
+			getDecodedPage(pageRow, pageColumn, decoded);
+		}
+	}
+}
+
+void TiledHeightField::update()
+{
+	PxMutex::ScopedLock lock(mLock);
+
+	mUpdateCount++;
+
+	PxU32 nbTracked = mTrackedPages.size();
+	for(PxU32 i=0; i<nbTracked;)
+	{
+		Page& page = mPages[mTrackedPages[i]];
+		if(mUpdateCount - page.lastUsed <= mDesc.maxIdleUpdates)
+		{
+			i++;
+			continue;
+		}
+
+		releaseDecoded(page);
+		// PT: samples set by users cannot be reloaded, they stay resident
+		if(page.flags & Page::eFROM_SOURCE)
+			releaseCompressed(page);
+
+		page.flags &= ~Page::eTRACKED;
+		mTrackedPages[i] = mTrackedPages[--nbTracked];
+	}
+	mTrackedPages.forceSize_Unsafe(nbTracked);
+}
+
+void TiledHeightField::getStats(PxTiledHeightFieldStats& stats) const
+{
+	PxMutex::ScopedLock lock(mLock);
+	stats.nbCompressedPages	= mNbCompressedPages;
+	stats.nbDecodedPages	= mNbDecodedPages;
+	stats.compressedBytes	= mCompressedBytes;
+	stats.decodedBytes		= mDecodedBytes;
+}
+
+PxTiledHeightField* physx::PxCreateTiledHeightField(PxPhysics& physics, const PxTiledHeightFieldDesc& desc)
+{
+	if(!desc.isValid())
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxCreateTiledHeightField: invalid descriptor.");
+		return NULL;
+	}
+	return PX_NEW(TiledHeightField)(physics, desc);
+}
@@ -0,0 +1,525 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2024 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "extensions/PxWorldStreamer.h"
+#include "extensions/PxSerialization.h"
+#include "extensions/PxCollectionExt.h"
+#include "foundation/PxArray.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxHashMap.h"
+#include "foundation/PxHashSet.h"
+#include "foundation/PxThread.h"
+#include "foundation/PxTime.h"
+#include "foundation/PxUserAllocated.h"
+#include "common/PxCollection.h"
+#include "task/PxTask.h"
+#include "task/PxCpuDispatcher.h"
+#include "PxAggregate.h"
+#include "PxArticulationReducedCoordinate.h"
+#include "PxPhysics.h"
+#include "PxPruningStructure.h"
+#include "PxRigidActor.h"
+#include "PxScene.h"
+#include "PxShape.h"
+
+using namespace physx;
+
+namespace
+{
+	class WorldStreamer;
+	struct Tile;
+
+	class TileLoadTask : public PxBaseTask
+	{
+		public:
+		virtual	void			run()					PX_OVERRIDE;
+		virtual	const char*		getName()		const	PX_OVERRIDE	{ return "PxWorldStreamer.loadTile";	}
+		virtual	void			addReference()			PX_OVERRIDE	{}
+		virtual	void			removeReference()		PX_OVERRIDE	{}
+		virtual	int32_t			getReference()	const	PX_OVERRIDE	{ return 1;								}
+		virtual	void			release()				PX_OVERRIDE;
+
+				WorldStreamer*	mStreamer;
+				Tile*			mTile;
+	};
+
+	struct Tile : public PxUserAllocated
+	{
+		Tile(PxU32 id, void* memBlock) :
+			mID					(id),
+			mMemBlock			(memBlock),
+			mState				(PxWorldStreamerTileState::eLOADING),
+			mLoaded				(0),
+			mCollection			(NULL),
+			mNbMergedStructures	(0),
+			mNbMergedActors		(0),
+			mNbMergedAggregates	(0),
+			mNbMergedArticulations(0),
+			mNbRemovedActors	(0)
+		{
+		}
+
+		const PxU32							mID;
+		void*const							mMemBlock;
+		PxWorldStreamerTileState::Enum		mState;
+		volatile PxI32						mLoaded;			// PT: set when the load task has been released, i.e. when the dispatcher is done with it
+
+		PxCollection*						mCollection;
+		PxArray<PxPruningStructure*>		mStructures;		// PT: one per chunk of actors with scene-query shapes
+		PxArray<bool>						mOwnedStructures;	// PT: false for structures coming from the collection
+		PxArray<PxActor*>					mActors;			// PT: rigid actors without scene-query shapes
+		PxArray<PxActor*>					mSceneActors;		// PT: all top-level rigid actors, for removal
+		PxArray<PxAggregate*>				mAggregates;
+		PxArray<PxArticulationReducedCoordinate*>	mArticulations;
+
+		// PT: merge & removal cursors
+		PxU32								mNbMergedStructures;
+		PxU32								mNbMergedActors;
+		PxU32								mNbMergedAggregates;
+		PxU32								mNbMergedArticulations;
+		PxU32								mNbRemovedActors;
+
+		TileLoadTask						mTask;
+	};
+
+	class WorldStreamer : public PxWorldStreamer, public PxUserAllocated
+	{
+		public:
+											WorldStreamer(const PxWorldStreamerDesc& desc);
+		virtual								~WorldStreamer();
+
+		// PxWorldStreamer
+		virtual	bool						loadTile(PxU32 tileID, void* memBlock)	PX_OVERRIDE;
+		virtual	bool						unloadTile(PxU32 tileID)				PX_OVERRIDE;
+		virtual	PxWorldStreamerTileState::Enum	getTileState(PxU32 tileID)	const	PX_OVERRIDE;
+		virtual	bool						update()								PX_OVERRIDE;
+		virtual	void						flush()									PX_OVERRIDE;
+		virtual	void						release()								PX_OVERRIDE;
+		//~PxWorldStreamer
+
+				void						prepareTile(Tile& tile);
+		private:
+				bool						process(PxReal timeBudget, PxU32 maxRemovals);
+				void						collectLoadedTiles(bool wait);
+				bool						mergeStep(Tile& tile);
+				bool						removeStep(Tile& tile, PxU32& nbRemovals);
+				void						releaseTile(Tile& tile);
+
+				const PxWorldStreamerDesc	mDesc;
+				PxHashMap<PxU32, Tile*>		mTiles;
+				PxArray<Tile*>				mLoadQueue;
+				PxArray<Tile*>				mMergeQueue;
+				PxArray<Tile*>				mUnloadQueue;
+				PxArray<PxActor*>			mTmpActors;
+	};
+}
+
+static bool hasSceneQueryShape(const PxRigidActor& actor)
+{
+	const PxU32 nbShapes = actor.getNbShapes();
+	for(PxU32 i=0;i<nbShapes;i++)
+	{
+		PxShape* shape;
+		actor.getShapes(&shape, 1, i);
+		if(shape->getFlags() & PxShapeFlag::eSCENE_QUERY_SHAPE)
+			return true;
+	}
+	return false;
+}
+
+void TileLoadTask::run()
+{
+	mStreamer->prepareTile(*mTile);
+}
+
+void TileLoadTask::release()
+{
+	// PT: the task lives in the tile, and the tile can be deleted by the main thread as soon as mLoaded is set. The
+	// dispatcher still uses the task after run() returns (profile zone, release call) so we only report completion here,
+	// and this must be the last access to the task or the tile.
+	PxAtomicExchange(&mTile->mLoaded, 1);
+}
+
+WorldStreamer::WorldStreamer(const PxWorldStreamerDesc& desc) : mDesc(desc)
+{
+}
+
+WorldStreamer::~WorldStreamer()
+{
+}
+
+// PT: runs on a background thread. Only touches the tile and SDK objects that are not in a scene yet.
+void WorldStreamer::prepareTile(Tile& tile)
+{
+	tile.mCollection = PxSerialization::createCollectionFromBinary(tile.mMemBlock, *mDesc.registry, mDesc.externalReferences);
+	if(tile.mCollection)
+	{
+		PxCollection& collection = *tile.mCollection;
+		const PxU32 nbObjects = collection.getNbObjects();
+
+		// PT: pruning structures stored in the collection (e.g. built offline) are used as-is, and their actors skipped below
+		PxHashSet<const PxActor*> structureActors;
+		PxArray<PxRigidActor*> actors;
+		for(PxU32 i=0;i<nbObjects;i++)
+		{
+			PxPruningStructure* ps = collection.getObject(i).is<PxPruningStructure>();
+			if(ps)
+			{
+				const PxU32 nbActors = ps->getNbRigidActors();
+				actors.resize(nbActors);
+				ps->getRigidActors(actors.begin(), nbActors);
+				for(PxU32 j=0;j<nbActors;j++)
+				{
+					structureActors.insert(actors[j]);
+					tile.mSceneActors.pushBack(actors[j]);
+				}
+				tile.mStructures.pushBack(ps);
+				tile.mOwnedStructures.pushBack(false);
+			}
+		}
+
+		actors.clear();
+		for(PxU32 i=0;i<nbObjects;i++)
+		{
+			PxBase& object = collection.getObject(i);
+			const PxType type = object.getConcreteType();
+			if(type==PxConcreteType::eRIGID_STATIC || type==PxConcreteType::eRIGID_DYNAMIC)
+			{
+				// PT: actors in aggregates are added with their aggregate
+				PxRigidActor* actor = static_cast<PxRigidActor*>(&object);
+				if(actor->getAggregate() || structureActors.contains(actor))
+					continue;
+
+				tile.mSceneActors.pushBack(actor);
+				if(hasSceneQueryShape(*actor))
+					actors.pushBack(actor);
+				else
+					tile.mActors.pushBack(actor);	// PT: pruning structures need scene-query shapes
+			}
+			else if(type==PxConcreteType::eAGGREGATE)
+			{
+				tile.mAggregates.pushBack(static_cast<PxAggregate*>(&object));
+			}
+			else if(type==PxConcreteType::eARTICULATION_REDUCED_COORDINATE)
+			{
+				PxArticulationReducedCoordinate* articulation = static_cast<PxArticulationReducedCoordinate*>(&object);
+				if(!articulation->getAggregate())
+					tile.mArticulations.pushBack(articulation);
+			}
+		}
+
+		PxPhysics& physics = mDesc.scene->getPhysics();
+		const PxU32 nbActors = actors.size();
+		for(PxU32 i=0;i<nbActors;i+=mDesc.maxActorsPerChunk)
+		{
+			const PxU32 nb = PxMin(mDesc.maxActorsPerChunk, nbActors - i);
+			PxPruningStructure* ps = physics.createPruningStructure(actors.begin() + i, nb);
+			if(ps)
+			{
+				tile.mStructures.pushBack(ps);
+				tile.mOwnedStructures.pushBack(true);
+			}
+			else
+			{
+				// PT: fallback to regular insertion
+				for(PxU32 j=0;j<nb;j++)
+					tile.mActors.pushBack(actors[i+j]);
+			}
+		}
+	}
+}
+
+bool WorldStreamer::loadTile(PxU32 tileID, void* memBlock)
+{
+	if(!memBlock || (size_t(memBlock) & 127))
+		return PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxWorldStreamer::loadTile: memBlock must be 128-byte aligned.");
+
+	if(mTiles.find(tileID))
+		return PxGetFoundation().error(PxErrorCode::eINVALID_OPERATION, PX_FL, "PxWorldStreamer::loadTile: tile %d is already managed by the streamer.", tileID);
+
+	Tile* tile = PX_NEW(Tile)(tileID, memBlock);
+	tile->mTask.mStreamer = this;
+	tile->mTask.mTile = tile;
+	mTiles.insert(tileID, tile);
+	mLoadQueue.pushBack(tile);
+
+	if(mDesc.cpuDispatcher)
+		mDesc.cpuDispatcher->submitTask(tile->mTask);
+	else
+	{
+		tile->mTask.run();
+		tile->mTask.release();
+	}
+	return true;
+}
+
+bool WorldStreamer::unloadTile(PxU32 tileID)
+{
+	const PxHashMap<PxU32, Tile*>::Entry* entry = mTiles.find(tileID);
+	if(!entry)
+		return false;
+
+	Tile* tile = entry->second;
+	switch(tile->mState)
+	{
+		case PxWorldStreamerTileState::eLOADING:
+			// PT: the tile will be moved to the unload queue when its background task finishes
+			break;
+		case PxWorldStreamerTileState::eMERGING:
+			mMergeQueue.remove(mMergeQueue.find(tile) - mMergeQueue.begin());
+			mUnloadQueue.pushBack(tile);
+			break;
+		case PxWorldStreamerTileState::eLOADED:
+			mUnloadQueue.pushBack(tile);
+			break;
+		case PxWorldStreamerTileState::eUNKNOWN:
+		case PxWorldStreamerTileState::eUNLOADING:
+			return true;
+	}
+	tile->mState = PxWorldStreamerTileState::eUNLOADING;
+	return true;
+}
+
+PxWorldStreamerTileState::Enum WorldStreamer::getTileState(PxU32 tileID) const
+{
+	const PxHashMap<PxU32, Tile*>::Entry* entry = mTiles.find(tileID);
+	return entry ? entry->second->mState : PxWorldStreamerTileState::eUNKNOWN;
+}
+
+void WorldStreamer::collectLoadedTiles(bool wait)
+{
+	// PT: tiles are processed in load order
+	for(PxU32 i=0;i<mLoadQueue.size();)
+	{
+		Tile* tile = mLoadQueue[i];
+		if(!tile->mLoaded)
+		{
+			if(!wait)
+			{
+				i++;
+				continue;
+			}
+			while(!tile->mLoaded)
+				PxThread::yield();
+		}
+
+		mLoadQueue.remove(i);
+
+		if(!tile->mCollection)
+		{
+			PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxWorldStreamer: failed to deserialize tile %d.", tile->mID);
+			mDesc.callback->releaseTileData(tile->mID, tile->mMemBlock);
+			releaseTile(*tile);
+		}
+		else if(tile->mState == PxWorldStreamerTileState::eUNLOADING)
+		{
+			mUnloadQueue.pushBack(tile);
+		}
+		else
+		{
+			tile->mState = PxWorldStreamerTileState::eMERGING;
+			mMergeQueue.pushBack(tile);
+		}
+	}
+}
+
+// PT: performs one merge operation, returns true when the tile has been fully merged
+bool WorldStreamer::mergeStep(Tile& tile)
+{
+	PxScene& scene = *mDesc.scene;
+
+	if(tile.mNbMergedStructures<tile.mStructures.size())
+	{
+		const PxU32 index = tile.mNbMergedStructures++;
+		PxPruningStructure* ps = tile.mStructures[index];
+		scene.addActors(*ps);
+
+		// PT: the structure is only needed to add the actors. Releasing it detaches them, so that they can later be
+		// removed and released like regular actors.
+		if(!tile.mOwnedStructures[index])
+			tile.mCollection->remove(*ps);
+		ps->release();
+		tile.mStructures[index] = NULL;
+	}
+	else if(tile.mNbMergedActors<tile.mActors.size())
+	{
+		const PxU32 nb = PxMin(mDesc.maxActorsPerChunk, tile.mActors.size() - tile.mNbMergedActors);
+		scene.addActors(tile.mActors.begin() + tile.mNbMergedActors, nb);
+		tile.mNbMergedActors += nb;
+	}
+	else if(tile.mNbMergedAggregates<tile.mAggregates.size())
+	{
+		scene.addAggregate(*tile.mAggregates[tile.mNbMergedAggregates++]);
+	}
+	else if(tile.mNbMergedArticulations<tile.mArticulations.size())
+	{
+		scene.addArticulation(*tile.mArticulations[tile.mNbMergedArticulations++]);
+	}
+
+	return		tile.mNbMergedStructures==tile.mStructures.size()
+			&&	tile.mNbMergedActors==tile.mActors.size()
+			&&	tile.mNbMergedAggregates==tile.mAggregates.size()
+			&&	tile.mNbMergedArticulations==tile.mArticulations.size();
+}
+
+// PT: removes up to nbRemovals actors from the scene, returns true when the tile has been fully removed and released
+bool WorldStreamer::removeStep(Tile& tile, PxU32& nbRemovals)
+{
+	PxScene& scene = *mDesc.scene;
+
+	// PT: pruning structures that have not been merged yet must be released before their actors
+	const PxU32 nbStructures = tile.mStructures.size();
+	for(PxU32 i=tile.mNbMergedStructures;i<nbStructures;i++)
+	{
+		PxPruningStructure* ps = tile.mStructures[i];
+		if(!tile.mOwnedStructures[i])
+			tile.mCollection->remove(*ps);
+		ps->release();
+		tile.mStructures[i] = NULL;
+	}
+	tile.mNbMergedStructures = nbStructures;
+
+	const PxU32 nbActors = tile.mSceneActors.size();
+	while(tile.mNbRemovedActors<nbActors)
+	{
+		if(!nbRemovals)
+			return false;
+
+		const PxU32 nb = PxMin(nbRemovals, nbActors - tile.mNbRemovedActors);
+
+		// PT: the tile might only have been partially merged
+		mTmpActors.clear();
+		for(PxU32 i=0;i<nb;i++)
+		{
+			PxActor* actor = tile.mSceneActors[tile.mNbRemovedActors + i];
+			if(actor->getScene())
+				mTmpActors.pushBack(actor);
+		}
+		if(mTmpActors.size())
+			scene.removeActors(mTmpActors.begin(), mTmpActors.size(), false);
+
+		tile.mNbRemovedActors += nb;
+		nbRemovals -= nb;
+	}
+
+	for(PxU32 i=0;i<tile.mAggregates.size();i++)
+	{
+		if(tile.mAggregates[i]->getScene())
+			scene.removeAggregate(*tile.mAggregates[i], false);
+	}
+
+	for(PxU32 i=0;i<tile.mArticulations.size();i++)
+	{
+		if(tile.mArticulations[i]->getScene())
+			scene.removeArticulation(*tile.mArticulations[i], false);
+	}
+
+	PxCollectionExt::releaseObjects(*tile.mCollection);
+	tile.mCollection->release();
+	tile.mCollection = NULL;
+
+	mDesc.callback->releaseTileData(tile.mID, tile.mMemBlock);
+	return true;
+}
+
+void WorldStreamer::releaseTile(Tile& tile)
+{
+	mTiles.erase(tile.mID);
+	Tile* tmp = &tile;
+	PX_DELETE(tmp);
+}
+
+bool WorldStreamer::process(PxReal timeBudget, PxU32 maxRemovals)
+{
+	collectLoadedTiles(false);
+
+	// PT: removals first, so that their cost is not charged to the merge budget
+	PxU32 nbRemovals = maxRemovals;
+	while(mUnloadQueue.size())
+	{
+		Tile* tile = mUnloadQueue[0];
+		if(!removeStep(*tile, nbRemovals))
+			break;
+		mUnloadQueue.remove(0);
+		releaseTile(*tile);
+	}
+
+	// PT: at least one merge operation per call, so that loading always progresses
+	PxTime timer;
+	while(mMergeQueue.size())
+	{
+		Tile* tile = mMergeQueue[0];
+		if(mergeStep(*tile))
+		{
+			mMergeQueue.remove(0);
+			tile->mState = PxWorldStreamerTileState::eLOADED;
+			mDesc.callback->onTileLoaded(tile->mID, *tile->mCollection);
+		}
+
+		if(timer.peekElapsedSeconds()>=timeBudget)
+			break;
+	}
+
+	return mLoadQueue.empty() && mMergeQueue.empty() && mUnloadQueue.empty();
+}
+
+bool WorldStreamer::update()
+{
+	return process(mDesc.timeBudget, mDesc.maxRemovalsPerUpdate);
+}
+
+void WorldStreamer::flush()
+{
+	collectLoadedTiles(true);
+	while(!process(PX_MAX_F32, 0xffffffff))
+		collectLoadedTiles(true);
+}
+
+void WorldStreamer::release()
+{
+	collectLoadedTiles(true);
+
+	PxArray<PxU32> tileIDs;
+	for(PxHashMap<PxU32, Tile*>::Iterator iter = mTiles.getIterator(); !iter.done(); ++iter)
+		tileIDs.pushBack(iter->first);
+	for(PxU32 i=0;i<tileIDs.size();i++)
+		unloadTile(tileIDs[i]);
+
+	flush();
+	PX_DELETE_THIS;
+}
+
+PxWorldStreamer* physx::PxCreateWorldStreamer(const PxWorldStreamerDesc& desc)
+{
+	if(!desc.isValid())
+	{
+		PxGetFoundation().error(PxErrorCode::eINVALID_PARAMETER, PX_FL, "PxCreateWorldStreamer: invalid descriptor.");
+		return NULL;
+	}
+	return PX_NEW(WorldStreamer)(desc);
+}
@@ -31,6 +31,7 @@
 #include "foundation/PxHashMap.h"
 #include "foundation/PxString.h"
 #include "extensions/PxSerialization.h"
+#include "task/PxCpuDispatcher.h"
 #include "PxPhysics.h"
 #include "PxPhysicsSerialization.h"
 
@@ -40,6 +41,7 @@
 #include "serialization/SnSerializationRegistry.h"
 #include "serialization/SnSerialUtils.h"
 #include "CmCollection.h"
+#include "CmParallelFor.h"
 
 using namespace physx;
 using namespace Sn;
@@ -142,10 +144,130 @@ namespace
 		}
 		return true;
 	}
-	
+
+	// PT: objects are created in groups, one group after the other. Objects from the first groups only depend on objects
+	// from previous groups (or external objects), and they only touch the objects they reference through thread-safe
+	// ref-counters. So objects within these groups can be created in parallel. Everything else (aggregates, articulations,
+	// constraints, custom types...) goes to the last group, created sequentially in manifest order.
+	enum DeserializationGroup
+	{
+		DESERIALIZATION_GROUP_ASSETS,		// materials, meshes, height fields
+		DESERIALIZATION_GROUP_SHAPES,
+		DESERIALIZATION_GROUP_ACTORS,		// rigid statics & dynamics
+		DESERIALIZATION_GROUP_SEQUENTIAL,
+
+		DESERIALIZATION_GROUP_COUNT
+	};
+
+	PX_FORCE_INLINE DeserializationGroup getDeserializationGroup(PxType type)
+	{
+		switch(type)
+		{
+			case PxConcreteType::eMATERIAL:
+			case PxConcreteType::eCONVEX_MESH:
+			case PxConcreteType::eTRIANGLE_MESH_BVH33:
+			case PxConcreteType::eTRIANGLE_MESH_BVH34:
+			case PxConcreteType::eHEIGHTFIELD:
+				return DESERIALIZATION_GROUP_ASSETS;
+			case PxConcreteType::eSHAPE:
+				return DESERIALIZATION_GROUP_SHAPES;
+			case PxConcreteType::eRIGID_STATIC:
+			case PxConcreteType::eRIGID_DYNAMIC:
+				return DESERIALIZATION_GROUP_ACTORS;
+			default:
+				return DESERIALIZATION_GROUP_SEQUENTIAL;
+		}
+	}
+
+	struct ObjectCreationParams
+	{
+		const SerializationRegistry*	mRegistry;
+		const ManifestEntry*			mManifestTable;
+		const ImportReference*			mImportReferences;
+		const InternalPtrRefMap*		mInternalPtrReferencesMap;
+		const InternalHandle16RefMap*	mInternalHandle16ReferencesMap;
+		const Cm::Collection*			mExternalRefs;
+		PxU8*							mObjectData;
+		PxU8*							mExtraData;
+		const PxU32*					mExtraDataOffsets;
+		const PxU32*					mObjectIndices;		// manifest indices of the current group
+		PxBase**						mInstances;			// created objects, in manifest order
+	};
+
+	PX_FORCE_INLINE void createObject(const ObjectCreationParams& params, DeserializationContext& context, PxU32 objectIndex)
+	{
+		context.setExtraDataAddress(params.mExtraData + params.mExtraDataOffsets[objectIndex]);
+
+		PxU8* address = params.mObjectData + params.mManifestTable[objectIndex].offset;
+		const PxType classType = reinterpret_cast<PxBase*>(address)->getConcreteType();
+		const PxSerializer* serializer = params.mRegistry->getSerializer(classType);
+		PX_ASSERT(serializer);
+
+		params.mInstances[objectIndex] = serializer->createObject(address, context);
+	}
+
+	void createObjects(void* userData, PxU32 start, PxU32 end)
+	{
+		const ObjectCreationParams& params = *reinterpret_cast<const ObjectCreationParams*>(userData);
+
+		DeserializationContext context(params.mManifestTable, params.mImportReferences, params.mObjectData, *params.mInternalPtrReferencesMap, *params.mInternalHandle16ReferencesMap, params.mExternalRefs, params.mExtraData);
+
+		for(PxU32 i=start;i<end;i++)
+			createObject(params, context, params.mObjectIndices[i]);
+	}
+
+	#define DESERIALIZATION_BATCH_SIZE	128
+
+	// PT: creates the objects with a list of per-object extra data offsets, in parallel when possible. Returns the index
+	// of the first object that could not be created, or nbObjects.
+	PxU32 createObjectsParallel(ObjectCreationParams& params, PxU32 nbObjects, PxCpuDispatcher* dispatcher)
+	{
+		// PT: partition the manifest by group, keeping the manifest (i.e. address) order within each group
+		PxU32 groupStart[DESERIALIZATION_GROUP_COUNT + 1];
+		PxMemZero(groupStart, sizeof(groupStart));
+		for(PxU32 i=0;i<nbObjects;i++)
+			groupStart[getDeserializationGroup(params.mManifestTable[i].type) + 1]++;
+		for(PxU32 i=0;i<DESERIALIZATION_GROUP_COUNT;i++)
+			groupStart[i + 1] += groupStart[i];
+
+		PxArray<PxU32> objectIndices(nbObjects);
+		{
+			PxU32 offsets[DESERIALIZATION_GROUP_COUNT];
+			PxMemCopy(offsets, groupStart, sizeof(offsets));
+			for(PxU32 i=0;i<nbObjects;i++)
+				objectIndices[offsets[getDeserializationGroup(params.mManifestTable[i].type)]++] = i;
+		}
+
+		for(PxU32 group=0; group<DESERIALIZATION_GROUP_SEQUENTIAL; group++)
+		{
+			const PxU32 start = groupStart[group];
+			const PxU32 nb = groupStart[group + 1] - start;
+
+			params.mObjectIndices = objectIndices.begin() + start;
+			Cm::parallelFor(dispatcher, nb, DESERIALIZATION_BATCH_SIZE, createObjects, &params);
+
+			// PT: later groups reference these objects, so we cannot go on if one of them failed
+			for(PxU32 i=0;i<nb;i++)
+			{
+				const PxU32 objectIndex = params.mObjectIndices[i];
+				if(!params.mInstances[objectIndex])
+					return objectIndex;
+			}
+		}
+
+		DeserializationContext context(params.mManifestTable, params.mImportReferences, params.mObjectData, *params.mInternalPtrReferencesMap, *params.mInternalHandle16ReferencesMap, params.mExternalRefs, params.mExtraData);
+		for(PxU32 i=groupStart[DESERIALIZATION_GROUP_SEQUENTIAL]; i<nbObjects; i++)
+		{
+			const PxU32 objectIndex = objectIndices[i];
+			createObject(params, context, objectIndex);
+			if(!params.mInstances[objectIndex])
+				return objectIndex;
+		}
+		return nbObjects;
+	}
 }
 
-PxCollection* PxSerialization::createCollectionFromBinary(void* memBlock, PxSerializationRegistry& sr, const PxCollection* pxExternalRefs)
+PxCollection* PxSerialization::createCollectionFromBinary(void* memBlock, PxSerializationRegistry& sr, const PxCollection* pxExternalRefs, PxCpuDispatcher* dispatcher)
 {
 	if(size_t(memBlock) & (PX_SERIAL_FILE_ALIGN-1))
 	{
@@ -222,6 +344,16 @@ PxCollection* PxSerialization::createCollectionFromBinary(void* memBlock, PxSeri
 		address += nbInternalHandle16References*sizeof(InternalReferenceHandle16);
 	}
 
+	// read extra data offsets
+	PxU32 nbExtraDataOffsets;
+	const PxU32* extraDataOffsets;
+	{
+		address = alignPtr(address);
+		nbExtraDataOffsets = read32(address);
+		extraDataOffsets = (nbExtraDataOffsets > 0) ? reinterpret_cast<const PxU32*>(address) : NULL;
+		address += nbExtraDataOffsets*sizeof(PxU32);
+	}
+
 	// create internal references map
 	InternalPtrRefMap internalPtrReferencesMap(nbInternalPtrReferences*2);
 	{
@@ -251,16 +383,47 @@ PxCollection* PxSerialization::createCollectionFromBinary(void* memBlock, PxSeri
 	PxU8* addressObjectData = alignPtr(address);
 	PxU8* addressExtraData = alignPtr(addressObjectData + objectDataEndOffset);
 
-	DeserializationContext context(manifestTable, importReferences, addressObjectData, internalPtrReferencesMap, internalHandle16ReferencesMap, externalRefs, addressExtraData);
-	
-	// iterate over memory containing PxBase objects, create the instances, resolve the addresses, import the external data, add to collection.
+	if(dispatcher && nbExtraDataOffsets == nbObjectsInCollection)
+	{
+		// PT: the creation order differs from the manifest order here, but objects are added to the collection in manifest
+		// order so that the result is the same as with the sequential code below.
+		PxArray<PxBase*> instances(nbObjectsInCollection, NULL);
+
+		ObjectCreationParams params;
+		params.mRegistry						= &sn;
+		params.mManifestTable					= manifestTable;
+		params.mImportReferences				= importReferences;
+		params.mInternalPtrReferencesMap		= &internalPtrReferencesMap;
+		params.mInternalHandle16ReferencesMap	= &internalHandle16ReferencesMap;
+		params.mExternalRefs					= externalRefs;
+		params.mObjectData						= addressObjectData;
+		params.mExtraData						= addressExtraData;
+		params.mExtraDataOffsets				= extraDataOffsets;
+		params.mObjectIndices					= NULL;
+		params.mInstances						= instances.begin();
+
+		const PxU32 failedIndex = createObjectsParallel(params, nbObjectsInCollection, dispatcher);
+		if(failedIndex != nbObjectsInCollection)
+		{
+			PxGetFoundation().error(physx::PxErrorCode::eINVALID_PARAMETER, PX_FL, 
+				"Cannot create class instance for concrete type %d.", manifestTable[failedIndex].type);
+			collection->release();
+			return NULL;
+		}
+
+		for(PxU32 i=0;i<nbObjectsInCollection;i++)
+			collection->internalAdd(instances[i]);
+	}
+	else
 	{
-		PxU32 nbObjects = nbObjectsInCollection;
+		DeserializationContext context(manifestTable, importReferences, addressObjectData, internalPtrReferencesMap, internalHandle16ReferencesMap, externalRefs, addressExtraData);
 
-		while(nbObjects--)
+		// iterate over memory containing PxBase objects, create the instances, resolve the addresses, import the external data, add to collection.
+		for(PxU32 i=0;i<nbObjectsInCollection;i++)
 		{
 			address = alignPtr(address);
 			context.alignExtraData();
+			PX_ASSERT(!extraDataOffsets || context.getExtraDataAddress() == addressExtraData + extraDataOffsets[i]);
 
 			// read PxBase header with type and get corresponding serializer.
 			PxBase* header = reinterpret_cast<PxBase*>(address);
@@ -113,6 +113,16 @@ using namespace Sn;
 //
 //
 //------------------------------------------------------------------------------------
+//// extra data offsets:
+//// one entry per collected object, offset of its extra data relative to the extra data buffer
+//// used for parallel deserialization, size is 0 when the offsets are not available
+//------------------------------------------------------------------------------------
+// alignment
+// PxU32 size
+// PxU32 offset*size
+//
+//
+//------------------------------------------------------------------------------------
 //// object data:
 //// serialized PxBase derived class instances
 //// each object size depends on specific class
@@ -143,9 +153,9 @@ namespace
 	{
 	public:
 
-		PX_INLINE OutputStreamWriter(PxOutputStream& stream) 
+		PX_INLINE OutputStreamWriter(PxOutputStream& stream, PxU32 startCount = 0) 
 		:	mStream(stream)
-		,	mCount(0)
+		,	mCount(startCount)
 		{}
 
 		PX_INLINE	PxU32	write(const void* src, PxU32 offset)		
@@ -167,6 +177,13 @@ namespace
 		PxU32 mCount;
 	};
 
+	// PT: only counts the written bytes, used to compute the extra data offsets before the extra data is written
+	class NullOutputStream : public PxOutputStream
+	{
+	public:
+		virtual	PxU32	write(const void*, PxU32 count)	PX_OVERRIDE	{ return count;	}
+	};
+
 	class LegacySerialStream : public PxSerializationContext
 	{
 	public:
@@ -297,9 +314,9 @@ bool PxSerialization::serializeCollectionToBinary(PxOutputStream& outputStream,
 	stream.writeData(&nbObjectsInCollection, sizeof(PxU32));
 
 	// write the manifest table (PxU32 offset, PxConcreteType type)
+	PxU32 headerOffset = 0;
 	{
 		PxArray<ManifestEntry> manifestTable(collection.internalGetNbObjects());
-		PxU32 headerOffset = 0;
 		for(PxU32 i=0;i<collection.internalGetNbObjects();i++)
 		{
 			PxBase* s = collection.internalGetObject(i);
@@ -382,6 +399,37 @@ bool PxSerialization::serializeCollectionToBinary(PxOutputStream& outputStream,
 		stream.writeData(internalReferencesHandle16.begin(), internalReferencesHandle16.size()*sizeof(InternalReferenceHandle16));
 	}
 
+	// write extra data offsets
+	PxArray<PxU32> extraDataOffsets(collection.internalGetNbObjects());
+	PxU32 extraDataStart;
+	{
+		// PT: the object data starts on the first aligned address after this table, and the extra data right after the
+		// object data. So we know where the extra data will start in the stream, and we can compute the offsets with a
+		// dry run that only counts bytes. Starting the count at the real position matters, since some objects align
+		// their extra data to more than PX_SERIAL_ALIGN (e.g. RTree).
+		const PxU32 nb = collection.internalGetNbObjects();
+		stream.alignData(PX_SERIAL_ALIGN);
+		const PxU32 tableEnd = stream.getTotalStoredSize() + sizeof(PxU32) + nb*sizeof(PxU32);
+		extraDataStart = tableEnd + getPadding(tableEnd, PX_SERIAL_ALIGN) + headerOffset;
+
+		NullOutputStream nullStream;
+		OutputStreamWriter sizeWriter(nullStream, extraDataStart);
+		LegacySerialStream sizeStream(sizeWriter, collection, exportNames);
+		for(PxU32 i=0;i<nb;i++)
+		{
+			PxBase* s = collection.internalGetObject(i);
+			const PxSerializer* serializer = sn.getSerializer(s->getConcreteType());
+			PX_ASSERT(serializer);
+
+			sizeStream.alignData(PX_SERIAL_ALIGN);
+			extraDataOffsets[i] = sizeStream.getTotalStoredSize() - extraDataStart;
+			serializer->exportExtraData(*s, sizeStream);
+		}
+
+		stream.writeData(&nb, sizeof(PxU32));
+		stream.writeData(extraDataOffsets.begin(), nb*sizeof(PxU32));
+	}
+
 	// write object data
 	{
 		stream.alignData(PX_SERIAL_ALIGN);
@@ -395,6 +443,8 @@ bool PxSerialization::serializeCollectionToBinary(PxOutputStream& outputStream,
 			stream.alignData(PX_SERIAL_ALIGN);
 			serializer->exportData(*s, stream);
 		}
+		stream.alignData(PX_SERIAL_ALIGN);
+		PX_ASSERT(stream.getTotalStoredSize() == extraDataStart);
 	}
 
 	// write extra data
@@ -409,6 +459,7 @@ bool PxSerialization::serializeCollectionToBinary(PxOutputStream& outputStream,
 			PX_ASSERT(serializer);
 
 			stream.alignData(PX_SERIAL_ALIGN);
+			PX_ASSERT(stream.getTotalStoredSize() - extraDataStart == extraDataOffsets[i]);
 			serializer->exportExtraData(*s, stream);
 		}
 	}
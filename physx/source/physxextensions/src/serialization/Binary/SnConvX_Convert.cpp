@@ -1437,6 +1437,36 @@ const void* Sn::ConvX::convertInternalReferences(const void* buffer, int& fileSi
 }
 
 
+// PT: the extra data offsets are only valid for the platform they were computed for, since the size of the extra data
+// depends on the platform. They are kept as-is when the source and destination platforms are the same (e.g. for
+// deterministic serialization), and dropped otherwise. The deserializer then falls back to sequential creation.
+const void* Sn::ConvX::convertExtraDataOffsets(const void* buffer, int& fileSize, int nbObjectsInCollection)
+{
+	PxU32 padding = getPadding(size_t(buffer), ALIGN_DEFAULT);
+	buffer = alignStream(reinterpret_cast<const char*>(buffer));
+	fileSize -= padding;
+
+	const int nb = *reinterpret_cast<const int*>(buffer);
+	buffer = reinterpret_cast<const void*>(size_t(buffer) + sizeof(int));
+	fileSize -= 4;
+	assert(nb==0 || nb==nbObjectsInCollection);
+	PX_UNUSED(nbObjectsInCollection);
+
+	const bool keepOffsets = mMetaData_Src->getPlatformTag() == mMetaData_Dst->getPlatformTag();
+	output(keepOffsets ? nb : 0);
+
+	const int* offsets = reinterpret_cast<const int*>(buffer);
+	if(keepOffsets)
+	{
+		for(int i=0;i<nb;i++)
+			output(offsets[i]);
+	}
+
+	fileSize -= nb*4;
+	assert(fileSize>=0);
+	return offsets + nb;
+}
+
 const void* Sn::ConvX::convertReferenceTables(const void* buffer, int& fileSize, int& nbObjectsInCollection)
 {	
 	// PT: the map should not be used while creating it, so use one indirection
@@ -1465,6 +1495,7 @@ const void* Sn::ConvX::convertReferenceTables(const void* buffer, int& fileSize,
 	buffer = convertImportReferences(buffer, fileSize);
 	buffer = convertExportReferences(buffer, fileSize);
 	buffer = convertInternalReferences(buffer, fileSize);
+	buffer = convertExtraDataOffsets(buffer, fileSize, nbObjectsInCollection);
 
 	// PT: the map can now be used
 	mPointerActiveRemap = &mPointerRemap;
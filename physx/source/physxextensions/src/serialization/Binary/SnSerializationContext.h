@@ -188,6 +188,9 @@ namespace physx
 
 			virtual	PxBase*	resolveReference(PxU32 kind, size_t reference) const;
 
+			PX_FORCE_INLINE	PxU8*	getExtraDataAddress()	const	{ return mExtraDataAddress;	}
+			PX_FORCE_INLINE	void	setExtraDataAddress(PxU8* address)	{ mExtraDataAddress = address;	}
+
 		private:
 			//various pointers to deserialized data
 			const ManifestEntry* mManifestTable;
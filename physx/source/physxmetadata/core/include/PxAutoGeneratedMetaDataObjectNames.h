@@ -390,6 +390,7 @@ PxSceneDesc_SolverBatchSize,
 PxSceneDesc_SolverArticulationBatchSize,
 PxSceneDesc_NbContactDataBlocks,
 PxSceneDesc_MaxNbContactDataBlocks,
+PxSceneDesc_ContactDataBlockIdleFrames,
 PxSceneDesc_MaxBiasCoefficient,
 PxSceneDesc_ContactReportStreamBufferSize,
 PxSceneDesc_CcdMaxPasses,
@@ -463,6 +464,9 @@ PxSimulationStatistics_NbAxisSolverConstraints,
 PxSimulationStatistics_CompressedContactSize,
 PxSimulationStatistics_RequiredContactConstraintMemory,
 PxSimulationStatistics_PeakConstraintMemory,
+PxSimulationStatistics_NbContactDataBlocksAllocated,
+PxSimulationStatistics_PeakContactDataBlocksUsed,
+PxSimulationStatistics_NbReducedContactPairs,
 PxSimulationStatistics_NbDiscreteContactPairsTotal,
 PxSimulationStatistics_NbDiscreteContactPairsWithCacheHits,
 PxSimulationStatistics_NbDiscreteContactPairsWithContacts,
@@ -2421,6 +2421,7 @@ template<> struct PxEnumTraits< physx::PxPruningStructureType::Enum > { PxEnumTr
 		{ "eENABLE_DIRECT_GPU_API", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_DIRECT_GPU_API ) },
 		{ "eENABLE_BODY_ACCELERATIONS", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_BODY_ACCELERATIONS ) },
 		{ "eENABLE_SOLVER_RESIDUAL_REPORTING", static_cast<PxU32>( physx::PxSceneFlag::eENABLE_SOLVER_RESIDUAL_REPORTING ) },
+		{ "eREDUCE_CONTACTS_ON_LOW_MEMORY", static_cast<PxU32>( physx::PxSceneFlag::eREDUCE_CONTACTS_ON_LOW_MEMORY ) },
 		{ "eMUTABLE_FLAGS", static_cast<PxU32>( physx::PxSceneFlag::eMUTABLE_FLAGS ) },
 		{ NULL, 0 }
 	};
@@ -2504,6 +2505,7 @@ template<> struct PxEnumTraits< physx::PxVisualizationParameter::Enum > { PxEnum
 		{ "eABP", static_cast<PxU32>( physx::PxBroadPhaseType::eABP ) },
 		{ "ePABP", static_cast<PxU32>( physx::PxBroadPhaseType::ePABP ) },
 		{ "eGPU", static_cast<PxU32>( physx::PxBroadPhaseType::eGPU ) },
+		{ "ePSAP", static_cast<PxU32>( physx::PxBroadPhaseType::ePSAP ) },
 		{ "eLAST", static_cast<PxU32>( physx::PxBroadPhaseType::eLAST ) },
 		{ NULL, 0 }
 	};
@@ -3203,6 +3205,7 @@ template<> struct PxEnumTraits< physx::PxBVHBuildStrategy::Enum > { PxEnumTraits
 		PxU32 SolverArticulationBatchSize;
 		PxU32 NbContactDataBlocks;
 		PxU32 MaxNbContactDataBlocks;
+		PxU32 ContactDataBlockIdleFrames;
 		PxReal MaxBiasCoefficient;
 		PxU32 ContactReportStreamBufferSize;
 		PxU32 CcdMaxPasses;
@@ -3243,6 +3246,7 @@ template<> struct PxEnumTraits< physx::PxBVHBuildStrategy::Enum > { PxEnumTraits
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSceneDesc, SolverArticulationBatchSize, PxSceneDescGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSceneDesc, NbContactDataBlocks, PxSceneDescGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSceneDesc, MaxNbContactDataBlocks, PxSceneDescGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSceneDesc, ContactDataBlockIdleFrames, PxSceneDescGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSceneDesc, MaxBiasCoefficient, PxSceneDescGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSceneDesc, ContactReportStreamBufferSize, PxSceneDescGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSceneDesc, CcdMaxPasses, PxSceneDescGeneratedValues)
@@ -3286,6 +3290,7 @@ template<> struct PxEnumTraits< physx::PxBVHBuildStrategy::Enum > { PxEnumTraits
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSceneDesc_SolverArticulationBatchSize, PxSceneDesc, PxU32, PxU32 > SolverArticulationBatchSize;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSceneDesc_NbContactDataBlocks, PxSceneDesc, PxU32, PxU32 > NbContactDataBlocks;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSceneDesc_MaxNbContactDataBlocks, PxSceneDesc, PxU32, PxU32 > MaxNbContactDataBlocks;
+		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSceneDesc_ContactDataBlockIdleFrames, PxSceneDesc, PxU32, PxU32 > ContactDataBlockIdleFrames;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSceneDesc_MaxBiasCoefficient, PxSceneDesc, PxReal, PxReal > MaxBiasCoefficient;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSceneDesc_ContactReportStreamBufferSize, PxSceneDesc, PxU32, PxU32 > ContactReportStreamBufferSize;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSceneDesc_CcdMaxPasses, PxSceneDesc, PxU32, PxU32 > CcdMaxPasses;
@@ -3320,7 +3325,7 @@ template<> struct PxEnumTraits< physx::PxBVHBuildStrategy::Enum > { PxEnumTraits
 			inStartIndex = PxSceneQueryDescGeneratedInfo::visitInstanceProperties( inOperator, inStartIndex );
 			return inStartIndex;
 		}
-		static PxU32 instancePropertyCount() { return 39; }
+		static PxU32 instancePropertyCount() { return 40; }
 		static PxU32 totalPropertyCount() { return instancePropertyCount()
 				+ PxSceneQueryDescGeneratedInfo::totalPropertyCount(); }
 		template<typename TOperator>
@@ -3355,19 +3360,20 @@ template<> struct PxEnumTraits< physx::PxBVHBuildStrategy::Enum > { PxEnumTraits
 			inOperator( SolverArticulationBatchSize, inStartIndex + 24 );; 
 			inOperator( NbContactDataBlocks, inStartIndex + 25 );; 
 			inOperator( MaxNbContactDataBlocks, inStartIndex + 26 );; 
-			inOperator( MaxBiasCoefficient, inStartIndex + 27 );; 
-			inOperator( ContactReportStreamBufferSize, inStartIndex + 28 );; 
-			inOperator( CcdMaxPasses, inStartIndex + 29 );; 
-			inOperator( CcdThreshold, inStartIndex + 30 );; 
-			inOperator( CcdMaxSeparation, inStartIndex + 31 );; 
-			inOperator( WakeCounterResetValue, inStartIndex + 32 );; 
-			inOperator( SanityBounds, inStartIndex + 33 );; 
-			inOperator( GpuDynamicsConfig, inStartIndex + 34 );; 
-			inOperator( GpuMaxNumPartitions, inStartIndex + 35 );; 
-			inOperator( GpuMaxNumStaticPartitions, inStartIndex + 36 );; 
-			inOperator( GpuComputeVersion, inStartIndex + 37 );; 
-			inOperator( ContactPairSlabSize, inStartIndex + 38 );; 
-			return 39 + inStartIndex;
+			inOperator( ContactDataBlockIdleFrames, inStartIndex + 27 );; 
+			inOperator( MaxBiasCoefficient, inStartIndex + 28 );; 
+			inOperator( ContactReportStreamBufferSize, inStartIndex + 29 );; 
+			inOperator( CcdMaxPasses, inStartIndex + 30 );; 
+			inOperator( CcdThreshold, inStartIndex + 31 );; 
+			inOperator( CcdMaxSeparation, inStartIndex + 32 );; 
+			inOperator( WakeCounterResetValue, inStartIndex + 33 );; 
+			inOperator( SanityBounds, inStartIndex + 34 );; 
+			inOperator( GpuDynamicsConfig, inStartIndex + 35 );; 
+			inOperator( GpuMaxNumPartitions, inStartIndex + 36 );; 
+			inOperator( GpuMaxNumStaticPartitions, inStartIndex + 37 );; 
+			inOperator( GpuComputeVersion, inStartIndex + 38 );; 
+			inOperator( ContactPairSlabSize, inStartIndex + 39 );; 
+			return 40 + inStartIndex;
 		}
 	};
 	template<> struct PxClassInfoTraits<PxSceneDesc>
@@ -3732,6 +3738,9 @@ template<> struct PxEnumTraits< physx::PxSimulationStatistics::RbPairStatsType >
 		PxU32 CompressedContactSize;
 		PxU32 RequiredContactConstraintMemory;
 		PxU32 PeakConstraintMemory;
+		PxU32 NbContactDataBlocksAllocated;
+		PxU32 PeakContactDataBlocksUsed;
+		PxU32 NbReducedContactPairs;
 		PxU32 NbDiscreteContactPairsTotal;
 		PxU32 NbDiscreteContactPairsWithCacheHits;
 		PxU32 NbDiscreteContactPairsWithContacts;
@@ -3782,6 +3791,9 @@ template<> struct PxEnumTraits< physx::PxSimulationStatistics::RbPairStatsType >
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, CompressedContactSize, PxSimulationStatisticsGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, RequiredContactConstraintMemory, PxSimulationStatisticsGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, PeakConstraintMemory, PxSimulationStatisticsGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, NbContactDataBlocksAllocated, PxSimulationStatisticsGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, PeakContactDataBlocksUsed, PxSimulationStatisticsGeneratedValues)
+	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, NbReducedContactPairs, PxSimulationStatisticsGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, NbDiscreteContactPairsTotal, PxSimulationStatisticsGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, NbDiscreteContactPairsWithCacheHits, PxSimulationStatisticsGeneratedValues)
 	DEFINE_PROPERTY_TO_VALUE_STRUCT_MAP( PxSimulationStatistics, NbDiscreteContactPairsWithContacts, PxSimulationStatisticsGeneratedValues)
@@ -3834,6 +3846,9 @@ template<> struct PxEnumTraits< physx::PxSimulationStatistics::RbPairStatsType >
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_CompressedContactSize, PxSimulationStatistics, PxU32, PxU32 > CompressedContactSize;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_RequiredContactConstraintMemory, PxSimulationStatistics, PxU32, PxU32 > RequiredContactConstraintMemory;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_PeakConstraintMemory, PxSimulationStatistics, PxU32, PxU32 > PeakConstraintMemory;
+		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_NbContactDataBlocksAllocated, PxSimulationStatistics, PxU32, PxU32 > NbContactDataBlocksAllocated;
+		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_PeakContactDataBlocksUsed, PxSimulationStatistics, PxU32, PxU32 > PeakContactDataBlocksUsed;
+		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_NbReducedContactPairs, PxSimulationStatistics, PxU32, PxU32 > NbReducedContactPairs;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_NbDiscreteContactPairsTotal, PxSimulationStatistics, PxU32, PxU32 > NbDiscreteContactPairsTotal;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_NbDiscreteContactPairsWithCacheHits, PxSimulationStatistics, PxU32, PxU32 > NbDiscreteContactPairsWithCacheHits;
 		PxPropertyInfo<PX_PROPERTY_INFO_NAME::PxSimulationStatistics_NbDiscreteContactPairsWithContacts, PxSimulationStatistics, PxU32, PxU32 > NbDiscreteContactPairsWithContacts;
@@ -3889,7 +3904,7 @@ template<> struct PxEnumTraits< physx::PxSimulationStatistics::RbPairStatsType >
 			PX_UNUSED(inStartIndex);
 			return inStartIndex;
 		}
-		static PxU32 instancePropertyCount() { return 48; }
+		static PxU32 instancePropertyCount() { return 51; }
 		static PxU32 totalPropertyCount() { return instancePropertyCount(); }
 		template<typename TOperator>
 		PxU32 visitInstanceProperties( TOperator inOperator, PxU32 inStartIndex = 0 ) const
@@ -3908,43 +3923,46 @@ template<> struct PxEnumTraits< physx::PxSimulationStatistics::RbPairStatsType >
 			inOperator( CompressedContactSize, inStartIndex + 9 );; 
 			inOperator( RequiredContactConstraintMemory, inStartIndex + 10 );; 
 			inOperator( PeakConstraintMemory, inStartIndex + 11 );; 
-			inOperator( NbDiscreteContactPairsTotal, inStartIndex + 12 );; 
-			inOperator( NbDiscreteContactPairsWithCacheHits, inStartIndex + 13 );; 
-			inOperator( NbDiscreteContactPairsWithContacts, inStartIndex + 14 );; 
-			inOperator( NbNewPairs, inStartIndex + 15 );; 
-			inOperator( NbLostPairs, inStartIndex + 16 );; 
-			inOperator( NbNewTouches, inStartIndex + 17 );; 
-			inOperator( NbLostTouches, inStartIndex + 18 );; 
-			inOperator( NbPartitions, inStartIndex + 19 );; 
-			inOperator( GpuMemParticles, inStartIndex + 20 );; 
-			inOperator( GpuMemSoftBodies, inStartIndex + 21 );; 
-			inOperator( GpuMemFEMCloths, inStartIndex + 22 );; 
-			inOperator( GpuMemHairSystems, inStartIndex + 23 );; 
-			inOperator( GpuMemHeap, inStartIndex + 24 );; 
-			inOperator( GpuMemHeapBroadPhase, inStartIndex + 25 );; 
-			inOperator( GpuMemHeapNarrowPhase, inStartIndex + 26 );; 
-			inOperator( GpuMemHeapSolver, inStartIndex + 27 );; 
-			inOperator( GpuMemHeapArticulation, inStartIndex + 28 );; 
-			inOperator( GpuMemHeapSimulation, inStartIndex + 29 );; 
-			inOperator( GpuMemHeapSimulationArticulation, inStartIndex + 30 );; 
-			inOperator( GpuMemHeapSimulationParticles, inStartIndex + 31 );; 
-			inOperator( GpuMemHeapSimulationSoftBody, inStartIndex + 32 );; 
-			inOperator( GpuMemHeapSimulationFEMCloth, inStartIndex + 33 );; 
-			inOperator( GpuMemHeapSimulationHairSystem, inStartIndex + 34 );; 
-			inOperator( GpuMemHeapParticles, inStartIndex + 35 );; 
-			inOperator( GpuMemHeapSoftBodies, inStartIndex + 36 );; 
-			inOperator( GpuMemHeapFEMCloths, inStartIndex + 37 );; 
-			inOperator( GpuMemHeapHairSystems, inStartIndex + 38 );; 
-			inOperator( GpuMemHeapOther, inStartIndex + 39 );; 
-			inOperator( GpuDynamicsMemoryConfigStatistics, inStartIndex + 40 );; 
-			inOperator( NbBroadPhaseAdds, inStartIndex + 41 );; 
-			inOperator( NbBroadPhaseRemoves, inStartIndex + 42 );; 
-			inOperator( NbDiscreteContactPairs, inStartIndex + 43 );; 
-			inOperator( NbModifiedContactPairs, inStartIndex + 44 );; 
-			inOperator( NbCCDPairs, inStartIndex + 45 );; 
-			inOperator( NbTriggerPairs, inStartIndex + 46 );; 
-			inOperator( NbShapes, inStartIndex + 47 );; 
-			return 48 + inStartIndex;
+			inOperator( NbContactDataBlocksAllocated, inStartIndex + 12 );; 
+			inOperator( PeakContactDataBlocksUsed, inStartIndex + 13 );; 
+			inOperator( NbReducedContactPairs, inStartIndex + 14 );; 
+			inOperator( NbDiscreteContactPairsTotal, inStartIndex + 15 );; 
+			inOperator( NbDiscreteContactPairsWithCacheHits, inStartIndex + 16 );; 
+			inOperator( NbDiscreteContactPairsWithContacts, inStartIndex + 17 );; 
+			inOperator( NbNewPairs, inStartIndex + 18 );; 
+			inOperator( NbLostPairs, inStartIndex + 19 );; 
+			inOperator( NbNewTouches, inStartIndex + 20 );; 
+			inOperator( NbLostTouches, inStartIndex + 21 );; 
+			inOperator( NbPartitions, inStartIndex + 22 );; 
+			inOperator( GpuMemParticles, inStartIndex + 23 );; 
+			inOperator( GpuMemSoftBodies, inStartIndex + 24 );; 
+			inOperator( GpuMemFEMCloths, inStartIndex + 25 );; 
+			inOperator( GpuMemHairSystems, inStartIndex + 26 );; 
+			inOperator( GpuMemHeap, inStartIndex + 27 );; 
+			inOperator( GpuMemHeapBroadPhase, inStartIndex + 28 );; 
+			inOperator( GpuMemHeapNarrowPhase, inStartIndex + 29 );; 
+			inOperator( GpuMemHeapSolver, inStartIndex + 30 );; 
+			inOperator( GpuMemHeapArticulation, inStartIndex + 31 );; 
+			inOperator( GpuMemHeapSimulation, inStartIndex + 32 );; 
+			inOperator( GpuMemHeapSimulationArticulation, inStartIndex + 33 );; 
+			inOperator( GpuMemHeapSimulationParticles, inStartIndex + 34 );; 
+			inOperator( GpuMemHeapSimulationSoftBody, inStartIndex + 35 );; 
+			inOperator( GpuMemHeapSimulationFEMCloth, inStartIndex + 36 );; 
+			inOperator( GpuMemHeapSimulationHairSystem, inStartIndex + 37 );; 
+			inOperator( GpuMemHeapParticles, inStartIndex + 38 );; 
+			inOperator( GpuMemHeapSoftBodies, inStartIndex + 39 );; 
+			inOperator( GpuMemHeapFEMCloths, inStartIndex + 40 );; 
+			inOperator( GpuMemHeapHairSystems, inStartIndex + 41 );; 
+			inOperator( GpuMemHeapOther, inStartIndex + 42 );; 
+			inOperator( GpuDynamicsMemoryConfigStatistics, inStartIndex + 43 );; 
+			inOperator( NbBroadPhaseAdds, inStartIndex + 44 );; 
+			inOperator( NbBroadPhaseRemoves, inStartIndex + 45 );; 
+			inOperator( NbDiscreteContactPairs, inStartIndex + 46 );; 
+			inOperator( NbModifiedContactPairs, inStartIndex + 47 );; 
+			inOperator( NbCCDPairs, inStartIndex + 48 );; 
+			inOperator( NbTriggerPairs, inStartIndex + 49 );; 
+			inOperator( NbShapes, inStartIndex + 50 );; 
+			return 51 + inStartIndex;
 		}
 	};
 	template<> struct PxClassInfoTraits<PxSimulationStatistics>
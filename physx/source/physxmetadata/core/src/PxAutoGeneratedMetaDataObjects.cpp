@@ -1267,6 +1267,8 @@ inline PxU32 getPxSceneDescNbContactDataBlocks( const PxSceneDesc* inOwner ) { r
 inline void setPxSceneDescNbContactDataBlocks( PxSceneDesc* inOwner, PxU32 inData) { inOwner->nbContactDataBlocks = inData; }
 inline PxU32 getPxSceneDescMaxNbContactDataBlocks( const PxSceneDesc* inOwner ) { return inOwner->maxNbContactDataBlocks; }
 inline void setPxSceneDescMaxNbContactDataBlocks( PxSceneDesc* inOwner, PxU32 inData) { inOwner->maxNbContactDataBlocks = inData; }
+inline PxU32 getPxSceneDescContactDataBlockIdleFrames( const PxSceneDesc* inOwner ) { return inOwner->contactDataBlockIdleFrames; }
+inline void setPxSceneDescContactDataBlockIdleFrames( PxSceneDesc* inOwner, PxU32 inData) { inOwner->contactDataBlockIdleFrames = inData; }
 inline PxReal getPxSceneDescMaxBiasCoefficient( const PxSceneDesc* inOwner ) { return inOwner->maxBiasCoefficient; }
 inline void setPxSceneDescMaxBiasCoefficient( PxSceneDesc* inOwner, PxReal inData) { inOwner->maxBiasCoefficient = inData; }
 inline PxU32 getPxSceneDescContactReportStreamBufferSize( const PxSceneDesc* inOwner ) { return inOwner->contactReportStreamBufferSize; }
@@ -1319,6 +1321,7 @@ PX_PHYSX_CORE_API PxSceneDescGeneratedInfo::PxSceneDescGeneratedInfo()
 	, SolverArticulationBatchSize( "SolverArticulationBatchSize", setPxSceneDescSolverArticulationBatchSize, getPxSceneDescSolverArticulationBatchSize )
 	, NbContactDataBlocks( "NbContactDataBlocks", setPxSceneDescNbContactDataBlocks, getPxSceneDescNbContactDataBlocks )
 	, MaxNbContactDataBlocks( "MaxNbContactDataBlocks", setPxSceneDescMaxNbContactDataBlocks, getPxSceneDescMaxNbContactDataBlocks )
+	, ContactDataBlockIdleFrames( "ContactDataBlockIdleFrames", setPxSceneDescContactDataBlockIdleFrames, getPxSceneDescContactDataBlockIdleFrames )
 	, MaxBiasCoefficient( "MaxBiasCoefficient", setPxSceneDescMaxBiasCoefficient, getPxSceneDescMaxBiasCoefficient )
 	, ContactReportStreamBufferSize( "ContactReportStreamBufferSize", setPxSceneDescContactReportStreamBufferSize, getPxSceneDescContactReportStreamBufferSize )
 	, CcdMaxPasses( "CcdMaxPasses", setPxSceneDescCcdMaxPasses, getPxSceneDescCcdMaxPasses )
@@ -1360,6 +1363,7 @@ PX_PHYSX_CORE_API PxSceneDescGeneratedValues::PxSceneDescGeneratedValues( const
 		,SolverArticulationBatchSize( inSource->solverArticulationBatchSize )
 		,NbContactDataBlocks( inSource->nbContactDataBlocks )
 		,MaxNbContactDataBlocks( inSource->maxNbContactDataBlocks )
+		,ContactDataBlockIdleFrames( inSource->contactDataBlockIdleFrames )
 		,MaxBiasCoefficient( inSource->maxBiasCoefficient )
 		,ContactReportStreamBufferSize( inSource->contactReportStreamBufferSize )
 		,CcdMaxPasses( inSource->ccdMaxPasses )
@@ -1577,6 +1581,12 @@ inline PxU32 getPxSimulationStatisticsRequiredContactConstraintMemory( const PxS
 inline void setPxSimulationStatisticsRequiredContactConstraintMemory( PxSimulationStatistics* inOwner, PxU32 inData) { inOwner->requiredContactConstraintMemory = inData; }
 inline PxU32 getPxSimulationStatisticsPeakConstraintMemory( const PxSimulationStatistics* inOwner ) { return inOwner->peakConstraintMemory; }
 inline void setPxSimulationStatisticsPeakConstraintMemory( PxSimulationStatistics* inOwner, PxU32 inData) { inOwner->peakConstraintMemory = inData; }
+inline PxU32 getPxSimulationStatisticsNbContactDataBlocksAllocated( const PxSimulationStatistics* inOwner ) { return inOwner->nbContactDataBlocksAllocated; }
+inline void setPxSimulationStatisticsNbContactDataBlocksAllocated( PxSimulationStatistics* inOwner, PxU32 inData) { inOwner->nbContactDataBlocksAllocated = inData; }
+inline PxU32 getPxSimulationStatisticsPeakContactDataBlocksUsed( const PxSimulationStatistics* inOwner ) { return inOwner->peakContactDataBlocksUsed; }
+inline void setPxSimulationStatisticsPeakContactDataBlocksUsed( PxSimulationStatistics* inOwner, PxU32 inData) { inOwner->peakContactDataBlocksUsed = inData; }
+inline PxU32 getPxSimulationStatisticsNbReducedContactPairs( const PxSimulationStatistics* inOwner ) { return inOwner->nbReducedContactPairs; }
+inline void setPxSimulationStatisticsNbReducedContactPairs( PxSimulationStatistics* inOwner, PxU32 inData) { inOwner->nbReducedContactPairs = inData; }
 inline PxU32 getPxSimulationStatisticsNbDiscreteContactPairsTotal( const PxSimulationStatistics* inOwner ) { return inOwner->nbDiscreteContactPairsTotal; }
 inline void setPxSimulationStatisticsNbDiscreteContactPairsTotal( PxSimulationStatistics* inOwner, PxU32 inData) { inOwner->nbDiscreteContactPairsTotal = inData; }
 inline PxU32 getPxSimulationStatisticsNbDiscreteContactPairsWithCacheHits( const PxSimulationStatistics* inOwner ) { return inOwner->nbDiscreteContactPairsWithCacheHits; }
@@ -1652,6 +1662,9 @@ PX_PHYSX_CORE_API PxSimulationStatisticsGeneratedInfo::PxSimulationStatisticsGen
 	, CompressedContactSize( "CompressedContactSize", setPxSimulationStatisticsCompressedContactSize, getPxSimulationStatisticsCompressedContactSize )
 	, RequiredContactConstraintMemory( "RequiredContactConstraintMemory", setPxSimulationStatisticsRequiredContactConstraintMemory, getPxSimulationStatisticsRequiredContactConstraintMemory )
 	, PeakConstraintMemory( "PeakConstraintMemory", setPxSimulationStatisticsPeakConstraintMemory, getPxSimulationStatisticsPeakConstraintMemory )
+	, NbContactDataBlocksAllocated( "NbContactDataBlocksAllocated", setPxSimulationStatisticsNbContactDataBlocksAllocated, getPxSimulationStatisticsNbContactDataBlocksAllocated )
+	, PeakContactDataBlocksUsed( "PeakContactDataBlocksUsed", setPxSimulationStatisticsPeakContactDataBlocksUsed, getPxSimulationStatisticsPeakContactDataBlocksUsed )
+	, NbReducedContactPairs( "NbReducedContactPairs", setPxSimulationStatisticsNbReducedContactPairs, getPxSimulationStatisticsNbReducedContactPairs )
 	, NbDiscreteContactPairsTotal( "NbDiscreteContactPairsTotal", setPxSimulationStatisticsNbDiscreteContactPairsTotal, getPxSimulationStatisticsNbDiscreteContactPairsTotal )
 	, NbDiscreteContactPairsWithCacheHits( "NbDiscreteContactPairsWithCacheHits", setPxSimulationStatisticsNbDiscreteContactPairsWithCacheHits, getPxSimulationStatisticsNbDiscreteContactPairsWithCacheHits )
 	, NbDiscreteContactPairsWithContacts( "NbDiscreteContactPairsWithContacts", setPxSimulationStatisticsNbDiscreteContactPairsWithContacts, getPxSimulationStatisticsNbDiscreteContactPairsWithContacts )
@@ -1697,6 +1710,9 @@ PX_PHYSX_CORE_API PxSimulationStatisticsGeneratedValues::PxSimulationStatisticsG
 		,CompressedContactSize( inSource->compressedContactSize )
 		,RequiredContactConstraintMemory( inSource->requiredContactConstraintMemory )
 		,PeakConstraintMemory( inSource->peakConstraintMemory )
+		,NbContactDataBlocksAllocated( inSource->nbContactDataBlocksAllocated )
+		,PeakContactDataBlocksUsed( inSource->peakContactDataBlocksUsed )
+		,NbReducedContactPairs( inSource->nbReducedContactPairs )
 		,NbDiscreteContactPairsTotal( inSource->nbDiscreteContactPairsTotal )
 		,NbDiscreteContactPairsWithCacheHits( inSource->nbDiscreteContactPairsWithCacheHits )
 		,NbDiscreteContactPairsWithContacts( inSource->nbDiscreteContactPairsWithContacts )
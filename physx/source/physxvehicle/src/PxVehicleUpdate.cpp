@@ -27,6 +27,7 @@
 // Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
 
 #include "foundation/PxQuat.h"
+#include "foundation/PxArray.h"
 #include "foundation/PxBitMap.h"
 #include "common/PxProfileZone.h"
 #include "common/PxTolerancesScale.h"
@@ -52,6 +53,7 @@
 #include "foundation/PxUtilities.h"
 #include "foundation/PxFPU.h"
 #include "CmUtils.h"
+#include "CmParallelFor.h"
 
 using namespace physx;
 using namespace Cm;
@@ -7080,17 +7082,107 @@ void PxVehicleUpdate::updatePost
 }
 
 
+////////////////////////////////////////////////////////////////////////////
+//Parallel update of chunks of vehicles.
+//All writes to actors are deferred to PxVehicleConcurrentUpdateData so the
+//vehicles of different chunks never touch the same data.
+////////////////////////////////////////////////////////////////////////////
+
+#define VEHICLE_UPDATE_BATCH_SIZE	8
+
+struct VehicleParallelUpdateContext
+{
+	PxF32 timestep;
+	const PxVec3* gravity;
+	const PxVehicleDrivableSurfaceToTireFrictionPairs* vehicleDrivableSurfaceToTireFrictionPairs;
+	PxVehicleWheels** vehicles;
+	PxVehicleWheelQueryResult* vehicleWheelQueryResults;
+	PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates;
+	const PxVehicleContext* context;
+};
+
+static void updateVehicleBatch(void* userData, PxU32 startIndex, PxU32 endIndex)
+{
+	const VehicleParallelUpdateContext& updateContext = *reinterpret_cast<const VehicleParallelUpdateContext*>(userData);
+
+	PxVehicleUpdate::update(updateContext.timestep, *updateContext.gravity, *updateContext.vehicleDrivableSurfaceToTireFrictionPairs,
+		endIndex - startIndex, updateContext.vehicles + startIndex,
+		updateContext.vehicleWheelQueryResults ? updateContext.vehicleWheelQueryResults + startIndex : NULL,
+		updateContext.vehicleConcurrentUpdates + startIndex,
+		NULL, *updateContext.context);
+}
+
+static bool canUpdateVehiclesInParallel(const PxU32 numVehicles, PxVehicleWheels** vehicles)
+{
+#if PX_VEHICLE_PROFILE
+	//The profiling timers are global.
+	PX_UNUSED(numVehicles);
+	PX_UNUSED(vehicles);
+	return false;
+#else
+	//Worker threads cannot take the read locks of scenes that require them while the calling thread owns the lock.
+	for(PxU32 i=0;i<numVehicles;i++)
+	{
+		const PxScene* scene = vehicles[i]->getRigidDynamicActor()->getScene();
+		if(scene && (scene->getFlags() & PxSceneFlag::eREQUIRE_RW_LOCK))
+			return false;
+	}
+	return true;
+#endif
+}
+
 void physx::PxVehicleUpdates
 (const PxReal timestep, const PxVec3& gravity, const PxVehicleDrivableSurfaceToTireFrictionPairs& vehicleDrivableSurfaceToTireFrictionPairs, 
  const PxU32 numVehicles, PxVehicleWheels** vehicles, PxVehicleWheelQueryResult* vehicleWheelQueryResults, PxVehicleConcurrentUpdateData* vehicleConcurrentUpdates,
- const PxVehicleContext& context)
+ const PxVehicleContext& context, PxCpuDispatcher* dispatcher)
 {
 	PX_PROFILE_ZONE("PxVehicleUpdates::ePROFILE_UPDATES",0);
 
 	PX_CHECK_AND_RETURN(context.isValid(), "PxVehicleUpdates: provided PxVehicleContext is not valid");
 
-	PxVehicleUpdate::update(timestep, gravity, vehicleDrivableSurfaceToTireFrictionPairs, numVehicles, vehicles, vehicleWheelQueryResults, vehicleConcurrentUpdates,
-		NULL, context);
+	if(!dispatcher)
+	{
+		PxVehicleUpdate::update(timestep, gravity, vehicleDrivableSurfaceToTireFrictionPairs, numVehicles, vehicles, vehicleWheelQueryResults, vehicleConcurrentUpdates,
+			NULL, context);
+		return;
+	}
+
+	if(!canUpdateVehiclesInParallel(numVehicles, vehicles))
+		dispatcher = NULL;
+
+	//Without user buffers the actor writes are deferred to temporary buffers that are applied once all vehicles are updated.
+	PxArray<PxVehicleConcurrentUpdateData> concurrentUpdates;
+	PxArray<PxVehicleWheelConcurrentUpdateData> concurrentWheelUpdates;
+	if(!vehicleConcurrentUpdates)
+	{
+		PxU32 numWheels=0;
+		for(PxU32 i=0;i<numVehicles;i++)
+			numWheels += 4*vehicles[i]->mWheelsSimData.getNbWheels4();
+
+		concurrentUpdates.resize(numVehicles);
+		concurrentWheelUpdates.resize(numWheels);
+
+		numWheels=0;
+		for(PxU32 i=0;i<numVehicles;i++)
+		{
+			concurrentUpdates[i].concurrentWheelUpdates = concurrentWheelUpdates.begin() + numWheels;
+			concurrentUpdates[i].nbConcurrentWheelUpdates = 4*vehicles[i]->mWheelsSimData.getNbWheels4();
+			numWheels += concurrentUpdates[i].nbConcurrentWheelUpdates;
+		}
+	}
+
+	VehicleParallelUpdateContext updateContext;
+	updateContext.timestep = timestep;
+	updateContext.gravity = &gravity;
+	updateContext.vehicleDrivableSurfaceToTireFrictionPairs = &vehicleDrivableSurfaceToTireFrictionPairs;
+	updateContext.vehicles = vehicles;
+	updateContext.vehicleWheelQueryResults = vehicleWheelQueryResults;
+	updateContext.vehicleConcurrentUpdates = vehicleConcurrentUpdates ? vehicleConcurrentUpdates : concurrentUpdates.begin();
+	updateContext.context = &context;
+	Cm::parallelFor(dispatcher, numVehicles, VEHICLE_UPDATE_BATCH_SIZE, updateVehicleBatch, &updateContext);
+
+	if(!vehicleConcurrentUpdates)
+		PxVehicleUpdate::updatePost(concurrentUpdates.begin(), numVehicles, vehicles, context);
 }
 
 void physx::PxVehiclePostUpdates
@@ -0,0 +1,1150 @@
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of NVIDIA CORPORATION nor the names of its
+//    contributors may be used to endorse or promote products derived
+//    from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+// OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Copyright (c) 2008-2024 NVIDIA Corporation. All rights reserved.
+// Copyright (c) 2004-2008 AGEIA Technologies, Inc. All rights reserved.
+// Copyright (c) 2001-2004 NovodeX AG. All rights reserved.  
+
+#include "foundation/PxArray.h"
+#include "foundation/PxAtomic.h"
+#include "foundation/PxBounds3.h"
+#include "foundation/PxFPU.h"
+#include "foundation/PxMath.h"
+#include "foundation/PxSort.h"
+#include "foundation/PxSync.h"
+#include "foundation/PxUserAllocated.h"
+#include "foundation/PxVecMath.h"
+
+#include "task/PxCpuDispatcher.h"
+#include "task/PxTask.h"
+
+#include "vehicle2/PxVehicleParams.h"
+
+#include "vehicle2/batch/PxVehicleBatchData.h"
+#include "vehicle2/batch/PxVehicleBatchFunctions.h"
+
+#include "vehicle2/drivetrain/PxVehicleDrivetrainFunctions.h"
+#include "vehicle2/drivetrain/PxVehicleDrivetrainParams.h"
+#include "vehicle2/drivetrain/PxVehicleDrivetrainStates.h"
+
+#include "vehicle2/physxRoadGeometry/PxVehiclePhysXRoadGeometryFunctions.h"
+#include "vehicle2/physxRoadGeometry/PxVehiclePhysXRoadGeometryParams.h"
+#include "vehicle2/physxRoadGeometry/PxVehiclePhysXRoadGeometryState.h"
+
+#include "vehicle2/rigidBody/PxVehicleRigidBodyParams.h"
+#include "vehicle2/rigidBody/PxVehicleRigidBodyStates.h"
+
+#include "vehicle2/roadGeometry/PxVehicleRoadGeometryState.h"
+
+#include "vehicle2/suspension/PxVehicleSuspensionFunctions.h"
+#include "vehicle2/suspension/PxVehicleSuspensionHelpers.h"
+#include "vehicle2/suspension/PxVehicleSuspensionParams.h"
+#include "vehicle2/suspension/PxVehicleSuspensionStates.h"
+
+#include "vehicle2/tire/PxVehicleTireFunctions.h"
+#include "vehicle2/tire/PxVehicleTireParams.h"
+#include "vehicle2/tire/PxVehicleTireStates.h"
+
+#include "vehicle2/wheel/PxVehicleWheelParams.h"
+#include "vehicle2/wheel/PxVehicleWheelStates.h"
+
+#include "PxRigidStatic.h"
+
+#include "common/PxProfileZone.h"
+
+namespace physx
+{
+namespace vehicle2
+{
+
+namespace
+{
+
+////////////////////////////////////////////////////////////////////////////
+//Parallel processing of chunks of vehicles.
+//The vehicle SDK only sees the public headers so this is a minimal version
+//of the parallel-for used in the core SDK: the calling thread and up to
+//BATCH_MAX_NB_TASKS worker tasks pick chunks of vehicles until none is left.
+////////////////////////////////////////////////////////////////////////////
+
+#define BATCH_MAX_NB_TASKS				64
+#define BATCH_NB_VEHICLES_PER_CHUNK		32
+
+typedef void (*BatchCallback)(void* userData, PxU32 startIndex, PxU32 endIndex);
+
+class BatchJob;
+
+class BatchTask : public PxBaseTask
+{
+public:
+	virtual	void		run()					PX_OVERRIDE;
+	virtual	const char*	getName()		const	PX_OVERRIDE	{ return "PxVehicleBatchUpdate";	}
+	virtual	void		addReference()			PX_OVERRIDE	{}
+	virtual	void		removeReference()		PX_OVERRIDE	{}
+	virtual	int32_t		getReference()	const	PX_OVERRIDE	{ return 1;							}
+	virtual	void		release()				PX_OVERRIDE;
+
+	BatchJob*	mJob;
+};
+
+//The job is shared by the calling thread and the submitted tasks. It is ref-counted 
+//because a task can start (and find nothing left to do) after the caller has returned.
+class BatchJob : public PxUserAllocated
+{
+public:
+	BatchJob(const PxU32 nbItems, BatchCallback callback, void* userData, const PxU32 nbTasks)
+		: mCallback(callback),
+		  mUserData(userData),
+		  mNbItems(nbItems),
+		  mNbChunks((nbItems + BATCH_NB_VEHICLES_PER_CHUNK - 1) / BATCH_NB_VEHICLES_PER_CHUNK),
+		  mNextChunk(0),
+		  mNbDoneChunks(0),
+		  mRefCount(PxI32(nbTasks + 1))
+	{
+		for (PxU32 i = 0; i < nbTasks; i++)
+			mTasks[i].mJob = this;
+	}
+
+	void processChunks()
+	{
+		for (;;)
+		{
+			const PxU32 chunkIndex = PxU32(PxAtomicIncrement(&mNextChunk) - 1);
+			if (chunkIndex >= mNbChunks)
+				return;
+
+			const PxU32 startIndex = chunkIndex * BATCH_NB_VEHICLES_PER_CHUNK;
+			const PxU32 endIndex = PxMin(startIndex + BATCH_NB_VEHICLES_PER_CHUNK, mNbItems);
+			(mCallback)(mUserData, startIndex, endIndex);
+
+			if (PxU32(PxAtomicIncrement(&mNbDoneChunks)) == mNbChunks)
+				mDone.set();
+		}
+	}
+
+	void releaseReference()
+	{
+		if (!PxAtomicDecrement(&mRefCount))
+			PX_DELETE_THIS;
+	}
+
+	const BatchCallback	mCallback;
+	void* const			mUserData;
+	const PxU32			mNbItems;
+	const PxU32			mNbChunks;
+	volatile PxI32		mNextChunk;
+	volatile PxI32		mNbDoneChunks;
+	volatile PxI32		mRefCount;
+	PxSync				mDone;
+	BatchTask			mTasks[BATCH_MAX_NB_TASKS];
+};
+
+void BatchTask::run()
+{
+	mJob->processChunks();
+}
+
+void BatchTask::release()
+{
+	mJob->releaseReference();
+}
+
+static void processBatch(PxCpuDispatcher* dispatcher, const PxU32 nbItems, BatchCallback callback, void* userData)
+{
+	if (!nbItems)
+		return;
+
+	const PxU32 nbChunks = (nbItems + BATCH_NB_VEHICLES_PER_CHUNK - 1) / BATCH_NB_VEHICLES_PER_CHUNK;
+
+	PxU32 nbTasks = 0;
+	if (dispatcher && nbChunks > 1)
+		nbTasks = PxMin(PxMin(dispatcher->getWorkerCount(), nbChunks - 1), PxU32(BATCH_MAX_NB_TASKS));
+
+	if (!nbTasks)
+	{
+		(callback)(userData, 0, nbItems);
+		return;
+	}
+
+	BatchJob* job = PX_NEW(BatchJob)(nbItems, callback, userData, nbTasks);
+
+	for (PxU32 i = 0; i < nbTasks; i++)
+		dispatcher->submitTask(job->mTasks[i]);
+
+	job->processChunks();
+
+	//All chunks have been picked up at this point, only wait for the ones still running on other threads.
+	job->mDone.wait();
+
+	job->releaseReference();
+}
+
+////////////////////////////////////////////////////////////////////////////
+//SIMD helpers.
+//Four wheels, possibly from different vehicles, are processed at once. Each
+//helper replicates the operation order of its scalar PxVec3/PxQuat 
+//counterpart so that the results are bit-identical to the scalar code.
+////////////////////////////////////////////////////////////////////////////
+
+using namespace aos;
+
+struct Vec3SoA
+{
+	Vec4V x, y, z;
+};
+
+struct QuatSoA
+{
+	Vec4V x, y, z, w;
+};
+
+//V4Neg computes 0-a, which loses the sign of zero. Multiplying by -1 matches the scalar unary minus.
+PX_FORCE_INLINE Vec4V negate(const Vec4V a)
+{
+	return V4Mul(a, V4Load(-1.0f));
+}
+
+PX_FORCE_INLINE Vec3SoA add(const Vec3SoA& a, const Vec3SoA& b)
+{
+	const Vec3SoA r = { V4Add(a.x, b.x), V4Add(a.y, b.y), V4Add(a.z, b.z) };
+	return r;
+}
+
+PX_FORCE_INLINE Vec3SoA sub(const Vec3SoA& a, const Vec3SoA& b)
+{
+	const Vec3SoA r = { V4Sub(a.x, b.x), V4Sub(a.y, b.y), V4Sub(a.z, b.z) };
+	return r;
+}
+
+PX_FORCE_INLINE Vec3SoA scale(const Vec3SoA& a, const Vec4V s)
+{
+	const Vec3SoA r = { V4Mul(a.x, s), V4Mul(a.y, s), V4Mul(a.z, s) };
+	return r;
+}
+
+PX_FORCE_INLINE Vec3SoA select(const BoolV c, const Vec3SoA& a, const Vec3SoA& b)
+{
+	const Vec3SoA r = { V4Sel(c, a.x, b.x), V4Sel(c, a.y, b.y), V4Sel(c, a.z, b.z) };
+	return r;
+}
+
+PX_FORCE_INLINE Vec4V dot(const Vec3SoA& a, const Vec3SoA& b)
+{
+	return V4Add(V4Add(V4Mul(a.x, b.x), V4Mul(a.y, b.y)), V4Mul(a.z, b.z));
+}
+
+PX_FORCE_INLINE Vec3SoA cross(const Vec3SoA& a, const Vec3SoA& b)
+{
+	const Vec3SoA r =
+	{
+		V4Sub(V4Mul(a.y, b.z), V4Mul(a.z, b.y)),
+		V4Sub(V4Mul(a.z, b.x), V4Mul(a.x, b.z)),
+		V4Sub(V4Mul(a.x, b.y), V4Mul(a.y, b.x))
+	};
+	return r;
+}
+
+//See PxQuat::rotate()
+PX_FORCE_INLINE Vec3SoA rotate(const QuatSoA& q, const Vec3SoA& v)
+{
+	const Vec4V two = V4Load(2.0f);
+	const Vec4V vx = V4Mul(two, v.x);
+	const Vec4V vy = V4Mul(two, v.y);
+	const Vec4V vz = V4Mul(two, v.z);
+	const Vec4V w2 = V4Sub(V4Mul(q.w, q.w), V4Load(0.5f));
+	const Vec4V dot2 = V4Add(V4Add(V4Mul(q.x, vx), V4Mul(q.y, vy)), V4Mul(q.z, vz));
+	const Vec3SoA r =
+	{
+		V4Add(V4Add(V4Mul(vx, w2), V4Mul(V4Sub(V4Mul(q.y, vz), V4Mul(q.z, vy)), q.w)), V4Mul(q.x, dot2)),
+		V4Add(V4Add(V4Mul(vy, w2), V4Mul(V4Sub(V4Mul(q.z, vx), V4Mul(q.x, vz)), q.w)), V4Mul(q.y, dot2)),
+		V4Add(V4Add(V4Mul(vz, w2), V4Mul(V4Sub(V4Mul(q.x, vy), V4Mul(q.y, vx)), q.w)), V4Mul(q.z, dot2))
+	};
+	return r;
+}
+
+//A block of up to four lanes stored field by field, ready to be loaded as Vec4V.
+template<PxU32 NB_FIELDS, class Output>
+struct LaneBlock
+{
+	PX_ALIGN(16, PxF32 mData[NB_FIELDS][4]);
+	Output* mOutputs[4];
+	PxU32 mNbLanes;
+
+	PX_FORCE_INLINE LaneBlock() : mNbLanes(0) {}
+
+	PX_FORCE_INLINE void setScalar(const PxU32 lane, const PxU32 field, const PxF32 v)
+	{
+		mData[field][lane] = v;
+	}
+
+	PX_FORCE_INLINE void setVec3(const PxU32 lane, const PxU32 field, const PxVec3& v)
+	{
+		mData[field + 0][lane] = v.x;
+		mData[field + 1][lane] = v.y;
+		mData[field + 2][lane] = v.z;
+	}
+
+	PX_FORCE_INLINE void setQuat(const PxU32 lane, const PxU32 field, const PxQuat& q)
+	{
+		mData[field + 0][lane] = q.x;
+		mData[field + 1][lane] = q.y;
+		mData[field + 2][lane] = q.z;
+		mData[field + 3][lane] = q.w;
+	}
+
+	//Unused lanes replicate the first lane so that they only ever see valid inputs.
+	PX_FORCE_INLINE void padLanes()
+	{
+		for (PxU32 f = 0; f < NB_FIELDS; f++)
+		{
+			for (PxU32 i = mNbLanes; i < 4; i++)
+				mData[f][i] = mData[f][0];
+		}
+	}
+
+	PX_FORCE_INLINE Vec4V getScalar(const PxU32 field) const
+	{
+		return V4LoadA(mData[field]);
+	}
+
+	PX_FORCE_INLINE Vec3SoA getVec3(const PxU32 field) const
+	{
+		const Vec3SoA v = { V4LoadA(mData[field + 0]), V4LoadA(mData[field + 1]), V4LoadA(mData[field + 2]) };
+		return v;
+	}
+
+	PX_FORCE_INLINE QuatSoA getQuat(const PxU32 field) const
+	{
+		const QuatSoA q = { V4LoadA(mData[field + 0]), V4LoadA(mData[field + 1]), V4LoadA(mData[field + 2]), V4LoadA(mData[field + 3]) };
+		return q;
+	}
+};
+
+struct LaneResults
+{
+	PX_ALIGN(16, PxF32 mX[4]);
+	PX_ALIGN(16, PxF32 mY[4]);
+	PX_ALIGN(16, PxF32 mZ[4]);
+
+	PX_FORCE_INLINE void store(const Vec3SoA& v)
+	{
+		V4StoreA(v.x, mX);
+		V4StoreA(v.y, mY);
+		V4StoreA(v.z, mZ);
+	}
+
+	PX_FORCE_INLINE PxVec3 get(const PxU32 lane) const
+	{
+		return PxVec3(mX[lane], mY[lane], mZ[lane]);
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////
+//Suspension force.
+//SIMD version of PxVehicleSuspensionForceUpdate() for wheels that touch
+//the ground. Wheels in the air are handled by the caller.
+////////////////////////////////////////////////////////////////////////////
+
+struct SuspensionForceField
+{
+	enum Enum
+	{
+		eRIGID_BODY_ROTATION = 0,
+		eTRAVEL_DIR = eRIGID_BODY_ROTATION + 4,
+		eATTACHMENT_ROTATION = eTRAVEL_DIR + 3,
+		eATTACHMENT_POSITION = eATTACHMENT_ROTATION + 4,
+		eFORCE_APP_POINT = eATTACHMENT_POSITION + 3,
+		eGROUND_NORMAL = eFORCE_APP_POINT + 3,
+		eEXTERNAL_FORCE = eGROUND_NORMAL + 3,
+		eEXTERNAL_TORQUE = eEXTERNAL_FORCE + 3,
+		eJOUNCE = eEXTERNAL_TORQUE + 3,
+		eJOUNCE_SPEED,
+		eSTIFFNESS,
+		eDAMPING,
+		eSPRUNG_MASS,
+		eVEHICLE_MASS,
+		eNB_FIELDS
+	};
+};
+
+typedef LaneBlock<SuspensionForceField::eNB_FIELDS, PxVehicleSuspensionForce> SuspensionForceBlock;
+
+PX_FORCE_INLINE void addSuspensionForceLane
+(const PxVehicleSuspensionParams& suspParams,
+ const PxVehicleSuspensionForceParams& suspForceParams,
+ const PxVehicleRoadGeometryState& roadGeom, const PxVehicleSuspensionState& suspState,
+ const PxVehicleSuspensionComplianceState& compState, const PxVehicleRigidBodyState& rigidBodyState,
+ const PxReal vehicleMass,
+ PxVehicleSuspensionForce& suspForces, SuspensionForceBlock& block)
+{
+	const PxU32 lane = block.mNbLanes++;
+	block.setQuat(lane, SuspensionForceField::eRIGID_BODY_ROTATION, rigidBodyState.pose.q);
+	block.setVec3(lane, SuspensionForceField::eTRAVEL_DIR, suspParams.suspensionTravelDir);
+	block.setQuat(lane, SuspensionForceField::eATTACHMENT_ROTATION, suspParams.suspensionAttachment.q);
+	block.setVec3(lane, SuspensionForceField::eATTACHMENT_POSITION, suspParams.suspensionAttachment.p);
+	block.setVec3(lane, SuspensionForceField::eFORCE_APP_POINT, compState.suspForceAppPoint);
+	block.setVec3(lane, SuspensionForceField::eGROUND_NORMAL, roadGeom.plane.n);
+	block.setVec3(lane, SuspensionForceField::eEXTERNAL_FORCE, rigidBodyState.externalForce);
+	block.setVec3(lane, SuspensionForceField::eEXTERNAL_TORQUE, rigidBodyState.externalTorque);
+	block.setScalar(lane, SuspensionForceField::eJOUNCE, suspState.jounce);
+	block.setScalar(lane, SuspensionForceField::eJOUNCE_SPEED, suspState.jounceSpeed);
+	block.setScalar(lane, SuspensionForceField::eSTIFFNESS, suspForceParams.stiffness);
+	block.setScalar(lane, SuspensionForceField::eDAMPING, suspForceParams.damping);
+	block.setScalar(lane, SuspensionForceField::eSPRUNG_MASS, suspForceParams.sprungMass);
+	block.setScalar(lane, SuspensionForceField::eVEHICLE_MASS, vehicleMass);
+	block.mOutputs[lane] = &suspForces;
+}
+
+static void flushSuspensionForces(SuspensionForceBlock& block, const Vec3SoA& gravity)
+{
+	if (!block.mNbLanes)
+		return;
+
+	block.padLanes();
+
+	const Vec4V zero = V4Zero();
+	const Vec4V one = V4One();
+
+	const QuatSoA rigidBodyRotation = block.getQuat(SuspensionForceField::eRIGID_BODY_ROTATION);
+	const Vec3SoA groundNormal = block.getVec3(SuspensionForceField::eGROUND_NORMAL);
+	const Vec4V vehicleMass = block.getScalar(SuspensionForceField::eVEHICLE_MASS);
+
+	//See PxVehicleSuspensionForceUpdate() for a description of the force model.
+	const Vec3SoA suspDirWorld = rotate(rigidBodyRotation, block.getVec3(SuspensionForceField::eTRAVEL_DIR));
+	const Vec4V springForceMagnitude = negate(V4Add(
+		V4Mul(block.getScalar(SuspensionForceField::eJOUNCE), block.getScalar(SuspensionForceField::eSTIFFNESS)),
+		V4Mul(block.getScalar(SuspensionForceField::eJOUNCE_SPEED), block.getScalar(SuspensionForceField::eDAMPING))));
+	const Vec3SoA suspSpringForce = scale(suspDirWorld, springForceMagnitude);
+	const Vec4V suspSpringForceProjected = dot(groundNormal, suspSpringForce);
+
+	const Vec3SoA attachmentPosition = block.getVec3(SuspensionForceField::eATTACHMENT_POSITION);
+	const Vec3SoA comToSuspWorld = rotate(rigidBodyRotation, attachmentPosition);
+	const Vec3SoA externalForceLin = add(scale(gravity, vehicleMass), block.getVec3(SuspensionForceField::eEXTERNAL_FORCE));
+
+	const Vec4V comToSuspDistSqr = dot(comToSuspWorld, comToSuspWorld);
+	const BoolV hasLeverArm = V4IsGrtr(comToSuspDistSqr, zero);
+	const Vec4V recipComToSuspDistSqr = V4Div(one, V4Sel(hasLeverArm, comToSuspDistSqr, one));
+	const Vec3SoA zeroVec = { zero, zero, zero };
+	const Vec3SoA externalForceAng = select(hasLeverArm, 
+		scale(cross(block.getVec3(SuspensionForceField::eEXTERNAL_TORQUE), comToSuspWorld), recipComToSuspDistSqr), zeroVec);
+
+	const Vec3SoA externalForce = add(externalForceLin, externalForceAng);
+	const Vec3SoA externalForceSusp = scale(externalForce, V4Div(block.getScalar(SuspensionForceField::eSPRUNG_MASS), vehicleMass));
+
+	const BoolV isPushedTowardsGround = V4IsGrtr(zero, dot(groundNormal, externalForceSusp));
+	const Vec4V suspDirExternalForceMagn = dot(suspDirWorld, externalForceSusp);
+	const Vec3SoA collisionForce = sub(externalForceSusp, scale(suspDirWorld, suspDirExternalForceMagn));
+	const Vec4V suspCollisionForceProjected = negate(dot(groundNormal, collisionForce));
+
+	const Vec4V suspForceMagnitude = V4Sel(isPushedTowardsGround, 
+		V4Add(suspSpringForceProjected, suspCollisionForceProjected), suspSpringForceProjected);
+
+	//See setSuspensionForceAndTorque()
+	const Vec3SoA appPoint = add(rotate(block.getQuat(SuspensionForceField::eATTACHMENT_ROTATION), 
+		block.getVec3(SuspensionForceField::eFORCE_APP_POINT)), attachmentPosition);
+	const Vec3SoA r = rotate(rigidBodyRotation, appPoint);
+	const Vec3SoA f = scale(groundNormal, suspForceMagnitude);
+
+	LaneResults force, torque;
+	force.store(f);
+	torque.store(cross(r, f));
+	PX_ALIGN(16, PxF32 normalForce[4]);
+	V4StoreA(suspForceMagnitude, normalForce);
+
+	for (PxU32 i = 0; i < block.mNbLanes; i++)
+	{
+		PxVehicleSuspensionForce& out = *block.mOutputs[i];
+		out.force = force.get(i);
+		out.torque = torque.get(i);
+		out.normalForce = normalForce[i];
+	}
+
+	block.mNbLanes = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////
+//Tire force.
+//SIMD version of PxVehicleTireForcesUpdate() with the Michigan tire model 
+//for tires that have non-zero friction and load. The other tires are 
+//handled by the caller.
+////////////////////////////////////////////////////////////////////////////
+
+struct TireForceField
+{
+	enum Enum
+	{
+		eRIGID_BODY_ROTATION = 0,
+		eATTACHMENT_ROTATION = eRIGID_BODY_ROTATION + 4,
+		eATTACHMENT_POSITION = eATTACHMENT_ROTATION + 4,
+		eFORCE_APP_POINT = eATTACHMENT_POSITION + 3,
+		eLONG_DIR = eFORCE_APP_POINT + 3,
+		eLAT_DIR = eLONG_DIR + 3,
+		eFRICTION = eLAT_DIR + 3,
+		eLOAD,
+		eLONG_SLIP,
+		eLAT_SLIP,
+		eCAMBER,
+		eWHEEL_RADIUS,
+		eREST_LOAD,
+		eLAT_STIFF_X,
+		eLAT_STIFF_Y,
+		eLONG_STIFF,
+		eCAMBER_STIFF,
+		eNB_FIELDS
+	};
+};
+
+typedef LaneBlock<TireForceField::eNB_FIELDS, PxVehicleTireForce> TireForceBlock;
+
+PX_FORCE_INLINE void addTireForceLane
+(const PxVehicleWheelParams& whlParams, const PxVehicleSuspensionParams& suspParams,
+ const PxVehicleTireForceParams& trForceParams,
+ const PxVehicleSuspensionComplianceState& compState,
+ const PxVehicleTireGripState& trGripState, const PxVehicleTireDirectionState& trDirectionState,
+ const PxVehicleTireSlipState& trSlipState, const PxVehicleTireCamberAngleState& cmbAngleState,
+ const PxVehicleRigidBodyState& rigidBodyState,
+ PxVehicleTireForce& trForce, TireForceBlock& block)
+{
+	const PxU32 lane = block.mNbLanes++;
+	block.setQuat(lane, TireForceField::eRIGID_BODY_ROTATION, rigidBodyState.pose.q);
+	block.setQuat(lane, TireForceField::eATTACHMENT_ROTATION, suspParams.suspensionAttachment.q);
+	block.setVec3(lane, TireForceField::eATTACHMENT_POSITION, suspParams.suspensionAttachment.p);
+	block.setVec3(lane, TireForceField::eFORCE_APP_POINT, compState.tireForceAppPoint);
+	block.setVec3(lane, TireForceField::eLONG_DIR, trDirectionState.directions[PxVehicleTireDirectionModes::eLONGITUDINAL]);
+	block.setVec3(lane, TireForceField::eLAT_DIR, trDirectionState.directions[PxVehicleTireDirectionModes::eLATERAL]);
+	block.setScalar(lane, TireForceField::eFRICTION, trGripState.friction);
+	block.setScalar(lane, TireForceField::eLOAD, trGripState.load);
+	block.setScalar(lane, TireForceField::eLONG_SLIP, trSlipState.slips[PxVehicleTireDirectionModes::eLONGITUDINAL]);
+	block.setScalar(lane, TireForceField::eLAT_SLIP, trSlipState.slips[PxVehicleTireDirectionModes::eLATERAL]);
+	block.setScalar(lane, TireForceField::eCAMBER, cmbAngleState.camberAngle);
+	block.setScalar(lane, TireForceField::eWHEEL_RADIUS, whlParams.radius);
+	block.setScalar(lane, TireForceField::eREST_LOAD, trForceParams.restLoad);
+	block.setScalar(lane, TireForceField::eLAT_STIFF_X, trForceParams.latStiffX);
+	block.setScalar(lane, TireForceField::eLAT_STIFF_Y, trForceParams.latStiffY);
+	block.setScalar(lane, TireForceField::eLONG_STIFF, trForceParams.longStiff);
+	block.setScalar(lane, TireForceField::eCAMBER_STIFF, trForceParams.camberStiff);
+	block.mOutputs[lane] = &trForce;
+}
+
+//Same constants as the scalar tire model.
+#define BATCH_ONE_TWENTYSEVENTH 0.037037f
+#define BATCH_ONE_THIRD 0.33333f
+
+//See smoothingFunction1() in VhTireFunctions.cpp
+PX_FORCE_INLINE Vec4V smoothingFunction1(const Vec4V K)
+{
+	const Vec4V oneThird = V4Load(BATCH_ONE_THIRD);
+	const Vec4V oneTwentySeventh = V4Load(BATCH_ONE_TWENTYSEVENTH);
+	return V4Min(V4One(), V4Add(V4Sub(K, V4Mul(V4Mul(oneThird, K), K)), V4Mul(V4Mul(V4Mul(oneTwentySeventh, K), K), K)));
+}
+
+//See smoothingFunction2() in VhTireFunctions.cpp
+PX_FORCE_INLINE Vec4V smoothingFunction2(const Vec4V K)
+{
+	const Vec4V oneThird = V4Load(BATCH_ONE_THIRD);
+	const Vec4V oneTwentySeventh = V4Load(BATCH_ONE_TWENTYSEVENTH);
+	return V4Sub(V4Add(V4Sub(K, V4Mul(K, K)), V4Mul(V4Mul(V4Mul(oneThird, K), K), K)), V4Mul(V4Mul(V4Mul(V4Mul(oneTwentySeventh, K), K), K), K));
+}
+
+static void flushTireForces(TireForceBlock& block)
+{
+	if (!block.mNbLanes)
+		return;
+
+	block.padLanes();
+
+	const Vec4V zero = V4Zero();
+	const Vec4V one = V4One();
+
+	//See computeTireForceMichiganModel() in VhTireFunctions.cpp
+
+	//Clamp the slips to a minimum value.
+	const Vec4V minimumSlipThreshold = V4Load(1e-5f);
+	const Vec4V latSlipUnclamped = block.getScalar(TireForceField::eLAT_SLIP);
+	const Vec4V longSlipUnclamped = block.getScalar(TireForceField::eLONG_SLIP);
+	const Vec4V camberUnclamped = block.getScalar(TireForceField::eCAMBER);
+	const Vec4V latSlip = V4Sel(V4IsGrtrOrEq(V4Abs(latSlipUnclamped), minimumSlipThreshold), latSlipUnclamped, zero);
+	const Vec4V longSlip = V4Sel(V4IsGrtrOrEq(V4Abs(longSlipUnclamped), minimumSlipThreshold), longSlipUnclamped, zero);
+	const Vec4V camber = V4Sel(V4IsGrtrOrEq(V4Abs(camberUnclamped), minimumSlipThreshold), camberUnclamped, zero);
+
+	//Normalise the tire load and compute the lateral stiffness.
+	const Vec4V tireFriction = block.getScalar(TireForceField::eFRICTION);
+	const Vec4V tireLoad = block.getScalar(TireForceField::eLOAD);
+	const Vec4V normalisedTireLoad = V4Div(tireLoad, block.getScalar(TireForceField::eREST_LOAD));
+	const Vec4V latStiffX = block.getScalar(TireForceField::eLAT_STIFF_X);
+	const Vec4V latStiffY = block.getScalar(TireForceField::eLAT_STIFF_Y);
+	const Vec4V latStiff = V4Sel(V4IsEq(latStiffX, zero), latStiffY, 
+		V4Mul(latStiffY, smoothingFunction1(V4Div(V4Mul(normalisedTireLoad, V4Load(3.0f)), latStiffX))));
+	const Vec4V longStiff = block.getScalar(TireForceField::eLONG_STIFF);
+	const Vec4V camberStiff = block.getScalar(TireForceField::eCAMBER_STIFF);
+
+	//If long slip/lat slip/camber are all zero than there will be zero tire force.
+	const BoolV hasNoForce = BAnd(BAnd(
+		V4IsEq(V4Mul(latSlip, latStiff), zero), 
+		V4IsEq(V4Mul(longSlip, longStiff), zero)), 
+		V4IsEq(V4Mul(camber, camberStiff), zero));
+	const PxU32 noForceMask = BGetBitMask(hasNoForce);
+
+	//Transcendental functions are evaluated lane by lane with the scalar functions for exact results.
+	PX_ALIGN(16, PxF32 scratch[4]);
+	V4StoreA(V4Add(latSlip, V4Div(V4Mul(camber, camberStiff), latStiff)), scratch);
+	for (PxU32 i = 0; i < 4; i++)
+		scratch[i] = (noForceMask & (1 << i)) ? 0.0f : PxTan(scratch[i]);
+	const Vec4V TEff = V4LoadA(scratch);
+
+	const Vec4V frictionLoad = V4Mul(tireFriction, tireLoad);
+	const Vec4V K = V4Div(V4Sqrt(V4Add(
+		V4Mul(V4Mul(V4Mul(latStiff, TEff), latStiff), TEff), 
+		V4Mul(V4Mul(V4Mul(longStiff, longSlip), longStiff), longSlip))), frictionLoad);
+	const Vec4V FBar = smoothingFunction1(K);
+	const Vec4V MBar = smoothingFunction2(K);
+
+	const BoolV isSmallK = V4IsGrtrOrEq(V4Load(2.0f*PxPi), K);
+	const PxU32 cosMask = BGetBitMask(isSmallK) & ~noForceMask;
+	V4StoreA(V4Mul(K, V4Load(0.5f)), scratch);
+	for (PxU32 i = 0; i < 4; i++)
+		scratch[i] = (cosMask & (1 << i)) ? PxCos(scratch[i]) : 0.0f;
+	const Vec4V cosHalfK = V4LoadA(scratch);
+
+	const Vec4V latOverlLong = V4Div(latStiff, longStiff);
+	const Vec4V nu = V4Sel(isSmallK, 
+		V4Mul(V4Load(0.5f), V4Sub(V4Add(one, latOverlLong), V4Mul(V4Sub(one, latOverlLong), cosHalfK))), 
+		one);
+
+	const Vec4V FZero = V4Div(frictionLoad, V4Sqrt(V4Add(V4Mul(longSlip, longSlip), V4Mul(V4Mul(V4Mul(nu, TEff), nu), TEff))));
+	const Vec4V fz = V4Mul(V4Mul(longSlip, FBar), FZero);
+	const Vec4V fx = V4Mul(V4Mul(V4Mul(negate(nu), TEff), FBar), FZero);
+	const Vec4V fMy = V4Mul(V4Mul(V4Mul(nu, TEff), MBar), FZero);	//The pneumatic trail is 1.
+
+	const Vec4V tireLongForceMag = V4Sel(hasNoForce, zero, fz);
+	const Vec4V tireLatForceMag = V4Sel(hasNoForce, zero, fx);
+	const Vec4V tireAlignMoment = V4Sel(hasNoForce, zero, fMy);
+	const Vec4V wheelTorque = V4Sel(hasNoForce, zero, V4Mul(negate(fz), block.getScalar(TireForceField::eWHEEL_RADIUS)));
+
+	//Compute the forces and torques.
+	const Vec3SoA tireLongForce = scale(block.getVec3(TireForceField::eLONG_DIR), tireLongForceMag);
+	const Vec3SoA tireLatForce = scale(block.getVec3(TireForceField::eLAT_DIR), tireLatForceMag);
+
+	const Vec3SoA appPoint = add(rotate(block.getQuat(TireForceField::eATTACHMENT_ROTATION), 
+		block.getVec3(TireForceField::eFORCE_APP_POINT)), block.getVec3(TireForceField::eATTACHMENT_POSITION));
+	const Vec3SoA r = rotate(block.getQuat(TireForceField::eRIGID_BODY_ROTATION), appPoint);
+
+	LaneResults longForce, latForce, longTorque, latTorque;
+	longForce.store(tireLongForce);
+	latForce.store(tireLatForce);
+	longTorque.store(cross(r, tireLongForce));
+	latTorque.store(cross(r, tireLatForce));
+	PX_ALIGN(16, PxF32 alignMoment[4]);
+	PX_ALIGN(16, PxF32 torque[4]);
+	V4StoreA(tireAlignMoment, alignMoment);
+	V4StoreA(wheelTorque, torque);
+
+	for (PxU32 i = 0; i < block.mNbLanes; i++)
+	{
+		PxVehicleTireForce& out = *block.mOutputs[i];
+		out.forces[PxVehicleTireDirectionModes::eLONGITUDINAL] = longForce.get(i);
+		out.torques[PxVehicleTireDirectionModes::eLONGITUDINAL] = longTorque.get(i);
+		out.forces[PxVehicleTireDirectionModes::eLATERAL] = latForce.get(i);
+		out.torques[PxVehicleTireDirectionModes::eLATERAL] = latTorque.get(i);
+		out.aligningMoment = alignMoment[i];
+		out.wheelTorque = torque[i];
+	}
+
+	block.mNbLanes = 0;
+}
+
+} //namespace
+
+////////////////////////////////////////////////////////////////////////////
+//Batch updates.
+//Each chunk of vehicles runs the scalar functions wheel by wheel in the 
+//same order as the corresponding component, except for the force 
+//computations that are deferred to the SIMD blocks. The deferred results
+//are not read by any later function of the same stage.
+////////////////////////////////////////////////////////////////////////////
+
+struct SuspensionBatch
+{
+	const PxVehicleSuspensionBatchData* vehicles;
+	PxReal dt;
+	const PxVehicleSimulationContext* context;
+};
+
+static void suspensionBatchUpdate(void* userData, const PxU32 startIndex, const PxU32 endIndex)
+{
+	PX_SIMD_GUARD
+
+	const SuspensionBatch& batch = *reinterpret_cast<const SuspensionBatch*>(userData);
+	const PxReal dt = batch.dt;
+	const PxVehicleSimulationContext& context = *batch.context;
+	const Vec3SoA gravity = { V4Load(context.gravity.x), V4Load(context.gravity.y), V4Load(context.gravity.z) };
+
+	SuspensionForceBlock block;
+	for (PxU32 v = startIndex; v < endIndex; v++)
+	{
+		//A local copy because PxVehicleArrayData only grants write access through non-const instances.
+		PxVehicleSuspensionBatchData vehicle = batch.vehicles[v];
+		const PxVehicleAxleDescription& axleDescription = *vehicle.axleDescription;
+		const PxVehicleRigidBodyState& rigidBodyState = *vehicle.rigidBodyState;
+		const PxReal vehicleMass = vehicle.rigidBodyParams->mass;
+
+		for (PxU32 i = 0; i < axleDescription.nbWheels; i++)
+		{
+			const PxU32 wheelId = axleDescription.wheelIdsInAxleOrder[i];
+
+			PxVehicleSuspensionStateUpdate(
+				vehicle.wheelParams[wheelId], vehicle.suspensionParams[wheelId], *vehicle.suspensionStateCalculationParams,
+				vehicle.suspensionForceParams[wheelId].stiffness, vehicle.suspensionForceParams[wheelId].damping,
+				vehicle.steerResponseStates[wheelId], vehicle.wheelRoadGeomStates[wheelId],
+				rigidBodyState,
+				dt, context.frame, context.gravity,
+				vehicle.suspensionStates[wheelId]);
+
+			PxVehicleSuspensionComplianceUpdate(
+				vehicle.suspensionParams[wheelId], vehicle.suspensionComplianceParams[wheelId],
+				vehicle.suspensionStates[wheelId],
+				vehicle.suspensionComplianceStates[wheelId]);
+
+			//If the wheel cannot touch the ground then carry on with zero force.
+			if (!PxVehicleIsWheelOnGround(vehicle.suspensionStates[wheelId]))
+			{
+				vehicle.suspensionForces[wheelId].setToDefault();
+				continue;
+			}
+
+			addSuspensionForceLane(
+				vehicle.suspensionParams[wheelId], vehicle.suspensionForceParams[wheelId],
+				vehicle.wheelRoadGeomStates[wheelId], vehicle.suspensionStates[wheelId],
+				vehicle.suspensionComplianceStates[wheelId], rigidBodyState,
+				vehicleMass,
+				vehicle.suspensionForces[wheelId], block);
+			if (4 == block.mNbLanes)
+				flushSuspensionForces(block, gravity);
+		}
+
+		if (vehicle.antiRollForceParams.size > 0 && vehicle.antiRollTorque)
+		{
+			PxVehicleAntiRollForceUpdate(
+				vehicle.suspensionParams, vehicle.antiRollForceParams,
+				vehicle.suspensionStates.getConst(), vehicle.suspensionComplianceStates.getConst(), rigidBodyState,
+				*vehicle.antiRollTorque);
+		}
+	}
+	flushSuspensionForces(block, gravity);
+}
+
+void PxVehicleSuspensionBatchUpdate
+(const PxVehicleSuspensionBatchData* vehicles, const PxU32 nbVehicles,
+ const PxReal dt, const PxVehicleSimulationContext& context,
+ PxCpuDispatcher* dispatcher)
+{
+	PX_PROFILE_ZONE("PxVehicleSuspensionBatchUpdate", 0);
+
+	SuspensionBatch batch = { vehicles, dt, &context };
+	processBatch(dispatcher, nbVehicles, suspensionBatchUpdate, &batch);
+}
+
+struct TireBatch
+{
+	const PxVehicleTireBatchData* vehicles;
+	PxReal dt;
+	const PxVehicleSimulationContext* context;
+};
+
+static void tireBatchUpdate(void* userData, const PxU32 startIndex, const PxU32 endIndex)
+{
+	PX_SIMD_GUARD
+
+	const TireBatch& batch = *reinterpret_cast<const TireBatch*>(userData);
+	const PxReal dt = batch.dt;
+	const PxVehicleSimulationContext& context = *batch.context;
+
+	TireForceBlock block;
+	for (PxU32 v = startIndex; v < endIndex; v++)
+	{
+		//A local copy because PxVehicleArrayData only grants write access through non-const instances.
+		PxVehicleTireBatchData vehicle = batch.vehicles[v];
+		const PxVehicleAxleDescription& axleDescription = *vehicle.axleDescription;
+		const PxVehicleRigidBodyState& rigidBodyState = *vehicle.rigidBodyState;
+
+		for (PxU32 i = 0; i < axleDescription.nbWheels; i++)
+		{
+			const PxU32 wheelId = axleDescription.wheelIdsInAxleOrder[i];
+
+			const bool isWheelOnGround = PxVehicleIsWheelOnGround(vehicle.suspensionStates[wheelId]);
+
+			PxVehicleTireDirsUpdate(
+				vehicle.suspensionParams[wheelId],
+				vehicle.steerResponseStates[wheelId],
+				vehicle.roadGeomStates[wheelId].plane.n, isWheelOnGround,
+				vehicle.suspensionComplianceStates[wheelId],
+				rigidBodyState,
+				context.frame,
+				vehicle.tireDirectionStates[wheelId]);
+
+			PxVehicleTireSlipSpeedsUpdate(
+				vehicle.wheelParams[wheelId], vehicle.suspensionParams[wheelId],
+				vehicle.steerResponseStates[wheelId], vehicle.suspensionStates[wheelId], vehicle.tireDirectionStates[wheelId],
+				rigidBodyState, vehicle.roadGeomStates[wheelId],
+				context.frame,
+				vehicle.tireSpeedStates[wheelId]);
+
+			PxVehicleTireSlipsUpdate(
+				vehicle.wheelParams[wheelId], context.tireSlipParams,
+				vehicle.actuationStates[wheelId], vehicle.tireSpeedStates[wheelId],
+				vehicle.wheelRigidBody1DStates[wheelId],
+				vehicle.tireSlipStates[wheelId]);
+
+			PxVehicleTireCamberAnglesUpdate(
+				vehicle.suspensionParams[wheelId], vehicle.steerResponseStates[wheelId],
+				vehicle.roadGeomStates[wheelId].plane.n, isWheelOnGround,
+				vehicle.suspensionComplianceStates[wheelId], rigidBodyState,
+				context.frame,
+				vehicle.tireCamberAngleStates[wheelId]);
+
+			PxVehicleTireGripUpdate(
+				vehicle.tireForceParams[wheelId], vehicle.roadGeomStates[wheelId].friction,
+				isWheelOnGround, vehicle.suspensionForces[wheelId],
+				vehicle.tireSlipStates[wheelId], vehicle.tireGripStates[wheelId]);
+
+			PxVehicleTireStickyStateUpdate(
+				axleDescription,
+				vehicle.wheelParams[wheelId],
+				context.tireStickyParams,
+				vehicle.actuationStates, vehicle.tireGripStates[wheelId],
+				vehicle.tireSpeedStates[wheelId], vehicle.wheelRigidBody1DStates[wheelId],
+				dt,
+				vehicle.tireStickyStates[wheelId]);
+
+			PxVehicleTireSlipsAccountingForStickyStatesUpdate(
+				vehicle.tireStickyStates[wheelId],
+				vehicle.tireSlipStates[wheelId]);
+
+			//If the tire can generate no force then carry on with zero force.
+			const PxVehicleTireGripState& gripState = vehicle.tireGripStates[wheelId];
+			if (0 == gripState.friction*gripState.load)
+			{
+				vehicle.tireForces[wheelId].setToDefault();
+				continue;
+			}
+
+			addTireForceLane(
+				vehicle.wheelParams[wheelId], vehicle.suspensionParams[wheelId],
+				vehicle.tireForceParams[wheelId],
+				vehicle.suspensionComplianceStates[wheelId],
+				gripState, vehicle.tireDirectionStates[wheelId],
+				vehicle.tireSlipStates[wheelId], vehicle.tireCamberAngleStates[wheelId],
+				rigidBodyState,
+				vehicle.tireForces[wheelId], block);
+			if (4 == block.mNbLanes)
+				flushTireForces(block);
+		}
+	}
+	flushTireForces(block);
+}
+
+void PxVehicleTireBatchUpdate
+(const PxVehicleTireBatchData* vehicles, const PxU32 nbVehicles,
+ const PxReal dt, const PxVehicleSimulationContext& context,
+ PxCpuDispatcher* dispatcher)
+{
+	PX_PROFILE_ZONE("PxVehicleTireBatchUpdate", 0);
+
+	TireBatch batch = { vehicles, dt, &context };
+	processBatch(dispatcher, nbVehicles, tireBatchUpdate, &batch);
+}
+
+template<class BatchData>
+struct DrivetrainBatch
+{
+	const BatchData* vehicles;
+	PxReal dt;
+};
+
+static void directDrivetrainBatchUpdate(void* userData, const PxU32 startIndex, const PxU32 endIndex)
+{
+	const DrivetrainBatch<PxVehicleDirectDrivetrainBatchData>& batch = *reinterpret_cast<const DrivetrainBatch<PxVehicleDirectDrivetrainBatchData>*>(userData);
+	const PxReal dt = batch.dt;
+
+	for (PxU32 v = startIndex; v < endIndex; v++)
+	{
+		PxVehicleDirectDrivetrainBatchData vehicle = batch.vehicles[v];
+		const PxVehicleAxleDescription& axleDescription = *vehicle.axleDescription;
+
+		for (PxU32 i = 0; i < axleDescription.nbWheels; i++)
+		{
+			const PxU32 wheelId = axleDescription.wheelIdsInAxleOrder[i];
+
+			PxVehicleDirectDriveUpdate(
+				vehicle.wheelParams[wheelId], vehicle.actuationStates[wheelId],
+				vehicle.brakeResponseStates[wheelId], vehicle.throttleResponseStates[wheelId],
+				vehicle.tireForces[wheelId],
+				dt,
+				vehicle.wheelRigidBody1dStates[wheelId]);
+		}
+	}
+}
+
+void PxVehicleDirectDrivetrainBatchUpdate
+(const PxVehicleDirectDrivetrainBatchData* vehicles, const PxU32 nbVehicles,
+ const PxReal dt,
+ PxCpuDispatcher* dispatcher)
+{
+	PX_PROFILE_ZONE("PxVehicleDirectDrivetrainBatchUpdate", 0);
+
+	DrivetrainBatch<PxVehicleDirectDrivetrainBatchData> batch = { vehicles, dt };
+	processBatch(dispatcher, nbVehicles, directDrivetrainBatchUpdate, &batch);
+}
+
+static void engineDrivetrainBatchUpdate(void* userData, const PxU32 startIndex, const PxU32 endIndex)
+{
+	const DrivetrainBatch<PxVehicleEngineDrivetrainBatchData>& batch = *reinterpret_cast<const DrivetrainBatch<PxVehicleEngineDrivetrainBatchData>*>(userData);
+	const PxReal dt = batch.dt;
+
+	for (PxU32 v = startIndex; v < endIndex; v++)
+	{
+		PxVehicleEngineDrivetrainBatchData vehicle = batch.vehicles[v];
+
+		PxVehicleGearboxUpdate(*vehicle.gearboxParams, dt, *vehicle.gearboxState);
+
+		PxVehicleEngineDrivetrainUpdate(
+			*vehicle.axleDescription,
+			vehicle.wheelParams,
+			*vehicle.engineParams, *vehicle.clutchParams, *vehicle.gearboxParams,
+			vehicle.brakeResponseStates, vehicle.actuationStates,
+			vehicle.tireForces,
+			*vehicle.gearboxState, *vehicle.throttleResponseState, *vehicle.clutchResponseState, *vehicle.differentialState, vehicle.constraintGroupState,
+			dt,
+			vehicle.wheelRigidBody1dStates, *vehicle.engineState, *vehicle.clutchState);
+	}
+}
+
+void PxVehicleEngineDrivetrainBatchUpdate
+(const PxVehicleEngineDrivetrainBatchData* vehicles, const PxU32 nbVehicles,
+ const PxReal dt,
+ PxCpuDispatcher* dispatcher)
+{
+	PX_PROFILE_ZONE("PxVehicleEngineDrivetrainBatchUpdate", 0);
+
+	DrivetrainBatch<PxVehicleEngineDrivetrainBatchData> batch = { vehicles, dt };
+	processBatch(dispatcher, nbVehicles, engineDrivetrainBatchUpdate, &batch);
+}
+
+////////////////////////////////////////////////////////////////////////////
+//Batched road geometry queries.
+//The queries of all wheels are gathered, sorted along a Morton curve of 
+//their start points and then performed in parallel chunks. Each query 
+//only writes the states of its own wheel.
+////////////////////////////////////////////////////////////////////////////
+
+struct RoadGeometryQuery
+{
+	PxU32 sortKey;
+	PxU32 vehicleIndex;
+	PxU32 wheelId;
+	PxVec3 start;
+	PxVec3 end;
+};
+
+struct RoadGeometryQueryLess
+{
+	PX_FORCE_INLINE bool operator()(const RoadGeometryQuery& a, const RoadGeometryQuery& b) const
+	{
+		return a.sortKey < b.sortKey;
+	}
+};
+
+struct RoadGeometryQueryBatch
+{
+	const PxVehiclePhysXRoadGeometryQueryBatchData* vehicles;
+	const RoadGeometryQuery* queries;
+	const PxVehiclePhysXSimulationContext* context;
+};
+
+//Spread the lower 10 bits of x so that there are two zero bits between each pair of bits.
+PX_FORCE_INLINE PxU32 spreadMortonBits(PxU32 x)
+{
+	x &= 0x000003ff;
+	x = (x | (x << 16)) & 0xff0000ff;
+	x = (x | (x << 8)) & 0x0300f00f;
+	x = (x | (x << 4)) & 0x030c30c3;
+	x = (x | (x << 2)) & 0x09249249;
+	return x;
+}
+
+PX_FORCE_INLINE PxU32 quantizeMortonCoordinate(const PxReal x, const PxReal minX, const PxReal invExtent)
+{
+	return PxU32(PxClamp((x - minX) * invExtent, 0.0f, 1023.0f));
+}
+
+//The start and end points that identify the query of a wheel. The end point accounts for the query direction and length.
+//For sweeps the points are offset from the wheel center along the wheel axis so that they also follow the steer and 
+//camber of the swept cylinder.
+static void computeRoadGeometryQueryPoints
+(const PxVehiclePhysXRoadGeometryQueryBatchData& vehicle, const PxU32 wheelId, const PxVehicleFrame& frame,
+ PxVec3& start, PxVec3& end)
+{
+	const PxVehicleWheelParams& wheelParams = vehicle.wheelParams[wheelId];
+	const PxVehicleSuspensionParams& suspParams = vehicle.suspensionParams[wheelId];
+	const PxReal steerAngle = vehicle.steerResponseStates[wheelId];
+
+	PxVec3 dir;
+	PxReal dist;
+	if (PxVehiclePhysXRoadGeometryQueryType::eRAYCAST == vehicle.roadGeomParams->roadGeometryQueryType)
+	{
+		PxVehicleComputeSuspensionRaycast(frame, wheelParams, suspParams, steerAngle, vehicle.rigidBodyState->pose, start, dir, dist);
+	}
+	else
+	{
+		PxTransform pose;
+		PxVehicleComputeSuspensionSweep(frame, suspParams, steerAngle, vehicle.rigidBodyState->pose, pose, dir, dist);
+		start = pose.transform(frame.getLatAxis() * wheelParams.halfWidth);
+	}
+	end = start + dir * dist;
+}
+
+static void roadGeometryQueryBatchUpdate(void* userData, const PxU32 startIndex, const PxU32 endIndex)
+{
+	const RoadGeometryQueryBatch& batch = *reinterpret_cast<const RoadGeometryQueryBatch*>(userData);
+	const PxVehiclePhysXSimulationContext& context = *batch.context;
+
+	for (PxU32 q = startIndex; q < endIndex; q++)
+	{
+		const RoadGeometryQuery& query = batch.queries[q];
+		const PxU32 wheelId = query.wheelId;
+
+		//A local copy because PxVehicleArrayData only grants write access through non-const instances.
+		PxVehiclePhysXRoadGeometryQueryBatchData vehicle = batch.vehicles[query.vehicleIndex];
+		const PxVehiclePhysXRoadGeometryQueryParams& roadGeomParams = *vehicle.roadGeomParams;
+		const PxQueryFilterData* fdPtr = roadGeomParams.filterDataEntries ? (roadGeomParams.filterDataEntries + wheelId) : &roadGeomParams.defaultFilterData;
+
+		//The hit actor is needed to decide whether the result can be cached.
+		const bool useCache = !vehicle.queryCacheStates.isEmpty();
+		PxVehiclePhysXRoadGeometryQueryState localPhysxRoadGeometryState;
+		PxVehiclePhysXRoadGeometryQueryState* physxRoadGeometryState = !vehicle.physxRoadGeometryStates.isEmpty() ? 
+			&vehicle.physxRoadGeometryStates[wheelId] : (useCache ? &localPhysxRoadGeometryState : NULL);
+
+		PxVehiclePhysXRoadGeometryQueryUpdate(
+			vehicle.wheelParams[wheelId], vehicle.suspensionParams[wheelId],
+			roadGeomParams.roadGeometryQueryType, roadGeomParams.filterCallback, *fdPtr,
+			vehicle.materialFrictionParams[wheelId],
+			vehicle.steerResponseStates[wheelId], *vehicle.rigidBodyState,
+			*context.physxScene, context.physxUnitCylinderSweepMesh, context.frame,
+			vehicle.roadGeometryStates[wheelId],
+			physxRoadGeometryState);
+
+		if (useCache)
+		{
+			PxVehiclePhysXRoadGeometryQueryCacheState& cacheState = vehicle.queryCacheStates[wheelId];
+			cacheState.queryStart = query.start;
+			cacheState.queryEnd = query.end;
+			cacheState.isValid = vehicle.roadGeometryStates[wheelId].hitState &&
+				physxRoadGeometryState->actor && physxRoadGeometryState->actor->is<PxRigidStatic>();
+		}
+	}
+}
+
+void PxVehiclePhysXRoadGeometryQueryBatchUpdate
+(const PxVehiclePhysXRoadGeometryQueryBatchData* vehicles, const PxU32 nbVehicles,
+ const PxVehicleSimulationContext& context,
+ PxCpuDispatcher* dispatcher)
+{
+	PX_PROFILE_ZONE("PxVehiclePhysXRoadGeometryQueryBatchUpdate", 0);
+
+	if (context.getType() != PxVehicleSimulationContextType::ePHYSX)
+	{
+		PX_ALWAYS_ASSERT();
+
+		for (PxU32 v = 0; v < nbVehicles; v++)
+		{
+			PxVehiclePhysXRoadGeometryQueryBatchData vehicle = vehicles[v];
+			for (PxU32 i = 0; i < vehicle.axleDescription->nbWheels; i++)
+				vehicle.roadGeometryStates[vehicle.axleDescription->wheelIdsInAxleOrder[i]].setToDefault();
+		}
+		return;
+	}
+
+	//Gather the queries that cannot reuse the result of the previous call.
+	PxArray<RoadGeometryQuery> queries;
+	PxBounds3 bounds = PxBounds3::empty();
+	for (PxU32 v = 0; v < nbVehicles; v++)
+	{
+		const PxVehiclePhysXRoadGeometryQueryBatchData& vehicle = vehicles[v];
+		if (PxVehiclePhysXRoadGeometryQueryType::eNONE == vehicle.roadGeomParams->roadGeometryQueryType)
+			continue;
+
+		const bool useCache = !vehicle.queryCacheStates.isEmpty();
+		const PxReal toleranceSq = vehicle.queryCacheTolerance * vehicle.queryCacheTolerance;
+
+		const PxVehicleAxleDescription& axleDescription = *vehicle.axleDescription;
+		for (PxU32 i = 0; i < axleDescription.nbWheels; i++)
+		{
+			RoadGeometryQuery query;
+			query.sortKey = 0;
+			query.vehicleIndex = v;
+			query.wheelId = axleDescription.wheelIdsInAxleOrder[i];
+			computeRoadGeometryQueryPoints(vehicle, query.wheelId, context.frame, query.start, query.end);
+
+			if (useCache)
+			{
+				const PxVehiclePhysXRoadGeometryQueryCacheState& cacheState = vehicle.queryCacheStates[query.wheelId];
+				if (cacheState.isValid &&
+					(query.start - cacheState.queryStart).magnitudeSquared() < toleranceSq &&
+					(query.end - cacheState.queryEnd).magnitudeSquared() < toleranceSq)
+					continue;
+			}
+
+			bounds.include(query.start);
+			queries.pushBack(query);
+		}
+	}
+
+	const PxU32 nbQueries = queries.size();
+	if (!nbQueries)
+		return;
+
+	//Sort the queries along a Morton curve through the bounds of their start points.
+	{
+		const PxVec3 extents = bounds.maximum - bounds.minimum;
+		const PxVec3 invExtents(
+			extents.x > 0.0f ? 1023.0f / extents.x : 0.0f,
+			extents.y > 0.0f ? 1023.0f / extents.y : 0.0f,
+			extents.z > 0.0f ? 1023.0f / extents.z : 0.0f);
+		for (PxU32 q = 0; q < nbQueries; q++)
+		{
+			RoadGeometryQuery& query = queries[q];
+			const PxU32 x = quantizeMortonCoordinate(query.start.x, bounds.minimum.x, invExtents.x);
+			const PxU32 y = quantizeMortonCoordinate(query.start.y, bounds.minimum.y, invExtents.y);
+			const PxU32 z = quantizeMortonCoordinate(query.start.z, bounds.minimum.z, invExtents.z);
+			query.sortKey = spreadMortonBits(x) | (spreadMortonBits(y) << 1) | (spreadMortonBits(z) << 2);
+		}
+		PxSort(queries.begin(), nbQueries, RoadGeometryQueryLess());
+	}
+
+	RoadGeometryQueryBatch batch = { vehicles, queries.begin(), static_cast<const PxVehiclePhysXSimulationContext*>(&context) };
+	processBatch(dispatcher, nbQueries, roadGeometryQueryBatchUpdate, &batch);
+}
+
+} //namespace vehicle2
+} //namespace physx
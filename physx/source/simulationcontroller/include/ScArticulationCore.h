@@ -123,6 +123,8 @@ namespace Sc
 
 						void						computeGeneralizedMassMatrix(PxArticulationCache& cache) const;
 
+						void						computeInverseDynamics(PxArticulationCache& cache, PxArticulationInverseDynamicsFlags flags, PxU32& nRows, PxU32& nCols, const bool isGpuSimEnabled) const;
+
 						PxU32						getCoefficientMatrixSize() const;
 
 						PxSpatialVelocity			getLinkAcceleration(const PxU32 linkId, const bool isGpuSimEnabled) const;
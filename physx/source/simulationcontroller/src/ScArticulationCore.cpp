@@ -250,6 +250,12 @@ void Sc::ArticulationCore::computeGeneralizedMassMatrix(PxArticulationCache& cac
 		mSim->computeGeneralizedMassMatrix(cache);
 }
 
+void Sc::ArticulationCore::computeInverseDynamics(PxArticulationCache& cache, PxArticulationInverseDynamicsFlags flags, PxU32& nRows, PxU32& nCols, const bool isGpuSimEnabled) const
+{
+	if(mSim)
+		mSim->computeInverseDynamics(cache, flags, nRows, nCols, isGpuSimEnabled);
+}
+
 PxU32 Sc::ArticulationCore::getCoefficientMatrixSize() const
 {
 	return mSim ? mSim->getCoefficientMatrixSize() : 0xFFFFFFFFu;
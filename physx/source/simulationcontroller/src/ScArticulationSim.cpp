@@ -722,6 +722,20 @@ void Sc::ArticulationSim::computeGeneralizedMassMatrix(PxArticulationCache& cach
 	PX_FREE(massMatrix);*/
 }
 
+void Sc::ArticulationSim::computeInverseDynamics(PxArticulationCache& cache, PxArticulationInverseDynamicsFlags flags, PxU32& nRows, PxU32& nCols, const bool isGpuSimEnabled)
+{
+	// the GPU pipeline updates the link poses without marking the inverse dynamics data dirty, so it cannot be kept across calls
+	if(isGpuSimEnabled)
+		mLLArticulation->initializeCommonData();
+
+	mLLArticulation->getInverseDynamics(mScene.getGravity(), cache, flags, nRows, nCols);
+}
+
+void Sc::ArticulationSim::setInverseDynamicsDataDirty()
+{
+	mLLArticulation->getArticulationData().setDataDirty(true);
+}
+
 PxU32 Sc::ArticulationSim::getCoefficientMatrixSize() const
 {
 	const PxU32 size = mLoopConstraints.size();
@@ -161,6 +161,10 @@ namespace Sc
 
 					void					computeGeneralizedMassMatrix(PxArticulationCache& cache);
 
+					void					computeInverseDynamics(PxArticulationCache& cache, PxArticulationInverseDynamicsFlags flags, PxU32& nRows, PxU32& nCols, const bool isGpuSimEnabled);
+					// marks the data cached for the inverse dynamics queries dirty, e.g. after a link mass property change
+					void					setInverseDynamicsDataDirty();
+
 					PxU32					getCoefficientMatrixSize() const;
 
 					void					setRootLinearVelocity(const PxVec3& velocity);
@@ -42,6 +42,14 @@ static void updateBodySim(Sc::BodyCore& bodyCore)
 		bodySim->getScene().updateBodySim(*bodySim);
 }
 
+// the inverse dynamics data cached by articulations is computed from the link mass properties
+static void setArticulationDataDirty(Sc::BodyCore& bodyCore)
+{
+	Sc::BodySim* bodySim = bodyCore.getSim();
+	if(bodySim && bodySim->isArticulationLink() && bodySim->getArticulation())
+		bodySim->getArticulation()->setInverseDynamicsDataDirty();
+}
+
 Sc::BodyCore::BodyCore(PxActorType::Enum type, const PxTransform& bodyPose) : RigidCore(type)
 {
 	const PxTolerancesScale& scale = Physics::getInstance().getTolerancesScale();
@@ -142,6 +150,7 @@ void Sc::BodyCore::setBody2Actor(const PxTransform& p)
 	mCore.setBody2Actor(p);
 
 	updateBodySim(*this);
+	setArticulationDataDirty(*this);
 }
 
 void Sc::BodyCore::addSpatialAcceleration(const PxVec3* linAcc, const PxVec3* angAcc)
@@ -204,6 +213,7 @@ void Sc::BodyCore::setInverseMass(PxReal m)
 	{
 		mCore.inverseMass = m;
 		updateBodySim(*this);
+		setArticulationDataDirty(*this);
 	}
 	else
 	{
@@ -237,6 +247,7 @@ void Sc::BodyCore::setInverseInertia(const PxVec3& i)
 	{
 		mCore.inverseInertia = i;
 		updateBodySim(*this);
+		setArticulationDataDirty(*this);
 	}
 	else
 	{
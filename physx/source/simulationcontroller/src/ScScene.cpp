@@ -2198,6 +2198,15 @@ void Sc::Scene::postCallbacksPreSync()
 	postCallbacksPreSyncKinematics();
 
 	releaseConstraints(true); //release constraint blocks at the end of the frame, so user can retrieve the blocks
+
+	PxcNpMemBlockPool& blockPool = mLLContext->getNpMemBlockPool();
+	blockPool.endFrame();
+#if PX_ENABLE_SIM_STATS
+	mLLContext->getSimStats().mPeakContactDataBlocksUsed = blockPool.getFramePeakUsedBlockCount();
+	mLLContext->getSimStats().mNbContactDataBlocksAllocated = blockPool.getAllocatedBlockCount();
+#else
+	PX_CATCH_UNDEFINED_ENABLE_SIM_STATS
+#endif
 }
 
 void Sc::Scene::getStats(PxSimulationStatistics& s) const
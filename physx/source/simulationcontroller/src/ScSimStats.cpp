@@ -126,6 +126,9 @@ void Sc::SimStats::readOut(PxSimulationStatistics& s, const PxvSimStats& simStat
 	s.peakConstraintMemory = simStats.mPeakConstraintBlockAllocations * 16 * 1024;
 	s.compressedContactSize = simStats.mTotalCompressedContactSize;
 	s.requiredContactConstraintMemory = simStats.mTotalConstraintSize;
+	s.nbContactDataBlocksAllocated = simStats.mNbContactDataBlocksAllocated;
+	s.peakContactDataBlocksUsed = simStats.mPeakContactDataBlocksUsed;
+	s.nbReducedContactPairs = simStats.mNbReducedContactPairs;
 	s.nbNewPairs = simStats.mNbNewPairs;
 	s.nbLostPairs = simStats.mNbLostPairs;
 	s.nbNewTouches = simStats.mNbNewTouches;